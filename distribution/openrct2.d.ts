@@ -554,6 +554,57 @@ declare global {
         getEntity(id: number): Entity;
         getAllEntities(type: EntityType): Entity[];
         getAllEntities(type: "peep"): Peep[];
+
+        /**
+         * Gets the tile elements of a rectangle of tiles as typed arrays, which is much faster than
+         * calling getTile for every tile. The rectangle is clipped to the map.
+         * @param x The x coordinate of the first tile.
+         * @param y The y coordinate of the first tile.
+         * @param width The number of tiles along the x axis.
+         * @param height The number of tiles along the y axis.
+         */
+        getTileData(x: number, y: number, width: number, height: number): TileData;
+
+        /**
+         * Gets the ids and positions of all entities of a type as typed arrays.
+         * @param type The type of entity.
+         * @param filter If given, only entities at most range units away from x and y on both axes are returned.
+         */
+        getEntityData(type: EntityType, filter?: { x: number, y: number, range: number }): EntityData;
+    }
+
+    /**
+     * The tile elements of a rectangle of tiles, tiles are ordered by row. The elements of tile i are
+     * at the indices elementIndex[i] up to but not including elementIndex[i + 1] of the element arrays.
+     */
+    interface TileData {
+        readonly x: number;
+        readonly y: number;
+        readonly width: number;
+        readonly height: number;
+        /** The base height of the surface element of each tile. */
+        readonly surfaceHeight: Uint8Array;
+        /** The index of the first element of each tile, followed by the total number of elements. */
+        readonly elementIndex: Uint32Array;
+        /**
+         * The type of each element: 0 surface, 1 footpath, 2 track, 3 small scenery, 4 entrance, 5 wall,
+         * 6 large scenery, 7 banner.
+         */
+        readonly elementType: Uint8Array;
+        readonly baseHeight: Uint8Array;
+        readonly clearanceHeight: Uint8Array;
+        /** The ride of each track, entrance or queue element, 65535 for all others. */
+        readonly rideId: Uint16Array;
+    }
+
+    /**
+     * The ids and positions of a list of entities.
+     */
+    interface EntityData {
+        readonly id: Uint16Array;
+        readonly x: Int32Array;
+        readonly y: Int32Array;
+        readonly z: Int32Array;
     }
 
     type TileElementType =
@@ -299,7 +299,20 @@ public:
 
         for (auto& w : g_window_list)
         {
-            DrawWeatherWindow(weatherDrawer, w.get(), left, right, top, bottom, drawFunc);
+            // Weather is only drawn over viewports, clipping to the viewport first leaves fewer windows above it to
+            // split the area around
+            auto vp = w->viewport;
+            if (vp == nullptr)
+                continue;
+
+            auto vpLeft = std::max<int16_t>(left, vp->pos.x);
+            auto vpRight = std::min<int16_t>(right, vp->pos.x + vp->width);
+            auto vpTop = std::max<int16_t>(top, vp->pos.y);
+            auto vpBottom = std::min<int16_t>(bottom, vp->pos.y + vp->height);
+            if (vpLeft < vpRight && vpTop < vpBottom)
+            {
+                DrawWeatherWindow(weatherDrawer, w.get(), vpLeft, vpRight, vpTop, vpBottom, drawFunc);
+            }
         }
     }
 
@@ -872,20 +885,12 @@ private:
         {
             if (it == g_window_list.end())
             {
-                // Loop ended, draw weather for original_w
-                auto vp = original_w->viewport;
-                if (vp != nullptr)
+                // Loop ended, draw weather for original_w, the area is already clipped to its viewport
+                if (left < right && top < bottom)
                 {
-                    left = std::max<int16_t>(left, vp->pos.x);
-                    right = std::min<int16_t>(right, vp->pos.x + vp->width);
-                    top = std::max<int16_t>(top, vp->pos.y);
-                    bottom = std::min<int16_t>(bottom, vp->pos.y + vp->height);
-                    if (left < right && top < bottom)
-                    {
-                        auto width = right - left;
-                        auto height = bottom - top;
-                        drawFunc(weatherDrawer, left, top, width, height);
-                    }
+                    auto width = right - left;
+                    auto height = bottom - top;
+                    drawFunc(weatherDrawer, left, top, width, height);
                 }
                 return;
             }
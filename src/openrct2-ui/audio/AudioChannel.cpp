@@ -15,6 +15,7 @@
 #include <openrct2/audio/AudioSource.h>
 #include <openrct2/common.h>
 #include <speex/speex_resampler.h>
+#include <vector>
 
 namespace OpenRCT2::Audio
 {
@@ -251,20 +252,42 @@ namespace OpenRCT2::Audio
         }
 
         size_t Read(void* dst, size_t len) override
+        {
+            return ReadLooped(dst, len, _offset, _source->GetLength(), [this](void* buffer, uint64_t offset, size_t bytes) {
+                return _source->Read(buffer, offset, bytes);
+            });
+        }
+
+        size_t ReadResampled(void* dst, size_t len, const std::vector<uint8_t>& data, double rate) override
+        {
+            int32_t byteRate = GetFormat().GetByteRate();
+            uint64_t offset = (static_cast<uint64_t>(_offset / rate) / byteRate) * byteRate;
+            size_t bytesRead = ReadLooped(dst, len, offset, data.size(), [&data](void* buffer, uint64_t pos, size_t bytes) {
+                bytes = static_cast<size_t>(std::min<uint64_t>(bytes, data.size() - std::min<uint64_t>(pos, data.size())));
+                std::copy_n(data.data() + pos, bytes, static_cast<uint8_t*>(buffer));
+                return bytes;
+            });
+            _offset = (static_cast<uint64_t>(offset * rate) / byteRate) * byteRate;
+            return bytesRead;
+        }
+
+    private:
+        template<typename TReadFunc>
+        size_t ReadLooped(void* dst, size_t len, uint64_t& offset, uint64_t length, TReadFunc readFunc)
         {
             size_t bytesRead = 0;
             size_t bytesToRead = len;
             while (bytesToRead > 0 && !_done)
             {
-                size_t readLen = _source->Read(dst, _offset, bytesToRead);
+                size_t readLen = readFunc(dst, offset, bytesToRead);
                 if (readLen > 0)
                 {
                     dst = reinterpret_cast<void*>(reinterpret_cast<uintptr_t>(dst) + readLen);
                     bytesToRead -= readLen;
                     bytesRead += readLen;
-                    _offset += readLen;
+                    offset += readLen;
                 }
-                if (_offset >= _source->GetLength())
+                if (offset >= length)
                 {
                     if (_loop == 0)
                     {
@@ -272,12 +295,12 @@ namespace OpenRCT2::Audio
                     }
                     else if (_loop == MIXER_LOOP_INFINITE)
                     {
-                        _offset = 0;
+                        offset = 0;
                     }
                     else
                     {
                         _loop--;
-                        _offset = 0;
+                        offset = 0;
                     }
                 }
             }
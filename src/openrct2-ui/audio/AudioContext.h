@@ -14,6 +14,7 @@
 #include <openrct2/audio/AudioSource.h>
 #include <openrct2/common.h>
 #include <string>
+#include <vector>
 
 struct SDL_RWops;
 using SpeexResamplerState = struct SpeexResamplerState_;
@@ -58,6 +59,12 @@ namespace OpenRCT2::Audio
         [[nodiscard]] virtual AudioFormat GetFormat() const abstract;
         [[nodiscard]] virtual SpeexResamplerState* GetResampler() const abstract;
         virtual void SetResampler(SpeexResamplerState* value) abstract;
+
+        /**
+         * Reads from data holding the whole source already resampled by the given rate, instead of from the source.
+         * The offset of the channel stays in terms of the source.
+         */
+        virtual size_t ReadResampled(void* dst, size_t len, const std::vector<uint8_t>& data, double rate) abstract;
     };
 
     namespace AudioSource
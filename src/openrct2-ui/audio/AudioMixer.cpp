@@ -12,6 +12,7 @@
 
 #include <SDL.h>
 #include <algorithm>
+#include <cmath>
 #include <iterator>
 #include <list>
 #include <openrct2/Context.h>
@@ -23,13 +24,30 @@
 #include <openrct2/common.h>
 #include <openrct2/config/Config.h>
 #include <speex/speex_resampler.h>
+#include <unordered_map>
 #include <vector>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    define AUDIO_MIXER_SSE2
+#    include <emmintrin.h>
+#endif
+
 namespace OpenRCT2::Audio
 {
     class AudioMixerImpl final : public IAudioMixer
     {
     private:
+        // Rates of cached resampled sounds are rounded to multiples of 1 / ResampleRateUnits
+        static constexpr int32_t ResampleRateUnits = 4096;
+        static constexpr size_t ResampleCacheMaxSize = 32 * 1024 * 1024;
+
+        struct ChannelGain
+        {
+            // Gain of the left and right output channel at the start and its change per frame
+            float Start[2];
+            float Step[2];
+        };
+
         IAudioSource* _nullSource = nullptr;
 
         SDL_AudioDeviceID _deviceId = 0;
@@ -44,9 +62,14 @@ namespace OpenRCT2::Audio
         IAudioSource* _css1Sources[RCT2SoundCount] = { nullptr };
         IAudioSource* _musicSources[PATH_ID_END] = { nullptr };
 
+        std::unordered_map<const IAudioSource*, uint32_t> _css1SourceIds;
+        std::unordered_map<uint64_t, std::vector<uint8_t>> _resampleCache;
+        size_t _resampleCacheSize = 0;
+
         std::vector<uint8_t> _channelBuffer;
         std::vector<uint8_t> _convertBuffer;
         std::vector<uint8_t> _effectBuffer;
+        std::vector<float> _mixBuffer;
 
     public:
         AudioMixerImpl()
@@ -107,6 +130,9 @@ namespace OpenRCT2::Audio
                     SafeDelete(_css1Sources[i]);
                 }
             }
+            _css1SourceIds.clear();
+            _resampleCache.clear();
+            _resampleCacheSize = 0;
             for (size_t i = 0; i < std::size(_musicSources); i++)
             {
                 if (_musicSources[i] != _nullSource)
@@ -122,6 +148,8 @@ namespace OpenRCT2::Audio
             _convertBuffer.shrink_to_fit();
             _effectBuffer.clear();
             _effectBuffer.shrink_to_fit();
+            _mixBuffer.clear();
+            _mixBuffer.shrink_to_fit();
         }
 
         void Lock() override
@@ -203,6 +231,10 @@ namespace OpenRCT2::Audio
                 {
                     source = _nullSource;
                 }
+                else
+                {
+                    _css1SourceIds[source] = static_cast<uint32_t>(i);
+                }
                 _css1Sources[i] = source;
             }
         }
@@ -211,10 +243,9 @@ namespace OpenRCT2::Audio
         {
             UpdateAdjustedSound();
 
-            // Zero the output buffer
-            std::fill_n(dst, length, 0);
+            // Channels are added up as floats and only clipped once when written to the output buffer
+            _mixBuffer.assign(length / _format.BytesPerSample(), 0.0f);
 
-            // Mix channels onto output buffer
             auto it = _channels.begin();
             while (it != _channels.end())
             {
@@ -223,7 +254,7 @@ namespace OpenRCT2::Audio
                 if ((group != MixerGroup::Sound || gConfigSound.sound_enabled) && gConfigSound.master_sound_enabled
                     && gConfigSound.master_volume != 0)
                 {
-                    MixChannel(channel, dst, length);
+                    MixChannel(channel, length);
                 }
                 if ((channel->IsDone() && channel->DeleteOnDone()) || channel->IsStopping())
                 {
@@ -235,6 +266,8 @@ namespace OpenRCT2::Audio
                     it++;
                 }
             }
+
+            WriteMixBuffer(dst, _mixBuffer.size());
         }
 
         void UpdateAdjustedSound()
@@ -252,7 +285,7 @@ namespace OpenRCT2::Audio
             }
         }
 
-        void MixChannel(ISDLAudioChannel* channel, uint8_t* data, size_t length)
+        void MixChannel(ISDLAudioChannel* channel, size_t length)
         {
             int32_t byteRate = _format.GetByteRate();
             auto numSamples = static_cast<int32_t>(length / byteRate);
@@ -262,76 +295,147 @@ namespace OpenRCT2::Audio
                 rate = channel->GetRate();
             }
 
-            bool mustConvert = false;
-            SDL_AudioCVT cvt;
-            cvt.len_ratio = 1;
-            AudioFormat streamformat = channel->GetFormat();
-            if (streamformat != _format)
+            void* buffer = nullptr;
+            size_t bufferLen = 0;
+
+            // Sound effects are resampled once per rate, all channels playing them at that rate read from the result
+            auto rateUnits = std::max<int32_t>(1, static_cast<int32_t>(std::lround(rate * ResampleRateUnits)));
+            const auto* resampled = rate != 1 ? GetResampledSound(channel, rateUnits) : nullptr;
+            if (resampled != nullptr)
             {
-                if (SDL_BuildAudioCVT(
-                        &cvt, streamformat.format, streamformat.channels, streamformat.freq, _format.format, _format.channels,
-                        _format.freq)
-                    == -1)
+                _effectBuffer.resize(length);
+                bufferLen = channel->ReadResampled(
+                    _effectBuffer.data(), length, *resampled, static_cast<double>(rateUnits) / ResampleRateUnits);
+                buffer = _effectBuffer.data();
+            }
+            else
+            {
+                bool mustConvert = false;
+                SDL_AudioCVT cvt;
+                cvt.len_ratio = 1;
+                AudioFormat streamformat = channel->GetFormat();
+                if (streamformat != _format)
                 {
-                    // Unable to convert channel data
-                    return;
+                    if (SDL_BuildAudioCVT(
+                            &cvt, streamformat.format, streamformat.channels, streamformat.freq, _format.format,
+                            _format.channels, _format.freq)
+                        == -1)
+                    {
+                        // Unable to convert channel data
+                        return;
+                    }
+                    mustConvert = true;
                 }
-                mustConvert = true;
-            }
 
-            // Read raw PCM from channel
-            int32_t readSamples = numSamples * rate;
-            auto readLength = static_cast<size_t>(readSamples / cvt.len_ratio) * byteRate;
-            _channelBuffer.resize(readLength);
-            size_t bytesRead = channel->Read(_channelBuffer.data(), readLength);
+                // Read raw PCM from channel
+                int32_t readSamples = numSamples * rate;
+                auto readLength = static_cast<size_t>(readSamples / cvt.len_ratio) * byteRate;
+                _channelBuffer.resize(readLength);
+                size_t bytesRead = channel->Read(_channelBuffer.data(), readLength);
 
-            // Convert data to required format if necessary
-            void* buffer = nullptr;
-            size_t bufferLen = 0;
-            if (mustConvert)
-            {
-                if (Convert(&cvt, _channelBuffer.data(), bytesRead))
+                // Convert data to required format if necessary
+                if (mustConvert)
                 {
-                    buffer = cvt.buf;
-                    bufferLen = cvt.len_cvt;
+                    if (Convert(&cvt, _channelBuffer.data(), bytesRead))
+                    {
+                        buffer = cvt.buf;
+                        bufferLen = cvt.len_cvt;
+                    }
+                    else
+                    {
+                        return;
+                    }
                 }
                 else
                 {
-                    return;
+                    buffer = _channelBuffer.data();
+                    bufferLen = bytesRead;
+                }
+
+                // Apply effects
+                if (rate != 1)
+                {
+                    auto inRate = static_cast<int32_t>(bufferLen / byteRate);
+                    int32_t outRate = numSamples;
+                    if (bytesRead != readLength)
+                    {
+                        inRate = _format.freq;
+                        outRate = _format.freq * (1 / rate);
+                    }
+                    _effectBuffer.resize(length);
+                    bufferLen = ApplyResample(
+                        channel, buffer, static_cast<int32_t>(bufferLen / byteRate), numSamples, inRate, outRate);
+                    buffer = _effectBuffer.data();
                 }
             }
-            else
+
+            // Apply panning and volume while adding the channel to the mix buffer
+            auto numFrames = std::min(length, bufferLen) / byteRate;
+            auto gain = GetChannelGain(channel, numFrames);
+            switch (_format.format)
+            {
+                case AUDIO_S16SYS:
+                    MixS16(_mixBuffer.data(), static_cast<const int16_t*>(buffer), numFrames, _format.channels, gain);
+                    break;
+                case AUDIO_U8:
+                    MixSamples(_mixBuffer.data(), static_cast<const uint8_t*>(buffer), numFrames, _format.channels, gain);
+                    break;
+            }
+
+            channel->UpdateOldVolume();
+        }
+
+        /**
+         * Returns the whole sound effect played by the channel resampled by the given rate, or nullptr if the channel is
+         * not playing a sound effect.
+         */
+        const std::vector<uint8_t>* GetResampledSound(const ISDLAudioChannel* channel, int32_t rateUnits)
+        {
+            auto* source = channel->GetSource();
+            auto soundId = _css1SourceIds.find(source);
+            if (soundId == _css1SourceIds.end() || channel->GetFormat() != _format)
             {
-                buffer = _channelBuffer.data();
-                bufferLen = bytesRead;
+                return nullptr;
             }
 
-            // Apply effects
-            if (rate != 1)
+            auto key = (static_cast<uint64_t>(soundId->second) << 32) | static_cast<uint32_t>(rateUnits);
+            auto it = _resampleCache.find(key);
+            if (it != _resampleCache.end())
             {
-                auto inRate = static_cast<int32_t>(bufferLen / byteRate);
-                int32_t outRate = numSamples;
-                if (bytesRead != readLength)
-                {
-                    inRate = _format.freq;
-                    outRate = _format.freq * (1 / rate);
-                }
-                _effectBuffer.resize(length);
-                bufferLen = ApplyResample(
-                    channel, buffer, static_cast<int32_t>(bufferLen / byteRate), numSamples, inRate, outRate);
-                buffer = _effectBuffer.data();
+                return &it->second;
             }
 
-            // Apply panning and volume
-            ApplyPan(channel, buffer, bufferLen, byteRate);
-            int32_t mixVolume = ApplyVolume(channel, buffer, bufferLen);
+            int32_t byteRate = _format.GetByteRate();
+            std::vector<uint8_t> srcData(static_cast<size_t>(source->GetLength()));
+            srcData.resize(source->Read(srcData.data(), 0, srcData.size()));
+            auto srcFrames = static_cast<uint32_t>(srcData.size() / byteRate);
+            auto dstFrames = static_cast<uint32_t>(static_cast<uint64_t>(srcFrames) * ResampleRateUnits / rateUnits + 1);
+            std::vector<uint8_t> data(static_cast<size_t>(dstFrames) * byteRate);
 
-            // Finally mix on to destination buffer
-            size_t dstLength = std::min(length, bufferLen);
-            SDL_MixAudioFormat(
-                data, static_cast<const uint8_t*>(buffer), _format.format, static_cast<uint32_t>(dstLength), mixVolume);
+            SpeexResamplerState* resampler = speex_resampler_init(_format.channels, rateUnits, ResampleRateUnits, 0, nullptr);
+            if (resampler == nullptr)
+            {
+                return nullptr;
+            }
+            speex_resampler_skip_zeros(resampler);
+            speex_resampler_process_interleaved_int(
+                resampler, reinterpret_cast<const spx_int16_t*>(srcData.data()), &srcFrames,
+                reinterpret_cast<spx_int16_t*>(data.data()), &dstFrames);
+            speex_resampler_destroy(resampler);
+            if (dstFrames == 0)
+            {
+                return nullptr;
+            }
+            data.resize(static_cast<size_t>(dstFrames) * byteRate);
 
-            channel->UpdateOldVolume();
+            // Vehicle sounds change their rate with the speed of the vehicle, start over rather than grow without bound
+            if (_resampleCacheSize + data.size() > ResampleCacheMaxSize)
+            {
+                _resampleCache.clear();
+                _resampleCacheSize = 0;
+            }
+            _resampleCacheSize += data.size();
+            return &(_resampleCache[key] = std::move(data));
         }
 
         /**
@@ -362,24 +466,10 @@ namespace OpenRCT2::Audio
             return outLen * byteRate;
         }
 
-        void ApplyPan(const IAudioChannel* channel, void* buffer, size_t len, size_t sampleSize)
+        ChannelGain GetChannelGain(const IAudioChannel* channel, size_t numFrames)
         {
-            if (channel->GetPan() != 0.5f && _format.channels == 2)
-            {
-                switch (_format.format)
-                {
-                    case AUDIO_S16SYS:
-                        EffectPanS16(channel, static_cast<int16_t*>(buffer), static_cast<int32_t>(len / sampleSize));
-                        break;
-                    case AUDIO_U8:
-                        EffectPanU8(channel, static_cast<uint8_t*>(buffer), static_cast<int32_t>(len / sampleSize));
-                        break;
-                }
-            }
-        }
+            static_assert(SDL_MIX_MAXVOLUME == MIXER_VOLUME_MAX, "Max volume differs between OpenRCT2 and SDL2");
 
-        int32_t ApplyVolume(const IAudioChannel* channel, void* buffer, size_t len)
-        {
             float volumeAdjust = _volume;
             volumeAdjust *= gConfigSound.master_sound_enabled ? (static_cast<float>(gConfigSound.master_volume) / 100.0f)
                                                               : 0.0f;
@@ -401,6 +491,7 @@ namespace OpenRCT2::Audio
                     break;
             }
 
+            // Fade between volume levels to smooth out sound and minimize clicks from sudden volume changes
             int32_t startVolume = channel->GetOldVolume() * volumeAdjust;
             int32_t endVolume = channel->GetVolume() * volumeAdjust;
             if (channel->IsStopping())
@@ -408,82 +499,121 @@ namespace OpenRCT2::Audio
                 endVolume = 0;
             }
 
-            int32_t mixVolume = channel->GetVolume() * volumeAdjust;
-            if (startVolume != endVolume)
+            float startPan[2] = { 1.0f, 1.0f };
+            float endPan[2] = { 1.0f, 1.0f };
+            if (channel->GetPan() != 0.5f && _format.channels == 2)
             {
-                // Set to max since we are adjusting the volume ourselves
-                mixVolume = MIXER_VOLUME_MAX;
+                startPan[0] = channel->GetOldVolumeL();
+                startPan[1] = channel->GetOldVolumeR();
+                endPan[0] = channel->GetVolumeL();
+                endPan[1] = channel->GetVolumeR();
+            }
 
-                // Fade between volume levels to smooth out sound and minimize clicks from sudden volume changes
-                int32_t fadeLength = static_cast<int32_t>(len) / _format.BytesPerSample();
-                switch (_format.format)
-                {
-                    case AUDIO_S16SYS:
-                        EffectFadeS16(static_cast<int16_t*>(buffer), fadeLength, startVolume, endVolume);
-                        break;
-                    case AUDIO_U8:
-                        EffectFadeU8(static_cast<uint8_t*>(buffer), fadeLength, startVolume, endVolume);
-                        break;
-                }
+            ChannelGain gain;
+            for (int32_t i = 0; i < 2; i++)
+            {
+                float start = startPan[i] * startVolume / SDL_MIX_MAXVOLUME;
+                float end = endPan[i] * endVolume / SDL_MIX_MAXVOLUME;
+                gain.Start[i] = start;
+                gain.Step[i] = numFrames != 0 ? (end - start) / numFrames : 0.0f;
             }
-            return mixVolume;
+            return gain;
         }
 
-        static void EffectPanS16(const IAudioChannel* channel, int16_t* data, int32_t length)
+        static float SampleToFloat(int16_t sample)
         {
-            const float dt = 1.0f / static_cast<float>(length * 2.0f);
-            float volumeL = channel->GetOldVolumeL();
-            float volumeR = channel->GetOldVolumeR();
-            const float d_left = dt * (channel->GetVolumeL() - channel->GetOldVolumeL());
-            const float d_right = dt * (channel->GetVolumeR() - channel->GetOldVolumeR());
-
-            for (int32_t i = 0; i < length * 2; i += 2)
-            {
-                data[i + 0] = static_cast<int16_t>(volumeL * static_cast<float>(data[i + 0]));
-                data[i + 1] = static_cast<int16_t>(volumeR * static_cast<float>(data[i + 1]));
-                volumeL += d_left;
-                volumeR += d_right;
-            }
+            return sample;
         }
 
-        static void EffectPanU8(const IAudioChannel* channel, uint8_t* data, int32_t length)
+        static float SampleToFloat(uint8_t sample)
         {
-            float volumeL = channel->GetVolumeL();
-            float volumeR = channel->GetVolumeR();
-            float oldVolumeL = channel->GetOldVolumeL();
-            float oldVolumeR = channel->GetOldVolumeR();
+            return (sample - 128) * 256.0f;
+        }
 
-            for (int32_t i = 0; i < length * 2; i += 2)
+        /**
+         * Adds the frames to the mix buffer, the left gain applies to all output channels unless there are two of them.
+         */
+        template<typename T>
+        static void MixSamples(
+            float* RESTRICT dst, const T* RESTRICT src, size_t numFrames, int32_t numChannels, const ChannelGain& gain,
+            size_t startFrame = 0)
+        {
+            for (size_t i = startFrame; i < numFrames; i++)
             {
-                float t = static_cast<float>(i) / static_cast<float>(length * 2.0f);
-                data[i] = static_cast<uint8_t>(data[i] * ((1.0 - t) * oldVolumeL + t * volumeL));
-                data[i + 1] = static_cast<uint8_t>(data[i + 1] * ((1.0 - t) * oldVolumeR + t * volumeR));
+                for (int32_t c = 0; c < numChannels; c++)
+                {
+                    int32_t side = numChannels == 2 ? c : 0;
+                    size_t index = i * numChannels + c;
+                    dst[index] += SampleToFloat(src[index]) * (gain.Start[side] + gain.Step[side] * i);
+                }
             }
         }
 
-        static void EffectFadeS16(int16_t* data, int32_t length, int32_t startvolume, int32_t endvolume)
+        static void MixS16(
+            float* RESTRICT dst, const int16_t* RESTRICT src, size_t numFrames, int32_t numChannels, const ChannelGain& gain)
         {
-            static_assert(SDL_MIX_MAXVOLUME == MIXER_VOLUME_MAX, "Max volume differs between OpenRCT2 and SDL2");
-
-            float startvolume_f = static_cast<float>(startvolume) / SDL_MIX_MAXVOLUME;
-            float endvolume_f = static_cast<float>(endvolume) / SDL_MIX_MAXVOLUME;
-            for (int32_t i = 0; i < length; i++)
+            size_t i = 0;
+#ifdef AUDIO_MIXER_SSE2
+            if (numChannels == 2)
             {
-                float t = static_cast<float>(i) / length;
-                data[i] = static_cast<int16_t>(data[i] * ((1.0f - t) * startvolume_f + t * endvolume_f));
+                // Four stereo frames at a time, the gains of the first and last two frames are kept in separate vectors
+                const auto step = _mm_setr_ps(gain.Step[0] * 4, gain.Step[1] * 4, gain.Step[0] * 4, gain.Step[1] * 4);
+                auto gainLo = _mm_setr_ps(
+                    gain.Start[0], gain.Start[1], gain.Start[0] + gain.Step[0], gain.Start[1] + gain.Step[1]);
+                auto gainHi = _mm_add_ps(
+                    gainLo, _mm_setr_ps(gain.Step[0] * 2, gain.Step[1] * 2, gain.Step[0] * 2, gain.Step[1] * 2));
+                for (; i + 4 <= numFrames; i += 4)
+                {
+                    auto samples = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 2));
+                    // Sign extend the samples to 32 bits by moving them to the upper half and shifting them back down
+                    auto lo = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(samples, samples), 16));
+                    auto hi = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(samples, samples), 16));
+                    float* out = dst + i * 2;
+                    _mm_storeu_ps(out, _mm_add_ps(_mm_loadu_ps(out), _mm_mul_ps(lo, gainLo)));
+                    _mm_storeu_ps(out + 4, _mm_add_ps(_mm_loadu_ps(out + 4), _mm_mul_ps(hi, gainHi)));
+                    gainLo = _mm_add_ps(gainLo, step);
+                    gainHi = _mm_add_ps(gainHi, step);
+                }
             }
+#endif
+            MixSamples(dst, src, numFrames, numChannels, gain, i);
         }
 
-        static void EffectFadeU8(uint8_t* data, int32_t length, int32_t startvolume, int32_t endvolume)
+        void WriteMixBuffer(uint8_t* dst, size_t numSamples)
         {
-            static_assert(SDL_MIX_MAXVOLUME == MIXER_VOLUME_MAX, "Max volume differs between OpenRCT2 and SDL2");
-
-            float startvolume_f = static_cast<float>(startvolume) / SDL_MIX_MAXVOLUME;
-            float endvolume_f = static_cast<float>(endvolume) / SDL_MIX_MAXVOLUME;
-            for (int32_t i = 0; i < length; i++)
+            const float* src = _mixBuffer.data();
+            switch (_format.format)
             {
-                float t = static_cast<float>(i) / length;
-                data[i] = static_cast<uint8_t>(data[i] * ((1.0f - t) * startvolume_f + t * endvolume_f));
+                case AUDIO_S16SYS:
+                {
+                    auto* dst16 = reinterpret_cast<int16_t*>(dst);
+                    size_t i = 0;
+#ifdef AUDIO_MIXER_SSE2
+                    // Clamp first, out of range values would convert to INT32_MIN before being saturated to 16 bits
+                    const auto min = _mm_set1_ps(INT16_MIN);
+                    const auto max = _mm_set1_ps(INT16_MAX);
+                    for (; i + 8 <= numSamples; i += 8)
+                    {
+                        auto lo = _mm_cvtps_epi32(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(src + i), min), max));
+                        auto hi = _mm_cvtps_epi32(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(src + i + 4), min), max));
+                        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst16 + i), _mm_packs_epi32(lo, hi));
+                    }
+#endif
+                    for (; i < numSamples; i++)
+                    {
+                        dst16[i] = static_cast<int16_t>(std::lrint(std::clamp<float>(src[i], INT16_MIN, INT16_MAX)));
+                    }
+                    break;
+                }
+                case AUDIO_U8:
+                    for (size_t i = 0; i < numSamples; i++)
+                    {
+                        dst[i] = static_cast<uint8_t>(std::lrint(std::clamp<float>(src[i] / 256.0f + 128.0f, 0, UINT8_MAX)));
+                    }
+                    break;
+                default:
+                    std::fill_n(dst, numSamples * _format.BytesPerSample(), 0);
+                    break;
             }
         }
 
@@ -12,41 +12,138 @@
 
 #include <SDL.h>
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
 #include <openrct2/audio/AudioSource.h>
 #include <openrct2/common.h>
+#include <thread>
+#include <vector>
 
 namespace OpenRCT2::Audio
 {
     /**
-     * An audio source where raw PCM data is streamed directly from
-     * a file.
+     * The PCM data of a streamed WAV file, read ahead into a ring buffer by the stream thread so the audio callback
+     * only has to copy it. Reads that do not continue where the buffer is, such as after a seek, are served from the
+     * file directly and make the stream thread carry on after them.
      */
-    class FileAudioSource final : public ISDLAudioSource
+    class AudioStream
     {
     private:
-        AudioFormat _format = {};
+        // How far ahead of playback the stream thread reads and how much it reads at a time
+        static constexpr int32_t BufferSeconds = 2;
+        static constexpr size_t ReadChunkSize = 32 * 1024;
+
         SDL_RWops* _rw = nullptr;
         uint64_t _dataBegin = 0;
         uint64_t _dataLength = 0;
+        std::mutex _fileMutex;
+
+        std::mutex _bufferMutex;
+        std::vector<uint8_t> _buffer;
+        size_t _bufferStart = 0;
+        size_t _bufferSize = 0;
+        // Offsets in the data of the first buffered byte and the next byte read by the stream thread
+        uint64_t _bufferOffset = 0;
+        uint64_t _readOffset = 0;
+        // Changed when the buffer is discarded, so data the stream thread read before is not added to it
+        uint32_t _generation = 0;
 
     public:
-        ~FileAudioSource() override
+        std::atomic<bool> Closed{};
+
+        AudioStream(SDL_RWops* rw, uint64_t dataBegin, uint64_t dataLength, const AudioFormat& format)
+            : _rw(rw)
+            , _dataBegin(dataBegin)
+            , _dataLength(dataLength)
+            , _buffer(static_cast<size_t>(format.freq) * format.GetByteRate() * BufferSeconds)
         {
-            Unload();
         }
 
-        [[nodiscard]] uint64_t GetLength() const override
+        AudioStream(const AudioStream&) = delete;
+        AudioStream& operator=(const AudioStream&) = delete;
+
+        ~AudioStream()
         {
-            return _dataLength;
+            SDL_RWclose(_rw);
         }
 
-        [[nodiscard]] AudioFormat GetFormat() const override
+        size_t Read(void* dst, uint64_t offset, size_t len)
         {
-            return _format;
+            {
+                std::lock_guard<std::mutex> lock(_bufferMutex);
+                if (offset == _bufferOffset && _bufferSize != 0)
+                {
+                    auto bytesToRead = static_cast<size_t>(std::min<uint64_t>({ len, _bufferSize, _dataLength - offset }));
+                    CopyFromBuffer(static_cast<uint8_t*>(dst), bytesToRead);
+                    return bytesToRead;
+                }
+            }
+
+            size_t bytesRead = ReadFile(dst, offset, len);
+
+            // Anything buffered meanwhile was read from the old position
+            std::lock_guard<std::mutex> lock(_bufferMutex);
+            _generation++;
+            _bufferStart = 0;
+            _bufferSize = 0;
+            _bufferOffset = (offset + bytesRead) % _dataLength;
+            _readOffset = _bufferOffset;
+            return bytesRead;
         }
 
-        size_t Read(void* dst, uint64_t offset, size_t len) override
+        /**
+         * Reads the next chunk into the buffer, returns false if the buffer is already full.
+         */
+        bool Fill(std::vector<uint8_t>& chunk)
+        {
+            uint64_t offset;
+            uint32_t generation;
+            {
+                std::lock_guard<std::mutex> lock(_bufferMutex);
+                size_t space = _buffer.size() - _bufferSize;
+                if (space == 0 || _dataLength == 0)
+                {
+                    return false;
+                }
+                chunk.resize(std::min(space, ReadChunkSize));
+                offset = _readOffset;
+                generation = _generation;
+            }
+
+            // Music loops, once the end is buffered carry on from the start
+            size_t bytesRead = ReadFile(chunk.data(), offset, chunk.size());
+
+            std::lock_guard<std::mutex> lock(_bufferMutex);
+            if (generation == _generation)
+            {
+                bytesRead = std::min(bytesRead, _buffer.size() - _bufferSize);
+                size_t end = (_bufferStart + _bufferSize) % _buffer.size();
+                size_t firstPart = std::min(bytesRead, _buffer.size() - end);
+                std::copy_n(chunk.data(), firstPart, _buffer.data() + end);
+                std::copy_n(chunk.data() + firstPart, bytesRead - firstPart, _buffer.data());
+                _bufferSize += bytesRead;
+                _readOffset = (offset + bytesRead) % _dataLength;
+            }
+            return bytesRead != 0;
+        }
+
+    private:
+        void CopyFromBuffer(uint8_t* dst, size_t len)
+        {
+            size_t firstPart = std::min(len, _buffer.size() - _bufferStart);
+            std::copy_n(_buffer.data() + _bufferStart, firstPart, dst);
+            std::copy_n(_buffer.data(), len - firstPart, dst + firstPart);
+            _bufferStart = (_bufferStart + len) % _buffer.size();
+            _bufferSize -= len;
+            _bufferOffset = (_bufferOffset + len) % _dataLength;
+        }
+
+        size_t ReadFile(void* dst, uint64_t offset, size_t len)
         {
+            std::lock_guard<std::mutex> lock(_fileMutex);
             size_t bytesRead = 0;
             int64_t currentPosition = SDL_RWtell(_rw);
             if (currentPosition != -1)
@@ -65,6 +162,122 @@ namespace OpenRCT2::Audio
             }
             return bytesRead;
         }
+    };
+
+    /**
+     * Keeps the buffers of all open streams filled. Streams are dropped once their source is closed, the file is then
+     * closed by whichever of the two lets go of the stream last.
+     */
+    class AudioStreamThread
+    {
+    private:
+        static constexpr std::chrono::milliseconds IdleWaitTime{ 10 };
+
+        std::mutex _mutex;
+        std::condition_variable _condition;
+        std::vector<std::shared_ptr<AudioStream>> _streams;
+        bool _shouldStop = false;
+        std::thread _thread;
+
+    public:
+        AudioStreamThread()
+        {
+            _thread = std::thread(&AudioStreamThread::Run, this);
+        }
+
+        ~AudioStreamThread()
+        {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _shouldStop = true;
+            }
+            _condition.notify_one();
+            _thread.join();
+        }
+
+        static AudioStreamThread& Get()
+        {
+            static AudioStreamThread instance;
+            return instance;
+        }
+
+        void Add(std::shared_ptr<AudioStream> stream)
+        {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _streams.push_back(std::move(stream));
+            }
+            _condition.notify_one();
+        }
+
+    private:
+        void Run()
+        {
+            std::vector<std::shared_ptr<AudioStream>> streams;
+            std::vector<uint8_t> chunk;
+            for (;;)
+            {
+                {
+                    std::unique_lock<std::mutex> lock(_mutex);
+                    _streams.erase(
+                        std::remove_if(
+                            _streams.begin(), _streams.end(), [](const auto& stream) { return stream->Closed.load(); }),
+                        _streams.end());
+                    streams = _streams;
+                }
+
+                bool filled = false;
+                for (auto& stream : streams)
+                {
+                    filled |= stream->Fill(chunk);
+                }
+                streams.clear();
+
+                std::unique_lock<std::mutex> lock(_mutex);
+                if (!filled)
+                {
+                    _condition.wait_for(lock, IdleWaitTime, [this]() { return _shouldStop; });
+                }
+                if (_shouldStop)
+                {
+                    break;
+                }
+            }
+        }
+    };
+
+    /**
+     * An audio source where raw PCM data is streamed from a file, read ahead on the audio stream thread.
+     */
+    class FileAudioSource final : public ISDLAudioSource
+    {
+    private:
+        AudioFormat _format = {};
+        SDL_RWops* _rw = nullptr;
+        uint64_t _dataBegin = 0;
+        uint64_t _dataLength = 0;
+        std::shared_ptr<AudioStream> _stream;
+
+    public:
+        ~FileAudioSource() override
+        {
+            Unload();
+        }
+
+        [[nodiscard]] uint64_t GetLength() const override
+        {
+            return _dataLength;
+        }
+
+        [[nodiscard]] AudioFormat GetFormat() const override
+        {
+            return _format;
+        }
+
+        size_t Read(void* dst, uint64_t offset, size_t len) override
+        {
+            return _stream != nullptr ? _stream->Read(dst, offset, len) : 0;
+        }
 
         bool LoadWAV(SDL_RWops* rw)
         {
@@ -140,6 +353,11 @@ namespace OpenRCT2::Audio
 
             _dataLength = dataChunkSize;
             _dataBegin = SDL_RWtell(rw);
+
+            // The stream owns the file from now on
+            _stream = std::make_shared<AudioStream>(rw, _dataBegin, _dataLength, _format);
+            _rw = nullptr;
+            AudioStreamThread::Get().Add(_stream);
             return true;
         }
 
@@ -171,6 +389,11 @@ namespace OpenRCT2::Audio
 
         void Unload()
         {
+            if (_stream != nullptr)
+            {
+                _stream->Closed = true;
+                _stream = nullptr;
+            }
             if (_rw != nullptr)
             {
                 SDL_RWclose(_rw);
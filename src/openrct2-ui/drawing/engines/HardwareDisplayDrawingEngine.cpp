@@ -10,10 +10,14 @@
 #include "DrawingEngineFactory.hpp"
 
 #include <SDL.h>
+#include <algorithm>
 #include <cmath>
+#include <cstring>
+#include <memory>
 #include <openrct2/Game.h>
 #include <openrct2/common.h>
 #include <openrct2/config/Config.h>
+#include <openrct2/core/JobPool.h>
 #include <openrct2/drawing/IDrawingEngine.h>
 #include <openrct2/drawing/LightFX.h>
 #include <openrct2/drawing/X8DrawingEngine.h>
@@ -29,6 +33,8 @@ class HardwareDisplayDrawingEngine final : public X8DrawingEngine
 {
 private:
     constexpr static uint32_t DIRTY_VISUAL_TIME = 32;
+    // Rows of the frame each job converts when the whole frame is converted at once
+    constexpr static int32_t CONVERSION_BAND_HEIGHT = 64;
 
     std::shared_ptr<IUiContext> const _uiContext;
     SDL_Window* _window = nullptr;
@@ -50,6 +56,15 @@ private:
 
     std::vector<uint32_t> _dirtyVisualsTime;
 
+    // The frame as it was last converted to the screen texture, only the blocks that differ from it are uploaded.
+    // Weather, the cursor and the overlays are drawn outside of the dirty blocks, so the frame is compared rather
+    // than relying on the dirty grid alone.
+    std::vector<uint8_t> _uploadedBits;
+    bool _uploadAll = true;
+
+    // Converts bands of the frame at once, the whole frame is converted every frame the palette is animated
+    std::unique_ptr<JobPool> _conversionJobs;
+
     bool smoothNN = false;
 
 public:
@@ -153,15 +168,23 @@ public:
         _screenTextureFormat = SDL_AllocFormat(format);
 
         ConfigureBits(width, height, width);
+        _uploadedBits.resize(_bitsSize);
+        _uploadAll = true;
     }
 
     void SetPalette(const GamePalette& palette) override
     {
         if (_screenTextureFormat != nullptr)
         {
+            // The palette is set every frame, every pixel only needs converting again when a colour changed
             for (int32_t i = 0; i < 256; i++)
             {
-                _paletteHWMapped[i] = SDL_MapRGB(_screenTextureFormat, palette[i].Red, palette[i].Green, palette[i].Blue);
+                auto colour = SDL_MapRGB(_screenTextureFormat, palette[i].Red, palette[i].Green, palette[i].Blue);
+                if (_paletteHWMapped[i] != colour)
+                {
+                    _paletteHWMapped[i] = colour;
+                    _uploadAll = true;
+                }
             }
 
 #ifdef __ENABLE_LIGHTFX__
@@ -217,12 +240,12 @@ private:
                 lightfx_render_to_texture(pixels, pitch, _bits, _width, _height, _paletteHWMapped, _lightPaletteHWMapped);
                 SDL_UnlockTexture(_screenTexture);
             }
+            _uploadAll = true;
         }
         else
 #endif
         {
-            CopyBitsToTexture(
-                _screenTexture, _bits, static_cast<int32_t>(_width), static_cast<int32_t>(_height), _paletteHWMapped);
+            UpdateScreenTexture();
         }
         if (smoothNN)
         {
@@ -256,6 +279,21 @@ private:
         }
     }
 
+    void UpdateScreenTexture()
+    {
+        if (_uploadAll || _screenTextureFormat == nullptr || SDL_BYTESPERPIXEL(_screenTextureFormat->format) != 4)
+        {
+            CopyBitsToTexture(
+                _screenTexture, _bits, static_cast<int32_t>(_width), static_cast<int32_t>(_height), _paletteHWMapped);
+            std::copy_n(_bits, _uploadedBits.size(), _uploadedBits.data());
+            _uploadAll = false;
+        }
+        else
+        {
+            CopyChangedBlocksToTexture();
+        }
+    }
+
     void CopyBitsToTexture(SDL_Texture* texture, uint8_t* src, int32_t width, int32_t height, const uint32_t* palette)
     {
         void* pixels;
@@ -265,11 +303,7 @@ private:
             int32_t padding = pitch - (width * 4);
             if (pitch == width * 4)
             {
-                uint32_t* dst = static_cast<uint32_t*>(pixels);
-                for (int32_t i = width * height; i > 0; i--)
-                {
-                    *dst++ = palette[*src++];
-                }
+                ExpandPaletteBands(src, static_cast<uint32_t*>(pixels), width, height, palette);
             }
             else
             {
@@ -304,6 +338,115 @@ private:
         }
     }
 
+    static void ExpandPalette(const uint8_t* src, uint32_t* dst, size_t count, const uint32_t* palette)
+    {
+        // Lookups are independent, unrolling lets several of them be in flight at once
+        for (; count >= 4; count -= 4)
+        {
+            dst[0] = palette[src[0]];
+            dst[1] = palette[src[1]];
+            dst[2] = palette[src[2]];
+            dst[3] = palette[src[3]];
+            src += 4;
+            dst += 4;
+        }
+        for (; count > 0; count--)
+        {
+            *dst++ = palette[*src++];
+        }
+    }
+
+    void ExpandPaletteBands(const uint8_t* src, uint32_t* dst, int32_t width, int32_t height, const uint32_t* palette)
+    {
+        const auto numBands = static_cast<size_t>((height + CONVERSION_BAND_HEIGHT - 1) / CONVERSION_BAND_HEIGHT);
+        auto expandBand = [=](size_t band) {
+            const auto top = static_cast<int32_t>(band) * CONVERSION_BAND_HEIGHT;
+            const auto rows = std::min(CONVERSION_BAND_HEIGHT, height - top);
+            const auto offset = static_cast<size_t>(top) * width;
+            ExpandPalette(src + offset, dst + offset, static_cast<size_t>(rows) * width, palette);
+        };
+
+        if (!gConfigGeneral.multithreading)
+        {
+            _conversionJobs.reset();
+        }
+        else if (_conversionJobs == nullptr)
+        {
+            _conversionJobs = std::make_unique<JobPool>();
+        }
+
+        if (_conversionJobs != nullptr && numBands > 1)
+        {
+            _conversionJobs->ParallelFor(0, numBands, 1, expandBand);
+        }
+        else
+        {
+            for (size_t band = 0; band < numBands; band++)
+            {
+                expandBand(band);
+            }
+        }
+    }
+
+    bool HasBlockChanged(uint32_t left, uint32_t top, uint32_t width, uint32_t height) const
+    {
+        for (uint32_t y = top; y < top + height; y++)
+        {
+            size_t offset = static_cast<size_t>(y) * _pitch + left;
+            if (std::memcmp(_bits + offset, _uploadedBits.data() + offset, width) != 0)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * Converts and uploads the blocks of the dirty grid that changed since the last upload, one span of blocks per row
+     * of the grid. Only used with 32 bit texture formats.
+     */
+    void CopyChangedBlocksToTexture()
+    {
+        const uint32_t blockWidth = _dirtyGrid.BlockWidth;
+        const uint32_t blockHeight = _dirtyGrid.BlockHeight;
+        for (uint32_t top = 0; top < _height; top += blockHeight)
+        {
+            const uint32_t height = std::min(blockHeight, _height - top);
+            uint32_t left = _width;
+            uint32_t right = 0;
+            for (uint32_t x = 0; x < _width; x += blockWidth)
+            {
+                const uint32_t width = std::min(blockWidth, _width - x);
+                if (HasBlockChanged(x, top, width, height))
+                {
+                    left = std::min(left, x);
+                    right = x + width;
+                }
+            }
+            if (left >= right)
+            {
+                continue;
+            }
+
+            SDL_Rect rect = { static_cast<int32_t>(left), static_cast<int32_t>(top), static_cast<int32_t>(right - left),
+                              static_cast<int32_t>(height) };
+            void* pixels;
+            int32_t pitch;
+            if (SDL_LockTexture(_screenTexture, &rect, &pixels, &pitch) != 0)
+            {
+                continue;
+            }
+            for (uint32_t y = 0; y < height; y++)
+            {
+                size_t offset = static_cast<size_t>(top + y) * _pitch + left;
+                auto* dst = reinterpret_cast<uint32_t*>(static_cast<uint8_t*>(pixels) + y * pitch);
+                ExpandPalette(_bits + offset, dst, right - left, _paletteHWMapped);
+                std::copy_n(_bits + offset, right - left, _uploadedBits.data() + offset);
+            }
+            SDL_UnlockTexture(_screenTexture);
+        }
+    }
+
     uint32_t GetDirtyVisualTime(uint32_t x, uint32_t y)
     {
         uint32_t result = 0;
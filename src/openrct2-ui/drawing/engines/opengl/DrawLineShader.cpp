@@ -78,6 +78,7 @@ DrawLineShader::DrawLineShader()
 DrawLineShader::~DrawLineShader()
 {
     glDeleteBuffers(1, &_vbo);
+    glDeleteBuffers(1, &_vboInstances);
     glDeleteVertexArrays(1, &_vao);
 }
 
@@ -103,7 +104,8 @@ void DrawLineShader::DrawInstances(const LineCommandBatch& instances)
     glBindVertexArray(_vao);
 
     glBindBuffer(GL_ARRAY_BUFFER, _vboInstances);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(DrawLineCommand) * instances.size(), instances.data(), GL_STREAM_DRAW);
+    OpenGLAPI::StreamBufferData(
+        GL_ARRAY_BUFFER, _instancesCapacity, sizeof(DrawLineCommand) * instances.size(), instances.data());
 
     glDrawArraysInstanced(GL_LINES, 0, 2, static_cast<GLsizei>(instances.size()));
 }
@@ -43,6 +43,7 @@ private:
     GLuint _vboInstances;
     GLuint _vao;
 
+    GLsizeiptr _instancesCapacity = 0;
     GLsizei _instanceCount = 0;
 
 public:
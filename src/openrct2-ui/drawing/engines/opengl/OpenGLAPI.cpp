@@ -11,6 +11,8 @@
 
 #    include "OpenGLAPI.h"
 
+#    include <algorithm>
+
 #    if OPENGL_NO_LINK
 
 #        define OPENGL_PROC(TYPE, PROC) TYPE PROC = nullptr;
@@ -59,6 +61,16 @@ void OpenGLAPI::SetTexture(uint16_t index, GLenum type, GLuint texture)
     glBindTexture(type, texture);
 }
 
+void OpenGLAPI::StreamBufferData(GLenum target, GLsizeiptr& capacity, GLsizeiptr size, const void* data)
+{
+    if (size > capacity)
+    {
+        capacity = std::max(size, capacity * 2);
+    }
+    glBufferData(target, capacity, nullptr, GL_STREAM_DRAW);
+    glBufferSubData(target, 0, size, data);
+}
+
 bool OpenGLAPI::Initialise()
 {
     OpenGLState::Reset();
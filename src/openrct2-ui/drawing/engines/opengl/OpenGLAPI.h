@@ -38,6 +38,7 @@
 #    define glTexImage3D __static__glTexImage3D
 #    define glGetIntegerv __static__glGetIntegerv
 #    define glGetTexImage __static__glGetTexImage
+#    define glCopyTexSubImage3D __static__glCopyTexSubImage3D
 
 #endif
 
@@ -74,6 +75,7 @@
 #    undef glTexImage3D
 #    undef glGetIntegerv
 #    undef glGetTexImage
+#    undef glCopyTexSubImage3D
 
 // 1.1 function signatures
 using PFNGLBEGINPROC = void(APIENTRYP)(GLenum mode);
@@ -127,6 +129,12 @@ namespace OpenGLAPI
 {
     bool Initialise();
     void SetTexture(uint16_t index, GLenum type, GLuint texture);
+
+    /**
+     * Uploads data to the buffer bound to target for a single use, orphaning the previous storage. The storage only
+     * grows, so its size stays the same from frame to frame and the driver can recycle it.
+     */
+    void StreamBufferData(GLenum target, GLsizeiptr& capacity, GLsizeiptr size, const void* data);
 } // namespace OpenGLAPI
 
 namespace OpenGLState
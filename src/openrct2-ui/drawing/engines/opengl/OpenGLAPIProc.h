@@ -36,6 +36,7 @@ OPENGL_PROC(PFNGLTEXSUBIMAGE3DPROC, glTexSubImage3D)
 OPENGL_PROC(PFNGLTEXIMAGE3DPROC, glTexImage3D)
 OPENGL_PROC(PFNGLGETINTERGERVPROC, glGetIntegerv)
 OPENGL_PROC(PFNGLGETTEXIMAGEPROC, glGetTexImage)
+OPENGL_PROC(PFNGLCOPYTEXSUBIMAGE3DPROC, glCopyTexSubImage3D)
 
 // 2.0+ function pointers
 OPENGL_PROC(PFNGLATTACHSHADERPROC, glAttachShader)
@@ -45,6 +46,7 @@ OPENGL_PROC(PFNGLBINDFRAMEBUFFERPROC, glBindFramebuffer)
 OPENGL_PROC(PFNGLBINDVERTEXARRAYPROC, glBindVertexArray)
 OPENGL_PROC(PFNGLBLITFRAMEBUFFERPROC, glBlitFramebuffer)
 OPENGL_PROC(PFNGLBUFFERDATAPROC, glBufferData)
+OPENGL_PROC(PFNGLBUFFERSUBDATAPROC, glBufferSubData)
 OPENGL_PROC(PFNGLCLEARBUFFERFVPROC, glClearBufferfv)
 OPENGL_PROC(PFNGLCLEARBUFFERUIVPROC, glClearBufferuiv)
 OPENGL_PROC(PFNGLCOMPILESHADERPROC, glCompileShader)
@@ -58,6 +60,7 @@ OPENGL_PROC(PFNGLDELETEVERTEXARRAYSPROC, glDeleteVertexArrays)
 OPENGL_PROC(PFNGLDETACHSHADERPROC, glDetachShader)
 OPENGL_PROC(PFNGLENABLEVERTEXATTRIBARRAYPROC, glEnableVertexAttribArray)
 OPENGL_PROC(PFNGLFRAMEBUFFERTEXTURE2DPROC, glFramebufferTexture2D)
+OPENGL_PROC(PFNGLFRAMEBUFFERTEXTURELAYERPROC, glFramebufferTextureLayer)
 OPENGL_PROC(PFNGLGETATTRIBLOCATIONPROC, glGetAttribLocation)
 OPENGL_PROC(PFNGLGENBUFFERSPROC, glGenBuffers)
 OPENGL_PROC(PFNGLGENFRAMEBUFFERSPROC, glGenFramebuffers)
@@ -144,32 +144,23 @@ public:
         uint8_t patternStartXOffset = xStart % patternXSpace;
         uint8_t patternStartYOffset = yStart % patternYSpace;
 
-        const auto* dpi = _drawingContext->GetDPI();
-
-        uint32_t pixelOffset = (dpi->pitch + dpi->width) * y + x;
         uint8_t patternYPos = patternStartYOffset % patternYSpace;
 
-        for (; height != 0; height--)
+        // Most rows of the patterns are empty, the screen position of each drop follows from its row and column
+        // instead of being derived from an offset into the screen bits
+        for (int32_t pixelY = y; pixelY < y + height; pixelY++)
         {
             auto patternX = pattern[patternYPos * 2];
             if (patternX != 0xFF)
             {
-                uint32_t finalPixelOffset = width + pixelOffset;
-
-                uint32_t xPixelOffset = pixelOffset;
-                xPixelOffset += (static_cast<uint8_t>(patternX - patternStartXOffset)) % patternXSpace;
-
                 auto patternPixel = pattern[patternYPos * 2 + 1];
-                for (; xPixelOffset < finalPixelOffset; xPixelOffset += patternXSpace)
+                int32_t pixelX = x + (static_cast<uint8_t>(patternX - patternStartXOffset)) % patternXSpace;
+                for (; pixelX < x + width; pixelX += patternXSpace)
                 {
-                    int32_t pixelX = xPixelOffset % dpi->width;
-                    int32_t pixelY = (xPixelOffset / dpi->width) % dpi->height;
-
                     _drawingContext->DrawLine(patternPixel, { { pixelX, pixelY }, { pixelX + 1, pixelY + 1 } });
                 }
             }
 
-            pixelOffset += dpi->pitch + dpi->width;
             patternYPos++;
             patternYPos %= patternYSpace;
         }
@@ -296,12 +287,14 @@ public:
     {
         assert(_screenFramebuffer != nullptr);
 
+        _drawingContext->GetTextureCache()->BeginFrame();
         _drawingContext->StartNewDraw();
     }
 
     void EndDraw() override
     {
         _drawingContext->FlushCommandBuffers();
+        _drawingContext->GetTextureCache()->EndFrame();
 
         glDisable(GL_DEPTH_TEST);
         if (_scaleFramebuffer != nullptr)
@@ -379,6 +372,12 @@ public:
         _drawingContext->GetTextureCache()->InvalidateImage(image);
     }
 
+    DrawingEngineDirtyStats GetLastFrameDirtyStats() override
+    {
+        // The whole screen is redrawn every frame
+        return { 0, 1, static_cast<uint64_t>(_width) * _height, static_cast<uint64_t>(_width) * _height };
+    }
+
     rct_drawpixelinfo* GetDPI()
     {
         return &_bitsDPI;
@@ -692,7 +691,12 @@ void OpenGLDrawingContext::DrawSprite(uint32_t image, int32_t x, int32_t y, uint
     right += _spriteOffset.x;
     bottom += _spriteOffset.y;
 
-    const auto texture = _textureCache->GetOrLoadImageTexture(image);
+    const auto texture = _textureCache->TryGetOrLoadImageTexture(image);
+    if (!texture.has_value())
+    {
+        // The image is still being decoded, it is drawn in a later frame once it has been uploaded
+        return;
+    }
 
     int paletteCount;
     ivec3 palettes{};
@@ -731,10 +735,10 @@ void OpenGLDrawingContext::DrawSprite(uint32_t image, int32_t x, int32_t y, uint
         DrawRectCommand& command = _commandBuffers.transparent.allocate();
 
         command.clip = { _clipLeft, _clipTop, _clipRight, _clipBottom };
-        command.texColourAtlas = texture.index;
-        command.texColourBounds = texture.normalizedBounds;
-        command.texMaskAtlas = texture.index;
-        command.texMaskBounds = texture.normalizedBounds;
+        command.texColourAtlas = texture->index;
+        command.texColourBounds = texture->normalizedBounds;
+        command.texMaskAtlas = texture->index;
+        command.texMaskBounds = texture->normalizedBounds;
         command.palettes = palettes;
         command.colour = palettes.x - (special ? 1 : 0);
         command.bounds = { left, top, right, bottom };
@@ -746,8 +750,8 @@ void OpenGLDrawingContext::DrawSprite(uint32_t image, int32_t x, int32_t y, uint
         DrawRectCommand& command = _commandBuffers.rects.allocate();
 
         command.clip = { _clipLeft, _clipTop, _clipRight, _clipBottom };
-        command.texColourAtlas = texture.index;
-        command.texColourBounds = texture.normalizedBounds;
+        command.texColourAtlas = texture->index;
+        command.texColourBounds = texture->normalizedBounds;
         command.texMaskAtlas = 0;
         command.texMaskBounds = { 0.0f, 0.0f, 0.0f, 0.0f };
         command.palettes = palettes;
@@ -12,7 +12,10 @@
 #    include "TextureCache.h"
 
 #    include <algorithm>
+#    include <openrct2/config/Config.h>
+#    include <openrct2/core/JobPool.h>
 #    include <openrct2/drawing/Drawing.h>
+#    include <openrct2/sprites.h>
 #    include <openrct2/util/Util.h>
 #    include <openrct2/world/Location.hpp>
 #    include <stdexcept>
@@ -20,9 +23,34 @@
 
 constexpr uint32_t UNUSED_INDEX = 0xFFFFFFFF;
 
+// Time a frame may spend loading missed images on the render thread, later misses are skipped and decoded in the background
+constexpr auto FRAME_LOAD_BUDGET = std::chrono::milliseconds(4);
+
+// Maximum number of images decoded (and so uploaded) per frame, and per decode task
+constexpr size_t DECODE_BATCH_SIZE = 512;
+constexpr size_t DECODE_TASK_SIZE = 32;
+
+// Object images are only prewarmed while fewer images than this are cached, which bounds the VRAM used by prewarming
+constexpr size_t MAX_PREWARMED_IMAGES = 16384;
+
+// Decoding should not compete with the paint threads for every core
+constexpr size_t DECODE_THREADS = 2;
+
+static bool IsDecodableImage(uint32_t image)
+{
+    // Scrolling text and the temporary image are rewritten while a frame is drawn
+    if (image >= SPR_SCROLLING_TEXT_START && (image < SPR_IMAGE_LIST_BEGIN || image >= SPR_IMAGE_LIST_END))
+    {
+        return false;
+    }
+    auto g1Element = gfx_get_g1_element(image);
+    return g1Element != nullptr && g1Element->offset != nullptr && g1Element->width > 0 && g1Element->height > 0;
+}
+
 TextureCache::TextureCache()
 {
     std::fill(_indexMap.begin(), _indexMap.end(), UNUSED_INDEX);
+    _decodeStates.resize(_indexMap.size(), DecodeState::None);
 }
 
 TextureCache::~TextureCache()
@@ -34,6 +62,26 @@ void TextureCache::InvalidateImage(uint32_t image)
 {
     unique_lock lock(_mutex);
 
+    if (_decodeStates[image] == DecodeState::Queued)
+    {
+        // The image may be decoded right now, wait for it and drop the old pixels
+        if (_decodeJobs != nullptr)
+        {
+            _decodeJobs->Join();
+        }
+        std::lock_guard<std::mutex> stagingLock(_stagingMutex);
+        auto isImage = [image](const StagedImage& staged) { return staged.Image == image; };
+        _stagedImages.erase(std::remove_if(_stagedImages.begin(), _stagedImages.end(), isImage), _stagedImages.end());
+    }
+    _decodeStates[image] = DecodeState::None;
+
+    // Images invalidated outside of drawing are those of objects being loaded, decode them ahead of their first use
+    if (_decodeJobs != nullptr && !_drawingFrame)
+    {
+        _decodeStates[image] = DecodeState::Prewarm;
+        _prewarmQueue.push_back(image);
+    }
+
     uint32_t index = _indexMap[image];
     if (index == UNUSED_INDEX)
         return;
@@ -88,16 +136,54 @@ BasicTextureInfo TextureCache::GetOrLoadImageTexture(uint32_t image)
     // Load new texture.
     unique_lock lock(_mutex);
 
-    index = static_cast<uint32_t>(_textureCache.size());
-
+    auto loadStart = std::chrono::steady_clock::now();
     AtlasTextureInfo info = LoadImageTexture(image);
-
-    _textureCache.push_back(info);
-    _indexMap[image] = index;
+    AddImageTexture(info);
+    _frameLoadTime += std::chrono::steady_clock::now() - loadStart;
 
     return info;
 }
 
+// Like GetOrLoadImageTexture, but returns nothing rather than stalling the frame once its load budget is spent
+std::optional<BasicTextureInfo> TextureCache::TryGetOrLoadImageTexture(uint32_t image)
+{
+    image &= 0x7FFFFUL;
+
+    {
+        shared_lock lock(_mutex);
+
+        uint32_t index = _indexMap[image];
+        if (index != UNUSED_INDEX)
+        {
+            const auto& info = _textureCache[index];
+            return BasicTextureInfo{
+                info.index,
+                info.normalizedBounds,
+            };
+        }
+
+        if (_decodeStates[image] == DecodeState::Queued)
+        {
+            return std::nullopt;
+        }
+    }
+
+    {
+        unique_lock lock(_mutex);
+        if (_decodeJobs != nullptr && _drawingFrame && _frameLoadTime >= FRAME_LOAD_BUDGET && IsDecodableImage(image))
+        {
+            if (_decodeStates[image] != DecodeState::Queued)
+            {
+                _decodeStates[image] = DecodeState::Queued;
+                _decodeQueue.push_back(image);
+            }
+            return std::nullopt;
+        }
+    }
+
+    return GetOrLoadImageTexture(image);
+}
+
 BasicTextureInfo TextureCache::GetOrLoadGlyphTexture(uint32_t image, const PaletteMap& paletteMap)
 {
     GlyphId glyphId{};
@@ -134,6 +220,146 @@ BasicTextureInfo TextureCache::GetOrLoadGlyphTexture(uint32_t image, const Palet
     return (*it.first).second;
 }
 
+void TextureCache::BeginFrame()
+{
+    unique_lock lock(_mutex);
+
+    bool useMultithreading = gConfigGeneral.multithreading;
+    if (useMultithreading && _decodeJobs == nullptr)
+    {
+        _decodeJobs = std::make_unique<JobPool>(DECODE_THREADS);
+    }
+    else if (!useMultithreading && _decodeJobs != nullptr)
+    {
+        _decodeJobs.reset();
+        ClearDecodes();
+    }
+
+    _drawingFrame = true;
+    _frameLoadTime = {};
+
+    UploadStagedImages();
+    if (_decodeJobs != nullptr)
+    {
+        SubmitDecodes();
+    }
+}
+
+void TextureCache::EndFrame()
+{
+    unique_lock lock(_mutex);
+
+    // Decoding reads the g1 elements, which may only change again once the frame has been drawn
+    if (_decodeJobs != nullptr)
+    {
+        _decodeJobs->Join();
+    }
+    _drawingFrame = false;
+}
+
+void TextureCache::UploadStagedImages()
+{
+    std::vector<StagedImage> stagedImages;
+    {
+        std::lock_guard<std::mutex> stagingLock(_stagingMutex);
+        stagedImages.swap(_stagedImages);
+    }
+
+    for (const auto& staged : stagedImages)
+    {
+        if (_decodeStates[staged.Image] != DecodeState::Queued)
+        {
+            continue;
+        }
+        _decodeStates[staged.Image] = DecodeState::None;
+        if (_indexMap[staged.Image] == UNUSED_INDEX)
+        {
+            AddImageTexture(UploadImageTexture(staged.Image, staged.Width, staged.Height, staged.Pixels.get()));
+        }
+    }
+}
+
+void TextureCache::SubmitDecodes()
+{
+    std::vector<uint32_t> batch;
+    batch.reserve(DECODE_BATCH_SIZE);
+
+    // Images that have been skipped go first, then the prewarm queue
+    while (batch.size() < DECODE_BATCH_SIZE && !_decodeQueue.empty())
+    {
+        auto image = _decodeQueue.front();
+        _decodeQueue.pop_front();
+        if (_decodeStates[image] != DecodeState::Queued)
+        {
+            continue;
+        }
+        if (_indexMap[image] != UNUSED_INDEX || !IsDecodableImage(image))
+        {
+            _decodeStates[image] = DecodeState::None;
+            continue;
+        }
+        batch.push_back(image);
+    }
+
+    if (_textureCache.size() >= MAX_PREWARMED_IMAGES)
+    {
+        for (auto image : _prewarmQueue)
+        {
+            if (_decodeStates[image] == DecodeState::Prewarm)
+            {
+                _decodeStates[image] = DecodeState::None;
+            }
+        }
+        _prewarmQueue.clear();
+    }
+    while (batch.size() < DECODE_BATCH_SIZE && !_prewarmQueue.empty())
+    {
+        auto image = _prewarmQueue.front();
+        _prewarmQueue.pop_front();
+        if (_decodeStates[image] != DecodeState::Prewarm)
+        {
+            continue;
+        }
+        if (_indexMap[image] != UNUSED_INDEX || !IsDecodableImage(image))
+        {
+            _decodeStates[image] = DecodeState::None;
+            continue;
+        }
+        _decodeStates[image] = DecodeState::Queued;
+        batch.push_back(image);
+    }
+
+    for (size_t i = 0; i < batch.size(); i += DECODE_TASK_SIZE)
+    {
+        std::vector<uint32_t> images(batch.begin() + i, batch.begin() + std::min(i + DECODE_TASK_SIZE, batch.size()));
+        _decodeJobs->AddTask([this, images = std::move(images)]() { DecodeImages(images); });
+    }
+}
+
+void TextureCache::DecodeImages(const std::vector<uint32_t>& images)
+{
+    std::vector<StagedImage> decoded;
+    decoded.reserve(images.size());
+    for (auto image : images)
+    {
+        rct_drawpixelinfo dpi = GetImageAsDPI(image, 0);
+        decoded.push_back({ image, dpi.width, dpi.height, std::unique_ptr<uint8_t[]>(dpi.bits) });
+    }
+
+    std::lock_guard<std::mutex> stagingLock(_stagingMutex);
+    std::move(decoded.begin(), decoded.end(), std::back_inserter(_stagedImages));
+}
+
+void TextureCache::ClearDecodes()
+{
+    std::fill(_decodeStates.begin(), _decodeStates.end(), DecodeState::None);
+    _decodeQueue.clear();
+    _prewarmQueue.clear();
+
+    std::lock_guard<std::mutex> stagingLock(_stagingMutex);
+    _stagedImages.clear();
+}
+
 void TextureCache::CreateTextures()
 {
     if (!_initialized)
@@ -205,32 +431,41 @@ void TextureCache::EnlargeAtlasesTexture(GLuint newEntries)
 
     GLuint newIndices = _atlasesTextureIndices + newEntries;
 
-    std::vector<char> oldPixels;
-
     if (newIndices > _atlasesTextureCapacity)
     {
-        // Retrieve current array data, growing buffer.
-        oldPixels.resize(_atlasesTextureDimensions * _atlasesTextureDimensions * _atlasesTextureCapacity);
-        if (!oldPixels.empty())
-        {
-            glGetTexImage(GL_TEXTURE_2D_ARRAY, 0, GL_RED_INTEGER, GL_UNSIGNED_BYTE, oldPixels.data());
-        }
-
         // Initial capacity will be 12 which covers most cases of a fully visible park.
         _atlasesTextureCapacity = (_atlasesTextureCapacity + 6) << 1UL;
 
-        glBindTexture(GL_TEXTURE_2D_ARRAY, _atlasesTexture);
+        GLuint newTexture;
+        glGenTextures(1, &newTexture);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, newTexture);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
         glTexImage3D(
             GL_TEXTURE_2D_ARRAY, 0, GL_R8UI, _atlasesTextureDimensions, _atlasesTextureDimensions, _atlasesTextureCapacity, 0,
             GL_RED_INTEGER, GL_UNSIGNED_BYTE, nullptr);
 
-        // Restore old data
-        if (!oldPixels.empty())
+        // Copy the old atlases layer by layer on the GPU rather than reading the whole array back
+        if (_atlasesTextureIndices > 0)
         {
-            glTexSubImage3D(
-                GL_TEXTURE_2D_ARRAY, 0, 0, 0, 0, _atlasesTextureDimensions, _atlasesTextureDimensions, _atlasesTextureIndices,
-                GL_RED_INTEGER, GL_UNSIGNED_BYTE, oldPixels.data());
+            GLint oldReadFramebuffer;
+            glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &oldReadFramebuffer);
+
+            GLuint copyFramebuffer;
+            glGenFramebuffers(1, &copyFramebuffer);
+            glBindFramebuffer(GL_READ_FRAMEBUFFER, copyFramebuffer);
+            for (GLuint layer = 0; layer < _atlasesTextureIndices; layer++)
+            {
+                glFramebufferTextureLayer(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, _atlasesTexture, 0, layer);
+                glCopyTexSubImage3D(
+                    GL_TEXTURE_2D_ARRAY, 0, 0, 0, layer, 0, 0, _atlasesTextureDimensions, _atlasesTextureDimensions);
+            }
+            glBindFramebuffer(GL_READ_FRAMEBUFFER, oldReadFramebuffer);
+            glDeleteFramebuffers(1, &copyFramebuffer);
         }
+
+        glDeleteTextures(1, &_atlasesTexture);
+        _atlasesTexture = newTexture;
     }
 
     _atlasesTextureIndices = newIndices;
@@ -240,19 +475,32 @@ AtlasTextureInfo TextureCache::LoadImageTexture(uint32_t image)
 {
     rct_drawpixelinfo dpi = GetImageAsDPI(image, 0);
 
-    auto cacheInfo = AllocateImage(dpi.width, dpi.height);
+    auto cacheInfo = UploadImageTexture(image, dpi.width, dpi.height, dpi.bits);
+
+    DeleteDPI(dpi);
+
+    return cacheInfo;
+}
+
+AtlasTextureInfo TextureCache::UploadImageTexture(uint32_t image, int32_t width, int32_t height, const uint8_t* pixels)
+{
+    auto cacheInfo = AllocateImage(width, height);
     cacheInfo.image = image;
 
     glBindTexture(GL_TEXTURE_2D_ARRAY, _atlasesTexture);
     glTexSubImage3D(
-        GL_TEXTURE_2D_ARRAY, 0, cacheInfo.bounds.x, cacheInfo.bounds.y, cacheInfo.index, dpi.width, dpi.height, 1,
-        GL_RED_INTEGER, GL_UNSIGNED_BYTE, dpi.bits);
-
-    DeleteDPI(dpi);
+        GL_TEXTURE_2D_ARRAY, 0, cacheInfo.bounds.x, cacheInfo.bounds.y, cacheInfo.index, width, height, 1, GL_RED_INTEGER,
+        GL_UNSIGNED_BYTE, pixels);
 
     return cacheInfo;
 }
 
+void TextureCache::AddImageTexture(const AtlasTextureInfo& info)
+{
+    _indexMap[info.image] = static_cast<uint32_t>(_textureCache.size());
+    _textureCache.push_back(info);
+}
+
 AtlasTextureInfo TextureCache::LoadGlyphTexture(uint32_t image, const PaletteMap& paletteMap)
 {
     rct_drawpixelinfo dpi = GetGlyphAsDPI(image, paletteMap);
@@ -332,6 +580,12 @@ rct_drawpixelinfo TextureCache::GetGlyphAsDPI(uint32_t image, const PaletteMap&
 
 void TextureCache::FreeTextures()
 {
+    if (_decodeJobs != nullptr)
+    {
+        _decodeJobs->Join();
+    }
+    ClearDecodes();
+
     // Free array texture
     glDeleteTextures(1, &_atlasesTexture);
     _textureCache.clear();
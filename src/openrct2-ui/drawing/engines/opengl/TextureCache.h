@@ -15,14 +15,19 @@
 #include <SDL_pixels.h>
 #include <algorithm>
 #include <array>
+#include <chrono>
+#include <deque>
+#include <memory>
 #include <mutex>
 #include <openrct2/common.h>
 #ifndef __MACOSX__
 #    include <shared_mutex>
 #endif
+#include <optional>
 #include <unordered_map>
 #include <vector>
 
+class JobPool;
 struct rct_drawpixelinfo;
 struct PaletteMap;
 enum class FilterPaletteID : int32_t;
@@ -205,6 +210,32 @@ private:
 
     GLuint _paletteTexture = 0;
 
+    enum class DecodeState : uint8_t
+    {
+        None,
+        Prewarm,
+        Queued,
+    };
+
+    struct StagedImage
+    {
+        uint32_t Image;
+        int32_t Width;
+        int32_t Height;
+        std::unique_ptr<uint8_t[]> Pixels;
+    };
+
+    // Images missed after the frame's load budget is spent, and images of newly loaded objects, are decoded on worker
+    // threads while a frame is drawn and uploaded at the start of the next one.
+    std::unique_ptr<JobPool> _decodeJobs;
+    std::mutex _stagingMutex;
+    std::vector<StagedImage> _stagedImages;
+    std::deque<uint32_t> _decodeQueue;
+    std::deque<uint32_t> _prewarmQueue;
+    std::vector<DecodeState> _decodeStates;
+    std::chrono::steady_clock::duration _frameLoadTime{};
+    bool _drawingFrame = false;
+
 #ifndef __MACOSX__
     std::shared_mutex _mutex;
     using shared_lock = std::shared_lock<std::shared_mutex>;
@@ -220,8 +251,12 @@ public:
     ~TextureCache();
     void InvalidateImage(uint32_t image);
     BasicTextureInfo GetOrLoadImageTexture(uint32_t image);
+    std::optional<BasicTextureInfo> TryGetOrLoadImageTexture(uint32_t image);
     BasicTextureInfo GetOrLoadGlyphTexture(uint32_t image, const PaletteMap& paletteMap);
 
+    void BeginFrame();
+    void EndFrame();
+
     GLuint GetAtlasesTexture();
     GLuint GetPaletteTexture();
     static GLint PaletteToY(FilterPaletteID palette);
@@ -231,6 +266,12 @@ private:
     void GeneratePaletteTexture();
     void EnlargeAtlasesTexture(GLuint newEntries);
     AtlasTextureInfo LoadImageTexture(uint32_t image);
+    AtlasTextureInfo UploadImageTexture(uint32_t image, int32_t width, int32_t height, const uint8_t* pixels);
+    void AddImageTexture(const AtlasTextureInfo& info);
+    void UploadStagedImages();
+    void SubmitDecodes();
+    void DecodeImages(const std::vector<uint32_t>& images);
+    void ClearDecodes();
     AtlasTextureInfo LoadGlyphTexture(uint32_t image, const PaletteMap& paletteMap);
     AtlasTextureInfo AllocateImage(int32_t imageWidth, int32_t imageHeight);
     static rct_drawpixelinfo GetImageAsDPI(uint32_t image, uint32_t tertiaryColour);
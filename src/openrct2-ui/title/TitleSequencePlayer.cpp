@@ -12,6 +12,8 @@
 #include "../interface/Window.h"
 
 #include <algorithm>
+#include <future>
+#include <list>
 #include <memory>
 #include <openrct2/Context.h>
 #include <openrct2/Game.h>
@@ -21,6 +23,7 @@
 #include <openrct2/common.h>
 #include <openrct2/core/Console.hpp>
 #include <openrct2/core/Guard.hpp>
+#include <openrct2/core/MemoryStream.h>
 #include <openrct2/core/Path.hpp>
 #include <openrct2/core/String.hpp>
 #include <openrct2/interface/Viewport.h>
@@ -42,15 +45,31 @@
 
 using namespace OpenRCT2;
 
+// Decoded parks kept to be imported again when the sequence gets back to them
+static constexpr size_t MaxCachedParks = 3;
+
 class TitleSequencePlayer final : public ITitleSequencePlayer
 {
 private:
+    struct CachedPark
+    {
+        uint8_t SaveIndex;
+        std::unique_ptr<IParkImporter> Importer;
+        std::vector<rct_object_entry> RequiredObjects;
+    };
+
     GameState& _gameState;
 
     std::unique_ptr<TitleSequence> _sequence;
     int32_t _position = 0;
     int32_t _waitCounter = 0;
 
+    // The data of the park of the next load command, read on a worker thread while the current park plays
+    std::future<std::unique_ptr<TitleSequenceParkHandle>> _prefetchedPark;
+    int32_t _prefetchedSaveIndex = -1;
+    // Most recently used first
+    std::list<CachedPark> _cachedParks;
+
     int32_t _lastScreenWidth = 0;
     int32_t _lastScreenHeight = 0;
     CoordsXY _viewCentreLocation = {};
@@ -73,6 +92,10 @@ public:
 
     void Eject() override
     {
+        // The worker reads from the sequence, wait for it before the sequence goes
+        _prefetchedPark = {};
+        _prefetchedSaveIndex = -1;
+        _cachedParks.clear();
         _sequence = nullptr;
     }
 
@@ -280,14 +303,21 @@ private:
                 break;
             case TitleScript::Load:
             {
-                bool loadSuccess = false;
                 uint8_t saveIndex = command.SaveIndex;
-                auto parkHandle = TitleSequenceGetParkHandle(*_sequence, saveIndex);
-                if (parkHandle != nullptr)
+                bool loadSuccess = LoadCachedPark(saveIndex);
+                if (!loadSuccess)
+                {
+                    auto parkHandle = TakeParkHandle(saveIndex);
+                    if (parkHandle != nullptr)
+                    {
+                        loadSuccess = LoadParkFromStream(parkHandle->Stream.get(), parkHandle->HintPath, saveIndex);
+                    }
+                }
+                if (loadSuccess)
                 {
-                    loadSuccess = LoadParkFromStream(parkHandle->Stream.get(), parkHandle->HintPath);
+                    PrefetchNextPark();
                 }
-                if (!loadSuccess)
+                else
                 {
                     if (_sequence->Saves.size() > saveIndex)
                     {
@@ -389,11 +419,96 @@ private:
         return success;
     }
 
+    /**
+     * Reads the park data of the next load command after the current position on a worker thread, so the data is in
+     * memory by the time the command runs.
+     */
+    void PrefetchNextPark()
+    {
+        const auto numCommands = _sequence->Commands.size();
+        for (size_t i = 1; i <= numCommands; i++)
+        {
+            const auto& command = _sequence->Commands[(_position + i) % numCommands];
+            if (command.Type != TitleScript::Load)
+                continue;
+
+            auto saveIndex = command.SaveIndex;
+            bool isCached = std::any_of(_cachedParks.begin(), _cachedParks.end(), [saveIndex](const CachedPark& park) {
+                return park.SaveIndex == saveIndex;
+            });
+            if (!isCached && saveIndex != _prefetchedSaveIndex)
+            {
+                _prefetchedSaveIndex = saveIndex;
+                _prefetchedPark = std::async(std::launch::async, [sequence = _sequence.get(), saveIndex]() {
+                    auto handle = TitleSequenceGetParkHandle(*sequence, saveIndex);
+                    if (handle != nullptr && !sequence->IsZip)
+                    {
+                        // Files are opened lazily, read them into memory here rather than on the main thread
+                        std::vector<uint8_t> data(static_cast<size_t>(handle->Stream->GetLength()));
+                        handle->Stream->Read(data.data(), data.size());
+                        handle->Stream = std::make_unique<MemoryStream>(std::move(data));
+                    }
+                    return handle;
+                });
+            }
+            return;
+        }
+    }
+
+    std::unique_ptr<TitleSequenceParkHandle> TakeParkHandle(uint8_t saveIndex)
+    {
+        if (_prefetchedSaveIndex == saveIndex && _prefetchedPark.valid())
+        {
+            _prefetchedSaveIndex = -1;
+            try
+            {
+                return _prefetchedPark.get();
+            }
+            catch (const std::exception& e)
+            {
+                Console::Error::WriteLine(e.what());
+            }
+        }
+        return TitleSequenceGetParkHandle(*_sequence, saveIndex);
+    }
+
+    /**
+     * Imports the park from the decoded parks kept from earlier loads, if it is one of them.
+     */
+    bool LoadCachedPark(uint8_t saveIndex)
+    {
+        if (gPreviewingTitleSequenceInGame)
+            return false;
+
+        auto it = std::find_if(_cachedParks.begin(), _cachedParks.end(), [saveIndex](const CachedPark& park) {
+            return park.SaveIndex == saveIndex;
+        });
+        if (it == _cachedParks.end())
+            return false;
+
+        _cachedParks.splice(_cachedParks.begin(), _cachedParks, it);
+        auto& park = _cachedParks.front();
+        try
+        {
+            auto& objectManager = GetContext()->GetObjectManager();
+            objectManager.LoadObjects(park.RequiredObjects.data(), park.RequiredObjects.size());
+            park.Importer->Import();
+            PrepareParkForPlayback();
+            return true;
+        }
+        catch (const std::exception&)
+        {
+            _cachedParks.pop_front();
+        }
+        return false;
+    }
+
     /**
      * @param stream The stream to read the park data from.
      * @param hintPath Hint path, the extension is grabbed to determine what importer to use.
+     * @param saveIndex The park in the sequence, the decoded park is kept under it to be imported again.
      */
-    bool LoadParkFromStream(OpenRCT2::IStream* stream, const std::string& hintPath)
+    bool LoadParkFromStream(OpenRCT2::IStream* stream, const std::string& hintPath, uint8_t saveIndex)
     {
         log_verbose("TitleSequencePlayer::LoadParkFromStream(%s)", hintPath.c_str());
         bool success = false;
@@ -416,6 +531,16 @@ private:
                 objectManager.LoadObjects(result.RequiredObjects.data(), result.RequiredObjects.size());
 
                 parkImporter->Import();
+
+                // RCT1 parks are converted while they are imported, which can not be repeated with the same importer
+                if (!ParkImporter::ExtensionIsRCT1(extension))
+                {
+                    _cachedParks.push_front({ saveIndex, std::move(parkImporter), std::move(result.RequiredObjects) });
+                    if (_cachedParks.size() > MaxCachedParks)
+                    {
+                        _cachedParks.pop_back();
+                    }
+                }
             }
             PrepareParkForPlayback();
             success = true;
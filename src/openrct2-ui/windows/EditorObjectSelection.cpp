@@ -69,6 +69,10 @@ static uint16_t _filter_object_counts[EnumValue(ObjectType::Count)];
 
 static char _filter_string[MAX_PATH];
 
+// Whether each repository item matches _filterStringMatchesText, indexed by item ID
+static std::string _filterStringMatchesText;
+static std::vector<bool> _filterStringMatches;
+
 #define _FILTER_ALL ((_filter_flags & FILTER_ALL) == FILTER_ALL)
 #define _FILTER_RCT1 (_filter_flags & FILTER_RCT1)
 #define _FILTER_AA (_filter_flags & FILTER_AA)
@@ -217,6 +221,7 @@ static int32_t get_object_from_object_selection(ObjectType object_type, int32_t
 static void window_editor_object_selection_manage_tracks();
 static void editor_load_selected_objects();
 static bool filter_selected(uint8_t objectFlags);
+static void filter_string_update_matches();
 static bool filter_string(const ObjectRepositoryItem* item);
 static bool filter_source(const ObjectRepositoryItem* item);
 static bool filter_chunks(const ObjectRepositoryItem* item);
@@ -290,6 +295,7 @@ static void visible_list_refresh(rct_window* w)
 
     visible_list_dispose();
     w->selected_list_item = -1;
+    filter_string_update_matches();
 
     const ObjectRepositoryItem* items = object_repository_get_items();
     for (int32_t i = 0; i < numObjects; i++)
@@ -372,7 +378,6 @@ rct_window* window_editor_object_selection_open()
         return window;
 
     sub_6AB211();
-    reset_selected_object_count_and_size();
 
     window = WindowCreateCentred(
         600, 400, &window_editor_object_selection_events, WC_EDITOR_OBJECT_SELECTION, WF_10 | WF_RESIZABLE);
@@ -435,6 +440,8 @@ static void window_editor_object_selection_close(rct_window* w)
     context_broadcast_intent(&intent);
 
     visible_list_dispose();
+    _filterStringMatchesText.clear();
+    _filterStringMatches.clear();
 
     intent = Intent(INTENT_ACTION_REFRESH_SCENERY);
     context_broadcast_intent(&intent);
@@ -1393,6 +1400,66 @@ static bool filter_selected(uint8_t objectFlag)
     }
 }
 
+static std::string filter_string_to_lower(std::string_view text)
+{
+    std::string result;
+    result.reserve(text.size());
+    for (auto c : text)
+        result.push_back(static_cast<char>(tolower(static_cast<unsigned char>(c))));
+    return result;
+}
+
+/**
+ * Looks up the objects matching the filter string in the object repository's search index, so the filter does not
+ * have to lower case and search the text of every object each time the list is refreshed. Only does any work when the
+ * filter string or the repository has changed since the last call.
+ */
+static void filter_string_update_matches()
+{
+    size_t numObjects = object_repository_get_items_count();
+    if (_filterStringMatches.size() == numObjects && _filterStringMatchesText == _filter_string)
+        return;
+
+    _filterStringMatchesText = _filter_string;
+    _filterStringMatches.assign(numObjects, false);
+    if (_filterStringMatchesText.empty())
+        return;
+
+    for (auto id : object_repository_search_objects(_filterStringMatchesText))
+    {
+        if (id < numObjects)
+            _filterStringMatches[id] = true;
+    }
+
+    // Ride type names depend on the current language so they are not part of the index, there are few enough of them
+    // to check each one
+    auto filterLower = filter_string_to_lower(_filterStringMatchesText);
+    std::vector<bool> rideTypeMatches(RIDE_TYPE_COUNT);
+    for (size_t rideType = 0; rideType < RIDE_TYPE_COUNT; rideType++)
+    {
+        auto rideTypeName = language_get_string(GetRideTypeDescriptor(static_cast<uint8_t>(rideType)).Naming.Name);
+        rideTypeMatches[rideType] = filter_string_to_lower(rideTypeName).find(filterLower) != std::string::npos;
+    }
+
+    const ObjectRepositoryItem* items = object_repository_get_items();
+    for (size_t i = 0; i < numObjects; i++)
+    {
+        const ObjectRepositoryItem* item = &items[i];
+        if (item->ObjectEntry.GetType() != ObjectType::Ride)
+            continue;
+
+        for (auto rideType : item->RideInfo.RideType)
+        {
+            if (rideType != RIDE_TYPE_NULL)
+            {
+                if (rideType < RIDE_TYPE_COUNT && rideTypeMatches[rideType])
+                    _filterStringMatches[i] = true;
+                break;
+            }
+        }
+    }
+}
+
 static bool filter_string(const ObjectRepositoryItem* item)
 {
     // Nothing to search for
@@ -1403,35 +1470,8 @@ static bool filter_string(const ObjectRepositoryItem* item)
     if (item->Name.empty())
         return false;
 
-    // Get ride type
-    const char* rideTypeName = language_get_string(get_ride_type_string_id(item));
-
-    // Get object name (ride/vehicle for rides) and type name (rides only)
-    char name_lower[MAX_PATH];
-    char type_lower[MAX_PATH];
-    char object_path[MAX_PATH];
-    char filter_lower[sizeof(_filter_string)];
-    safe_strcpy(name_lower, item->Name.c_str(), MAX_PATH);
-    safe_strcpy(type_lower, rideTypeName, MAX_PATH);
-    safe_strcpy(object_path, item->Path.c_str(), MAX_PATH);
-    safe_strcpy(filter_lower, _filter_string, sizeof(_filter_string));
-
-    // Make use of lowercase characters only
-    for (int32_t i = 0; name_lower[i] != '\0'; i++)
-        name_lower[i] = static_cast<char>(tolower(name_lower[i]));
-    for (int32_t i = 0; type_lower[i] != '\0'; i++)
-        type_lower[i] = static_cast<char>(tolower(type_lower[i]));
-    for (int32_t i = 0; object_path[i] != '\0'; i++)
-        object_path[i] = static_cast<char>(tolower(object_path[i]));
-    for (int32_t i = 0; filter_lower[i] != '\0'; i++)
-        filter_lower[i] = static_cast<char>(tolower(filter_lower[i]));
-
-    // Check if the searched string exists in the name, ride type, or filename
-    bool inName = strstr(name_lower, filter_lower) != nullptr;
-    bool inRideType = (item->ObjectEntry.GetType() == ObjectType::Ride) && strstr(type_lower, filter_lower) != nullptr;
-    bool inPath = strstr(object_path, filter_lower) != nullptr;
-
-    return inName || inRideType || inPath;
+    // Check if the searched string exists in the name, ride type, identifier, filename or authors
+    return item->Id < _filterStringMatches.size() && _filterStringMatches[item->Id];
 }
 
 static bool sources_match(ObjectSourceGame source)
@@ -1493,6 +1533,7 @@ static void filter_update_counts()
     {
         const auto& selectionFlags = _objectSelectionFlags;
         std::fill(std::begin(_filter_object_counts), std::end(_filter_object_counts), 0);
+        filter_string_update_matches();
 
         size_t numObjects = object_repository_get_items_count();
         const ObjectRepositoryItem* items = object_repository_get_items();
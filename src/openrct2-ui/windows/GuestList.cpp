@@ -22,6 +22,8 @@
 #include <openrct2/util/Util.h>
 #include <openrct2/world/Park.h>
 #include <openrct2/world/Sprite.h>
+#include <optional>
+#include <string>
 #include <vector>
 
 static constexpr const rct_string_id WINDOW_TITLE = STR_GUESTS;
@@ -118,14 +120,30 @@ private:
     {
         using CompareFunc = bool (*)(const GuestItem&, const GuestItem&);
 
-        uint16_t Id;
-        char Name[256];
+        uint16_t Id{};
+        PeepType Type{};
+        uint32_t PeepId{};
+        bool HasCustomName{};
+        // Only formatted when needed, guests without a custom name are sorted by their number
+        mutable std::optional<std::string> Name;
+
+        const std::string& GetName() const
+        {
+            if (!Name)
+            {
+                auto peep = GetEntity<Guest>(Id);
+                Name = peep != nullptr ? peep->GetName() : std::string();
+            }
+            return *Name;
+        }
     };
 
     static constexpr const uint8_t SUMMARISED_GUEST_ROW_HEIGHT = SCROLLABLE_ROW_HEIGHT + 11;
     static constexpr const auto GUESTS_PER_PAGE = 2000;
     static constexpr const auto GUEST_PAGE_HEIGHT = GUESTS_PER_PAGE * SCROLLABLE_ROW_HEIGHT;
     static constexpr size_t MaxGroups = 240;
+    // Guests enter and leave the park all the time, so refresh requests are applied at most this often (in updates)
+    static constexpr uint32_t RefreshListInterval = 8;
 
     TabId _selectedTab{};
     GuestViewType _selectedView{};
@@ -144,6 +162,8 @@ private:
 
     std::vector<GuestItem> _guestList;
     std::optional<size_t> _highlightedIndex;
+    bool _refreshListPending{};
+    uint32_t _refreshListWait{};
 
     uint32_t _tabAnimationIndex{};
 
@@ -264,6 +284,16 @@ public:
             _lastFindGroupsWait--;
         }
 
+        if (_refreshListWait != 0)
+        {
+            _refreshListWait--;
+        }
+        else if (_refreshListPending)
+        {
+            RefreshList();
+            Invalidate();
+        }
+
         // Current tab image animation
         _tabAnimationIndex++;
         if (_tabAnimationIndex >= (_selectedTab == TabId::Individual ? 24UL : 32UL))
@@ -548,20 +578,15 @@ public:
         {
             case TabId::Individual:
             {
-                auto i = screenCoords.y / SCROLLABLE_ROW_HEIGHT;
-                i += static_cast<int32_t>(_selectedPage * GUESTS_PER_PAGE);
-                for (const auto& guestItem : _guestList)
+                auto i = static_cast<size_t>(screenCoords.y / SCROLLABLE_ROW_HEIGHT);
+                i += _selectedPage * GUESTS_PER_PAGE;
+                if (i < _guestList.size())
                 {
-                    if (i == 0)
+                    auto guest = GetEntity<Guest>(_guestList[i].Id);
+                    if (guest != nullptr)
                     {
-                        auto guest = GetEntity<Guest>(guestItem.Id);
-                        if (guest != nullptr)
-                        {
-                            window_guest_open(guest);
-                        }
-                        break;
+                        window_guest_open(guest);
                     }
-                    i--;
                 }
                 break;
             }
@@ -601,6 +626,9 @@ public:
 
     void RefreshList()
     {
+        _refreshListPending = false;
+        _refreshListWait = RefreshListInterval;
+
         // Only the individual tab uses the GuestList so no point calculating it
         if (_selectedTab != TabId::Individual)
         {
@@ -621,21 +649,31 @@ public:
                         continue;
                     sprite_set_flashing(peep, true);
                 }
-                if (!GuestShouldBeVisible(*peep))
-                    continue;
 
                 auto& item = _guestList.emplace_back();
                 item.Id = peep->sprite_index;
-
-                Formatter ft;
-                peep->FormatNameTo(ft);
-                format_string(item.Name, sizeof(item.Name), STR_STRINGID, ft.Data());
+                item.Type = peep->AssignedPeepType;
+                item.PeepId = peep->Id;
+                item.HasCustomName = peep->Name != nullptr;
+                if (!GuestShouldBeVisible(*peep, item))
+                {
+                    _guestList.pop_back();
+                }
             }
 
             std::sort(_guestList.begin(), _guestList.end(), GetGuestCompareFunc());
         }
     }
 
+    /**
+     * Refreshes the list on one of the next updates, so that bursts of guests entering or leaving the park only cause
+     * a single refresh.
+     */
+    void RequestRefreshList()
+    {
+        _refreshListPending = true;
+    }
+
 private:
     void DrawTabImages(rct_drawpixelinfo& dpi)
     {
@@ -653,13 +691,18 @@ private:
 
     void DrawScrollIndividual(rct_drawpixelinfo& dpi)
     {
-        size_t index = 0;
-        auto y = static_cast<int32_t>(_selectedPage) * -GUEST_PAGE_HEIGHT;
-        for (const auto& guestItem : _guestList)
+        // Only visit the rows that are within the scroll view
+        auto pageOffset = static_cast<int32_t>(_selectedPage) * GUEST_PAGE_HEIGHT;
+        auto index = static_cast<size_t>(std::max(0, (dpi.y + pageOffset) / SCROLLABLE_ROW_HEIGHT - 1));
+        for (; index < _guestList.size(); index++)
         {
+            const auto& guestItem = _guestList[index];
+            auto y = static_cast<int32_t>(index) * SCROLLABLE_ROW_HEIGHT - pageOffset;
+            if (y >= dpi.y + dpi.height || y >= 0x7FFF)
+                break;
+
             // Check if y is beyond the scroll control
-            if (y + SCROLLABLE_ROW_HEIGHT + 1 >= -0x7FFF && y + SCROLLABLE_ROW_HEIGHT + 1 > dpi.y && y < 0x7FFF
-                && y < dpi.y + dpi.height)
+            if (y + SCROLLABLE_ROW_HEIGHT + 1 >= -0x7FFF && y + SCROLLABLE_ROW_HEIGHT + 1 > dpi.y)
             {
                 // Highlight backcolour and text colour (format)
                 rct_string_id format = STR_BLACK_STRING;
@@ -713,8 +756,6 @@ private:
                         break;
                 }
             }
-            y += SCROLLABLE_ROW_HEIGHT;
-            index++;
         }
     }
 
@@ -762,19 +803,14 @@ private:
         }
     }
 
-    bool GuestShouldBeVisible(const Peep& peep)
+    bool GuestShouldBeVisible(const Peep& peep, const GuestItem& item)
     {
         if (_trackingOnly && !(peep.PeepFlags & PEEP_FLAGS_TRACKING))
             return false;
 
         if (!_filterName.empty())
         {
-            char name[256]{};
-
-            Formatter ft;
-            peep.FormatNameTo(ft);
-            format_string(name, sizeof(name), STR_STRINGID, ft.Data());
-            if (strcasestr(name, _filterName.c_str()) == nullptr)
+            if (strcasestr(item.GetName().c_str(), _filterName.c_str()) == nullptr)
             {
                 return false;
             }
@@ -914,27 +950,22 @@ private:
 
     template<bool TRealNames> static bool CompareGuestItem(const GuestItem& a, const GuestItem& b)
     {
-        const auto* peepA = GetEntity<Peep>(a.Id);
-        const auto* peepB = GetEntity<Peep>(b.Id);
-        if (peepA != nullptr && peepB != nullptr)
+        // Compare types
+        if (a.Type != b.Type)
         {
-            // Compare types
-            if (peepA->AssignedPeepType != peepB->AssignedPeepType)
-            {
-                return static_cast<int32_t>(peepA->AssignedPeepType) < static_cast<int32_t>(peepB->AssignedPeepType);
-            }
+            return static_cast<int32_t>(a.Type) < static_cast<int32_t>(b.Type);
+        }
 
-            // Compare name
-            if constexpr (!TRealNames)
+        // Compare name
+        if constexpr (!TRealNames)
+        {
+            if (!a.HasCustomName && !b.HasCustomName)
             {
-                if (peepA->Name == nullptr && peepB->Name == nullptr)
-                {
-                    // Simple ID comparison for when both peeps use a number or a generated name
-                    return peepA->Id < peepB->Id;
-                }
+                // Simple ID comparison for when both peeps use a number or a generated name
+                return a.PeepId < b.PeepId;
             }
         }
-        return strlogicalcmp(a.Name, b.Name) < 0;
+        return strlogicalcmp(a.GetName().c_str(), b.GetName().c_str()) < 0;
     }
 
     static GuestItem::CompareFunc GetGuestCompareFunc()
@@ -971,6 +1002,6 @@ void window_guest_list_refresh_list()
     auto* w = window_find_by_class(WC_GUEST_LIST);
     if (w != nullptr)
     {
-        static_cast<GuestListWindow*>(w)->RefreshList();
+        static_cast<GuestListWindow*>(w)->RequestRefreshList();
     }
 }
@@ -11,6 +11,7 @@
 #include <ctime>
 #include <iterator>
 #include <memory>
+#include <mutex>
 #include <openrct2-ui/interface/Widget.h>
 #include <openrct2-ui/windows/Window.h>
 #include <openrct2/Context.h>
@@ -19,8 +20,10 @@
 #include <openrct2/Game.h>
 #include <openrct2/GameState.h>
 #include <openrct2/config/Config.h>
+#include <openrct2/core/File.h>
 #include <openrct2/core/FileScanner.h>
 #include <openrct2/core/Guard.hpp>
+#include <openrct2/core/JobPool.h>
 #include <openrct2/core/Path.hpp>
 #include <openrct2/core/String.hpp>
 #include <openrct2/localisation/Localisation.h>
@@ -35,6 +38,7 @@
 #include <openrct2/windows/Intent.h>
 #include <openrct2/world/Park.h>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #pragma region Widgets
@@ -82,6 +86,7 @@ static rct_widget window_loadsave_widgets[] =
 
 static void window_loadsave_close(rct_window *w);
 static void window_loadsave_mouseup(rct_window *w, rct_widgetindex widgetIndex);
+static void window_loadsave_update(rct_window *w);
 static void window_loadsave_resize(rct_window *w);
 static void window_loadsave_scrollgetsize(rct_window *w, int32_t scrollIndex, int32_t *width, int32_t *height);
 static void window_loadsave_scrollmousedown(rct_window *w, int32_t scrollIndex, const ScreenCoordsXY& screenCoords);
@@ -96,6 +101,7 @@ static rct_window_event_list window_loadsave_events([](auto& events)
 {
     events.close = &window_loadsave_close;
     events.mouse_up = &window_loadsave_mouseup;
+    events.update = &window_loadsave_update;
     events.resize = &window_loadsave_resize;
     events.get_scroll_size = &window_loadsave_scrollgetsize;
     events.scroll_mousedown = &window_loadsave_scrollmousedown;
@@ -137,12 +143,28 @@ static char _extension[256];
 static std::string _defaultPath;
 static int32_t _type;
 
+// Directory listings are read on a background thread and merged into the list on the window's update
+static constexpr size_t SCAN_BATCH_SIZE = 256;
+static constexpr size_t MAX_CACHED_LISTINGS = 32;
+static std::mutex _scanMutex;
+static std::vector<LoadSaveListItem> _scanResults;
+static bool _scanComplete;
+static uint32_t _scanGeneration;
+static bool _scanning;
+static bool _scanReplacesListing;
+static std::vector<LoadSaveListItem> _scanListItems;
+static std::unordered_map<std::string, std::vector<LoadSaveListItem>> _listingCache;
+// Declared after the state it uses so it is destroyed, and the scan thread joined, first
+static std::unique_ptr<JobPool> _scanJobs;
+
 static int32_t maxDateWidth = 0;
 static int32_t maxTimeWidth = 0;
 
 static void window_loadsave_populate_list(rct_window* w, int32_t includeNewItem, const char* directory, const char* extension);
 static void window_loadsave_select(rct_window* w, const char* path);
 static void window_loadsave_sort_list();
+static void window_loadsave_cancel_scan();
+static void window_loadsave_start_scan(bool replaceListing);
 
 static rct_window* window_overwrite_prompt_open(const char* name, const char* path);
 
@@ -201,10 +223,10 @@ static const char* getFilterPatternByType(const int32_t type, const bool isSave)
     switch (type & 0x0E)
     {
         case LOADSAVETYPE_GAME:
-            return isSave ? "*.sv6" : "*.sv6;*.sc6;*.sc4;*.sv4;*.sv7;*.sea;";
+            return isSave ? "*.sv6" : "*.sv6;*.sc6;*.sc4;*.sv4;*.sv7;*.sea;*.park;";
 
         case LOADSAVETYPE_LANDSCAPE:
-            return isSave ? "*.sc6" : "*.sc6;*.sv6;*.sc4;*.sv4;*.sv7;*.sea;";
+            return isSave ? "*.sc6" : "*.sc6;*.sv6;*.sc4;*.sv4;*.sv7;*.sea;*.park;";
 
         case LOADSAVETYPE_SCENARIO:
             return "*.sc6";
@@ -322,6 +344,7 @@ rct_window* window_loadsave_open(
 
 static void window_loadsave_close(rct_window* w)
 {
+    window_loadsave_cancel_scan();
     _listItems.clear();
     window_close_by_class(WC_LOADSAVE_OVERWRITE_PROMPT);
 }
@@ -615,6 +638,12 @@ static void window_loadsave_textinput(rct_window* w, rct_widgetindex widgetIndex
                 }
             }
 
+            // The listing may not be complete yet
+            if (!overwrite && _scanning)
+            {
+                overwrite = File::Exists(path);
+            }
+
             if (overwrite)
                 window_overwrite_prompt_open(text, path);
             else
@@ -812,6 +841,181 @@ static void window_loadsave_sort_list()
     std::sort(_listItems.begin(), _listItems.end(), list_item_sort);
 }
 
+static std::string window_loadsave_get_listing_key()
+{
+    return std::string(_directory) + '|' + _extension;
+}
+
+/**
+ * Lists the sub directories and the files matching the extensions of a directory on the scan thread. The items are
+ * handed over in batches so the window can show them while the scan is still going, the scan stops as soon as a newer
+ * one has been started or the window has been closed.
+ */
+static void window_loadsave_scan_directory(uint32_t generation, const std::string& directory, const std::string& extension)
+{
+    std::vector<LoadSaveListItem> items;
+    auto flush = [&](bool complete) {
+        std::lock_guard<std::mutex> lock(_scanMutex);
+        if (_scanGeneration != generation)
+            return false;
+
+        _scanResults.insert(_scanResults.end(), std::make_move_iterator(items.begin()), std::make_move_iterator(items.end()));
+        _scanComplete = complete;
+        items.clear();
+        return true;
+    };
+
+    // List all directories
+    auto subDirectories = Path::GetDirectories(directory);
+    for (const auto& sdName : subDirectories)
+    {
+        auto subDir = sdName + PATH_SEPARATOR;
+
+        LoadSaveListItem newListItem;
+        newListItem.path = Path::Combine(directory, subDir);
+        newListItem.name = subDir;
+        newListItem.type = TYPE_DIRECTORY;
+        newListItem.loaded = false;
+
+        items.push_back(std::move(newListItem));
+    }
+    if (!flush(false))
+        return;
+
+    // List all files with the wanted extensions
+    bool showExtension = false;
+    for (const auto& extToken : String::Split(extension, ";"))
+    {
+        if (extToken.empty())
+            continue;
+
+        char filter[MAX_PATH];
+        safe_strcpy(filter, directory.c_str(), std::size(filter));
+        safe_strcat_path(filter, "*", std::size(filter));
+        path_append_extension(filter, extToken.c_str(), std::size(filter));
+
+        auto scanner = std::unique_ptr<IFileScanner>(Path::ScanDirectory(filter, false));
+        while (scanner->Next())
+        {
+            LoadSaveListItem newListItem;
+            newListItem.path = scanner->GetPath();
+            newListItem.type = TYPE_FILE;
+            newListItem.date_modified = platform_file_get_modified_time(newListItem.path.c_str());
+            newListItem.loaded = false;
+
+            // Remove the extension (but only the first extension token)
+            if (!showExtension)
+            {
+                newListItem.name = Path::GetFileNameWithoutExtension(newListItem.path);
+            }
+            else
+            {
+                newListItem.name = Path::GetFileName(newListItem.path);
+            }
+
+            items.push_back(std::move(newListItem));
+            if (items.size() >= SCAN_BATCH_SIZE && !flush(false))
+                return;
+        }
+
+        showExtension = true; // Show any extension after the first iteration
+    }
+    flush(true);
+}
+
+static void window_loadsave_cancel_scan()
+{
+    std::lock_guard<std::mutex> lock(_scanMutex);
+    _scanGeneration++;
+    _scanResults.clear();
+    _scanComplete = false;
+    _scanning = false;
+    _scanListItems.clear();
+}
+
+static void window_loadsave_start_scan(bool replaceListing)
+{
+    uint32_t generation;
+    {
+        std::lock_guard<std::mutex> lock(_scanMutex);
+        generation = ++_scanGeneration;
+        _scanResults.clear();
+        _scanComplete = false;
+    }
+    _scanning = true;
+    _scanReplacesListing = replaceListing;
+    _scanListItems.clear();
+
+    if (_scanJobs == nullptr)
+    {
+        _scanJobs = std::make_unique<JobPool>(1);
+    }
+    _scanJobs->AddTask([generation, directory = std::string(_directory), extension = std::string(_extension)]() {
+        window_loadsave_scan_directory(generation, directory, extension);
+    });
+}
+
+static void window_loadsave_update(rct_window* w)
+{
+    if (!_scanning)
+        return;
+
+    std::vector<LoadSaveListItem> items;
+    bool complete;
+    {
+        std::lock_guard<std::mutex> lock(_scanMutex);
+        items = std::move(_scanResults);
+        _scanResults.clear();
+        complete = _scanComplete;
+    }
+    if (items.empty() && !complete)
+        return;
+
+    for (auto& item : items)
+    {
+        if (item.type == TYPE_FILE)
+        {
+            // Cache a human-readable version of the modified date.
+            item.date_formatted = Platform::FormatShortDate(item.date_modified);
+            item.time_formatted = Platform::FormatTime(item.date_modified);
+
+            // Mark if file is the currently loaded game
+            item.loaded = item.path.compare(gCurrentLoadedPath.c_str()) == 0;
+        }
+    }
+
+    if (_scanReplacesListing)
+    {
+        // Keep showing the cached listing until the new one is complete
+        _scanListItems.insert(
+            _scanListItems.end(), std::make_move_iterator(items.begin()), std::make_move_iterator(items.end()));
+        if (!complete)
+            return;
+
+        _listItems = std::move(_scanListItems);
+        _scanListItems.clear();
+        w->selected_list_item = -1;
+    }
+    else
+    {
+        _listItems.insert(_listItems.end(), std::make_move_iterator(items.begin()), std::make_move_iterator(items.end()));
+    }
+    window_loadsave_sort_list();
+
+    if (complete)
+    {
+        _scanning = false;
+        if (_listingCache.size() >= MAX_CACHED_LISTINGS)
+        {
+            _listingCache.clear();
+        }
+        _listingCache[window_loadsave_get_listing_key()] = _listItems;
+    }
+
+    w->no_list_items = static_cast<uint16_t>(_listItems.size());
+    w->Invalidate();
+}
+
 static void window_loadsave_populate_list(rct_window* w, int32_t includeNewItem, const char* directory, const char* extension)
 {
     utf8 absoluteDirectory[MAX_PATH];
@@ -824,6 +1028,7 @@ static void window_loadsave_populate_list(rct_window* w, int32_t includeNewItem,
     }
     _shortenedDirectory[0] = '\0';
 
+    window_loadsave_cancel_scan();
     _listItems.clear();
 
     // Show "new" buttons when saving
@@ -886,64 +1091,18 @@ static void window_loadsave_populate_list(rct_window* w, int32_t includeNewItem,
         w->disabled_widgets &= ~(1 << WIDX_NEW_FILE);
         w->disabled_widgets &= ~(1 << WIDX_NEW_FOLDER);
 
-        // List all directories
-        auto subDirectories = Path::GetDirectories(absoluteDirectory);
-        for (const auto& sdName : subDirectories)
-        {
-            auto subDir = sdName + PATH_SEPARATOR;
-
-            LoadSaveListItem newListItem;
-            newListItem.path = Path::Combine(absoluteDirectory, subDir);
-            newListItem.name = subDir;
-            newListItem.type = TYPE_DIRECTORY;
-            newListItem.loaded = false;
-
-            _listItems.push_back(std::move(newListItem));
-        }
-
-        // List all files with the wanted extensions
-        char filter[MAX_PATH];
-        char extCopy[64];
-        safe_strcpy(extCopy, extension, std::size(extCopy));
-        bool showExtension = false;
-        char* extToken = strtok(extCopy, ";");
-        while (extToken != nullptr)
+        // Show the last listing of this directory while it is read again in the background, the listing is replaced
+        // once the scan has finished. Directories that have not been listed before fill in as they are read instead.
+        auto cached = _listingCache.find(window_loadsave_get_listing_key());
+        if (cached != _listingCache.end())
         {
-            safe_strcpy(filter, directory, std::size(filter));
-            safe_strcat_path(filter, "*", std::size(filter));
-            path_append_extension(filter, extToken, std::size(filter));
-
-            auto scanner = std::unique_ptr<IFileScanner>(Path::ScanDirectory(filter, false));
-            while (scanner->Next())
+            _listItems = cached->second;
+            for (auto& item : _listItems)
             {
-                LoadSaveListItem newListItem;
-                newListItem.path = scanner->GetPath();
-                newListItem.type = TYPE_FILE;
-                newListItem.date_modified = platform_file_get_modified_time(newListItem.path.c_str());
-
-                // Cache a human-readable version of the modified date.
-                newListItem.date_formatted = Platform::FormatShortDate(newListItem.date_modified);
-                newListItem.time_formatted = Platform::FormatTime(newListItem.date_modified);
-
-                // Mark if file is the currently loaded game
-                newListItem.loaded = newListItem.path.compare(gCurrentLoadedPath.c_str()) == 0;
-
-                // Remove the extension (but only the first extension token)
-                if (!showExtension)
-                {
-                    newListItem.name = Path::GetFileNameWithoutExtension(newListItem.path);
-                }
-                else
-                {
-                    newListItem.name = Path::GetFileName(newListItem.path);
-                }
-
-                _listItems.push_back(std::move(newListItem));
+                item.loaded = item.path.compare(gCurrentLoadedPath.c_str()) == 0;
             }
-
-            extToken = strtok(nullptr, ";");
-            showExtension = true; // Show any extension after the first iteration
         }
+        window_loadsave_start_scan(cached != _listingCache.end());
 
         window_loadsave_sort_list();
     }
@@ -180,12 +180,14 @@ static rct_window_event_list window_map_events([](auto& events)
 /** rct2: 0x00F1AD61 */
 static uint8_t _activeTool;
 
-/** rct2: 0x00F1AD6C */
-static uint32_t _currentLine;
-
 /** rct2: 0x00F1AD68 */
 static std::vector<uint8_t> _mapImageData;
 
+// The tab and map size _mapImageData was last fully coloured for, after that only changed tiles are recoloured
+static int32_t _mapImageTab = -1;
+static int32_t _mapImageMapSize;
+static std::vector<TileCoordsXY> _mapChangedTiles;
+
 static uint16_t _landRightsToolSize;
 
 static void window_map_init_map();
@@ -205,7 +207,7 @@ static void window_map_place_park_entrance_tool_down(const ScreenCoordsXY& scree
 static void window_map_set_peep_spawn_tool_down(const ScreenCoordsXY& screenCoords);
 static void map_window_increase_map_size();
 static void map_window_decrease_map_size();
-static void map_window_set_pixels(rct_window* w);
+static void map_window_update_pixels(rct_window* w);
 
 static CoordsXY map_window_screen_to_map(ScreenCoordsXY screenCoords);
 
@@ -234,6 +236,7 @@ rct_window* window_map_open()
     {
         return nullptr;
     }
+    map_set_changed_tile_tracking(true);
 
     w = WindowCreateAutoPos(245, 259, &window_map_events, WC_MAP, WF_10);
     w->widgets = window_map_widgets;
@@ -284,6 +287,9 @@ static void window_map_close(rct_window* w)
 {
     _mapImageData.clear();
     _mapImageData.shrink_to_fit();
+    _mapChangedTiles.clear();
+    _mapChangedTiles.shrink_to_fit();
+    map_set_changed_tile_tracking(false);
     if ((input_test_flag(INPUT_FLAG_TOOL_ACTIVE)) && gCurrentToolWidget.window_classification == w->classification
         && gCurrentToolWidget.window_number == w->number)
     {
@@ -445,8 +451,7 @@ static void window_map_update(rct_window* w)
         window_map_centre_on_view_point();
     }
 
-    for (int32_t i = 0; i < 16; i++)
-        map_window_set_pixels(w);
+    map_window_update_pixels(w);
 
     w->Invalidate();
 
@@ -906,7 +911,7 @@ static void window_map_scrollpaint(rct_window* w, rct_drawpixelinfo* dpi, int32_
 static void window_map_init_map()
 {
     std::fill(_mapImageData.begin(), _mapImageData.end(), PALETTE_INDEX_10);
-    _currentLine = 0;
+    _mapImageTab = -1;
 }
 
 /**
@@ -1540,68 +1545,81 @@ static uint16_t map_window_get_pixel_colour_ride(const CoordsXY& c)
     return colourB;
 }
 
-static void map_window_set_pixels(rct_window* w)
+static void map_window_set_tile_pixels(rct_window* w, const TileCoordsXY& tilePos)
 {
-    uint16_t colour = 0;
-    int32_t x = 0, y = 0, dx = 0, dy = 0;
+    const auto mapPos = tilePos.ToCoordsXY();
+    if (mapPos.x <= 0 || mapPos.y <= 0 || mapPos.x >= gMapSizeUnits || mapPos.y >= gMapSizeUnits)
+        return;
 
-    int32_t pos = (_currentLine * (MAP_WINDOW_MAP_SIZE - 1)) + MAXIMUM_MAP_SIZE_TECHNICAL - 1;
-    auto destinationPosition = ScreenCoordsXY{ pos % MAP_WINDOW_MAP_SIZE, pos / MAP_WINDOW_MAP_SIZE };
-    auto destination = _mapImageData.data() + (destinationPosition.y * MAP_WINDOW_MAP_SIZE) + destinationPosition.x;
+    // The image is drawn as diagonal lines of tiles, find the line the tile is on and its position along it
+    int32_t line = 0, position = 0;
     switch (get_current_rotation())
     {
         case 0:
-            x = _currentLine * COORDS_XY_STEP;
-            y = 0;
-            dx = 0;
-            dy = COORDS_XY_STEP;
+            line = tilePos.x;
+            position = tilePos.y;
             break;
         case 1:
-            x = MAXIMUM_TILE_START_XY;
-            y = _currentLine * COORDS_XY_STEP;
-            dx = -COORDS_XY_STEP;
-            dy = 0;
+            line = tilePos.y;
+            position = MAXIMUM_MAP_SIZE_TECHNICAL - 1 - tilePos.x;
             break;
         case 2:
-            x = MAXIMUM_MAP_SIZE_BIG - ((_currentLine + 1) * COORDS_XY_STEP);
-            y = MAXIMUM_TILE_START_XY;
-            dx = 0;
-            dy = -COORDS_XY_STEP;
+            line = MAXIMUM_MAP_SIZE_TECHNICAL - 1 - tilePos.x;
+            position = MAXIMUM_MAP_SIZE_TECHNICAL - 1 - tilePos.y;
             break;
         case 3:
-            x = 0;
-            y = MAXIMUM_MAP_SIZE_BIG - ((_currentLine + 1) * COORDS_XY_STEP);
-            dx = COORDS_XY_STEP;
-            dy = 0;
+            line = MAXIMUM_MAP_SIZE_TECHNICAL - 1 - tilePos.y;
+            position = tilePos.x;
             break;
     }
 
-    for (int32_t i = 0; i < MAXIMUM_MAP_SIZE_TECHNICAL; i++)
+    uint16_t colour = 0;
+    switch (w->selected_tab)
     {
-        if (x > 0 && y > 0 && x < gMapSizeUnits && y < gMapSizeUnits)
+        case PAGE_PEEPS:
+            colour = map_window_get_pixel_colour_peep(mapPos);
+            break;
+        case PAGE_RIDES:
+            colour = map_window_get_pixel_colour_ride(mapPos);
+            break;
+    }
+
+    auto destinationPosition = ScreenCoordsXY{ MAXIMUM_MAP_SIZE_TECHNICAL - 1 - line + position, line + position };
+    auto destination = _mapImageData.data() + (destinationPosition.y * MAP_WINDOW_MAP_SIZE) + destinationPosition.x;
+    destination[0] = (colour >> 8) & 0xFF;
+    destination[1] = colour;
+}
+
+/**
+ * Recolours the tiles that changed since the last update, or the whole map when the tab, rotation or map size changed
+ * or too many tiles changed at once.
+ */
+static void map_window_update_pixels(rct_window* w)
+{
+    const auto hasChangedTiles = map_take_changed_tiles(_mapChangedTiles);
+    if (hasChangedTiles && _mapImageTab == w->selected_tab && _mapImageMapSize == gMapSize)
+    {
+        for (const auto& tilePos : _mapChangedTiles)
         {
-            switch (w->selected_tab)
-            {
-                case PAGE_PEEPS:
-                    colour = map_window_get_pixel_colour_peep({ x, y });
-                    break;
-                case PAGE_RIDES:
-                    colour = map_window_get_pixel_colour_ride({ x, y });
-                    break;
-            }
-            destination[0] = (colour >> 8) & 0xFF;
-            destination[1] = colour;
+            map_window_set_tile_pixels(w, tilePos);
         }
-        x += dx;
-        y += dy;
+        return;
+    }
 
-        destinationPosition.x++;
-        destinationPosition.y++;
-        destination = _mapImageData.data() + (destinationPosition.y * MAP_WINDOW_MAP_SIZE) + destinationPosition.x;
+    if (_mapImageMapSize != gMapSize)
+    {
+        // Tiles outside of a shrunk map would keep their colour
+        std::fill(_mapImageData.begin(), _mapImageData.end(), PALETTE_INDEX_10);
+    }
+    for (int32_t y = 0; y < gMapSize; y++)
+    {
+        for (int32_t x = 0; x < gMapSize; x++)
+        {
+            map_window_set_tile_pixels(w, { x, y });
+        }
     }
-    _currentLine++;
-    if (_currentLine >= MAXIMUM_MAP_SIZE_TECHNICAL)
-        _currentLine = 0;
+    _mapImageTab = w->selected_tab;
+    _mapImageMapSize = gMapSize;
 }
 
 static CoordsXY map_window_screen_to_map(ScreenCoordsXY screenCoords)
@@ -103,6 +103,7 @@ static void window_scenarioselect_init_tabs(rct_window *w);
 static void window_scenarioselect_close(rct_window *w);
 static void window_scenarioselect_mouseup(rct_window *w, rct_widgetindex widgetIndex);
 static void window_scenarioselect_mousedown(rct_window *w, rct_widgetindex widgetIndex, rct_widget* widget);
+static void window_scenarioselect_update(rct_window *w);
 static void window_scenarioselect_scrollgetsize(rct_window *w, int32_t scrollIndex, int32_t *width, int32_t *height);
 static void window_scenarioselect_scrollmousedown(rct_window *w, int32_t scrollIndex, const ScreenCoordsXY& screenCoords);
 static void window_scenarioselect_scrollmouseover(rct_window *w, int32_t scrollIndex, const ScreenCoordsXY& screenCoords);
@@ -120,6 +121,7 @@ static rct_window_event_list window_scenarioselect_events([](auto& events)
     events.close = &window_scenarioselect_close;
     events.mouse_up = &window_scenarioselect_mouseup;
     events.mouse_down = &window_scenarioselect_mousedown;
+    events.update = &window_scenarioselect_update;
     events.get_scroll_size = &window_scenarioselect_scrollgetsize;
     events.scroll_mousedown = &window_scenarioselect_scrollmousedown;
     events.scroll_mouseover = &window_scenarioselect_scrollmouseover;
@@ -169,8 +171,10 @@ rct_window* window_scenarioselect_open(std::function<void(std::string_view)> cal
     _callback = callback;
     _disableLocking = disableLocking;
 
-    // Load scenario list
-    scenario_repository_scan();
+    // Show the scenarios found by the last scan straight away and rescan in the background, the list is refreshed
+    // once the scan has finished
+    scenario_repository_poll_scan();
+    scenario_repository_scan_async();
 
     // Shrink the window if we're showing scenarios by difficulty level.
     if (gConfigGeneral.scenario_select_mode == SCENARIO_SELECT_MODE_DIFFICULTY && !_titleEditor)
@@ -284,6 +288,19 @@ static void window_scenarioselect_mousedown(rct_window* w, rct_widgetindex widge
     }
 }
 
+static void window_scenarioselect_update(rct_window* w)
+{
+    // Replacing the scenarios invalidates every entry the list refers to
+    if (scenario_repository_poll_scan())
+    {
+        w->highlighted_scenario = nullptr;
+        window_scenarioselect_init_tabs(w);
+        initialise_list_items(w);
+        WindowInitScrollWidgets(w);
+        w->Invalidate();
+    }
+}
+
 static int32_t get_scenario_list_item_size()
 {
     if (!LocalisationService_UseTrueTypeFont())
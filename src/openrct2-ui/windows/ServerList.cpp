@@ -10,7 +10,6 @@
 #ifndef DISABLE_NETWORK
 
 #    include <algorithm>
-#    include <chrono>
 #    include <openrct2-ui/interface/Dropdown.h>
 #    include <openrct2-ui/interface/Widget.h>
 #    include <openrct2-ui/windows/Window.h>
@@ -26,7 +25,6 @@
 #    include <openrct2/platform/platform.h>
 #    include <openrct2/sprites.h>
 #    include <openrct2/util/Util.h>
-#    include <tuple>
 
 #    define WWIDTH_MIN 500
 #    define WHEIGHT_MIN 300
@@ -36,7 +34,7 @@
 
 static char _playerName[32 + 1];
 static ServerList _serverList;
-static std::future<std::tuple<std::vector<ServerListEntry>, rct_string_id>> _fetchFuture;
+static std::shared_ptr<ServerListFetch> _fetch;
 static uint32_t _numPlayersOnline = 0;
 static rct_string_id _statusText = STR_SERVER_LIST_CONNECTING;
 
@@ -112,7 +110,7 @@ static std::string _version;
 
 static void server_list_get_item_button(int32_t buttonIndex, int32_t x, int32_t y, int32_t width, int32_t* outX, int32_t* outY);
 static void join_server(std::string address);
-static void server_list_fetch_servers_begin();
+static void server_list_fetch_servers_begin(bool refresh);
 static void server_list_fetch_servers_check(rct_window* w);
 
 rct_window* window_server_list_open()
@@ -150,7 +148,7 @@ rct_window* window_server_list_open()
     _serverList.ReadAndAddFavourites();
     window->no_list_items = static_cast<uint16_t>(_serverList.GetCount());
 
-    server_list_fetch_servers_begin();
+    server_list_fetch_servers_begin(false);
 
     return window;
 }
@@ -158,7 +156,7 @@ rct_window* window_server_list_open()
 static void window_server_list_close(rct_window* w)
 {
     _serverList = {};
-    _fetchFuture = {};
+    _fetch = nullptr;
 }
 
 static void window_server_list_mouseup(rct_window* w, rct_widgetindex widgetIndex)
@@ -191,7 +189,7 @@ static void window_server_list_mouseup(rct_window* w, rct_widgetindex widgetInde
             break;
         }
         case WIDX_FETCH_SERVERS:
-            server_list_fetch_servers_begin();
+            server_list_fetch_servers_begin(true);
             break;
         case WIDX_ADD_SERVER:
             window_text_input_open(w, widgetIndex, STR_ADD_SERVER, STR_ENTER_HOSTNAME_OR_IP_ADDRESS, STR_NONE, 0, 128);
@@ -549,9 +547,9 @@ static void join_server(std::string address)
     }
 }
 
-static void server_list_fetch_servers_begin()
+static void server_list_fetch_servers_begin(bool refresh)
 {
-    if (_fetchFuture.valid())
+    if (_fetch != nullptr)
     {
         // A fetch is already in progress
         return;
@@ -560,71 +558,36 @@ static void server_list_fetch_servers_begin()
     _serverList.Clear();
     _serverList.ReadAndAddFavourites();
     _statusText = STR_SERVER_LIST_CONNECTING;
-
-    _fetchFuture = std::async(std::launch::async, [] {
-        // Spin off background fetches
-        auto lanF = _serverList.FetchLocalServerListAsync();
-        auto wanF = _serverList.FetchOnlineServerListAsync();
-
-        // Merge or deal with errors
-        std::vector<ServerListEntry> allEntries;
-        try
-        {
-            auto entries = lanF.get();
-            allEntries.insert(allEntries.end(), entries.begin(), entries.end());
-        }
-        catch (...)
-        {
-        }
-
-        auto status = STR_NONE;
-        try
-        {
-            auto entries = wanF.get();
-            allEntries.insert(allEntries.end(), entries.begin(), entries.end());
-        }
-        catch (const MasterServerException& e)
-        {
-            status = e.StatusText;
-        }
-        catch (...)
-        {
-            status = STR_SERVER_LIST_NO_CONNECTION;
-        }
-        return std::make_tuple(allEntries, status);
-    });
+    _fetch = _serverList.FetchServersAsync(refresh);
 }
 
 static void server_list_fetch_servers_check(rct_window* w)
 {
-    if (_fetchFuture.valid())
+    if (_fetch == nullptr)
     {
-        auto status = _fetchFuture.wait_for(std::chrono::seconds::zero());
-        if (status == std::future_status::ready)
+        return;
+    }
+
+    // Servers are listed as soon as they answer, the status is only known once every query has finished
+    const bool finished = _fetch->IsFinished();
+    auto entries = _fetch->TakeEntries();
+    if (!entries.empty())
+    {
+        _serverList.AddRange(entries);
+        _numPlayersOnline = _serverList.GetTotalPlayerCount();
+        w->no_list_items = static_cast<uint16_t>(_serverList.GetCount());
+        w->Invalidate();
+    }
+
+    if (finished)
+    {
+        _statusText = STR_X_PLAYERS_ONLINE;
+        if (_fetch->GetStatus() != STR_NONE)
         {
-            try
-            {
-                auto [entries, statusText] = _fetchFuture.get();
-                _serverList.AddRange(entries);
-                _numPlayersOnline = _serverList.GetTotalPlayerCount();
-                _statusText = STR_X_PLAYERS_ONLINE;
-                if (statusText != STR_NONE)
-                {
-                    _statusText = statusText;
-                }
-            }
-            catch (const MasterServerException& e)
-            {
-                _statusText = e.StatusText;
-            }
-            catch (const std::exception& e)
-            {
-                _statusText = STR_SERVER_LIST_NO_CONNECTION;
-                log_warning("Unable to connect to master server: %s", e.what());
-            }
-            _fetchFuture = {};
-            w->Invalidate();
+            _statusText = _fetch->GetStatus();
         }
+        _fetch = nullptr;
+        w->Invalidate();
     }
 }
 
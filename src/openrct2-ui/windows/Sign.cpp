@@ -137,7 +137,7 @@ rct_window* window_sign_open(rct_windownumber number)
             }
         }
         tile_element++;
-        if (tile_element >= &gTileElements[std::size(gTileElements)])
+        if (tile_element >= map_get_tile_elements_end())
         {
             return nullptr;
         }
@@ -193,7 +193,7 @@ static void window_sign_mouseup(rct_window* w, rct_widgetindex widgetIndex)
                     }
                 }
                 tile_element++;
-                if (tile_element >= &gTileElements[std::size(gTileElements)])
+                if (tile_element >= map_get_tile_elements_end())
                 {
                     return;
                 }
@@ -8,6 +8,7 @@
  *****************************************************************************/
 
 #include <algorithm>
+#include <cstring>
 #include <iterator>
 #include <openrct2-ui/interface/Dropdown.h>
 #include <openrct2-ui/interface/Widget.h>
@@ -422,6 +423,9 @@ static bool windowTileInspectorApplyToAll = false;
 static bool windowTileInspectorElementCopied = false;
 static TileElement tileInspectorCopiedElement;
 
+// The elements of the selected tile as the list last showed them, the list is only redrawn when they change
+static std::vector<TileElement> windowTileInspectorListedElements;
+
 static void window_tile_inspector_mouseup(rct_window* w, rct_widgetindex widgetIndex);
 static void window_tile_inspector_resize(rct_window* w);
 static void window_tile_inspector_mousedown(rct_window* w, rct_widgetindex widgetIndex, rct_widget* widget);
@@ -551,6 +555,38 @@ static void window_tile_inspector_select_element_from_list(rct_window* w, int32_
     w->Invalidate();
 }
 
+/**
+ * Compares the elements of the selected tile to the ones the list shows, and takes them if they have changed.
+ * @returns true if the list is out of date.
+ */
+static bool window_tile_inspector_refresh_listed_elements()
+{
+    const TileElement* firstElement = map_get_first_element_at(windowTileInspectorToolMap);
+    const TileElement* element = firstElement;
+    size_t numElements = 0;
+    do
+    {
+        if (element == nullptr)
+            break;
+        numElements++;
+    } while (!(element++)->IsLastForTile());
+
+    if (numElements == windowTileInspectorListedElements.size()
+        && (numElements == 0
+            || std::memcmp(firstElement, windowTileInspectorListedElements.data(), numElements * sizeof(TileElement)) == 0))
+    {
+        return false;
+    }
+
+    windowTileInspectorListedElements.assign(firstElement, firstElement + numElements);
+    windowTileInspectorElementCount = static_cast<int32_t>(numElements);
+    if (windowTileInspectorSelectedIndex >= windowTileInspectorElementCount)
+    {
+        windowTileInspectorSelectedIndex = -1;
+    }
+    return true;
+}
+
 static void window_tile_inspector_load_tile(rct_window* w, TileElement* elementToSelect)
 {
     windowTileInspectorSelectedIndex = -1;
@@ -571,6 +607,7 @@ static void window_tile_inspector_load_tile(rct_window* w, TileElement* elementT
     } while (!(element++)->IsLastForTile());
 
     windowTileInspectorElementCount = numItems;
+    window_tile_inspector_refresh_listed_elements();
 
     w->Invalidate();
 }
@@ -1165,12 +1202,18 @@ static void window_tile_inspector_mousedown(rct_window* w, rct_widgetindex widge
 static void window_tile_inspector_update(rct_window* w)
 {
     // Check if the mouse is hovering over the list
-    if (!WidgetIsHighlighted(w, WIDX_LIST))
+    if (!WidgetIsHighlighted(w, WIDX_LIST) && windowTileInspectorHighlightedIndex != -1)
     {
         windowTileInspectorHighlightedIndex = -1;
         widget_invalidate(w, WIDX_LIST);
     }
 
+    // Other players and the game itself can change the tile too
+    if (windowTileInspectorTileSelected && window_tile_inspector_refresh_listed_elements())
+    {
+        w->Invalidate();
+    }
+
     if (gCurrentToolWidget.window_classification != WC_TILE_INSPECTOR)
         window_close(w);
 }
@@ -1344,11 +1387,13 @@ static void window_tile_inspector_scrollmouseover(rct_window* w, int32_t scrollI
 {
     int16_t index = windowTileInspectorElementCount - (screenCoords.y - 1) / SCROLLABLE_ROW_HEIGHT - 1;
     if (index < 0 || index >= windowTileInspectorElementCount)
-        windowTileInspectorHighlightedIndex = -1;
-    else
-        windowTileInspectorHighlightedIndex = index;
+        index = -1;
 
-    widget_invalidate(w, WIDX_LIST);
+    if (index != windowTileInspectorHighlightedIndex)
+    {
+        windowTileInspectorHighlightedIndex = index;
+        widget_invalidate(w, WIDX_LIST);
+    }
 }
 
 static void window_tile_inspector_invalidate(rct_window* w)
@@ -2265,6 +2310,15 @@ static void window_tile_inspector_scrollpaint(rct_window* w, rct_drawpixelinfo*
     {
         if (tileElement == nullptr)
             break;
+
+        // Only the rows within the clip are formatted and drawn
+        if (screenCoords.y + SCROLLABLE_ROW_HEIGHT <= dpi->y || screenCoords.y >= dpi->y + dpi->height)
+        {
+            screenCoords.y -= SCROLLABLE_ROW_HEIGHT;
+            i++;
+            continue;
+        }
+
         const bool selectedRow = i == windowTileInspectorSelectedIndex;
         const bool hoveredRow = i == windowTileInspectorHighlightedIndex;
         int32_t type = tileElement->GetType();
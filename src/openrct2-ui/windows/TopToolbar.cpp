@@ -39,6 +39,7 @@
 #include <openrct2/actions/PauseToggleAction.h>
 #include <openrct2/actions/SetCheatAction.h>
 #include <openrct2/actions/SmallSceneryPlaceAction.h>
+#include <openrct2/actions/SmallSceneryScatterAction.h>
 #include <openrct2/actions/SmallScenerySetColourAction.h>
 #include <openrct2/actions/SurfaceSetStyleAction.h>
 #include <openrct2/actions/WallPlaceAction.h>
@@ -1751,7 +1752,11 @@ static void window_top_toolbar_scenery_tool_down(const ScreenCoordsXY& windowPos
                 }
             }
 
-            bool forceError = true;
+            // All the items of a cluster are placed by a single action, sent over the network as one message
+            auto scatterAction = SmallSceneryScatterAction(
+                selectedScenery, gWindowSceneryPrimaryColour, gWindowScenerySecondaryColour);
+            CoordsXYZD lastLoc;
+            uint8_t lastQuadrant = 0;
             for (int32_t q = 0; q < quantity; q++)
             {
                 int32_t zCoordinate = gSceneryPlaceZ;
@@ -1813,32 +1818,42 @@ static void window_top_toolbar_scenery_tool_down(const ScreenCoordsXY& windowPos
                     }
                 }
 
-                // Actually place
-                if (success == GameActions::Status::Ok || ((q + 1 == quantity) && forceError))
+                lastLoc = { cur_grid_x, cur_grid_y, gSceneryPlaceZ, gSceneryPlaceRotation };
+                lastQuadrant = quadrant;
+                if (success == GameActions::Status::Ok)
                 {
-                    auto smallSceneryPlaceAction = SmallSceneryPlaceAction(
-                        { cur_grid_x, cur_grid_y, gSceneryPlaceZ, gSceneryPlaceRotation }, quadrant, selectedScenery,
-                        gWindowSceneryPrimaryColour, gWindowScenerySecondaryColour);
+                    scatterAction.AddItem(lastLoc, lastQuadrant);
+                }
+                gSceneryPlaceZ = zCoordinate;
+            }
 
-                    smallSceneryPlaceAction.SetCallback([=](const GameAction* ga, const GameActions::Result* result) {
-                        if (result->Error == GameActions::Status::Ok)
-                        {
-                            OpenRCT2::Audio::Play3D(OpenRCT2::Audio::SoundId::PlaceItem, result->Position);
-                        }
-                    });
-                    auto res = GameActions::Execute(&smallSceneryPlaceAction);
-                    if (res->Error == GameActions::Status::Ok)
+            if (!isCluster)
+            {
+                auto smallSceneryPlaceAction = SmallSceneryPlaceAction(
+                    lastLoc, lastQuadrant, selectedScenery, gWindowSceneryPrimaryColour, gWindowScenerySecondaryColour);
+                smallSceneryPlaceAction.SetCallback([=](const GameAction* ga, const GameActions::Result* result) {
+                    if (result->Error == GameActions::Status::Ok)
                     {
-                        forceError = false;
+                        OpenRCT2::Audio::Play3D(OpenRCT2::Audio::SoundId::PlaceItem, result->Position);
                     }
+                });
+                GameActions::Execute(&smallSceneryPlaceAction);
+                break;
+            }
 
-                    if (res->Error == GameActions::Status::InsufficientFunds)
-                    {
-                        break;
-                    }
-                }
-                gSceneryPlaceZ = zCoordinate;
+            // Place the last item anyway if none of them fit, so the reason is shown
+            if (scatterAction.GetNumItems() == 0)
+            {
+                scatterAction.AddItem(lastLoc, lastQuadrant);
             }
+
+            scatterAction.SetCallback([=](const GameAction* ga, const GameActions::Result* result) {
+                if (result->Error == GameActions::Status::Ok)
+                {
+                    OpenRCT2::Audio::Play3D(OpenRCT2::Audio::SoundId::PlaceItem, result->Position);
+                }
+            });
+            GameActions::Execute(&scatterAction);
             break;
         }
         case SCENERY_TYPE_PATH_ITEM:
@@ -18,6 +18,7 @@
 #include <openrct2/actions/TrackDesignAction.h>
 #include <openrct2/audio/audio.h>
 #include <openrct2/localisation/Localisation.h>
+#include <openrct2/platform/platform.h>
 #include <openrct2/ride/RideData.h>
 #include <openrct2/ride/Track.h>
 #include <openrct2/ride/TrackData.h>
@@ -29,6 +30,7 @@
 #include <openrct2/windows/Intent.h>
 #include <openrct2/world/Park.h>
 #include <openrct2/world/Surface.h>
+#include <unordered_map>
 #include <vector>
 
 using namespace OpenRCT2;
@@ -103,7 +105,32 @@ static money32 _window_track_place_last_cost;
 
 static std::unique_ptr<TrackDesign> _trackDesign;
 
+/**
+ * The outcome of querying the design at a tile, with the height it was found to fit at.
+ */
+struct TrackPlaceQueryResult
+{
+    int32_t BaseZ;
+    CoordsXYZ Location;
+    GameActions::Status Error;
+    money32 Cost;
+    uint32_t Time;
+};
+
+// Query results are reused while the cursor moves back and forth, until the map may have changed too much
+static constexpr uint32_t TRACK_PLACE_QUERY_LIFETIME_MS = 1000;
+static constexpr size_t TRACK_PLACE_QUERY_CACHE_SIZE = 1024;
+static std::unordered_map<uint32_t, TrackPlaceQueryResult> _windowTrackPlaceQueries;
+
+// The ghost is only built once the cursor has stayed on the same tile for this many updates
+static constexpr int32_t TRACK_PLACE_GHOST_DELAY = 3;
+static bool _windowTrackPlaceGhostPending;
+static CoordsXYZ _windowTrackPlaceGhostLoc;
+static int32_t _windowTrackPlaceGhostTicks;
+
 static void window_track_place_clear_provisional();
+static const TrackPlaceQueryResult& window_track_place_query(const CoordsXYZ& loc);
+static void window_track_place_place_ghost(rct_window* w);
 static int32_t window_track_place_get_base_z(const CoordsXY& loc);
 
 static void window_track_place_clear_mini_preview();
@@ -174,6 +201,7 @@ static void window_track_place_close(rct_window* w)
     hide_gridlines();
     _window_track_place_mini_preview.clear();
     _window_track_place_mini_preview.shrink_to_fit();
+    _windowTrackPlaceQueries.clear();
     _trackDesign = nullptr;
 }
 
@@ -200,6 +228,7 @@ static void window_track_place_mouseup(rct_window* w, rct_widgetindex widgetInde
             _currentTrackPieceDirection = (0 - _currentTrackPieceDirection) & 3;
             w->Invalidate();
             _windowTrackPlaceLast.setNull();
+            _windowTrackPlaceQueries.clear();
             window_track_place_draw_mini_preview(_trackDesign.get());
             break;
         case WIDX_SELECT_DIFFERENT_DESIGN:
@@ -222,6 +251,16 @@ static void window_track_place_update(rct_window* w)
     if (!(input_test_flag(INPUT_FLAG_TOOL_ACTIVE)))
         if (gCurrentToolWidget.window_classification != WC_TRACK_DESIGN_PLACE)
             window_close(w);
+
+    if (_windowTrackPlaceGhostPending)
+    {
+        _windowTrackPlaceGhostTicks++;
+        if (_windowTrackPlaceGhostTicks >= TRACK_PLACE_GHOST_DELAY)
+        {
+            _windowTrackPlaceGhostPending = false;
+            window_track_place_place_ghost(w);
+        }
+    }
 }
 
 static GameActions::Result::Ptr FindValidTrackDesignPlaceHeight(CoordsXYZ& loc, uint32_t flags)
@@ -280,23 +319,16 @@ static void window_track_place_toolupdate(rct_window* w, rct_widgetindex widgetI
     if (game_is_not_paused() || gCheatsBuildInPauseMode)
     {
         window_track_place_clear_provisional();
-        auto res = FindValidTrackDesignPlaceHeight(trackLoc, GAME_COMMAND_FLAG_NO_SPEND | GAME_COMMAND_FLAG_GHOST);
+        const auto& query = window_track_place_query(trackLoc);
+        trackLoc = query.Location;
 
-        if (res->Error == GameActions::Status::Ok)
+        if (query.Error == GameActions::Status::Ok)
         {
-            // Valid location found. Place the ghost at the location.
-            auto tdAction = TrackDesignAction({ trackLoc, _currentTrackPieceDirection }, *_trackDesign);
-            tdAction.SetFlags(GAME_COMMAND_FLAG_NO_SPEND | GAME_COMMAND_FLAG_GHOST);
-            tdAction.SetCallback([trackLoc](const GameAction*, const TrackDesignActionResult* result) {
-                if (result->Error == GameActions::Status::Ok)
-                {
-                    _window_track_place_ride_index = result->rideIndex;
-                    _windowTrackPlaceLastValid = trackLoc;
-                    _window_track_place_last_was_valid = true;
-                }
-            });
-            res = GameActions::Execute(&tdAction);
-            cost = res->Error == GameActions::Status::Ok ? res->Cost : MONEY32_UNDEFINED;
+            // Valid location found, the ghost is placed there once the cursor stops moving
+            cost = query.Cost;
+            _windowTrackPlaceGhostPending = true;
+            _windowTrackPlaceGhostLoc = trackLoc;
+            _windowTrackPlaceGhostTicks = 0;
         }
     }
 
@@ -333,6 +365,7 @@ static void window_track_place_tooldown(rct_window* w, rct_widgetindex widgetInd
     auto res = FindValidTrackDesignPlaceHeight(trackLoc, 0);
     if (res->Error == GameActions::Status::Ok)
     {
+        _windowTrackPlaceQueries.clear();
         auto tdAction = TrackDesignAction({ trackLoc, _currentTrackPieceDirection }, *_trackDesign);
         tdAction.SetCallback([trackLoc](const GameAction*, const TrackDesignActionResult* result) {
             if (result->Error == GameActions::Status::Ok)
@@ -399,12 +432,76 @@ static void window_track_place_invalidate(rct_window* w)
     window_track_place_draw_mini_preview(_trackDesign.get());
 }
 
+/**
+ * Queries placing the design at the given tile, raising it until it fits. The result is reused when the cursor returns to
+ * the tile shortly after.
+ */
+static const TrackPlaceQueryResult& window_track_place_query(const CoordsXYZ& loc)
+{
+    auto tileCoords = TileCoordsXY(loc);
+    uint32_t key = tileCoords.x | (tileCoords.y << 8) | (_currentTrackPieceDirection << 16);
+    auto now = platform_get_ticks();
+
+    auto it = _windowTrackPlaceQueries.find(key);
+    if (it != _windowTrackPlaceQueries.end() && it->second.BaseZ == loc.z
+        && now - it->second.Time < TRACK_PLACE_QUERY_LIFETIME_MS)
+    {
+        return it->second;
+    }
+
+    if (_windowTrackPlaceQueries.size() >= TRACK_PLACE_QUERY_CACHE_SIZE)
+    {
+        _windowTrackPlaceQueries.clear();
+    }
+
+    CoordsXYZ trackLoc = loc;
+    auto res = FindValidTrackDesignPlaceHeight(trackLoc, GAME_COMMAND_FLAG_NO_SPEND | GAME_COMMAND_FLAG_GHOST);
+    auto& result = _windowTrackPlaceQueries[key];
+    result.BaseZ = loc.z;
+    result.Location = trackLoc;
+    result.Error = res->Error;
+    result.Cost = res->Error == GameActions::Status::Ok ? res->Cost : MONEY32_UNDEFINED;
+    result.Time = now;
+    return result;
+}
+
+/**
+ * Places the ghost of the design at the location the cursor has settled on.
+ */
+static void window_track_place_place_ghost(rct_window* w)
+{
+    if (!(game_is_not_paused() || gCheatsBuildInPauseMode))
+        return;
+
+    window_track_place_clear_provisional();
+
+    auto trackLoc = _windowTrackPlaceGhostLoc;
+    auto tdAction = TrackDesignAction({ trackLoc, _currentTrackPieceDirection }, *_trackDesign);
+    tdAction.SetFlags(GAME_COMMAND_FLAG_NO_SPEND | GAME_COMMAND_FLAG_GHOST);
+    tdAction.SetCallback([trackLoc](const GameAction*, const TrackDesignActionResult* result) {
+        if (result->Error == GameActions::Status::Ok)
+        {
+            _window_track_place_ride_index = result->rideIndex;
+            _windowTrackPlaceLastValid = trackLoc;
+            _window_track_place_last_was_valid = true;
+        }
+    });
+    auto res = GameActions::Execute(&tdAction);
+    money32 cost = res->Error == GameActions::Status::Ok ? res->Cost : MONEY32_UNDEFINED;
+    if (cost != _window_track_place_last_cost)
+    {
+        _window_track_place_last_cost = cost;
+        widget_invalidate(w, WIDX_PRICE);
+    }
+}
+
 /**
  *
  *  rct2: 0x006D017F
  */
 static void window_track_place_clear_provisional()
 {
+    _windowTrackPlaceGhostPending = false;
     if (_window_track_place_last_was_valid)
     {
         auto ride = get_ride(_window_track_place_ride_index);
@@ -8,6 +8,8 @@
  *****************************************************************************/
 
 #include <algorithm>
+#include <deque>
+#include <memory>
 #include <openrct2-ui/interface/Widget.h>
 #include <openrct2-ui/windows/Window.h>
 #include <openrct2/Context.h>
@@ -22,6 +24,7 @@
 #include <openrct2/ride/TrackDesignRepository.h>
 #include <openrct2/sprites.h>
 #include <openrct2/windows/Intent.h>
+#include <string>
 #include <vector>
 
 static constexpr const rct_string_id WINDOW_TITLE = STR_SELECT_DESIGN;
@@ -90,10 +93,28 @@ static std::vector<track_design_file_ref> _trackDesigns;
 static utf8 _filterString[USER_STRING_MAX_LENGTH];
 static std::vector<uint16_t> _filteredTrackIds;
 static uint16_t _loadedTrackDesignIndex;
-static std::unique_ptr<TrackDesign> _loadedTrackDesign;
+static std::shared_ptr<TrackDesign> _loadedTrackDesign;
 static std::vector<uint8_t> _trackDesignPreviewPixels;
 
+// Designs that have been previewed recently, most recent first, so going back to one does not draw it again
+struct TrackDesignPreview
+{
+    std::string Path;
+    bool SceneryToggle;
+    std::shared_ptr<TrackDesign> Design;
+    std::vector<uint8_t> Pixels;
+};
+static constexpr size_t TRACK_DESIGN_PREVIEW_CACHE_SIZE = 16;
+static std::deque<TrackDesignPreview> _trackDesignPreviewCache;
+
+// The highlighted design is only loaded and drawn once it has stayed highlighted for this many updates, so moving the
+// mouse over the list does not draw every design on the way
+static constexpr int32_t TRACK_DESIGN_PREVIEW_DELAY = 2;
+static int32_t _highlightedTrackDesignIndex = -1;
+static int32_t _highlightedTrackDesignTicks;
+
 static void track_list_load_designs(RideSelection item);
+static void track_list_load_design(int32_t trackIndex);
 static bool track_list_load_design_for_preview(utf8* path);
 
 /**
@@ -194,6 +215,7 @@ static void window_track_list_close(rct_window* w)
     _loadedTrackDesign = nullptr;
     _trackDesignPreviewPixels.clear();
     _trackDesignPreviewPixels.shrink_to_fit();
+    _trackDesignPreviewCache.clear();
 
     // Dispose track list
     for (auto& trackDesign : _trackDesigns)
@@ -234,6 +256,8 @@ static void window_track_list_select(rct_window* w, int32_t listIndex)
         listIndex--;
     }
 
+    track_list_load_design(_filteredTrackIds[listIndex]);
+
     // Displays a message if the ride can't load, fix #4080
     if (_loadedTrackDesign == nullptr)
     {
@@ -289,6 +313,22 @@ static int32_t window_track_list_get_list_item_index_from_position(const ScreenC
  *
  *  rct2: 0x006CFA31
  */
+/**
+ * Returns the index in _trackDesigns of the highlighted design, or -1 when no design is highlighted.
+ */
+static int32_t window_track_list_get_selected_track_index(rct_window* w)
+{
+    int32_t listItemIndex = w->selected_list_item;
+    if (!(gScreenFlags & SCREEN_FLAGS_TRACK_MANAGER))
+    {
+        // Because the first item in the list is "Build a custom design", lower the index by one
+        listItemIndex--;
+    }
+    if (listItemIndex < 0 || static_cast<size_t>(listItemIndex) >= _filteredTrackIds.size())
+        return -1;
+    return _filteredTrackIds[listItemIndex];
+}
+
 static void window_track_list_mouseup(rct_window* w, rct_widgetindex widgetIndex)
 {
     switch (widgetIndex)
@@ -419,6 +459,22 @@ static void window_track_list_update(rct_window* w)
         w->Invalidate();
         w->track_list.reload_track_designs = false;
     }
+
+    int32_t trackIndex = window_track_list_get_selected_track_index(w);
+    if (trackIndex != _highlightedTrackDesignIndex)
+    {
+        _highlightedTrackDesignIndex = trackIndex;
+        _highlightedTrackDesignTicks = 0;
+    }
+    else if (trackIndex != -1 && trackIndex != _loadedTrackDesignIndex)
+    {
+        _highlightedTrackDesignTicks++;
+        if (_highlightedTrackDesignTicks >= TRACK_DESIGN_PREVIEW_DELAY)
+        {
+            track_list_load_design(trackIndex);
+            widget_invalidate(w, WIDX_TRACK_PREVIEW);
+        }
+    }
 }
 
 /**
@@ -480,22 +536,9 @@ static void window_track_list_paint(rct_window* w, rct_drawpixelinfo* dpi)
 {
     WindowDrawWidgets(w, dpi);
 
-    int32_t listItemIndex = w->selected_list_item;
-    if (gScreenFlags & SCREEN_FLAGS_TRACK_MANAGER)
-    {
-        if (_trackDesigns.empty() || listItemIndex == -1)
-            return;
-    }
-    else
-    {
-        if (listItemIndex == 0)
-            return;
-
-        // Because the first item in the list is "Build a custom design", lower the index by one
-        listItemIndex--;
-    }
-
-    int32_t trackIndex = _filteredTrackIds[listItemIndex];
+    int32_t trackIndex = window_track_list_get_selected_track_index(w);
+    if (trackIndex == -1)
+        return;
 
     // Track preview
     int32_t colour;
@@ -504,56 +547,42 @@ static void window_track_list_paint(rct_window* w, rct_drawpixelinfo* dpi)
     colour = ColourMapA[w->colours[0]].darkest;
     gfx_fill_rect(dpi, { screenPos, screenPos + ScreenCoordsXY{ 369, 216 } }, colour);
 
-    if (_loadedTrackDesignIndex != trackIndex)
-    {
-        utf8* path = _trackDesigns[trackIndex].path;
-        if (track_list_load_design_for_preview(path))
-        {
-            _loadedTrackDesignIndex = trackIndex;
-        }
-        else
-        {
-            _loadedTrackDesignIndex = TRACK_DESIGN_INDEX_UNLOADED;
-        }
-    }
-
-    if (!_loadedTrackDesign)
-    {
-        return;
-    }
-
+    // The preview and the warnings need the design to be loaded, the statistics come from the track design index
+    const TrackDesign* loadedTrackDesign = _loadedTrackDesignIndex == trackIndex ? _loadedTrackDesign.get() : nullptr;
     auto trackPreview = screenPos;
     screenPos = w->windowPos + ScreenCoordsXY{ widget->midX(), widget->midY() };
-
-    rct_g1_element g1temp = {};
-    g1temp.offset = _trackDesignPreviewPixels.data() + (_currentTrackPieceDirection * TRACK_PREVIEW_IMAGE_SIZE);
-    g1temp.width = 370;
-    g1temp.height = 217;
-    g1temp.flags = G1_FLAG_BMP;
-    gfx_set_g1_element(SPR_TEMP, &g1temp);
-    drawing_engine_invalidate_image(SPR_TEMP);
-    gfx_draw_sprite(dpi, SPR_TEMP, trackPreview, 0);
-
     screenPos.y = w->windowPos.y + widget->bottom - 12;
 
-    // Warnings
-    if ((_loadedTrackDesign->track_flags & TRACK_DESIGN_FLAG_VEHICLE_UNAVAILABLE)
-        && !(gScreenFlags & SCREEN_FLAGS_TRACK_MANAGER))
+    if (loadedTrackDesign != nullptr)
     {
-        // Vehicle design not available
-        DrawTextEllipsised(dpi, screenPos, 368, STR_VEHICLE_DESIGN_UNAVAILABLE, {}, { TextAlignment::CENTRE });
-        screenPos.y -= SCROLLABLE_ROW_HEIGHT;
-    }
+        rct_g1_element g1temp = {};
+        g1temp.offset = _trackDesignPreviewPixels.data() + (_currentTrackPieceDirection * TRACK_PREVIEW_IMAGE_SIZE);
+        g1temp.width = 370;
+        g1temp.height = 217;
+        g1temp.flags = G1_FLAG_BMP;
+        gfx_set_g1_element(SPR_TEMP, &g1temp);
+        drawing_engine_invalidate_image(SPR_TEMP);
+        gfx_draw_sprite(dpi, SPR_TEMP, trackPreview, 0);
 
-    if (_loadedTrackDesign->track_flags & TRACK_DESIGN_FLAG_SCENERY_UNAVAILABLE)
-    {
-        if (!gTrackDesignSceneryToggle)
+        // Warnings
+        if ((loadedTrackDesign->track_flags & TRACK_DESIGN_FLAG_VEHICLE_UNAVAILABLE)
+            && !(gScreenFlags & SCREEN_FLAGS_TRACK_MANAGER))
         {
-            // Scenery not available
-            DrawTextEllipsised(
-                dpi, screenPos, 368, STR_DESIGN_INCLUDES_SCENERY_WHICH_IS_UNAVAILABLE, {}, { TextAlignment::CENTRE });
+            // Vehicle design not available
+            DrawTextEllipsised(dpi, screenPos, 368, STR_VEHICLE_DESIGN_UNAVAILABLE, {}, { TextAlignment::CENTRE });
             screenPos.y -= SCROLLABLE_ROW_HEIGHT;
         }
+
+        if (loadedTrackDesign->track_flags & TRACK_DESIGN_FLAG_SCENERY_UNAVAILABLE)
+        {
+            if (!gTrackDesignSceneryToggle)
+            {
+                // Scenery not available
+                DrawTextEllipsised(
+                    dpi, screenPos, 368, STR_DESIGN_INCLUDES_SCENERY_WHICH_IS_UNAVAILABLE, {}, { TextAlignment::CENTRE });
+                screenPos.y -= SCROLLABLE_ROW_HEIGHT;
+            }
+        }
     }
 
     // Track design name
@@ -565,39 +594,40 @@ static void window_track_list_paint(rct_window* w, rct_drawpixelinfo* dpi)
     screenPos = w->windowPos + ScreenCoordsXY{ widget->left + 1, widget->bottom + 2 };
 
     // Stats
-    fixed32_2dp rating = _loadedTrackDesign->excitement * 10;
+    const auto& stats = _trackDesigns[trackIndex].stats;
+    fixed32_2dp rating = stats.excitement * 10;
     DrawTextBasic(dpi, screenPos, STR_TRACK_LIST_EXCITEMENT_RATING, &rating);
     screenPos.y += LIST_ROW_HEIGHT;
 
-    rating = _loadedTrackDesign->intensity * 10;
+    rating = stats.intensity * 10;
     DrawTextBasic(dpi, screenPos, STR_TRACK_LIST_INTENSITY_RATING, &rating);
     screenPos.y += LIST_ROW_HEIGHT;
 
-    rating = _loadedTrackDesign->nausea * 10;
+    rating = stats.nausea * 10;
     DrawTextBasic(dpi, screenPos, STR_TRACK_LIST_NAUSEA_RATING, &rating);
     screenPos.y += LIST_ROW_HEIGHT + 4;
 
     // Information for tracked rides.
-    if (GetRideTypeDescriptor(_loadedTrackDesign->type).HasFlag(RIDE_TYPE_FLAG_HAS_TRACK))
+    if (GetRideTypeDescriptor(stats.type).HasFlag(RIDE_TYPE_FLAG_HAS_TRACK))
     {
-        if (_loadedTrackDesign->type != RIDE_TYPE_MAZE)
+        if (stats.type != RIDE_TYPE_MAZE)
         {
-            if (_loadedTrackDesign->type == RIDE_TYPE_MINI_GOLF)
+            if (stats.type == RIDE_TYPE_MINI_GOLF)
             {
                 // Holes
-                uint16_t holes = _loadedTrackDesign->holes & 0x1F;
+                uint16_t holes = stats.holes & 0x1F;
                 DrawTextBasic(dpi, screenPos, STR_HOLES, &holes);
                 screenPos.y += LIST_ROW_HEIGHT;
             }
             else
             {
                 // Maximum speed
-                uint16_t speed = ((_loadedTrackDesign->max_speed << 16) * 9) >> 18;
+                uint16_t speed = ((stats.max_speed << 16) * 9) >> 18;
                 DrawTextBasic(dpi, screenPos, STR_MAX_SPEED, &speed);
                 screenPos.y += LIST_ROW_HEIGHT;
 
                 // Average speed
-                speed = ((_loadedTrackDesign->average_speed << 16) * 9) >> 18;
+                speed = ((stats.average_speed << 16) * 9) >> 18;
                 DrawTextBasic(dpi, screenPos, STR_AVERAGE_SPEED, &speed);
                 screenPos.y += LIST_ROW_HEIGHT;
             }
@@ -605,53 +635,53 @@ static void window_track_list_paint(rct_window* w, rct_drawpixelinfo* dpi)
             // Ride length
             ft = Formatter();
             ft.Add<rct_string_id>(STR_RIDE_LENGTH_ENTRY);
-            ft.Add<uint16_t>(_loadedTrackDesign->ride_length);
+            ft.Add<uint16_t>(stats.ride_length);
             DrawTextEllipsised(dpi, screenPos, 214, STR_TRACK_LIST_RIDE_LENGTH, ft);
             screenPos.y += LIST_ROW_HEIGHT;
         }
 
-        if (GetRideTypeDescriptor(_loadedTrackDesign->type).HasFlag(RIDE_TYPE_FLAG_HAS_G_FORCES))
+        if (GetRideTypeDescriptor(stats.type).HasFlag(RIDE_TYPE_FLAG_HAS_G_FORCES))
         {
             // Maximum positive vertical Gs
-            int32_t gForces = _loadedTrackDesign->max_positive_vertical_g * 32;
+            int32_t gForces = stats.max_positive_vertical_g * 32;
             DrawTextBasic(dpi, screenPos, STR_MAX_POSITIVE_VERTICAL_G, &gForces);
             screenPos.y += LIST_ROW_HEIGHT;
 
             // Maximum negative vertical Gs
-            gForces = _loadedTrackDesign->max_negative_vertical_g * 32;
+            gForces = stats.max_negative_vertical_g * 32;
             DrawTextBasic(dpi, screenPos, STR_MAX_NEGATIVE_VERTICAL_G, &gForces);
             screenPos.y += LIST_ROW_HEIGHT;
 
             // Maximum lateral Gs
-            gForces = _loadedTrackDesign->max_lateral_g * 32;
+            gForces = stats.max_lateral_g * 32;
             DrawTextBasic(dpi, screenPos, STR_MAX_LATERAL_G, &gForces);
             screenPos.y += LIST_ROW_HEIGHT;
 
-            if (_loadedTrackDesign->total_air_time != 0)
+            if (stats.total_air_time != 0)
             {
                 // Total air time
-                int32_t airTime = _loadedTrackDesign->total_air_time * 25;
+                int32_t airTime = stats.total_air_time * 25;
                 DrawTextBasic(dpi, screenPos, STR_TOTAL_AIR_TIME, &airTime);
                 screenPos.y += LIST_ROW_HEIGHT;
             }
         }
 
-        if (GetRideTypeDescriptor(_loadedTrackDesign->type).HasFlag(RIDE_TYPE_FLAG_HAS_DROPS))
+        if (GetRideTypeDescriptor(stats.type).HasFlag(RIDE_TYPE_FLAG_HAS_DROPS))
         {
             // Drops
-            uint16_t drops = _loadedTrackDesign->drops & 0x3F;
+            uint16_t drops = stats.drops & 0x3F;
             DrawTextBasic(dpi, screenPos, STR_DROPS, &drops);
             screenPos.y += LIST_ROW_HEIGHT;
 
             // Drop height is multiplied by 0.75
-            uint16_t highestDropHeight = (_loadedTrackDesign->highest_drop_height * 3) / 4;
+            uint16_t highestDropHeight = (stats.highest_drop_height * 3) / 4;
             DrawTextBasic(dpi, screenPos, STR_HIGHEST_DROP_HEIGHT, &highestDropHeight);
             screenPos.y += LIST_ROW_HEIGHT;
         }
 
-        if (_loadedTrackDesign->type != RIDE_TYPE_MINI_GOLF)
+        if (stats.type != RIDE_TYPE_MINI_GOLF)
         {
-            uint16_t inversions = _loadedTrackDesign->inversions & 0x1F;
+            uint16_t inversions = stats.inversions & 0x1F;
             if (inversions != 0)
             {
                 // Inversions
@@ -662,20 +692,20 @@ static void window_track_list_paint(rct_window* w, rct_drawpixelinfo* dpi)
         screenPos.y += 4;
     }
 
-    if (_loadedTrackDesign->space_required_x != 0xFF)
+    if (stats.space_required_x != 0xFF)
     {
         // Space required
         ft = Formatter();
-        ft.Add<uint16_t>(_loadedTrackDesign->space_required_x);
-        ft.Add<uint16_t>(_loadedTrackDesign->space_required_y);
+        ft.Add<uint16_t>(stats.space_required_x);
+        ft.Add<uint16_t>(stats.space_required_y);
         DrawTextBasic(dpi, screenPos, STR_TRACK_LIST_SPACE_REQUIRED, ft);
         screenPos.y += LIST_ROW_HEIGHT;
     }
 
-    if (_loadedTrackDesign->cost != 0)
+    if (loadedTrackDesign != nullptr && loadedTrackDesign->cost != 0)
     {
         ft = Formatter();
-        ft.Add<uint32_t>(_loadedTrackDesign->cost);
+        ft.Add<uint32_t>(loadedTrackDesign->cost);
         DrawTextBasic(dpi, screenPos, STR_TRACK_LIST_COST_AROUND, ft);
     }
 }
@@ -765,16 +795,51 @@ static void track_list_load_designs(RideSelection item)
         }
     }
     _trackDesigns = repo->GetItemsForObjectEntry(item.Type, entryName);
+    _trackDesignPreviewCache.clear();
+    _loadedTrackDesign = nullptr;
+    _loadedTrackDesignIndex = TRACK_DESIGN_INDEX_UNLOADED;
+    _highlightedTrackDesignIndex = -1;
 
     window_track_list_filter_list();
 }
 
+static void track_list_load_design(int32_t trackIndex)
+{
+    if (_loadedTrackDesignIndex != trackIndex)
+    {
+        // A design that fails to load is not tried again until another one has been highlighted
+        track_list_load_design_for_preview(_trackDesigns[trackIndex].path);
+        _loadedTrackDesignIndex = trackIndex;
+    }
+}
+
 static bool track_list_load_design_for_preview(utf8* path)
 {
+    auto it = std::find_if(
+        _trackDesignPreviewCache.begin(), _trackDesignPreviewCache.end(), [path](const TrackDesignPreview& preview) {
+            return preview.Path == path && preview.SceneryToggle == gTrackDesignSceneryToggle;
+        });
+    if (it != _trackDesignPreviewCache.end())
+    {
+        auto preview = std::move(*it);
+        _trackDesignPreviewCache.erase(it);
+        _loadedTrackDesign = preview.Design;
+        std::copy(preview.Pixels.begin(), preview.Pixels.end(), _trackDesignPreviewPixels.begin());
+        _trackDesignPreviewCache.push_front(std::move(preview));
+        return true;
+    }
+
     _loadedTrackDesign = track_design_open(path);
     if (_loadedTrackDesign != nullptr)
     {
         track_design_draw_preview(_loadedTrackDesign.get(), _trackDesignPreviewPixels.data());
+
+        if (_trackDesignPreviewCache.size() >= TRACK_DESIGN_PREVIEW_CACHE_SIZE)
+        {
+            _trackDesignPreviewCache.pop_back();
+        }
+        _trackDesignPreviewCache.push_front(
+            { path, gTrackDesignSceneryToggle, _loadedTrackDesign, _trackDesignPreviewPixels });
         return true;
     }
     return false;
@@ -11,7 +11,9 @@
 
 #include "Context.h"
 #include "OpenRCT2.h"
+#include "config/Config.h"
 #include "core/FileStream.h"
+#include "core/JobPool.h"
 #include "core/Imaging.h"
 #include "core/Json.hpp"
 #include "drawing/Drawing.h"
@@ -25,6 +27,8 @@
 #include <cmath>
 #include <cstring>
 #include <optional>
+#include <string>
+#include <vector>
 
 #ifdef _WIN32
 #    include "core/String.hpp"
@@ -428,6 +432,9 @@ int32_t cmdline_for_sprite(const char** argv, int32_t argc)
         auto context = OpenRCT2::CreateContext();
         context->Initialise();
 
+        // All images are exported, so there is no point in reading them on first draw
+        gConfigGeneral.object_image_budget = 0;
+
         const ObjectRepositoryItem* ori = object_repository_find_object_by_name(datName);
         if (ori == nullptr)
         {
@@ -597,7 +604,15 @@ int32_t cmdline_for_sprite(const char** argv, int32_t argc)
 
         fprintf(stdout, "Building: %s\n", spriteFilePath);
 
-        json_t sprite_description;
+        struct SpriteBuildEntry
+        {
+            std::string ImagePath;
+            int16_t XOffset;
+            int16_t YOffset;
+            bool KeepPalette;
+            bool ForceBmp;
+        };
+        std::vector<SpriteBuildEntry> entries;
 
         // Note: jsonSprite is deliberately left non-const: json_t behaviour changes when const
         for (auto& [jsonKey, jsonSprite] : jsonSprites.items())
@@ -622,18 +637,29 @@ int32_t cmdline_for_sprite(const char** argv, int32_t argc)
             bool keep_palette = Json::GetString(jsonSprite["palette"]) == "keep";
             bool forceBmp = !jsonSprite["palette"].is_null() && Json::GetBoolean(jsonSprite["forceBmp"]);
 
-            auto imagePath = platform_get_absolute_path(strPath.c_str(), directoryPath);
+            entries.push_back({ platform_get_absolute_path(strPath.c_str(), directoryPath), Json::GetNumber<int16_t>(x_offset),
+                                Json::GetNumber<int16_t>(y_offset), keep_palette, forceBmp });
+        }
 
-            auto importResult = SpriteImageImport(
-                imagePath.c_str(), Json::GetNumber<int16_t>(x_offset), Json::GetNumber<int16_t>(y_offset), keep_palette,
-                forceBmp, gSpriteMode);
-            if (importResult == std::nullopt)
+        // The images are converted in parallel, then added in the order of the description file
+        std::vector<std::optional<ImageImporter::ImportResult>> importResults(entries.size());
+        JobPool jobPool;
+        jobPool.ParallelFor(0, entries.size(), 1, [&entries, &importResults](size_t index) {
+            const auto& entry = entries[index];
+            importResults[index] = SpriteImageImport(
+                entry.ImagePath.c_str(), entry.XOffset, entry.YOffset, entry.KeepPalette, entry.ForceBmp, gSpriteMode);
+        });
+
+        for (size_t i = 0; i < entries.size(); i++)
+        {
+            const auto& imagePath = entries[i].ImagePath;
+            if (importResults[i] == std::nullopt)
             {
                 fprintf(stderr, "Could not import image file: %s\nCanceling\n", imagePath.c_str());
                 return -1;
             }
 
-            spriteFile.AddImage(importResult.value());
+            spriteFile.AddImage(importResults[i].value());
 
             if (!silent)
                 fprintf(stdout, "Added: %s\n", imagePath.c_str());
@@ -19,6 +19,7 @@
 #include "GameStateSnapshots.h"
 #include "Input.h"
 #include "Intro.h"
+#include "MemoryUsage.h"
 #include "OpenRCT2.h"
 #include "ParkImporter.h"
 #include "PlatformEnvironment.h"
@@ -34,6 +35,8 @@
 #include "core/FileStream.h"
 #include "core/Guard.hpp"
 #include "core/Http.h"
+#include "core/Json.hpp"
+#include "core/JobPool.h"
 #include "core/MemoryStream.h"
 #include "core/Path.hpp"
 #include "core/String.hpp"
@@ -41,6 +44,7 @@
 #include "drawing/LightFX.h"
 #include "interface/Chat.h"
 #include "interface/InteractiveConsole.h"
+#include "interface/Screenshot.h"
 #include "interface/Viewport.h"
 #include "localisation/Date.h"
 #include "localisation/Localisation.h"
@@ -67,6 +71,7 @@
 #include "world/Sprite.h"
 
 #include <algorithm>
+#include <chrono>
 #include <cmath>
 #include <exception>
 #include <future>
@@ -84,6 +89,20 @@ using namespace OpenRCT2::Ui;
 
 namespace OpenRCT2
 {
+    /**
+     * A step of start-up that can run on a worker thread once the steps it depends on have finished.
+     */
+    struct StartupPhase
+    {
+        const char* Name;
+        std::function<void()> Work;
+        std::vector<size_t> Dependencies;
+        bool Started{};
+        bool Finished{};
+        double DurationMs{};
+        std::exception_ptr Error;
+    };
+
     class Context final : public IContext
     {
     private:
@@ -122,6 +141,7 @@ namespace OpenRCT2
         float _accumulator = 0.0f;
         float _timeScale = 1.0f;
         uint32_t _lastUpdateTime = 0;
+        uint32_t _lastMemoryStatsTime = 0;
         bool _variableFrame = false;
 
         // If set, will end the OpenRCT2 game loop. Intentionally private to this module so that the flag can not be set back to
@@ -132,6 +152,10 @@ namespace OpenRCT2
         NewVersionInfo _newVersionInfo;
         bool _hasNewVersionInfo = false;
 
+        std::unique_ptr<JobPool> _startupJobs;
+        std::vector<StartupPhase> _startupPhases;
+        std::mutex _startupPhasesMutex;
+
     public:
         // Singleton of Context.
         // Remove this when GetContext() is no longer called so that
@@ -162,6 +186,8 @@ namespace OpenRCT2
             // NOTE: We must shutdown all systems here before Instance is set back to null.
             //       If objects use GetContext() in their destructor things won't go well.
 
+            scenario_wait_for_background_saves();
+            screenshot_wait_for_pending();
             GameActions::ClearQueue();
             network_close();
             window_close_all();
@@ -440,18 +466,24 @@ namespace OpenRCT2
 
             EnsureUserContentDirectoriesExist();
 
+            // The repositories are scanned on worker threads while the audio and base graphics are loaded here.
             // TODO Ideally we want to delay this until we show the title so that we can
             //      still open the game window and draw a progress screen for the creation
             //      of the object cache.
-            _objectRepository->LoadOrConstruct(_localisationService->GetCurrentLanguage());
-
-            // TODO Like objects, this can take a while if there are a lot of track designs
-            //      its also really something really we might want to do in the background
-            //      as its not required until the player wants to place a new ride.
-            _trackDesignRepository->Scan(_localisationService->GetCurrentLanguage());
-
-            _scenarioRepository->Scan(_localisationService->GetCurrentLanguage());
-            TitleSequenceManager::Scan();
+            auto startupTime = std::chrono::high_resolution_clock::now();
+            auto language = _localisationService->GetCurrentLanguage();
+            auto objectsPhase = AddStartupPhase(
+                "objects", [this, language]() { _objectRepository->LoadOrConstruct(language); });
+            // Dedicated servers rarely need these lists, so they are left to scan on first use
+            if (!gOpenRCT2Headless)
+            {
+                // Track designs with old ride types are converted by loading their vehicle object
+                AddStartupPhase(
+                    "track designs", [this, language]() { _trackDesignRepository->Scan(language); }, { objectsPhase });
+                AddStartupPhase("scenarios", [this, language]() { _scenarioRepository->Scan(language); });
+                AddStartupPhase("title sequences", []() { TitleSequenceManager::Scan(); });
+            }
+            StartStartupPhases();
 
             if (!gOpenRCT2Headless)
             {
@@ -463,12 +495,18 @@ namespace OpenRCT2
 
             network_set_env(_env);
             chat_init();
-            CopyOriginalUserFilesOver();
 
+            double baseGraphicsMs = 0;
             if (!gOpenRCT2NoGraphics)
             {
-                if (!LoadBaseGraphics())
+                auto baseGraphicsTime = std::chrono::high_resolution_clock::now();
+                bool baseGraphicsLoaded = LoadBaseGraphics();
+                baseGraphicsMs = std::chrono::duration<double, std::milli>(
+                                     std::chrono::high_resolution_clock::now() - baseGraphicsTime)
+                                     .count();
+                if (!baseGraphicsLoaded)
                 {
+                    FinishStartupPhases();
                     return false;
                 }
 #ifdef __ENABLE_LIGHTFX__
@@ -476,6 +514,19 @@ namespace OpenRCT2
 #endif
             }
 
+            FinishStartupPhases();
+            if (gOpenRCT2StartupProfile)
+            {
+                auto totalMs = std::chrono::duration<double, std::milli>(
+                                   std::chrono::high_resolution_clock::now() - startupTime)
+                                   .count();
+                PrintStartupProfile(baseGraphicsMs, totalMs);
+            }
+            _startupPhases.clear();
+
+            // Copied after the scans so that they do not pick up partially copied files
+            CopyOriginalUserFilesOver();
+
             gScenarioTicks = 0;
             input_reset_place_obj_modifier();
             viewport_init_all();
@@ -557,6 +608,8 @@ namespace OpenRCT2
         bool LoadParkFromFile(const std::string& path, bool loadTitleScreenOnFail) final override
         {
             log_verbose("Context::LoadParkFromFile(%s)", path.c_str());
+            // The park may still be being written by a save
+            scenario_wait_for_background_saves();
             try
             {
                 if (String::Equals(Path::GetExtension(path), ".sea", true))
@@ -756,6 +809,103 @@ namespace OpenRCT2
             return result;
         }
 
+        size_t AddStartupPhase(const char* name, std::function<void()> work, std::vector<size_t> dependencies = {})
+        {
+            auto& phase = _startupPhases.emplace_back();
+            phase.Name = name;
+            phase.Work = std::move(work);
+            phase.Dependencies = std::move(dependencies);
+            return _startupPhases.size() - 1;
+        }
+
+        void StartStartupPhases()
+        {
+            if (_startupJobs == nullptr)
+            {
+                _startupJobs = std::make_unique<JobPool>(_startupPhases.size());
+            }
+
+            std::lock_guard<std::mutex> lock(_startupPhasesMutex);
+            QueueReadyStartupPhases();
+        }
+
+        /**
+         * Queues every phase whose dependencies have all finished. Must be called with the phases mutex held.
+         */
+        void QueueReadyStartupPhases()
+        {
+            for (size_t i = 0; i < _startupPhases.size(); i++)
+            {
+                auto& phase = _startupPhases[i];
+                if (phase.Started)
+                    continue;
+
+                auto ready = std::all_of(phase.Dependencies.begin(), phase.Dependencies.end(), [this](size_t dependency) {
+                    return _startupPhases[dependency].Finished;
+                });
+                if (ready)
+                {
+                    phase.Started = true;
+                    _startupJobs->AddTask([this, i]() { RunStartupPhase(i); });
+                }
+            }
+        }
+
+        void RunStartupPhase(size_t index)
+        {
+            auto& phase = _startupPhases[index];
+            auto startTime = std::chrono::high_resolution_clock::now();
+            try
+            {
+                phase.Work();
+            }
+            catch (...)
+            {
+                phase.Error = std::current_exception();
+            }
+            phase.DurationMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - startTime)
+                                   .count();
+            log_verbose("Startup phase '%s' took %.1f ms", phase.Name, phase.DurationMs);
+
+            std::lock_guard<std::mutex> lock(_startupPhasesMutex);
+            phase.Finished = true;
+            QueueReadyStartupPhases();
+        }
+
+        /**
+         * Waits for all start-up phases and rethrows the first error raised by any of them.
+         */
+        void FinishStartupPhases()
+        {
+            if (_startupJobs == nullptr)
+                return;
+
+            _startupJobs->Join();
+            _startupJobs = nullptr;
+            for (const auto& phase : _startupPhases)
+            {
+                if (phase.Error)
+                {
+                    _startupPhases.clear();
+                    std::rethrow_exception(phase.Error);
+                }
+            }
+        }
+
+        void PrintStartupProfile(double baseGraphicsMs, double totalMs) const
+        {
+            Console::WriteLine("Startup profile (wall time, phases run concurrently):");
+            for (const auto& phase : _startupPhases)
+            {
+                Console::WriteLine("  %-16s %9.1f ms", phase.Name, phase.DurationMs);
+            }
+            if (!gOpenRCT2NoGraphics)
+            {
+                Console::WriteLine("  %-16s %9.1f ms", "base graphics", baseGraphicsMs);
+            }
+            Console::WriteLine("  %-16s %9.1f ms", "total", totalMs);
+        }
+
         bool LoadBaseGraphics()
         {
             if (!gfx_load_g1(*_env))
@@ -1105,6 +1255,13 @@ namespace OpenRCT2
 #endif
             _stdInOutConsole.ProcessEvalQueue();
             _uiContext->Update();
+
+            if (gOpenRCT2MemoryStatsInterval != 0
+                && currentUpdateTime - _lastMemoryStatsTime >= gOpenRCT2MemoryStatsInterval * 1000)
+            {
+                _lastMemoryStatsTime = currentUpdateTime;
+                log_info("Memory usage: %s", GetMemoryUsageAsJson().dump().c_str());
+            }
         }
 
         /**
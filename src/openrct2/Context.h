@@ -173,6 +173,8 @@ enum
     GAME_MAX_UPDATES = 4,
     // The maximum threshold to advance.
     GAME_UPDATE_MAX_THRESHOLD = GAME_UPDATE_TIME_MS * GAME_MAX_UPDATES,
+    // The time the extra ticks of a sped up game may take before the rest are skipped, so frames are still drawn.
+    GAME_LOGIC_TIME_BUDGET_MS = 16,
 };
 
 constexpr float GAME_MIN_TIME_SCALE = 0.1f;
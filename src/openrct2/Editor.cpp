@@ -222,6 +222,7 @@ namespace Editor
         {
             case FILE_EXTENSION_SC6:
             case FILE_EXTENSION_SV6:
+            case FILE_EXTENSION_PARK:
                 return ReadS6(path);
             case FILE_EXTENSION_SC4:
                 return LoadLandscapeFromSC4(path);
@@ -281,6 +282,18 @@ namespace Editor
             load_from_sv6(path);
             loadedFromSave = true;
         }
+        else if (_stricmp(extension, ".park") == 0)
+        {
+            loadedFromSave = ClassifyParkFile(path) == FILE_TYPE::SAVED_GAME;
+            if (loadedFromSave)
+            {
+                load_from_sv6(path);
+            }
+            else
+            {
+                load_from_sc6(path);
+            }
+        }
 
         ClearMapForEditing(loadedFromSave);
 
@@ -288,8 +288,6 @@ void sub_6AB211()
             window_editor_object_selection_select_default_objects();
         }
     }
-
-    reset_selected_object_count_and_size();
 }
 
 /**
@@ -468,10 +466,6 @@ void finish_object_selection()
 static void set_object_selection_error(uint8_t is_master_object, rct_string_id error_msg)
 {
     gGameCommandErrorText = error_msg;
-    if (!is_master_object)
-    {
-        reset_selected_object_count_and_size();
-    }
 }
 
 /**
@@ -486,16 +480,12 @@ bool window_editor_object_selection_select_object(uint8_t isMasterObject, int32_
         return false;
     }
 
-    int32_t numObjects = static_cast<int32_t>(object_repository_get_items_count());
-    // Get repository item index
-    int32_t index = -1;
-    const ObjectRepositoryItem* items = object_repository_get_items();
-    for (int32_t i = 0; i < numObjects; i++)
+    // Repository items are stored contiguously, so the index follows from the address of the item
+    size_t index = item - object_repository_get_items();
+    if (index >= _objectSelectionFlags.size())
     {
-        if (&items[i] == item)
-        {
-            index = i;
-        }
+        set_object_selection_error(isMasterObject, STR_OBJECT_SELECTION_ERR_OBJECT_DATA_NOT_FOUND);
+        return false;
     }
 
     uint8_t* selectionFlags = &_objectSelectionFlags[index];
@@ -614,18 +604,12 @@ bool window_editor_object_selection_select_object(uint8_t isMasterObject, int32_
 
 bool editor_check_object_group_at_least_one_selected(ObjectType checkObjectType)
 {
-    auto numObjects = std::min(object_repository_get_items_count(), _objectSelectionFlags.size());
-    const ObjectRepositoryItem* items = object_repository_get_items();
-
-    for (size_t i = 0; i < numObjects; i++)
+    // The counts are kept up to date by every selection change, but are left as they were once the flags are freed
+    if (_objectSelectionFlags.empty())
     {
-        ObjectType objectType = items[i].ObjectEntry.GetType();
-        if (checkObjectType == objectType && (_objectSelectionFlags[i] & OBJECT_SELECTION_FLAG_SELECTED))
-        {
-            return true;
-        }
+        return false;
     }
-    return false;
+    return _numSelectedObjectsForType[EnumValue(checkObjectType)] > 0;
 }
 
 int32_t editor_remove_unused_objects()
@@ -9,6 +9,7 @@
 
 #include "FileClassifier.h"
 
+#include "ParkFile.h"
 #include "core/Console.hpp"
 #include "core/FileStream.h"
 #include "core/Path.hpp"
@@ -17,6 +18,7 @@
 #include "scenario/Scenario.h"
 #include "util/SawyerCoding.h"
 
+static bool TryClassifyAsParkFile(OpenRCT2::IStream* stream, ClassifiedFileInfo* result);
 static bool TryClassifyAsS6(OpenRCT2::IStream* stream, ClassifiedFileInfo* result);
 static bool TryClassifyAsS4(OpenRCT2::IStream* stream, ClassifiedFileInfo* result);
 static bool TryClassifyAsTD4_TD6(OpenRCT2::IStream* stream, ClassifiedFileInfo* result);
@@ -41,6 +43,12 @@ bool TryClassifyFile(OpenRCT2::IStream* stream, ClassifiedFileInfo* result)
     //      between them is to decode it. Decoding however is currently not protected
     //      against invalid compression data for that decoding algorithm and will crash.
 
+    // Park file detection
+    if (TryClassifyAsParkFile(stream, result))
+    {
+        return true;
+    }
+
     // S6 detection
     if (TryClassifyAsS6(stream, result))
     {
@@ -62,6 +70,59 @@ bool TryClassifyFile(OpenRCT2::IStream* stream, ClassifiedFileInfo* result)
     return false;
 }
 
+FILE_TYPE ClassifyParkFile(const std::string& path)
+{
+    try
+    {
+        auto fs = OpenRCT2::FileStream(path, OpenRCT2::FILE_MODE_OPEN);
+        return ClassifyParkFile(&fs);
+    }
+    catch (const std::exception&)
+    {
+        return FILE_TYPE::UNDEFINED;
+    }
+}
+
+FILE_TYPE ClassifyParkFile(OpenRCT2::IStream* stream)
+{
+    ClassifiedFileInfo info;
+    return TryClassifyAsParkFile(stream, &info) ? info.Type : FILE_TYPE::UNDEFINED;
+}
+
+static bool TryClassifyAsParkFile(OpenRCT2::IStream* stream, ClassifiedFileInfo* result)
+{
+    if (!ParkFileReader::IsParkFile(stream))
+    {
+        return false;
+    }
+
+    bool success = false;
+    uint64_t originalPosition = stream->GetPosition();
+    try
+    {
+        // Only the header chunk is decoded
+        auto reader = ParkFileReader(stream);
+        rct_s6_header s6Header{};
+        reader.ReadChunk(ParkFileChunkType::Header, &s6Header, sizeof(s6Header));
+        if (s6Header.type == S6_TYPE_SAVEDGAME)
+        {
+            result->Type = FILE_TYPE::SAVED_GAME;
+        }
+        else if (s6Header.type == S6_TYPE_SCENARIO)
+        {
+            result->Type = FILE_TYPE::SCENARIO;
+        }
+        result->Version = s6Header.version;
+        success = true;
+    }
+    catch (const std::exception& e)
+    {
+        log_verbose(e.what());
+    }
+    stream->SetPosition(originalPosition);
+    return success;
+}
+
 static bool TryClassifyAsS6(OpenRCT2::IStream* stream, ClassifiedFileInfo* result)
 {
     bool success = false;
@@ -183,5 +244,7 @@ uint32_t get_file_extension_type(const utf8* path)
         return FILE_EXTENSION_SV6;
     if (String::Equals(extension, ".td6", true))
         return FILE_EXTENSION_TD6;
+    if (String::Equals(extension, ".park", true))
+        return FILE_EXTENSION_PARK;
     return FILE_EXTENSION_UNKNOWN;
 }
@@ -21,6 +21,7 @@ enum
     FILE_EXTENSION_SC6,
     FILE_EXTENSION_SV6,
     FILE_EXTENSION_TD6,
+    FILE_EXTENSION_PARK,
 };
 
 #include <string>
@@ -49,4 +50,11 @@ struct ClassifiedFileInfo
 bool TryClassifyFile(const std::string& path, ClassifiedFileInfo* result);
 bool TryClassifyFile(OpenRCT2::IStream* stream, ClassifiedFileInfo* result);
 
+/**
+ * Park files can hold either a saved game or a scenario, the header chunk tells which.
+ * @returns FILE_TYPE::SAVED_GAME or FILE_TYPE::SCENARIO, FILE_TYPE::UNDEFINED if it is not a valid park file.
+ */
+FILE_TYPE ClassifyParkFile(const std::string& path);
+FILE_TYPE ClassifyParkFile(OpenRCT2::IStream* stream);
+
 uint32_t get_file_extension_type(const utf8* path);
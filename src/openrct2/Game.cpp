@@ -22,9 +22,9 @@
 #include "actions/LoadOrQuitAction.h"
 #include "audio/audio.h"
 #include "config/Config.h"
-#include "core/Console.hpp"
 #include "core/FileScanner.h"
 #include "core/Path.hpp"
+#include "core/Trace.h"
 #include "interface/Colour.h"
 #include "interface/Screenshot.h"
 #include "interface/Viewport.h"
@@ -629,12 +629,19 @@ void save_game_cmd(const utf8* name /* = nullptr */)
 void save_game_with_name(const utf8* name)
 {
     log_verbose("Saving to %s", name);
-    if (scenario_save(name, 0x80000000 | (gConfigGeneral.save_plugin_data ? 1 : 0)))
-    {
-        log_verbose("Saved to %s", name);
-        gCurrentLoadedPath = name;
-        gScreenAge = 0;
-    }
+    // The park is written while the game carries on, it only counts as saved once the file has been written
+    scenario_save_in_background(
+        name, 0x80000000 | (gConfigGeneral.save_plugin_data ? 1 : 0), [path = std::string(name)](bool success) {
+            if (success)
+            {
+                gCurrentLoadedPath = path;
+                gScreenAge = 0;
+            }
+            else
+            {
+                context_show_error(STR_SAVE_GAME, STR_GAME_SAVE_FAILED, {});
+            }
+        });
 }
 
 void* create_save_game_as_intent()
@@ -724,6 +731,7 @@ static void limit_autosave_count(const size_t numberOfFilesToKeep, bool processL
 
 void game_autosave()
 {
+    TRACE_ZONE("Autosave");
     const char* subDirectory = "save";
     const char* fileExtension = ".sv6";
     uint32_t saveFlags = 0x80000000;
@@ -762,8 +770,8 @@ void game_autosave()
         platform_file_copy(path, backupPath, true);
     }
 
-    if (!scenario_save(path, saveFlags))
-        Console::Error::WriteLine("Could not autosave the scenario. Is the save folder writeable?");
+    // Only the snapshot of the park is taken here, it is written while the game carries on
+    scenario_save_in_background(path, saveFlags);
 }
 
 static void game_load_or_quit_no_save_prompt_callback(int32_t result, const utf8* path)
@@ -103,6 +103,7 @@ enum class GameCommand : int32_t
     GuestSetFlags,            // GA
     SetDate,                  // GA
     Custom,                   // GA
+    ScatterScenery,           // GA
     Count,
 };
 
@@ -19,6 +19,8 @@
 #include "ReplayManager.h"
 #include "actions/GameAction.h"
 #include "config/Config.h"
+#include "core/Allocations.h"
+#include "core/Trace.h"
 #include "interface/Screenshot.h"
 #include "localisation/Date.h"
 #include "localisation/Localisation.h"
@@ -163,9 +165,19 @@ void GameState::Update()
     }
 
     // Update the game one or more times
+    const auto logicStartTime = std::chrono::high_resolution_clock::now();
+    const bool limitLogicTime = numUpdates > 1 && !gOpenRCT2Headless && network_get_mode() == NETWORK_MODE_NONE;
+    _isCatchingUp = numUpdates > 1;
     for (uint32_t i = 0; i < numUpdates; i++)
     {
-        UpdateLogic();
+        UpdateLogic(gConfigGeneral.show_performance_overlay ? &_performanceTimings : nullptr);
+        if (limitLogicTime
+            && std::chrono::high_resolution_clock::now() - logicStartTime
+                >= std::chrono::milliseconds(GAME_LOGIC_TIME_BUDGET_MS))
+        {
+            // The park is too busy to run at the selected speed, draw and handle input instead of stalling the frame
+            break;
+        }
         if (gGameSpeed == 1)
         {
             if (input_get_state() == InputState::Reset || input_get_state() == InputState::Normal)
@@ -182,6 +194,11 @@ void GameState::Update()
             }
         }
     }
+    if (_isCatchingUp)
+    {
+        _isCatchingUp = false;
+        UpdateFrameWork();
+    }
 
     if (!gOpenRCT2Headless)
     {
@@ -216,9 +233,15 @@ void GameState::Update()
     {
         scenario_autosave_check();
     }
+    scenario_complete_background_saves();
 
     window_dispatch_update_all();
 
+#ifdef ENABLE_SCRIPTING
+    // Game actions run from input or while paused would otherwise wait for the next tick
+    GetContext()->GetScriptEngine().GetHookEngine().CallQueued();
+#endif
+
     if (didRunSingleFrame && game_is_not_paused() && !(gScreenFlags & SCREEN_FLAGS_TITLE_DEMO))
     {
         pause_toggle();
@@ -228,16 +251,66 @@ void GameState::Update()
     gInUpdateCode = false;
 }
 
-void GameState::UpdateLogic(LogicTimings* timings)
+LogicCounters* OpenRCT2::gLogicCounters;
+
+// Indexed by LogicTimePart
+static constexpr const char* LogicTimePartNames[] = {
+    "Network update",
+    "Date",
+    "Scenario",
+    "Climate",
+    "Map tiles",
+    "Stash provisional elements",
+    "Path wide flags",
+    "Peeps",
+    "Restore provisional elements",
+    "Vehicles",
+    "Misc",
+    "Rides",
+    "Park",
+    "Research",
+    "Ride ratings",
+    "Ride measurements",
+    "News",
+    "Map animations",
+    "Sounds",
+    "Game actions",
+    "Network flush",
+    "Scripts",
+};
+static_assert(std::size(LogicTimePartNames) == EnumValue(LogicTimePart::Scripts) + 1);
+
+const char* OpenRCT2::GetLogicTimePartName(LogicTimePart part)
 {
-    auto start_time = std::chrono::high_resolution_clock::now();
+    return LogicTimePartNames[EnumValue(part)];
+}
 
-    auto report_time = [timings, start_time](LogicTimePart part) {
-        if (timings != nullptr)
+void GameState::UpdateLogic(LogicTimings* timings)
+{
+    TRACE_ZONE("Update logic");
+    auto last_time = Trace::Clock::now();
+    auto last_allocations = Allocations::GetThreadCount();
+    const auto allocationsAtStart = Allocations::GetCount();
+
+    // Each part is given the time since the previous one was reported, not since the start of the update
+    auto report_time = [timings, &last_time, &last_allocations](LogicTimePart part) {
+        if (timings != nullptr || Trace::IsRecording())
         {
-            timings->TimingInfo[part][timings->CurrentIdx] = std::chrono::high_resolution_clock::now() - start_time;
+            auto current_time = Trace::Clock::now();
+            if (timings != nullptr)
+            {
+                timings->TimingInfo[part][timings->CurrentIdx] = current_time - last_time;
+            }
+            if (Trace::IsRecording())
+            {
+                auto current_allocations = Allocations::GetThreadCount();
+                Trace::RecordZone(GetLogicTimePartName(part), last_time, current_time, current_allocations - last_allocations);
+                last_allocations = current_allocations;
+            }
+            last_time = current_time;
         }
     };
+    gLogicCounters = timings != nullptr ? &timings->Counters : nullptr;
 
     gScreenAge++;
     if (gScreenAge == 0)
@@ -245,7 +318,11 @@ void GameState::UpdateLogic(LogicTimings* timings)
 
     GetContext()->GetReplayManager()->Update();
 
-    network_update();
+    // Update already received the network data of this frame
+    if (!_isCatchingUp)
+    {
+        network_update();
+    }
     report_time(LogicTimePart::NetworkUpdate);
 
     if (network_get_mode() == NETWORK_MODE_SERVER)
@@ -263,6 +340,7 @@ void GameState::UpdateLogic(LogicTimings* timings)
         // Don't run past the server, this condition can happen during map changes.
         if (network_get_server_tick() == gCurrentTicks)
         {
+            gLogicCounters = nullptr;
             return;
         }
 
@@ -329,11 +407,17 @@ void GameState::UpdateLogic(LogicTimings* timings)
     News::UpdateCurrentItem();
     report_time(LogicTimePart::News);
 
-    map_animation_invalidate_all();
+    if (!_isCatchingUp)
+    {
+        map_animation_invalidate_all();
+    }
     report_time(LogicTimePart::MapAnimation);
-    vehicle_sounds_update();
-    peep_update_crowd_noise();
-    climate_update_sound();
+    if (!_isCatchingUp)
+    {
+        vehicle_sounds_update();
+        peep_update_crowd_noise();
+        climate_update_sound();
+    }
     report_time(LogicTimePart::Sounds);
     editor_open_windows_for_current_step();
 
@@ -350,7 +434,10 @@ void GameState::UpdateLogic(LogicTimings* timings)
     report_time(LogicTimePart::GameActions);
 
     network_process_pending();
-    network_flush();
+    if (!_isCatchingUp)
+    {
+        network_flush();
+    }
     report_time(LogicTimePart::NetworkFlush);
 
     gCurrentTicks++;
@@ -359,9 +446,14 @@ void GameState::UpdateLogic(LogicTimings* timings)
 
 #ifdef ENABLE_SCRIPTING
     auto& hookEngine = GetContext()->GetScriptEngine().GetHookEngine();
-    hookEngine.Call(HOOK_TYPE::INTERVAL_TICK, true);
+    hookEngine.CallQueued();
+
+    if (hookEngine.HasSubscriptions(HOOK_TYPE::INTERVAL_TICK))
+    {
+        hookEngine.Call(HOOK_TYPE::INTERVAL_TICK, true);
+    }
 
-    if (day != _date.GetDay())
+    if (day != _date.GetDay() && hookEngine.HasSubscriptions(HOOK_TYPE::INTERVAL_DAY))
     {
         hookEngine.Call(HOOK_TYPE::INTERVAL_DAY, true);
     }
@@ -370,8 +462,24 @@ void GameState::UpdateLogic(LogicTimings* timings)
 
     if (timings != nullptr)
     {
+        timings->Allocations[timings->CurrentIdx] = Allocations::GetCount() - allocationsAtStart;
         timings->CurrentIdx = (timings->CurrentIdx + 1) % LOGIC_UPDATE_MEASUREMENTS_COUNT;
+        timings->NumMeasurements++;
     }
+    gLogicCounters = nullptr;
+}
+
+/**
+ * The part of a logic update that only affects what is drawn, heard or sent, done once after a frame that ran several
+ * ticks. The desync checks, tick packets and game actions still happen on every tick.
+ */
+void GameState::UpdateFrameWork()
+{
+    map_animation_invalidate_all();
+    vehicle_sounds_update();
+    peep_update_crowd_noise();
+    climate_update_sound();
+    network_flush();
 }
 
 void GameState::CreateStateSnapshot()
@@ -47,6 +47,8 @@ namespace OpenRCT2
         Scripts,
     };
 
+    const char* GetLogicTimePartName(LogicTimePart part);
+
     // ~6.5s at 40Hz
     constexpr size_t LOGIC_UPDATE_MEASUREMENTS_COUNT = 256;
 
@@ -54,12 +56,34 @@ namespace OpenRCT2
     using LogicTimingInfo = std::unordered_map<
         LogicTimePart, std::array<std::chrono::duration<double>, LOGIC_UPDATE_MEASUREMENTS_COUNT>>;
 
+    // Work done within the parts of the logic update, summed over every update that is given the timings
+    struct LogicCounters
+    {
+        uint32_t GuestsUpdated{};
+        uint32_t StaffUpdated{};
+        std::chrono::duration<double> GuestTime{};
+        std::chrono::duration<double> StaffTime{};
+        uint32_t PathfindCalls{};
+        std::chrono::duration<double> PathfindTime{};
+        uint32_t RideRatingsSteps{};
+        uint32_t TilesUpdated{};
+        uint32_t TrainsUpdated{};
+    };
+
     struct LogicTimings
     {
         LogicTimingInfo TimingInfo;
         size_t CurrentIdx{};
+        // The number of updates recorded, the timings only hold the last LOGIC_UPDATE_MEASUREMENTS_COUNT of them
+        size_t NumMeasurements{};
+        LogicCounters Counters;
+        // Heap allocations made by all threads during each update, only counted in builds that track them
+        std::array<uint64_t, LOGIC_UPDATE_MEASUREMENTS_COUNT> Allocations{};
     };
 
+    // The counters of the logic update that is running, nullptr when it is not being measured
+    extern LogicCounters* gLogicCounters;
+
     /**
      * Class to update the state of the map and park.
      */
@@ -68,6 +92,10 @@ namespace OpenRCT2
     private:
         std::unique_ptr<Park> _park;
         Date _date;
+        // Recorded while the performance overlay is shown
+        LogicTimings _performanceTimings;
+        // Set while several ticks run back to back in one frame, work that only matters once per frame is deferred
+        bool _isCatchingUp{};
 
     public:
         GameState();
@@ -81,12 +109,17 @@ namespace OpenRCT2
         {
             return *_park;
         }
+        const LogicTimings& GetPerformanceTimings() const
+        {
+            return _performanceTimings;
+        }
 
         void InitAll(int32_t mapSize);
         void Update();
         void UpdateLogic(LogicTimings* timings = nullptr);
 
     private:
+        void UpdateFrameWork();
         void CreateStateSnapshot();
     };
 } // namespace OpenRCT2
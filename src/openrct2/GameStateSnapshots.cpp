@@ -9,36 +9,277 @@
 
 #include "GameStateSnapshots.h"
 
-#include "core/CircularBuffer.h"
 #include "peep/Peep.h"
+#include "ride/Ride.h"
+#include "scenario/Scenario.h"
+#include "util/Util.h"
 #include "world/EntityList.h"
+#include "world/Map.h"
 #include "world/Sprite.h"
 
-static constexpr size_t MaximumGameStateSnapshots = 32;
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <deque>
+
+// Snapshots are stored compressed, either on their own as a keyframe or as the difference to the snapshot before. The
+// oldest keyframe is dropped together with its deltas, so between 7 and 8 times as many snapshots are kept.
+static constexpr size_t GameStateSnapshotsPerKeyframe = 32;
+static constexpr size_t MaximumGameStateSnapshotKeyframes = 8;
 static constexpr uint32_t InvalidTick = 0xFFFFFFFF;
 
-struct GameStateSnapshot_t
+// The map is compared and resent in square blocks of tiles rather than per tile to keep the digest small
+static constexpr int32_t ResyncTileBlockSize = 8;
+static constexpr int32_t ResyncTileBlocksPerRow = MAXIMUM_MAP_SIZE_TECHNICAL / ResyncTileBlockSize;
+static constexpr size_t ResyncTileBlockCount = ResyncTileBlocksPerRow * ResyncTileBlocksPerRow;
+static constexpr size_t ResyncTilesPerBlock = ResyncTileBlockSize * ResyncTileBlockSize;
+
+struct GameStateResync_t
+{
+    struct TileBlock
+    {
+        // Number of elements of each tile within the block, row by row.
+        std::array<uint16_t, ResyncTilesPerBlock> counts{};
+        // Elements of all tiles without ghosts, the last for tile flag is cleared so clients with ghosts still match.
+        std::vector<TileElement> elements;
+    };
+
+    struct RideData
+    {
+        bool exists = false;
+        std::string name;
+        std::vector<uint8_t> data;
+    };
+
+    uint32_t tick = 0;
+    random_engine_t::state_type randState{};
+    std::vector<TileBlock> tileBlocks;
+    // Peep names are pointers, they are stored separately and cleared in the copies.
+    std::vector<rct_sprite> entities;
+    std::vector<std::string> entityNames;
+    std::vector<RideData> rides;
+};
+
+static uint32_t HashResyncData(const void* data, size_t length, uint32_t hash = 2166136261u)
+{
+    // FNV-1a, only has to tell differing parts apart
+    auto bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < length; i++)
+    {
+        hash = (hash ^ bytes[i]) * 16777619u;
+    }
+    return hash;
+}
+
+/**
+ * Calls fn(offset, length) for the parts of a ride that are game state, skipping the members that own memory or are only
+ * used by the user interface.
+ */
+template<typename TFn> static void ForEachRideDataRange(const Ride& ride, TFn&& fn)
+{
+    const auto* base = reinterpret_cast<const uint8_t*>(&ride);
+    auto offsetOf = [base](const void* member) {
+        return static_cast<size_t>(reinterpret_cast<const uint8_t*>(member) - base);
+    };
+
+    std::array<std::pair<size_t, size_t>, 3> skipped = { {
+        { offsetOf(&ride.custom_name), sizeof(ride.custom_name) },
+        { offsetOf(&ride.window_invalidate_flags), sizeof(ride.window_invalidate_flags) },
+        { offsetOf(&ride.measurement), sizeof(ride.measurement) },
+    } };
+    std::sort(skipped.begin(), skipped.end());
+
+    size_t offset = 0;
+    for (const auto& [skipOffset, skipLength] : skipped)
+    {
+        fn(offset, skipOffset - offset);
+        offset = skipOffset + skipLength;
+    }
+    fn(offset, sizeof(Ride) - offset);
+}
+
+static size_t GetRideDataLength(const Ride& ride)
+{
+    size_t length = 0;
+    ForEachRideDataRange(ride, [&length](size_t, size_t rangeLength) { length += rangeLength; });
+    return length;
+}
+
+/**
+ * Size of the entity data following the type in a snapshot, entities of other types are stored without data.
+ */
+static size_t GetSnapshotEntitySize(EntityType type)
+{
+    switch (type)
+    {
+        case EntityType::Vehicle:
+            return sizeof(Vehicle);
+        case EntityType::Guest:
+            return sizeof(Guest);
+        case EntityType::Staff:
+            return sizeof(Staff);
+        case EntityType::Litter:
+            return sizeof(Litter);
+        case EntityType::MoneyEffect:
+            return sizeof(MoneyEffect);
+        case EntityType::Balloon:
+            return sizeof(Balloon);
+        case EntityType::Duck:
+            return sizeof(Duck);
+        case EntityType::JumpingFountain:
+            return sizeof(JumpingFountain);
+        case EntityType::SteamParticle:
+            return sizeof(SteamParticle);
+        default:
+            return 0;
+    }
+}
+
+struct SnapshotEntityRecord
+{
+    uint32_t index;
+    size_t offset;
+    size_t length;
+};
+
+static constexpr size_t SnapshotHeaderLength = sizeof(uint32_t);
+
+/**
+ * Splits serialised entities into the records of each entity, in the order of their index.
+ */
+static std::vector<SnapshotEntityRecord> GetSnapshotEntityRecords(const std::vector<uint8_t>& sprites)
+{
+    std::vector<SnapshotEntityRecord> records;
+    size_t offset = SnapshotHeaderLength;
+    while (offset + sizeof(uint32_t) + sizeof(EntityType) <= sprites.size())
+    {
+        uint32_t index;
+        std::memcpy(&index, &sprites[offset], sizeof(index));
+        const auto type = static_cast<EntityType>(sprites[offset + sizeof(uint32_t)]);
+
+        size_t length = sizeof(uint32_t) + sizeof(EntityType);
+        const size_t dataSize = GetSnapshotEntitySize(type);
+        if (dataSize != 0)
+        {
+            length += sizeof(uint16_t) + dataSize;
+        }
+        if (offset + length > sprites.size())
+            break;
+
+        records.push_back({ ByteSwapBE(index), offset, length });
+        offset += length;
+    }
+    return records;
+}
+
+enum : uint8_t
 {
-    GameStateSnapshot_t& operator=(GameStateSnapshot_t&& mv) noexcept
+    SNAPSHOT_DELTA_RECORD_RAW,
+    SNAPSHOT_DELTA_RECORD_XOR,
+};
+
+/**
+ * Describes the entities as the difference to the entities of the previous snapshot. Entities that still exist with
+ * the same type are xor'ed with their previous state, which is mostly zeros and compresses to almost nothing.
+ */
+static std::vector<uint8_t> EncodeSnapshotDelta(
+    const std::vector<uint8_t>& sprites, const std::vector<uint8_t>& previous)
+{
+    std::vector<uint8_t> delta(sprites.begin(), sprites.begin() + std::min(sprites.size(), SnapshotHeaderLength));
+    auto write = [&delta](const void* data, size_t length) {
+        delta.insert(delta.end(), static_cast<const uint8_t*>(data), static_cast<const uint8_t*>(data) + length);
+    };
+
+    const auto previousRecords = GetSnapshotEntityRecords(previous);
+    auto it = previousRecords.begin();
+    for (const auto& record : GetSnapshotEntityRecords(sprites))
     {
-        tick = mv.tick;
-        storedSprites = std::move(mv.storedSprites);
-        return *this;
+        while (it != previousRecords.end() && it->index < record.index)
+            it++;
+
+        if (it != previousRecords.end() && it->index == record.index && it->length == record.length
+            && sprites[record.offset + sizeof(uint32_t)] == previous[it->offset + sizeof(uint32_t)])
+        {
+            delta.push_back(SNAPSHOT_DELTA_RECORD_XOR);
+            write(&record.index, sizeof(record.index));
+            for (size_t i = 0; i < record.length; i++)
+            {
+                delta.push_back(sprites[record.offset + i] ^ previous[it->offset + i]);
+            }
+        }
+        else
+        {
+            const auto length = static_cast<uint32_t>(record.length);
+            delta.push_back(SNAPSHOT_DELTA_RECORD_RAW);
+            write(&length, sizeof(length));
+            write(&sprites[record.offset], record.length);
+        }
     }
+    return delta;
+}
 
+static std::vector<uint8_t> DecodeSnapshotDelta(const std::vector<uint8_t>& delta, const std::vector<uint8_t>& previous)
+{
+    std::vector<uint8_t> sprites(delta.begin(), delta.begin() + std::min(delta.size(), SnapshotHeaderLength));
+    sprites.reserve(previous.size());
+
+    const auto previousRecords = GetSnapshotEntityRecords(previous);
+    auto it = previousRecords.begin();
+    size_t offset = sprites.size();
+    while (offset + 1 + sizeof(uint32_t) <= delta.size())
+    {
+        const uint8_t recordType = delta[offset];
+        uint32_t value;
+        std::memcpy(&value, &delta[offset + 1], sizeof(value));
+        offset += 1 + sizeof(value);
+
+        if (recordType == SNAPSHOT_DELTA_RECORD_XOR)
+        {
+            while (it != previousRecords.end() && it->index < value)
+                it++;
+            if (it == previousRecords.end() || it->index != value || offset + it->length > delta.size())
+                break;
+
+            for (size_t i = 0; i < it->length; i++)
+            {
+                sprites.push_back(delta[offset + i] ^ previous[it->offset + i]);
+            }
+            offset += it->length;
+        }
+        else
+        {
+            if (offset + value > delta.size())
+                break;
+            sprites.insert(sprites.end(), delta.begin() + offset, delta.begin() + offset + value);
+            offset += value;
+        }
+    }
+    return sprites;
+}
+
+struct GameStateSnapshot_t
+{
     uint32_t tick = InvalidTick;
     uint32_t srand0 = 0;
 
+    // Serialised entities, released once the snapshot has been encoded.
     OpenRCT2::MemoryStream storedSprites;
     OpenRCT2::MemoryStream parkParameters;
 
+    bool encoded = false;
+    bool keyframe = false;
+    size_t decodedLength = 0;
+    std::vector<uint8_t> encodedSprites;
+
     // Must pass a function that can access the sprite.
-    void SerialiseSprites(std::function<rct_sprite*(const size_t)> getEntity, const size_t numSprites, bool saving)
+    static void SerialiseSprites(
+        OpenRCT2::MemoryStream& stream, std::function<rct_sprite*(const size_t)> getEntity, const size_t numSprites,
+        bool saving)
     {
         const bool loading = !saving;
 
-        storedSprites.SetPosition(0);
-        DataSerialiser ds(saving, storedSprites);
+        stream.SetPosition(0);
+        DataSerialiser ds(saving, stream);
 
         std::vector<uint32_t> indexTable;
         indexTable.reserve(numSprites);
@@ -79,39 +320,19 @@ struct GameStateSnapshot_t
 
             ds << sprite.misc.Type;
 
-            switch (sprite.misc.Type)
+            // Same layout as a byte array of the entity, written in one go rather than per byte
+            const size_t size = GetSnapshotEntitySize(sprite.misc.Type);
+            if (size != 0)
             {
-                case EntityType::Vehicle:
-                    ds << reinterpret_cast<uint8_t(&)[sizeof(Vehicle)]>(sprite.vehicle);
-                    break;
-                case EntityType::Guest:
-                    ds << reinterpret_cast<uint8_t(&)[sizeof(Guest)]>(sprite.peep);
-                    break;
-                case EntityType::Staff:
-                    ds << reinterpret_cast<uint8_t(&)[sizeof(Staff)]>(sprite.peep);
-                    break;
-                case EntityType::Litter:
-                    ds << reinterpret_cast<uint8_t(&)[sizeof(Litter)]>(sprite.litter);
-                    break;
-                case EntityType::MoneyEffect:
-                    ds << reinterpret_cast<uint8_t(&)[sizeof(MoneyEffect)]>(sprite.money_effect);
-                    break;
-                case EntityType::Balloon:
-                    ds << reinterpret_cast<uint8_t(&)[sizeof(Balloon)]>(sprite.balloon);
-                    break;
-                case EntityType::Duck:
-                    ds << reinterpret_cast<uint8_t(&)[sizeof(Duck)]>(sprite.duck);
-                    break;
-                case EntityType::JumpingFountain:
-                    ds << reinterpret_cast<uint8_t(&)[sizeof(JumpingFountain)]>(sprite.jumping_fountain);
-                    break;
-                case EntityType::SteamParticle:
-                    ds << reinterpret_cast<uint8_t(&)[sizeof(SteamParticle)]>(sprite.steam_particle);
-                    break;
-                case EntityType::Null:
-                    break;
-                default:
-                    break;
+                uint16_t length = static_cast<uint16_t>(size);
+                ds << length;
+                if (length != size)
+                    throw std::runtime_error("Invalid size, can't decode");
+
+                if (saving)
+                    stream.Write(&sprite, size);
+                else
+                    stream.Read(&sprite, size);
             }
         }
     }
@@ -122,16 +343,111 @@ struct GameStateSnapshots final : public IGameStateSnapshots
     virtual void Reset() override final
     {
         _snapshots.clear();
+        _previousSprites.clear();
+        _snapshotsSinceKeyframe = 0;
     }
 
     virtual GameStateSnapshot_t& CreateSnapshot() override final
     {
+        if (!_snapshots.empty())
+        {
+            EncodeSnapshot(*_snapshots.back());
+        }
+
         auto snapshot = std::make_unique<GameStateSnapshot_t>();
         _snapshots.push_back(std::move(snapshot));
 
         return *_snapshots.back();
     }
 
+    /**
+     * Compresses the sprites of the snapshot, which is no longer the latest one.
+     */
+    void EncodeSnapshot(GameStateSnapshot_t& snapshot)
+    {
+        if (snapshot.encoded)
+            return;
+
+        const auto* data = static_cast<const uint8_t*>(snapshot.storedSprites.GetData());
+        std::vector<uint8_t> sprites(data, data + snapshot.storedSprites.GetLength());
+
+        std::vector<uint8_t> delta;
+        if (_previousSprites.empty() || _snapshotsSinceKeyframe >= GameStateSnapshotsPerKeyframe)
+        {
+            DropOldestKeyframe();
+            snapshot.keyframe = true;
+            _snapshotsSinceKeyframe = 0;
+        }
+        else
+        {
+            delta = EncodeSnapshotDelta(sprites, _previousSprites);
+        }
+        _snapshotsSinceKeyframe++;
+
+        const auto& decoded = snapshot.keyframe ? sprites : delta;
+        auto compressed = util_zlib_deflate(decoded.data(), decoded.size());
+        snapshot.encodedSprites = compressed ? std::move(*compressed) : std::vector<uint8_t>();
+        snapshot.decodedLength = decoded.size();
+        snapshot.storedSprites = OpenRCT2::MemoryStream();
+        snapshot.encoded = true;
+
+        _previousSprites = std::move(sprites);
+    }
+
+    void DropOldestKeyframe()
+    {
+        const auto numKeyframes = std::count_if(
+            _snapshots.begin(), _snapshots.end(), [](const auto& snapshot) { return snapshot->keyframe; });
+        if (static_cast<size_t>(numKeyframes) < MaximumGameStateSnapshotKeyframes)
+            return;
+
+        do
+        {
+            _snapshots.pop_front();
+        } while (!_snapshots.empty() && !_snapshots.front()->keyframe && _snapshots.front()->encoded);
+    }
+
+    static std::vector<uint8_t> Inflate(const GameStateSnapshot_t& snapshot)
+    {
+        size_t length = snapshot.decodedLength;
+        if (snapshot.encodedSprites.empty() || length == 0)
+            return {};
+
+        auto* data = util_zlib_inflate(
+            const_cast<uint8_t*>(snapshot.encodedSprites.data()), snapshot.encodedSprites.size(), &length);
+        if (data == nullptr)
+            return {};
+
+        std::vector<uint8_t> result(data, data + length);
+        free(data);
+        return result;
+    }
+
+    /**
+     * Returns the serialised sprites of the snapshot, applying the deltas since the last keyframe before it.
+     */
+    OpenRCT2::MemoryStream DecodeSprites(const GameStateSnapshot_t& snapshot) const
+    {
+        if (!snapshot.encoded)
+            return OpenRCT2::MemoryStream(snapshot.storedSprites);
+
+        auto it = std::find_if(
+            _snapshots.begin(), _snapshots.end(), [&snapshot](const auto& item) { return item.get() == &snapshot; });
+        if (it == _snapshots.end())
+            return {};
+
+        auto keyframe = it;
+        while (keyframe != _snapshots.begin() && !(*keyframe)->keyframe)
+            keyframe--;
+
+        std::vector<uint8_t> sprites = Inflate(**keyframe);
+        for (auto delta = std::next(keyframe); delta != std::next(it); delta++)
+        {
+            sprites = DecodeSnapshotDelta(Inflate(**delta), sprites);
+        }
+        return OpenRCT2::MemoryStream(std::move(sprites));
+    }
+
     virtual void LinkSnapshot(GameStateSnapshot_t& snapshot, uint32_t tick, uint32_t srand0) override final
     {
         snapshot.tick = tick;
@@ -140,8 +456,12 @@ struct GameStateSnapshots final : public IGameStateSnapshots
 
     virtual void Capture(GameStateSnapshot_t& snapshot) override final
     {
+        // Entity counts barely change between ticks, size the stream after the last capture so it is not regrown
+        snapshot.storedSprites.Reserve(_capturedSpritesLength + _capturedSpritesLength / 8);
         snapshot.SerialiseSprites(
-            [](const size_t index) { return reinterpret_cast<rct_sprite*>(GetEntity(index)); }, MAX_ENTITIES, true);
+            snapshot.storedSprites, [](const size_t index) { return reinterpret_cast<rct_sprite*>(GetEntity(index)); },
+            MAX_ENTITIES, true);
+        _capturedSpritesLength = static_cast<size_t>(snapshot.storedSprites.GetLength());
 
         // log_info("Snapshot size: %u bytes", static_cast<uint32_t>(snapshot.storedSprites.GetLength()));
     }
@@ -160,11 +480,19 @@ struct GameStateSnapshots final : public IGameStateSnapshots
     {
         ds << snapshot.tick;
         ds << snapshot.srand0;
-        ds << snapshot.storedSprites;
+        if (snapshot.encoded)
+        {
+            auto sprites = DecodeSprites(snapshot);
+            ds << sprites;
+        }
+        else
+        {
+            ds << snapshot.storedSprites;
+        }
         ds << snapshot.parkParameters;
     }
 
-    std::vector<rct_sprite> BuildSpriteList(GameStateSnapshot_t& snapshot) const
+    std::vector<rct_sprite> BuildSpriteList(const GameStateSnapshot_t& snapshot) const
     {
         std::vector<rct_sprite> spriteList;
         spriteList.resize(MAX_ENTITIES);
@@ -175,7 +503,9 @@ struct GameStateSnapshots final : public IGameStateSnapshots
             sprite.misc.Type = EntityType::Null;
         }
 
-        snapshot.SerialiseSprites([&spriteList](const size_t index) { return &spriteList[index]; }, MAX_ENTITIES, false);
+        auto sprites = DecodeSprites(snapshot);
+        GameStateSnapshot_t::SerialiseSprites(
+            sprites, [&spriteList](const size_t index) { return &spriteList[index]; }, MAX_ENTITIES, false);
 
         return spriteList;
     }
@@ -532,8 +862,8 @@ struct GameStateSnapshots final : public IGameStateSnapshots
         res.srand0Left = base.srand0;
         res.srand0Right = cmp.srand0;
 
-        std::vector<rct_sprite> spritesBase = BuildSpriteList(const_cast<GameStateSnapshot_t&>(base));
-        std::vector<rct_sprite> spritesCmp = BuildSpriteList(const_cast<GameStateSnapshot_t&>(cmp));
+        std::vector<rct_sprite> spritesBase = BuildSpriteList(base);
+        std::vector<rct_sprite> spritesCmp = BuildSpriteList(cmp);
 
         for (uint32_t i = 0; i < static_cast<uint32_t>(spritesBase.size()); i++)
         {
@@ -682,8 +1012,461 @@ struct GameStateSnapshots final : public IGameStateSnapshots
         return true;
     }
 
+    virtual std::shared_ptr<GameStateResync_t> CaptureResync(uint32_t tick) const override final
+    {
+        auto resync = std::make_shared<GameStateResync_t>();
+        resync->tick = tick;
+        resync->randState = scenario_rand_state();
+
+        resync->tileBlocks.resize(ResyncTileBlockCount);
+        for (size_t blockIndex = 0; blockIndex < ResyncTileBlockCount; blockIndex++)
+        {
+            auto& block = resync->tileBlocks[blockIndex];
+            const int32_t blockX = static_cast<int32_t>(blockIndex % ResyncTileBlocksPerRow) * ResyncTileBlockSize;
+            const int32_t blockY = static_cast<int32_t>(blockIndex / ResyncTileBlocksPerRow) * ResyncTileBlockSize;
+            for (size_t tileIndex = 0; tileIndex < ResyncTilesPerBlock; tileIndex++)
+            {
+                const auto tileX = blockX + static_cast<int32_t>(tileIndex % ResyncTileBlockSize);
+                const auto tileY = blockY + static_cast<int32_t>(tileIndex / ResyncTileBlockSize);
+                const TileElement* tileElement = map_get_first_element_at(TileCoordsXY{ tileX, tileY }.ToCoordsXY());
+                if (tileElement == nullptr)
+                    continue;
+
+                do
+                {
+                    if (tileElement->IsGhost())
+                        continue;
+
+                    auto copy = *tileElement;
+                    copy.SetLastForTile(false);
+                    block.elements.push_back(copy);
+                    block.counts[tileIndex]++;
+                } while (!(tileElement++)->IsLastForTile());
+            }
+        }
+
+        resync->entities.resize(MAX_ENTITIES);
+        resync->entityNames.resize(MAX_ENTITIES);
+        for (size_t i = 0; i < MAX_ENTITIES; i++)
+        {
+            auto& copy = resync->entities[i];
+            copy = *reinterpret_cast<const rct_sprite*>(GetEntity(i));
+            if (copy.misc.Is<Peep>())
+            {
+                if (copy.peep.Name != nullptr)
+                {
+                    resync->entityNames[i] = copy.peep.Name;
+                }
+                copy.peep.Name = nullptr;
+            }
+        }
+
+        resync->rides.resize(MAX_RIDES);
+        for (size_t i = 0; i < MAX_RIDES; i++)
+        {
+            const auto* ride = get_ride(static_cast<ride_id_t>(i));
+            if (ride == nullptr)
+                continue;
+
+            auto& rideData = resync->rides[i];
+            rideData.exists = true;
+            rideData.name = ride->custom_name;
+            ForEachRideDataRange(*ride, [ride, &rideData](size_t offset, size_t length) {
+                const auto* begin = reinterpret_cast<const uint8_t*>(ride) + offset;
+                rideData.data.insert(rideData.data.end(), begin, begin + length);
+            });
+        }
+
+        return resync;
+    }
+
+    virtual GameStateDigest_t GetDigest(const GameStateResync_t& resync) const override final
+    {
+        GameStateDigest_t digest;
+        digest.tick = resync.tick;
+
+        digest.tileBlocks.reserve(resync.tileBlocks.size());
+        for (const auto& block : resync.tileBlocks)
+        {
+            auto hash = HashResyncData(block.counts.data(), block.counts.size() * sizeof(uint16_t));
+            hash = HashResyncData(block.elements.data(), block.elements.size() * sizeof(TileElement), hash);
+            digest.tileBlocks.push_back(hash);
+        }
+
+        digest.entities.reserve(resync.entities.size());
+        for (const auto& entity : resync.entities)
+        {
+            // Same rules as the sprite checksum sent with every tick.
+            if (entity.misc.Type == EntityType::Null || entity.misc.Is<MiscEntity>())
+            {
+                digest.entities.push_back(0);
+                continue;
+            }
+
+            auto copy = entity;
+            copy.misc.sprite_left = copy.misc.sprite_right = copy.misc.sprite_top = copy.misc.sprite_bottom = 0;
+            copy.misc.sprite_width = copy.misc.sprite_height_negative = copy.misc.sprite_height_positive = 0;
+            if (copy.misc.Is<Peep>())
+            {
+                copy.peep.WindowInvalidateFlags = 0;
+            }
+            digest.entities.push_back(HashResyncData(&copy, sizeof(copy)));
+        }
+
+        digest.rides.reserve(resync.rides.size());
+        for (const auto& rideData : resync.rides)
+        {
+            if (!rideData.exists)
+            {
+                digest.rides.push_back(0);
+                continue;
+            }
+
+            auto hash = HashResyncData(rideData.data.data(), rideData.data.size());
+            hash = HashResyncData(rideData.name.data(), rideData.name.size(), hash);
+            digest.rides.push_back(hash);
+        }
+
+        return digest;
+    }
+
+    virtual GameStateResyncParts_t CompareDigests(const GameStateDigest_t& base, const GameStateDigest_t& cmp) const override final
+    {
+        auto compare = [](const std::vector<uint32_t>& a, const std::vector<uint32_t>& b, std::vector<uint32_t>& differing) {
+            const auto count = std::max(a.size(), b.size());
+            for (size_t i = 0; i < count; i++)
+            {
+                const auto hashA = i < a.size() ? a[i] : 0;
+                const auto hashB = i < b.size() ? b[i] : 0;
+                if (hashA != hashB)
+                {
+                    differing.push_back(static_cast<uint32_t>(i));
+                }
+            }
+        };
+
+        GameStateResyncParts_t parts;
+        parts.tick = base.tick;
+        compare(base.tileBlocks, cmp.tileBlocks, parts.tileBlocks);
+        compare(base.entities, cmp.entities, parts.entities);
+        compare(base.rides, cmp.rides, parts.rides);
+        return parts;
+    }
+
+    virtual void SerialiseDigest(GameStateDigest_t& digest, DataSerialiser& ds) const override final
+    {
+        ds << digest.tick;
+        ds << digest.tileBlocks;
+        ds << digest.entities;
+        ds << digest.rides;
+    }
+
+    virtual void SerialiseResyncParts(GameStateResyncParts_t& parts, DataSerialiser& ds) const override final
+    {
+        ds << parts.tick;
+        ds << parts.tileBlocks;
+        ds << parts.entities;
+        ds << parts.rides;
+    }
+
+    virtual void SerialiseResyncData(
+        const GameStateResync_t& resync, const GameStateResyncParts_t& parts, DataSerialiser& ds) const override final
+    {
+        ds << resync.tick;
+        ds << resync.randState.s0;
+        ds << resync.randState.s1;
+
+        std::vector<uint32_t> tileBlocks;
+        std::copy_if(parts.tileBlocks.begin(), parts.tileBlocks.end(), std::back_inserter(tileBlocks), [&](uint32_t index) {
+            return index < resync.tileBlocks.size();
+        });
+        ds << static_cast<uint32_t>(tileBlocks.size());
+        for (auto index : tileBlocks)
+        {
+            const auto& block = resync.tileBlocks[index];
+            ds << index;
+            for (auto count : block.counts)
+            {
+                ds << count;
+            }
+            for (const auto& element : block.elements)
+            {
+                ds << element;
+            }
+        }
+
+        std::vector<uint32_t> entities;
+        std::copy_if(parts.entities.begin(), parts.entities.end(), std::back_inserter(entities), [&](uint32_t index) {
+            return index < resync.entities.size();
+        });
+        ds << static_cast<uint32_t>(entities.size());
+        for (auto index : entities)
+        {
+            ds << index;
+            ds << reinterpret_cast<const uint8_t(&)[sizeof(rct_sprite)]>(resync.entities[index]);
+            ds << resync.entityNames[index];
+        }
+
+        std::vector<uint32_t> rides;
+        std::copy_if(parts.rides.begin(), parts.rides.end(), std::back_inserter(rides), [&](uint32_t index) {
+            return index < resync.rides.size();
+        });
+        ds << static_cast<uint32_t>(rides.size());
+        for (auto index : rides)
+        {
+            const auto& rideData = resync.rides[index];
+            ds << index;
+            ds << rideData.exists;
+            if (rideData.exists)
+            {
+                ds << rideData.name;
+                ds << static_cast<uint32_t>(rideData.data.size());
+                ds.GetStream().Write(rideData.data.data(), rideData.data.size());
+            }
+        }
+    }
+
+    virtual bool ApplyResyncData(DataSerialiser& ds) override final
+    {
+        GameStateResync_t resync;
+        std::vector<uint32_t> tileBlocks;
+        std::vector<uint32_t> entities;
+        std::vector<uint32_t> rides;
+
+        // Read everything first so invalid data leaves the game state untouched.
+        try
+        {
+            ds << resync.tick;
+            ds << resync.randState.s0;
+            ds << resync.randState.s1;
+
+            uint32_t numTileBlocks = 0;
+            ds << numTileBlocks;
+            resync.tileBlocks.resize(ResyncTileBlockCount);
+            for (uint32_t i = 0; i < numTileBlocks; i++)
+            {
+                uint32_t index = 0;
+                ds << index;
+                if (index >= ResyncTileBlockCount)
+                    return false;
+
+                auto& block = resync.tileBlocks[index];
+                size_t numElements = 0;
+                for (auto& count : block.counts)
+                {
+                    ds << count;
+                    // Every tile has at least its surface
+                    if (count == 0)
+                        return false;
+                    numElements += count;
+                }
+                if (numElements > MAX_TILE_ELEMENTS)
+                    return false;
+
+                block.elements.resize(numElements);
+                for (auto& element : block.elements)
+                {
+                    ds << element;
+                }
+                tileBlocks.push_back(index);
+            }
+
+            uint32_t numEntities = 0;
+            ds << numEntities;
+            resync.entities.resize(MAX_ENTITIES);
+            resync.entityNames.resize(MAX_ENTITIES);
+            for (uint32_t i = 0; i < numEntities; i++)
+            {
+                uint32_t index = 0;
+                ds << index;
+                if (index >= MAX_ENTITIES)
+                    return false;
+
+                auto& entity = resync.entities[index];
+                ds << reinterpret_cast<uint8_t(&)[sizeof(rct_sprite)]>(entity);
+                ds << resync.entityNames[index];
+                if (entity.misc.sprite_index != index)
+                    return false;
+                if (entity.misc.Is<Peep>())
+                {
+                    entity.peep.Name = nullptr;
+                }
+                entities.push_back(index);
+            }
+
+            const auto rideDataLength = GetRideDataLength(Ride{});
+            uint32_t numRides = 0;
+            ds << numRides;
+            resync.rides.resize(MAX_RIDES);
+            for (uint32_t i = 0; i < numRides; i++)
+            {
+                uint32_t index = 0;
+                ds << index;
+                if (index >= MAX_RIDES)
+                    return false;
+
+                auto& rideData = resync.rides[index];
+                ds << rideData.exists;
+                if (rideData.exists)
+                {
+                    uint32_t length = 0;
+                    ds << rideData.name;
+                    ds << length;
+                    if (length != rideDataLength)
+                        return false;
+
+                    rideData.data.resize(length);
+                    ds.GetStream().Read(rideData.data.data(), length);
+                }
+                rides.push_back(index);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            log_error("Invalid resync data: %s", e.what());
+            return false;
+        }
+
+        if (!tileBlocks.empty() && !ApplyResyncTileBlocks(resync))
+            return false;
+
+        for (auto index : entities)
+        {
+            auto& dst = *reinterpret_cast<rct_sprite*>(GetEntity(index));
+            if (dst.misc.Is<Peep>())
+            {
+                std::free(dst.peep.Name);
+            }
+
+            dst = resync.entities[index];
+            if (dst.misc.Is<Peep>() && !resync.entityNames[index].empty())
+            {
+                dst.peep.SetName(resync.entityNames[index]);
+            }
+        }
+        if (!entities.empty())
+        {
+            RebuildEntityLists();
+            reset_sprite_spatial_index();
+        }
+
+        for (auto index : rides)
+        {
+            const auto& rideData = resync.rides[index];
+            const auto rideId = static_cast<ride_id_t>(index);
+            if (!rideData.exists)
+            {
+                auto* ride = get_ride(rideId);
+                if (ride != nullptr)
+                {
+                    ride->Delete();
+                }
+                continue;
+            }
+
+            auto* ride = GetOrAllocateRide(rideId);
+            const auto* src = rideData.data.data();
+            ForEachRideDataRange(*ride, [ride, &src](size_t offset, size_t length) {
+                std::memcpy(reinterpret_cast<uint8_t*>(ride) + offset, src, length);
+                src += length;
+            });
+            ride->custom_name = rideData.name;
+            ride->measurement = {};
+        }
+
+        scenario_rand_seed(resync.randState.s0, resync.randState.s1);
+        return true;
+    }
 private:
-    CircularBuffer<std::unique_ptr<GameStateSnapshot_t>, MaximumGameStateSnapshots> _snapshots;
+    /**
+     * Rebuilds the tile element list with the tiles of the received blocks, the client keeps its own ghost elements.
+     */
+    static bool ApplyResyncTileBlocks(const GameStateResync_t& resync)
+    {
+        std::vector<TileElement> newTileElements;
+        newTileElements.reserve(gNextFreeTileElement - gTileElements);
+
+        for (int32_t y = 0; y < MAXIMUM_MAP_SIZE_TECHNICAL; y++)
+        {
+            for (int32_t x = 0; x < MAXIMUM_MAP_SIZE_TECHNICAL; x++)
+            {
+                const auto& block = resync.tileBlocks[(y / ResyncTileBlockSize) * ResyncTileBlocksPerRow + (x / ResyncTileBlockSize)];
+                const auto tileStart = newTileElements.size();
+                const TileElement* tileElement = map_get_first_element_at(TileCoordsXY{ x, y }.ToCoordsXY());
+                if (block.elements.empty())
+                {
+                    if (tileElement != nullptr)
+                    {
+                        do
+                        {
+                            newTileElements.push_back(*tileElement);
+                        } while (!(tileElement++)->IsLastForTile());
+                    }
+                }
+                else
+                {
+                    const size_t tileIndex = (y % ResyncTileBlockSize) * ResyncTileBlockSize + (x % ResyncTileBlockSize);
+                    size_t offset = 0;
+                    for (size_t i = 0; i < tileIndex; i++)
+                    {
+                        offset += block.counts[i];
+                    }
+                    auto begin = block.elements.begin() + offset;
+                    newTileElements.insert(newTileElements.end(), begin, begin + block.counts[tileIndex]);
+
+                    if (tileElement != nullptr)
+                    {
+                        do
+                        {
+                            if (tileElement->IsGhost())
+                            {
+                                newTileElements.push_back(*tileElement);
+                            }
+                        } while (!(tileElement++)->IsLastForTile());
+                    }
+                }
+
+                if (newTileElements.size() == tileStart)
+                    return false;
+                for (auto i = tileStart; i < newTileElements.size(); i++)
+                {
+                    newTileElements[i].SetLastForTile(i == newTileElements.size() - 1);
+                }
+            }
+        }
+
+        if (newTileElements.size() > MAX_TILE_ELEMENTS)
+            return false;
+
+        const auto numElements = newTileElements.size();
+        map_reserve_tile_elements(numElements + (MAX_TILE_ELEMENTS_WITH_SPARE_ROOM - MAX_TILE_ELEMENTS));
+        std::memcpy(gTileElements, newTileElements.data(), numElements * sizeof(TileElement));
+        map_set_tile_elements_end(gTileElements + numElements);
+        map_update_tile_pointers();
+        return true;
+    }
+
+    virtual size_t GetCount() const override final
+    {
+        return _snapshots.size();
+    }
+
+    virtual size_t GetMemoryUsage() const override final
+    {
+        size_t size = _previousSprites.capacity();
+        for (const auto& snapshot : _snapshots)
+        {
+            size += sizeof(GameStateSnapshot_t) + snapshot->storedSprites.GetLength() + snapshot->parkParameters.GetLength()
+                + snapshot->encodedSprites.capacity();
+        }
+        return size;
+    }
+
+    std::deque<std::unique_ptr<GameStateSnapshot_t>> _snapshots;
+    // Sprites of the most recently encoded snapshot, the base of the next delta
+    std::vector<uint8_t> _previousSprites;
+    size_t _snapshotsSinceKeyframe = 0;
+    size_t _capturedSpritesLength = 0;
 };
 
 std::unique_ptr<IGameStateSnapshots> CreateGameStateSnapshots()
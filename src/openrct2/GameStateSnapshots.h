@@ -15,8 +15,10 @@
 #include <memory>
 #include <set>
 #include <string>
+#include <vector>
 
 struct GameStateSnapshot_t;
+struct GameStateResync_t;
 
 struct GameStateSpriteChange_t
 {
@@ -54,6 +56,29 @@ struct GameStateCompareData_t
     std::vector<GameStateSpriteChange_t> spriteChanges;
 };
 
+/*
+ * Hashes of the parts of a game state that can be replaced on their own, indexed by tile block, entity and ride. Comparing
+ * the digests of server and client tells which parts have to be sent to bring the client back in sync.
+ */
+struct GameStateDigest_t
+{
+    uint32_t tick = 0;
+    std::vector<uint32_t> tileBlocks;
+    std::vector<uint32_t> entities;
+    std::vector<uint32_t> rides;
+};
+
+/*
+ * Indices of the tile blocks, entities and rides that differ between two digests.
+ */
+struct GameStateResyncParts_t
+{
+    uint32_t tick = 0;
+    std::vector<uint32_t> tileBlocks;
+    std::vector<uint32_t> entities;
+    std::vector<uint32_t> rides;
+};
+
 /*
  * Interface to create and capture game states. It only allows one to have 32 active snapshots
  * the oldest snapshot will be removed from the buffer. Never store the snapshot pointer
@@ -103,6 +128,47 @@ struct IGameStateSnapshots
      * Writes the GameStateCompareData_t into the specified file as readable text.
      */
     virtual bool LogCompareDataToFile(const std::string& fileName, const GameStateCompareData_t& cmpData) const = 0;
+
+    /*
+     * Copies the tile elements, entities, rides and random state of the current game state so parts of it can be sent
+     * to a desynchronised client later, the game state may advance in the meantime.
+     */
+    virtual std::shared_ptr<GameStateResync_t> CaptureResync(uint32_t tick) const = 0;
+
+    /*
+     * Hashes every tile block, entity and ride of a captured game state.
+     */
+    virtual GameStateDigest_t GetDigest(const GameStateResync_t& resync) const = 0;
+
+    /*
+     * Returns the parts of which the hashes differ.
+     */
+    virtual GameStateResyncParts_t CompareDigests(const GameStateDigest_t& base, const GameStateDigest_t& cmp) const = 0;
+
+    virtual void SerialiseDigest(GameStateDigest_t& digest, DataSerialiser& serialiser) const = 0;
+    virtual void SerialiseResyncParts(GameStateResyncParts_t& parts, DataSerialiser& serialiser) const = 0;
+
+    /*
+     * Writes the requested parts of a captured game state along with its random state.
+     */
+    virtual void SerialiseResyncData(
+        const GameStateResync_t& resync, const GameStateResyncParts_t& parts, DataSerialiser& serialiser) const = 0;
+
+    /*
+     * Reads the data written by SerialiseResyncData and replaces those parts of the current game state, returns false
+     * without replacing anything if the data is invalid.
+     */
+    virtual bool ApplyResyncData(DataSerialiser& serialiser) = 0;
+
+    /*
+     * Returns the number of stored snapshots.
+     */
+    virtual size_t GetCount() const = 0;
+
+    /*
+     * Returns the bytes held by the stored snapshots.
+     */
+    virtual size_t GetMemoryUsage() const = 0;
 };
 
 std::unique_ptr<IGameStateSnapshots> CreateGameStateSnapshots();
@@ -0,0 +1,95 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+
+#include "MemoryUsage.h"
+
+#include "Context.h"
+#include "GameStateSnapshots.h"
+#include "core/Json.hpp"
+#include "drawing/TTF.h"
+#include "network/network.h"
+#include "object/Object.h"
+#include "object/ObjectLimits.h"
+#include "object/ObjectManager.h"
+#include "paint/Painter.h"
+#include "world/EntityList.h"
+#include "world/Map.h"
+#include "world/Sprite.h"
+
+#ifdef ENABLE_SCRIPTING
+#    include "scripting/ScriptEngine.h"
+#endif
+
+using namespace OpenRCT2;
+
+std::vector<MemoryUsageEntry> GetMemoryUsage()
+{
+    auto context = GetContext();
+    std::vector<MemoryUsageEntry> entries;
+
+    // Only the elements up to the end of the used ones have been touched, the rest of the list is not paged in
+    auto numTileElements = static_cast<size_t>(map_get_tile_elements_end() - gTileElements);
+    entries.push_back({ "tileElements", numTileElements, numTileElements * sizeof(TileElement) });
+
+    auto numEntities = static_cast<size_t>(MAX_ENTITIES - GetNumFreeEntities());
+    entries.push_back({ "entities", numEntities, MAX_ENTITIES * sizeof(rct_sprite) });
+
+    MemoryUsageEntry objectImages = { "objectImages" };
+    auto& objectManager = context->GetObjectManager();
+    for (size_t i = 0; i < OBJECT_ENTRY_COUNT; i++)
+    {
+        const auto* object = objectManager.GetLoadedObject(i);
+        if (object != nullptr)
+        {
+            objectImages.Count += object->GetImageTable().GetCount();
+            objectImages.Bytes += object->GetImageTable().GetMemoryUsage();
+        }
+    }
+    entries.push_back(objectImages);
+
+    auto painter = context->GetPainter();
+    if (painter != nullptr)
+    {
+        auto stats = painter->GetSessionStats();
+        entries.push_back({ "paintStructs", stats.AllocatedPaintStructs, stats.AllocatedPaintStructs * sizeof(paint_entry) });
+    }
+
+    entries.push_back({ "ttfCaches", 0, ttf_get_cache_memory_usage() });
+
+    auto snapshots = context->GetGameStateSnapshots();
+    if (snapshots != nullptr)
+    {
+        entries.push_back({ "gameStateSnapshots", snapshots->GetCount(), snapshots->GetMemoryUsage() });
+    }
+
+    auto backlog = network_get_send_backlog();
+    entries.push_back({ "networkSendQueues", backlog.QueuedPackets, backlog.QueuedBytes });
+
+#ifdef ENABLE_SCRIPTING
+    entries.push_back({ "scriptHeap", 0, context->GetScriptEngine().GetHeapSize() });
+#endif
+    return entries;
+}
+
+json_t GetMemoryUsageAsJson()
+{
+    json_t jsonObj = json_t::object();
+    size_t totalBytes = 0;
+    for (const auto& entry : GetMemoryUsage())
+    {
+        jsonObj[entry.Name] = {
+            { "count", entry.Count },
+            { "bytes", entry.Bytes },
+        };
+        totalBytes += entry.Bytes;
+    }
+    jsonObj["totalBytes"] = totalBytes;
+    return jsonObj;
+}
@@ -0,0 +1,33 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+
+#pragma once
+
+#include "common.h"
+#include "core/JsonFwd.hpp"
+
+#include <string>
+#include <vector>
+
+/**
+ * The memory held by one of the larger subsystems. What an item is depends on the subsystem.
+ */
+struct MemoryUsageEntry
+{
+    std::string Name;
+    size_t Count{};
+    size_t Bytes{};
+};
+
+/**
+ * Asks each of the larger subsystems how much memory it holds at the moment, must be called from the game thread.
+ */
+std::vector<MemoryUsageEntry> GetMemoryUsage();
+json_t GetMemoryUsageAsJson();
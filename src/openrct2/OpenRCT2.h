@@ -47,6 +47,8 @@ extern bool gOpenRCT2Headless;
 extern bool gOpenRCT2NoGraphics;
 extern bool gOpenRCT2ShowChangelog;
 extern bool gOpenRCT2SilentBreakpad;
+extern bool gOpenRCT2StartupProfile;
+extern uint32_t gOpenRCT2MemoryStatsInterval;
 extern utf8 gSilentRecordingName[MAX_PATH];
 
 #ifndef DISABLE_NETWORK
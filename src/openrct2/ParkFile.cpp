@@ -0,0 +1,294 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "ParkFile.h"
+
+#include "core/JobPool.h"
+
+#include <algorithm>
+#include <cstring>
+#include <exception>
+#include "zlib.h"
+
+// Chunks this small are stored as they are, compressing them would only add the zlib framing
+constexpr size_t MIN_COMPRESSED_CHUNK_SIZE = 64;
+
+// Limits so corrupt files can not make us allocate arbitrary amounts of memory
+constexpr uint32_t MAX_CHUNKS = 256;
+constexpr uint64_t MAX_CHUNK_SIZE = 64 * 1024 * 1024;
+
+void ParkFileWriter::AddChunk(ParkFileChunkType type, const void* data, size_t length)
+{
+    _chunks.push_back({ type, data, length });
+}
+
+void ParkFileWriter::Save(OpenRCT2::IStream* stream, JobPool& jobPool)
+{
+    struct CompressedChunk
+    {
+        ParkFileCompression Compression = ParkFileCompression::None;
+        std::vector<uint8_t> Data;
+    };
+
+    // Favour speed over size, saving happens on the game thread and autosaves would otherwise stall the game
+    std::vector<CompressedChunk> compressed(_chunks.size());
+    jobPool.ParallelFor(0, _chunks.size(), 1, [this, &compressed](size_t index) {
+        const auto& chunk = _chunks[index];
+        auto& result = compressed[index];
+        if (chunk.Length < MIN_COMPRESSED_CHUNK_SIZE)
+        {
+            return;
+        }
+
+        auto compressedLength = compressBound(static_cast<uLong>(chunk.Length));
+        result.Data.resize(compressedLength);
+        auto status = compress2(
+            result.Data.data(), &compressedLength, static_cast<const Bytef*>(chunk.Data), static_cast<uLong>(chunk.Length),
+            Z_BEST_SPEED);
+        if (status == Z_OK && compressedLength < chunk.Length)
+        {
+            result.Compression = ParkFileCompression::Zlib;
+            result.Data.resize(compressedLength);
+        }
+        else
+        {
+            result.Data = {};
+        }
+    });
+
+    ParkFileHeader header{};
+    header.Magic = ParkFileReader::MAGIC_NUMBER;
+    header.TargetVersion = ParkFileReader::VERSION;
+    header.MinVersion = ParkFileReader::VERSION;
+    header.NumChunks = static_cast<uint32_t>(_chunks.size());
+    stream->WriteValue(header);
+
+    uint64_t offset = sizeof(ParkFileHeader) + sizeof(ParkFileChunkEntry) * _chunks.size();
+    for (size_t i = 0; i < _chunks.size(); i++)
+    {
+        ParkFileChunkEntry entry{};
+        entry.Type = static_cast<uint32_t>(_chunks[i].Type);
+        entry.Compression = static_cast<uint8_t>(compressed[i].Compression);
+        entry.Offset = offset;
+        entry.Length = compressed[i].Compression == ParkFileCompression::None ? _chunks[i].Length : compressed[i].Data.size();
+        entry.UncompressedLength = _chunks[i].Length;
+        stream->WriteValue(entry);
+        offset += entry.Length;
+    }
+
+    for (size_t i = 0; i < _chunks.size(); i++)
+    {
+        if (compressed[i].Compression == ParkFileCompression::None)
+        {
+            stream->Write(_chunks[i].Data, _chunks[i].Length);
+        }
+        else
+        {
+            stream->Write(compressed[i].Data.data(), compressed[i].Data.size());
+        }
+    }
+}
+
+ParkFileReader::ParkFileReader(OpenRCT2::IStream* stream)
+    : _stream(stream)
+{
+    _basePosition = stream->GetPosition();
+    auto header = stream->ReadValue<ParkFileHeader>();
+    if (header.Magic != MAGIC_NUMBER)
+    {
+        throw ParkFileException("Not a park file.");
+    }
+    if (header.MinVersion > VERSION)
+    {
+        throw ParkFileException("Park file was saved by a newer version of OpenRCT2.");
+    }
+    if (header.NumChunks > MAX_CHUNKS)
+    {
+        throw ParkFileException("Corrupt park file table of contents.");
+    }
+
+    const auto fileLength = stream->GetLength() - _basePosition;
+    _chunks.resize(header.NumChunks);
+    for (auto& entry : _chunks)
+    {
+        entry = stream->ReadValue<ParkFileChunkEntry>();
+        if (entry.Length > MAX_CHUNK_SIZE || entry.UncompressedLength > MAX_CHUNK_SIZE || entry.Offset > fileLength
+            || entry.Length > fileLength - entry.Offset)
+        {
+            throw ParkFileException("Corrupt park file table of contents.");
+        }
+    }
+}
+
+bool ParkFileReader::IsParkFile(OpenRCT2::IStream* stream)
+{
+    const auto position = stream->GetPosition();
+    uint32_t magic = 0;
+    const auto isParkFile = stream->TryRead(&magic, sizeof(magic)) == sizeof(magic) && magic == MAGIC_NUMBER;
+    stream->SetPosition(position);
+    return isParkFile;
+}
+
+bool ParkFileReader::HasChunk(ParkFileChunkType type) const
+{
+    return FindChunk(type) != nullptr;
+}
+
+std::vector<uint8_t> ParkFileReader::ReadChunk(ParkFileChunkType type)
+{
+    std::vector<uint8_t> result;
+    auto entry = FindChunk(type);
+    if (entry != nullptr)
+    {
+        std::unique_ptr<uint8_t[]> buffer;
+        auto src = ReadStoredData(*entry, buffer);
+        result.resize(static_cast<size_t>(entry->UncompressedLength));
+        DecodeChunk(*entry, src, result.data(), result.size());
+    }
+    return result;
+}
+
+void ParkFileReader::ReadChunk(ParkFileChunkType type, void* dst, size_t length)
+{
+    auto entry = FindChunk(type);
+    if (entry == nullptr)
+    {
+        std::memset(dst, 0, length);
+        return;
+    }
+
+    std::unique_ptr<uint8_t[]> buffer;
+    auto src = ReadStoredData(*entry, buffer);
+    DecodeChunk(*entry, src, dst, length);
+}
+
+void ParkFileReader::ReadChunks(JobPool& jobPool, std::initializer_list<ChunkDestination> destinations)
+{
+    struct PendingChunk
+    {
+        ChunkDestination Destination;
+        const ParkFileChunkEntry* Entry;
+        const uint8_t* StoredData;
+        std::unique_ptr<uint8_t[]> StoredDataBuffer;
+        std::exception_ptr Exception;
+    };
+
+    // Only reading from the stream has to be sequential
+    std::vector<PendingChunk> chunks(destinations.size());
+    size_t i = 0;
+    for (const auto& destination : destinations)
+    {
+        auto& chunk = chunks[i++];
+        chunk.Destination = destination;
+        chunk.Entry = FindChunk(destination.Type);
+        if (chunk.Entry != nullptr)
+        {
+            chunk.StoredData = ReadStoredData(*chunk.Entry, chunk.StoredDataBuffer);
+        }
+    }
+
+    jobPool.ParallelFor(0, chunks.size(), 1, [&chunks](size_t index) {
+        auto& chunk = chunks[index];
+        try
+        {
+            if (chunk.Entry == nullptr)
+            {
+                std::memset(chunk.Destination.Data, 0, chunk.Destination.Length);
+            }
+            else
+            {
+                DecodeChunk(*chunk.Entry, chunk.StoredData, chunk.Destination.Data, chunk.Destination.Length);
+            }
+        }
+        catch (...)
+        {
+            chunk.Exception = std::current_exception();
+        }
+    });
+
+    for (const auto& chunk : chunks)
+    {
+        if (chunk.Exception != nullptr)
+        {
+            std::rethrow_exception(chunk.Exception);
+        }
+    }
+}
+
+const ParkFileChunkEntry* ParkFileReader::FindChunk(ParkFileChunkType type) const
+{
+    auto it = std::find_if(_chunks.begin(), _chunks.end(), [type](const ParkFileChunkEntry& entry) {
+        return entry.Type == static_cast<uint32_t>(type);
+    });
+    return it != _chunks.end() ? &*it : nullptr;
+}
+
+const uint8_t* ParkFileReader::ReadStoredData(const ParkFileChunkEntry& entry, std::unique_ptr<uint8_t[]>& buffer)
+{
+    // Decode straight from the stream's memory if it has any (memory streams and memory mapped files)
+    auto streamData = static_cast<const uint8_t*>(_stream->GetData());
+    if (streamData != nullptr)
+    {
+        return streamData + _basePosition + entry.Offset;
+    }
+
+    buffer.reset(new uint8_t[static_cast<size_t>(entry.Length)]);
+    _stream->SetPosition(_basePosition + entry.Offset);
+    if (_stream->TryRead(buffer.get(), static_cast<size_t>(entry.Length)) != entry.Length)
+    {
+        throw ParkFileException("Park file is truncated.");
+    }
+    return buffer.get();
+}
+
+void ParkFileReader::DecodeChunk(const ParkFileChunkEntry& entry, const uint8_t* src, void* dst, size_t length)
+{
+    const auto uncompressedLength = static_cast<size_t>(entry.UncompressedLength);
+    auto dst8 = static_cast<uint8_t*>(dst);
+    switch (static_cast<ParkFileCompression>(entry.Compression))
+    {
+        case ParkFileCompression::None:
+            if (entry.Length != entry.UncompressedLength)
+            {
+                throw ParkFileException("Corrupt park file chunk.");
+            }
+            std::memcpy(dst, src, std::min(length, uncompressedLength));
+            break;
+        case ParkFileCompression::Zlib:
+        {
+            // Decompress straight into the destination unless only part of the chunk is wanted
+            std::vector<uint8_t> partialBuffer;
+            uint8_t* target = dst8;
+            if (length < uncompressedLength)
+            {
+                partialBuffer.resize(uncompressedLength);
+                target = partialBuffer.data();
+            }
+
+            auto decompressedLength = static_cast<uLongf>(uncompressedLength);
+            auto status = uncompress(target, &decompressedLength, src, static_cast<uLong>(entry.Length));
+            if (status != Z_OK || decompressedLength != uncompressedLength)
+            {
+                throw ParkFileException("Corrupt park file chunk.");
+            }
+            if (target != dst8)
+            {
+                std::memcpy(dst, target, length);
+            }
+            break;
+        }
+        default:
+            throw ParkFileException("Unsupported park file chunk compression.");
+    }
+
+    if (length > uncompressedLength)
+    {
+        std::memset(dst8 + uncompressedLength, 0, length - uncompressedLength);
+    }
+}
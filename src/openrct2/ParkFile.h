@@ -0,0 +1,154 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "common.h"
+#include "core/IStream.hpp"
+
+#include <initializer_list>
+#include <memory>
+#include <vector>
+
+class JobPool;
+
+/**
+ * The chunks of a park file. A missing chunk is treated as empty by the importer, chunks with an unknown type are
+ * skipped so newer files can add chunks that older versions ignore.
+ */
+enum class ParkFileChunkType : uint32_t
+{
+    Header = 1,
+    Info = 2,
+    PackedObjects = 3,
+    Objects = 4,
+    General = 5,
+    TileElements = 6,
+    ParkState = 7,
+};
+
+enum class ParkFileCompression : uint8_t
+{
+    None = 0,
+    Zlib = 1,
+};
+
+class ParkFileException : public IOException
+{
+public:
+    explicit ParkFileException(const std::string& message)
+        : IOException(message)
+    {
+    }
+};
+
+#pragma pack(push, 1)
+struct ParkFileHeader
+{
+    uint32_t Magic;
+    uint32_t TargetVersion;
+    uint32_t MinVersion;
+    uint32_t NumChunks;
+};
+assert_struct_size(ParkFileHeader, 16);
+
+struct ParkFileChunkEntry
+{
+    uint32_t Type;
+    uint8_t Compression;
+    uint64_t Offset;
+    uint64_t Length;
+    uint64_t UncompressedLength;
+};
+assert_struct_size(ParkFileChunkEntry, 29);
+#pragma pack(pop)
+
+/**
+ * Writes a park file: a header, a table of contents and then every chunk compressed on its own, so that a reader can
+ * seek straight to the chunks it needs and decode them independently.
+ */
+class ParkFileWriter final
+{
+private:
+    struct PendingChunk
+    {
+        ParkFileChunkType Type;
+        const void* Data;
+        size_t Length;
+    };
+
+    std::vector<PendingChunk> _chunks;
+
+public:
+    /**
+     * Adds a chunk to the file, the data is not copied and has to stay valid until Save is called.
+     */
+    void AddChunk(ParkFileChunkType type, const void* data, size_t length);
+
+    /**
+     * Compresses all chunks in parallel on the given job pool and writes the file to the stream.
+     */
+    void Save(OpenRCT2::IStream* stream, JobPool& jobPool);
+};
+
+/**
+ * Reads the table of contents of a park file and decodes its chunks on demand.
+ */
+class ParkFileReader final
+{
+private:
+    OpenRCT2::IStream* const _stream = nullptr;
+    uint64_t _basePosition{};
+    std::vector<ParkFileChunkEntry> _chunks;
+
+public:
+    static constexpr uint32_t MAGIC_NUMBER = 0x4B524150; // PARK
+    static constexpr uint32_t VERSION = 1;
+
+    struct ChunkDestination
+    {
+        ParkFileChunkType Type;
+        void* Data;
+        size_t Length;
+    };
+
+    /**
+     * Reads the header and the table of contents, throws a ParkFileException if the stream is not a park file this
+     * version can read.
+     */
+    explicit ParkFileReader(OpenRCT2::IStream* stream);
+
+    /**
+     * Checks the magic number at the current position of the stream without moving it.
+     */
+    static bool IsParkFile(OpenRCT2::IStream* stream);
+
+    bool HasChunk(ParkFileChunkType type) const;
+
+    /**
+     * Reads and decodes a single chunk, an empty buffer is returned if the file does not have it.
+     */
+    std::vector<uint8_t> ReadChunk(ParkFileChunkType type);
+
+    /**
+     * Reads a chunk into the destination buffer. If the chunk is larger than length, only length is copied. If it is
+     * smaller or missing, the remaining space is padded with zero.
+     */
+    void ReadChunk(ParkFileChunkType type, void* dst, size_t length);
+
+    /**
+     * As above for several chunks at once, which are decoded in parallel on the given job pool.
+     */
+    void ReadChunks(JobPool& jobPool, std::initializer_list<ChunkDestination> destinations);
+
+private:
+    const ParkFileChunkEntry* FindChunk(ParkFileChunkType type) const;
+    const uint8_t* ReadStoredData(const ParkFileChunkEntry& entry, std::unique_ptr<uint8_t[]>& buffer);
+    static void DecodeChunk(const ParkFileChunkEntry& entry, const uint8_t* src, void* dst, size_t length);
+};
@@ -11,6 +11,7 @@
 
 #include "Context.h"
 #include "Game.h"
+#include "GameState.h"
 #include "GameStateSnapshots.h"
 #include "OpenRCT2.h"
 #include "ParkImporter.h"
@@ -33,6 +34,7 @@
 #include "world/Sprite.h"
 #include "zlib.h"
 
+#include <algorithm>
 #include <chrono>
 #include <memory>
 #include <vector>
@@ -76,6 +78,15 @@ namespace OpenRCT2
         OpenRCT2::MemoryStream data;
     };
 
+    // Full park state at a tick of the recording, playback can start from here instead of the beginning.
+    struct ReplayKeyframe
+    {
+        uint32_t tick = 0;
+        OpenRCT2::MemoryStream parkData;
+        OpenRCT2::MemoryStream parkParams;
+        OpenRCT2::MemoryStream cheatData;
+    };
+
     struct ReplayRecordData
     {
         uint32_t magic;
@@ -93,15 +104,18 @@ namespace OpenRCT2
         std::vector<std::pair<uint32_t, rct_sprite_checksum>> checksums;
         uint32_t checksumIndex;
         OpenRCT2::MemoryStream gameStateSnapshots;
+        std::vector<ReplayKeyframe> keyframes; // Sorted by tick.
     };
 
     class ReplayManager final : public IReplayManager
     {
-        static constexpr uint16_t ReplayVersion = 4;
+        static constexpr uint16_t ReplayVersion = 5;
+        static constexpr uint16_t ReplayMinCompatibleVersion = 4;
         static constexpr uint32_t ReplayMagic = 0x5243524F; // ORCR.
         static constexpr int ReplayCompressionLevel = 9;
         static constexpr int NormalRecordingChecksumTicks = 1;
         static constexpr int SilentRecordingChecksumTicks = 40; // Same as network server
+        static constexpr uint32_t KeyframeTicks = 40 * 60 * 5;  // Roughly every 5 minutes at normal speed
 
         enum class ReplayMode
         {
@@ -165,6 +179,15 @@ namespace OpenRCT2
                 _nextChecksumTick = gCurrentTicks + ChecksumTicksDelta();
             }
 
+            if ((_mode == ReplayMode::RECORDING || _mode == ReplayMode::NORMALISATION) && gCurrentTicks == _nextKeyframeTick)
+            {
+                auto& keyframe = _currentRecording->keyframes.emplace_back();
+                keyframe.tick = gCurrentTicks;
+                SaveParkState(keyframe.parkData, keyframe.parkParams, keyframe.cheatData, false);
+
+                _nextKeyframeTick = gCurrentTicks + KeyframeTicks;
+            }
+
             if (_mode == ReplayMode::RECORDING)
             {
                 if (gCurrentTicks >= _currentRecording->tickEnd)
@@ -241,23 +264,10 @@ namespace OpenRCT2
 
             replayData->filePath = name;
 
-            auto context = GetContext();
-            auto& objManager = context->GetObjectManager();
-            auto objects = objManager.GetPackableObjects();
-
-            auto s6exporter = std::make_unique<S6Exporter>();
-            s6exporter->ExportObjectsList = objects;
-            s6exporter->Export();
-            s6exporter->SaveGame(&replayData->parkData);
+            SaveParkState(replayData->parkData, replayData->parkParams, replayData->cheatData, true);
 
             replayData->timeRecorded = std::chrono::seconds(std::time(nullptr)).count();
 
-            DataSerialiser parkParamsDs(true, replayData->parkParams);
-            SerialiseParkParameters(parkParamsDs);
-
-            DataSerialiser cheatDataDs(true, replayData->cheatData);
-            SerialiseCheats(cheatDataDs);
-
             TakeGameStateSnapshot(replayData->gameStateSnapshots);
 
             if (_mode != ReplayMode::NORMALISATION)
@@ -266,6 +276,7 @@ namespace OpenRCT2
             _currentRecording = std::move(replayData);
             _recordType = rt;
             _nextChecksumTick = gCurrentTicks + 1;
+            _nextKeyframeTick = gCurrentTicks + KeyframeTicks;
 
             return true;
         }
@@ -439,6 +450,7 @@ namespace OpenRCT2
             _currentReplay = std::move(replayData);
             _currentReplay->checksumIndex = 0;
             _faultyChecksumIndex = -1;
+            _nextCheckedTick = 0;
 
             // Make sure game is not paused.
             gGamePaused = 0;
@@ -454,6 +466,42 @@ namespace OpenRCT2
             return _faultyChecksumIndex != -1;
         }
 
+        virtual bool SeekPlayback(uint32_t replayTick) override
+        {
+            if (_mode != ReplayMode::PLAYING)
+                return false;
+
+            uint32_t targetTick = _currentReplay->tickStart
+                + std::min(replayTick, _currentReplay->tickEnd - _currentReplay->tickStart);
+
+            // Restore the closest park state before the target, fast-forwarding from the current tick is only
+            // done when no keyframe lies between the two.
+            const auto& keyframes = _currentReplay->keyframes;
+            auto keyframeIt = std::upper_bound(
+                keyframes.begin(), keyframes.end(), targetTick,
+                [](uint32_t tick, const ReplayKeyframe& keyframe) { return tick < keyframe.tick; });
+            uint32_t keyframeTick = keyframeIt == keyframes.begin() ? _currentReplay->tickStart
+                                                                    : std::prev(keyframeIt)->tick;
+
+            if (targetTick < gCurrentTicks || keyframeTick > gCurrentTicks)
+            {
+                if (!RestorePlayback(keyframeTick))
+                    return false;
+            }
+
+            auto* gameState = GetContext()->GetGameState();
+            while (_mode == ReplayMode::PLAYING && gCurrentTicks < targetTick)
+            {
+                gameState->UpdateLogic();
+            }
+            return true;
+        }
+
+        virtual void SetPlaybackChecksumInterval(uint32_t ticks) override
+        {
+            _checksumInterval = std::max<uint32_t>(1, ticks);
+        }
+
         virtual bool StopPlayback() override
         {
             if (_mode != ReplayMode::PLAYING && _mode != ReplayMode::NORMALISATION)
@@ -512,17 +560,42 @@ namespace OpenRCT2
             }
         }
 
+        void SaveParkState(MemoryStream& parkData, MemoryStream& parkParams, MemoryStream& cheatData, bool packObjects)
+        {
+            auto s6exporter = std::make_unique<S6Exporter>();
+            if (packObjects)
+            {
+                auto& objManager = GetContext()->GetObjectManager();
+                s6exporter->ExportObjectsList = objManager.GetPackableObjects();
+            }
+            s6exporter->Export();
+            s6exporter->SaveGame(&parkData);
+
+            DataSerialiser parkParamsDs(true, parkParams);
+            SerialiseParkParameters(parkParamsDs);
+
+            DataSerialiser cheatDataDs(true, cheatData);
+            SerialiseCheats(cheatDataDs);
+        }
+
         bool LoadReplayDataMap(ReplayRecordData& data)
+        {
+            return LoadParkState(data.parkData, data.parkParams, data.cheatData);
+        }
+
+        bool LoadParkState(MemoryStream& parkData, MemoryStream& parkParams, MemoryStream& cheatData)
         {
             try
             {
-                data.parkData.SetPosition(0);
+                parkData.SetPosition(0);
+                parkParams.SetPosition(0);
+                cheatData.SetPosition(0);
 
                 auto context = GetContext();
                 auto& objManager = context->GetObjectManager();
                 auto importer = ParkImporter::CreateS6(context->GetObjectRepository());
 
-                auto loadResult = importer->LoadFromStream(&data.parkData, false);
+                auto loadResult = importer->LoadFromStream(&parkData, false);
                 objManager.LoadObjects(loadResult.RequiredObjects.data(), loadResult.RequiredObjects.size());
 
                 importer->Import();
@@ -530,13 +603,13 @@ namespace OpenRCT2
                 EntityTweener::Get().Reset();
 
                 // Load all map global variables.
-                DataSerialiser parkParamsDs(false, data.parkParams);
+                DataSerialiser parkParamsDs(false, parkParams);
                 SerialiseParkParameters(parkParamsDs);
 
                 // New cheats might not be serialised, make sure they are using their defaults.
                 CheatsReset();
 
-                DataSerialiser cheatDataDs(false, data.cheatData);
+                DataSerialiser cheatDataDs(false, cheatData);
                 SerialiseCheats(cheatDataDs);
 
                 game_load_init();
@@ -550,6 +623,64 @@ namespace OpenRCT2
             return true;
         }
 
+        /**
+         * Puts the park back into the state it had at the given tick of the replay, which has to be the start of the
+         * replay or one of its keyframes.
+         */
+        bool RestorePlayback(uint32_t tick)
+        {
+            // Commands are dropped as they are executed, going back needs them from the file again.
+            if (tick < gCurrentTicks)
+            {
+                auto replayData = std::make_unique<ReplayRecordData>();
+                if (!ReadReplayData(_currentReplay->filePath, *replayData))
+                {
+                    log_error("Unable to read replay data.");
+                    return false;
+                }
+                _currentReplay = std::move(replayData);
+            }
+
+            auto& replay = *_currentReplay;
+            bool loaded = false;
+            if (tick == replay.tickStart)
+            {
+                loaded = LoadReplayDataMap(replay);
+            }
+            else
+            {
+                auto it = std::find_if(
+                    replay.keyframes.begin(), replay.keyframes.end(),
+                    [tick](const ReplayKeyframe& keyframe) { return keyframe.tick == tick; });
+                if (it != replay.keyframes.end())
+                {
+                    loaded = LoadParkState(it->parkData, it->parkParams, it->cheatData);
+                }
+            }
+            if (!loaded)
+            {
+                log_error("Unable to load map.");
+                StopPlayback();
+                return false;
+            }
+
+            gCurrentTicks = tick;
+
+            auto& commands = replay.commands;
+            auto firstCommand = std::find_if(
+                commands.begin(), commands.end(), [tick](const ReplayCommand& command) { return command.tick >= tick; });
+            commands.erase(commands.begin(), firstCommand);
+
+            auto checksumIt = std::find_if(
+                replay.checksums.begin(), replay.checksums.end(),
+                [tick](const std::pair<uint32_t, rct_sprite_checksum>& checksum) { return checksum.first >= tick; });
+            replay.checksumIndex = static_cast<uint32_t>(std::distance(replay.checksums.begin(), checksumIt));
+            _faultyChecksumIndex = -1;
+            _nextCheckedTick = 0;
+
+            return true;
+        }
+
         bool ReadReplayFromFile(const std::string& file, MemoryStream& stream)
         {
             FILE* fp = fopen(file.c_str(), "rb");
@@ -709,7 +840,7 @@ namespace OpenRCT2
 
         bool Compatible(ReplayRecordData& data)
         {
-            return data.version == ReplayVersion;
+            return data.version >= ReplayMinCompatibleVersion && data.version <= ReplayVersion;
         }
 
         bool Serialise(DataSerialiser& serialiser, ReplayRecordData& data)
@@ -782,6 +913,26 @@ namespace OpenRCT2
             }
 
             serialiser << data.gameStateSnapshots;
+
+            // Replays recorded before version 5 have no keyframes, seeking then always fast-forwards from the start.
+            if (data.version >= 5)
+            {
+                uint32_t countKeyframes = static_cast<uint32_t>(data.keyframes.size());
+                serialiser << countKeyframes;
+
+                if (serialiser.IsLoading())
+                {
+                    data.keyframes.resize(countKeyframes);
+                }
+
+                for (auto& keyframe : data.keyframes)
+                {
+                    serialiser << keyframe.tick;
+                    serialiser << keyframe.parkData;
+                    serialiser << keyframe.parkParams;
+                    serialiser << keyframe.cheatData;
+                }
+            }
             return true;
         }
 
@@ -798,6 +949,12 @@ namespace OpenRCT2
             {
                 _currentReplay->checksumIndex++;
 
+                // Recorded checksums in between the checked ones are skipped, the last one is always checked.
+                bool isLastChecksum = _currentReplay->checksumIndex == _currentReplay->checksums.size();
+                if (gCurrentTicks < _nextCheckedTick && !isLastChecksum)
+                    return;
+                _nextCheckedTick = gCurrentTicks + _checksumInterval;
+
                 rct_sprite_checksum checksum = sprite_checksum();
                 if (savedChecksum.second.raw != checksum.raw)
                 {
@@ -875,6 +1032,9 @@ namespace OpenRCT2
         uint32_t _commandId = 0;
         uint32_t _nextChecksumTick = 0;
         uint32_t _nextReplayTick = 0;
+        uint32_t _nextKeyframeTick = 0;
+        uint32_t _checksumInterval = 1;
+        uint32_t _nextCheckedTick = 0;
         RecordType _recordType = RecordType::NORMAL;
     };
 
@@ -60,6 +60,8 @@ namespace OpenRCT2
 
         virtual bool StartPlayback(const std::string& file) = 0;
         virtual bool IsPlaybackStateMismatching() const = 0;
+        virtual bool SeekPlayback(uint32_t replayTick) = 0;
+        virtual void SetPlaybackChecksumInterval(uint32_t ticks) = 0;
         virtual bool StopPlayback() = 0;
 
         virtual bool NormaliseReplay(const std::string& inputFile, const std::string& outputFile) = 0;
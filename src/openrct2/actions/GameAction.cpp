@@ -16,18 +16,23 @@
 #include "../core/MemoryStream.h"
 #include "../localisation/Localisation.h"
 #include "../network/network.h"
+#include "../peep/GuestPathfinding.h"
 #include "../platform/platform.h"
+#include "../ride/Ride.h"
+#include "../ride/RideRatings.h"
 #include "../scenario/Scenario.h"
 #include "../scripting/Duktape.hpp"
 #include "../scripting/HookEngine.h"
 #include "../scripting/ScriptEngine.h"
 #include "../ui/UiContext.h"
 #include "../ui/WindowManager.h"
+#include "../world/Footpath.h"
 #include "../world/Park.h"
 #include "../world/Scenery.h"
 #include "../world/Sprite.h"
 
 #include <algorithm>
+#include <atomic>
 #include <iterator>
 
 using namespace OpenRCT2;
@@ -55,6 +60,66 @@ namespace GameActions
         std::copy_n(args, ErrorMessageArgs.size(), ErrorMessageArgs.begin());
     }
 
+    // Freed results are kept per size class, the virtual destructor passes the size of the derived result
+    static constexpr size_t ResultPoolGranularity = 64;
+    static constexpr size_t ResultPoolSizeClasses = 16;
+    static constexpr size_t MaxPooledResultsPerSizeClass = 64;
+
+    struct PooledResult
+    {
+        PooledResult* Next;
+    };
+
+    struct ResultPool
+    {
+        PooledResult* Free[ResultPoolSizeClasses]{};
+        size_t NumFree[ResultPoolSizeClasses]{};
+    };
+
+    // Results are created and destroyed on the thread running the action, so each thread recycles its own. The pool
+    // has no destructor so results released during shutdown can still be returned to it.
+    static thread_local ResultPool _resultPool;
+
+    static size_t GetResultSizeClass(size_t size)
+    {
+        return (size - 1) / ResultPoolGranularity;
+    }
+
+    void* Result::operator new(size_t size)
+    {
+        auto sizeClass = GetResultSizeClass(size);
+        if (sizeClass >= ResultPoolSizeClasses)
+        {
+            return ::operator new(size);
+        }
+        auto* block = _resultPool.Free[sizeClass];
+        if (block == nullptr)
+        {
+            return ::operator new((sizeClass + 1) * ResultPoolGranularity);
+        }
+        _resultPool.Free[sizeClass] = block->Next;
+        _resultPool.NumFree[sizeClass]--;
+        return block;
+    }
+
+    void Result::operator delete(void* ptr, size_t size)
+    {
+        if (ptr == nullptr)
+        {
+            return;
+        }
+        auto sizeClass = GetResultSizeClass(size);
+        if (sizeClass >= ResultPoolSizeClasses || _resultPool.NumFree[sizeClass] >= MaxPooledResultsPerSizeClass)
+        {
+            ::operator delete(ptr);
+            return;
+        }
+        auto* block = static_cast<PooledResult*>(ptr);
+        block->Next = _resultPool.Free[sizeClass];
+        _resultPool.Free[sizeClass] = block;
+        _resultPool.NumFree[sizeClass]++;
+    }
+
     std::string GameActions::Result::GetErrorTitle() const
     {
         std::string title;
@@ -109,9 +174,18 @@ namespace GameActions
         }
     };
 
+    // Actions pushed by Enqueue, newest first, until ProcessQueue moves them into the ordered queue. Pushing is lock free
+    // so producers on other threads never wait for each other or for the game thread.
+    struct PendingGameAction
+    {
+        QueuedGameAction Queued;
+        PendingGameAction* Next{};
+    };
+
     static GameActionFactory _actions[EnumValue(GameCommand::Count)];
     static std::multiset<QueuedGameAction> _actionQueue;
-    static uint32_t _nextUniqueId = 0;
+    static std::atomic<PendingGameAction*> _pendingActions{ nullptr };
+    static std::atomic<uint32_t> _nextUniqueId{ 0 };
     static bool _suspended = false;
 
     GameActionFactory Register(GameCommand id, GameActionFactory factory)
@@ -158,7 +232,28 @@ namespace GameActions
             // as that normally happens when receiving them over network.
             ga->SetPlayer(network_get_current_player_id());
         }
-        _actionQueue.emplace(tick, std::move(ga), _nextUniqueId++);
+        auto pending = new PendingGameAction{ QueuedGameAction(tick, std::move(ga), _nextUniqueId++) };
+        pending->Next = _pendingActions.load(std::memory_order_relaxed);
+        while (!_pendingActions.compare_exchange_weak(
+            pending->Next, pending, std::memory_order_release, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    /**
+     * Moves the actions enqueued since the last call into the ordered queue. The queue orders by tick and then by the
+     * id given on enqueue, so the order the pending actions are taken in does not matter.
+     */
+    static void TakePendingActions()
+    {
+        auto pending = _pendingActions.exchange(nullptr, std::memory_order_acquire);
+        while (pending != nullptr)
+        {
+            auto next = pending->Next;
+            _actionQueue.insert(std::move(pending->Queued));
+            delete pending;
+            pending = next;
+        }
     }
 
     void ProcessQueue()
@@ -169,6 +264,8 @@ namespace GameActions
             return;
         }
 
+        TakePendingActions();
+
         const uint32_t currentTick = gCurrentTicks;
 
         while (_actionQueue.begin() != _actionQueue.end())
@@ -225,6 +322,7 @@ namespace GameActions
 
     void ClearQueue()
     {
+        TakePendingActions();
         _actionQueue.clear();
     }
 
@@ -454,6 +552,23 @@ namespace GameActions
 
             // Execute the action, changing the game state
             result = action->Execute();
+
+            // Actions may modify tile elements in place, which can change the routes guests take, ride ratings, the
+            // wide flags of paths and how track pieces connect. Only the links between track pieces are read by other
+            // actions, the rest is invalidated once for an action and all the actions nested in it.
+            if (topLevel)
+            {
+                peep_pathfind_invalidate_cache();
+                ride_ratings_proximity_cache_invalidate_all();
+                footpath_invalidate_wide_flags_all();
+                if (!(flags & GAME_COMMAND_FLAG_GHOST))
+                {
+                    // Ghosts are only placed by the construction tools, which remove them before placing the next one
+                    ride_provisional_track_invalidate_cache();
+                }
+            }
+            track_block_links_invalidate();
+            ride_station_elements_invalidate();
 #ifdef ENABLE_SCRIPTING
             if (result->Error == GameActions::Status::Ok)
             {
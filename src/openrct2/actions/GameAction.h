@@ -138,6 +138,10 @@ namespace GameActions
         Result(const GameActions::Result&) = delete;
         virtual ~Result(){};
 
+        // Tools query actions on every mouse move, the results of all actions are recycled rather than reallocated
+        static void* operator new(size_t size);
+        static void operator delete(void* ptr, size_t size);
+
         std::string GetErrorTitle() const;
         std::string GetErrorMessage() const;
     };
@@ -395,6 +399,7 @@ namespace GameActions
     // Resumes queue processing.
     void ResumeQueue();
 
+    // Enqueue may be called from any thread, the queue is only processed and cleared on the game thread.
     void Enqueue(const GameAction* ga, uint32_t tick);
     void Enqueue(GameAction::Ptr&& ga, uint32_t tick);
     void ProcessQueue();
@@ -68,6 +68,7 @@
 #include "SignSetStyleAction.h"
 #include "SmallSceneryPlaceAction.h"
 #include "SmallSceneryRemoveAction.h"
+#include "SmallSceneryScatterAction.h"
 #include "SmallScenerySetColourAction.h"
 #include "StaffFireAction.h"
 #include "StaffHireNewAction.h"
@@ -148,6 +149,7 @@ namespace GameActions
         Register<WallSetColourAction>();
         Register<SmallSceneryPlaceAction>();
         Register<SmallSceneryRemoveAction>();
+        Register<SmallSceneryScatterAction>();
         Register<SmallScenerySetColourAction>();
         Register<LargeSceneryPlaceAction>();
         Register<LargeSceneryRemoveAction>();
@@ -208,6 +208,7 @@ GameActions::Result::Ptr RideDemolishAction::DemolishRide(Ride* ride) const
         }
         if (peep->FavouriteRide == _rideIndex)
         {
+            ride_guest_favourite_changed(peep->FavouriteRide, RIDE_ID_NULL);
             peep->FavouriteRide = RIDE_ID_NULL;
         }
 
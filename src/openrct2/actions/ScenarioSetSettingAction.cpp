@@ -12,12 +12,14 @@
 #include "../OpenRCT2.h"
 #include "../interface/Window.h"
 #include "../management/Finance.h"
+#include "../peep/GuestPathfinding.h"
 #include "../peep/Peep.h"
 #include "../scenario/Scenario.h"
 #include "../util/Util.h"
 #include "../world/Park.h"
 
 #include <algorithm>
+#include <limits>
 
 void ScenarioSetSettingAction::Serialise(DataSerialiser& stream)
 {
@@ -240,6 +242,9 @@ GameActions::Result::Ptr ScenarioSetSettingAction::Execute() const
         case ScenarioSetSetting::AllowEarlyCompletion:
             gAllowEarlyCompletionInNetworkPlay = _value;
             break;
+        case ScenarioSetSetting::GuestPathfindingBudget:
+            gGuestPathfindingBudget = std::clamp<uint32_t>(_value, 0, std::numeric_limits<uint16_t>::max());
+            break;
         default:
             log_error("Invalid setting: %u", _setting);
             return MakeResult(GameActions::Status::InvalidParameters, STR_NONE);
@@ -630,8 +630,7 @@ void SetCheatAction::RemoveAllGuests() const
 
         for (size_t stationIndex = 0; stationIndex < MAX_STATIONS; stationIndex++)
         {
-            ride.stations[stationIndex].QueueLength = 0;
-            ride.stations[stationIndex].LastPeepInQueue = SPRITE_INDEX_NULL;
+            ride.QueueClear(static_cast<StationIndex>(stationIndex));
         }
 
         for (auto trainIndex : ride.vehicles)
@@ -659,15 +658,9 @@ void SetCheatAction::RemoveAllGuests() const
         }
     }
 
-    // Do not use the FOR_ALL_PEEPS macro for this as next sprite index
-    // will be fetched on a deleted guest.
-    for (auto guest : EntityList<Guest>())
-    {
-        guest->Remove();
-    }
+    peep_remove_all_guests();
 
     window_invalidate_by_class(WC_RIDE);
-    gfx_invalidate_screen();
 }
 
 void SetCheatAction::SetStaffSpeed(uint8_t value) const
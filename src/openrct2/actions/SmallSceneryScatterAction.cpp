@@ -0,0 +1,118 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "SmallSceneryScatterAction.h"
+
+#include "../localisation/Formatter.h"
+#include "../localisation/StringIds.h"
+#include "../management/Finance.h"
+#include "SmallSceneryPlaceAction.h"
+
+SmallSceneryScatterAction::SmallSceneryScatterAction(
+    ObjectEntryIndex sceneryType, uint8_t primaryColour, uint8_t secondaryColour)
+    : _sceneryType(sceneryType)
+    , _primaryColour(primaryColour)
+    , _secondaryColour(secondaryColour)
+{
+}
+
+void SmallSceneryScatterAction::AddItem(const CoordsXYZD& loc, uint8_t quadrant)
+{
+    _locs.push_back(loc);
+    _quadrants.push_back(quadrant);
+}
+
+size_t SmallSceneryScatterAction::GetNumItems() const
+{
+    return _locs.size();
+}
+
+uint32_t SmallSceneryScatterAction::GetCooldownTime() const
+{
+    return 20;
+}
+
+void SmallSceneryScatterAction::Serialise(DataSerialiser& stream)
+{
+    GameAction::Serialise(stream);
+
+    stream << DS_TAG(_locs) << DS_TAG(_quadrants) << DS_TAG(_sceneryType) << DS_TAG(_primaryColour)
+           << DS_TAG(_secondaryColour);
+}
+
+GameActions::Result::Ptr SmallSceneryScatterAction::Query() const
+{
+    return QueryExecute(false);
+}
+
+GameActions::Result::Ptr SmallSceneryScatterAction::Execute() const
+{
+    return QueryExecute(true);
+}
+
+GameActions::Result::Ptr SmallSceneryScatterAction::QueryExecute(bool executing) const
+{
+    if (_locs.empty() || _locs.size() != _quadrants.size() || _locs.size() > MaxItems)
+    {
+        log_error("Invalid number of scatter items: %zu", _locs.size());
+        return MakeResult(GameActions::Status::InvalidParameters, STR_CANT_POSITION_THIS_HERE);
+    }
+
+    auto result = MakeResult();
+    result->ErrorTitle = STR_CANT_POSITION_THIS_HERE;
+    result->Expenditure = ExpenditureType::Landscaping;
+
+    // Every item is checked and placed on its own, the first error is reported if none of them could be placed
+    GameActions::Result::Ptr firstError;
+    money32 totalCost = 0;
+    bool anyPlaced = false;
+    for (size_t i = 0; i < _locs.size(); i++)
+    {
+        auto placeAction = SmallSceneryPlaceAction(_locs[i], _quadrants[i], _sceneryType, _primaryColour, _secondaryColour);
+        placeAction.SetFlags(GetFlags());
+
+        auto res = executing ? GameActions::ExecuteNested(&placeAction) : GameActions::QueryNested(&placeAction);
+        if (res->Error == GameActions::Status::Ok && !finance_check_affordability(totalCost + res->Cost, GetFlags()))
+        {
+            // Place as many items as the park can afford, like placing them one by one would
+            res->Error = GameActions::Status::InsufficientFunds;
+            res->ErrorTitle = STR_CANT_POSITION_THIS_HERE;
+            res->ErrorMessage = STR_NOT_ENOUGH_CASH_REQUIRES;
+            Formatter(res->ErrorMessageArgs.data()).Add<uint32_t>(totalCost + res->Cost);
+        }
+
+        if (res->Error != GameActions::Status::Ok)
+        {
+            if (firstError == nullptr)
+            {
+                firstError = std::move(res);
+            }
+            if (firstError->Error == GameActions::Status::InsufficientFunds)
+            {
+                break;
+            }
+            continue;
+        }
+
+        if (!anyPlaced)
+        {
+            result->Position = res->Position;
+            anyPlaced = true;
+        }
+        totalCost += res->Cost;
+    }
+
+    if (!anyPlaced)
+    {
+        return firstError;
+    }
+
+    result->Cost = totalCost;
+    return result;
+}
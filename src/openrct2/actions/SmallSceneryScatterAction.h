@@ -0,0 +1,49 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "GameAction.h"
+
+#include <vector>
+
+/**
+ * Places a batch of small scenery items of the same type, e.g. the items of one click of the scatter tool. The batch is
+ * sent over the network as a single action and is charged as a single payment. Items that can not be placed are
+ * skipped, the action only fails if none of them can be placed.
+ */
+DEFINE_GAME_ACTION(SmallSceneryScatterAction, GameCommand::ScatterScenery, GameActions::Result)
+{
+public:
+    // Upper bound for the number of items in one batch, so a single action can not stall the server
+    static constexpr size_t MaxItems = 1024;
+
+private:
+    std::vector<CoordsXYZD> _locs;
+    std::vector<uint8_t> _quadrants;
+    ObjectEntryIndex _sceneryType{};
+    uint8_t _primaryColour{};
+    uint8_t _secondaryColour{};
+
+public:
+    SmallSceneryScatterAction() = default;
+    SmallSceneryScatterAction(ObjectEntryIndex sceneryType, uint8_t primaryColour, uint8_t secondaryColour);
+
+    void AddItem(const CoordsXYZD& loc, uint8_t quadrant);
+    size_t GetNumItems() const;
+
+    uint32_t GetCooldownTime() const override;
+
+    void Serialise(DataSerialiser & stream) override;
+    GameActions::Result::Ptr Query() const override;
+    GameActions::Result::Ptr Execute() const override;
+
+private:
+    GameActions::Result::Ptr QueryExecute(bool executing) const;
+};
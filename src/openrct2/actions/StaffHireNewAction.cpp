@@ -157,6 +157,7 @@ GameActions::Result::Ptr StaffHireNewAction::QueryExecute(bool execute) const
         newPeep->PaidOnFood = 0;
         newPeep->PaidOnSouvenirs = 0;
         newPeep->FavouriteRide = RIDE_ID_NULL;
+        newPeep->GuestPreviousInQueue = SPRITE_INDEX_NULL;
         newPeep->StaffOrders = _staffOrders;
 
         // We search for the first available Id for a given staff type
@@ -63,21 +63,9 @@ GameActions::Result::Ptr StaffSetPatrolAreaAction::Execute() const
         return MakeResult(GameActions::Status::InvalidParameters, STR_NONE);
     }
 
-    int32_t patrolOffset = staff->StaffId * STAFF_PATROL_AREA_SIZE;
-
     staff_toggle_patrol_area(staff->StaffId, _loc);
 
-    bool isPatrolling = false;
-    for (int32_t i = 0; i < 128; i++)
-    {
-        if (gStaffPatrolAreas[patrolOffset + i])
-        {
-            isPatrolling = true;
-            break;
-        }
-    }
-
-    if (isPatrolling)
+    if (staff_has_patrol_area(staff->StaffId))
     {
         gStaffModes[staff->StaffId] = StaffMode::Patrol;
     }
@@ -0,0 +1,126 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "CommandLine.hpp"
+
+#ifdef USE_BENCHMARK
+
+#    include "../Context.h"
+#    include "../OpenRCT2.h"
+#    include "../localisation/Formatting.h"
+#    include "../localisation/Language.h"
+#    include "../localisation/StringIds.h"
+#    include "../platform/platform.h"
+
+#    include <benchmark/benchmark.h>
+#    include <memory>
+#    include <vector>
+
+using namespace OpenRCT2;
+
+static const std::vector<FormatArg_t> QueuingForArgs = { STR_RIDE_NAME_DEFAULT, STR_RIDE_NAME_BOAT_HIRE, 2 };
+
+/**
+ * Formats a language string with the tokens the language pack parsed when it was loaded.
+ */
+static void BM_format_compiled(benchmark::State& state)
+{
+    auto fmt = GetFmtStringById(STR_QUEUING_FOR);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(FormatStringAny(fmt, QueuingForArgs));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+/**
+ * Formats the same language string, parsing its text on every call as strings that are not from a language pack are.
+ */
+static void BM_format_parsed(benchmark::State& state)
+{
+    auto text = language_get_string(STR_QUEUING_FOR);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(FormatStringAny(FmtString(text), QueuingForArgs));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+static int cmdline_for_bench_formatting(int argc, const char** argv)
+{
+    benchmark::RegisterBenchmark("compiled", BM_format_compiled);
+    benchmark::RegisterBenchmark("parsed", BM_format_parsed);
+
+    // Google benchmark does stuff to argv. It doesn't modify the pointees,
+    // but it wants to reorder the pointers, so present a copy of them.
+    std::vector<char*> argv_for_benchmark;
+
+    // argv[0] is expected to contain the binary name. It's only for logging purposes, don't bother.
+    argv_for_benchmark.push_back(nullptr);
+    for (int i = 0; i < argc; i++)
+    {
+        argv_for_benchmark.push_back(const_cast<char*>(argv[i]));
+    }
+    // Update argc with all the changes made
+    argc = static_cast<int>(argv_for_benchmark.size());
+    ::benchmark::Initialize(&argc, &argv_for_benchmark[0]);
+    if (::benchmark::ReportUnrecognizedArguments(argc, &argv_for_benchmark[0]))
+        return -1;
+
+    core_init();
+    gOpenRCT2Headless = true;
+    gOpenRCT2NoGraphics = true;
+
+    // The context loads the language pack the strings are formatted from
+    auto context = CreateContext();
+    if (!context->Initialise())
+    {
+        log_error("Context initialization failed.");
+        return -1;
+    }
+    language_open(LANGUAGE_ENGLISH_UK);
+
+    ::benchmark::RunSpecifiedBenchmarks();
+    return 0;
+}
+
+static exitcode_t HandleBenchFormatting(CommandLineArgEnumerator* argEnumerator)
+{
+    const char** argv = const_cast<const char**>(argEnumerator->GetArguments()) + argEnumerator->GetIndex();
+    int32_t argc = argEnumerator->GetCount() - argEnumerator->GetIndex();
+    int32_t result = cmdline_for_bench_formatting(argc, argv);
+    if (result < 0)
+    {
+        return EXITCODE_FAIL;
+    }
+    return EXITCODE_OK;
+}
+
+#else
+static exitcode_t HandleBenchFormatting(CommandLineArgEnumerator* argEnumerator)
+{
+    log_error("Sorry, Google benchmark not enabled in this build");
+    return EXITCODE_FAIL;
+}
+#endif // USE_BENCHMARK
+
+const CommandLineCommand CommandLine::BenchFormattingCommands[]{
+#ifdef USE_BENCHMARK
+    DefineCommand(
+        "",
+        "[--benchmark_list_tests={true|false}] [--benchmark_filter=<regex>] [--benchmark_min_time=<min_time>] "
+        "[--benchmark_repetitions=<num_repetitions>] [--benchmark_report_aggregates_only={true|false}] "
+        "[--benchmark_format=<console|json|csv>] [--benchmark_out=<filename>] [--benchmark_out_format=<json|console|csv>] "
+        "[--benchmark_color={auto|true|false}] [--benchmark_counters_tabular={true|false}] [--v=<verbosity>]",
+        nullptr, HandleBenchFormatting),
+    CommandTableEnd
+#else
+    DefineCommand("", "*** SORRY NOT ENABLED IN THIS BUILD ***", nullptr, HandleBenchFormatting), CommandTableEnd
+#endif // USE_BENCHMARK
+};
@@ -0,0 +1,231 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "CommandLine.hpp"
+
+#ifdef USE_BENCHMARK
+
+#    include "../Context.h"
+#    include "../Game.h"
+#    include "../Intro.h"
+#    include "../OpenRCT2.h"
+#    include "../config/Config.h"
+#    include "../drawing/Drawing.h"
+#    include "../drawing/X8DrawingEngine.h"
+#    include "../interface/Viewport.h"
+#    include "../platform/Platform2.h"
+#    include "../platform/platform.h"
+#    include "../world/Map.h"
+#    include "../world/Sprite.h"
+
+#    include <benchmark/benchmark.h>
+#    include <chrono>
+#    include <cstdint>
+#    include <memory>
+#    include <string>
+#    include <vector>
+
+using namespace OpenRCT2;
+using namespace OpenRCT2::Drawing;
+
+// Size of the rendered view in pixels, the view covers more of the map the further it is zoomed out
+constexpr int32_t ViewWidth = 1920;
+constexpr int32_t ViewHeight = 1080;
+constexpr int32_t NumRotations = 4;
+constexpr int32_t NumZoomLevels = 4;
+
+// The camera positions every view is rendered at, as a fraction of the map size
+constexpr std::pair<float, float> CameraPositions[] = {
+    { 0.5f, 0.5f }, { 0.25f, 0.25f }, { 0.75f, 0.25f }, { 0.25f, 0.75f }, { 0.75f, 0.75f },
+};
+
+static std::unique_ptr<IContext> _benchContext;
+static std::string _loadedPark;
+
+static bool load_park(const std::string& path)
+{
+    // All zoom levels and rotations of a park are registered one after the other, only load it for the first of them
+    if (_loadedPark == path)
+    {
+        return true;
+    }
+    _loadedPark.clear();
+    if (!_benchContext->LoadParkFromFile(path))
+    {
+        return false;
+    }
+    gIntroState = IntroState::None;
+    gScreenFlags = SCREEN_FLAGS_PLAYING;
+    _loadedPark = path;
+    return true;
+}
+
+static rct_viewport create_viewport(const CoordsXY& position, int32_t rotation, ZoomLevel zoom)
+{
+    rct_viewport viewport{};
+    viewport.width = ViewWidth;
+    viewport.height = ViewHeight;
+    viewport.view_width = ViewWidth * zoom;
+    viewport.view_height = ViewHeight * zoom;
+    viewport.zoom = zoom;
+
+    auto coords2d = translate_3d_to_2d_with_z(rotation, CoordsXYZ(position, tile_element_height(position)));
+    viewport.viewPos = { coords2d.x - viewport.view_width / 2, coords2d.y - viewport.view_height / 2 };
+    return viewport;
+}
+
+/**
+ * Renders the park at every camera position with the software renderer and reports the time spent generating,
+ * arranging and drawing the paint structs per frame.
+ */
+static void BM_paint(benchmark::State& state, const std::string& path, int32_t rotation, ZoomLevel zoom)
+{
+    if (!load_park(path))
+    {
+        state.SkipWithError("Failed to load park!");
+        return;
+    }
+
+    auto backupRotation = gCurrentRotation;
+    gCurrentRotation = rotation;
+    // Ensure sprites appear regardless of rotation
+    reset_all_sprite_quadrant_placements();
+
+    std::vector<rct_viewport> viewports;
+    for (const auto& [fractionX, fractionY] : CameraPositions)
+    {
+        auto position = CoordsXY(gMapSizeUnits * fractionX, gMapSizeUnits * fractionY).ToTileCentre();
+        viewports.push_back(create_viewport(position, rotation, zoom));
+    }
+
+    X8DrawingEngine drawingEngine(GetContext()->GetUiContext());
+    std::vector<uint8_t> bits(ViewWidth * ViewHeight);
+    rct_drawpixelinfo dpi{};
+    dpi.bits = bits.data();
+    dpi.width = ViewWidth;
+    dpi.height = ViewHeight;
+    dpi.DrawingEngine = &drawingEngine;
+
+    // Paint on this thread only, so the stage times add up to the time a frame takes
+    auto backupMultithreading = gConfigGeneral.multithreading;
+    gConfigGeneral.multithreading = false;
+
+    PaintTimings timings;
+    gPaintTimings = &timings;
+    for (auto _ : state)
+    {
+        for (const auto& viewport : viewports)
+        {
+            viewport_render(&dpi, &viewport, 0, 0, viewport.width, viewport.height);
+        }
+    }
+    gPaintTimings = nullptr;
+    gConfigGeneral.multithreading = backupMultithreading;
+    gCurrentRotation = backupRotation;
+
+    const auto numFrames = static_cast<double>(state.iterations() * viewports.size());
+    state.SetItemsProcessed(state.iterations() * viewports.size());
+    if (numFrames > 0)
+    {
+        state.counters["Generate_us"] = std::chrono::duration<double, std::micro>(timings.Generate).count() / numFrames;
+        state.counters["Arrange_us"] = std::chrono::duration<double, std::micro>(timings.Arrange).count() / numFrames;
+        state.counters["Draw_us"] = std::chrono::duration<double, std::micro>(timings.Draw).count() / numFrames;
+        state.counters["PaintStructs"] = timings.PaintStructs / numFrames;
+        state.counters["Columns"] = timings.Columns / numFrames;
+    }
+}
+
+static int cmdline_for_bench_paint(int argc, const char** argv)
+{
+    // Google benchmark does stuff to argv. It doesn't modify the pointees,
+    // but it wants to reorder the pointers, so present a copy of them.
+    std::vector<char*> argv_for_benchmark;
+
+    // argv[0] is expected to contain the binary name. It's only for logging purposes, don't bother.
+    argv_for_benchmark.push_back(nullptr);
+
+    // Extract file names from argument list. If there is no such file, consider it benchmark option.
+    for (int i = 0; i < argc; i++)
+    {
+        if (Platform::FileExists(argv[i]))
+        {
+            for (int32_t zoom = 0; zoom < NumZoomLevels; zoom++)
+            {
+                for (int32_t rotation = 0; rotation < NumRotations; rotation++)
+                {
+                    auto name = std::string(argv[i]) + "/zoom:" + std::to_string(zoom) + "/rotation:"
+                        + std::to_string(rotation);
+                    benchmark::RegisterBenchmark(name.c_str(), BM_paint, std::string(argv[i]), rotation, ZoomLevel(zoom));
+                }
+            }
+        }
+        else
+        {
+            argv_for_benchmark.push_back(const_cast<char*>(argv[i]));
+        }
+    }
+    // Update argc with all the changes made
+    argc = static_cast<int>(argv_for_benchmark.size());
+    ::benchmark::Initialize(&argc, &argv_for_benchmark[0]);
+    if (::benchmark::ReportUnrecognizedArguments(argc, &argv_for_benchmark[0]))
+        return -1;
+
+    core_init();
+    gOpenRCT2Headless = true;
+
+    // The game state is global, all benchmarks share one context and replace its park
+    _benchContext = CreateContext();
+    if (!_benchContext->Initialise())
+    {
+        log_error("Context initialization failed.");
+        return -1;
+    }
+    drawing_engine_init();
+
+    ::benchmark::RunSpecifiedBenchmarks();
+
+    drawing_engine_dispose();
+    _benchContext = nullptr;
+    return 0;
+}
+
+static exitcode_t HandleBenchPaint(CommandLineArgEnumerator* argEnumerator)
+{
+    const char** argv = const_cast<const char**>(argEnumerator->GetArguments()) + argEnumerator->GetIndex();
+    int32_t argc = argEnumerator->GetCount() - argEnumerator->GetIndex();
+    int32_t result = cmdline_for_bench_paint(argc, argv);
+    if (result < 0)
+    {
+        return EXITCODE_FAIL;
+    }
+    return EXITCODE_OK;
+}
+
+#else
+static exitcode_t HandleBenchPaint(CommandLineArgEnumerator* argEnumerator)
+{
+    log_error("Sorry, Google benchmark not enabled in this build");
+    return EXITCODE_FAIL;
+}
+#endif // USE_BENCHMARK
+
+const CommandLineCommand CommandLine::BenchPaintCommands[]{
+#ifdef USE_BENCHMARK
+    DefineCommand(
+        "",
+        "<file>... [--benchmark_list_tests={true|false}] [--benchmark_filter=<regex>] [--benchmark_min_time=<min_time>] "
+        "[--benchmark_repetitions=<num_repetitions>] [--benchmark_report_aggregates_only={true|false}] "
+        "[--benchmark_format=<console|json|csv>] [--benchmark_out=<filename>] [--benchmark_out_format=<json|console|csv>] "
+        "[--benchmark_color={auto|true|false}] [--benchmark_counters_tabular={true|false}] [--v=<verbosity>]",
+        nullptr, HandleBenchPaint),
+    CommandTableEnd
+#else
+    DefineCommand("", "*** SORRY NOT ENABLED IN THIS BUILD ***", nullptr, HandleBenchPaint), CommandTableEnd
+#endif // USE_BENCHMARK
+};
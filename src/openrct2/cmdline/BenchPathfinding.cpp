@@ -0,0 +1,417 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "CommandLine.hpp"
+
+#ifdef USE_BENCHMARK
+
+#    include "../Context.h"
+#    include "../OpenRCT2.h"
+#    include "../peep/GuestPathfinding.h"
+#    include "../peep/Peep.h"
+#    include "../platform/Platform2.h"
+#    include "../platform/platform.h"
+#    include "../scenario/Scenario.h"
+#    include "../world/Footpath.h"
+#    include "../world/Map.h"
+#    include "../world/Sprite.h"
+#    include "../world/Surface.h"
+
+#    include <benchmark/benchmark.h>
+#    include <chrono>
+#    include <cstdint>
+#    include <functional>
+#    include <memory>
+#    include <random>
+#    include <string>
+#    include <utility>
+#    include <vector>
+
+using namespace OpenRCT2;
+
+// The number of start and goal pairs searched per iteration
+constexpr size_t NumSearches = 64;
+// Height of the footpaths in the generated parks, level with the flat surface map_init creates
+constexpr int32_t SyntheticPathBaseHeight = 14;
+
+using CreatePark = std::function<bool()>;
+
+static std::unique_ptr<IContext> _benchContext;
+
+/**
+ * Replaces the map with a flat one of the given size that has a flat footpath on each of the given tiles, joined to the
+ * footpaths next to it.
+ */
+static void create_path_network(int32_t mapSize, const std::vector<TileCoordsXY>& pathTiles)
+{
+    reset_sprite_list();
+    map_init(mapSize);
+
+    std::vector<bool> isPath(mapSize * mapSize);
+    for (const auto& tile : pathTiles)
+    {
+        isPath[tile.y * mapSize + tile.x] = true;
+    }
+
+    const int32_t baseZ = SyntheticPathBaseHeight * COORDS_Z_STEP;
+    for (const auto& tile : pathTiles)
+    {
+        auto* surfaceElement = map_get_surface_element_at(tile.ToCoordsXY());
+        if (surfaceElement != nullptr)
+        {
+            surfaceElement->SetOwnership(OWNERSHIP_OWNED);
+        }
+
+        auto* pathElement = TileElementInsert<PathElement>({ tile.ToCoordsXY(), baseZ }, 0b1111);
+        if (pathElement == nullptr)
+        {
+            continue;
+        }
+        pathElement->SetClearanceZ(baseZ + PATH_CLEARANCE);
+        pathElement->SetRideIndex(RIDE_ID_NULL);
+        pathElement->SetAdditionStatus(255);
+
+        uint8_t edges = 0;
+        for (Direction direction = 0; direction < NumOrthogonalDirections; direction++)
+        {
+            auto neighbour = tile + TileDirectionDelta[direction];
+            if (neighbour.x >= 0 && neighbour.y >= 0 && neighbour.x < mapSize && neighbour.y < mapSize
+                && isPath[neighbour.y * mapSize + neighbour.x])
+            {
+                edges |= 1 << direction;
+            }
+        }
+        pathElement->SetEdges(edges);
+    }
+    peep_pathfind_invalidate_cache();
+}
+
+/**
+ * Footpaths along every spacing-th row and column of the map, so there is a junction wherever they cross.
+ */
+static std::vector<TileCoordsXY> create_grid_path_tiles(int32_t mapSize, int32_t spacing)
+{
+    std::vector<TileCoordsXY> tiles;
+    for (int32_t y = 1; y < mapSize - 1; y++)
+    {
+        for (int32_t x = 1; x < mapSize - 1; x++)
+        {
+            if ((x - 1) % spacing == 0 || (y - 1) % spacing == 0)
+            {
+                tiles.emplace_back(x, y);
+            }
+        }
+    }
+    return tiles;
+}
+
+/**
+ * A maze of one tile wide footpaths carved out by a depth first walk from the first cell, with a fixed seed so it is the
+ * same maze every time. The cells lie on the odd tiles, the tiles between two cells join them.
+ */
+static std::vector<TileCoordsXY> create_maze_path_tiles(int32_t cellsPerSide)
+{
+    std::mt19937 rng(0);
+    std::vector<bool> visited(cellsPerSide * cellsPerSide);
+    std::vector<TileCoordsXY> tiles;
+    std::vector<TileCoordsXY> stack;
+
+    stack.emplace_back(0, 0);
+    visited[0] = true;
+    tiles.emplace_back(1, 1);
+    while (!stack.empty())
+    {
+        auto cell = stack.back();
+        Direction unvisited[NumOrthogonalDirections];
+        size_t numUnvisited = 0;
+        for (Direction direction = 0; direction < NumOrthogonalDirections; direction++)
+        {
+            auto next = cell + TileDirectionDelta[direction];
+            if (next.x >= 0 && next.y >= 0 && next.x < cellsPerSide && next.y < cellsPerSide
+                && !visited[next.y * cellsPerSide + next.x])
+            {
+                unvisited[numUnvisited++] = direction;
+            }
+        }
+        if (numUnvisited == 0)
+        {
+            stack.pop_back();
+            continue;
+        }
+
+        auto direction = unvisited[rng() % numUnvisited];
+        auto next = cell + TileDirectionDelta[direction];
+        visited[next.y * cellsPerSide + next.x] = true;
+        const auto& delta = TileDirectionDelta[direction];
+        tiles.emplace_back(cell.x * 2 + 1 + delta.x, cell.y * 2 + 1 + delta.y);
+        tiles.emplace_back(next.x * 2 + 1, next.y * 2 + 1);
+        stack.push_back(next);
+    }
+    return tiles;
+}
+
+static bool create_small_park()
+{
+    create_path_network(34, create_grid_path_tiles(34, 4));
+    return true;
+}
+
+static bool create_maze_park()
+{
+    create_path_network(101, create_maze_path_tiles(49));
+    return true;
+}
+
+// About 10,000 footpath tiles
+static bool create_network_park()
+{
+    create_path_network(202, create_grid_path_tiles(202, 8));
+    return true;
+}
+
+/**
+ * Returns the flat footpaths of the park that are not queues, these are the tiles searches start from and head to.
+ */
+static std::vector<TileCoordsXYZ> get_path_tiles()
+{
+    std::vector<TileCoordsXYZ> tiles;
+    for (int32_t y = 0; y < gMapSize; y++)
+    {
+        for (int32_t x = 0; x < gMapSize; x++)
+        {
+            auto* tileElement = map_get_first_element_at(TileCoordsXY{ x, y }.ToCoordsXY());
+            if (tileElement == nullptr)
+            {
+                continue;
+            }
+            do
+            {
+                if (tileElement->GetType() == TILE_ELEMENT_TYPE_PATH && !tileElement->AsPath()->IsQueue()
+                    && !tileElement->AsPath()->IsSloped())
+                {
+                    tiles.emplace_back(x, y, tileElement->base_height);
+                    break;
+                }
+            } while (!(tileElement++)->IsLastForTile());
+        }
+    }
+    return tiles;
+}
+
+static void report_search_counters(
+    benchmark::State& state, int64_t numSearches, std::chrono::duration<double> searchTime, uint64_t tilesExpanded)
+{
+    state.SetItemsProcessed(numSearches);
+    if (numSearches > 0)
+    {
+        state.counters["ns_per_search"] = std::chrono::duration<double, std::nano>(searchTime).count() / numSearches;
+        state.counters["tiles_per_search"] = static_cast<double>(tilesExpanded) / numSearches;
+    }
+}
+
+/**
+ * Runs peep_pathfind_choose_direction for a fixed set of start and goal pairs on the footpaths of the park.
+ */
+static void BM_pathfind_choose_direction(benchmark::State& state, const CreatePark& createPark)
+{
+    if (!createPark())
+    {
+        state.SkipWithError("Failed to load park!");
+        return;
+    }
+
+    auto pathTiles = get_path_tiles();
+    if (pathTiles.size() < 2)
+    {
+        state.SkipWithError("The park has no footpaths to search.");
+        return;
+    }
+
+    std::mt19937 rng(0);
+    std::vector<std::pair<TileCoordsXYZ, TileCoordsXYZ>> searches(NumSearches);
+    for (auto& [start, goal] : searches)
+    {
+        start = pathTiles[rng() % pathTiles.size()];
+        goal = pathTiles[rng() % pathTiles.size()];
+    }
+
+    scenario_rand_seed(0x12345678, 0x87654321);
+    Peep* peep = Peep::Generate(searches[0].first.ToCoordsXYZ().ToTileCentre());
+    if (peep == nullptr)
+    {
+        state.SkipWithError("Unable to create a guest.");
+        return;
+    }
+    peep->OutsideOfPark = false;
+    gPeepPathFindIgnoreForeignQueues = true;
+    gPeepPathFindQueueRideIndex = RIDE_ID_NULL;
+
+    std::chrono::duration<double> searchTime{};
+    const auto tilesExpandedAtStart = peep_pathfind_get_tiles_expanded_count();
+    for (auto _ : state)
+    {
+        // Results are cached until the footpaths change, every iteration has to do the searches again
+        peep_pathfind_invalidate_cache();
+
+        auto startTime = std::chrono::high_resolution_clock::now();
+        for (const auto& [start, goal] : searches)
+        {
+            peep->ResetPathfindGoal();
+            gPeepPathFindGoalPosition = goal;
+            benchmark::DoNotOptimize(peep_pathfind_choose_direction(start, peep));
+        }
+        searchTime += std::chrono::high_resolution_clock::now() - startTime;
+    }
+    report_search_counters(
+        state, state.iterations() * searches.size(), searchTime,
+        peep_pathfind_get_tiles_expanded_count() - tilesExpandedAtStart);
+    peep->Remove();
+}
+
+/**
+ * Runs guest_path_finding for every guest of the park that is walking, starting each iteration from the state the
+ * guests were in when the park was loaded.
+ */
+static void BM_guest_path_finding(benchmark::State& state, const CreatePark& createPark)
+{
+    if (!createPark())
+    {
+        state.SkipWithError("Failed to load park!");
+        return;
+    }
+
+    std::vector<Guest> guests;
+    for (auto* guest : EntityList<Guest>())
+    {
+        if (guest->State == PeepState::Walking && !guest->OutsideOfPark)
+        {
+            guests.push_back(*guest);
+        }
+    }
+    if (guests.empty())
+    {
+        state.SkipWithError("The park has no walking guests.");
+        return;
+    }
+
+    std::chrono::duration<double> searchTime{};
+    const auto tilesExpandedAtStart = peep_pathfind_get_tiles_expanded_count();
+    for (auto _ : state)
+    {
+        peep_pathfind_invalidate_cache();
+        guest_path_finding_reset_budget();
+        scenario_rand_seed(0x12345678, 0x87654321);
+
+        auto startTime = std::chrono::high_resolution_clock::now();
+        for (const auto& original : guests)
+        {
+            auto* guest = GetEntity<Guest>(original.sprite_index);
+            *guest = original;
+            benchmark::DoNotOptimize(guest_path_finding(guest));
+        }
+        searchTime += std::chrono::high_resolution_clock::now() - startTime;
+    }
+    report_search_counters(
+        state, state.iterations() * guests.size(), searchTime,
+        peep_pathfind_get_tiles_expanded_count() - tilesExpandedAtStart);
+}
+
+static int cmdline_for_bench_pathfinding(int argc, const char** argv)
+{
+    std::pair<const char*, CreatePark> syntheticParks[] = {
+        { "small", create_small_park },
+        { "maze", create_maze_park },
+        { "network", create_network_park },
+    };
+    for (const auto& [name, createPark] : syntheticParks)
+    {
+        benchmark::RegisterBenchmark(
+            (std::string(name) + " (choose_direction)").c_str(), BM_pathfind_choose_direction, createPark);
+    }
+
+    // Google benchmark does stuff to argv. It doesn't modify the pointees,
+    // but it wants to reorder the pointers, so present a copy of them.
+    std::vector<char*> argv_for_benchmark;
+
+    // argv[0] is expected to contain the binary name. It's only for logging purposes, don't bother.
+    argv_for_benchmark.push_back(nullptr);
+
+    // Extract file names from argument list. If there is no such file, consider it benchmark option.
+    for (int i = 0; i < argc; i++)
+    {
+        if (Platform::FileExists(argv[i]))
+        {
+            CreatePark loadPark = [path = std::string(argv[i])] { return _benchContext->LoadParkFromFile(path); };
+            benchmark::RegisterBenchmark(
+                (std::string(argv[i]) + " (choose_direction)").c_str(), BM_pathfind_choose_direction, loadPark);
+            benchmark::RegisterBenchmark(
+                (std::string(argv[i]) + " (guest_path_finding)").c_str(), BM_guest_path_finding, loadPark);
+        }
+        else
+        {
+            argv_for_benchmark.push_back(const_cast<char*>(argv[i]));
+        }
+    }
+    // Update argc with all the changes made
+    argc = static_cast<int>(argv_for_benchmark.size());
+    ::benchmark::Initialize(&argc, &argv_for_benchmark[0]);
+    if (::benchmark::ReportUnrecognizedArguments(argc, &argv_for_benchmark[0]))
+        return -1;
+
+    core_init();
+    gOpenRCT2Headless = true;
+    gOpenRCT2NoGraphics = true;
+
+    // The game state is global, all benchmarks share one context and replace its park
+    _benchContext = CreateContext();
+    if (!_benchContext->Initialise())
+    {
+        log_error("Context initialization failed.");
+        return -1;
+    }
+
+    ::benchmark::RunSpecifiedBenchmarks();
+    _benchContext = nullptr;
+    return 0;
+}
+
+static exitcode_t HandleBenchPathfinding(CommandLineArgEnumerator* argEnumerator)
+{
+    const char** argv = const_cast<const char**>(argEnumerator->GetArguments()) + argEnumerator->GetIndex();
+    int32_t argc = argEnumerator->GetCount() - argEnumerator->GetIndex();
+    int32_t result = cmdline_for_bench_pathfinding(argc, argv);
+    if (result < 0)
+    {
+        return EXITCODE_FAIL;
+    }
+    return EXITCODE_OK;
+}
+
+#else
+static exitcode_t HandleBenchPathfinding(CommandLineArgEnumerator* argEnumerator)
+{
+    log_error("Sorry, Google benchmark not enabled in this build");
+    return EXITCODE_FAIL;
+}
+#endif // USE_BENCHMARK
+
+const CommandLineCommand CommandLine::BenchPathfindingCommands[]{
+#ifdef USE_BENCHMARK
+    DefineCommand(
+        "",
+        "[<file>]... [--benchmark_list_tests={true|false}] [--benchmark_filter=<regex>] [--benchmark_min_time=<min_time>] "
+        "[--benchmark_repetitions=<num_repetitions>] [--benchmark_report_aggregates_only={true|false}] "
+        "[--benchmark_format=<console|json|csv>] [--benchmark_out=<filename>] [--benchmark_out_format=<json|console|csv>] "
+        "[--benchmark_color={auto|true|false}] [--benchmark_counters_tabular={true|false}] [--v=<verbosity>]",
+        nullptr, HandleBenchPathfinding),
+    CommandTableEnd
+#else
+    DefineCommand("", "*** SORRY NOT ENABLED IN THIS BUILD ***", nullptr, HandleBenchPathfinding), CommandTableEnd
+#endif // USE_BENCHMARK
+};
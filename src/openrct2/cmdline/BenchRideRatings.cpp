@@ -0,0 +1,164 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "CommandLine.hpp"
+
+#ifdef USE_BENCHMARK
+
+#    include "../Context.h"
+#    include "../OpenRCT2.h"
+#    include "../platform/Platform2.h"
+#    include "../platform/platform.h"
+#    include "../ride/Ride.h"
+#    include "../ride/RideData.h"
+#    include "../ride/RideRatings.h"
+
+#    include <benchmark/benchmark.h>
+#    include <chrono>
+#    include <cstdint>
+#    include <map>
+#    include <memory>
+#    include <string>
+#    include <vector>
+
+using namespace OpenRCT2;
+
+static std::unique_ptr<IContext> _benchContext;
+
+/**
+ * Rates every ride of the park to completion, one after the other. Unless useProximityCache is set the cached proximity
+ * scores are dropped before every iteration, so each iteration does the full proximity loop of every ride.
+ */
+static void BM_ride_ratings(benchmark::State& state, const std::string& path, bool useProximityCache)
+{
+    if (!_benchContext->LoadParkFromFile(path))
+    {
+        state.SkipWithError("Failed to load park!");
+        return;
+    }
+
+    std::vector<const Ride*> rides;
+    for (const auto& ride : GetRideManager())
+    {
+        rides.push_back(&ride);
+    }
+    if (rides.empty())
+    {
+        state.SkipWithError("The park has no rides.");
+        return;
+    }
+
+    RideRatingsMeasurement total;
+    std::map<uint8_t, std::chrono::duration<double>> timeByRideType;
+    for (auto _ : state)
+    {
+        if (!useProximityCache)
+        {
+            ride_ratings_proximity_cache_invalidate_all();
+        }
+        for (const auto* ride : rides)
+        {
+            auto startTime = std::chrono::high_resolution_clock::now();
+            ride_ratings_update_ride(*ride, &total);
+            timeByRideType[ride->type] += std::chrono::high_resolution_clock::now() - startTime;
+        }
+    }
+
+    const auto iterations = static_cast<double>(state.iterations());
+    state.SetItemsProcessed(state.iterations() * rides.size());
+    state.counters["Proximity_us"] = std::chrono::duration<double, std::micro>(total.ProximityTime).count() / iterations;
+    state.counters["Calculate_us"] = std::chrono::duration<double, std::micro>(total.CalculateTime).count() / iterations;
+    state.counters["StateUpdates"] = total.StateUpdates / iterations;
+    state.counters["TrackPieces"] = total.TrackPieces / iterations;
+    for (const auto& [rideType, time] : timeByRideType)
+    {
+        auto name = std::string(GetRideTypeDescriptor(rideType).EnumName) + "_us";
+        state.counters[name] = std::chrono::duration<double, std::micro>(time).count() / iterations;
+    }
+}
+
+static int cmdline_for_bench_ride_ratings(int argc, const char** argv)
+{
+    // Google benchmark does stuff to argv. It doesn't modify the pointees,
+    // but it wants to reorder the pointers, so present a copy of them.
+    std::vector<char*> argv_for_benchmark;
+
+    // argv[0] is expected to contain the binary name. It's only for logging purposes, don't bother.
+    argv_for_benchmark.push_back(nullptr);
+
+    // Extract file names from argument list. If there is no such file, consider it benchmark option.
+    for (int i = 0; i < argc; i++)
+    {
+        if (Platform::FileExists(argv[i]))
+        {
+            benchmark::RegisterBenchmark((std::string(argv[i]) + " (uncached)").c_str(), BM_ride_ratings, argv[i], false);
+            benchmark::RegisterBenchmark((std::string(argv[i]) + " (cached)").c_str(), BM_ride_ratings, argv[i], true);
+        }
+        else
+        {
+            argv_for_benchmark.push_back(const_cast<char*>(argv[i]));
+        }
+    }
+    // Update argc with all the changes made
+    argc = static_cast<int>(argv_for_benchmark.size());
+    ::benchmark::Initialize(&argc, &argv_for_benchmark[0]);
+    if (::benchmark::ReportUnrecognizedArguments(argc, &argv_for_benchmark[0]))
+        return -1;
+
+    core_init();
+    gOpenRCT2Headless = true;
+    gOpenRCT2NoGraphics = true;
+
+    // The game state is global, all benchmarks share one context and replace its park
+    _benchContext = CreateContext();
+    if (!_benchContext->Initialise())
+    {
+        log_error("Context initialization failed.");
+        return -1;
+    }
+
+    ::benchmark::RunSpecifiedBenchmarks();
+    _benchContext = nullptr;
+    return 0;
+}
+
+static exitcode_t HandleBenchRideRatings(CommandLineArgEnumerator* argEnumerator)
+{
+    const char** argv = const_cast<const char**>(argEnumerator->GetArguments()) + argEnumerator->GetIndex();
+    int32_t argc = argEnumerator->GetCount() - argEnumerator->GetIndex();
+    int32_t result = cmdline_for_bench_ride_ratings(argc, argv);
+    if (result < 0)
+    {
+        return EXITCODE_FAIL;
+    }
+    return EXITCODE_OK;
+}
+
+#else
+static exitcode_t HandleBenchRideRatings(CommandLineArgEnumerator* argEnumerator)
+{
+    log_error("Sorry, Google benchmark not enabled in this build");
+    return EXITCODE_FAIL;
+}
+#endif // USE_BENCHMARK
+
+const CommandLineCommand CommandLine::BenchRideRatingsCommands[]{
+#ifdef USE_BENCHMARK
+    DefineCommand(
+        "",
+        "<file>... [--benchmark_list_tests={true|false}] [--benchmark_filter=<regex>] [--benchmark_min_time=<min_time>] "
+        "[--benchmark_repetitions=<num_repetitions>] [--benchmark_report_aggregates_only={true|false}] "
+        "[--benchmark_format=<console|json|csv>] [--benchmark_out=<filename>] [--benchmark_out_format=<json|console|csv>] "
+        "[--benchmark_color={auto|true|false}] [--benchmark_counters_tabular={true|false}] [--v=<verbosity>]",
+        nullptr, HandleBenchRideRatings),
+    CommandTableEnd
+#else
+    DefineCommand("", "*** SORRY NOT ENABLED IN THIS BUILD ***", nullptr, HandleBenchRideRatings), CommandTableEnd
+#endif // USE_BENCHMARK
+};
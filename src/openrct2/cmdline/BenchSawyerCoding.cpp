@@ -0,0 +1,189 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "CommandLine.hpp"
+
+#ifdef USE_BENCHMARK
+
+#    include "../core/File.h"
+#    include "../core/MemoryStream.h"
+#    include "../platform/Platform2.h"
+#    include "../rct12/SawyerChunkReader.h"
+#    include "../util/SawyerCoding.h"
+
+#    include <algorithm>
+#    include <benchmark/benchmark.h>
+#    include <cstdint>
+#    include <random>
+#    include <string>
+#    include <utility>
+#    include <vector>
+
+// Size of the synthetic chunks, roughly the size of the tile element chunk in a park
+constexpr size_t SyntheticChunkSize = 3 * 1024 * 1024;
+
+/**
+ * Creates data that has both repeated and random runs like the tile elements of a park, so every RLE code path is
+ * exercised.
+ */
+static std::vector<uint8_t> create_synthetic_chunk_data()
+{
+    std::mt19937 rng(0);
+    std::vector<uint8_t> data(SyntheticChunkSize);
+    for (size_t i = 0; i < data.size();)
+    {
+        const size_t runLength = rng() % 48 + 1;
+        const bool isRepeated = (rng() % 2) == 0;
+        const auto value = static_cast<uint8_t>(rng());
+        for (size_t j = 0; j < runLength && i < data.size(); j++, i++)
+        {
+            data[i] = isRepeated ? value : static_cast<uint8_t>(rng());
+        }
+    }
+    return data;
+}
+
+static std::vector<uint8_t> encode_chunk(const std::vector<uint8_t>& data, uint8_t encoding)
+{
+    // The repeat encoding searches back for every byte, keep its input small enough to register quickly
+    sawyercoding_chunk_header header{ encoding, static_cast<uint32_t>(data.size()) };
+    if (encoding == CHUNK_ENCODING_RLECOMPRESSED)
+    {
+        header.length = static_cast<uint32_t>(std::min<size_t>(data.size(), 256 * 1024));
+    }
+    std::vector<uint8_t> encoded(data.size() * 2 + sizeof(sawyercoding_chunk_header));
+    encoded.resize(sawyercoding_write_chunk_buffer(encoded.data(), data.data(), header));
+    return encoded;
+}
+
+// Reads every chunk in the buffer, the four byte checksum of a park file at the end is left out. Returns the number of
+// decoded bytes.
+static size_t read_chunks(const std::vector<uint8_t>& encoded)
+{
+    size_t bytesDecoded = 0;
+    OpenRCT2::MemoryStream stream(encoded.data(), encoded.size());
+    SawyerChunkReader reader(&stream);
+    while (stream.GetLength() - stream.GetPosition() > sizeof(sawyercoding_chunk_header) + 4)
+    {
+        auto chunk = reader.ReadChunk();
+        bytesDecoded += chunk->GetLength();
+        benchmark::DoNotOptimize(chunk->GetData());
+    }
+    return bytesDecoded;
+}
+
+static void BM_sawyer_read_chunks(benchmark::State& state, const std::vector<uint8_t> encoded)
+{
+    int64_t bytesDecoded = 0;
+    for (auto _ : state)
+    {
+        bytesDecoded += read_chunks(encoded);
+    }
+    state.SetBytesProcessed(bytesDecoded);
+}
+
+static void BM_sawyer_checksum(benchmark::State& state, const std::vector<uint8_t> data)
+{
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(sawyercoding_calculate_checksum(data.data(), data.size()));
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(data.size()));
+}
+
+static int cmdline_for_bench_sawyer_coding(int argc, const char** argv)
+{
+    {
+        auto data = create_synthetic_chunk_data();
+        std::pair<const char*, uint8_t> encodings[] = {
+            { "decode/none", CHUNK_ENCODING_NONE },
+            { "decode/rle", CHUNK_ENCODING_RLE },
+            { "decode/rlecompressed", CHUNK_ENCODING_RLECOMPRESSED },
+            { "decode/rotate", CHUNK_ENCODING_ROTATE },
+        };
+        for (const auto& [name, encoding] : encodings)
+        {
+            benchmark::RegisterBenchmark(name, BM_sawyer_read_chunks, encode_chunk(data, encoding));
+        }
+        benchmark::RegisterBenchmark("checksum", BM_sawyer_checksum, data);
+    }
+
+    // Google benchmark does stuff to argv. It doesn't modify the pointees,
+    // but it wants to reorder the pointers, so present a copy of them.
+    std::vector<char*> argv_for_benchmark;
+
+    // argv[0] is expected to contain the binary name. It's only for logging purposes, don't bother.
+    argv_for_benchmark.push_back(nullptr);
+
+    // Extract file names from argument list. If there is no such file, consider it benchmark option.
+    for (int i = 0; i < argc; i++)
+    {
+        if (Platform::FileExists(argv[i]))
+        {
+            auto data = File::ReadAllBytes(argv[i]);
+            try
+            {
+                read_chunks(data);
+            }
+            catch (const std::exception& e)
+            {
+                log_error("Unable to decode %s: %s", argv[i], e.what());
+                continue;
+            }
+            benchmark::RegisterBenchmark((std::string(argv[i]) + " (decode)").c_str(), BM_sawyer_read_chunks, data);
+            benchmark::RegisterBenchmark((std::string(argv[i]) + " (checksum)").c_str(), BM_sawyer_checksum, data);
+        }
+        else
+        {
+            argv_for_benchmark.push_back(const_cast<char*>(argv[i]));
+        }
+    }
+    // Update argc with all the changes made
+    argc = static_cast<int>(argv_for_benchmark.size());
+    ::benchmark::Initialize(&argc, &argv_for_benchmark[0]);
+    if (::benchmark::ReportUnrecognizedArguments(argc, &argv_for_benchmark[0]))
+        return -1;
+    ::benchmark::RunSpecifiedBenchmarks();
+    return 0;
+}
+
+static exitcode_t HandleBenchSawyerCoding(CommandLineArgEnumerator* argEnumerator)
+{
+    const char** argv = const_cast<const char**>(argEnumerator->GetArguments()) + argEnumerator->GetIndex();
+    int32_t argc = argEnumerator->GetCount() - argEnumerator->GetIndex();
+    int32_t result = cmdline_for_bench_sawyer_coding(argc, argv);
+    if (result < 0)
+    {
+        return EXITCODE_FAIL;
+    }
+    return EXITCODE_OK;
+}
+
+#else
+static exitcode_t HandleBenchSawyerCoding(CommandLineArgEnumerator* argEnumerator)
+{
+    log_error("Sorry, Google benchmark not enabled in this build");
+    return EXITCODE_FAIL;
+}
+#endif // USE_BENCHMARK
+
+const CommandLineCommand CommandLine::BenchSawyerCodingCommands[]{
+#ifdef USE_BENCHMARK
+    DefineCommand(
+        "",
+        "[<file>]... [--benchmark_list_tests={true|false}] [--benchmark_filter=<regex>] [--benchmark_min_time=<min_time>] "
+        "[--benchmark_repetitions=<num_repetitions>] [--benchmark_report_aggregates_only={true|false}] "
+        "[--benchmark_format=<console|json|csv>] [--benchmark_out=<filename>] [--benchmark_out_format=<json|console|csv>] "
+        "[--benchmark_color={auto|true|false}] [--benchmark_counters_tabular={true|false}] [--v=<verbosity>]",
+        nullptr, HandleBenchSawyerCoding),
+    CommandTableEnd
+#else
+    DefineCommand("", "*** SORRY NOT ENABLED IN THIS BUILD ***", nullptr, HandleBenchSawyerCoding), CommandTableEnd
+#endif // USE_BENCHMARK
+};
@@ -32,12 +32,16 @@
 #    include <benchmark/benchmark.h>
 #    include <cstdint>
 #    include <iterator>
+#    include <string>
+#    include <utility>
 #    include <vector>
 
-static void fixup_pointers(paint_session* s, size_t paint_session_entries, size_t paint_struct_entries, size_t quadrant_entries)
+static void fixup_pointers(paint_session* s, size_t paint_session_entries, size_t quadrant_entries)
 {
     for (size_t i = 0; i < paint_session_entries; i++)
     {
+        // Each session is recorded with its own number of paint structs, which also marks a null pointer
+        const size_t paint_struct_entries = std::size(s[i].PaintStructs);
         for (size_t j = 0; j < paint_struct_entries; j++)
         {
             if (s[i].PaintStructs[j].basic.next_quadrant_ps == reinterpret_cast<paint_struct*>(paint_struct_entries))
@@ -132,30 +136,106 @@ static std::vector<paint_session> extract_paint_session(const std::string parkFi
     return sessions;
 }
 
+// Checks that PaintSessionArrange() draws the paint structs of every session in the same order as the reference sort.
+static bool check_paint_session_arrange(const std::vector<paint_session>& inputSessions)
+{
+    std::vector<paint_session> sessions = inputSessions;
+    std::vector<paint_session> referenceSessions = inputSessions;
+    const size_t quadrantEntries = std::size(sessions[0].Quadrants);
+    fixup_pointers(&sessions[0], std::size(sessions), quadrantEntries);
+    fixup_pointers(&referenceSessions[0], std::size(referenceSessions), quadrantEntries);
+
+    for (size_t i = 0; i < std::size(sessions); i++)
+    {
+        PaintSessionArrange(&sessions[i]);
+        PaintSessionArrangeReference(&referenceSessions[i]);
+
+        // The structs are compared by their index in the session as each session has its own copy
+        auto getOffset = [](const paint_session& session, const paint_struct* ps) {
+            return session.PaintStructs.index_of(reinterpret_cast<const paint_entry*>(ps));
+        };
+        const paint_struct* ps = sessions[i].PaintHead.next_quadrant_ps;
+        const paint_struct* referencePs = referenceSessions[i].PaintHead.next_quadrant_ps;
+        for (; ps != nullptr && referencePs != nullptr; ps = ps->next_quadrant_ps, referencePs = referencePs->next_quadrant_ps)
+        {
+            if (getOffset(sessions[i], ps) != getOffset(referenceSessions[i], referencePs))
+                return false;
+        }
+        if (ps != nullptr || referencePs != nullptr)
+            return false;
+    }
+    return true;
+}
+
 // This function is based on benchgfx_render_screenshots
-static void BM_paint_session_arrange(benchmark::State& state, const std::vector<paint_session> inputSessions)
+static void BM_paint_session_arrange(
+    benchmark::State& state, const std::vector<paint_session> inputSessions, void (*arrangeFn)(paint_session*))
 {
     std::vector<paint_session> sessions = inputSessions;
     // Fixing up the pointers continuously is wasteful. Fix it up once for `sessions` and store a copy.
     // Keep in mind we need bit-exact copy, as the lists use pointers.
     // Once sorted, just restore the copy with the original fixed-up version.
     paint_session* local_s = new paint_session[std::size(sessions)];
-    fixup_pointers(&sessions[0], std::size(sessions), std::size(local_s->PaintStructs), std::size(local_s->Quadrants));
+    fixup_pointers(&sessions[0], std::size(sessions), std::size(local_s->Quadrants));
     std::copy_n(sessions.cbegin(), std::size(sessions), local_s);
     for (auto _ : state)
     {
         state.PauseTiming();
         std::copy_n(local_s, std::size(sessions), sessions.begin());
         state.ResumeTiming();
-        PaintSessionArrange(&sessions[0]);
+        arrangeFn(&sessions[0]);
         benchmark::DoNotOptimize(sessions);
     }
     state.SetItemsProcessed(state.iterations() * std::size(sessions));
     delete[] local_s;
 }
 
+using RLEMinifyCopyFn = void (*)(const uint8_t*, uint8_t*, int32_t, int32_t);
+
+// Samples runs of synthetic RLE sprite pixels the way DrawRLESpriteMinify does, with every 7th pixel transparent.
+static void BM_rle_minify_copy(benchmark::State& state, RLEMinifyCopyFn copyFn, int32_t zoomLevel)
+{
+    constexpr int32_t RunLength = 256;
+    constexpr int32_t NumRuns = 1024;
+    std::vector<uint8_t> src(RunLength * NumRuns);
+    for (size_t i = 0; i < src.size(); i++)
+    {
+        src[i] = (i % 7 == 0) ? 0 : static_cast<uint8_t>(i % 200 + 10);
+    }
+    std::vector<uint8_t> dst(src.size() >> zoomLevel);
+    for (auto _ : state)
+    {
+        for (int32_t run = 0; run < NumRuns; run++)
+        {
+            copyFn(&src[run * RunLength], &dst[(run * RunLength) >> zoomLevel], RunLength, zoomLevel);
+        }
+        benchmark::DoNotOptimize(dst);
+    }
+    state.SetItemsProcessed(state.iterations() * NumRuns);
+}
+
+static void register_rle_minify_benchmarks()
+{
+    std::vector<std::pair<std::string, RLEMinifyCopyFn>> copyFns = { { "scalar", rle_minify_copy_scalar } };
+    if (sse41_available())
+        copyFns.emplace_back("sse4.1", rle_minify_copy_sse4_1);
+    if (avx2_available())
+        copyFns.emplace_back("avx2", rle_minify_copy_avx2);
+
+    for (int32_t zoomLevel = 1; zoomLevel <= 3; zoomLevel++)
+    {
+        for (const auto& [name, copyFn] : copyFns)
+        {
+            auto benchmarkName = "rle_minify_copy/zoom" + std::to_string(zoomLevel) + "/" + name;
+            benchmark::RegisterBenchmark(benchmarkName.c_str(), BM_rle_minify_copy, copyFn, zoomLevel);
+        }
+    }
+}
+
 static int cmdline_for_bench_sprite_sort(int argc, const char** argv)
 {
+    register_rle_minify_benchmarks();
+
     {
         // Register some basic "baseline" benchmark
         std::vector<paint_session> sessions(1);
@@ -167,7 +247,7 @@ static int cmdline_for_bench_sprite_sort(int argc, const char** argv)
         {
             quad = reinterpret_cast<paint_struct*>((std::size(sessions[0].Quadrants)));
         }
-        benchmark::RegisterBenchmark("baseline", BM_paint_session_arrange, sessions);
+        benchmark::RegisterBenchmark("baseline", BM_paint_session_arrange, sessions, PaintSessionArrange);
     }
 
     // Google benchmark does stuff to argv. It doesn't modify the pointees,
@@ -185,7 +265,20 @@ static int cmdline_for_bench_sprite_sort(int argc, const char** argv)
             // Register benchmark for sv6 if valid
             std::vector<paint_session> sessions = extract_paint_session(argv[i]);
             if (!sessions.empty())
-                benchmark::RegisterBenchmark(argv[i], BM_paint_session_arrange, sessions);
+            {
+                if (check_paint_session_arrange(sessions))
+                {
+                    log_info("Sprite order of %s matches the reference sort.", argv[i]);
+                }
+                else
+                {
+                    log_error("Sprite order of %s differs from the reference sort!", argv[i]);
+                }
+                benchmark::RegisterBenchmark(argv[i], BM_paint_session_arrange, sessions, PaintSessionArrange);
+                benchmark::RegisterBenchmark(
+                    (std::string(argv[i]) + " (reference)").c_str(), BM_paint_session_arrange, sessions,
+                    PaintSessionArrangeReference);
+            }
         }
         else
         {
@@ -0,0 +1,287 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "../core/Console.hpp"
+#include "../core/File.h"
+#include "../core/Json.hpp"
+#include "../core/Path.hpp"
+#include "../core/String.hpp"
+#include "../platform/Platform2.h"
+#include "CommandLine.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+static exitcode_t HandleBenchSuiteRun(CommandLineArgEnumerator* argEnumerator);
+static exitcode_t HandleBenchSuiteCompare(CommandLineArgEnumerator* argEnumerator);
+
+// clang-format off
+const CommandLineCommand CommandLine::BenchSuiteCommands[]
+{
+    // Main commands
+    DefineCommand("run",     "<results-file> <sv6-file> [...]",                  nullptr, HandleBenchSuiteRun    ),
+    DefineCommand("compare", "<results-file> <baseline-file> [threshold-percent]", nullptr, HandleBenchSuiteCompare),
+    CommandTableEnd
+};
+// clang-format on
+
+// Bumped whenever the benchmarks of the suite change in a way that makes older results incomparable
+static constexpr int32_t BenchSuiteResultsVersion = 1;
+
+static constexpr double DefaultThresholdPercent = 10.0;
+
+#ifdef USE_BENCHMARK
+
+struct SuiteBenchmark
+{
+    const char* Name;
+    const char* Command;
+};
+
+// The Google benchmark commands of the suite, each is given every park
+static constexpr SuiteBenchmark SuiteBenchmarks[] = {
+    { "update", "benchsimulate" },
+    { "spritesort", "benchspritesort" },
+    { "ratings", "benchrideratings" },
+    { "pathfinding", "benchpathfinding" },
+};
+
+// Repetitions of each Google benchmark, the median of them is recorded
+static constexpr int32_t SuiteRepetitions = 3;
+
+// Iterations of each zoom level and rotation of the gfx benchmark
+static constexpr int32_t SuiteGfxIterations = 3;
+
+/**
+ * Benchmark names contain the paths of the parks, only their file names are kept so the results of checkouts in
+ * different directories can be compared.
+ */
+static std::string get_stable_name(std::string name, const std::vector<std::string>& parks)
+{
+    for (const auto& park : parks)
+    {
+        auto fileName = Path::GetFileName(park);
+        for (auto pos = name.find(park); pos != std::string::npos; pos = name.find(park, pos + fileName.size()))
+        {
+            name.replace(pos, park.size(), fileName);
+        }
+    }
+    return name;
+}
+
+static double get_nanoseconds(double time, const std::string& unit)
+{
+    if (unit == "us")
+        return time * 1000.0;
+    if (unit == "ms")
+        return time * 1000000.0;
+    if (unit == "s")
+        return time * 1000000000.0;
+    return time;
+}
+
+/**
+ * Runs the benchmark command in a separate process as the game state is global, and adds the median time of each of
+ * its benchmarks to the results.
+ */
+static bool run_google_benchmark(
+    const std::string& exePath, const SuiteBenchmark& benchmark, const std::vector<std::string>& parks,
+    const std::string& outputPath, json_t& results)
+{
+    auto command = String::StdFormat(
+        "%s %s --benchmark_repetitions=%d --benchmark_report_aggregates_only=true --benchmark_out_format=json %s",
+        Platform::QuoteArgument(exePath).c_str(), benchmark.Command, SuiteRepetitions,
+        Platform::QuoteArgument("--benchmark_out=" + outputPath).c_str());
+    for (const auto& park : parks)
+    {
+        command += " " + Platform::QuoteArgument(park);
+    }
+
+    std::string output;
+    Platform::Execute(command, &output);
+    if (!File::Exists(outputPath))
+    {
+        Console::Error::WriteLine("%s did not write any results.", benchmark.Command);
+        return false;
+    }
+
+    auto jsonOutput = Json::ReadFromFile(outputPath.c_str());
+    File::Delete(outputPath);
+    for (const auto& entry : Json::AsArray(jsonOutput["benchmarks"]))
+    {
+        if (Json::GetString(entry["aggregate_name"]) != "median")
+            continue;
+
+        auto name = std::string(benchmark.Name) + "/" + get_stable_name(Json::GetString(entry["run_name"]), parks);
+        results[name] = get_nanoseconds(Json::GetNumber<double>(entry["real_time"]), Json::GetString(entry["time_unit"]));
+    }
+    return true;
+}
+
+/**
+ * The gfx benchmark renders the whole park at every zoom level and rotation and prints the average time of a render.
+ */
+static bool run_gfx_benchmark(const std::string& exePath, const std::string& park, json_t& results)
+{
+    auto command = String::StdFormat(
+        "%s benchgfx %s %d", Platform::QuoteArgument(exePath).c_str(), Platform::QuoteArgument(park).c_str(),
+        SuiteGfxIterations);
+    std::string output;
+    Platform::Execute(command, &output);
+
+    static constexpr const char* AveragePrefix = "Total average: ";
+    auto pos = output.find(AveragePrefix);
+    if (pos == std::string::npos)
+    {
+        Console::Error::WriteLine("benchgfx did not report a time for %s.", park.c_str());
+        return false;
+    }
+    auto seconds = std::strtod(output.c_str() + pos + String::LengthOf(AveragePrefix), nullptr);
+    results["gfx/" + Path::GetFileName(park)] = get_nanoseconds(seconds, "s");
+    return true;
+}
+
+/**
+ * Runs every benchmark of the suite with the given parks and writes the time of each benchmark in nanoseconds. The
+ * results are keyed by benchmark name, so they are written in a stable order that diffs well.
+ */
+static exitcode_t HandleBenchSuiteRun(CommandLineArgEnumerator* argEnumerator)
+{
+    const char** argv = const_cast<const char**>(argEnumerator->GetArguments()) + argEnumerator->GetIndex();
+    int32_t argc = argEnumerator->GetCount() - argEnumerator->GetIndex();
+
+    if (argc < 2)
+    {
+        Console::Error::WriteLine("Missing arguments <results-file> <sv6-file> [...].");
+        return EXITCODE_FAIL;
+    }
+
+    std::string resultsPath = argv[0];
+    std::vector<std::string> parks;
+    for (int32_t i = 1; i < argc; i++)
+    {
+        if (!File::Exists(argv[i]))
+        {
+            Console::Error::WriteLine("Park %s does not exist.", argv[i]);
+            return EXITCODE_FAIL;
+        }
+        parks.push_back(Path::GetAbsolute(argv[i]));
+    }
+
+    auto exePath = Platform::GetCurrentExecutablePath();
+    auto outputPath = resultsPath + ".tmp";
+    json_t results = json_t::object();
+    bool allRan = true;
+    for (const auto& benchmark : SuiteBenchmarks)
+    {
+        Console::WriteLine("Running %s...", benchmark.Command);
+        allRan &= run_google_benchmark(exePath, benchmark, parks, outputPath, results);
+    }
+    Console::WriteLine("Running benchgfx...");
+    for (const auto& park : parks)
+    {
+        allRan &= run_gfx_benchmark(exePath, park, results);
+    }
+
+    json_t jsonResults = {
+        { "version", BenchSuiteResultsVersion },
+        { "benchmarks", results },
+    };
+    Json::WriteToFile(resultsPath.c_str(), jsonResults);
+    Console::WriteLine("Wrote %zu results to %s", results.size(), resultsPath.c_str());
+    return allRan ? EXITCODE_OK : EXITCODE_FAIL;
+}
+
+#else
+
+static exitcode_t HandleBenchSuiteRun(CommandLineArgEnumerator* argEnumerator)
+{
+    Console::Error::WriteLine("Sorry, Google benchmark not enabled in this build");
+    return EXITCODE_FAIL;
+}
+
+#endif // USE_BENCHMARK
+
+/**
+ * Compares the results to the baseline, a benchmark regresses when it takes more than the threshold percentage longer
+ * than in the baseline. Benchmarks that only exist in one of the files are listed but do not fail the comparison.
+ */
+static exitcode_t HandleBenchSuiteCompare(CommandLineArgEnumerator* argEnumerator)
+{
+    const char** argv = const_cast<const char**>(argEnumerator->GetArguments()) + argEnumerator->GetIndex();
+    int32_t argc = argEnumerator->GetCount() - argEnumerator->GetIndex();
+
+    if (argc < 2)
+    {
+        Console::Error::WriteLine("Missing arguments <results-file> <baseline-file> [threshold-percent].");
+        return EXITCODE_FAIL;
+    }
+    if (!File::Exists(argv[1]))
+    {
+        Console::Error::WriteLine("No baseline at %s, use the results of a reference build as the baseline.", argv[1]);
+        return EXITCODE_FAIL;
+    }
+    double thresholdPercent = argc >= 3 ? std::atof(argv[2]) : DefaultThresholdPercent;
+
+    json_t jsonResults;
+    json_t jsonBaseline;
+    try
+    {
+        jsonResults = Json::ReadFromFile(argv[0]);
+        jsonBaseline = Json::ReadFromFile(argv[1]);
+    }
+    catch (const std::exception& e)
+    {
+        Console::Error::WriteLine("%s", e.what());
+        return EXITCODE_FAIL;
+    }
+    if (Json::GetNumber<int32_t>(jsonResults["version"]) != Json::GetNumber<int32_t>(jsonBaseline["version"]))
+    {
+        Console::Error::WriteLine("The results and the baseline are of different versions of the benchmark suite.");
+        return EXITCODE_FAIL;
+    }
+
+    auto results = Json::AsObject(jsonResults["benchmarks"]);
+    auto baseline = Json::AsObject(jsonBaseline["benchmarks"]);
+    uint32_t numRegressions = 0;
+    for (const auto& [name, baselineTime] : baseline.items())
+    {
+        auto it = results.find(name);
+        if (it == results.end())
+        {
+            Console::WriteLine("%s: missing", name.c_str());
+            continue;
+        }
+
+        auto before = Json::GetNumber<double>(baselineTime);
+        auto after = Json::GetNumber<double>(*it);
+        auto changePercent = before > 0 ? (after - before) * 100.0 / before : 0.0;
+        bool regressed = changePercent > thresholdPercent;
+        numRegressions += regressed ? 1 : 0;
+        Console::WriteLine(
+            "%s: %.0f ns -> %.0f ns (%+.1f%%)%s", name.c_str(), before, after, changePercent, regressed ? " REGRESSED" : "");
+    }
+    for (const auto& [name, time] : results.items())
+    {
+        if (!baseline.contains(name))
+        {
+            Console::WriteLine("%s: %.0f ns (new)", name.c_str(), Json::GetNumber<double>(time));
+        }
+    }
+
+    if (numRegressions != 0)
+    {
+        Console::Error::WriteLine("%u benchmarks regressed by more than %.1f%%.", numRegressions, thresholdPercent);
+        return EXITCODE_FAIL;
+    }
+    Console::WriteLine("No benchmark regressed by more than %.1f%%.", thresholdPercent);
+    return EXITCODE_OK;
+}
@@ -14,10 +14,14 @@
 #    include "../Context.h"
 #    include "../GameState.h"
 #    include "../OpenRCT2.h"
+#    include "../core/Allocations.h"
+#    include "../peep/GuestPathfinding.h"
 #    include "../platform/Platform2.h"
 #    include "../platform/platform.h"
 
+#    include <algorithm>
 #    include <benchmark/benchmark.h>
+#    include <chrono>
 #    include <cstdint>
 #    include <iterator>
 #    include <numeric>
@@ -25,6 +29,16 @@
 
 using namespace OpenRCT2;
 
+static double GetTickPercentile(const std::vector<double>& sortedTickTimes, double percentile)
+{
+    if (sortedTickTimes.empty())
+    {
+        return 0;
+    }
+    auto index = static_cast<size_t>(percentile * (sortedTickTimes.size() - 1));
+    return sortedTickTimes[index];
+}
+
 static void BM_update(benchmark::State& state, const std::string& filename)
 {
     std::unique_ptr<IContext> context(CreateContext());
@@ -35,9 +49,13 @@ static void BM_update(benchmark::State& state, const std::string& filename)
             state.SkipWithError("Failed to load file!");
         }
 
+        const auto deferredAtStart = guest_path_finding_get_deferred_count();
         std::vector<LogicTimings> timings(1);
         timings.reserve(100);
+        std::vector<double> tickTimes;
+        tickTimes.reserve(10000);
         int currentTimingIdx = 0;
+        const auto allocationsAtStart = Allocations::GetCount();
         for (auto _ : state)
         {
             if (timings[currentTimingIdx].CurrentIdx == (LOGIC_UPDATE_MEASUREMENTS_COUNT - 1))
@@ -46,18 +64,39 @@ static void BM_update(benchmark::State& state, const std::string& filename)
                 currentTimingIdx++;
             }
             LogicTimings* timingToUse = &timings[currentTimingIdx];
+            auto tickStartTime = std::chrono::steady_clock::now();
             context->GetGameState()->UpdateLogic(timingToUse);
+            tickTimes.push_back(
+                std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - tickStartTime).count());
         }
+        const auto numAllocations = Allocations::GetCount() - allocationsAtStart;
         state.SetItemsProcessed(state.iterations());
-        auto accumulator = [timings](LogicTimePart part) -> double {
-            std::chrono::duration<double> timesum;
+        auto accumulator = [&timings](LogicTimePart part) -> double {
+            std::chrono::duration<double> timesum{};
             for (const auto& timing : timings)
             {
-                timesum = std::accumulate(
-                    timing.TimingInfo.at(part).begin(), timing.TimingInfo.at(part).end(), std::chrono::duration<double>());
+                auto it = timing.TimingInfo.find(part);
+                if (it != timing.TimingInfo.end())
+                {
+                    timesum = std::accumulate(it->second.begin(), it->second.end(), timesum);
+                }
             }
-            return std::chrono::duration_cast<std::chrono::milliseconds>(timesum).count();
+            return std::chrono::duration<double, std::milli>(timesum).count();
         };
+        LogicCounters counters;
+        for (const auto& timing : timings)
+        {
+            counters.GuestsUpdated += timing.Counters.GuestsUpdated;
+            counters.StaffUpdated += timing.Counters.StaffUpdated;
+            counters.GuestTime += timing.Counters.GuestTime;
+            counters.StaffTime += timing.Counters.StaffTime;
+            counters.PathfindCalls += timing.Counters.PathfindCalls;
+            counters.PathfindTime += timing.Counters.PathfindTime;
+            counters.RideRatingsSteps += timing.Counters.RideRatingsSteps;
+            counters.TilesUpdated += timing.Counters.TilesUpdated;
+            counters.TrainsUpdated += timing.Counters.TrainsUpdated;
+        }
+        std::sort(tickTimes.begin(), tickTimes.end());
         state.counters["NetworkUpdateAcc_ms"] = accumulator(LogicTimePart::NetworkUpdate);
         state.counters["DateAcc_ms"] = accumulator(LogicTimePart::Date);
         state.counters["ScenarioAcc_ms"] = accumulator(LogicTimePart::Scenario);
@@ -80,6 +119,21 @@ static void BM_update(benchmark::State& state, const std::string& filename)
         state.counters["GameActionsAcc_ms"] = accumulator(LogicTimePart::GameActions);
         state.counters["NetworkFlushAcc_ms"] = accumulator(LogicTimePart::NetworkFlush);
         state.counters["ScriptsAcc_ms"] = accumulator(LogicTimePart::Scripts);
+        state.counters["PathfindDeferred"] = guest_path_finding_get_deferred_count() - deferredAtStart;
+        state.counters["Guests_ms"] = std::chrono::duration<double, std::milli>(counters.GuestTime).count();
+        state.counters["Staff_ms"] = std::chrono::duration<double, std::milli>(counters.StaffTime).count();
+        state.counters["GuestsUpdated"] = counters.GuestsUpdated;
+        state.counters["StaffUpdated"] = counters.StaffUpdated;
+        state.counters["PathfindCalls"] = counters.PathfindCalls;
+        state.counters["Pathfind_ms"] = std::chrono::duration<double, std::milli>(counters.PathfindTime).count();
+        state.counters["RideRatingsSteps"] = counters.RideRatingsSteps;
+        state.counters["TilesUpdated"] = counters.TilesUpdated;
+        state.counters["TrainsUpdated"] = counters.TrainsUpdated;
+        state.counters["Allocations"] = static_cast<double>(numAllocations);
+        state.counters["TickP50_us"] = GetTickPercentile(tickTimes, 0.50);
+        state.counters["TickP90_us"] = GetTickPercentile(tickTimes, 0.90);
+        state.counters["TickP99_us"] = GetTickPercentile(tickTimes, 0.99);
+        state.counters["TickMax_us"] = tickTimes.empty() ? 0 : tickTimes.back();
     }
     else
     {
@@ -116,10 +116,18 @@ namespace CommandLine
     extern const CommandLineCommand RootCommands[];
     extern const CommandLineCommand ScreenshotCommands[];
     extern const CommandLineCommand SpriteCommands[];
+    extern const CommandLineCommand BenchFormattingCommands[];
     extern const CommandLineCommand BenchGfxCommands[];
+    extern const CommandLineCommand BenchPaintCommands[];
+    extern const CommandLineCommand BenchPathfindingCommands[];
+    extern const CommandLineCommand BenchRideRatingsCommands[];
+    extern const CommandLineCommand BenchSawyerCodingCommands[];
     extern const CommandLineCommand BenchSpriteSortCommands[];
     extern const CommandLineCommand BenchUpdateCommands[];
+    extern const CommandLineCommand BenchSuiteCommands[];
     extern const CommandLineCommand SimulateCommands[];
+    extern const CommandLineCommand ReplayCommands[];
+    extern const CommandLineCommand LoadTestCommands[];
 
     extern const CommandLineExample RootExamples[];
 
@@ -127,5 +135,6 @@ namespace CommandLine
     exitcode_t HandleCommandDefault();
 
     exitcode_t HandleCommandConvert(CommandLineArgEnumerator* enumerator);
+    exitcode_t HandleCommandConvertBatch(CommandLineArgEnumerator* enumerator);
     exitcode_t HandleCommandUri(CommandLineArgEnumerator* enumerator);
 } // namespace CommandLine
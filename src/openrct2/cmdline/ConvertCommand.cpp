@@ -7,18 +7,40 @@
  * OpenRCT2 is licensed under the GNU General Public License version 3.
  *****************************************************************************/
 
+#include "../Context.h"
 #include "../FileClassifier.h"
 #include "../OpenRCT2.h"
 #include "../ParkImporter.h"
 #include "../common.h"
 #include "../core/Console.hpp"
+#include "../core/File.h"
+#include "../core/FileScanner.h"
 #include "../core/Path.hpp"
+#include "../core/String.hpp"
 #include "../interface/Window.h"
+#include "../object/ObjectManager.h"
+#include "../platform/Platform2.h"
+#include "../platform/platform.h"
 #include "../rct2/S6Exporter.h"
+#include "../scenario/Scenario.h"
 #include "CommandLine.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
 #include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
 
+using namespace OpenRCT2;
+
+static const utf8* GetConversionError(uint32_t sourceFileType, uint32_t destinationFileType);
+static void ConvertPark(
+    const utf8* sourcePath, uint32_t sourceFileType, const utf8* destinationPath, uint32_t destinationFileType,
+    IObjectManager* objectManager);
 static void WriteConvertFromAndToMessage(uint32_t sourceFileType, uint32_t destinationFileType);
 static const utf8* GetFileTypeFriendlyName(uint32_t fileType);
 
@@ -54,12 +76,316 @@ exitcode_t CommandLine::HandleCommandConvert(CommandLineArgEnumerator* enumerato
     Path::GetAbsolute(destinationPath, sizeof(sourcePath), rawDestinationPath);
     uint32_t destinationFileType = get_file_extension_type(destinationPath);
 
-    // Validate target type
-    if (destinationFileType != FILE_EXTENSION_SC6 && destinationFileType != FILE_EXTENSION_SV6)
+    const utf8* error = GetConversionError(sourceFileType, destinationFileType);
+    if (error != nullptr)
+    {
+        Console::Error::WriteLine(error);
+        return EXITCODE_FAIL;
+    }
+
+    // Perform conversion
+    WriteConvertFromAndToMessage(sourceFileType, destinationFileType);
+
+    gOpenRCT2Headless = true;
+
+    try
+    {
+        ConvertPark(sourcePath, sourceFileType, destinationPath, destinationFileType, nullptr);
+    }
+    catch (const std::exception& ex)
+    {
+        Console::Error::WriteLine(ex.what());
+        return EXITCODE_FAIL;
+    }
+
+    Console::WriteLine("Conversion successful!");
+    return EXITCODE_OK;
+}
+
+struct BatchConvertResult
+{
+    bool Converted = false;
+    double Seconds = 0;
+    std::string Error;
+};
+
+/**
+ * A directory is converted with all the parks directly in it, any other file is a manifest with the path of a park on
+ * each line.
+ */
+static std::vector<std::string> GetBatchSourcePaths(const std::string& source)
+{
+    std::vector<std::string> paths;
+    if (Path::DirectoryExists(source))
+    {
+        auto scanner = std::unique_ptr<IFileScanner>(
+            Path::ScanDirectory(Path::Combine(source, "*.sc4;*.sv4;*.sc6;*.sv6;*.park"), false));
+        while (scanner->Next())
+        {
+            paths.push_back(scanner->GetPath());
+        }
+        std::sort(paths.begin(), paths.end());
+    }
+    else
+    {
+        for (const auto& line : File::ReadAllLines(source))
+        {
+            auto path = String::Trim(line);
+            if (!path.empty() && path[0] != '#')
+            {
+                paths.push_back(Path::GetAbsolute(path));
+            }
+        }
+    }
+    return paths;
+}
+
+static std::string GetBatchDestinationPath(
+    const std::string& sourcePath, const std::string& destinationDirectory, const std::string& destinationExtension)
+{
+    return Path::Combine(destinationDirectory, Path::GetFileNameWithoutExtension(sourcePath) + "." + destinationExtension);
+}
+
+static void WriteBatchConvertResult(const std::string& sourcePath, const BatchConvertResult& result)
+{
+    if (result.Converted)
+    {
+        Console::WriteLine("%s: converted in %.3f s", sourcePath.c_str(), result.Seconds);
+    }
+    else
+    {
+        Console::WriteLine("%s: failed in %.3f s, %s", sourcePath.c_str(), result.Seconds, result.Error.c_str());
+    }
+}
+
+/**
+ * Converts the parks one after the other in this process, the context and the object repository are only set up once
+ * for all of them.
+ */
+static std::vector<BatchConvertResult> ConvertParksInProcess(
+    const std::vector<std::string>& sourcePaths, const std::string& destinationDirectory,
+    const std::string& destinationExtension)
+{
+    std::vector<BatchConvertResult> results(sourcePaths.size());
+
+    core_init();
+    gOpenRCT2Headless = true;
+    std::unique_ptr<IContext> context(CreateContext());
+    if (!context->Initialise())
+    {
+        for (auto& result : results)
+        {
+            result.Error = "context initialization failed";
+        }
+        return results;
+    }
+
+    auto destinationFileType = get_file_extension_type(("." + destinationExtension).c_str());
+    for (size_t i = 0; i < sourcePaths.size(); i++)
+    {
+        const auto& sourcePath = sourcePaths[i];
+        auto& result = results[i];
+        auto startTime = std::chrono::steady_clock::now();
+        try
+        {
+            auto sourceFileType = get_file_extension_type(sourcePath.c_str());
+            const utf8* error = GetConversionError(sourceFileType, destinationFileType);
+            if (error != nullptr)
+            {
+                throw std::runtime_error(error);
+            }
+            auto destinationPath = GetBatchDestinationPath(sourcePath, destinationDirectory, destinationExtension);
+            ConvertPark(
+                sourcePath.c_str(), sourceFileType, destinationPath.c_str(), destinationFileType,
+                &context->GetObjectManager());
+            result.Converted = true;
+        }
+        catch (const std::exception& ex)
+        {
+            result.Error = ex.what();
+        }
+        result.Seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+        WriteBatchConvertResult(sourcePath, result);
+    }
+    return results;
+}
+
+#ifndef _WIN32
+/**
+ * Splits the parks between worker processes that each convert their share in process, so a park that crashes the
+ * importer only takes the rest of its worker's share down with it. The results are read back from the output of the
+ * workers, which write them in the order of their manifest.
+ */
+static std::vector<BatchConvertResult> ConvertParksInWorkers(
+    const std::vector<std::string>& sourcePaths, const std::string& destinationDirectory,
+    const std::string& destinationExtension, size_t numJobs)
+{
+    std::vector<BatchConvertResult> results(sourcePaths.size());
+    std::vector<std::vector<size_t>> shares(numJobs);
+    for (size_t i = 0; i < sourcePaths.size(); i++)
+    {
+        shares[i % numJobs].push_back(i);
+    }
+
+    auto exePath = Platform::GetCurrentExecutablePath();
+    auto runShare = [&](size_t job) {
+        const auto& share = shares[job];
+        std::string manifest;
+        for (auto index : share)
+        {
+            manifest += sourcePaths[index] + "\n";
+        }
+        auto manifestPath = Path::Combine(destinationDirectory, String::StdFormat(".convert-batch-%zu.txt", job));
+        File::WriteAllBytes(manifestPath, manifest.data(), manifest.size());
+
+        auto command = String::StdFormat(
+            "%s convert-batch %s %s %s 1 2> /dev/null", Platform::QuoteArgument(exePath).c_str(),
+            Platform::QuoteArgument(manifestPath).c_str(), Platform::QuoteArgument(destinationDirectory).c_str(),
+            Platform::QuoteArgument(destinationExtension).c_str());
+        std::string output;
+        Platform::Execute(command, &output);
+        File::Delete(manifestPath);
+
+        size_t next = 0;
+        for (const auto& line : String::Split(output, "\n"))
+        {
+            if (next >= share.size())
+                break;
+
+            const auto& sourcePath = sourcePaths[share[next]];
+            if (!String::StartsWith(line, sourcePath + ": "))
+                continue;
+
+            auto& result = results[share[next]];
+            auto status = line.substr(sourcePath.size() + 2);
+            if (String::StartsWith(status, "converted in "))
+            {
+                result.Converted = true;
+                result.Seconds = std::atof(status.c_str() + String::LengthOf("converted in "));
+            }
+            else if (String::StartsWith(status, "failed in "))
+            {
+                result.Seconds = std::atof(status.c_str() + String::LengthOf("failed in "));
+                auto separator = status.find(", ");
+                result.Error = separator != std::string::npos ? status.substr(separator + 2) : "unknown error";
+            }
+            next++;
+        }
+        for (; next < share.size(); next++)
+        {
+            results[share[next]].Error = "the worker process exited before converting it";
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (size_t job = 0; job < numJobs; job++)
+    {
+        workers.emplace_back(runShare, job);
+    }
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+    return results;
+}
+#endif // _WIN32
+
+/**
+ * Converts every park of a directory or a manifest to the given format, into the destination directory. With more
+ * than one job the parks are split between that many worker processes. The time taken for each park and the parks that
+ * failed are reported at the end.
+ */
+exitcode_t CommandLine::HandleCommandConvertBatch(CommandLineArgEnumerator* enumerator)
+{
+    exitcode_t result = CommandLine::HandleCommandDefault();
+    if (result != EXITCODE_CONTINUE)
+    {
+        return result;
+    }
+
+    const utf8* rawSource;
+    const utf8* rawDestinationDirectory;
+    const utf8* destinationExtension;
+    if (!enumerator->TryPopString(&rawSource) || !enumerator->TryPopString(&rawDestinationDirectory)
+        || !enumerator->TryPopString(&destinationExtension))
+    {
+        Console::Error::WriteLine("Expected a source directory or manifest, a destination directory and a format.");
+        return EXITCODE_FAIL;
+    }
+    int32_t numJobs = 1;
+    enumerator->TryPopInteger(&numJobs);
+
+    auto destinationFileType = get_file_extension_type((std::string(".") + destinationExtension).c_str());
+    if (destinationFileType != FILE_EXTENSION_SC6 && destinationFileType != FILE_EXTENSION_SV6
+        && destinationFileType != FILE_EXTENSION_PARK)
+    {
+        Console::Error::WriteLine("Only conversion to sc6, sv6 or park is supported.");
+        return EXITCODE_FAIL;
+    }
+
+    auto source = Path::GetAbsolute(rawSource);
+    if (!Path::DirectoryExists(source) && !File::Exists(source))
     {
-        Console::Error::WriteLine("Only conversion to .SC6 or .SV4 is supported.");
+        Console::Error::WriteLine("%s does not exist.", source.c_str());
         return EXITCODE_FAIL;
     }
+    auto sourcePaths = GetBatchSourcePaths(source);
+    auto destinationDirectory = Path::GetAbsolute(rawDestinationDirectory);
+    Path::CreateDirectory(destinationDirectory);
+
+    auto startTime = std::chrono::steady_clock::now();
+    std::vector<BatchConvertResult> results;
+#ifdef _WIN32
+    numJobs = 1;
+#endif
+    if (numJobs <= 1)
+    {
+        results = ConvertParksInProcess(sourcePaths, destinationDirectory, destinationExtension);
+    }
+#ifndef _WIN32
+    else
+    {
+        auto jobs = std::min<size_t>(numJobs, sourcePaths.size());
+        Console::WriteLine("Converting %zu parks with %zu jobs...", sourcePaths.size(), jobs);
+        results = ConvertParksInWorkers(sourcePaths, destinationDirectory, destinationExtension, jobs);
+        for (size_t i = 0; i < sourcePaths.size(); i++)
+        {
+            WriteBatchConvertResult(sourcePaths[i], results[i]);
+        }
+    }
+#endif
+    auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+    size_t numFailed = 0;
+    for (size_t i = 0; i < sourcePaths.size(); i++)
+    {
+        if (!results[i].Converted)
+        {
+            if (numFailed == 0)
+            {
+                Console::WriteLine("Failed:");
+            }
+            Console::WriteLine("  %s: %s", sourcePaths[i].c_str(), results[i].Error.c_str());
+            numFailed++;
+        }
+    }
+    Console::WriteLine(
+        "Converted %zu of %zu parks in %.3f s, %zu failed.", sourcePaths.size() - numFailed, sourcePaths.size(), seconds,
+        numFailed);
+    return numFailed == 0 ? EXITCODE_OK : EXITCODE_FAIL;
+}
+
+/**
+ * Returns why the source can not be converted to the destination type, or nullptr if it can.
+ */
+static const utf8* GetConversionError(uint32_t sourceFileType, uint32_t destinationFileType)
+{
+    // Validate target type
+    if (destinationFileType != FILE_EXTENSION_SC6 && destinationFileType != FILE_EXTENSION_SV6
+        && destinationFileType != FILE_EXTENSION_PARK)
+    {
+        return "Only conversion to .SC6, .SV6 or .PARK is supported.";
+    }
 
     // Validate the source type
     switch (sourceFileType)
@@ -70,71 +396,71 @@ exitcode_t CommandLine::HandleCommandConvert(CommandLineArgEnumerator* enumerato
         case FILE_EXTENSION_SC6:
             if (destinationFileType == FILE_EXTENSION_SC6)
             {
-                Console::Error::WriteLine("File is already a RollerCoaster Tycoon 2 scenario.");
-                return EXITCODE_FAIL;
+                return "File is already a RollerCoaster Tycoon 2 scenario.";
             }
             break;
         case FILE_EXTENSION_SV6:
             if (destinationFileType == FILE_EXTENSION_SV6)
             {
-                Console::Error::WriteLine("File is already a RollerCoaster Tycoon 2 saved game.");
-                return EXITCODE_FAIL;
+                return "File is already a RollerCoaster Tycoon 2 saved game.";
+            }
+            break;
+        case FILE_EXTENSION_PARK:
+            if (destinationFileType == FILE_EXTENSION_PARK)
+            {
+                return "File is already an OpenRCT2 park.";
             }
             break;
         default:
-            Console::Error::WriteLine("Only conversion from .SC4, .SV4, .SC6 or .SV6 is supported.");
-            return EXITCODE_FAIL;
+            return "Only conversion from .SC4, .SV4, .SC6, .SV6 or .PARK is supported.";
     }
+    return nullptr;
+}
 
-    // Perform conversion
-    WriteConvertFromAndToMessage(sourceFileType, destinationFileType);
-
-    gOpenRCT2Headless = true;
-
-    try
-    {
-        auto importer = ParkImporter::Create(sourcePath);
-        importer->Load(sourcePath);
-        importer->Import();
-    }
-    catch (const std::exception& ex)
+/**
+ * Imports the source park and exports it to the destination, throws if either fails. The objects of the park are
+ * loaded first when an object manager is given.
+ */
+static void ConvertPark(
+    const utf8* sourcePath, uint32_t sourceFileType, const utf8* destinationPath, uint32_t destinationFileType,
+    IObjectManager* objectManager)
+{
+    auto importer = ParkImporter::Create(sourcePath);
+    auto loadResult = importer->Load(sourcePath);
+    if (objectManager != nullptr)
     {
-        Console::Error::WriteLine(ex.what());
-        return EXITCODE_FAIL;
+        objectManager->LoadObjects(loadResult.RequiredObjects.data(), loadResult.RequiredObjects.size());
     }
+    importer->Import();
+
+    bool sourceIsScenario = sourceFileType == FILE_EXTENSION_SC4 || sourceFileType == FILE_EXTENSION_SC6
+        || (sourceFileType == FILE_EXTENSION_PARK && ClassifyParkFile(sourcePath) == FILE_TYPE::SCENARIO);
 
-    if (sourceFileType == FILE_EXTENSION_SC4 || sourceFileType == FILE_EXTENSION_SC6)
+    if (sourceIsScenario)
     {
         // We are converting a scenario, so reset the park
         scenario_begin();
     }
 
-    try
-    {
-        auto exporter = std::make_unique<S6Exporter>();
+    auto exporter = std::make_unique<S6Exporter>();
 
-        // HACK remove the main window so it saves the park with the
-        //      correct initial view
-        window_close_by_class(WC_MAIN_WINDOW);
+    // HACK remove the main window so it saves the park with the
+    //      correct initial view
+    window_close_by_class(WC_MAIN_WINDOW);
 
-        exporter->Export();
-        if (destinationFileType == FILE_EXTENSION_SC6)
-        {
-            exporter->SaveScenario(destinationPath);
-        }
-        else
-        {
-            exporter->SaveGame(destinationPath);
-        }
+    exporter->Export();
+    if (destinationFileType == FILE_EXTENSION_PARK)
+    {
+        exporter->SaveParkFile(destinationPath, sourceIsScenario);
     }
-    catch (const std::exception& ex)
+    else if (destinationFileType == FILE_EXTENSION_SC6)
     {
-        Console::Error::WriteLine(ex.what());
-        return EXITCODE_FAIL;
+        exporter->SaveScenario(destinationPath);
+    }
+    else
+    {
+        exporter->SaveGame(destinationPath);
     }
-
-    Console::WriteLine("Conversion successful!");
-    return EXITCODE_OK;
 }
 
 static void WriteConvertFromAndToMessage(uint32_t sourceFileType, uint32_t destinationFileType)
@@ -157,6 +483,8 @@ static const utf8* GetFileTypeFriendlyName(uint32_t fileType)
             return "RollerCoaster Tycoon 2 scenario";
         case FILE_EXTENSION_SV6:
             return "RollerCoaster Tycoon 2 saved game";
+        case FILE_EXTENSION_PARK:
+            return "OpenRCT2 park";
     }
 
     assert(false);
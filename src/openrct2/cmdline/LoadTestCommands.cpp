@@ -0,0 +1,475 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "../Context.h"
+#include "../Game.h"
+#include "../GameState.h"
+#include "../OpenRCT2.h"
+#include "../actions/GuestSetNameAction.h"
+#include "../actions/NetworkModifyGroupAction.h"
+#include "../actions/RideSetPriceAction.h"
+#include "../actions/SetParkEntranceFeeAction.h"
+#include "../config/Config.h"
+#include "../core/Console.hpp"
+#include "../core/String.hpp"
+#include "../network/network.h"
+#include "../platform/Platform2.h"
+#include "../platform/platform.h"
+#include "../ride/Ride.h"
+#include "../world/EntityList.h"
+#include "CommandLine.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace OpenRCT2;
+
+static exitcode_t HandleLoadTest(CommandLineArgEnumerator* argEnumerator);
+static exitcode_t HandleLoadTestClients(CommandLineArgEnumerator* argEnumerator);
+static exitcode_t HandleLoadTestClient(CommandLineArgEnumerator* argEnumerator);
+
+// clang-format off
+const CommandLineCommand CommandLine::LoadTestCommands[]
+{
+    // Main commands
+    DefineCommand("",        "<sv6-file> <clients> <seconds> [port]",  nullptr, HandleLoadTest       ),
+    DefineCommand("clients", "<host> <port> <clients> <seconds>",      nullptr, HandleLoadTestClients),
+    DefineCommand("client",  "<host> <port> <seconds> <seed>",         nullptr, HandleLoadTestClient ),
+    CommandTableEnd
+};
+// clang-format on
+
+#ifndef DISABLE_NETWORK
+
+static constexpr const char* LoadTestResultPrefix = "Result: ";
+
+// Clients that have not received the map by then count as failed to join
+static constexpr auto LoadTestJoinTimeout = std::chrono::seconds(60);
+
+// Ticks between the game actions of a client, about two actions per second
+static constexpr uint32_t LoadTestActionIntervalTicks = 20;
+
+// The User group of the default groups, which may build and change prices
+static constexpr uint8_t LoadTestClientGroupId = 2;
+
+struct LoadTestClientResult
+{
+    bool Joined = false;
+    uint32_t JoinMilliseconds = 0;
+    uint32_t Ticks = 0;
+    uint32_t Actions = 0;
+    uint32_t Desyncs = 0;
+    unsigned long long BytesReceived = 0;
+    unsigned long long BytesSent = 0;
+};
+
+/**
+ * Runs the next game action of the scripted mix. The generator is seeded per client, so every client sends a different
+ * but reproducible sequence of chat messages, ride price, guest name and entrance fee changes.
+ * @returns true if the action was sent to the server.
+ */
+static bool run_scripted_action(std::mt19937& rng, uint32_t seed)
+{
+    switch (rng() % 4)
+    {
+        case 0:
+        {
+            auto text = String::StdFormat("Load test message %u from client %u", static_cast<uint32_t>(rng() % 1000), seed);
+            network_send_chat(text.c_str());
+            return true;
+        }
+        case 1:
+        {
+            std::vector<ride_id_t> rides;
+            for (const auto& ride : GetRideManager())
+            {
+                rides.push_back(ride.id);
+            }
+            if (rides.empty())
+            {
+                return false;
+            }
+            auto action = RideSetPriceAction(rides[rng() % rides.size()], static_cast<money16>(rng() % MONEY(20, 00)), true);
+            return GameActions::Execute(&action)->Error == GameActions::Status::Ok;
+        }
+        case 2:
+        {
+            std::vector<uint16_t> guests;
+            for (auto* guest : EntityList<Guest>())
+            {
+                guests.push_back(guest->sprite_index);
+            }
+            if (guests.empty())
+            {
+                return false;
+            }
+            auto name = String::StdFormat("Load test %u", static_cast<uint32_t>(rng() % 1000));
+            auto action = GuestSetNameAction(guests[rng() % guests.size()], name);
+            return GameActions::Execute(&action)->Error == GameActions::Status::Ok;
+        }
+        default:
+        {
+            auto action = SetParkEntranceFeeAction(static_cast<money16>(rng() % MONEY(50, 00)));
+            return GameActions::Execute(&action)->Error == GameActions::Status::Ok;
+        }
+    }
+}
+
+/**
+ * Runs the client for the given number of seconds after it has joined, without rendering, keeping up with the ticks of
+ * the server and sending the scripted game actions.
+ */
+static LoadTestClientResult run_client(const std::string& host, int32_t port, uint32_t seconds, uint32_t seed)
+{
+    LoadTestClientResult result;
+    gConfigNetwork.player_name = String::StdFormat("loadtest-%u", seed);
+    gConfigNetwork.stay_connected = true;
+    if (!network_begin_client(host, port))
+    {
+        return result;
+    }
+
+    std::mt19937 rng(seed);
+    auto* gameState = GetContext()->GetGameState();
+    const auto startTime = std::chrono::steady_clock::now();
+    auto endTime = startTime + LoadTestJoinTimeout;
+    uint32_t joinTick = 0;
+    uint32_t lastActionTick = 0;
+    bool desynchronised = false;
+    while (network_get_mode() == NETWORK_MODE_CLIENT)
+    {
+        const auto tickStartTime = std::chrono::steady_clock::now();
+        if (tickStartTime >= endTime)
+        {
+            break;
+        }
+
+        gCurrentDeltaTime = GAME_UPDATE_TIME_MS;
+        gameState->Update();
+
+        if (!result.Joined)
+        {
+            if (network_is_map_loaded() && network_get_authstatus() == NetworkAuth::Ok)
+            {
+                result.Joined = true;
+                result.JoinMilliseconds = static_cast<uint32_t>(
+                    std::chrono::duration_cast<std::chrono::milliseconds>(tickStartTime - startTime).count());
+                joinTick = lastActionTick = gCurrentTicks;
+                endTime = tickStartTime + std::chrono::seconds(seconds);
+            }
+        }
+        else
+        {
+            if (network_is_desynchronised() && !desynchronised)
+            {
+                result.Desyncs++;
+            }
+            desynchronised = network_is_desynchronised();
+
+            if (gCurrentTicks - lastActionTick >= LoadTestActionIntervalTicks)
+            {
+                lastActionTick = gCurrentTicks;
+                result.Actions += run_scripted_action(rng, seed) ? 1 : 0;
+            }
+            result.Ticks = gCurrentTicks - joinTick;
+        }
+
+        std::this_thread::sleep_until(tickStartTime + std::chrono::milliseconds(GAME_UPDATE_TIME_MS));
+    }
+
+    const auto stats = network_get_stats();
+    result.BytesReceived = stats.bytesReceived[EnumValue(NetworkStatisticsGroup::Total)];
+    result.BytesSent = stats.bytesSent[EnumValue(NetworkStatisticsGroup::Total)];
+    network_close();
+    return result;
+}
+
+static exitcode_t HandleLoadTestClient(CommandLineArgEnumerator* argEnumerator)
+{
+    const char** argv = const_cast<const char**>(argEnumerator->GetArguments()) + argEnumerator->GetIndex();
+    int32_t argc = argEnumerator->GetCount() - argEnumerator->GetIndex();
+
+    if (argc < 4)
+    {
+        Console::Error::WriteLine("Missing arguments <host> <port> <seconds> <seed>.");
+        return EXITCODE_FAIL;
+    }
+
+    core_init();
+    gOpenRCT2Headless = true;
+    gOpenRCT2NoGraphics = true;
+
+    std::unique_ptr<IContext> context(CreateContext());
+    if (!context->Initialise())
+    {
+        Console::Error::WriteLine("Context initialization failed.");
+        return EXITCODE_FAIL;
+    }
+
+    auto result = run_client(argv[0], atoi(argv[1]), atol(argv[2]), atol(argv[3]));
+    Console::WriteLine(
+        "%s%d %u %u %u %u %llu %llu", LoadTestResultPrefix, result.Joined ? 1 : 0, result.JoinMilliseconds, result.Ticks,
+        result.Actions, result.Desyncs, result.BytesReceived, result.BytesSent);
+    return result.Joined ? EXITCODE_OK : EXITCODE_FAIL;
+}
+
+/**
+ * Starts the client processes on worker threads and returns immediately, the number of clients still running is kept
+ * in runningClients.
+ */
+static std::vector<std::thread> start_clients(
+    const std::string& host, int32_t port, uint32_t numClients, uint32_t seconds, std::vector<LoadTestClientResult>& results,
+    std::atomic<uint32_t>& runningClients)
+{
+    results.resize(numClients);
+    runningClients = numClients;
+
+    // Each client runs in its own process as the game state is global, only the last line of output (the result) is kept.
+    auto exePath = Platform::GetCurrentExecutablePath();
+    std::vector<std::thread> workers;
+    for (uint32_t i = 0; i < numClients; i++)
+    {
+        workers.emplace_back([&results, &runningClients, exePath, host, port, seconds, i]() {
+            auto command = String::StdFormat(
+                "%s loadtest client %s %d %u %u 2> /dev/null | tail -n 1", Platform::QuoteArgument(exePath).c_str(),
+                Platform::QuoteArgument(host).c_str(), port, seconds, i + 1);
+
+            std::string output;
+            Platform::Execute(command, &output);
+            if (String::StartsWith(output, LoadTestResultPrefix))
+            {
+                auto& result = results[i];
+                int32_t joined = 0;
+                if (std::sscanf(
+                        output.c_str() + String::LengthOf(LoadTestResultPrefix), "%d %u %u %u %u %llu %llu", &joined,
+                        &result.JoinMilliseconds, &result.Ticks, &result.Actions, &result.Desyncs, &result.BytesReceived,
+                        &result.BytesSent)
+                    == 7)
+                {
+                    result.Joined = joined != 0;
+                }
+            }
+            runningClients--;
+        });
+    }
+    return workers;
+}
+
+/**
+ * Prints the summed client results and returns whether every client joined and stayed in sync.
+ */
+static bool report_clients(const std::vector<LoadTestClientResult>& results)
+{
+    uint32_t numJoined = 0;
+    uint32_t maxJoinMilliseconds = 0;
+    uint64_t totalJoinMilliseconds = 0;
+    uint64_t totalTicks = 0;
+    uint32_t totalActions = 0;
+    uint32_t totalDesyncs = 0;
+    for (const auto& result : results)
+    {
+        if (result.Joined)
+        {
+            numJoined++;
+            maxJoinMilliseconds = std::max(maxJoinMilliseconds, result.JoinMilliseconds);
+            totalJoinMilliseconds += result.JoinMilliseconds;
+            totalTicks += result.Ticks;
+            totalActions += result.Actions;
+            totalDesyncs += result.Desyncs;
+        }
+    }
+
+    Console::WriteLine("Clients joined: %u/%zu", numJoined, results.size());
+    if (numJoined != 0)
+    {
+        Console::WriteLine(
+            "Join time: %u ms average, %u ms max", static_cast<uint32_t>(totalJoinMilliseconds / numJoined),
+            maxJoinMilliseconds);
+        Console::WriteLine("Client ticks: %u average", static_cast<uint32_t>(totalTicks / numJoined));
+    }
+    Console::WriteLine("Game actions sent: %u", totalActions);
+    Console::WriteLine("Desyncs: %u", totalDesyncs);
+    return numJoined == results.size() && totalDesyncs == 0;
+}
+
+/**
+ * Hosts the park and runs the given number of headless clients against it, each in its own process. The tick time and
+ * traffic of the server are recorded until the last client has finished.
+ */
+static exitcode_t HandleLoadTest(CommandLineArgEnumerator* argEnumerator)
+{
+    const char** argv = const_cast<const char**>(argEnumerator->GetArguments()) + argEnumerator->GetIndex();
+    int32_t argc = argEnumerator->GetCount() - argEnumerator->GetIndex();
+
+    if (argc < 3)
+    {
+        Console::Error::WriteLine("Missing arguments <sv6-file> <clients> <seconds> [port].");
+        return EXITCODE_FAIL;
+    }
+
+#    ifdef _WIN32
+    Console::Error::WriteLine("Load testing is not supported on this platform.");
+    return EXITCODE_FAIL;
+#    else
+    const char* inputPath = argv[0];
+    uint32_t numClients = std::max<int32_t>(1, atoi(argv[1]));
+    uint32_t seconds = atol(argv[2]);
+
+    core_init();
+    gOpenRCT2Headless = true;
+    gOpenRCT2NoGraphics = true;
+
+    std::unique_ptr<IContext> context(CreateContext());
+    if (!context->Initialise())
+    {
+        Console::Error::WriteLine("Context initialization failed.");
+        return EXITCODE_FAIL;
+    }
+    if (!context->LoadParkFromFile(inputPath))
+    {
+        return EXITCODE_FAIL;
+    }
+
+    int32_t port = argc >= 4 ? atoi(argv[3]) : gConfigNetwork.default_port;
+    gConfigNetwork.pause_server_if_no_clients = false;
+    gConfigNetwork.maxplayers = std::max<int32_t>(gConfigNetwork.maxplayers, numClients + 1);
+    network_set_password("");
+    if (!network_begin_server(port, gConfigNetwork.listen_address))
+    {
+        Console::Error::WriteLine("Unable to host on port %d.", port);
+        return EXITCODE_FAIL;
+    }
+    auto setDefaultGroup = NetworkModifyGroupAction(ModifyGroupType::SetDefault, LoadTestClientGroupId);
+    GameActions::Execute(&setDefaultGroup);
+
+    Console::WriteLine("Running %u clients for %u seconds...", numClients, seconds);
+    std::vector<LoadTestClientResult> results;
+    std::atomic<uint32_t> runningClients = { 0 };
+    auto workers = start_clients("127.0.0.1", port, numClients, seconds, results, runningClients);
+
+    auto* gameState = context->GetGameState();
+    std::vector<double> tickMilliseconds;
+    int32_t peakPlayers = 0;
+    const auto startTime = std::chrono::steady_clock::now();
+    const auto endTime = startTime + LoadTestJoinTimeout + std::chrono::seconds(seconds);
+    while (runningClients != 0 && std::chrono::steady_clock::now() < endTime)
+    {
+        const auto tickStartTime = std::chrono::steady_clock::now();
+        gCurrentDeltaTime = GAME_UPDATE_TIME_MS;
+        gameState->Update();
+        tickMilliseconds.push_back(
+            std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - tickStartTime).count());
+        peakPlayers = std::max(peakPlayers, network_get_num_players() - 1);
+        std::this_thread::sleep_until(tickStartTime + std::chrono::milliseconds(GAME_UPDATE_TIME_MS));
+    }
+    const auto totalSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    const auto stats = network_get_stats();
+
+    // Clients that have not finished by the deadline lose the server and stop on their own
+    network_close();
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+
+    std::vector<double> sortedTicks = tickMilliseconds;
+    std::sort(sortedTicks.begin(), sortedTicks.end());
+    auto percentile = [&sortedTicks](double fraction) {
+        return sortedTicks.empty() ? 0.0 : sortedTicks[static_cast<size_t>(fraction * (sortedTicks.size() - 1))];
+    };
+    double totalTickMilliseconds = 0;
+    for (auto tick : tickMilliseconds)
+    {
+        totalTickMilliseconds += tick;
+    }
+
+    Console::WriteLine("Peak players: %d", peakPlayers);
+    Console::WriteLine(
+        "Server ticks: %zu, %.3f ms average, %.3f ms p50, %.3f ms p99, %.3f ms max", tickMilliseconds.size(),
+        tickMilliseconds.empty() ? 0.0 : totalTickMilliseconds / tickMilliseconds.size(), percentile(0.5),
+        percentile(0.99), percentile(1.0));
+    Console::WriteLine(
+        "Server traffic: %.1f KiB/s sent, %.1f KiB/s received",
+        stats.bytesSent[EnumValue(NetworkStatisticsGroup::Total)] / 1024.0 / totalSeconds,
+        stats.bytesReceived[EnumValue(NetworkStatisticsGroup::Total)] / 1024.0 / totalSeconds);
+    return report_clients(results) ? EXITCODE_OK : EXITCODE_FAIL;
+#    endif // _WIN32
+}
+
+/**
+ * Runs the given number of headless clients against a server that is already running, only the client side of the
+ * load can be recorded then.
+ */
+static exitcode_t HandleLoadTestClients(CommandLineArgEnumerator* argEnumerator)
+{
+    const char** argv = const_cast<const char**>(argEnumerator->GetArguments()) + argEnumerator->GetIndex();
+    int32_t argc = argEnumerator->GetCount() - argEnumerator->GetIndex();
+
+    if (argc < 4)
+    {
+        Console::Error::WriteLine("Missing arguments <host> <port> <clients> <seconds>.");
+        return EXITCODE_FAIL;
+    }
+
+#    ifdef _WIN32
+    Console::Error::WriteLine("Load testing is not supported on this platform.");
+    return EXITCODE_FAIL;
+#    else
+    uint32_t numClients = std::max<int32_t>(1, atoi(argv[2]));
+    uint32_t seconds = atol(argv[3]);
+
+    Console::WriteLine("Running %u clients for %u seconds...", numClients, seconds);
+    std::vector<LoadTestClientResult> results;
+    std::atomic<uint32_t> runningClients = { 0 };
+    auto workers = start_clients(argv[0], atoi(argv[1]), numClients, seconds, results, runningClients);
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+
+    unsigned long long bytesReceived = 0;
+    unsigned long long bytesSent = 0;
+    for (const auto& result : results)
+    {
+        bytesReceived += result.BytesReceived;
+        bytesSent += result.BytesSent;
+    }
+    Console::WriteLine("Client traffic: %llu KiB received, %llu KiB sent", bytesReceived / 1024, bytesSent / 1024);
+    return report_clients(results) ? EXITCODE_OK : EXITCODE_FAIL;
+#    endif // _WIN32
+}
+
+#else
+
+static exitcode_t HandleLoadTest(CommandLineArgEnumerator* argEnumerator)
+{
+    Console::Error::WriteLine("Load testing is not available in builds without multiplayer.");
+    return EXITCODE_FAIL;
+}
+
+static exitcode_t HandleLoadTestClients(CommandLineArgEnumerator* argEnumerator)
+{
+    return HandleLoadTest(argEnumerator);
+}
+
+static exitcode_t HandleLoadTestClient(CommandLineArgEnumerator* argEnumerator)
+{
+    return HandleLoadTest(argEnumerator);
+}
+
+#endif // DISABLE_NETWORK
@@ -0,0 +1,190 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "../Context.h"
+#include "../GameState.h"
+#include "../OpenRCT2.h"
+#include "../ReplayManager.h"
+#include "../core/Console.hpp"
+#include "../core/String.hpp"
+#include "../platform/Platform2.h"
+#include "../platform/platform.h"
+#include "CommandLine.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace OpenRCT2;
+
+static exitcode_t HandleReplay(CommandLineArgEnumerator* argEnumerator);
+static exitcode_t HandleReplayBatch(CommandLineArgEnumerator* argEnumerator);
+
+// clang-format off
+const CommandLineCommand CommandLine::ReplayCommands[]
+{
+    // Main commands
+    DefineCommand("",      "<sv6r-file> [checksum-interval]",              nullptr, HandleReplay     ),
+    DefineCommand("batch", "<jobs> <checksum-interval> <sv6r-file> [...]", nullptr, HandleReplayBatch),
+    CommandTableEnd
+};
+// clang-format on
+
+static constexpr const char* ReplayResultPrefix = "Result: ";
+
+/**
+ * Plays a replay back without rendering, running the game logic for each tick straight after the previous one.
+ * Only every given number of ticks the state is compared to the checksums stored in the replay.
+ */
+static exitcode_t HandleReplay(CommandLineArgEnumerator* argEnumerator)
+{
+    const char** argv = const_cast<const char**>(argEnumerator->GetArguments()) + argEnumerator->GetIndex();
+    int32_t argc = argEnumerator->GetCount() - argEnumerator->GetIndex();
+
+    if (argc < 1)
+    {
+        Console::Error::WriteLine("Missing arguments <sv6r-file> [checksum-interval].");
+        return EXITCODE_FAIL;
+    }
+
+    core_init();
+
+    const char* inputPath = argv[0];
+    uint32_t checksumInterval = argc >= 2 ? atol(argv[1]) : 1;
+
+    gOpenRCT2Headless = true;
+    gOpenRCT2NoGraphics = true;
+
+    std::unique_ptr<IContext> context(CreateContext());
+    if (!context->Initialise())
+    {
+        Console::Error::WriteLine("Context initialization failed.");
+        return EXITCODE_FAIL;
+    }
+
+    auto* replayManager = context->GetReplayManager();
+    replayManager->SetPlaybackChecksumInterval(checksumInterval);
+    if (!replayManager->StartPlayback(inputPath))
+    {
+        Console::Error::WriteLine("Unable to start replay %s.", inputPath);
+        return EXITCODE_FAIL;
+    }
+
+    ReplayRecordInfo info;
+    replayManager->GetCurrentReplayInfo(info);
+    Console::WriteLine("Running %u ticks...", info.Ticks);
+
+    auto* gameState = context->GetGameState();
+    auto startTime = std::chrono::steady_clock::now();
+    while (replayManager->IsReplaying() && !replayManager->IsPlaybackStateMismatching())
+    {
+        gameState->UpdateLogic();
+    }
+    auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+    bool passed = !replayManager->IsPlaybackStateMismatching();
+    Console::WriteLine(
+        "%s%s %u %.3f %.0f", ReplayResultPrefix, passed ? "passed" : "mismatch", info.Ticks, seconds,
+        info.Ticks / std::max(seconds, 0.001));
+    return passed ? EXITCODE_OK : EXITCODE_FAIL;
+}
+
+/**
+ * Runs the replay command for each replay in a separate process, with up to the given number of processes at the same
+ * time, and prints the outcome and the throughput for each replay in the order of the arguments.
+ */
+static exitcode_t HandleReplayBatch(CommandLineArgEnumerator* argEnumerator)
+{
+    const char** argv = const_cast<const char**>(argEnumerator->GetArguments()) + argEnumerator->GetIndex();
+    int32_t argc = argEnumerator->GetCount() - argEnumerator->GetIndex();
+
+    if (argc < 3)
+    {
+        Console::Error::WriteLine("Missing arguments <jobs> <checksum-interval> <sv6r-file> [...].");
+        return EXITCODE_FAIL;
+    }
+
+#ifdef _WIN32
+    Console::Error::WriteLine("Batch replay is not supported on this platform.");
+    return EXITCODE_FAIL;
+#else
+    size_t numJobs = std::max<int32_t>(1, atoi(argv[0]));
+    uint32_t checksumInterval = atol(argv[1]);
+    std::vector<std::string> replays(argv + 2, argv + argc);
+
+    struct ReplayResult
+    {
+        std::string Status = "failed";
+        uint32_t Ticks = 0;
+        double Seconds = 0;
+        double TicksPerSecond = 0;
+    };
+    std::vector<ReplayResult> results(replays.size());
+
+    // Each replay runs in its own process as the game state is global, only the last line of output (the result) is kept.
+    auto exePath = Platform::GetCurrentExecutablePath();
+    std::atomic<size_t> nextReplay = { 0 };
+    std::mutex consoleMutex;
+    auto runReplays = [&]() {
+        for (size_t i = nextReplay++; i < replays.size(); i = nextReplay++)
+        {
+            auto command = String::StdFormat(
+                "%s replay %s %u 2> /dev/null | tail -n 1", Platform::QuoteArgument(exePath).c_str(),
+                Platform::QuoteArgument(replays[i]).c_str(), checksumInterval);
+
+            std::string output;
+            Platform::Execute(command, &output);
+            if (String::StartsWith(output, ReplayResultPrefix))
+            {
+                auto& result = results[i];
+                char status[16] = {};
+                if (std::sscanf(
+                        output.c_str() + String::LengthOf(ReplayResultPrefix), "%15s %u %lf %lf", status, &result.Ticks,
+                        &result.Seconds, &result.TicksPerSecond)
+                    == 4)
+                {
+                    result.Status = status;
+                }
+            }
+
+            std::lock_guard<std::mutex> lock(consoleMutex);
+            Console::WriteLine("Finished %s (%zu/%zu)", replays[i].c_str(), i + 1, replays.size());
+        }
+    };
+
+    Console::WriteLine("Running %zu replays with %zu jobs...", replays.size(), numJobs);
+    std::vector<std::thread> workers;
+    for (size_t i = 0; i < std::min(numJobs, replays.size()); i++)
+    {
+        workers.emplace_back(runReplays);
+    }
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+
+    bool allPassed = true;
+    for (size_t i = 0; i < replays.size(); i++)
+    {
+        const auto& result = results[i];
+        Console::WriteLine(
+            "%s: %s, %u ticks, %.3f s, %.0f ticks/s", replays[i].c_str(), result.Status.c_str(), result.Ticks,
+            result.Seconds, result.TicksPerSecond);
+        allPassed &= result.Status == "passed";
+    }
+    return allPassed ? EXITCODE_OK : EXITCODE_FAIL;
+#endif // _WIN32
+}
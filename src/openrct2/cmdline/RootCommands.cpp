@@ -24,6 +24,7 @@
 #include "../platform/Platform2.h"
 #include "CommandLine.hpp"
 
+#include <algorithm>
 #include <ctime>
 #include <iterator>
 #include <memory>
@@ -58,6 +59,8 @@ static utf8* _openrct2DataPath = nullptr;
 static utf8* _rct1DataPath = nullptr;
 static utf8* _rct2DataPath = nullptr;
 static bool _silentBreakpad = false;
+static bool _startupProfile = false;
+static int32_t _memoryStats = 0;
 
 // clang-format off
 static constexpr const CommandLineOptionDefinition StandardOptions[]
@@ -69,6 +72,8 @@ static constexpr const CommandLineOptionDefinition StandardOptions[]
     { CMDLINE_TYPE_SWITCH,  &_about,            NAC, "about",              "show information about " OPENRCT2_NAME                      },
     { CMDLINE_TYPE_SWITCH,  &_verbose,          NAC, "verbose",            "log verbose messages"                                       },
     { CMDLINE_TYPE_SWITCH,  &_headless,         NAC, "headless",           "run " OPENRCT2_NAME " headless" IMPLIES_SILENT_BREAKPAD     },
+    { CMDLINE_TYPE_SWITCH,  &_startupProfile,   NAC, "startup-profile",    "print the time spent in each startup phase"                 },
+    { CMDLINE_TYPE_INTEGER, &_memoryStats,      NAC, "memory-stats",       "log the memory used by each subsystem every given seconds"  },
 #ifndef DISABLE_NETWORK                                                    
     { CMDLINE_TYPE_INTEGER, &_port,             NAC, "port",               "port to use for hosting or joining a server"                },
     { CMDLINE_TYPE_STRING,  &_address,          NAC, "address",            "address to listen on when hosting a server"                 },
@@ -128,6 +133,7 @@ const CommandLineCommand CommandLine::RootCommands[]
 #endif
     DefineCommand("set-rct2", "<path>",                 StandardOptions, HandleCommandSetRCT2),
     DefineCommand("convert",  "<source> <destination>", StandardOptions, CommandLine::HandleCommandConvert),
+    DefineCommand("convert-batch", "<directory|manifest> <destination-directory> <sc6|sv6|park> [jobs]", StandardOptions, CommandLine::HandleCommandConvertBatch),
     DefineCommand("scan-objects", "<path>",             StandardOptions, HandleCommandScanObjects),
     DefineCommand("handle-uri", "openrct2://.../",      StandardOptions, CommandLine::HandleCommandUri),
 
@@ -138,10 +144,18 @@ const CommandLineCommand CommandLine::RootCommands[]
     // Sub-commands
     DefineSubCommand("screenshot",      CommandLine::ScreenshotCommands       ),
     DefineSubCommand("sprite",          CommandLine::SpriteCommands           ),
+    DefineSubCommand("benchformatting", CommandLine::BenchFormattingCommands  ),
     DefineSubCommand("benchgfx",        CommandLine::BenchGfxCommands         ),
+    DefineSubCommand("benchpaint",      CommandLine::BenchPaintCommands       ),
+    DefineSubCommand("benchpathfinding", CommandLine::BenchPathfindingCommands),
+    DefineSubCommand("benchrideratings", CommandLine::BenchRideRatingsCommands),
+    DefineSubCommand("benchsawyercoding", CommandLine::BenchSawyerCodingCommands),
     DefineSubCommand("benchspritesort", CommandLine::BenchSpriteSortCommands  ),
     DefineSubCommand("benchsimulate",   CommandLine::BenchUpdateCommands      ),
+    DefineSubCommand("benchsuite",      CommandLine::BenchSuiteCommands       ),
     DefineSubCommand("simulate",        CommandLine::SimulateCommands         ),
+    DefineSubCommand("replay",          CommandLine::ReplayCommands           ),
+    DefineSubCommand("loadtest",        CommandLine::LoadTestCommands         ),
     CommandTableEnd
 };
 
@@ -196,6 +210,8 @@ exitcode_t CommandLine::HandleCommandDefault()
     gOpenRCT2Headless = _headless;
     gOpenRCT2NoGraphics = _headless;
     gOpenRCT2SilentBreakpad = _silentBreakpad || _headless;
+    gOpenRCT2StartupProfile = _startupProfile;
+    gOpenRCT2MemoryStatsInterval = static_cast<uint32_t>(std::max(0, _memoryStats));
 
     if (_userDataPath != nullptr)
     {
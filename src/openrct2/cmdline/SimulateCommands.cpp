@@ -12,21 +12,39 @@
 #include "../GameState.h"
 #include "../OpenRCT2.h"
 #include "../core/Console.hpp"
+#include "../core/String.hpp"
 #include "../network/network.h"
+#include "../platform/Platform2.h"
 #include "../platform/platform.h"
 #include "../world/Sprite.h"
 #include "CommandLine.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cstdlib>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
 
 using namespace OpenRCT2;
 
 static exitcode_t HandleSimulate(CommandLineArgEnumerator* argEnumerator);
+static exitcode_t HandleSimulateBatch(CommandLineArgEnumerator* argEnumerator);
 
-const CommandLineCommand CommandLine::SimulateCommands[]{ // Main commands
-                                                          DefineCommand("", "<ticks>", nullptr, HandleSimulate), CommandTableEnd
+// clang-format off
+const CommandLineCommand CommandLine::SimulateCommands[]
+{
+    // Main commands
+    DefineCommand("",      "<sv6-file> <ticks>",                nullptr, HandleSimulate     ),
+    DefineCommand("batch", "<ticks> <jobs> <sv6-file> [...]",   nullptr, HandleSimulateBatch),
+    CommandTableEnd
 };
+// clang-format on
+
+static constexpr const char* SimulateCompletedPrefix = "Completed: ";
 
 static exitcode_t HandleSimulate(CommandLineArgEnumerator* argEnumerator)
 {
@@ -63,7 +81,7 @@ static exitcode_t HandleSimulate(CommandLineArgEnumerator* argEnumerator)
         {
             context->GetGameState()->UpdateLogic();
         }
-        Console::WriteLine("Completed: %s", sprite_checksum().ToString().c_str());
+        Console::WriteLine("%s%s", SimulateCompletedPrefix, sprite_checksum().ToString().c_str());
     }
     else
     {
@@ -73,3 +91,87 @@ static exitcode_t HandleSimulate(CommandLineArgEnumerator* argEnumerator)
 
     return EXITCODE_OK;
 }
+
+/**
+ * Runs the simulate command for each park in a separate process, with up to the given number of processes at the same
+ * time, and prints the checksum and the time taken for each park in the order of the arguments.
+ */
+static exitcode_t HandleSimulateBatch(CommandLineArgEnumerator* argEnumerator)
+{
+    const char** argv = const_cast<const char**>(argEnumerator->GetArguments()) + argEnumerator->GetIndex();
+    int32_t argc = argEnumerator->GetCount() - argEnumerator->GetIndex();
+
+    if (argc < 3)
+    {
+        Console::Error::WriteLine("Missing arguments <ticks> <jobs> <sv6-file> [...].");
+        return EXITCODE_FAIL;
+    }
+
+#ifdef _WIN32
+    Console::Error::WriteLine("Batch simulation is not supported on this platform.");
+    return EXITCODE_FAIL;
+#else
+    uint32_t ticks = atol(argv[0]);
+    size_t numJobs = std::max<int32_t>(1, atoi(argv[1]));
+    std::vector<std::string> parks(argv + 2, argv + argc);
+
+    struct SimulateResult
+    {
+        std::string Checksum;
+        double Seconds = 0;
+    };
+    std::vector<SimulateResult> results(parks.size());
+
+    // Each park runs in its own process as the game state is global, only the last line of output (the checksum) is kept.
+    auto exePath = Platform::GetCurrentExecutablePath();
+    std::atomic<size_t> nextPark = { 0 };
+    std::mutex consoleMutex;
+    auto runParks = [&]() {
+        for (size_t i = nextPark++; i < parks.size(); i = nextPark++)
+        {
+            auto command = String::StdFormat(
+                "%s simulate %s %u 2> /dev/null | tail -n 1", Platform::QuoteArgument(exePath).c_str(),
+                Platform::QuoteArgument(parks[i]).c_str(), ticks);
+
+            std::string output;
+            auto startTime = std::chrono::steady_clock::now();
+            Platform::Execute(command, &output);
+            results[i].Seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+            if (String::StartsWith(output, SimulateCompletedPrefix))
+            {
+                results[i].Checksum = output.substr(String::LengthOf(SimulateCompletedPrefix));
+            }
+
+            std::lock_guard<std::mutex> lock(consoleMutex);
+            Console::WriteLine("Finished %s (%zu/%zu)", parks[i].c_str(), i + 1, parks.size());
+        }
+    };
+
+    Console::WriteLine("Running %d ticks for %zu parks with %zu jobs...", ticks, parks.size(), numJobs);
+    std::vector<std::thread> workers;
+    for (size_t i = 0; i < std::min(numJobs, parks.size()); i++)
+    {
+        workers.emplace_back(runParks);
+    }
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+
+    bool allCompleted = true;
+    for (size_t i = 0; i < parks.size(); i++)
+    {
+        const auto& result = results[i];
+        if (result.Checksum.empty())
+        {
+            Console::WriteLine("%s: failed, %.3f s", parks[i].c_str(), result.Seconds);
+            allCompleted = false;
+        }
+        else
+        {
+            Console::WriteLine("%s: %s, %.3f s", parks[i].c_str(), result.Checksum.c_str(), result.Seconds);
+        }
+    }
+    return allCompleted ? EXITCODE_OK : EXITCODE_FAIL;
+#endif // _WIN32
+}
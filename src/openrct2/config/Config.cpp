@@ -15,6 +15,7 @@
 #include "../core/Console.hpp"
 #include "../core/File.h"
 #include "../core/FileStream.h"
+#include "../core/Imaging.h"
 #include "../core/Memory.hpp"
 #include "../core/Path.hpp"
 #include "../core/String.hpp"
@@ -208,7 +209,9 @@ namespace Config
             model->scale_quality = reader->GetEnum<ScaleQuality>(
                 "scale_quality", ScaleQuality::SmoothNearestNeighbour, Enum_ScaleQuality);
             model->show_fps = reader->GetBoolean("show_fps", false);
+            model->show_performance_overlay = reader->GetBoolean("show_performance_overlay", false);
             model->multithreading = reader->GetBoolean("multi_threading", false);
+            model->object_image_budget = reader->GetInt32("object_image_budget", 0);
             model->trap_cursor = reader->GetBoolean("trap_cursor", false);
             model->auto_open_shops = reader->GetBoolean("auto_open_shops", false);
             model->scenario_select_mode = reader->GetInt32("scenario_select_mode", SCENARIO_SELECT_MODE_ORIGIN);
@@ -227,6 +230,8 @@ namespace Config
             model->show_real_names_of_guests = reader->GetBoolean("show_real_names_of_guests", true);
             model->allow_early_completion = reader->GetBoolean("allow_early_completion", false);
             model->transparent_screenshot = reader->GetBoolean("transparent_screenshot", true);
+            model->screenshot_compression_level = reader->GetInt32(
+                "screenshot_compression_level", Imaging::DefaultPngCompressionLevel);
             model->last_version_check_time = reader->GetInt64("last_version_check_time", 0);
         }
     }
@@ -284,7 +289,9 @@ namespace Config
         writer->WriteFloat("window_scale", model->window_scale);
         writer->WriteEnum<ScaleQuality>("scale_quality", model->scale_quality, Enum_ScaleQuality);
         writer->WriteBoolean("show_fps", model->show_fps);
+        writer->WriteBoolean("show_performance_overlay", model->show_performance_overlay);
         writer->WriteBoolean("multi_threading", model->multithreading);
+        writer->WriteInt32("object_image_budget", model->object_image_budget);
         writer->WriteBoolean("trap_cursor", model->trap_cursor);
         writer->WriteBoolean("auto_open_shops", model->auto_open_shops);
         writer->WriteInt32("scenario_select_mode", model->scenario_select_mode);
@@ -304,6 +311,7 @@ namespace Config
         writer->WriteBoolean("allow_early_completion", model->allow_early_completion);
         writer->WriteEnum<VirtualFloorStyles>("virtual_floor_style", model->virtual_floor_style, Enum_VirtualFloorStyle);
         writer->WriteBoolean("transparent_screenshot", model->transparent_screenshot);
+        writer->WriteInt32("screenshot_compression_level", model->screenshot_compression_level);
         writer->WriteInt64("last_version_check_time", model->last_version_check_time);
     }
 
@@ -548,6 +556,8 @@ namespace Config
             auto model = &gConfigPlugin;
             model->enable_hot_reloading = reader->GetBoolean("enable_hot_reloading", false);
             model->allowed_hosts = reader->GetString("allowed_hosts", "");
+            model->soft_budget_us = reader->GetInt32("soft_budget_us", 2000);
+            model->hard_budget_us = reader->GetInt32("hard_budget_us", 0);
         }
     }
 
@@ -557,6 +567,8 @@ namespace Config
         writer->WriteSection("plugin");
         writer->WriteBoolean("enable_hot_reloading", model->enable_hot_reloading);
         writer->WriteString("allowed_hosts", model->allowed_hosts);
+        writer->WriteInt32("soft_budget_us", model->soft_budget_us);
+        writer->WriteInt32("hard_budget_us", model->hard_budget_us);
     }
 
     static bool SetDefaults()
@@ -998,9 +1010,9 @@ bool RCT1DataPresentAtLocation(const utf8* path)
     return Csg1datPresentAtLocation(path) && Csg1idatPresentAtLocation(path) && CsgAtLocationIsUsable(path);
 }
 
-bool CsgIsUsable(const rct_gx& csg)
+bool CsgIsUsable(const rct_g1_header& csgHeader)
 {
-    return csg.header.total_size == RCT1_LL_CSG1_DAT_FILE_SIZE && csg.header.num_entries == RCT1_NUM_LL_CSG_ENTRIES;
+    return csgHeader.total_size == RCT1_LL_CSG1_DAT_FILE_SIZE && csgHeader.num_entries == RCT1_NUM_LL_CSG_ENTRIES;
 }
 
 bool CsgAtLocationIsUsable(const utf8* path)
@@ -1022,8 +1034,8 @@ bool CsgAtLocationIsUsable(const utf8* path)
     size_t fileHeaderSize = fileHeader.GetLength();
     size_t fileDataSize = fileData.GetLength();
 
-    rct_gx csg = {};
-    csg.header.num_entries = static_cast<uint32_t>(fileHeaderSize / sizeof(rct_g1_element_32bit));
-    csg.header.total_size = static_cast<uint32_t>(fileDataSize);
-    return CsgIsUsable(csg);
+    rct_g1_header csgHeader = {};
+    csgHeader.num_entries = static_cast<uint32_t>(fileHeaderSize / sizeof(rct_g1_element_32bit));
+    csgHeader.total_size = static_cast<uint32_t>(fileDataSize);
+    return CsgIsUsable(csgHeader);
 }
@@ -41,7 +41,9 @@ struct GeneralConfiguration
     bool uncap_fps;
     bool use_vsync;
     bool show_fps;
+    bool show_performance_overlay;
     bool multithreading;
+    int32_t object_image_budget;
     bool minimize_fullscreen_focus_loss;
     bool disable_screensaver;
 
@@ -58,6 +60,7 @@ struct GeneralConfiguration
     bool disable_lightning_effect;
     bool show_guest_purchases;
     bool transparent_screenshot;
+    int32_t screenshot_compression_level;
 
     // Localisation
     int32_t language;
@@ -207,6 +210,8 @@ struct PluginConfiguration
 {
     bool enable_hot_reloading;
     std::string allowed_hosts;
+    int32_t soft_budget_us;
+    int32_t hard_budget_us;
 };
 
 enum class Sort : int32_t
@@ -258,5 +263,5 @@ std::string FindCsg1datAtLocation(const utf8* path);
 bool Csg1datPresentAtLocation(const utf8* path);
 std::string FindCsg1idatAtLocation(const utf8* path);
 bool Csg1idatPresentAtLocation(const utf8* path);
-bool CsgIsUsable(const rct_gx& csg);
+bool CsgIsUsable(const rct_g1_header& csgHeader);
 bool CsgAtLocationIsUsable(const utf8* path);
@@ -0,0 +1,66 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "Allocations.h"
+
+#if defined(ENABLE_TRACING) || defined(USE_BENCHMARK)
+
+#    include <atomic>
+#    include <cstdlib>
+#    include <new>
+
+static std::atomic<uint64_t> _numAllocations{};
+static thread_local uint64_t _numThreadAllocations;
+
+// The default array and nothrow forms call this one, over-aligned allocations are not counted
+void* operator new(size_t size)
+{
+    _numAllocations.fetch_add(1, std::memory_order_relaxed);
+    _numThreadAllocations++;
+    void* ptr = std::malloc(size == 0 ? 1 : size);
+    if (ptr == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+    std::free(ptr);
+}
+
+uint64_t OpenRCT2::Allocations::GetCount()
+{
+    return _numAllocations.load(std::memory_order_relaxed);
+}
+
+uint64_t OpenRCT2::Allocations::GetThreadCount()
+{
+    return _numThreadAllocations;
+}
+
+#else
+
+uint64_t OpenRCT2::Allocations::GetCount()
+{
+    return 0;
+}
+
+uint64_t OpenRCT2::Allocations::GetThreadCount()
+{
+    return 0;
+}
+
+#endif
@@ -0,0 +1,38 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+/**
+ * Counts the heap allocations made through operator new. The counting replaces the global operator new, so it is only
+ * compiled into tracing (ENABLE_TRACING) and benchmark builds, the counts stay 0 otherwise.
+ */
+namespace OpenRCT2::Allocations
+{
+    constexpr bool IsTracked()
+    {
+#if defined(ENABLE_TRACING) || defined(USE_BENCHMARK)
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    /**
+     * The number of allocations made by all threads so far.
+     */
+    uint64_t GetCount();
+
+    /**
+     * The number of allocations made by the calling thread so far.
+     */
+    uint64_t GetThreadCount();
+} // namespace OpenRCT2::Allocations
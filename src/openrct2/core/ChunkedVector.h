@@ -0,0 +1,219 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <vector>
+
+/**
+ * A vector that grows in fixed size chunks, elements never move once they are added so pointers to them stay valid
+ * until the vector is cleared. Clearing keeps the chunks for reuse.
+ */
+template<typename T, size_t TChunkSize> class ChunkedVector
+{
+    using chunk = std::array<T, TChunkSize>;
+
+public:
+    using value_type = T;
+    using reference_type = value_type&;
+    using const_reference_type = const value_type&;
+
+    template<typename TVector, typename TValue> class basic_iterator
+    {
+    private:
+        TVector* _vector;
+        size_t _index;
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = TValue;
+        using difference_type = std::ptrdiff_t;
+        using pointer = TValue*;
+        using reference = TValue&;
+
+        basic_iterator(TVector* vector, size_t index)
+            : _vector(vector)
+            , _index(index)
+        {
+        }
+
+        reference operator*() const
+        {
+            return (*_vector)[_index];
+        }
+
+        pointer operator->() const
+        {
+            return &(*_vector)[_index];
+        }
+
+        basic_iterator& operator++()
+        {
+            _index++;
+            return *this;
+        }
+
+        basic_iterator operator++(int)
+        {
+            auto result = *this;
+            _index++;
+            return result;
+        }
+
+        bool operator==(const basic_iterator& rhs) const
+        {
+            return _index == rhs._index;
+        }
+
+        bool operator!=(const basic_iterator& rhs) const
+        {
+            return _index != rhs._index;
+        }
+    };
+
+    using iterator = basic_iterator<ChunkedVector, T>;
+    using const_iterator = basic_iterator<const ChunkedVector, const T>;
+
+    ChunkedVector() = default;
+    ChunkedVector(ChunkedVector&&) = default;
+    ChunkedVector& operator=(ChunkedVector&&) = default;
+
+    ChunkedVector(const ChunkedVector& other)
+    {
+        *this = other;
+    }
+
+    ChunkedVector& operator=(const ChunkedVector& other)
+    {
+        if (this != &other)
+        {
+            reserve(other._count);
+            for (size_t i = 0; i < other._count; i += TChunkSize)
+            {
+                auto& src = *other._chunks[i / TChunkSize];
+                std::copy_n(src.begin(), std::min(TChunkSize, other._count - i), _chunks[i / TChunkSize]->begin());
+            }
+            _count = other._count;
+            _peak = other._peak;
+        }
+        return *this;
+    }
+
+    iterator begin()
+    {
+        return iterator(this, 0);
+    }
+
+    iterator end()
+    {
+        return iterator(this, _count);
+    }
+
+    const_iterator begin() const
+    {
+        return const_iterator(this, 0);
+    }
+
+    const_iterator end() const
+    {
+        return const_iterator(this, _count);
+    }
+
+    template<typename... Args> reference_type emplace_back(Args&&... args)
+    {
+        const auto chunkIndex = _count / TChunkSize;
+        if (chunkIndex == _chunks.size())
+        {
+            _chunks.push_back(std::make_unique<chunk>());
+        }
+        reference_type res = (*_chunks[chunkIndex])[_count % TChunkSize];
+        ::new (&res) T(std::forward<Args&&>(args)...);
+        _count++;
+        return res;
+    }
+
+    reference_type operator[](const size_t n)
+    {
+        return (*_chunks[n / TChunkSize])[n % TChunkSize];
+    }
+
+    const_reference_type operator[](const size_t n) const
+    {
+        return (*_chunks[n / TChunkSize])[n % TChunkSize];
+    }
+
+    /**
+     * Returns the index of the element at the given address, or size() if it is not an element of this vector.
+     */
+    size_t index_of(const T* element) const
+    {
+        for (size_t i = 0; i < _chunks.size(); i++)
+        {
+            const T* first = _chunks[i]->data();
+            if (element >= first && element < first + TChunkSize)
+            {
+                const auto index = i * TChunkSize + static_cast<size_t>(element - first);
+                return index < _count ? index : _count;
+            }
+        }
+        return _count;
+    }
+
+    void reserve(size_t n)
+    {
+        while (capacity() < n)
+        {
+            _chunks.push_back(std::make_unique<chunk>());
+        }
+    }
+
+    void clear()
+    {
+        _peak = std::max(_peak, _count);
+        _count = 0;
+    }
+
+    // Releases the chunks that are not needed for the current elements.
+    void shrink_to_fit()
+    {
+        _chunks.resize((_count + TChunkSize - 1) / TChunkSize);
+    }
+
+    size_t size() const
+    {
+        return _count;
+    }
+
+    // The largest number of elements held at once since construction.
+    size_t peak_size() const
+    {
+        return std::max(_peak, _count);
+    }
+
+    size_t capacity() const
+    {
+        return _chunks.size() * TChunkSize;
+    }
+
+    bool empty() const
+    {
+        return _count == 0;
+    }
+
+private:
+    std::vector<std::unique_ptr<chunk>> _chunks;
+    size_t _count = 0;
+    size_t _peak = 0;
+};
@@ -23,11 +23,15 @@
 #include "Endianness.h"
 #include "MemoryStream.h"
 
+#include <algorithm>
 #include <cstdio>
 #include <iomanip>
 #include <iostream>
+#include <iterator>
 #include <sstream>
 #include <stdexcept>
+#include <type_traits>
+#include <vector>
 
 template<typename T> struct DataSerializerTraits_t
 {
@@ -294,6 +298,49 @@ template<> struct DataSerializerTraits_t<OpenRCT2::MemoryStream>
     }
 };
 
+/**
+ * Integers are stored big endian, so spans of them can be written and read as one block rather than through a
+ * stream call per element. Wider types are swapped through a small buffer on the stack.
+ */
+template<typename _Ty> struct DataSerializerTraitsSpan
+{
+    static constexpr bool IsBulk = std::is_integral_v<_Ty> && !std::is_same_v<_Ty, bool>;
+
+    static void encode(OpenRCT2::IStream* stream, const _Ty* data, size_t count)
+    {
+        if constexpr (sizeof(_Ty) == 1)
+        {
+            stream->Write(data, count);
+        }
+        else
+        {
+            _Ty buffer[256];
+            while (count != 0)
+            {
+                size_t chunk = std::min<size_t>(count, std::size(buffer));
+                for (size_t i = 0; i < chunk; i++)
+                {
+                    buffer[i] = ByteSwapBE(data[i]);
+                }
+                stream->Write(buffer, chunk * sizeof(_Ty));
+                data += chunk;
+                count -= chunk;
+            }
+        }
+    }
+    static void decode(OpenRCT2::IStream* stream, _Ty* data, size_t count)
+    {
+        stream->Read(data, count * sizeof(_Ty));
+        if constexpr (sizeof(_Ty) != 1)
+        {
+            for (size_t i = 0; i < count; i++)
+            {
+                data[i] = ByteSwapBE(data[i]);
+            }
+        }
+    }
+};
+
 template<typename _Ty, size_t _Size> struct DataSerializerTraitsPODArray
 {
     static void encode(OpenRCT2::IStream* stream, const _Ty (&val)[_Size])
@@ -302,10 +349,17 @@ template<typename _Ty, size_t _Size> struct DataSerializerTraitsPODArray
         uint16_t swapped = ByteSwapBE(len);
         stream->Write(&swapped);
 
-        DataSerializerTraits<uint8_t> s;
-        for (auto&& sub : val)
+        if constexpr (sizeof(_Ty) == 1)
+        {
+            DataSerializerTraitsSpan<_Ty>::encode(stream, val, _Size);
+        }
+        else
         {
-            s.encode(stream, sub);
+            DataSerializerTraits<uint8_t> s;
+            for (auto&& sub : val)
+            {
+                s.encode(stream, sub);
+            }
         }
     }
     static void decode(OpenRCT2::IStream* stream, _Ty (&val)[_Size])
@@ -317,11 +371,7 @@ template<typename _Ty, size_t _Size> struct DataSerializerTraitsPODArray
         if (len != _Size)
             throw std::runtime_error("Invalid size, can't decode");
 
-        DataSerializerTraits<_Ty> s;
-        for (auto&& sub : val)
-        {
-            s.decode(stream, sub);
-        }
+        DataSerializerTraitsSpan<_Ty>::decode(stream, val, _Size);
     }
     static void log(OpenRCT2::IStream* stream, const _Ty (&val)[_Size])
     {
@@ -364,10 +414,17 @@ template<typename _Ty, size_t _Size> struct DataSerializerTraits_t<std::array<_T
         uint16_t swapped = ByteSwapBE(len);
         stream->Write(&swapped);
 
-        DataSerializerTraits<_Ty> s;
-        for (auto&& sub : val)
+        if constexpr (DataSerializerTraitsSpan<_Ty>::IsBulk)
         {
-            s.encode(stream, sub);
+            DataSerializerTraitsSpan<_Ty>::encode(stream, val.data(), _Size);
+        }
+        else
+        {
+            DataSerializerTraits<_Ty> s;
+            for (auto&& sub : val)
+            {
+                s.encode(stream, sub);
+            }
         }
     }
     static void decode(OpenRCT2::IStream* stream, std::array<_Ty, _Size>& val)
@@ -379,10 +436,17 @@ template<typename _Ty, size_t _Size> struct DataSerializerTraits_t<std::array<_T
         if (len != _Size)
             throw std::runtime_error("Invalid size, can't decode");
 
-        DataSerializerTraits<_Ty> s;
-        for (auto&& sub : val)
+        if constexpr (DataSerializerTraitsSpan<_Ty>::IsBulk)
         {
-            s.decode(stream, sub);
+            DataSerializerTraitsSpan<_Ty>::decode(stream, val.data(), _Size);
+        }
+        else
+        {
+            DataSerializerTraits<_Ty> s;
+            for (auto&& sub : val)
+            {
+                s.decode(stream, sub);
+            }
         }
     }
     static void log(OpenRCT2::IStream* stream, const std::array<_Ty, _Size>& val)
@@ -406,10 +470,17 @@ template<typename _Ty> struct DataSerializerTraits_t<std::vector<_Ty>>
         uint16_t swapped = ByteSwapBE(len);
         stream->Write(&swapped);
 
-        DataSerializerTraits<_Ty> s;
-        for (auto&& sub : val)
+        if constexpr (DataSerializerTraitsSpan<_Ty>::IsBulk)
         {
-            s.encode(stream, sub);
+            DataSerializerTraitsSpan<_Ty>::encode(stream, val.data(), len);
+        }
+        else
+        {
+            DataSerializerTraits<_Ty> s;
+            for (auto&& sub : val)
+            {
+                s.encode(stream, sub);
+            }
         }
     }
     static void decode(OpenRCT2::IStream* stream, std::vector<_Ty>& val)
@@ -418,12 +489,22 @@ template<typename _Ty> struct DataSerializerTraits_t<std::vector<_Ty>>
         stream->Read(&len);
         len = ByteSwapBE(len);
 
-        DataSerializerTraits<_Ty> s;
-        for (auto i = 0; i < len; ++i)
+        if constexpr (DataSerializerTraitsSpan<_Ty>::IsBulk)
         {
-            _Ty sub{};
-            s.decode(stream, sub);
-            val.push_back(std::move(sub));
+            const size_t offset = val.size();
+            val.resize(offset + len);
+            DataSerializerTraitsSpan<_Ty>::decode(stream, val.data() + offset, len);
+        }
+        else
+        {
+            DataSerializerTraits<_Ty> s;
+            val.reserve(val.size() + len);
+            for (auto i = 0; i < len; ++i)
+            {
+                _Ty sub{};
+                s.decode(stream, sub);
+                val.push_back(std::move(sub));
+            }
         }
     }
     static void log(OpenRCT2::IStream* stream, const std::vector<_Ty>& val)
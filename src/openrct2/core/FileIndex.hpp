@@ -19,9 +19,10 @@
 #include "Path.hpp"
 
 #include <chrono>
-#include <list>
+#include <optional>
 #include <string>
 #include <tuple>
+#include <unordered_map>
 #include <vector>
 
 template<typename TItem> class FileIndex
@@ -35,18 +36,48 @@ private:
         uint32_t PathChecksum = 0;
     };
 
+    struct FileFingerprint
+    {
+        std::string Path;
+        uint64_t Size = 0;
+        uint64_t LastModified = 0;
+
+        bool operator==(const FileFingerprint& other) const
+        {
+            return Path == other.Path && Size == other.Size && LastModified == other.LastModified;
+        }
+    };
+
     struct ScanResult
     {
         DirectoryStats const Stats;
-        std::vector<std::string> const Files;
+        std::vector<FileFingerprint> const Files;
 
-        ScanResult(DirectoryStats stats, std::vector<std::string> files)
+        ScanResult(DirectoryStats stats, std::vector<FileFingerprint> files)
             : Stats(stats)
             , Files(files)
         {
         }
     };
 
+    /**
+     * The result of indexing a single file, files that did not produce an item are recorded as well so that they are
+     * not parsed again until they change.
+     */
+    struct FileRecord
+    {
+        FileFingerprint File;
+        std::optional<TItem> Item;
+    };
+
+    struct ReadIndexResult
+    {
+        bool UpToDate = false;
+        std::vector<TItem> Items;
+        // Records of a compatible, but out of date index which can be reused for unchanged files.
+        std::vector<FileRecord> Records;
+    };
+
     struct FileIndexHeader
     {
         uint32_t HeaderSize = sizeof(FileIndexHeader);
@@ -55,11 +86,11 @@ private:
         uint8_t VersionB = 0;
         uint16_t LanguageId = 0;
         DirectoryStats Stats;
-        uint32_t NumItems = 0;
+        uint32_t NumRecords = 0;
     };
 
     // Index file format version which when incremented forces a rebuild
-    static constexpr uint8_t FILE_INDEX_VERSION = 4;
+    static constexpr uint8_t FILE_INDEX_VERSION = 5;
 
     std::string const _name;
     uint32_t const _magicNumber;
@@ -97,29 +128,26 @@ public:
     /**
      * Queries and directories and loads the index header. If the index is up to date,
      * the items are loaded from the index and returned, otherwise the index is rebuilt.
+     * Only files that were added or changed since the index was written are loaded again.
      */
     std::vector<TItem> LoadOrBuild(int32_t language) const
     {
-        std::vector<TItem> items;
         auto scanResult = Scan();
         auto readIndexResult = ReadIndexFile(language, scanResult.Stats);
-        if (std::get<0>(readIndexResult))
+        if (readIndexResult.UpToDate)
         {
             // Index was loaded
-            items = std::get<1>(readIndexResult);
-        }
-        else
-        {
-            // Index was not loaded
-            items = Build(language, scanResult);
+            return std::move(readIndexResult.Items);
         }
-        return items;
+
+        // Index was not loaded or is out of date
+        return Build(language, scanResult, std::move(readIndexResult.Records));
     }
 
     std::vector<TItem> Rebuild(int32_t language) const
     {
         auto scanResult = Scan();
-        auto items = Build(language, scanResult);
+        auto items = Build(language, scanResult, {});
         return items;
     }
 
@@ -139,41 +167,36 @@ private:
     ScanResult Scan() const
     {
         DirectoryStats stats{};
-        std::vector<std::string> files;
+        std::vector<FileFingerprint> files;
         for (const auto& directory : SearchPaths)
         {
             auto absoluteDirectory = Path::GetAbsolute(directory);
             log_verbose("FileIndex:Scanning for %s in '%s'", _pattern.c_str(), absoluteDirectory.c_str());
 
             auto pattern = Path::Combine(absoluteDirectory, _pattern);
-            auto scanner = Path::ScanDirectory(pattern, true);
-            while (scanner->Next())
+            for (auto& file : Path::ScanDirectoryParallel(pattern, true))
             {
-                auto fileInfo = scanner->GetFileInfo();
-                auto path = std::string(scanner->GetPath());
-
                 stats.TotalFiles++;
-                stats.TotalFileSize += fileInfo->Size;
-                stats.FileDateModifiedChecksum ^= static_cast<uint32_t>(fileInfo->LastModified >> 32)
-                    ^ static_cast<uint32_t>(fileInfo->LastModified & 0xFFFFFFFF);
+                stats.TotalFileSize += file.Size;
+                stats.FileDateModifiedChecksum ^= static_cast<uint32_t>(file.LastModified >> 32)
+                    ^ static_cast<uint32_t>(file.LastModified & 0xFFFFFFFF);
                 stats.FileDateModifiedChecksum = ror32(stats.FileDateModifiedChecksum, 5);
-                stats.PathChecksum += GetPathChecksum(path);
+                stats.PathChecksum += GetPathChecksum(file.Path);
 
-                files.push_back(std::move(path));
+                files.push_back({ std::move(file.Path), file.Size, file.LastModified });
             }
-            delete scanner;
         }
         return ScanResult(stats, files);
     }
 
     void BuildRange(
-        int32_t language, const ScanResult& scanResult, size_t rangeStart, size_t rangeEnd, std::vector<TItem>& items,
-        std::atomic<size_t>& processed, std::mutex& printLock) const
+        int32_t language, const ScanResult& scanResult, const std::vector<size_t>& fileIndices, size_t rangeStart,
+        size_t rangeEnd, std::vector<FileRecord>& records, std::atomic<size_t>& processed, std::mutex& printLock) const
     {
-        items.reserve(rangeEnd - rangeStart);
         for (size_t i = rangeStart; i < rangeEnd; i++)
         {
-            const auto& filePath = scanResult.Files.at(i);
+            const auto fileIndex = fileIndices[i];
+            const auto& filePath = scanResult.Files.at(fileIndex).Path;
 
             if (_log_levels[static_cast<uint8_t>(DiagnosticLevel::Verbose)])
             {
@@ -184,28 +207,61 @@ private:
             auto item = Create(language, filePath);
             if (std::get<0>(item))
             {
-                items.push_back(std::get<1>(item));
+                records[fileIndex].Item = std::move(std::get<1>(item));
             }
 
             processed++;
         }
     }
 
-    std::vector<TItem> Build(int32_t language, const ScanResult& scanResult) const
+    std::vector<TItem> Build(int32_t language, const ScanResult& scanResult, std::vector<FileRecord> previousRecords) const
     {
-        std::vector<TItem> allItems;
-        Console::WriteLine("Building %s (%zu items)", _name.c_str(), scanResult.Files.size());
-
         auto startTime = std::chrono::high_resolution_clock::now();
 
-        const size_t totalCount = scanResult.Files.size();
+        // Reuse the records of all files that have not been changed since the index was last written.
+        std::unordered_map<std::string, FileRecord*> previousRecordMap;
+        previousRecordMap.reserve(previousRecords.size());
+        for (auto& record : previousRecords)
+        {
+            previousRecordMap.emplace(record.File.Path, &record);
+        }
+
+        const size_t totalFiles = scanResult.Files.size();
+        std::vector<FileRecord> records(totalFiles);
+        std::vector<size_t> changedFiles;
+        for (size_t i = 0; i < totalFiles; i++)
+        {
+            const auto& file = scanResult.Files[i];
+            records[i].File = file;
+
+            auto itr = previousRecordMap.find(file.Path);
+            if (itr != previousRecordMap.end() && itr->second->File == file)
+            {
+                records[i].Item = std::move(itr->second->Item);
+            }
+            else
+            {
+                changedFiles.push_back(i);
+            }
+        }
+        previousRecordMap.clear();
+        previousRecords.clear();
+
+        if (changedFiles.size() == totalFiles)
+        {
+            Console::WriteLine("Building %s (%zu items)", _name.c_str(), totalFiles);
+        }
+        else
+        {
+            Console::WriteLine("Updating %s (%zu of %zu items changed)", _name.c_str(), changedFiles.size(), totalFiles);
+        }
+
+        const size_t totalCount = changedFiles.size();
         if (totalCount > 0)
         {
             JobPool jobPool;
             std::mutex printLock; // For verbose prints.
 
-            std::list<std::vector<TItem>> containers;
-
             size_t stepSize = 100; // Handpicked, seems to work well with 4/8 cores.
 
             std::atomic<size_t> processed = ATOMIC_VAR_INIT(0);
@@ -222,25 +278,28 @@ private:
                     stepSize = totalCount - rangeStart;
                 }
 
-                auto& items = containers.emplace_back();
-
                 jobPool.AddTask(std::bind(
-                    &FileIndex<TItem>::BuildRange, this, language, std::cref(scanResult), rangeStart, rangeStart + stepSize,
-                    std::ref(items), std::ref(processed), std::ref(printLock)));
+                    &FileIndex<TItem>::BuildRange, this, language, std::cref(scanResult), std::cref(changedFiles), rangeStart,
+                    rangeStart + stepSize, std::ref(records), std::ref(processed), std::ref(printLock)));
 
                 reportProgress();
             }
 
             jobPool.Join(reportProgress);
+        }
 
-            for (const auto& itr : containers)
+        WriteIndexFile(language, scanResult.Stats, records);
+
+        std::vector<TItem> allItems;
+        allItems.reserve(records.size());
+        for (auto& record : records)
+        {
+            if (record.Item)
             {
-                allItems.insert(allItems.end(), itr.begin(), itr.end());
+                allItems.push_back(std::move(*record.Item));
             }
         }
 
-        WriteIndexFile(language, scanResult.Stats, allItems);
-
         auto endTime = std::chrono::high_resolution_clock::now();
         auto duration = std::chrono::duration<float>(endTime - startTime);
         Console::WriteLine("Finished building %s in %.2f seconds.", _name.c_str(), duration.count());
@@ -248,10 +307,9 @@ private:
         return allItems;
     }
 
-    std::tuple<bool, std::vector<TItem>> ReadIndexFile(int32_t language, const DirectoryStats& stats) const
+    ReadIndexResult ReadIndexFile(int32_t language, const DirectoryStats& stats) const
     {
-        bool loadedItems = false;
-        std::vector<TItem> items;
+        ReadIndexResult result;
         if (File::Exists(_indexPath))
         {
             try
@@ -259,24 +317,32 @@ private:
                 log_verbose("FileIndex:Loading index: '%s'", _indexPath.c_str());
                 auto fs = OpenRCT2::FileStream(_indexPath, OpenRCT2::FILE_MODE_OPEN);
 
-                // Read header, check if we need to re-scan
+                // Read header, check if the records are compatible and whether we need to re-scan
                 auto header = fs.ReadValue<FileIndexHeader>();
                 if (header.HeaderSize == sizeof(FileIndexHeader) && header.MagicNumber == _magicNumber
-                    && header.VersionA == FILE_INDEX_VERSION && header.VersionB == _version && header.LanguageId == language
-                    && header.Stats.TotalFiles == stats.TotalFiles && header.Stats.TotalFileSize == stats.TotalFileSize
-                    && header.Stats.FileDateModifiedChecksum == stats.FileDateModifiedChecksum
-                    && header.Stats.PathChecksum == stats.PathChecksum)
+                    && header.VersionA == FILE_INDEX_VERSION && header.VersionB == _version && header.LanguageId == language)
                 {
-                    items.reserve(header.NumItems);
-                    DataSerialiser ds(false, fs);
-                    // Directory is the same, just read the saved items
-                    for (uint32_t i = 0; i < header.NumItems; i++)
+                    auto records = ReadRecords(fs, header.NumRecords);
+                    if (header.Stats.TotalFiles == stats.TotalFiles && header.Stats.TotalFileSize == stats.TotalFileSize
+                        && header.Stats.FileDateModifiedChecksum == stats.FileDateModifiedChecksum
+                        && header.Stats.PathChecksum == stats.PathChecksum)
+                    {
+                        // Directory is the same, just use the saved items
+                        result.Items.reserve(records.size());
+                        for (auto& record : records)
+                        {
+                            if (record.Item)
+                            {
+                                result.Items.push_back(std::move(*record.Item));
+                            }
+                        }
+                        result.UpToDate = true;
+                    }
+                    else
                     {
-                        TItem item;
-                        Serialise(ds, item);
-                        items.emplace_back(std::move(item));
+                        Console::WriteLine("%s out of date", _name.c_str());
+                        result.Records = std::move(records);
                     }
-                    loadedItems = true;
                 }
                 else
                 {
@@ -287,12 +353,36 @@ private:
             {
                 Console::Error::WriteLine("Unable to load index: '%s'.", _indexPath.c_str());
                 Console::Error::WriteLine("%s", e.what());
+                result = {};
+            }
+        }
+        return result;
+    }
+
+    std::vector<FileRecord> ReadRecords(OpenRCT2::IStream& stream, uint32_t numRecords) const
+    {
+        std::vector<FileRecord> records;
+        records.reserve(numRecords);
+        DataSerialiser ds(false, stream);
+        for (uint32_t i = 0; i < numRecords; i++)
+        {
+            auto& record = records.emplace_back();
+            bool hasItem = false;
+            ds << record.File.Path;
+            ds << record.File.Size;
+            ds << record.File.LastModified;
+            ds << hasItem;
+            if (hasItem)
+            {
+                TItem item;
+                Serialise(ds, item);
+                record.Item = std::move(item);
             }
         }
-        return std::make_tuple(loadedItems, std::move(items));
+        return records;
     }
 
-    void WriteIndexFile(int32_t language, const DirectoryStats& stats, std::vector<TItem>& items) const
+    void WriteIndexFile(int32_t language, const DirectoryStats& stats, std::vector<FileRecord>& records) const
     {
         try
         {
@@ -307,14 +397,22 @@ private:
             header.VersionB = _version;
             header.LanguageId = language;
             header.Stats = stats;
-            header.NumItems = static_cast<uint32_t>(items.size());
+            header.NumRecords = static_cast<uint32_t>(records.size());
             fs.WriteValue(header);
 
             DataSerialiser ds(true, fs);
-            // Write items
-            for (auto& item : items)
+            // Write a record for every file, followed by its item if it has one
+            for (auto& record : records)
             {
-                Serialise(ds, item);
+                bool hasItem = record.Item.has_value();
+                ds << record.File.Path;
+                ds << record.File.Size;
+                ds << record.File.LastModified;
+                ds << hasItem;
+                if (hasItem)
+                {
+                    Serialise(ds, *record.Item);
+                }
             }
         }
         catch (const std::exception& e)
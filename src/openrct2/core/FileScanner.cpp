@@ -24,10 +24,12 @@
 #endif
 
 #include "FileScanner.h"
+#include "JobPool.h"
 #include "Memory.hpp"
 #include "Path.hpp"
 #include "String.hpp"
 
+#include <functional>
 #include <memory>
 #include <stack>
 #include <string>
@@ -164,17 +166,7 @@ public:
 
     virtual void GetDirectoryChildren(std::vector<DirectoryChild>& children, const std::string& path) abstract;
 
-private:
-    void PushState(const std::string& directory)
-    {
-        DirectoryState newState;
-        newState.Path = directory;
-        newState.Index = -1;
-        GetDirectoryChildren(newState.Listing, directory);
-        _directoryStack.push(newState);
-    }
-
-    bool PatternMatch(const std::string& fileName)
+    bool PatternMatch(const std::string& fileName) const
     {
         for (const auto& pattern : _patterns)
         {
@@ -186,6 +178,16 @@ private:
         return false;
     }
 
+private:
+    void PushState(const std::string& directory)
+    {
+        DirectoryState newState;
+        newState.Path = directory;
+        newState.Index = -1;
+        GetDirectoryChildren(newState.Listing, directory);
+        _directoryStack.push(newState);
+    }
+
     static std::vector<std::string> GetPatterns(const std::string& delimitedPatterns)
     {
         std::vector<std::string> patterns;
@@ -369,6 +371,77 @@ void Path::QueryDirectory(QueryDirectoryResult* result, const std::string& patte
     delete scanner;
 }
 
+static std::string AppendPath(const std::string& directory, const std::string& name)
+{
+    utf8 path[MAX_PATH];
+    String::Set(path, sizeof(path), directory.c_str());
+    Path::Append(path, sizeof(path), name.c_str());
+    return path;
+}
+
+std::vector<ScannedFile> Path::ScanDirectoryParallel(const std::string& pattern, bool recurse, size_t maxThreads)
+{
+    struct ScannedDirectory
+    {
+        std::string Path;
+        std::vector<DirectoryChild> Listing;
+        // The sub directories in the order of the listing
+        std::vector<std::unique_ptr<ScannedDirectory>> SubDirectories;
+    };
+
+    // Listing a directory does not touch the state of the scanner, so one is shared by all threads
+    auto scanner = std::unique_ptr<IFileScanner>(ScanDirectory(pattern, recurse));
+    auto baseScanner = static_cast<FileScannerBase*>(scanner.get());
+
+    ScannedDirectory root;
+    root.Path = Path::GetDirectory(pattern);
+    {
+        JobPool jobs(maxThreads);
+        std::function<void(ScannedDirectory*)> readDirectory = [&](ScannedDirectory* directory) {
+            baseScanner->GetDirectoryChildren(directory->Listing, directory->Path);
+            if (!recurse)
+                return;
+
+            for (const auto& child : directory->Listing)
+            {
+                if (child.Type == DIRECTORY_CHILD_TYPE::DC_DIRECTORY)
+                {
+                    auto& subDirectory = directory->SubDirectories.emplace_back(std::make_unique<ScannedDirectory>());
+                    subDirectory->Path = AppendPath(directory->Path, child.Name);
+                }
+            }
+            for (auto& subDirectory : directory->SubDirectories)
+            {
+                jobs.AddTask([&readDirectory, subDirectory = subDirectory.get()]() { readDirectory(subDirectory); });
+            }
+        };
+        jobs.AddTask([&readDirectory, &root]() { readDirectory(&root); });
+        jobs.Join();
+    }
+
+    // Walk the listings depth first like the scanner does, so the order only depends on the listings
+    std::vector<ScannedFile> files;
+    std::function<void(const ScannedDirectory&)> addFiles = [&](const ScannedDirectory& directory) {
+        size_t subDirectoryIndex = 0;
+        for (const auto& child : directory.Listing)
+        {
+            if (child.Type == DIRECTORY_CHILD_TYPE::DC_DIRECTORY)
+            {
+                if (recurse)
+                {
+                    addFiles(*directory.SubDirectories[subDirectoryIndex++]);
+                }
+            }
+            else if (baseScanner->PatternMatch(child.Name))
+            {
+                files.push_back({ AppendPath(directory.Path, child.Name), child.Size, child.LastModified });
+            }
+        }
+    };
+    addFiles(root);
+    return files;
+}
+
 std::vector<std::string> Path::GetDirectories(const std::string& path)
 {
     auto scanner = std::unique_ptr<IFileScanner>(ScanDirectory(path, false));
@@ -21,6 +21,13 @@ struct FileInfo
     uint64_t LastModified;
 };
 
+struct ScannedFile
+{
+    std::string Path;
+    uint64_t Size;
+    uint64_t LastModified;
+};
+
 struct IFileScanner
 {
     virtual ~IFileScanner() = default;
@@ -59,5 +66,14 @@ namespace Path
      */
     void QueryDirectory(QueryDirectoryResult* result, const std::string& pattern);
 
+    /**
+     * Scans like ScanDirectory but reads the directories on several threads at once, which hides the latency of slow
+     * and network file systems. The files are returned in the order ScanDirectory would enumerate them.
+     * @param pattern The path followed by a semi-colon delimited list of wildcard patterns.
+     * @param recurse Whether to scan sub directories or not.
+     * @param maxThreads The most directories that are read at the same time.
+     */
+    std::vector<ScannedFile> ScanDirectoryParallel(const std::string& pattern, bool recurse, size_t maxThreads = 8);
+
     std::vector<std::string> GetDirectories(const std::string& path);
 } // namespace Path
@@ -150,9 +150,33 @@ namespace Http
         return body;
     }
 
+    // Each thread keeps its session between requests, WinHTTP keeps the connections of a session alive
+    static HINTERNET GetThreadSession()
+    {
+        struct SessionHandle
+        {
+            HINTERNET Handle{};
+            ~SessionHandle()
+            {
+                if (Handle != nullptr)
+                    WinHttpCloseHandle(Handle);
+            }
+        };
+        thread_local SessionHandle session;
+        if (session.Handle == nullptr)
+        {
+            auto userAgent = String::ToWideChar(OPENRCT2_USER_AGENT);
+            session.Handle = WinHttpOpen(
+                userAgent.c_str(), WINHTTP_ACCESS_TYPE_DEFAULT_PROXY, WINHTTP_NO_PROXY_NAME, WINHTTP_NO_PROXY_BYPASS, 0);
+            if (session.Handle == nullptr)
+                ThrowWin32Exception("WinHttpOpen");
+        }
+        return session.Handle;
+    }
+
     Response Do(const Request& req)
     {
-        HINTERNET hSession{}, hConnect{}, hRequest{};
+        HINTERNET hConnect{}, hRequest{};
         try
         {
             URL_COMPONENTS url{};
@@ -166,12 +190,7 @@ namespace Http
             if (!WinHttpCrackUrl(wUrl.c_str(), 0, 0, &url))
                 throw std::invalid_argument("Unable to parse URI.");
 
-            auto userAgent = String::ToWideChar(OPENRCT2_USER_AGENT);
-            hSession = WinHttpOpen(
-                userAgent.c_str(), WINHTTP_ACCESS_TYPE_DEFAULT_PROXY, WINHTTP_NO_PROXY_NAME, WINHTTP_NO_PROXY_BYPASS, 0);
-            if (hSession == nullptr)
-                ThrowWin32Exception("WinHttpOpen");
-
+            auto hSession = GetThreadSession();
             auto wHostName = std::wstring(url.lpszHostName, url.dwHostNameLength);
             hConnect = WinHttpConnect(hSession, wHostName.c_str(), url.nPort, 0);
             if (hConnect == nullptr)
@@ -190,6 +209,10 @@ namespace Http
             if (hRequest == nullptr)
                 ThrowWin32Exception("WinHttpOpenRequest");
 
+            auto timeout = static_cast<int>(req.timeout.count());
+            if (!WinHttpSetTimeouts(hRequest, timeout, timeout, timeout, timeout))
+                ThrowWin32Exception("WinHttpSetTimeouts");
+
             for (auto header : req.header)
             {
                 auto fullHeader = String::ToWideChar(header.first) + L": " + String::ToWideChar(header.second);
@@ -219,9 +242,8 @@ namespace Http
             }
             response.header = std::move(headers);
 
-            WinHttpCloseHandle(hSession);
-            WinHttpCloseHandle(hConnect);
             WinHttpCloseHandle(hRequest);
+            WinHttpCloseHandle(hConnect);
             return response;
         }
         catch ([[maybe_unused]] const std::exception& e)
@@ -229,9 +251,8 @@ namespace Http
 #    ifdef DEBUG
             Console::Error::WriteLine("HTTP request failed: %s", e.what());
 #    endif
-            WinHttpCloseHandle(hSession);
-            WinHttpCloseHandle(hConnect);
             WinHttpCloseHandle(hRequest);
+            WinHttpCloseHandle(hConnect);
             throw;
         }
     }
@@ -81,11 +81,24 @@ namespace Http
         return 0;
     }
 
-    Response Do(const Request& req)
+    // Each thread keeps its handle between requests, so the connections and DNS lookups it has cached are reused
+    static CURL* GetThreadHandle()
     {
-        CURL* curl = curl_easy_init();
-        std::shared_ptr<void> _(nullptr, [curl](...) { curl_easy_cleanup(curl); });
+        thread_local std::unique_ptr<CURL, decltype(&curl_easy_cleanup)> handle(nullptr, &curl_easy_cleanup);
+        if (handle == nullptr)
+        {
+            handle.reset(curl_easy_init());
+        }
+        else
+        {
+            curl_easy_reset(handle.get());
+        }
+        return handle.get();
+    }
 
+    Response Do(const Request& req)
+    {
+        CURL* curl = GetThreadHandle();
         if (!curl)
             throw std::runtime_error("Failed to initialize curl");
 
@@ -120,27 +133,31 @@ namespace Http
         curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, true);
         curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, true);
         curl_easy_setopt(curl, CURLOPT_USERAGENT, OPENRCT2_USER_AGENT);
+        curl_easy_setopt(curl, CURLOPT_TCP_KEEPALIVE, 1L);
+        curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT_MS, static_cast<long>(req.timeout.count()));
+        curl_easy_setopt(curl, CURLOPT_TIMEOUT_MS, static_cast<long>(req.timeout.count()));
 
-        curl_slist* chunk = nullptr;
-        std::shared_ptr<void> __(nullptr, [chunk](...) { curl_slist_free_all(chunk); });
+        std::unique_ptr<curl_slist, decltype(&curl_slist_free_all)> chunk(nullptr, &curl_slist_free_all);
         for (auto header : req.header)
         {
             std::string hs = header.first + ": " + header.second;
-            chunk = curl_slist_append(chunk, hs.c_str());
-        }
-        if (req.header.size() != 0)
-        {
-            if (chunk == nullptr)
+            auto appended = curl_slist_append(chunk.get(), hs.c_str());
+            if (appended == nullptr)
             {
                 throw std::runtime_error("Failed to set headers");
             }
-            curl_easy_setopt(curl, CURLOPT_HTTPHEADER, chunk);
+            chunk.release();
+            chunk.reset(appended);
+        }
+        if (chunk != nullptr)
+        {
+            curl_easy_setopt(curl, CURLOPT_HTTPHEADER, chunk.get());
         }
 
         CURLcode curl_code = curl_easy_perform(curl);
         if (curl_code != CURLE_OK)
         {
-            throw std::runtime_error("Failed to perform request");
+            throw std::runtime_error(std::string("Failed to perform request: ") + curl_easy_strerror(curl_code));
         }
 
         // gets freed by curl_easy_cleanup
@@ -0,0 +1,128 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#ifndef DISABLE_HTTP
+
+#    include "Http.h"
+
+#    include "Console.hpp"
+
+#    include <condition_variable>
+#    include <deque>
+#    include <memory>
+#    include <mutex>
+#    include <thread>
+
+namespace Http
+{
+    /**
+     * A single thread that performs the asynchronous requests in the order they were queued. As it is always the same
+     * thread, requests to a host it has recently talked to reuse the open connection.
+     */
+    class RequestWorker
+    {
+    private:
+        struct QueuedRequest
+        {
+            Request Req;
+            std::function<void(Response&)> Callback;
+        };
+
+        std::mutex _mutex;
+        std::condition_variable _condition;
+        std::deque<QueuedRequest> _queue;
+        bool _stopping{};
+        std::thread _thread;
+
+    public:
+        ~RequestWorker()
+        {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _stopping = true;
+            }
+            _condition.notify_one();
+            if (_thread.joinable())
+            {
+                _thread.join();
+            }
+        }
+
+        void Enqueue(const Request& req, std::function<void(Response&)> fn)
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (!_thread.joinable())
+            {
+                _thread = std::thread([this]() { Run(); });
+            }
+            _queue.push_back({ req, std::move(fn) });
+            _condition.notify_one();
+        }
+
+    private:
+        void Run()
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            while (true)
+            {
+                _condition.wait(lock, [this]() { return _stopping || !_queue.empty(); });
+                if (_stopping)
+                {
+                    return;
+                }
+
+                auto queued = std::move(_queue.front());
+                _queue.pop_front();
+                lock.unlock();
+
+                Response res;
+                try
+                {
+                    res = Do(queued.Req);
+                }
+                catch (const std::exception& e)
+                {
+                    res.status = Status::Invalid;
+                    res.error = e.what();
+                }
+                try
+                {
+                    queued.Callback(res);
+                }
+                catch (const std::exception& e)
+                {
+                    Console::Error::WriteLine("Unable to handle the response of %s: %s", queued.Req.url.c_str(), e.what());
+                }
+
+                lock.lock();
+            }
+        }
+    };
+
+    static RequestWorker& GetRequestWorker()
+    {
+        static RequestWorker worker;
+        return worker;
+    }
+
+    void DoAsync(const Request& req, std::function<void(Response& res)> fn)
+    {
+        GetRequestWorker().Enqueue(req, std::move(fn));
+    }
+
+    std::future<Response> DoAsync(const Request& req)
+    {
+        auto promise = std::make_shared<std::promise<Response>>();
+        auto future = promise->get_future();
+        GetRequestWorker().Enqueue(req, [promise](Response& res) { promise->set_value(std::move(res)); });
+        return future;
+    }
+} // namespace Http
+
+#endif // DISABLE_HTTP
@@ -13,15 +13,20 @@
 
 #    include "../common.h"
 
+#    include <chrono>
 #    include <functional>
+#    include <future>
 #    include <map>
 #    include <string>
-#    include <thread>
 
 namespace Http
 {
+    constexpr std::chrono::milliseconds DefaultTimeout = std::chrono::seconds(30);
+
     enum class Status
     {
+        // The request failed before a response was received, see the error of the response
+        Invalid = 0,
         Ok = 200,
         NotFound = 404
     };
@@ -35,7 +40,7 @@ namespace Http
 
     struct Response
     {
-        Status status;
+        Status status{};
         std::string content_type;
         std::string body = "";
         std::map<std::string, std::string> header = {};
@@ -49,27 +54,26 @@ namespace Http
         Method method = Method::GET;
         std::string body = "";
         bool forceIPv4 = false;
+        // Applies to resolving, connecting and the whole transfer
+        std::chrono::milliseconds timeout = DefaultTimeout;
     };
 
+    /**
+     * Performs the request on the calling thread. Each thread keeps its connections alive between requests.
+     */
     Response Do(const Request& req);
 
-    inline void DoAsync(const Request& req, std::function<void(Response& res)> fn)
-    {
-        auto thread = std::thread([=]() {
-            Response res;
-            try
-            {
-                res = Do(req);
-            }
-            catch (std::exception& e)
-            {
-                res.error = e.what();
-                return;
-            }
-            fn(res);
-        });
-        thread.detach();
-    }
+    /**
+     * Queues the request on the shared HTTP worker thread, which performs the queued requests one after the other and
+     * reuses its connections. The callback is run on the worker thread, also when the request fails.
+     */
+    void DoAsync(const Request& req, std::function<void(Response& res)> fn);
+
+    /**
+     * Queues the request on the shared HTTP worker thread. The response is ready once the request completed or failed,
+     * so it can be polled from the game thread without waiting.
+     */
+    std::future<Response> DoAsync(const Request& req);
 } // namespace Http
 
 #endif // DISABLE_HTTP
@@ -15,6 +15,7 @@
 #include "../drawing/Drawing.h"
 #include "Guard.hpp"
 #include "IStream.hpp"
+#include "JobPool.h"
 #include "Memory.hpp"
 #include "String.hpp"
 
@@ -23,6 +24,7 @@
 #include <png.h>
 #include <stdexcept>
 #include <unordered_map>
+#include <zlib.h>
 
 namespace Imaging
 {
@@ -162,7 +164,161 @@ namespace Imaging
         }
     }
 
-    static void WritePng(std::ostream& ostream, const Image& image)
+    static std::unique_ptr<JobPool> _deflateJobs;
+
+    static JobPool& GetDeflateJobPool()
+    {
+        if (_deflateJobs == nullptr)
+        {
+            _deflateJobs = std::make_unique<JobPool>();
+        }
+        return *_deflateJobs;
+    }
+
+    /**
+     * Compresses the rows of an unfiltered PNG into its zlib stream. The rows are split into blocks which are deflated in
+     * parallel, each primed with the 32 KiB of data before it, and joined with sync flushes like pigz does.
+     */
+    class PngDeflater
+    {
+    private:
+        static constexpr size_t BlockSize = 256 * 1024;
+        static constexpr size_t WindowSize = 32 * 1024;
+
+        int32_t _level;
+        uint32_t _adler = adler32(0L, Z_NULL, 0);
+        bool _headerWritten = false;
+        std::vector<uint8_t> _window;
+
+    public:
+        explicit PngDeflater(int32_t level)
+            : _level(std::clamp(level, Z_NO_COMPRESSION, Z_BEST_COMPRESSION))
+        {
+        }
+
+        std::vector<uint8_t> Deflate(const uint8_t* pixels, uint32_t numRows, size_t rowBytes, size_t stride, bool last)
+        {
+            // Every row starts with its filter type, which is always none
+            std::vector<uint8_t> data;
+            data.reserve(numRows * (rowBytes + 1));
+            for (uint32_t y = 0; y < numRows; y++)
+            {
+                data.push_back(PNG_FILTER_VALUE_NONE);
+                data.insert(data.end(), pixels, pixels + rowBytes);
+                pixels += stride;
+            }
+
+            auto numBlocks = std::max<size_t>(1, (data.size() + BlockSize - 1) / BlockSize);
+            std::vector<std::vector<uint8_t>> blocks(numBlocks);
+            std::vector<uint32_t> blockAdlers(numBlocks);
+            std::vector<std::exception_ptr> blockErrors(numBlocks);
+            GetDeflateJobPool().ParallelFor(0, numBlocks, 1, [&](size_t i) {
+                try
+                {
+                    auto begin = std::min(data.size(), i * BlockSize);
+                    auto end = std::min(data.size(), begin + BlockSize);
+                    const uint8_t* dictionary;
+                    size_t dictionarySize;
+                    if (i == 0)
+                    {
+                        dictionary = _window.data();
+                        dictionarySize = _window.size();
+                    }
+                    else
+                    {
+                        dictionarySize = std::min(begin, WindowSize);
+                        dictionary = data.data() + begin - dictionarySize;
+                    }
+                    auto flush = last && i == numBlocks - 1 ? Z_FINISH : Z_SYNC_FLUSH;
+                    blocks[i] = DeflateBlock(data.data() + begin, end - begin, dictionary, dictionarySize, flush);
+                    blockAdlers[i] = adler32(adler32(0L, Z_NULL, 0), data.data() + begin, static_cast<uInt>(end - begin));
+                }
+                catch (const std::exception&)
+                {
+                    blockErrors[i] = std::current_exception();
+                }
+            });
+
+            std::vector<uint8_t> result;
+            if (!_headerWritten)
+            {
+                // Deflate with a 32 KiB window, the level is only informative
+                uint8_t cmf = 0x78;
+                uint8_t flevel = _level < 2 ? 0 : _level < 6 ? 1 : _level == 6 ? 2 : 3;
+                uint8_t flg = flevel << 6;
+                flg += 31 - ((cmf << 8) | flg) % 31;
+                result.push_back(cmf);
+                result.push_back(flg);
+                _headerWritten = true;
+            }
+            for (size_t i = 0; i < numBlocks; i++)
+            {
+                if (blockErrors[i] != nullptr)
+                {
+                    std::rethrow_exception(blockErrors[i]);
+                }
+                result.insert(result.end(), blocks[i].begin(), blocks[i].end());
+                auto blockSize = std::min(data.size(), (i + 1) * BlockSize) - std::min(data.size(), i * BlockSize);
+                _adler = adler32_combine(_adler, blockAdlers[i], static_cast<z_off_t>(blockSize));
+            }
+            if (last)
+            {
+                result.push_back(static_cast<uint8_t>(_adler >> 24));
+                result.push_back(static_cast<uint8_t>(_adler >> 16));
+                result.push_back(static_cast<uint8_t>(_adler >> 8));
+                result.push_back(static_cast<uint8_t>(_adler));
+            }
+
+            // Keep the end of the data to prime the first block of the next rows
+            _window.insert(_window.end(), data.end() - std::min(data.size(), WindowSize), data.end());
+            if (_window.size() > WindowSize)
+            {
+                _window.erase(_window.begin(), _window.end() - WindowSize);
+            }
+            return result;
+        }
+
+    private:
+        std::vector<uint8_t> DeflateBlock(
+            const uint8_t* src, size_t srcSize, const uint8_t* dictionary, size_t dictionarySize, int32_t flush) const
+        {
+            z_stream strm{};
+            if (deflateInit2(&strm, _level, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+            {
+                throw std::runtime_error("deflateInit2 failed.");
+            }
+            if (dictionarySize != 0)
+            {
+                deflateSetDictionary(&strm, dictionary, static_cast<uInt>(dictionarySize));
+            }
+
+            // Room for the sync flush marker on top of the bound for a finished stream
+            std::vector<uint8_t> result(deflateBound(&strm, static_cast<uLong>(srcSize)) + 16);
+            strm.next_in = const_cast<Bytef*>(src);
+            strm.avail_in = static_cast<uInt>(srcSize);
+            strm.next_out = result.data();
+            strm.avail_out = static_cast<uInt>(result.size());
+            auto ret = deflate(&strm, flush);
+            auto complete = flush == Z_FINISH ? ret == Z_STREAM_END : (ret == Z_OK && strm.avail_out != 0);
+            result.resize(strm.total_out);
+            deflateEnd(&strm);
+            if (!complete || strm.avail_in != 0)
+            {
+                throw std::runtime_error("deflate failed.");
+            }
+            return result;
+        }
+    };
+
+    static void WritePngIdat(png_structp png_ptr, const std::vector<uint8_t>& data)
+    {
+        if (!data.empty())
+        {
+            png_write_chunk(png_ptr, reinterpret_cast<png_const_bytep>("IDAT"), data.data(), data.size());
+        }
+    }
+
+    static void WritePng(std::ostream& ostream, const Image& image, int32_t compressionLevel)
     {
         png_structp png_ptr = nullptr;
         png_colorp png_palette = nullptr;
@@ -228,17 +384,29 @@ namespace Imaging
             png_set_IHDR(
                 png_ptr, info_ptr, image.Width, image.Height, 8, colourType, PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_DEFAULT,
                 PNG_FILTER_TYPE_DEFAULT);
+            png_set_compression_level(png_ptr, std::clamp(compressionLevel, Z_NO_COMPRESSION, Z_BEST_COMPRESSION));
             png_write_info(png_ptr, info_ptr);
 
-            // Write pixels
-            auto pixels = image.Pixels.data();
-            for (uint32_t y = 0; y < image.Height; y++)
+            if (image.Depth == 8)
             {
-                png_write_row(png_ptr, const_cast<png_byte*>(pixels));
-                pixels += image.Stride;
+                // libpng does not filter palette images either, so the image data can be deflated in parallel
+                PngDeflater deflater(compressionLevel);
+                WritePngIdat(png_ptr, deflater.Deflate(image.Pixels.data(), image.Height, image.Width, image.Stride, true));
+                png_write_chunk(png_ptr, reinterpret_cast<png_const_bytep>("IEND"), nullptr, 0);
+                png_write_flush(png_ptr);
             }
+            else
+            {
+                // Write pixels
+                auto pixels = image.Pixels.data();
+                for (uint32_t y = 0; y < image.Height; y++)
+                {
+                    png_write_row(png_ptr, const_cast<png_byte*>(pixels));
+                    pixels += image.Stride;
+                }
 
-            png_write_end(png_ptr, nullptr);
+                png_write_end(png_ptr, nullptr);
+            }
             png_destroy_info_struct(png_ptr, &info_ptr);
             png_free(png_ptr, png_palette);
             png_destroy_write_struct(&png_ptr, nullptr);
@@ -251,6 +419,133 @@ namespace Imaging
         }
     }
 
+    struct PngStreamWriter::State
+    {
+        std::ofstream Stream;
+        png_structp Png{};
+        png_infop Info{};
+        png_colorp Palette{};
+        uint32_t Width{};
+        uint32_t Height{};
+        uint32_t RowsWritten{};
+        std::unique_ptr<PngDeflater> Deflater;
+
+        ~State()
+        {
+            if (Png != nullptr)
+            {
+                png_free(Png, Palette);
+                png_destroy_write_struct(&Png, &Info);
+            }
+        }
+    };
+
+    PngStreamWriter::PngStreamWriter(
+        std::string_view path, uint32_t width, uint32_t height, const GamePalette& palette, int32_t compressionLevel)
+        : _state(std::make_unique<State>())
+    {
+#if defined(_WIN32) && !defined(__MINGW32__)
+        auto pathW = String::ToWideChar(path);
+        _state->Stream.open(pathW, std::ios::binary);
+#else
+        _state->Stream.open(std::string(path), std::ios::binary);
+#endif
+        if (!_state->Stream.is_open())
+        {
+            throw std::runtime_error("Unable to open file for writing.");
+        }
+        _state->Width = width;
+        _state->Height = height;
+        _state->Deflater = std::make_unique<PngDeflater>(compressionLevel);
+
+        auto& png_ptr = _state->Png;
+        png_ptr = png_create_write_struct(PNG_LIBPNG_VER_STRING, nullptr, PngError, PngWarning);
+        if (png_ptr == nullptr)
+        {
+            throw std::runtime_error("png_create_write_struct failed.");
+        }
+        auto& info_ptr = _state->Info;
+        info_ptr = png_create_info_struct(png_ptr);
+        if (info_ptr == nullptr)
+        {
+            throw std::runtime_error("png_create_info_struct failed.");
+        }
+
+        auto& png_palette = _state->Palette;
+        png_palette = static_cast<png_colorp>(png_malloc(png_ptr, PNG_MAX_PALETTE_LENGTH * sizeof(png_color)));
+        if (png_palette == nullptr)
+        {
+            throw std::runtime_error("png_malloc failed.");
+        }
+        for (size_t i = 0; i < PNG_MAX_PALETTE_LENGTH; i++)
+        {
+            const auto& entry = palette[static_cast<uint16_t>(i)];
+            png_palette[i].blue = entry.Blue;
+            png_palette[i].green = entry.Green;
+            png_palette[i].red = entry.Red;
+        }
+
+        png_text text_ptr[1];
+        text_ptr[0].key = const_cast<char*>("Software");
+        text_ptr[0].text = const_cast<char*>(gVersionInfoFull);
+        text_ptr[0].compression = PNG_TEXT_COMPRESSION_zTXt;
+
+        png_set_write_fn(png_ptr, &_state->Stream, PngWriteData, PngFlush);
+        if (setjmp(png_jmpbuf(png_ptr)))
+        {
+            throw std::runtime_error("PNG ERROR");
+        }
+
+        png_byte transparentIndex = 0;
+        png_set_PLTE(png_ptr, info_ptr, png_palette, PNG_MAX_PALETTE_LENGTH);
+        png_set_tRNS(png_ptr, info_ptr, &transparentIndex, 1, nullptr);
+        png_set_text(png_ptr, info_ptr, text_ptr, 1);
+        png_set_IHDR(
+            png_ptr, info_ptr, width, height, 8, PNG_COLOR_TYPE_PALETTE, PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_DEFAULT,
+            PNG_FILTER_TYPE_DEFAULT);
+        png_write_info(png_ptr, info_ptr);
+    }
+
+    PngStreamWriter::~PngStreamWriter() = default;
+
+    void PngStreamWriter::WriteRows(const uint8_t* pixels, uint32_t numRows, uint32_t stride)
+    {
+        if (_state->RowsWritten + numRows > _state->Height)
+        {
+            throw std::out_of_range("More rows written than the image has.");
+        }
+
+        auto png_ptr = _state->Png;
+        if (setjmp(png_jmpbuf(png_ptr)))
+        {
+            throw std::runtime_error("PNG ERROR");
+        }
+        _state->RowsWritten += numRows;
+        auto last = _state->RowsWritten == _state->Height;
+        WritePngIdat(png_ptr, _state->Deflater->Deflate(pixels, numRows, _state->Width, stride, last));
+    }
+
+    void PngStreamWriter::Finish()
+    {
+        if (_state->RowsWritten != _state->Height)
+        {
+            throw std::runtime_error("Not all rows of the image have been written.");
+        }
+
+        auto png_ptr = _state->Png;
+        if (setjmp(png_jmpbuf(png_ptr)))
+        {
+            throw std::runtime_error("PNG ERROR");
+        }
+        png_write_chunk(png_ptr, reinterpret_cast<png_const_bytep>("IEND"), nullptr, 0);
+        png_write_flush(png_ptr);
+        _state->Stream.close();
+        if (_state->Stream.fail())
+        {
+            throw std::runtime_error("Unable to write file.");
+        }
+    }
+
     IMAGE_FORMAT GetImageFormatFromPath(std::string_view path)
     {
         if (String::EndsWith(path, ".png", true))
@@ -329,14 +624,15 @@ namespace Imaging
         return ReadFromStream(istream, format);
     }
 
-    void WriteToFile(std::string_view path, const Image& image, IMAGE_FORMAT format)
+    void WriteToFile(std::string_view path, const Image& image, IMAGE_FORMAT format, int32_t compressionLevel)
     {
         switch (format)
         {
             case IMAGE_FORMAT::AUTOMATIC:
-                WriteToFile(path, image, GetImageFormatFromPath(path));
+                WriteToFile(path, image, GetImageFormatFromPath(path), compressionLevel);
                 break;
             case IMAGE_FORMAT::PNG:
+            case IMAGE_FORMAT::PNG_32:
             {
 #if defined(_WIN32) && !defined(__MINGW32__)
                 auto pathW = String::ToWideChar(path);
@@ -344,7 +640,7 @@ namespace Imaging
 #else
                 std::ofstream fs(std::string(path), std::ios::binary);
 #endif
-                WritePng(fs, image);
+                WritePng(fs, image, compressionLevel);
                 break;
             }
             default:
@@ -46,10 +46,34 @@ using ImageReaderFunc = std::function<Image(std::istream&, IMAGE_FORMAT)>;
 
 namespace Imaging
 {
+    // zlib compression level, from 0 (no compression) to 9 (smallest files)
+    constexpr int32_t DefaultPngCompressionLevel = 6;
+
     IMAGE_FORMAT GetImageFormatFromPath(std::string_view path);
     Image ReadFromFile(std::string_view path, IMAGE_FORMAT format = IMAGE_FORMAT::AUTOMATIC);
     Image ReadFromBuffer(const std::vector<uint8_t>& buffer, IMAGE_FORMAT format = IMAGE_FORMAT::AUTOMATIC);
-    void WriteToFile(std::string_view path, const Image& image, IMAGE_FORMAT format = IMAGE_FORMAT::AUTOMATIC);
+    void WriteToFile(
+        std::string_view path, const Image& image, IMAGE_FORMAT format = IMAGE_FORMAT::AUTOMATIC,
+        int32_t compressionLevel = DefaultPngCompressionLevel);
 
     void SetReader(IMAGE_FORMAT format, ImageReaderFunc impl);
+
+    /**
+     * Writes an 8-bit PNG a few rows at a time, so images larger than memory can be written as they are drawn.
+     */
+    class PngStreamWriter final
+    {
+    private:
+        struct State;
+        std::unique_ptr<State> _state;
+
+    public:
+        PngStreamWriter(
+            std::string_view path, uint32_t width, uint32_t height, const GamePalette& palette,
+            int32_t compressionLevel = DefaultPngCompressionLevel);
+        ~PngStreamWriter();
+
+        void WriteRows(const uint8_t* pixels, uint32_t numRows, uint32_t stride);
+        void Finish();
+    };
 } // namespace Imaging
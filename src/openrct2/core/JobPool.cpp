@@ -9,21 +9,29 @@
 
 #include "JobPool.h"
 
+#include "Trace.h"
+
 #include <algorithm>
 #include <cassert>
+#include <limits>
 
-JobPool::TaskData::TaskData(std::function<void()> workFn, std::function<void()> completionFn)
-    : WorkFn(workFn)
-    , CompletionFn(completionFn)
-{
-}
+static constexpr size_t INVALID_QUEUE_INDEX = std::numeric_limits<size_t>::max();
+
+// Identifies the pool and queue of the worker thread that is currently running, if any.
+static thread_local const JobPool* _currentPool = nullptr;
+static thread_local size_t _currentQueueIndex = INVALID_QUEUE_INDEX;
 
 JobPool::JobPool(size_t maxThreads)
 {
     maxThreads = std::min<size_t>(maxThreads, std::thread::hardware_concurrency());
+    maxThreads = std::max<size_t>(maxThreads, 1);
     for (size_t n = 0; n < maxThreads; n++)
     {
-        _threads.emplace_back(&JobPool::ProcessQueue, this);
+        _queues.push_back(std::make_unique<WorkerQueue>());
+    }
+    for (size_t n = 0; n < maxThreads; n++)
+    {
+        _threads.emplace_back(&JobPool::ProcessQueue, this, n);
     }
 }
 
@@ -44,9 +52,21 @@ JobPool::~JobPool()
 
 void JobPool::AddTask(std::function<void()> workFn, std::function<void()> completionFn)
 {
-    unique_lock lock(_mutex);
-    _pending.emplace_back(workFn, completionFn);
-    _condPending.notify_one();
+    {
+        unique_lock lock(_mutex);
+        _outstanding++;
+    }
+
+    TaskData task;
+    task.WorkFn = std::move(workFn);
+    task.CompletionFn = std::move(completionFn);
+
+    auto queueIndex = GetCurrentQueueIndex();
+    if (queueIndex == INVALID_QUEUE_INDEX)
+    {
+        queueIndex = _nextQueue++ % _queues.size();
+    }
+    PushTask(std::move(task), queueIndex);
 }
 
 void JobPool::Join(std::function<void()> reportFn)
@@ -54,23 +74,20 @@ void JobPool::Join(std::function<void()> reportFn)
     unique_lock lock(_mutex);
     while (true)
     {
-        // Wait for the queue to become empty or having completed tasks.
-        _condComplete.wait(lock, [this]() { return (_pending.empty() && _processing == 0) || !_completed.empty(); });
+        // Wait for all tasks to finish or having completed tasks.
+        _condComplete.wait(lock, [this]() { return _outstanding == 0 || !_completed.empty(); });
 
         // Dispatch all completion callbacks if there are any.
         while (!_completed.empty())
         {
-            auto taskData = _completed.front();
+            auto taskData = std::move(_completed.front());
             _completed.pop_front();
 
-            if (taskData.CompletionFn)
-            {
-                lock.unlock();
+            lock.unlock();
 
-                taskData.CompletionFn();
+            taskData.CompletionFn();
 
-                lock.lock();
-            }
+            lock.lock();
         }
 
         if (reportFn)
@@ -83,7 +100,7 @@ void JobPool::Join(std::function<void()> reportFn)
         }
 
         // If everything is empty and no more work has to be done we can stop waiting.
-        if (_completed.empty() && _pending.empty() && _processing == 0)
+        if (_completed.empty() && _outstanding == 0)
         {
             break;
         }
@@ -92,34 +109,181 @@ void JobPool::Join(std::function<void()> reportFn)
 
 size_t JobPool::CountPending()
 {
-    return _pending.size();
+    return _queued;
 }
 
-void JobPool::ProcessQueue()
+size_t JobPool::CountThreads() const
 {
-    unique_lock lock(_mutex);
-    do
+    return _threads.size();
+}
+
+void JobPool::ProcessQueue(size_t queueIndex)
+{
+    _currentPool = this;
+    _currentQueueIndex = queueIndex;
+
+    while (!_shouldStop)
     {
+        TaskData task;
+        if (TryPopTask(queueIndex, task))
+        {
+            RunTask(task);
+            continue;
+        }
+
         // Wait for work or cancellation.
-        _condPending.wait(lock, [this]() { return _shouldStop || !_pending.empty(); });
+        unique_lock lock(_mutex);
+        _condPending.wait(lock, [this]() { return _shouldStop || _queued != 0; });
+    }
+}
+
+void JobPool::PushTask(TaskData&& task, size_t queueIndex)
+{
+    // The counter is raised before the task becomes visible so that it never drops below zero when the task is stolen
+    // right away, sleeping workers read it under the lock so the notification can not be missed.
+    {
+        unique_lock lock(_mutex);
+        _queued++;
+    }
+    {
+        auto& queue = *_queues[queueIndex];
+        std::lock_guard<std::mutex> lock(queue.Mutex);
+        queue.Tasks.push_back(std::move(task));
+    }
+    _condPending.notify_one();
+}
 
-        if (!_pending.empty())
+bool JobPool::TryPopTask(size_t queueIndex, TaskData& task)
+{
+    const auto numQueues = _queues.size();
+
+    // Take the most recently added task from our own queue first, it is the most likely to still be in the cache.
+    if (queueIndex != INVALID_QUEUE_INDEX)
+    {
+        auto& queue = *_queues[queueIndex];
+        std::lock_guard<std::mutex> lock(queue.Mutex);
+        if (!queue.Tasks.empty())
         {
-            _processing++;
+            task = std::move(queue.Tasks.back());
+            queue.Tasks.pop_back();
+            _queued--;
+            return true;
+        }
+    }
 
-            auto taskData = _pending.front();
-            _pending.pop_front();
+    // Steal the oldest task from one of the other queues.
+    const size_t start = queueIndex == INVALID_QUEUE_INDEX ? 0 : queueIndex + 1;
+    for (size_t i = 0; i < numQueues; i++)
+    {
+        const auto victimIndex = (start + i) % numQueues;
+        if (victimIndex == queueIndex)
+            continue;
 
-            lock.unlock();
+        auto& queue = *_queues[victimIndex];
+        std::unique_lock<std::mutex> lock(queue.Mutex, std::try_to_lock);
+        if (lock.owns_lock() && !queue.Tasks.empty())
+        {
+            task = std::move(queue.Tasks.front());
+            queue.Tasks.pop_front();
+            _queued--;
+            return true;
+        }
+    }
+    return false;
+}
 
-            taskData.WorkFn();
+void JobPool::RunTask(TaskData& task)
+{
+    TRACE_ZONE("Job");
+    if (task.RawFn != nullptr)
+    {
+        task.RawFn(task.RawContext);
+        return;
+    }
 
-            lock.lock();
+    task.WorkFn();
+
+    unique_lock lock(_mutex);
+    if (task.CompletionFn)
+    {
+        _completed.push_back(std::move(task));
+    }
+    _outstanding--;
+    _condComplete.notify_all();
+}
+
+void JobPool::ParallelForImpl(size_t begin, size_t end, size_t grain, void (*invokeFn)(void*, size_t), void* context)
+{
+    if (begin >= end)
+        return;
+
+    grain = std::max<size_t>(grain, 1);
+
+    ParallelForState state;
+    state.Next = begin;
+    state.End = end;
+    state.Grain = grain;
+    state.InvokeFn = invokeFn;
+    state.Context = context;
+
+    // The calling thread takes part in the work, so one chunk less needs a helper.
+    const size_t numChunks = (end - begin + grain - 1) / grain;
+    const size_t numHelpers = std::min(_threads.size(), numChunks - 1);
+    state.PendingHelpers = numHelpers;
+
+    const auto queueIndex = GetCurrentQueueIndex();
+    const size_t firstQueue = queueIndex == INVALID_QUEUE_INDEX ? _nextQueue++ : queueIndex + 1;
+    for (size_t i = 0; i < numHelpers; i++)
+    {
+        TaskData task;
+        task.RawFn = &JobPool::RunParallelForHelper;
+        task.RawContext = &state;
+        PushTask(std::move(task), (firstQueue + i) % _queues.size());
+    }
 
-            _completed.push_back(std::move(taskData));
+    RunParallelForChunks(state);
 
-            _processing--;
-            _condComplete.notify_one();
+    // The state lives on our stack, so wait for every helper to have finished with it. Keep processing tasks meanwhile,
+    // this guarantees progress when called from a worker thread while all other workers are busy.
+    while (state.PendingHelpers.load(std::memory_order_acquire) != 0)
+    {
+        TaskData task;
+        if (TryPopTask(queueIndex, task))
+        {
+            RunTask(task);
+        }
+        else
+        {
+            std::this_thread::yield();
         }
-    } while (!_shouldStop);
+    }
+}
+
+size_t JobPool::GetCurrentQueueIndex() const
+{
+    return _currentPool == this ? _currentQueueIndex : INVALID_QUEUE_INDEX;
+}
+
+void JobPool::RunParallelForChunks(ParallelForState& state)
+{
+    TRACE_ZONE("Parallel for");
+    while (true)
+    {
+        const size_t chunkStart = state.Next.fetch_add(state.Grain, std::memory_order_relaxed);
+        if (chunkStart >= state.End)
+            break;
+
+        const size_t chunkEnd = std::min(chunkStart + state.Grain, state.End);
+        for (size_t i = chunkStart; i < chunkEnd; i++)
+        {
+            state.InvokeFn(state.Context, i);
+        }
+    }
+}
+
+void JobPool::RunParallelForHelper(void* context)
+{
+    auto& state = *static_cast<ParallelForState*>(context);
+    RunParallelForChunks(state);
+    state.PendingHelpers.fetch_sub(1, std::memory_order_release);
 }
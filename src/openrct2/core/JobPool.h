@@ -13,25 +13,51 @@
 #include <condition_variable>
 #include <deque>
 #include <functional>
+#include <memory>
 #include <mutex>
 #include <thread>
+#include <type_traits>
 #include <vector>
 
+/**
+ * A pool of worker threads. Each worker owns a queue of tasks which it processes newest first, idle workers steal the
+ * oldest tasks from the queues of other workers.
+ */
 class JobPool
 {
 private:
     struct TaskData
     {
-        const std::function<void()> WorkFn;
-        const std::function<void()> CompletionFn;
+        std::function<void()> WorkFn;
+        std::function<void()> CompletionFn;
 
-        TaskData(std::function<void()> workFn, std::function<void()> completionFn);
+        // Internal tasks (used by ParallelFor) are plain function pointers to avoid allocating a std::function.
+        void (*RawFn)(void*) = nullptr;
+        void* RawContext = nullptr;
+    };
+
+    struct WorkerQueue
+    {
+        std::mutex Mutex;
+        std::deque<TaskData> Tasks;
+    };
+
+    struct ParallelForState
+    {
+        std::atomic<size_t> Next;
+        size_t End;
+        size_t Grain;
+        void (*InvokeFn)(void*, size_t);
+        void* Context;
+        std::atomic<size_t> PendingHelpers;
     };
 
     std::atomic_bool _shouldStop = { false };
-    std::atomic<size_t> _processing = { 0 };
+    std::atomic<size_t> _queued = { 0 };
+    std::atomic<size_t> _nextQueue = { 0 };
+    size_t _outstanding = 0;
     std::vector<std::thread> _threads;
-    std::deque<TaskData> _pending;
+    std::vector<std::unique_ptr<WorkerQueue>> _queues;
     std::deque<TaskData> _completed;
     std::condition_variable _condPending;
     std::condition_variable _condComplete;
@@ -46,7 +72,28 @@ public:
     void AddTask(std::function<void()> workFn, std::function<void()> completionFn = nullptr);
     void Join(std::function<void()> reportFn = nullptr);
     size_t CountPending();
+    size_t CountThreads() const;
+
+    /**
+     * Invokes fn(index) for every index in [begin, end) and blocks until all invocations have finished. The range is
+     * split into chunks of grain indices which are claimed by the workers and the calling thread, no allocation is made.
+     */
+    template<typename TFn> void ParallelFor(size_t begin, size_t end, size_t grain, TFn&& fn)
+    {
+        using TFnValue = std::remove_reference_t<TFn>;
+        ParallelForImpl(
+            begin, end, grain, [](void* context, size_t index) { (*static_cast<TFnValue*>(context))(index); },
+            const_cast<void*>(static_cast<const void*>(&fn)));
+    }
 
 private:
-    void ProcessQueue();
+    void ProcessQueue(size_t queueIndex);
+    void PushTask(TaskData&& task, size_t queueIndex);
+    bool TryPopTask(size_t queueIndex, TaskData& task);
+    void RunTask(TaskData& task);
+    void ParallelForImpl(size_t begin, size_t end, size_t grain, void (*invokeFn)(void*, size_t), void* context);
+    size_t GetCurrentQueueIndex() const;
+
+    static void RunParallelForChunks(ParallelForState& state);
+    static void RunParallelForHelper(void* context);
 };
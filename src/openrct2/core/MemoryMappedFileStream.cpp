@@ -0,0 +1,244 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "MemoryMappedFileStream.h"
+
+#include "String.hpp"
+
+#include <algorithm>
+
+#ifdef _WIN32
+#    include <windows.h>
+#else
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
+
+namespace OpenRCT2
+{
+    MemoryMappedFileStream::MemoryMappedFileStream(const fs::path& path)
+        : MemoryMappedFileStream(path.u8string())
+    {
+    }
+
+    MemoryMappedFileStream::MemoryMappedFileStream(const std::string& path)
+        : MemoryMappedFileStream(path.c_str())
+    {
+    }
+
+    MemoryMappedFileStream::MemoryMappedFileStream(const utf8* path)
+    {
+#ifdef _WIN32
+        auto pathW = String::ToWideChar(path);
+        auto fileHandle = CreateFileW(
+            pathW.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (fileHandle == INVALID_HANDLE_VALUE)
+        {
+            throw IOException(String::StdFormat("Unable to open '%s'", path));
+        }
+        _fileHandle = fileHandle;
+
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(fileHandle, &fileSize))
+        {
+            Close();
+            throw IOException(String::StdFormat("Unable to open '%s'", path));
+        }
+        _dataSize = static_cast<uint64_t>(fileSize.QuadPart);
+
+        // Empty files can not be mapped, they are simply treated as an empty stream
+        if (_dataSize > 0)
+        {
+            _mappingHandle = CreateFileMappingW(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (_mappingHandle != nullptr)
+            {
+                _data = static_cast<const uint8_t*>(MapViewOfFile(_mappingHandle, FILE_MAP_READ, 0, 0, 0));
+            }
+            if (_data == nullptr)
+            {
+                Close();
+                throw IOException(String::StdFormat("Unable to map '%s'", path));
+            }
+        }
+#else
+        _fd = open(path, O_RDONLY);
+        if (_fd == -1)
+        {
+            throw IOException(String::StdFormat("Unable to open '%s'", path));
+        }
+
+        struct stat fileStat;
+        // Only allow regular files to be opened as its possible to open directories.
+        if (fstat(_fd, &fileStat) != 0 || !S_ISREG(fileStat.st_mode))
+        {
+            Close();
+            throw IOException(String::StdFormat("Unable to open '%s'", path));
+        }
+        _dataSize = static_cast<uint64_t>(fileStat.st_size);
+
+        // Empty files can not be mapped, they are simply treated as an empty stream
+        if (_dataSize > 0)
+        {
+            auto data = mmap(nullptr, static_cast<size_t>(_dataSize), PROT_READ, MAP_PRIVATE, _fd, 0);
+            if (data == MAP_FAILED)
+            {
+                Close();
+                throw IOException(String::StdFormat("Unable to map '%s'", path));
+            }
+            _data = static_cast<const uint8_t*>(data);
+#    ifdef POSIX_MADV_SEQUENTIAL
+            posix_madvise(data, static_cast<size_t>(_dataSize), POSIX_MADV_SEQUENTIAL);
+#    endif
+        }
+#endif
+    }
+
+    MemoryMappedFileStream::~MemoryMappedFileStream()
+    {
+        Close();
+    }
+
+    void MemoryMappedFileStream::Close()
+    {
+#ifdef _WIN32
+        if (_data != nullptr)
+        {
+            UnmapViewOfFile(_data);
+        }
+        if (_mappingHandle != nullptr)
+        {
+            CloseHandle(_mappingHandle);
+        }
+        if (_fileHandle != nullptr)
+        {
+            CloseHandle(_fileHandle);
+        }
+        _mappingHandle = nullptr;
+        _fileHandle = nullptr;
+#else
+        if (_data != nullptr)
+        {
+            munmap(const_cast<uint8_t*>(_data), static_cast<size_t>(_dataSize));
+        }
+        if (_fd != -1)
+        {
+            close(_fd);
+        }
+        _fd = -1;
+#endif
+        _data = nullptr;
+        _dataSize = 0;
+        _position = 0;
+    }
+
+    bool MemoryMappedFileStream::CanRead() const
+    {
+        return true;
+    }
+
+    bool MemoryMappedFileStream::CanWrite() const
+    {
+        return false;
+    }
+
+    uint64_t MemoryMappedFileStream::GetLength() const
+    {
+        return _dataSize;
+    }
+
+    uint64_t MemoryMappedFileStream::GetPosition() const
+    {
+        return _position;
+    }
+
+    void MemoryMappedFileStream::SetPosition(uint64_t position)
+    {
+        Seek(position, STREAM_SEEK_BEGIN);
+    }
+
+    void MemoryMappedFileStream::Seek(int64_t offset, int32_t origin)
+    {
+        uint64_t newPosition;
+        switch (origin)
+        {
+            default:
+            case STREAM_SEEK_BEGIN:
+                newPosition = offset;
+                break;
+            case STREAM_SEEK_CURRENT:
+                newPosition = _position + offset;
+                break;
+            case STREAM_SEEK_END:
+                newPosition = _dataSize + offset;
+                break;
+        }
+
+        if (newPosition > _dataSize)
+        {
+            throw IOException("New position out of bounds.");
+        }
+        _position = newPosition;
+    }
+
+    void MemoryMappedFileStream::Read(void* buffer, uint64_t length)
+    {
+        if (length > _dataSize - _position)
+        {
+            throw IOException("Attempted to read past end of file.");
+        }
+
+        std::memcpy(buffer, _data + _position, static_cast<size_t>(length));
+        _position += length;
+    }
+
+    void MemoryMappedFileStream::Read1(void* buffer)
+    {
+        Read<1>(buffer);
+    }
+
+    void MemoryMappedFileStream::Read2(void* buffer)
+    {
+        Read<2>(buffer);
+    }
+
+    void MemoryMappedFileStream::Read4(void* buffer)
+    {
+        Read<4>(buffer);
+    }
+
+    void MemoryMappedFileStream::Read8(void* buffer)
+    {
+        Read<8>(buffer);
+    }
+
+    void MemoryMappedFileStream::Read16(void* buffer)
+    {
+        Read<16>(buffer);
+    }
+
+    void MemoryMappedFileStream::Write(const void*, uint64_t)
+    {
+        throw IOException("Unable to write to a memory mapped file.");
+    }
+
+    uint64_t MemoryMappedFileStream::TryRead(void* buffer, uint64_t length)
+    {
+        uint64_t bytesToRead = std::min(length, _dataSize - _position);
+        Read(buffer, bytesToRead);
+        return bytesToRead;
+    }
+
+    const void* MemoryMappedFileStream::GetData() const
+    {
+        return _data;
+    }
+
+} // namespace OpenRCT2
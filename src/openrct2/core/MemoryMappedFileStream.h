@@ -0,0 +1,80 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../common.h"
+#include "FileSystem.hpp"
+#include "IStream.hpp"
+
+#include <cstring>
+#include <string>
+
+namespace OpenRCT2
+{
+    /**
+     * A read-only stream over a file that is mapped into memory. GetData() returns the start of the mapping so readers
+     * can access the contents directly instead of copying them into their own buffer.
+     */
+    class MemoryMappedFileStream final : public IStream
+    {
+    private:
+#ifdef _WIN32
+        void* _fileHandle = nullptr;
+        void* _mappingHandle = nullptr;
+#else
+        int32_t _fd = -1;
+#endif
+        const uint8_t* _data = nullptr;
+        uint64_t _dataSize = 0;
+        uint64_t _position = 0;
+
+    public:
+        MemoryMappedFileStream(const fs::path& path);
+        MemoryMappedFileStream(const std::string& path);
+        MemoryMappedFileStream(const utf8* path);
+        MemoryMappedFileStream(const MemoryMappedFileStream&) = delete;
+        MemoryMappedFileStream& operator=(const MemoryMappedFileStream&) = delete;
+        ~MemoryMappedFileStream() override;
+
+        bool CanRead() const override;
+        bool CanWrite() const override;
+
+        uint64_t GetLength() const override;
+        uint64_t GetPosition() const override;
+        void SetPosition(uint64_t position) override;
+        void Seek(int64_t offset, int32_t origin) override;
+
+        void Read(void* buffer, uint64_t length) override;
+        void Read1(void* buffer) override;
+        void Read2(void* buffer) override;
+        void Read4(void* buffer) override;
+        void Read8(void* buffer) override;
+        void Read16(void* buffer) override;
+
+        template<size_t N> void Read(void* buffer)
+        {
+            if (N > _dataSize - _position)
+            {
+                throw IOException("Attempted to read past end of file.");
+            }
+
+            std::memcpy(buffer, _data + _position, N);
+            _position += N;
+        }
+
+        void Write(const void* buffer, uint64_t length) override;
+        uint64_t TryRead(void* buffer, uint64_t length) override;
+        const void* GetData() const override;
+
+    private:
+        void Close();
+    };
+
+} // namespace OpenRCT2
@@ -89,6 +89,11 @@ namespace OpenRCT2
     {
         if (this != &mv)
         {
+            if (_access & MEMORY_ACCESS::OWNER)
+            {
+                Memory::Free(_data);
+            }
+
             _access = mv._access;
             _dataCapacity = mv._dataCapacity;
             _data = mv._data;
@@ -262,6 +267,17 @@ namespace OpenRCT2
         Write<16>(buffer);
     }
 
+    void MemoryStream::Reserve(size_t capacity)
+    {
+        if (_dataCapacity < capacity && (_access & MEMORY_ACCESS::OWNER))
+        {
+            uint64_t position = GetPosition();
+            _dataCapacity = capacity;
+            _data = Memory::Reallocate(_data, _dataCapacity);
+            _position = reinterpret_cast<void*>(reinterpret_cast<uintptr_t>(_data) + static_cast<uintptr_t>(position));
+        }
+    }
+
     void MemoryStream::EnsureCapacity(size_t capacity)
     {
         if (_dataCapacity < capacity)
@@ -52,6 +52,11 @@ namespace OpenRCT2
         void* GetDataCopy() const;
         void* TakeData();
 
+        /**
+         * Grows the buffer to exactly the given capacity up front, so writing up to it never reallocates.
+         */
+        void Reserve(size_t capacity);
+
         ///////////////////////////////////////////////////////////////////////////
         // ISteam methods
         ///////////////////////////////////////////////////////////////////////////
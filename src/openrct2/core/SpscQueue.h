@@ -0,0 +1,74 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <utility>
+
+/**
+ * An unbounded queue that one thread pushes to while another pops from it, without either of them taking a lock.
+ * Every value lives in its own node, the node last popped stays behind as the head so the two threads never touch
+ * the same node other than through its atomic link.
+ */
+template<typename T> class SpscQueue
+{
+private:
+    struct Node
+    {
+        std::atomic<Node*> Next{};
+        T Value{};
+    };
+
+    // Only used by the consuming thread
+    Node* _head;
+    // Only used by the producing thread
+    Node* _tail;
+
+public:
+    SpscQueue()
+        : _head(new Node())
+        , _tail(_head)
+    {
+    }
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    ~SpscQueue()
+    {
+        while (_head != nullptr)
+        {
+            auto* next = _head->Next.load(std::memory_order_relaxed);
+            delete _head;
+            _head = next;
+        }
+    }
+
+    void push(T&& value)
+    {
+        auto* node = new Node();
+        node->Value = std::move(value);
+        _tail->Next.store(node, std::memory_order_release);
+        _tail = node;
+    }
+
+    bool try_pop(T& value)
+    {
+        auto* next = _head->Next.load(std::memory_order_acquire);
+        if (next == nullptr)
+        {
+            return false;
+        }
+        value = std::move(next->Value);
+        delete _head;
+        _head = next;
+        return true;
+    }
+};
@@ -207,29 +207,35 @@ public:
         {
             return _index != rhs._index;
         }
+        // ASCII, which most text is, is handled inline without decoding
         char32_t operator*() const
         {
+            const auto ch = static_cast<uint8_t>(_str[_index]);
+            if (ch < 0x80)
+                return ch;
             return GetNextCodepoint(&_str[_index], nullptr);
         }
         iterator& operator++()
         {
             if (_index < _str.size())
             {
-                const utf8* nextch;
-                GetNextCodepoint(&_str[_index], &nextch);
-                _index = nextch - _str.data();
+                if (static_cast<uint8_t>(_str[_index]) < 0x80)
+                {
+                    _index++;
+                }
+                else
+                {
+                    const utf8* nextch;
+                    GetNextCodepoint(&_str[_index], &nextch);
+                    _index = nextch - _str.data();
+                }
             }
             return *this;
         }
         iterator operator++(int)
         {
             auto result = *this;
-            if (_index < _str.size())
-            {
-                const utf8* nextch;
-                GetNextCodepoint(&_str[_index], &nextch);
-                _index = nextch - _str.data();
-            }
+            ++(*this);
             return result;
         }
 
@@ -0,0 +1,137 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "Trace.h"
+
+#include "File.h"
+#include "String.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace OpenRCT2::Trace
+{
+    std::atomic<bool> Detail::Recording = { false };
+
+    struct RecordedZone
+    {
+        const char* Name;
+        Clock::time_point Start;
+        Clock::time_point End;
+        uint64_t Allocations;
+    };
+
+    // Each thread appends to its own buffer, the mutex is only contended while the zones are cleared or written
+    struct ThreadZones
+    {
+        uint32_t ThreadId{};
+        std::mutex Mutex;
+        std::vector<RecordedZone> Zones;
+        size_t Next{};
+    };
+
+    // Buffers stay registered after their thread ends, so the zones of short lived threads still get written
+    static std::mutex _threadZonesMutex;
+    static std::vector<std::unique_ptr<ThreadZones>> _threadZones;
+    static thread_local ThreadZones* _currentThreadZones;
+
+    static ThreadZones& GetCurrentThreadZones()
+    {
+        if (_currentThreadZones == nullptr)
+        {
+            std::lock_guard<std::mutex> lock(_threadZonesMutex);
+            auto& threadZones = _threadZones.emplace_back(std::make_unique<ThreadZones>());
+            threadZones->ThreadId = static_cast<uint32_t>(_threadZones.size());
+            _currentThreadZones = threadZones.get();
+        }
+        return *_currentThreadZones;
+    }
+
+    void Start()
+    {
+        std::lock_guard<std::mutex> lock(_threadZonesMutex);
+        for (auto& threadZones : _threadZones)
+        {
+            std::lock_guard<std::mutex> zonesLock(threadZones->Mutex);
+            threadZones->Zones.clear();
+            threadZones->Next = 0;
+        }
+        Detail::Recording = true;
+    }
+
+    void Stop()
+    {
+        Detail::Recording = false;
+    }
+
+    void RecordZone(const char* name, Clock::time_point start, Clock::time_point end, uint64_t allocations)
+    {
+        auto& threadZones = GetCurrentThreadZones();
+        std::lock_guard<std::mutex> lock(threadZones.Mutex);
+        if (threadZones.Zones.size() < MaxZonesPerThread)
+        {
+            threadZones.Zones.push_back({ name, start, end, allocations });
+        }
+        else
+        {
+            threadZones.Zones[threadZones.Next] = { name, start, end, allocations };
+            threadZones.Next = (threadZones.Next + 1) % MaxZonesPerThread;
+        }
+    }
+
+    size_t WriteChromeTrace(const std::string& path)
+    {
+        struct ZoneToWrite
+        {
+            RecordedZone Zone;
+            uint32_t ThreadId;
+        };
+        std::vector<ZoneToWrite> zones;
+        {
+            std::lock_guard<std::mutex> lock(_threadZonesMutex);
+            for (auto& threadZones : _threadZones)
+            {
+                std::lock_guard<std::mutex> zonesLock(threadZones->Mutex);
+                for (const auto& zone : threadZones->Zones)
+                {
+                    zones.push_back({ zone, threadZones->ThreadId });
+                }
+            }
+        }
+        if (zones.empty())
+        {
+            File::WriteAllBytes(path, "{\"traceEvents\":[]}\n", 19);
+            return 0;
+        }
+
+        // Timestamps are in microseconds, relative to the earliest zone so they stay readable
+        auto origin = std::min_element(zones.begin(), zones.end(), [](const ZoneToWrite& a, const ZoneToWrite& b) {
+                          return a.Zone.Start < b.Zone.Start;
+                      })->Zone.Start;
+        auto toMicroseconds = [](Clock::duration duration) {
+            return std::chrono::duration<double, std::micro>(duration).count();
+        };
+
+        std::string json = "{\"traceEvents\":[\n";
+        for (size_t i = 0; i < zones.size(); i++)
+        {
+            const auto& [zone, threadId] = zones[i];
+            json += String::StdFormat(
+                "{\"name\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u,"
+                "\"args\":{\"allocations\":%llu}}%s\n",
+                zone.Name, toMicroseconds(zone.Start - origin), toMicroseconds(zone.End - zone.Start), threadId,
+                static_cast<unsigned long long>(zone.Allocations), i + 1 < zones.size() ? "," : "");
+        }
+        json += "]}\n";
+        File::WriteAllBytes(path, json.data(), json.size());
+        return zones.size();
+    }
+} // namespace OpenRCT2::Trace
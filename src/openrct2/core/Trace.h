@@ -0,0 +1,110 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "Allocations.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <string>
+
+/**
+ * Scoped zones that record when the hot paths of the game run, on every thread, so a running game or server can be
+ * profiled without a native profiler. Zones are only compiled in when ENABLE_TRACING is defined, and only recorded
+ * between Start() and Stop().
+ */
+namespace OpenRCT2::Trace
+{
+    using Clock = std::chrono::steady_clock;
+
+    // Only the most recent zones of each thread are kept, about a minute of game updates
+    constexpr size_t MaxZonesPerThread = 1 << 18;
+
+    namespace Detail
+    {
+        extern std::atomic<bool> Recording;
+    }
+
+#ifdef ENABLE_TRACING
+    inline bool IsRecording()
+    {
+        return Detail::Recording.load(std::memory_order_relaxed);
+    }
+#else
+    constexpr bool IsRecording()
+    {
+        return false;
+    }
+#endif
+
+    constexpr bool IsEnabled()
+    {
+#ifdef ENABLE_TRACING
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    /**
+     * Drops the zones recorded so far and starts recording new ones.
+     */
+    void Start();
+    void Stop();
+
+    /**
+     * The name must outlive the recording, usually it is a string literal. Allocations are the heap allocations the
+     * thread made within the zone, including those of the zones nested in it.
+     */
+    void RecordZone(const char* name, Clock::time_point start, Clock::time_point end, uint64_t allocations = 0);
+
+    /**
+     * Writes the recorded zones in the Chrome trace event format, which chrome://tracing and Perfetto open.
+     * @returns the number of zones written.
+     */
+    size_t WriteChromeTrace(const std::string& path);
+
+    class Zone
+    {
+    private:
+        const char* _name{};
+        Clock::time_point _start;
+        uint64_t _allocationsAtStart{};
+
+    public:
+        explicit Zone(const char* name)
+        {
+            if (IsRecording())
+            {
+                _name = name;
+                _start = Clock::now();
+                _allocationsAtStart = Allocations::GetThreadCount();
+            }
+        }
+        Zone(const Zone&) = delete;
+        Zone& operator=(const Zone&) = delete;
+        ~Zone()
+        {
+            if (_name != nullptr)
+            {
+                RecordZone(_name, _start, Clock::now(), Allocations::GetThreadCount() - _allocationsAtStart);
+            }
+        }
+    };
+} // namespace OpenRCT2::Trace
+
+#ifdef ENABLE_TRACING
+#    define TRACE_ZONE_CONCAT_IMPL(a, b) a##b
+#    define TRACE_ZONE_CONCAT(a, b) TRACE_ZONE_CONCAT_IMPL(a, b)
+#    define TRACE_ZONE(name) OpenRCT2::Trace::Zone TRACE_ZONE_CONCAT(_traceZone, __LINE__)(name)
+#else
+#    define TRACE_ZONE(name)
+#endif
@@ -9,9 +9,13 @@
 
 #include "Zip.h"
 
+#include "FileSystem.hpp"
 #include "IStream.hpp"
 
 #include <algorithm>
+#include <list>
+#include <mutex>
+#include <unordered_map>
 #ifndef __ANDROID__
 #    include <zip.h>
 #endif
@@ -65,6 +69,75 @@ bool IZipArchive::Exists(std::string_view path) const
     return GetIndexFromPath(path).has_value();
 }
 
+namespace Zip
+{
+    constexpr size_t MaxCachedArchives = 16;
+
+    struct CachedArchive
+    {
+        std::string Path;
+        fs::file_time_type LastWriteTime;
+        uintmax_t Size{};
+        std::shared_ptr<IZipArchive> Archive;
+    };
+
+    static std::mutex _cachedArchivesMutex;
+    static std::list<CachedArchive> _cachedArchives;
+
+    std::shared_ptr<IZipArchive> OpenCached(std::string_view path)
+    {
+        std::error_code ec;
+        auto fsPath = fs::u8path(path);
+        auto lastWriteTime = fs::last_write_time(fsPath, ec);
+        if (ec)
+        {
+            return nullptr;
+        }
+        auto size = fs::file_size(fsPath, ec);
+        if (ec)
+        {
+            return nullptr;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(_cachedArchivesMutex);
+            for (auto it = _cachedArchives.begin(); it != _cachedArchives.end();)
+            {
+                if (it->Path != path)
+                {
+                    it++;
+                    continue;
+                }
+                if (it->LastWriteTime != lastWriteTime || it->Size != size)
+                {
+                    // File has changed on disk since it was opened
+                    it = _cachedArchives.erase(it);
+                    continue;
+                }
+                // libzip handles are not thread safe, so only hand out archives nobody else is using
+                if (it->Archive.use_count() == 1)
+                {
+                    _cachedArchives.splice(_cachedArchives.begin(), _cachedArchives, it);
+                    return _cachedArchives.front().Archive;
+                }
+                it++;
+            }
+        }
+
+        std::shared_ptr<IZipArchive> archive = TryOpen(path, ZIP_ACCESS::READ);
+        if (archive != nullptr)
+        {
+            std::lock_guard<std::mutex> lock(_cachedArchivesMutex);
+            _cachedArchives.push_front({ std::string(path), lastWriteTime, size, archive });
+            if (_cachedArchives.size() > MaxCachedArchives)
+            {
+                _cachedArchives.pop_back();
+            }
+        }
+        return archive;
+    }
+} // namespace Zip
+
 #ifndef __ANDROID__
 
 class ZipArchive final : public IZipArchive
@@ -73,6 +146,8 @@ private:
     zip_t* _zip;
     ZIP_ACCESS _access;
     std::vector<std::vector<uint8_t>> _writeBuffers;
+    mutable std::unordered_map<std::string, size_t> _pathIndex;
+    mutable bool _pathIndexValid{};
 
 public:
     ZipArchive(std::string_view path, ZIP_ACCESS access)
@@ -127,6 +202,43 @@ public:
         }
     }
 
+    /**
+     * Looks up the index of the given path using a hash of the normalised central directory names,
+     * built on first use.
+     */
+    std::optional<size_t> GetIndexFromPath(std::string_view path) const override
+    {
+        auto normalisedPath = NormalisePath(path);
+        if (normalisedPath.empty())
+        {
+            return std::nullopt;
+        }
+
+        if (!_pathIndexValid)
+        {
+            _pathIndex.clear();
+            auto numFiles = GetNumFiles();
+            _pathIndex.reserve(numFiles);
+            for (size_t i = 0; i < numFiles; i++)
+            {
+                auto normalisedZipPath = NormalisePath(GetFileName(i));
+                if (!normalisedZipPath.empty())
+                {
+                    // Keep the first match, as the linear search does
+                    _pathIndex.emplace(std::move(normalisedZipPath), i);
+                }
+            }
+            _pathIndexValid = true;
+        }
+
+        auto it = _pathIndex.find(normalisedPath);
+        if (it != _pathIndex.end())
+        {
+            return it->second;
+        }
+        return std::nullopt;
+    }
+
     std::vector<uint8_t> GetFileData(std::string_view path) const override
     {
         std::vector<uint8_t> result;
@@ -179,6 +291,7 @@ public:
         {
             zip_add(_zip, path.data(), source);
         }
+        _pathIndexValid = false;
     }
 
     void DeleteFile(std::string_view path) override
@@ -187,6 +300,7 @@ public:
         if (index)
         {
             zip_delete(_zip, *index);
+            _pathIndexValid = false;
         }
         else
         {
@@ -200,6 +314,7 @@ public:
         if (index)
         {
             zip_file_rename(_zip, *index, newPath.data(), ZIP_FL_ENC_GUESS);
+            _pathIndexValid = false;
         }
         else
         {
@@ -216,6 +331,7 @@ private:
         zip_file_t* _zipFile{};
         zip_uint64_t _len{};
         zip_uint64_t _pos{};
+        bool _stored{};
 
     public:
         ZipItemStream(zip* zip, zip_int64_t index)
@@ -251,6 +367,21 @@ private:
 
         void SetPosition(uint64_t position) override
         {
+            if (_zipFile == nullptr && !Reset())
+            {
+                return;
+            }
+#if defined(LIBZIP_VERSION_MAJOR) && (LIBZIP_VERSION_MAJOR > 1 || LIBZIP_VERSION_MINOR >= 2)
+            // Stored entries can be seeked directly without decompressing
+            if (_stored && position != _pos && position <= _len)
+            {
+                if (zip_fseek(_zipFile, static_cast<zip_int64_t>(position), SEEK_SET) == 0)
+                {
+                    _pos = position;
+                    return;
+                }
+            }
+#endif
             if (position > _pos)
             {
                 // Read to seek forwards
@@ -334,6 +465,7 @@ private:
 
             _pos = 0;
             _len = 0;
+            _stored = false;
             _zipFile = zip_fopen_index(_zip, _index, 0);
             if (_zipFile == nullptr)
             {
@@ -347,6 +479,8 @@ private:
             }
 
             _len = zipFileStat.size;
+            _stored = (zipFileStat.valid & ZIP_STAT_COMP_METHOD) && zipFileStat.comp_method == ZIP_CM_STORE
+                && (!(zipFileStat.valid & ZIP_STAT_ENCRYPTION_METHOD) || zipFileStat.encryption_method == ZIP_EM_NONE);
             return true;
         }
 
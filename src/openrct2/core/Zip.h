@@ -47,7 +47,7 @@ struct IZipArchive
     virtual void DeleteFile(std::string_view path) abstract;
     virtual void RenameFile(std::string_view path, std::string_view newPath) abstract;
 
-    std::optional<size_t> GetIndexFromPath(std::string_view path) const;
+    virtual std::optional<size_t> GetIndexFromPath(std::string_view path) const;
     bool Exists(std::string_view path) const;
 };
 
@@ -61,4 +61,10 @@ namespace Zip
 {
     std::unique_ptr<IZipArchive> Open(std::string_view path, ZIP_ACCESS zipAccess);
     std::unique_ptr<IZipArchive> TryOpen(std::string_view path, ZIP_ACCESS zipAccess);
+
+    /**
+     * Opens a zip file for reading, re-using a previously opened handle for the same file if it
+     * is unchanged on disk and not currently in use. Returns nullptr if the file can not be opened.
+     */
+    std::shared_ptr<IZipArchive> OpenCached(std::string_view path);
 } // namespace Zip
@@ -42,6 +42,98 @@ void mask_avx2(
     }
 }
 
+static void rle_minify_blend_avx2(uint8_t* dst, __m256i colour)
+{
+    const __m256i dest = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst));
+    const __m256i transparent = _mm256_cmpeq_epi8(colour, _mm256_setzero_si256());
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), _mm256_blendv_epi8(colour, dest, transparent));
+}
+
+static __m256i rle_minify_load_avx2(const uint8_t* src, __m256i mask)
+{
+    return _mm256_and_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src)), mask);
+}
+
+void rle_minify_copy_avx2(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t numPixels, int32_t zoomLevel)
+{
+    // As rle_minify_copy_sse4_1() with 32 destination pixels per block, the packs work on each 128 bit lane so the
+    // results are put back in order afterwards.
+    const int32_t blockPixels = 32 << zoomLevel;
+    switch (zoomLevel)
+    {
+        case 1:
+        {
+            const __m256i mask = _mm256_set1_epi16(0xFF);
+            for (; numPixels >= blockPixels; numPixels -= blockPixels, src += blockPixels, dst += 32)
+            {
+                const __m256i packed = _mm256_packus_epi16(
+                    rle_minify_load_avx2(src, mask), rle_minify_load_avx2(src + 32, mask));
+                rle_minify_blend_avx2(dst, _mm256_permute4x64_epi64(packed, 0xD8));
+            }
+            break;
+        }
+        case 2:
+        {
+            const __m256i mask = _mm256_set1_epi32(0xFF);
+            const __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+            for (; numPixels >= blockPixels; numPixels -= blockPixels, src += blockPixels, dst += 32)
+            {
+                const __m256i a = _mm256_packus_epi32(rle_minify_load_avx2(src, mask), rle_minify_load_avx2(src + 32, mask));
+                const __m256i b = _mm256_packus_epi32(
+                    rle_minify_load_avx2(src + 64, mask), rle_minify_load_avx2(src + 96, mask));
+                rle_minify_blend_avx2(dst, _mm256_permutevar8x32_epi32(_mm256_packus_epi16(a, b), order));
+            }
+            break;
+        }
+        case 3:
+        {
+            const __m256i mask = _mm256_set1_epi64x(0xFF);
+            for (; numPixels >= blockPixels; numPixels -= blockPixels, src += blockPixels, dst += 32)
+            {
+                __m256i words[2];
+                for (int32_t i = 0; i < 2; i++)
+                {
+                    const uint8_t* half = src + i * 128;
+                    const __m256i a = _mm256_packus_epi32(
+                        rle_minify_load_avx2(half, mask), rle_minify_load_avx2(half + 32, mask));
+                    const __m256i b = _mm256_packus_epi32(
+                        rle_minify_load_avx2(half + 64, mask), rle_minify_load_avx2(half + 96, mask));
+                    words[i] = _mm256_packus_epi32(a, b);
+                }
+                // Each lane holds pairs of pixels, the pairs of the low and high lanes alternate
+                const __m256i packed = _mm256_packus_epi16(words[0], words[1]);
+                const __m128i low = _mm256_castsi256_si128(packed);
+                const __m128i high = _mm256_extracti128_si256(packed, 1);
+                const __m256i ordered = _mm256_inserti128_si256(
+                    _mm256_castsi128_si256(_mm_unpacklo_epi16(low, high)), _mm_unpackhi_epi16(low, high), 1);
+                rle_minify_blend_avx2(dst, ordered);
+            }
+            break;
+        }
+    }
+    rle_minify_copy_scalar(src, dst, numPixels, zoomLevel);
+}
+
+void light_add_avx2(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t numPixels, uint16_t multiplier)
+{
+    // Unpacking and packing both work within each lane, so the pixels stay in order
+    const __m256i scale = _mm256_set1_epi16(static_cast<int16_t>(multiplier));
+    const __m256i zero = _mm256_setzero_si256();
+    for (; numPixels >= 32; numPixels -= 32, src += 32, dst += 32)
+    {
+        __m256i light = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src));
+        if (multiplier != 256)
+        {
+            const __m256i low = _mm256_srli_epi16(_mm256_mullo_epi16(_mm256_unpacklo_epi8(light, zero), scale), 8);
+            const __m256i high = _mm256_srli_epi16(_mm256_mullo_epi16(_mm256_unpackhi_epi8(light, zero), scale), 8);
+            light = _mm256_packus_epi16(low, high);
+        }
+        const __m256i dest = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), _mm256_adds_epu8(dest, light));
+    }
+    light_add_scalar(src, dst, numPixels, multiplier);
+}
+
 #else
 
 #    ifdef OPENRCT2_X86
@@ -55,4 +147,14 @@ void mask_avx2(
     openrct2_assert(false, "AVX2 function called on a CPU that doesn't support AVX2");
 }
 
+void rle_minify_copy_avx2(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t numPixels, int32_t zoomLevel)
+{
+    openrct2_assert(false, "AVX2 function called on a CPU that doesn't support AVX2");
+}
+
+void light_add_avx2(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t numPixels, uint16_t multiplier)
+{
+    openrct2_assert(false, "AVX2 function called on a CPU that doesn't support AVX2");
+}
+
 #endif // __AVX2__
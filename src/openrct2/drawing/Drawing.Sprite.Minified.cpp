@@ -0,0 +1,239 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "../sprites.h"
+#include "Drawing.h"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <utility>
+
+namespace
+{
+    // The cache is trimmed back to three quarters of this once it grows beyond it
+    constexpr size_t MaxCacheBytes = 32 * 1024 * 1024;
+
+    struct CacheEntry
+    {
+        std::shared_ptr<const MinifiedRLESprite> Sprite;
+        const uint8_t* SourceData{};
+        int16_t SourceWidth{};
+        int16_t SourceHeight{};
+        size_t Bytes{};
+        std::atomic<uint32_t> LastUsed{};
+    };
+
+    std::shared_mutex _mutex;
+    std::unordered_map<uint32_t, CacheEntry> _entries;
+    std::atomic<uint32_t> _useCounter{};
+    size_t _totalBytes{};
+
+    using shared_lock = std::shared_lock<std::shared_mutex>;
+    using unique_lock = std::unique_lock<std::shared_mutex>;
+} // namespace
+
+static bool IsCacheableImage(uint32_t imageIndex)
+{
+    // Scrolling text and the temporary image are rewritten in place, so their pixels can change under the same index
+    return imageIndex < SPR_SCROLLING_TEXT_START || (imageIndex >= SPR_IMAGE_LIST_BEGIN && imageIndex < SPR_IMAGE_LIST_END);
+}
+
+static uint32_t GetCacheKey(uint32_t imageIndex, int32_t zoomLevel, int32_t phaseX, int32_t phaseY)
+{
+    return (imageIndex << 8) | (zoomLevel << 6) | (phaseY << 3) | phaseX;
+}
+
+/**
+ * Samples every (1 << zoomLevel)th pixel of every (1 << zoomLevel)th line of an RLE sprite, starting at
+ * (phaseX, phaseY), into a new RLE sprite. Transparent pixels are dropped from the runs, so drawing the result at zoom
+ * level 0 writes exactly the pixels the minifying blitter would have written.
+ */
+static std::shared_ptr<MinifiedRLESprite> MinifyRLESprite(
+    const rct_g1_element& g1, int32_t zoomLevel, int32_t phaseX, int32_t phaseY)
+{
+    const int32_t zoom = 1 << zoomLevel;
+    const int32_t width = (g1.width - phaseX + zoom - 1) >> zoomLevel;
+    const int32_t height = (g1.height - phaseY + zoom - 1) >> zoomLevel;
+    if (g1.offset == nullptr || width <= 0 || height <= 0)
+    {
+        return nullptr;
+    }
+
+    auto sprite = std::make_shared<MinifiedRLESprite>();
+    auto& data = sprite->Data;
+    data.resize(static_cast<size_t>(height) * 2);
+    for (int32_t j = 0; j < height; j++)
+    {
+        // Line offsets are 16 bit, give up on sprites that would not fit
+        const size_t lineOffset = data.size();
+        if (lineOffset > 0xFFFF)
+        {
+            return nullptr;
+        }
+        data[j * 2] = static_cast<uint8_t>(lineOffset & 0xFF);
+        data[j * 2 + 1] = static_cast<uint8_t>(lineOffset >> 8);
+
+        const int32_t y = phaseY + j * zoom;
+        const uint8_t* nextRun = g1.offset + (g1.offset[y * 2] | (g1.offset[y * 2 + 1] << 8));
+        size_t lastHeader = SIZE_MAX;
+        auto isEndOfLine = false;
+        while (!isEndOfLine)
+        {
+            auto src = nextRun;
+            int32_t dataSize = *src++;
+            int32_t firstPixelX = *src++;
+            isEndOfLine = (dataSize & 0x80) != 0;
+            dataSize &= 0x7F;
+            nextRun = src + dataSize;
+
+            // Runs are split at transparent pixels and never merged, so later runs still overwrite earlier ones
+            size_t runHeader = SIZE_MAX;
+            for (int32_t x = firstPixelX + ((phaseX - firstPixelX) & (zoom - 1)); x < firstPixelX + dataSize; x += zoom)
+            {
+                const auto pixel = src[x - firstPixelX];
+                if (pixel == 0)
+                {
+                    runHeader = SIZE_MAX;
+                    continue;
+                }
+                if (runHeader == SIZE_MAX || data[runHeader] == 0x7F)
+                {
+                    runHeader = data.size();
+                    data.push_back(0);
+                    data.push_back(static_cast<uint8_t>((x - phaseX) >> zoomLevel));
+                }
+                data[runHeader]++;
+                data.push_back(pixel);
+                lastHeader = runHeader;
+            }
+        }
+
+        if (lastHeader == SIZE_MAX)
+        {
+            // Empty line
+            data.push_back(0x80);
+            data.push_back(0);
+        }
+        else
+        {
+            data[lastHeader] |= 0x80;
+        }
+    }
+    data.shrink_to_fit();
+
+    sprite->Element = {};
+    sprite->Element.offset = data.data();
+    sprite->Element.width = width;
+    sprite->Element.height = height;
+    sprite->Element.flags = G1_FLAG_RLE_COMPRESSION;
+    return sprite;
+}
+
+static void TrimCache()
+{
+    std::vector<std::pair<uint32_t, uint32_t>> entriesByAge;
+    entriesByAge.reserve(_entries.size());
+    for (const auto& [key, entry] : _entries)
+    {
+        entriesByAge.emplace_back(entry.LastUsed.load(std::memory_order_relaxed), key);
+    }
+    std::sort(entriesByAge.begin(), entriesByAge.end());
+
+    for (const auto& [lastUsed, key] : entriesByAge)
+    {
+        if (_totalBytes <= MaxCacheBytes / 4 * 3)
+        {
+            break;
+        }
+        auto it = _entries.find(key);
+        _totalBytes -= it->second.Bytes;
+        _entries.erase(it);
+    }
+}
+
+std::shared_ptr<const MinifiedRLESprite> gfx_get_minified_rle_sprite(
+    uint32_t imageIndex, const rct_g1_element& g1, int32_t zoomLevel, int32_t phaseX, int32_t phaseY)
+{
+    if (!IsCacheableImage(imageIndex))
+    {
+        return nullptr;
+    }
+
+    const auto key = GetCacheKey(imageIndex, zoomLevel, phaseX, phaseY);
+    {
+        shared_lock lock(_mutex);
+        auto it = _entries.find(key);
+        if (it != _entries.end() && it->second.SourceData == g1.offset && it->second.SourceWidth == g1.width
+            && it->second.SourceHeight == g1.height)
+        {
+            it->second.LastUsed.store(_useCounter.fetch_add(1, std::memory_order_relaxed), std::memory_order_relaxed);
+            return it->second.Sprite;
+        }
+    }
+
+    // Minify outside of the lock so other paint threads can keep drawing, sprites that can not be minified are stored
+    // as well so they are not attempted again.
+    auto sprite = MinifyRLESprite(g1, zoomLevel, phaseX, phaseY);
+
+    unique_lock lock(_mutex);
+    auto& entry = _entries[key];
+    _totalBytes -= entry.Bytes;
+    entry.Sprite = sprite;
+    entry.SourceData = g1.offset;
+    entry.SourceWidth = g1.width;
+    entry.SourceHeight = g1.height;
+    entry.Bytes = sizeof(CacheEntry) + (sprite != nullptr ? sizeof(MinifiedRLESprite) + sprite->Data.capacity() : 0);
+    entry.LastUsed.store(_useCounter.fetch_add(1, std::memory_order_relaxed), std::memory_order_relaxed);
+    _totalBytes += entry.Bytes;
+    if (_totalBytes > MaxCacheBytes)
+    {
+        TrimCache();
+    }
+    return sprite;
+}
+
+void gfx_invalidate_minified_rle_sprites(uint32_t imageIndex)
+{
+    if (!IsCacheableImage(imageIndex))
+    {
+        return;
+    }
+
+    unique_lock lock(_mutex);
+    if (_entries.empty())
+    {
+        return;
+    }
+    for (int32_t zoomLevel = 1; zoomLevel <= 3; zoomLevel++)
+    {
+        const int32_t zoom = 1 << zoomLevel;
+        for (int32_t phaseY = 0; phaseY < zoom; phaseY++)
+        {
+            for (int32_t phaseX = 0; phaseX < zoom; phaseX++)
+            {
+                auto it = _entries.find(GetCacheKey(imageIndex, zoomLevel, phaseX, phaseY));
+                if (it != _entries.end())
+                {
+                    _totalBytes -= it->second.Bytes;
+                    _entries.erase(it);
+                }
+            }
+        }
+    }
+}
+
+void gfx_clear_minified_rle_sprites()
+{
+    unique_lock lock(_mutex);
+    _entries.clear();
+    _totalBytes = 0;
+}
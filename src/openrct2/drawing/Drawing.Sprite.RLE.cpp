@@ -163,6 +163,27 @@ template<DrawBlendOp TBlendOp, size_t TZoom> static void FASTCALL DrawRLESpriteM
                     std::memcpy(dst, src, numPixels);
                 }
             }
+            else if constexpr (TBlendOp == BLEND_TRANSPARENT && TZoom > 0)
+            {
+                // Runs long enough to fill a SIMD block are sampled by rle_minify_copy_fn, the rest pixel by pixel
+                if (numPixels >= (16 << TZoom))
+                {
+                    rle_minify_copy_fn(src, dst, numPixels, TZoom);
+                }
+                else
+                {
+                    while (numPixels > 0)
+                    {
+                        if (*src != 0)
+                        {
+                            *dst = *src;
+                        }
+                        numPixels -= zoom;
+                        src += zoom;
+                        dst++;
+                    }
+                }
+            }
             else
             {
                 auto& paletteMap = args.PalMap;
@@ -178,6 +199,47 @@ template<DrawBlendOp TBlendOp, size_t TZoom> static void FASTCALL DrawRLESpriteM
     }
 }
 
+/**
+ * Draws a zoomed out RLE sprite from its cached minified version at zoom level 0, returns false if there is none.
+ */
+template<DrawBlendOp TBlendOp, size_t TZoom> static bool FASTCALL DrawRLESpriteMinifyCached(DrawSpriteArgs& args)
+{
+    auto dpi = args.DPI;
+    auto srcX = args.SrcX;
+    auto srcY = args.SrcY;
+    auto height = args.Height;
+    auto dst = args.DestinationBits;
+    auto zoom = 1 << TZoom;
+
+    // Same adjustment as DrawRLESpriteMinify
+    if (srcY < 0)
+    {
+        srcY += zoom;
+        height -= zoom;
+        dst += (static_cast<size_t>(dpi->width) >> TZoom) + dpi->pitch;
+    }
+
+    // The sampled pixels depend on the source start modulo the zoom, each phase is a separate minified sprite
+    auto phaseX = srcX & (zoom - 1);
+    auto phaseY = srcY & (zoom - 1);
+    auto minified = gfx_get_minified_rle_sprite(args.Image.GetIndex(), args.SourceImage, TZoom, phaseX, phaseY);
+    if (minified == nullptr)
+    {
+        return false;
+    }
+
+    rct_drawpixelinfo minifiedDpi = *dpi;
+    minifiedDpi.width = dpi->width >> TZoom;
+    minifiedDpi.height = dpi->height >> TZoom;
+    minifiedDpi.zoom_level = 0;
+
+    DrawSpriteArgs minifiedArgs(
+        &minifiedDpi, args.Image, args.PalMap, minified->Element, (srcX - phaseX) >> TZoom, (srcY - phaseY) >> TZoom,
+        (args.Width + zoom - 1) >> TZoom, (height + zoom - 1) >> TZoom, dst);
+    DrawRLESpriteMinify<TBlendOp, 0>(minifiedArgs);
+    return true;
+}
+
 template<DrawBlendOp TBlendOp> static void FASTCALL DrawRLESprite(DrawSpriteArgs& args)
 {
     auto zoom_level = static_cast<int8_t>(args.DPI->zoom_level);
@@ -193,13 +255,22 @@ template<DrawBlendOp TBlendOp> static void FASTCALL DrawRLESprite(DrawSpriteArgs
             DrawRLESpriteMinify<TBlendOp, 0>(args);
             break;
         case 1:
-            DrawRLESpriteMinify<TBlendOp, 1>(args);
+            if (!DrawRLESpriteMinifyCached<TBlendOp, 1>(args))
+            {
+                DrawRLESpriteMinify<TBlendOp, 1>(args);
+            }
             break;
         case 2:
-            DrawRLESpriteMinify<TBlendOp, 2>(args);
+            if (!DrawRLESpriteMinifyCached<TBlendOp, 2>(args))
+            {
+                DrawRLESpriteMinify<TBlendOp, 2>(args);
+            }
             break;
         case 3:
-            DrawRLESpriteMinify<TBlendOp, 3>(args);
+            if (!DrawRLESpriteMinifyCached<TBlendOp, 3>(args))
+            {
+                DrawRLESpriteMinify<TBlendOp, 3>(args);
+            }
             break;
         default:
             assert(false);
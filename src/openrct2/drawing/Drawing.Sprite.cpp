@@ -12,6 +12,7 @@
 #include "../PlatformEnvironment.h"
 #include "../config/Config.h"
 #include "../core/FileStream.h"
+#include "../core/MemoryMappedFileStream.h"
 #include "../core/Path.hpp"
 #include "../platform/platform.h"
 #include "../sprites.h"
@@ -154,6 +155,27 @@ static void read_and_convert_gxdat(IStream* stream, size_t count, bool is_rctc,
     }
 }
 
+/**
+ * Points the element offsets at the element data that follows the current position of the mapped file, instead of
+ * copying the data into a buffer.
+ */
+static void map_gxdat_data(rct_gx& gx, std::unique_ptr<MemoryMappedFileStream> fs)
+{
+    if (fs->GetLength() - fs->GetPosition() < gx.header.total_size)
+    {
+        throw std::runtime_error("Graphics file is shorter than expected");
+    }
+
+    auto dataBase = reinterpret_cast<uintptr_t>(static_cast<const uint8_t*>(fs->GetData()) + fs->GetPosition());
+    for (auto& element : gx.elements)
+    {
+        element.offset += dataBase;
+    }
+    gx.data = std::move(fs);
+}
+
+rct_gx::~rct_gx() = default;
+
 void mask_scalar(
     int32_t width, int32_t height, const uint8_t* RESTRICT maskSrc, const uint8_t* RESTRICT colourSrc, uint8_t* RESTRICT dst,
     int32_t maskWrap, int32_t colourWrap, int32_t dstWrap)
@@ -178,6 +200,29 @@ void mask_scalar(
     }
 }
 
+void rle_minify_copy_scalar(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t numPixels, int32_t zoomLevel)
+{
+    const int32_t zoom = 1 << zoomLevel;
+    while (numPixels > 0)
+    {
+        if (*src != 0)
+        {
+            *dst = *src;
+        }
+        numPixels -= zoom;
+        src += zoom;
+        dst++;
+    }
+}
+
+void light_add_scalar(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t numPixels, uint16_t multiplier)
+{
+    for (int32_t i = 0; i < numPixels; i++)
+    {
+        dst[i] = std::min(0xFF, dst[i] + ((src[i] * multiplier) >> 8));
+    }
+}
+
 static rct_gx _g1 = {};
 static rct_gx _g2 = {};
 static rct_gx _csg = {};
@@ -198,8 +243,8 @@ bool gfx_load_g1(const IPlatformEnvironment& env)
     try
     {
         auto path = Path::Combine(env.GetDirectoryPath(DIRBASE::RCT2, DIRID::DATA), "g1.dat");
-        auto fs = FileStream(path, FILE_MODE_OPEN);
-        _g1.header = fs.ReadValue<rct_g1_header>();
+        auto fs = std::make_unique<MemoryMappedFileStream>(path);
+        _g1.header = fs->ReadValue<rct_g1_header>();
 
         log_verbose("g1.dat, number of entries: %u", _g1.header.num_entries);
 
@@ -211,17 +256,10 @@ bool gfx_load_g1(const IPlatformEnvironment& env)
         // Read element headers
         bool is_rctc = _g1.header.num_entries == SPR_RCTC_G1_END;
         _g1.elements.resize(_g1.header.num_entries);
-        read_and_convert_gxdat(&fs, _g1.header.num_entries, is_rctc, _g1.elements.data());
+        read_and_convert_gxdat(fs.get(), _g1.header.num_entries, is_rctc, _g1.elements.data());
         gTinyFontAntiAliased = is_rctc;
 
-        // Read element data
-        _g1.data = fs.ReadArray<uint8_t>(_g1.header.total_size);
-
-        // Fix entry data offsets
-        for (uint32_t i = 0; i < _g1.header.num_entries; i++)
-        {
-            _g1.elements[i].offset += reinterpret_cast<uintptr_t>(_g1.data.get());
-        }
+        map_gxdat_data(_g1, std::move(fs));
         return true;
     }
     catch (const std::exception&)
@@ -241,6 +279,7 @@ bool gfx_load_g1(const IPlatformEnvironment& env)
 
 void gfx_unload_g1()
 {
+    gfx_clear_minified_rle_sprites();
     _g1.data.reset();
     _g1.elements.clear();
     _g1.elements.shrink_to_fit();
@@ -248,6 +287,7 @@ void gfx_unload_g1()
 
 void gfx_unload_g2()
 {
+    gfx_clear_minified_rle_sprites();
     _g2.data.reset();
     _g2.elements.clear();
     _g2.elements.shrink_to_fit();
@@ -255,6 +295,7 @@ void gfx_unload_g2()
 
 void gfx_unload_csg()
 {
+    gfx_clear_minified_rle_sprites();
     _csg.data.reset();
     _csg.elements.clear();
     _csg.elements.shrink_to_fit();
@@ -270,21 +311,14 @@ bool gfx_load_g2()
     safe_strcat_path(path, "g2.dat", MAX_PATH);
     try
     {
-        auto fs = FileStream(path, FILE_MODE_OPEN);
-        _g2.header = fs.ReadValue<rct_g1_header>();
+        auto fs = std::make_unique<MemoryMappedFileStream>(path);
+        _g2.header = fs->ReadValue<rct_g1_header>();
 
         // Read element headers
         _g2.elements.resize(_g2.header.num_entries);
-        read_and_convert_gxdat(&fs, _g2.header.num_entries, false, _g2.elements.data());
-
-        // Read element data
-        _g2.data = fs.ReadArray<uint8_t>(_g2.header.total_size);
+        read_and_convert_gxdat(fs.get(), _g2.header.num_entries, false, _g2.elements.data());
 
-        // Fix entry data offsets
-        for (uint32_t i = 0; i < _g2.header.num_entries; i++)
-        {
-            _g2.elements[i].offset += reinterpret_cast<uintptr_t>(_g2.data.get());
-        }
+        map_gxdat_data(_g2, std::move(fs));
         return true;
     }
     catch (const std::exception&)
@@ -317,14 +351,14 @@ bool gfx_load_csg()
     try
     {
         auto fileHeader = FileStream(pathHeaderPath, FILE_MODE_OPEN);
-        auto fileData = FileStream(pathDataPath, FILE_MODE_OPEN);
+        auto fileData = std::make_unique<MemoryMappedFileStream>(pathDataPath);
         size_t fileHeaderSize = fileHeader.GetLength();
-        size_t fileDataSize = fileData.GetLength();
+        size_t fileDataSize = fileData->GetLength();
 
         _csg.header.num_entries = static_cast<uint32_t>(fileHeaderSize / sizeof(rct_g1_element_32bit));
         _csg.header.total_size = static_cast<uint32_t>(fileDataSize);
 
-        if (!CsgIsUsable(_csg))
+        if (!CsgIsUsable(_csg.header))
         {
             log_warning("Cannot load CSG1.DAT, it has too few entries. Only CSG1.DAT from Loopy Landscapes will work.");
             return false;
@@ -334,13 +368,10 @@ bool gfx_load_csg()
         _csg.elements.resize(_csg.header.num_entries);
         read_and_convert_gxdat(&fileHeader, _csg.header.num_entries, false, _csg.elements.data());
 
-        // Read element data
-        _csg.data = fileData.ReadArray<uint8_t>(_csg.header.total_size);
+        map_gxdat_data(_csg, std::move(fileData));
 
-        // Fix entry data offsets
         for (uint32_t i = 0; i < _csg.header.num_entries; i++)
         {
-            _csg.elements[i].offset += reinterpret_cast<uintptr_t>(_csg.data.get());
             // RCT1 used zoomed offsets that counted from the beginning of the file, rather than from the current sprite.
             if (_csg.elements[i].flags & G1_FLAG_HAS_ZOOM_SPRITE)
             {
@@ -716,6 +747,7 @@ const rct_g1_element* gfx_get_g1_element(int32_t image_id)
         size_t idx = offset - SPR_IMAGE_LIST_BEGIN;
         if (idx < _imageListElements.size())
         {
+            gfx_object_use_lazy_image(static_cast<uint32_t>(offset));
             return &_imageListElements[idx];
         }
     }
@@ -736,6 +768,7 @@ void gfx_set_g1_element(int32_t imageId, const rct_g1_element* g1)
 
     if (g1 != nullptr)
     {
+        gfx_invalidate_minified_rle_sprites(imageId);
         if (isTemp)
         {
             _g1Temp = *g1;
@@ -771,6 +804,22 @@ void gfx_set_g1_element(int32_t imageId, const rct_g1_element* g1)
     }
 }
 
+/**
+ * Points the elements of an object image list at the pixel data of the given images, or clears their offsets if images
+ * is nullptr. The other fields are left untouched, so drawing threads can keep reading them meanwhile.
+ */
+void gfx_set_g1_element_offsets(uint32_t baseImageId, const rct_g1_element* images, uint32_t count)
+{
+    openrct2_assert(
+        baseImageId >= SPR_IMAGE_LIST_BEGIN && baseImageId + count <= SPR_IMAGE_LIST_END,
+        "gfx_set_g1_element_offsets called with unexpected image id");
+    size_t baseIdx = baseImageId - SPR_IMAGE_LIST_BEGIN;
+    for (size_t i = 0; i < count && baseIdx + i < _imageListElements.size(); i++)
+    {
+        _imageListElements[baseIdx + i].offset = images != nullptr ? images[i].offset : nullptr;
+    }
+}
+
 bool is_csg_loaded()
 {
     return _csgLoaded;
@@ -21,6 +21,13 @@
 #include "TTF.h"
 
 #include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 using namespace OpenRCT2;
 
@@ -38,6 +45,145 @@ enum : uint32_t
 
 static int32_t ttf_get_string_width(std::string_view text, FontSpriteBase fontSpriteBase, bool noFormatting);
 
+namespace
+{
+    // The cache is trimmed back to three quarters of this once it grows beyond it
+    constexpr size_t MaxLayoutCacheEntries = 8192;
+
+    enum class TextLayoutKind : uint8_t
+    {
+        Width,
+        WidthNoFormatting,
+        Clip,
+        Wrap,
+    };
+
+    struct TextLayoutEntry
+    {
+        std::string Text;
+        FontSpriteBase Font{};
+        TextLayoutKind Kind{};
+        bool TrueTypeFont{};
+        int32_t AvailableWidth{};
+        // The clipped or wrapped text, including the NUL line terminators of wrapped text
+        std::string Result;
+        int32_t Width{};
+        int32_t NumLines{};
+        std::atomic<uint32_t> LastUsed{};
+    };
+
+    std::shared_mutex _layoutMutex;
+    std::unordered_map<size_t, TextLayoutEntry> _layoutEntries;
+    std::atomic<uint32_t> _layoutUseCounter{};
+
+    using layout_shared_lock = std::shared_lock<std::shared_mutex>;
+    using layout_unique_lock = std::unique_lock<std::shared_mutex>;
+} // namespace
+
+static size_t GetTextLayoutKey(
+    std::string_view text, FontSpriteBase fontSpriteBase, TextLayoutKind kind, bool trueTypeFont, int32_t availableWidth)
+{
+    auto key = std::hash<std::string_view>()(text);
+    auto combine = [&key](size_t value) { key ^= value + 0x9E3779B9 + (key << 6) + (key >> 2); };
+    combine(static_cast<size_t>(fontSpriteBase));
+    combine((static_cast<size_t>(kind) << 1) | (trueTypeFont ? 1 : 0));
+    combine(static_cast<uint32_t>(availableWidth));
+    return key;
+}
+
+/**
+ * Looks up a previously measured layout of the text, keys are only hashes so the entry is compared in full before it
+ * is used.
+ */
+template<typename TFunc>
+static auto FindTextLayout(
+    std::string_view text, FontSpriteBase fontSpriteBase, TextLayoutKind kind, int32_t availableWidth, TFunc&& onHit)
+{
+    const auto trueTypeFont = LocalisationService_UseTrueTypeFont();
+    const auto key = GetTextLayoutKey(text, fontSpriteBase, kind, trueTypeFont, availableWidth);
+
+    layout_shared_lock lock(_layoutMutex);
+    auto it = _layoutEntries.find(key);
+    if (it == _layoutEntries.end())
+    {
+        return false;
+    }
+    auto& entry = it->second;
+    if (entry.Font != fontSpriteBase || entry.Kind != kind || entry.TrueTypeFont != trueTypeFont
+        || entry.AvailableWidth != availableWidth || entry.Text != text)
+    {
+        return false;
+    }
+    entry.LastUsed.store(_layoutUseCounter.fetch_add(1, std::memory_order_relaxed), std::memory_order_relaxed);
+    onHit(entry);
+    return true;
+}
+
+static void TrimTextLayoutCache()
+{
+    std::vector<std::pair<uint32_t, size_t>> entriesByAge;
+    entriesByAge.reserve(_layoutEntries.size());
+    for (const auto& [key, entry] : _layoutEntries)
+    {
+        entriesByAge.emplace_back(entry.LastUsed.load(std::memory_order_relaxed), key);
+    }
+    std::sort(entriesByAge.begin(), entriesByAge.end());
+
+    const auto numToRemove = _layoutEntries.size() - MaxLayoutCacheEntries / 4 * 3;
+    for (size_t i = 0; i < numToRemove; i++)
+    {
+        _layoutEntries.erase(entriesByAge[i].second);
+    }
+}
+
+static void StoreTextLayout(
+    std::string_view text, FontSpriteBase fontSpriteBase, TextLayoutKind kind, int32_t availableWidth,
+    std::string_view result, int32_t width, int32_t numLines)
+{
+    const auto trueTypeFont = LocalisationService_UseTrueTypeFont();
+    const auto key = GetTextLayoutKey(text, fontSpriteBase, kind, trueTypeFont, availableWidth);
+
+    // A colliding entry is simply replaced
+    layout_unique_lock lock(_layoutMutex);
+    auto& entry = _layoutEntries[key];
+    entry.Text = text;
+    entry.Font = fontSpriteBase;
+    entry.Kind = kind;
+    entry.TrueTypeFont = trueTypeFont;
+    entry.AvailableWidth = availableWidth;
+    entry.Result = result;
+    entry.Width = width;
+    entry.NumLines = numLines;
+    entry.LastUsed.store(_layoutUseCounter.fetch_add(1, std::memory_order_relaxed), std::memory_order_relaxed);
+    if (_layoutEntries.size() > MaxLayoutCacheEntries)
+    {
+        TrimTextLayoutCache();
+    }
+}
+
+/**
+ * Forgets all measured text, must be called whenever the glyphs or their metrics may have changed.
+ */
+void gfx_clear_text_layout_cache()
+{
+    layout_unique_lock lock(_layoutMutex);
+    _layoutEntries.clear();
+}
+
+static int32_t get_string_width_cached(std::string_view text, FontSpriteBase fontSpriteBase, bool noFormatting)
+{
+    const auto kind = noFormatting ? TextLayoutKind::WidthNoFormatting : TextLayoutKind::Width;
+    int32_t width = 0;
+    if (FindTextLayout(text, fontSpriteBase, kind, 0, [&width](const TextLayoutEntry& entry) { width = entry.Width; }))
+    {
+        return width;
+    }
+
+    width = ttf_get_string_width(text, fontSpriteBase, noFormatting);
+    StoreTextLayout(text, fontSpriteBase, kind, 0, {}, width, 0);
+    return width;
+}
+
 /**
  *
  *  rct2: 0x006C23B1
@@ -80,14 +226,18 @@ int32_t gfx_get_string_width_new_lined(std::string_view text, FontSpriteBase fon
  */
 int32_t gfx_get_string_width(std::string_view text, FontSpriteBase fontSpriteBase)
 {
-    return ttf_get_string_width(text, fontSpriteBase, false);
+    return get_string_width_cached(text, fontSpriteBase, false);
 }
 
 int32_t gfx_get_string_width_no_formatting(std::string_view text, FontSpriteBase fontSpriteBase)
 {
-    return ttf_get_string_width(text, fontSpriteBase, true);
+    return get_string_width_cached(text, fontSpriteBase, true);
 }
 
+static int32_t clip_string_uncached(utf8* text, int32_t width, FontSpriteBase fontSpriteBase);
+static int32_t wrap_string_uncached(
+    std::string_view text, int32_t width, FontSpriteBase fontSpriteBase, int32_t* outNumLines, std::string& buffer);
+
 /**
  * Clip the text in buffer to width, add ellipsis and return the new width of the clipped string
  *
@@ -103,8 +253,29 @@ int32_t gfx_clip_string(utf8* text, int32_t width, FontSpriteBase fontSpriteBase
         return 0;
     }
 
+    const std::string_view input(text);
+    int32_t clippedWidth = 0;
+    auto found = FindTextLayout(input, fontSpriteBase, TextLayoutKind::Clip, width, [&](const TextLayoutEntry& entry) {
+        std::memcpy(text, entry.Result.c_str(), entry.Result.size() + 1);
+        clippedWidth = entry.Width;
+    });
+    if (found)
+    {
+        return clippedWidth;
+    }
+
+    // The clipped text overwrites the input, so keep a copy of it to store the layout under
+    thread_local std::string original;
+    original = input;
+    clippedWidth = clip_string_uncached(text, width, fontSpriteBase);
+    StoreTextLayout(original, fontSpriteBase, TextLayoutKind::Clip, width, text, clippedWidth, 0);
+    return clippedWidth;
+}
+
+static int32_t clip_string_uncached(utf8* text, int32_t width, FontSpriteBase fontSpriteBase)
+{
     // If width of the full string is less than allowed width then we don't need to clip
-    auto clippedWidth = gfx_get_string_width(text, fontSpriteBase);
+    auto clippedWidth = ttf_get_string_width(text, fontSpriteBase, false);
     if (clippedWidth <= width)
     {
         return clippedWidth;
@@ -126,7 +297,7 @@ int32_t gfx_clip_string(utf8* text, int32_t width, FontSpriteBase fontSpriteBase
             // Add the ellipsis before checking the width
             buffer.append("...");
 
-            auto currentWidth = gfx_get_string_width(buffer, fontSpriteBase);
+            auto currentWidth = ttf_get_string_width(buffer, fontSpriteBase, false);
             if (currentWidth < width)
             {
                 bestLength = buffer.size();
@@ -154,7 +325,7 @@ int32_t gfx_clip_string(utf8* text, int32_t width, FontSpriteBase fontSpriteBase
             buffer.append(cb);
         }
     }
-    return gfx_get_string_width(text, fontSpriteBase);
+    return ttf_get_string_width(text, fontSpriteBase, false);
 }
 
 /**
@@ -172,8 +343,33 @@ int32_t gfx_clip_string(utf8* text, int32_t width, FontSpriteBase fontSpriteBase
  */
 int32_t gfx_wrap_string(utf8* text, int32_t width, FontSpriteBase fontSpriteBase, int32_t* outNumLines)
 {
-    constexpr size_t NULL_INDEX = std::numeric_limits<size_t>::max();
+    const std::string_view input(text);
+    int32_t maxWidth = 0;
+    auto found = FindTextLayout(input, fontSpriteBase, TextLayoutKind::Wrap, width, [&](const TextLayoutEntry& entry) {
+        std::memcpy(text, entry.Result.data(), entry.Result.size());
+        *outNumLines = entry.NumLines;
+        maxWidth = entry.Width;
+    });
+    if (found)
+    {
+        return maxWidth;
+    }
+
+    // The lines of the wrapped text are separated by NUL characters
     thread_local std::string buffer;
+    maxWidth = wrap_string_uncached(input, width, fontSpriteBase, outNumLines, buffer);
+    StoreTextLayout(
+        input, fontSpriteBase, TextLayoutKind::Wrap, width, std::string_view(buffer.data(), buffer.size() + 1), maxWidth,
+        *outNumLines);
+
+    std::memcpy(text, buffer.data(), buffer.size() + 1);
+    return maxWidth;
+}
+
+static int32_t wrap_string_uncached(
+    std::string_view text, int32_t width, FontSpriteBase fontSpriteBase, int32_t* outNumLines, std::string& buffer)
+{
+    constexpr size_t NULL_INDEX = std::numeric_limits<size_t>::max();
     buffer.resize(0);
 
     size_t currentLineIndex = 0;
@@ -194,7 +390,7 @@ int32_t gfx_wrap_string(utf8* text, int32_t width, FontSpriteBase fontSpriteBase
                 utf8_write_codepoint(cb, codepoint);
                 buffer.append(cb);
 
-                auto lineWidth = gfx_get_string_width(&buffer[currentLineIndex], fontSpriteBase);
+                auto lineWidth = ttf_get_string_width(&buffer[currentLineIndex], fontSpriteBase, false);
                 if (lineWidth <= width || (splitIndex == NULL_INDEX && bestSplitIndex == NULL_INDEX))
                 {
                     if (codepoint == ' ')
@@ -218,7 +414,7 @@ int32_t gfx_wrap_string(utf8* text, int32_t width, FontSpriteBase fontSpriteBase
                     buffer.insert(buffer.begin() + splitIndex, '\0');
 
                     // Recalculate the line length after splitting
-                    lineWidth = gfx_get_string_width(&buffer[currentLineIndex], fontSpriteBase);
+                    lineWidth = ttf_get_string_width(&buffer[currentLineIndex], fontSpriteBase, false);
                     maxWidth = std::max(maxWidth, lineWidth);
                     numLines++;
 
@@ -238,7 +434,7 @@ int32_t gfx_wrap_string(utf8* text, int32_t width, FontSpriteBase fontSpriteBase
         {
             buffer.push_back('\0');
 
-            auto lineWidth = gfx_get_string_width(&buffer[currentLineIndex], fontSpriteBase);
+            auto lineWidth = ttf_get_string_width(&buffer[currentLineIndex], fontSpriteBase, false);
             maxWidth = std::max(maxWidth, lineWidth);
             numLines++;
 
@@ -253,11 +449,10 @@ int32_t gfx_wrap_string(utf8* text, int32_t width, FontSpriteBase fontSpriteBase
     }
     {
         // Final line width calculation
-        auto lineWidth = gfx_get_string_width(&buffer[currentLineIndex], fontSpriteBase);
+        auto lineWidth = ttf_get_string_width(&buffer[currentLineIndex], fontSpriteBase, false);
         maxWidth = std::max(maxWidth, lineWidth);
     }
 
-    std::memcpy(text, buffer.data(), buffer.size() + 1);
     *outNumLines = static_cast<int32_t>(numLines);
     return maxWidth;
 }
@@ -539,13 +734,13 @@ static void ttf_draw_string_raw_ttf(rct_drawpixelinfo* dpi, std::string_view tex
 
     if (info->flags & TEXT_DRAW_FLAG_NO_DRAW)
     {
-        info->x += ttf_getwidth_cache_get_or_add(fontDesc->font, text);
+        info->x += ttf_get_width(fontDesc->font, text);
         return;
     }
     else
     {
         uint8_t colour = info->palette[1];
-        TTFSurface* surface = ttf_surface_cache_get_or_add(fontDesc->font, text);
+        const TTFSurface* surface = ttf_render_string(fontDesc->font, text);
         if (surface == nullptr)
             return;
 
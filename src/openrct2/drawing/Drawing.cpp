@@ -64,6 +64,11 @@ uint8_t PaletteMap::operator[](size_t index) const
     return _data[index];
 }
 
+const uint8_t* PaletteMap::GetFullMap() const
+{
+    return _mapLength >= PALETTE_SIZE && _dataLength >= PALETTE_SIZE ? _data : nullptr;
+}
+
 uint8_t PaletteMap::Blend(uint8_t src, uint8_t dst) const
 {
     // src = 0 would be transparent so there is no blend palette for that, hence (src - 1)
@@ -575,6 +580,50 @@ void mask_init()
     }
 }
 
+void (*rle_minify_copy_fn)(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t numPixels, int32_t zoomLevel)
+    = rle_minify_copy_scalar;
+
+void rle_minify_init()
+{
+    if (avx2_available())
+    {
+        log_verbose("registering AVX2 RLE minify function");
+        rle_minify_copy_fn = rle_minify_copy_avx2;
+    }
+    else if (sse41_available())
+    {
+        log_verbose("registering SSE4.1 RLE minify function");
+        rle_minify_copy_fn = rle_minify_copy_sse4_1;
+    }
+    else
+    {
+        log_verbose("registering scalar RLE minify function");
+        rle_minify_copy_fn = rle_minify_copy_scalar;
+    }
+}
+
+void (*light_add_fn)(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t numPixels, uint16_t multiplier)
+    = light_add_scalar;
+
+void light_add_init()
+{
+    if (avx2_available())
+    {
+        log_verbose("registering AVX2 light add function");
+        light_add_fn = light_add_avx2;
+    }
+    else if (sse41_available())
+    {
+        log_verbose("registering SSE4.1 light add function");
+        light_add_fn = light_add_sse4_1;
+    }
+    else
+    {
+        log_verbose("registering scalar light add function");
+        light_add_fn = light_add_scalar;
+    }
+}
+
 void gfx_filter_pixel(rct_drawpixelinfo* dpi, const ScreenCoordsXY& coords, FilterPaletteID palette)
 {
     gfx_filter_rect(dpi, { coords, coords }, palette);
@@ -27,7 +27,8 @@ struct ScreenRect;
 namespace OpenRCT2
 {
     struct IPlatformEnvironment;
-}
+    class MemoryMappedFileStream;
+} // namespace OpenRCT2
 
 namespace OpenRCT2::Drawing
 {
@@ -99,7 +100,10 @@ struct rct_gx
 {
     rct_g1_header header;
     std::vector<rct_g1_element> elements;
-    std::unique_ptr<uint8_t[]> data;
+    // The element offsets point into this read-only mapping of the file, so it is shared between processes
+    std::unique_ptr<OpenRCT2::MemoryMappedFileStream> data;
+
+    ~rct_gx();
 };
 
 struct rct_drawpixelinfo
@@ -536,6 +540,12 @@ public:
     uint8_t& operator[](size_t index);
     uint8_t operator[](size_t index) const;
     uint8_t Blend(uint8_t src, uint8_t dst) const;
+
+    /**
+     * The first map when it has an entry for every palette index, so spans of pixels can be remapped without bounds
+     * checks. nullptr when the map is shorter.
+     */
+    const uint8_t* GetFullMap() const;
     void Copy(size_t dstIndex, const PaletteMap& src, size_t srcIndex, size_t length);
 };
 
@@ -710,15 +720,54 @@ void gfx_unload_csg();
 const rct_g1_element* gfx_get_g1_element(ImageId imageId);
 const rct_g1_element* gfx_get_g1_element(int32_t image_id);
 void gfx_set_g1_element(int32_t imageId, const rct_g1_element* g1);
+void gfx_set_g1_element_offsets(uint32_t baseImageId, const rct_g1_element* images, uint32_t count);
 bool is_csg_loaded();
-uint32_t gfx_object_allocate_images(const rct_g1_element* images, uint32_t count);
+
+/**
+ * Provides the pixel data of a list of object images, which is only read when one of the images is first drawn and can
+ * be unloaded again when the images have not been drawn for a while.
+ */
+struct ILazyImageSource
+{
+    virtual ~ILazyImageSource() = default;
+
+    /**
+     * Reads the pixel data if it is not loaded yet and returns the images with their offsets pointing at it.
+     */
+    virtual const rct_g1_element* LoadImageData() abstract;
+    virtual void UnloadImageData() abstract;
+    virtual size_t GetImageDataSize() const abstract;
+};
+
+uint32_t gfx_object_allocate_images(const rct_g1_element* images, uint32_t count, ILazyImageSource* lazySource = nullptr);
 void gfx_object_free_images(uint32_t baseImageId, uint32_t count);
+void gfx_object_use_lazy_image(uint32_t imageId);
+void gfx_object_evict_lazy_images();
 void gfx_object_check_all_images_freed();
 size_t ImageListGetUsedCount();
 size_t ImageListGetMaximum();
 void FASTCALL gfx_sprite_to_buffer(DrawSpriteArgs& args);
 void FASTCALL gfx_bmp_sprite_to_buffer(DrawSpriteArgs& args);
 void FASTCALL gfx_rle_sprite_to_buffer(DrawSpriteArgs& args);
+
+/**
+ * An RLE sprite with only every (1 << zoom)th pixel of every (1 << zoom)th line of its source image, so zoomed out
+ * views can draw it at zoom level 0 instead of skipping pixels of the full resolution image.
+ */
+struct MinifiedRLESprite
+{
+    std::vector<uint8_t> Data;
+    rct_g1_element Element;
+};
+
+/**
+ * Returns the cached minified version of an RLE image for the given zoom level and sampling phase, creating it if
+ * necessary, or nullptr if the image can not be cached. The cache is bounded in size and shared by all paint threads.
+ */
+std::shared_ptr<const MinifiedRLESprite> gfx_get_minified_rle_sprite(
+    uint32_t imageIndex, const rct_g1_element& g1, int32_t zoomLevel, int32_t phaseX, int32_t phaseY);
+void gfx_invalidate_minified_rle_sprites(uint32_t imageIndex);
+void gfx_clear_minified_rle_sprites();
 void FASTCALL gfx_draw_sprite(rct_drawpixelinfo* dpi, int32_t image_id, const ScreenCoordsXY& coords, uint32_t tertiary_colour);
 void FASTCALL
     gfx_draw_glyph(rct_drawpixelinfo* dpi, int32_t image_id, const ScreenCoordsXY& coords, const PaletteMap& paletteMap);
@@ -754,6 +803,7 @@ int32_t gfx_get_string_width_new_lined(std::string_view text, FontSpriteBase fon
 int32_t gfx_get_string_width_no_formatting(std::string_view text, FontSpriteBase fontSpriteBase);
 int32_t string_get_height_raw(std::string_view text, FontSpriteBase fontBase);
 int32_t gfx_clip_string(char* buffer, int32_t width, FontSpriteBase fontSpriteBase);
+void gfx_clear_text_layout_cache();
 void shorten_path(utf8* buffer, size_t bufferSize, const utf8* path, int32_t availableWidth, FontSpriteBase fontSpriteBase);
 void ttf_draw_string(
     rct_drawpixelinfo* dpi, const_utf8string text, int32_t colour, const ScreenCoordsXY& coords, bool noFormatting,
@@ -787,6 +837,28 @@ extern void (*mask_fn)(
     int32_t width, int32_t height, const uint8_t* RESTRICT maskSrc, const uint8_t* RESTRICT colourSrc, uint8_t* RESTRICT dst,
     int32_t maskWrap, int32_t colourWrap, int32_t dstWrap);
 
+/**
+ * Copies every (1 << zoomLevel)th pixel of a run of numPixels RLE sprite pixels to dst, skipping transparent (0) pixels.
+ * Only zoom levels 1 to 3 are supported.
+ */
+void rle_minify_copy_scalar(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t numPixels, int32_t zoomLevel);
+void rle_minify_copy_sse4_1(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t numPixels, int32_t zoomLevel);
+void rle_minify_copy_avx2(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t numPixels, int32_t zoomLevel);
+void rle_minify_init();
+
+extern void (*rle_minify_copy_fn)(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t numPixels, int32_t zoomLevel);
+
+/**
+ * Adds numPixels light intensities from src, scaled by multiplier / 256, to dst saturating at 255. The multiplier has
+ * to be between 1 and 256.
+ */
+void light_add_scalar(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t numPixels, uint16_t multiplier);
+void light_add_sse4_1(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t numPixels, uint16_t multiplier);
+void light_add_avx2(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t numPixels, uint16_t multiplier);
+void light_add_init();
+
+extern void (*light_add_fn)(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t numPixels, uint16_t multiplier);
+
 std::optional<uint32_t> GetPaletteG1Index(colour_t paletteId);
 std::optional<PaletteMap> GetPaletteMapForColour(colour_t paletteId);
 
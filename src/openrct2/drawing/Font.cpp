@@ -264,6 +264,7 @@ void font_sprite_initialise_characters()
     }
 
     scrolling_text_initialise_bitmaps();
+    gfx_clear_text_layout_cache();
 }
 
 int32_t font_sprite_get_codepoint_offset(int32_t codepoint)
@@ -46,6 +46,17 @@ namespace OpenRCT2::Drawing
 {
     struct IDrawingContext;
 
+    /**
+     * How much of the screen was redrawn in a frame.
+     */
+    struct DrawingEngineDirtyStats
+    {
+        uint32_t Invalidations;
+        uint32_t Regions;
+        uint64_t Pixels;
+        uint64_t ScreenPixels;
+    };
+
     struct IDrawingEngine
     {
         virtual ~IDrawingEngine()
@@ -72,6 +83,8 @@ namespace OpenRCT2::Drawing
         virtual DRAWING_ENGINE_FLAGS GetFlags() abstract;
 
         virtual void InvalidateImage(uint32_t image) abstract;
+
+        virtual DrawingEngineDirtyStats GetLastFrameDirtyStats() abstract;
     };
 
     struct IDrawingEngineFactory
@@ -8,13 +8,19 @@
  *****************************************************************************/
 
 #include "../OpenRCT2.h"
+#include "../config/Config.h"
 #include "../core/Console.hpp"
 #include "../core/Guard.hpp"
+#include "../platform/platform.h"
 #include "../sprites.h"
 #include "Drawing.h"
 
 #include <algorithm>
+#include <atomic>
 #include <list>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 constexpr uint32_t BASE_IMAGE_ID = SPR_IMAGE_LIST_BEGIN;
 constexpr uint32_t MAX_IMAGES = SPR_IMAGE_LIST_END - BASE_IMAGE_ID;
@@ -26,10 +32,31 @@ struct ImageList
     uint32_t Count;
 };
 
+struct LazyImageList
+{
+    ILazyImageSource* Source;
+    uint32_t BaseId;
+    uint32_t Count;
+    std::atomic<bool> Loaded{};
+    std::atomic<uint32_t> LastUsedFrame{};
+};
+
 static bool _initialised = false;
 static std::list<ImageList> _freeLists;
 static uint32_t _allocatedImageCount;
 
+// Only changed on the main thread while nothing is being drawn, images are loaded on first use by any drawing thread
+static std::vector<std::unique_ptr<LazyImageList>> _lazyImageLists;
+static std::vector<LazyImageList*> _lazyImageListsBySlot;
+static std::mutex _lazyImageMutex;
+static std::atomic<uint32_t> _lazyImageFrame;
+static size_t _lazyImageDataSize;
+
+// Images that have not been drawn for this long are unloaded even when the loaded pixel data fits in the budget
+static constexpr uint32_t LAZY_IMAGE_IDLE_TIME_MS = 60000;
+static uint32_t _lazyImageIdleCheckTime;
+static uint32_t _lazyImageIdleCheckFrame;
+
 #ifdef DEBUG
 static std::list<ImageList> _allocatedLists;
 
@@ -187,7 +214,158 @@ static void FreeImageList(uint32_t baseImageId, uint32_t count)
     _freeLists.push_back({ baseImageId, count });
 }
 
-uint32_t gfx_object_allocate_images(const rct_g1_element* images, uint32_t count)
+static void AddLazyImageList(ILazyImageSource* source, uint32_t baseImageId, uint32_t count)
+{
+    auto list = std::make_unique<LazyImageList>();
+    list->Source = source;
+    list->BaseId = baseImageId;
+    list->Count = count;
+
+    auto endSlot = baseImageId - BASE_IMAGE_ID + count;
+    if (_lazyImageListsBySlot.size() < endSlot)
+    {
+        _lazyImageListsBySlot.resize(endSlot);
+    }
+    std::fill_n(_lazyImageListsBySlot.begin() + (baseImageId - BASE_IMAGE_ID), count, list.get());
+    _lazyImageLists.push_back(std::move(list));
+
+    // Pixel data read along with the object is dropped straight away, it is read again when one of the images is drawn
+    source->UnloadImageData();
+    gfx_set_g1_element_offsets(baseImageId, nullptr, count);
+}
+
+static void RemoveLazyImageList(uint32_t baseImageId)
+{
+    auto it = std::find_if(_lazyImageLists.begin(), _lazyImageLists.end(), [baseImageId](const auto& list) {
+        return list->BaseId == baseImageId;
+    });
+    if (it == _lazyImageLists.end())
+    {
+        return;
+    }
+
+    auto& list = **it;
+    std::lock_guard<std::mutex> lock(_lazyImageMutex);
+    if (list.Loaded)
+    {
+        _lazyImageDataSize -= list.Source->GetImageDataSize();
+        list.Source->UnloadImageData();
+    }
+    std::fill_n(_lazyImageListsBySlot.begin() + (baseImageId - BASE_IMAGE_ID), list.Count, nullptr);
+    _lazyImageLists.erase(it);
+}
+
+static void LoadLazyImageList(LazyImageList& list)
+{
+    std::lock_guard<std::mutex> lock(_lazyImageMutex);
+    if (list.Loaded)
+    {
+        return;
+    }
+
+    gfx_set_g1_element_offsets(list.BaseId, list.Source->LoadImageData(), list.Count);
+    _lazyImageDataSize += list.Source->GetImageDataSize();
+    list.Loaded = true;
+}
+
+/**
+ * Makes sure the pixel data of the image is loaded if it is part of a lazily loaded list.
+ */
+void gfx_object_use_lazy_image(uint32_t imageId)
+{
+    auto slot = static_cast<size_t>(imageId - BASE_IMAGE_ID);
+    if (imageId < BASE_IMAGE_ID || slot >= _lazyImageListsBySlot.size())
+    {
+        return;
+    }
+
+    auto list = _lazyImageListsBySlot[slot];
+    if (list != nullptr)
+    {
+        // Only write when it changes to keep drawing threads from contending on the cache line
+        auto frame = _lazyImageFrame.load(std::memory_order_relaxed);
+        if (list->LastUsedFrame.load(std::memory_order_relaxed) != frame)
+        {
+            list->LastUsedFrame.store(frame, std::memory_order_relaxed);
+        }
+        if (!list->Loaded.load(std::memory_order_acquire))
+        {
+            LoadLazyImageList(*list);
+        }
+    }
+}
+
+static void UnloadLazyImageList(LazyImageList& list)
+{
+    _lazyImageDataSize -= list.Source->GetImageDataSize();
+    list.Source->UnloadImageData();
+    gfx_set_g1_element_offsets(list.BaseId, nullptr, list.Count);
+    list.Loaded = false;
+}
+
+/**
+ * Unloads the images that have not been drawn since the previous check, which is done once every idle time.
+ */
+static void EvictIdleLazyImages(uint32_t frame)
+{
+    auto currentTime = platform_get_ticks();
+    if (currentTime - _lazyImageIdleCheckTime < LAZY_IMAGE_IDLE_TIME_MS)
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(_lazyImageMutex);
+    for (const auto& list : _lazyImageLists)
+    {
+        if (list->Loaded && frame - list->LastUsedFrame > frame - _lazyImageIdleCheckFrame)
+        {
+            UnloadLazyImageList(*list);
+        }
+    }
+    _lazyImageIdleCheckTime = currentTime;
+    _lazyImageIdleCheckFrame = frame;
+}
+
+/**
+ * Unloads the images that were drawn longest ago until the loaded pixel data fits in the object image budget, as well as
+ * the images that have not been drawn for a while. Must only be called while nothing is being drawn.
+ */
+void gfx_object_evict_lazy_images()
+{
+    auto frame = _lazyImageFrame.fetch_add(1, std::memory_order_relaxed);
+    EvictIdleLazyImages(frame);
+
+    auto budget = static_cast<size_t>(std::max(0, gConfigGeneral.object_image_budget)) * 1024 * 1024;
+    if (_lazyImageDataSize <= budget)
+    {
+        return;
+    }
+
+    // Images drawn in the last frame are kept even when over budget, they would only be loaded again straight away
+    std::vector<LazyImageList*> candidates;
+    for (const auto& list : _lazyImageLists)
+    {
+        if (list->Loaded && list->LastUsedFrame != frame)
+        {
+            candidates.push_back(list.get());
+        }
+    }
+    std::sort(candidates.begin(), candidates.end(), [frame](const LazyImageList* a, const LazyImageList* b) {
+        return frame - a->LastUsedFrame > frame - b->LastUsedFrame;
+    });
+
+    std::lock_guard<std::mutex> lock(_lazyImageMutex);
+    for (auto list : candidates)
+    {
+        if (_lazyImageDataSize <= budget)
+        {
+            break;
+        }
+        UnloadLazyImageList(*list);
+    }
+}
+
+uint32_t gfx_object_allocate_images(const rct_g1_element* images, uint32_t count, ILazyImageSource* lazySource)
 {
     if (count == 0 || gOpenRCT2NoGraphics)
     {
@@ -209,6 +387,11 @@ uint32_t gfx_object_allocate_images(const rct_g1_element* images, uint32_t count
         imageId++;
     }
 
+    if (lazySource != nullptr)
+    {
+        AddLazyImageList(lazySource, baseImageId, count);
+    }
+
     return baseImageId;
 }
 
@@ -216,6 +399,8 @@ void gfx_object_free_images(uint32_t baseImageId, uint32_t count)
 {
     if (baseImageId != 0 && baseImageId != INVALID_IMAGE_ID)
     {
+        RemoveLazyImageList(baseImageId);
+
         // Zero the G1 elements so we don't have invalid pointers
         // and data lying about
         for (uint32_t i = 0; i < count; i++)
@@ -11,15 +11,57 @@
 
 #include "../core/Imaging.h"
 
+#include <algorithm>
+#include <array>
 #include <cstring>
 #include <stdexcept>
 #include <string>
+#include <utility>
 
 using namespace OpenRCT2::Drawing;
 using ImportResult = ImageImporter::ImportResult;
 
 constexpr int32_t PALETTE_TRANSPARENT = -1;
 
+/**
+ * The standard palette arranged for the colour searches every pixel makes: the colours sorted for a binary search of
+ * exact matches, and the changeable colours as separate channel arrays so the closest colour search vectorises.
+ */
+struct PaletteLookup
+{
+    std::array<std::pair<uint32_t, uint8_t>, PALETTE_SIZE> Sorted{};
+    std::array<int32_t, PALETTE_SIZE> Red{};
+    std::array<int32_t, PALETTE_SIZE> Green{};
+    std::array<int32_t, PALETTE_SIZE> Blue{};
+    std::array<uint8_t, PALETTE_SIZE> Index{};
+    size_t NumChangeable{};
+};
+
+/**
+ * @returns true if pixel index is an index not used for remapping.
+ */
+static bool IsChangablePaletteIndex(int32_t paletteIndex)
+{
+    if (paletteIndex == PALETTE_TRANSPARENT)
+        return true;
+    if (paletteIndex == 0)
+        return false;
+    if (paletteIndex >= 203 && paletteIndex < 214)
+        return false;
+    if (paletteIndex == 226)
+        return false;
+    if (paletteIndex >= 227 && paletteIndex < 229)
+        return false;
+    if (paletteIndex >= 243)
+        return false;
+    return true;
+}
+
+static uint32_t PackColour(int32_t red, int32_t green, int32_t blue)
+{
+    return (static_cast<uint32_t>(red) << 16) | (static_cast<uint32_t>(green) << 8) | static_cast<uint32_t>(blue);
+}
+
 ImportResult ImageImporter::Import(
     const Image& image, int32_t offsetX, int32_t offsetY, IMPORT_FLAGS flags, IMPORT_MODE mode) const
 {
@@ -212,21 +254,50 @@ std::vector<uint8_t> ImageImporter::EncodeRLE(const int32_t* pixels, uint32_t wi
     return buffer;
 }
 
+static const PaletteLookup& GetPaletteLookup()
+{
+    static const PaletteLookup lookup = [] {
+        PaletteLookup result;
+        for (int32_t i = 0; i < PALETTE_SIZE; i++)
+        {
+            const auto& colour = StandardPalette[i];
+            result.Sorted[i] = { PackColour(colour.Red, colour.Green, colour.Blue), static_cast<uint8_t>(i) };
+        }
+        // Equal colours stay in index order so the lowest index is found, as a linear search would
+        std::sort(result.Sorted.begin(), result.Sorted.end());
+
+        for (int32_t i = 0; i < PALETTE_SIZE; i++)
+        {
+            if (IsChangablePaletteIndex(i))
+            {
+                const auto& colour = StandardPalette[i];
+                result.Red[result.NumChangeable] = colour.Red;
+                result.Green[result.NumChangeable] = colour.Green;
+                result.Blue[result.NumChangeable] = colour.Blue;
+                result.Index[result.NumChangeable] = static_cast<uint8_t>(i);
+                result.NumChangeable++;
+            }
+        }
+        return result;
+    }();
+    return lookup;
+}
+
 int32_t ImageImporter::CalculatePaletteIndex(
     IMPORT_MODE mode, int16_t* rgbaSrc, int32_t x, int32_t y, int32_t width, int32_t height)
 {
     auto& palette = StandardPalette;
-    auto paletteIndex = GetPaletteIndex(palette, rgbaSrc);
+    auto paletteIndex = GetPaletteIndex(rgbaSrc);
     if (mode == IMPORT_MODE::CLOSEST || mode == IMPORT_MODE::DITHERING)
     {
         if (paletteIndex == PALETTE_TRANSPARENT && !IsTransparentPixel(rgbaSrc))
         {
-            paletteIndex = GetClosestPaletteIndex(palette, rgbaSrc);
+            paletteIndex = GetClosestPaletteIndex(rgbaSrc);
         }
     }
     if (mode == IMPORT_MODE::DITHERING)
     {
-        if (!IsTransparentPixel(rgbaSrc) && IsChangablePixel(GetPaletteIndex(palette, rgbaSrc)))
+        if (!IsTransparentPixel(rgbaSrc) && IsChangablePixel(GetPaletteIndex(rgbaSrc)))
         {
             auto dr = rgbaSrc[0] - static_cast<int16_t>(palette[paletteIndex].Red);
             auto dg = rgbaSrc[1] - static_cast<int16_t>(palette[paletteIndex].Green);
@@ -234,7 +305,7 @@ int32_t ImageImporter::CalculatePaletteIndex(
 
             if (x + 1 < width)
             {
-                if (!IsTransparentPixel(rgbaSrc + 4) && IsChangablePixel(GetPaletteIndex(palette, rgbaSrc + 4)))
+                if (!IsTransparentPixel(rgbaSrc + 4) && IsChangablePixel(GetPaletteIndex(rgbaSrc + 4)))
                 {
                     // Right
                     rgbaSrc[4] += dr * 7 / 16;
@@ -248,7 +319,7 @@ int32_t ImageImporter::CalculatePaletteIndex(
                 if (x > 0)
                 {
                     if (!IsTransparentPixel(rgbaSrc + 4 * (width - 1))
-                        && IsChangablePixel(GetPaletteIndex(palette, rgbaSrc + 4 * (width - 1))))
+                        && IsChangablePixel(GetPaletteIndex(rgbaSrc + 4 * (width - 1))))
                     {
                         // Bottom left
                         rgbaSrc[4 * (width - 1)] += dr * 3 / 16;
@@ -258,7 +329,7 @@ int32_t ImageImporter::CalculatePaletteIndex(
                 }
 
                 // Bottom
-                if (!IsTransparentPixel(rgbaSrc + 4 * width) && IsChangablePixel(GetPaletteIndex(palette, rgbaSrc + 4 * width)))
+                if (!IsTransparentPixel(rgbaSrc + 4 * width) && IsChangablePixel(GetPaletteIndex(rgbaSrc + 4 * width)))
                 {
                     rgbaSrc[4 * width] += dr * 5 / 16;
                     rgbaSrc[4 * width + 1] += dg * 5 / 16;
@@ -268,7 +339,7 @@ int32_t ImageImporter::CalculatePaletteIndex(
                 if (x + 1 < width)
                 {
                     if (!IsTransparentPixel(rgbaSrc + 4 * (width + 1))
-                        && IsChangablePixel(GetPaletteIndex(palette, rgbaSrc + 4 * (width + 1))))
+                        && IsChangablePixel(GetPaletteIndex(rgbaSrc + 4 * (width + 1))))
                     {
                         // Bottom right
                         rgbaSrc[4 * (width + 1)] += dr * 1 / 16;
@@ -282,19 +353,24 @@ int32_t ImageImporter::CalculatePaletteIndex(
     return paletteIndex;
 }
 
-int32_t ImageImporter::GetPaletteIndex(const GamePalette& palette, int16_t* colour)
+int32_t ImageImporter::GetPaletteIndex(const int16_t* colour)
 {
-    if (!IsTransparentPixel(colour))
+    if (IsTransparentPixel(colour))
+        return PALETTE_TRANSPARENT;
+
+    // Dithering can push a channel out of range, no palette colour matches it then
+    for (int32_t channel = 0; channel < 3; channel++)
     {
-        for (int32_t i = 0; i < PALETTE_SIZE; i++)
-        {
-            if (static_cast<int16_t>(palette[i].Red) == colour[0] && static_cast<int16_t>(palette[i].Green) == colour[1]
-                && static_cast<int16_t>(palette[i].Blue) == colour[2])
-            {
-                return i;
-            }
-        }
+        if (colour[channel] < 0 || colour[channel] > 255)
+            return PALETTE_TRANSPARENT;
     }
+
+    const auto& sorted = GetPaletteLookup().Sorted;
+    const auto key = PackColour(colour[0], colour[1], colour[2]);
+    auto it = std::lower_bound(
+        sorted.begin(), sorted.end(), key, [](const std::pair<uint32_t, uint8_t>& a, uint32_t b) { return a.first < b; });
+    if (it != sorted.end() && it->first == key)
+        return it->second;
     return PALETTE_TRANSPARENT;
 }
 
@@ -303,45 +379,39 @@ bool ImageImporter::IsTransparentPixel(const int16_t* colour)
     return colour[3] < 128;
 }
 
-/**
- * @returns true if pixel index is an index not used for remapping.
- */
 bool ImageImporter::IsChangablePixel(int32_t paletteIndex)
 {
-    if (paletteIndex == PALETTE_TRANSPARENT)
-        return true;
-    if (paletteIndex == 0)
-        return false;
-    if (paletteIndex >= 203 && paletteIndex < 214)
-        return false;
-    if (paletteIndex == 226)
-        return false;
-    if (paletteIndex >= 227 && paletteIndex < 229)
-        return false;
-    if (paletteIndex >= 243)
-        return false;
-    return true;
+    return IsChangablePaletteIndex(paletteIndex);
 }
 
-int32_t ImageImporter::GetClosestPaletteIndex(const GamePalette& palette, const int16_t* colour)
+int32_t ImageImporter::GetClosestPaletteIndex(const int16_t* colour)
 {
+    const auto& lookup = GetPaletteLookup();
+    const int32_t red = colour[0];
+    const int32_t green = colour[1];
+    const int32_t blue = colour[2];
+
+    // Separate passes for the errors, their minimum and its first index keep each loop simple enough to vectorise
+    std::array<uint32_t, PALETTE_SIZE> errors;
+    for (size_t i = 0; i < lookup.NumChangeable; i++)
+    {
+        const auto dr = lookup.Red[i] - red;
+        const auto dg = lookup.Green[i] - green;
+        const auto db = lookup.Blue[i] - blue;
+        errors[i] = static_cast<uint32_t>(dr * dr) + static_cast<uint32_t>(dg * dg) + static_cast<uint32_t>(db * db);
+    }
+
     auto smallestError = static_cast<uint32_t>(-1);
-    auto bestMatch = PALETTE_TRANSPARENT;
-    for (int32_t x = 0; x < PALETTE_SIZE; x++)
+    for (size_t i = 0; i < lookup.NumChangeable; i++)
     {
-        if (IsChangablePixel(x))
-        {
-            uint32_t error = (static_cast<int16_t>(palette[x].Red) - colour[0])
-                    * (static_cast<int16_t>(palette[x].Red) - colour[0])
-                + (static_cast<int16_t>(palette[x].Green) - colour[1]) * (static_cast<int16_t>(palette[x].Green) - colour[1])
-                + (static_cast<int16_t>(palette[x].Blue) - colour[2]) * (static_cast<int16_t>(palette[x].Blue) - colour[2]);
+        smallestError = std::min(smallestError, errors[i]);
+    }
 
-            if (smallestError == static_cast<uint32_t>(-1) || smallestError > error)
-            {
-                bestMatch = x;
-                smallestError = error;
-            }
-        }
+    // The lowest index wins a tie
+    for (size_t i = 0; i < lookup.NumChangeable; i++)
+    {
+        if (errors[i] == smallestError)
+            return lookup.Index[i];
     }
-    return bestMatch;
+    return PALETTE_TRANSPARENT;
 }
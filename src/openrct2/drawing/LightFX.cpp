@@ -14,6 +14,7 @@
 #    include "../Game.h"
 #    include "../common.h"
 #    include "../config/Config.h"
+#    include "../core/JobPool.h"
 #    include "../interface/Viewport.h"
 #    include "../interface/Window.h"
 #    include "../interface/Window_internal.h"
@@ -28,6 +29,8 @@
 #    include <algorithm>
 #    include <cmath>
 #    include <cstring>
+#    include <memory>
+#    include <vector>
 
 static uint8_t _bakedLightTexture_lantern_0[32 * 32];
 static uint8_t _bakedLightTexture_lantern_1[64 * 64];
@@ -86,6 +89,24 @@ static ZoomLevel _current_view_zoom_back_delay = 0;
 
 static GamePalette gPalette_light;
 
+// The light buffer and the final image are processed in bands of rows, which are spread over workers when
+// multithreading is enabled. Each band only draws the lights that overlap it.
+static constexpr int32_t LIGHT_BAND_HEIGHT = 64;
+static std::unique_ptr<JobPool> _lightJobs;
+
+struct LightDraw
+{
+    // The top left texel of the part of the light texture that is on screen
+    const uint8_t* Source;
+    uint32_t SourceWidth;
+    int32_t X;
+    int32_t Y;
+    int32_t Width;
+    int32_t Height;
+    uint16_t Multiplier;
+};
+static std::vector<LightDraw> _lightDraws;
+
 static uint8_t calc_light_intensity_lantern(int32_t x, int32_t y)
 {
     double distance = static_cast<double>(x * x + y * y);
@@ -449,6 +470,55 @@ void lightfx_update_viewport_settings()
     }
 }
 
+template<typename TFn> static void lightfx_for_each_band(int32_t height, TFn&& fn)
+{
+    const auto numBands = static_cast<size_t>((height + LIGHT_BAND_HEIGHT - 1) / LIGHT_BAND_HEIGHT);
+    auto processBand = [height, &fn](size_t band) {
+        const auto top = static_cast<int32_t>(band) * LIGHT_BAND_HEIGHT;
+        fn(top, std::min(top + LIGHT_BAND_HEIGHT, height));
+    };
+
+    if (!gConfigGeneral.multithreading)
+    {
+        _lightJobs.reset();
+    }
+    else if (_lightJobs == nullptr)
+    {
+        _lightJobs = std::make_unique<JobPool>();
+    }
+
+    if (_lightJobs != nullptr && numBands > 1)
+    {
+        _lightJobs->ParallelFor(0, numBands, 1, processBand);
+    }
+    else
+    {
+        for (size_t band = 0; band < numBands; band++)
+        {
+            processBand(band);
+        }
+    }
+}
+
+static void lightfx_render_band(int32_t top, int32_t bottom)
+{
+    const auto width = _pixelInfo.width;
+    uint8_t* buffer = static_cast<uint8_t*>(_light_rendered_buffer_front);
+    std::memset(buffer + static_cast<size_t>(top) * width, 0, static_cast<size_t>(bottom - top) * width);
+
+    for (const auto& draw : _lightDraws)
+    {
+        const auto drawTop = std::max(top, draw.Y);
+        const auto drawBottom = std::min(bottom, draw.Y + draw.Height);
+        for (int32_t y = drawTop; y < drawBottom; y++)
+        {
+            light_add_fn(
+                draw.Source + (y - draw.Y) * draw.SourceWidth, buffer + static_cast<size_t>(y) * width + draw.X, draw.Width,
+                draw.Multiplier);
+        }
+    }
+}
+
 void lightfx_render_lights_to_frontbuffer()
 {
     if (_light_rendered_buffer_front == nullptr)
@@ -456,20 +526,15 @@ void lightfx_render_lights_to_frontbuffer()
         return;
     }
 
-    std::memset(_light_rendered_buffer_front, 0, _pixelInfo.width * _pixelInfo.height);
-
     _lightPolution_back = 0;
+    _lightDraws.clear();
 
     //  log_warning("%i lights", LightListCurrentCountFront);
 
     for (uint32_t light = 0; light < LightListCurrentCountFront; light++)
     {
         const uint8_t* bufReadBase = nullptr;
-        uint8_t* bufWriteBase = static_cast<uint8_t*>(_light_rendered_buffer_front);
         uint32_t bufReadWidth, bufReadHeight;
-        int32_t bufWriteX, bufWriteY;
-        int32_t bufWriteWidth, bufWriteHeight;
-        uint32_t bufReadSkip, bufWriteSkip;
 
         lightlist_entry* entry = &_LightListFront[light];
 
@@ -530,91 +595,31 @@ void lightfx_render_lights_to_frontbuffer()
                 continue;
         }
 
-        bufWriteX = inRectCentreX - bufReadWidth / 2;
-        bufWriteY = inRectCentreY - bufReadHeight / 2;
-
-        bufWriteWidth = bufReadWidth;
-        bufWriteHeight = bufReadHeight;
-
-        if (bufWriteX < 0)
-        {
-            bufReadBase += -bufWriteX;
-            bufWriteWidth += bufWriteX;
-        }
-        else
-        {
-            bufWriteBase += bufWriteX;
-        }
-
-        if (bufWriteWidth <= 0)
+        // Clip the light to the screen, lights that are not on it at all are skipped
+        const int32_t left = std::max(inRectCentreX - static_cast<int32_t>(bufReadWidth / 2), 0);
+        const int32_t top = std::max(inRectCentreY - static_cast<int32_t>(bufReadHeight / 2), 0);
+        const int32_t right = std::min<int32_t>(inRectCentreX + bufReadWidth / 2, _pixelInfo.width);
+        const int32_t bottom = std::min<int32_t>(inRectCentreY + bufReadHeight / 2, _pixelInfo.height);
+        if (left >= right || top >= bottom)
             continue;
 
-        if (bufWriteY < 0)
-        {
-            bufReadBase += -bufWriteY * bufReadWidth;
-            bufWriteHeight += bufWriteY;
-        }
-        else
-        {
-            bufWriteBase += bufWriteY * _pixelInfo.width;
-        }
+        const int32_t readX = left - (inRectCentreX - static_cast<int32_t>(bufReadWidth / 2));
+        const int32_t readY = top - (inRectCentreY - static_cast<int32_t>(bufReadHeight / 2));
 
-        if (bufWriteHeight <= 0)
-            continue;
-
-        int32_t rightEdge = bufWriteX + bufWriteWidth;
-        int32_t bottomEdge = bufWriteY + bufWriteHeight;
-
-        if (rightEdge > _pixelInfo.width)
-        {
-            bufWriteWidth -= rightEdge - _pixelInfo.width;
-        }
-        if (bottomEdge > _pixelInfo.height)
-        {
-            bufWriteHeight -= bottomEdge - _pixelInfo.height;
-        }
-
-        if (bufWriteWidth <= 0)
-            continue;
-        if (bufWriteHeight <= 0)
-            continue;
+        _lightPolution_back += ((right - left) * (bottom - top)) / 256;
 
-        _lightPolution_back += (bufWriteWidth * bufWriteHeight) / 256;
-
-        bufReadSkip = bufReadWidth - bufWriteWidth;
-        bufWriteSkip = _pixelInfo.width - bufWriteWidth;
-
-        if (entry->lightIntensity == 0xFF)
-        {
-            for (int32_t y = 0; y < bufWriteHeight; y++)
-            {
-                for (int32_t x = 0; x < bufWriteWidth; x++)
-                {
-                    *bufWriteBase = std::min(0xFF, *bufWriteBase + *bufReadBase);
-                    bufWriteBase++;
-                    bufReadBase++;
-                }
-
-                bufWriteBase += bufWriteSkip;
-                bufReadBase += bufReadSkip;
-            }
-        }
-        else
-        {
-            for (int32_t y = 0; y < bufWriteHeight; y++)
-            {
-                for (int32_t x = 0; x < bufWriteWidth; x++)
-                {
-                    *bufWriteBase = std::min(0xFF, *bufWriteBase + (((*bufReadBase) * (1 + entry->lightIntensity)) >> 8));
-                    bufWriteBase++;
-                    bufReadBase++;
-                }
-
-                bufWriteBase += bufWriteSkip;
-                bufReadBase += bufReadSkip;
-            }
-        }
+        LightDraw draw;
+        draw.Source = bufReadBase + readY * bufReadWidth + readX;
+        draw.SourceWidth = bufReadWidth;
+        draw.X = left;
+        draw.Y = top;
+        draw.Width = right - left;
+        draw.Height = bottom - top;
+        draw.Multiplier = 1 + entry->lightIntensity;
+        _lightDraws.push_back(draw);
     }
+
+    lightfx_for_each_band(_pixelInfo.height, lightfx_render_band);
 }
 
 void* lightfx_get_front_buffer()
@@ -997,32 +1002,34 @@ void lightfx_render_to_texture(
         return;
     }
 
-    for (uint32_t y = 0; y < height; y++)
-    {
-        uintptr_t dstOffset = static_cast<uintptr_t>(y * dstPitch);
-        uint32_t* dst = reinterpret_cast<uint32_t*>(reinterpret_cast<uintptr_t>(dstPixels) + dstOffset);
-        for (uint32_t x = 0; x < width; x++)
+    lightfx_for_each_band(height, [=](int32_t top, int32_t bottom) {
+        for (uint32_t y = top; y < static_cast<uint32_t>(bottom); y++)
         {
-            uint8_t* src = &bits[y * width + x];
-            uint32_t darkColour = palette[*src];
-            uint32_t lightColour = lightPalette[*src];
-            uint8_t lightIntensity = lightBits[y * width + x];
-
-            uint32_t colour = 0;
-            if (lightIntensity == 0)
+            uintptr_t dstOffset = static_cast<uintptr_t>(y * dstPitch);
+            uint32_t* dst = reinterpret_cast<uint32_t*>(reinterpret_cast<uintptr_t>(dstPixels) + dstOffset);
+            for (uint32_t x = 0; x < width; x++)
             {
-                colour = darkColour;
-            }
-            else
-            {
-                colour |= mix_light((darkColour >> 0) & 0xFF, (lightColour >> 0) & 0xFF, lightIntensity);
-                colour |= mix_light((darkColour >> 8) & 0xFF, (lightColour >> 8) & 0xFF, lightIntensity) << 8;
-                colour |= mix_light((darkColour >> 16) & 0xFF, (lightColour >> 16) & 0xFF, lightIntensity) << 16;
-                colour |= mix_light((darkColour >> 24) & 0xFF, (lightColour >> 24) & 0xFF, lightIntensity) << 24;
+                uint8_t* src = &bits[y * width + x];
+                uint32_t darkColour = palette[*src];
+                uint32_t lightColour = lightPalette[*src];
+                uint8_t lightIntensity = lightBits[y * width + x];
+
+                uint32_t colour = 0;
+                if (lightIntensity == 0)
+                {
+                    colour = darkColour;
+                }
+                else
+                {
+                    colour |= mix_light((darkColour >> 0) & 0xFF, (lightColour >> 0) & 0xFF, lightIntensity);
+                    colour |= mix_light((darkColour >> 8) & 0xFF, (lightColour >> 8) & 0xFF, lightIntensity) << 8;
+                    colour |= mix_light((darkColour >> 16) & 0xFF, (lightColour >> 16) & 0xFF, lightIntensity) << 16;
+                    colour |= mix_light((darkColour >> 24) & 0xFF, (lightColour >> 24) & 0xFF, lightIntensity) << 24;
+                }
+                *dst++ = colour;
             }
-            *dst++ = colour;
         }
-    }
+    });
 }
 
 #endif // __ENABLE_LIGHTFX__
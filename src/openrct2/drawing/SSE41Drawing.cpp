@@ -56,6 +56,91 @@ void mask_sse4_1(
     }
 }
 
+static void rle_minify_blend_sse4_1(uint8_t* dst, __m128i colour)
+{
+    const __m128i dest = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst));
+    const __m128i transparent = _mm_cmpeq_epi8(colour, _mm_setzero_si128());
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm_blendv_epi8(colour, dest, transparent));
+}
+
+static __m128i rle_minify_load_sse4_1(const uint8_t* src, __m128i mask)
+{
+    return _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src)), mask);
+}
+
+void rle_minify_copy_sse4_1(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t numPixels, int32_t zoomLevel)
+{
+    // Every block takes every zoom-th pixel of 16 << zoomLevel source pixels, keeping the low byte of each 2, 4 or 8
+    // byte element and packing them down to 16 destination pixels.
+    const int32_t blockPixels = 16 << zoomLevel;
+    switch (zoomLevel)
+    {
+        case 1:
+        {
+            const __m128i mask = _mm_set1_epi16(0xFF);
+            for (; numPixels >= blockPixels; numPixels -= blockPixels, src += blockPixels, dst += 16)
+            {
+                const __m128i a = rle_minify_load_sse4_1(src, mask);
+                const __m128i b = rle_minify_load_sse4_1(src + 16, mask);
+                rle_minify_blend_sse4_1(dst, _mm_packus_epi16(a, b));
+            }
+            break;
+        }
+        case 2:
+        {
+            const __m128i mask = _mm_set1_epi32(0xFF);
+            for (; numPixels >= blockPixels; numPixels -= blockPixels, src += blockPixels, dst += 16)
+            {
+                const __m128i a = _mm_packus_epi32(rle_minify_load_sse4_1(src, mask), rle_minify_load_sse4_1(src + 16, mask));
+                const __m128i b = _mm_packus_epi32(
+                    rle_minify_load_sse4_1(src + 32, mask), rle_minify_load_sse4_1(src + 48, mask));
+                rle_minify_blend_sse4_1(dst, _mm_packus_epi16(a, b));
+            }
+            break;
+        }
+        case 3:
+        {
+            const __m128i mask = _mm_set1_epi64x(0xFF);
+            for (; numPixels >= blockPixels; numPixels -= blockPixels, src += blockPixels, dst += 16)
+            {
+                __m128i words[2];
+                for (int32_t i = 0; i < 2; i++)
+                {
+                    const uint8_t* half = src + i * 64;
+                    const __m128i a = _mm_packus_epi32(
+                        rle_minify_load_sse4_1(half, mask), rle_minify_load_sse4_1(half + 16, mask));
+                    const __m128i b = _mm_packus_epi32(
+                        rle_minify_load_sse4_1(half + 32, mask), rle_minify_load_sse4_1(half + 48, mask));
+                    words[i] = _mm_packus_epi32(a, b);
+                }
+                rle_minify_blend_sse4_1(dst, _mm_packus_epi16(words[0], words[1]));
+            }
+            break;
+        }
+    }
+    rle_minify_copy_scalar(src, dst, numPixels, zoomLevel);
+}
+
+void light_add_sse4_1(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t numPixels, uint16_t multiplier)
+{
+    // Intensities are widened to 16 bits to be scaled, then packed back and added with unsigned saturation
+    const __m128i scale = _mm_set1_epi16(static_cast<int16_t>(multiplier));
+    const __m128i zero = _mm_setzero_si128();
+    for (; numPixels >= 16; numPixels -= 16, src += 16, dst += 16)
+    {
+        __m128i light = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+        if (multiplier != 256)
+        {
+            const __m128i low = _mm_srli_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(light, zero), scale), 8);
+            const __m128i high = _mm_srli_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(light, zero), scale), 8);
+            light = _mm_packus_epi16(low, high);
+        }
+        const __m128i dest = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm_adds_epu8(dest, light));
+    }
+    light_add_scalar(src, dst, numPixels, multiplier);
+}
+
 #else
 
 #    ifdef OPENRCT2_X86
@@ -69,4 +154,14 @@ void mask_sse4_1(
     openrct2_assert(false, "SSE 4.1 function called on a CPU that doesn't support SSE 4.1");
 }
 
+void rle_minify_copy_sse4_1(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t numPixels, int32_t zoomLevel)
+{
+    openrct2_assert(false, "SSE 4.1 function called on a CPU that doesn't support SSE 4.1");
+}
+
+void light_add_sse4_1(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t numPixels, uint16_t multiplier)
+{
+    openrct2_assert(false, "SSE 4.1 function called on a CPU that doesn't support SSE 4.1");
+}
+
 #endif // __SSE4_1__
@@ -22,6 +22,8 @@
 
 #include <algorithm>
 #include <mutex>
+#include <string>
+#include <unordered_map>
 
 using namespace OpenRCT2;
 
@@ -30,15 +32,25 @@ struct rct_draw_scroll_text
     rct_string_id string_id;
     uint8_t string_args[32];
     colour_t colour;
+    bool upper_case;
     uint16_t position;
     uint16_t mode;
-    uint32_t id;
+    // Least recently used list, most recently used first
+    int32_t prev;
+    int32_t next;
+    std::string text;
     uint8_t bitmap[64 * 40];
 };
 
 static rct_draw_scroll_text _drawScrollTextList[OpenRCT2::MaxScrollingTextEntries];
 static uint8_t _characterBitmaps[FONT_SPRITE_GLYPH_COUNT + SPR_G2_GLYPH_COUNT][8];
-static uint32_t _drawSCrollNextIndex = 0;
+static int32_t _drawScrollTextHead = -1;
+static int32_t _drawScrollTextTail = -1;
+// Scrolling text bitmaps by the hash of their string, arguments, colour and position
+static std::unordered_map<size_t, int32_t> _drawScrollTextBitmaps;
+// The most recent scrolling text of a string by the hash of the string and its arguments, so moving text only has to be
+// formatted once
+static std::unordered_map<size_t, int32_t> _drawScrollTextStrings;
 static std::mutex _scrollingTextMutex;
 
 static void scrolling_text_set_bitmap_for_sprite(
@@ -134,35 +146,90 @@ static uint8_t* font_sprite_get_codepoint_bitmap(int32_t codepoint)
     }
 }
 
-static int32_t scrolling_text_get_matching_or_oldest(
-    rct_string_id stringId, Formatter& ft, uint16_t scroll, uint16_t scrollingMode, colour_t colour)
+static size_t scrolling_text_get_string_hash(rct_string_id stringId, const uint8_t* args, bool upperCase)
 {
-    uint32_t oldestId = 0xFFFFFFFF;
-    int32_t scrollIndex = -1;
-    for (size_t i = 0; i < std::size(_drawScrollTextList); i++)
+    auto hash = std::hash<std::string_view>()(
+        std::string_view(reinterpret_cast<const char*>(args), sizeof(rct_draw_scroll_text::string_args)));
+    hash ^= (static_cast<size_t>(stringId) << 1 | (upperCase ? 1 : 0)) + 0x9E3779B9 + (hash << 6) + (hash >> 2);
+    return hash;
+}
+
+static size_t scrolling_text_get_bitmap_hash(size_t stringHash, colour_t colour, uint16_t scroll, uint16_t scrollingMode)
+{
+    auto value = (static_cast<size_t>(scroll) << 16) | (static_cast<size_t>(scrollingMode) << 8) | colour;
+    return stringHash ^ (value + 0x9E3779B9 + (stringHash << 6) + (stringHash >> 2));
+}
+
+static bool scrolling_text_has_string(
+    const rct_draw_scroll_text& scrollText, rct_string_id stringId, const uint8_t* args, bool upperCase)
+{
+    return scrollText.string_id == stringId && scrollText.upper_case == upperCase
+        && std::memcmp(scrollText.string_args, args, sizeof(scrollText.string_args)) == 0;
+}
+
+static void scrolling_text_lru_unlink(int32_t index)
+{
+    auto& scrollText = _drawScrollTextList[index];
+    if (scrollText.prev != -1)
+        _drawScrollTextList[scrollText.prev].next = scrollText.next;
+    else
+        _drawScrollTextHead = scrollText.next;
+    if (scrollText.next != -1)
+        _drawScrollTextList[scrollText.next].prev = scrollText.prev;
+    else
+        _drawScrollTextTail = scrollText.prev;
+}
+
+static void scrolling_text_lru_push_front(int32_t index)
+{
+    auto& scrollText = _drawScrollTextList[index];
+    scrollText.prev = -1;
+    scrollText.next = _drawScrollTextHead;
+    if (_drawScrollTextHead != -1)
+        _drawScrollTextList[_drawScrollTextHead].prev = index;
+    _drawScrollTextHead = index;
+    if (_drawScrollTextTail == -1)
+        _drawScrollTextTail = index;
+}
+
+static void scrolling_text_lru_reset()
+{
+    _drawScrollTextHead = -1;
+    _drawScrollTextTail = -1;
+    for (int32_t i = 0; i < OpenRCT2::MaxScrollingTextEntries; i++)
+    {
+        scrolling_text_lru_push_front(i);
+    }
+}
+
+/**
+ * Removes the least recently used scrolling text from the lookups and returns its index.
+ */
+static int32_t scrolling_text_evict_oldest()
+{
+    auto index = _drawScrollTextTail;
+    auto& scrollText = _drawScrollTextList[index];
+    if (scrollText.string_id != 0)
     {
-        rct_draw_scroll_text* scrollText = &_drawScrollTextList[i];
-        if (oldestId >= scrollText->id)
+        auto stringHash = scrolling_text_get_string_hash(scrollText.string_id, scrollText.string_args, scrollText.upper_case);
+        auto bitmapIt = _drawScrollTextBitmaps.find(
+            scrolling_text_get_bitmap_hash(stringHash, scrollText.colour, scrollText.position, scrollText.mode));
+        if (bitmapIt != _drawScrollTextBitmaps.end() && bitmapIt->second == index)
         {
-            oldestId = scrollText->id;
-            scrollIndex = static_cast<int32_t>(i);
+            _drawScrollTextBitmaps.erase(bitmapIt);
         }
-
-        // If exact match return the matching index
-        if (scrollText->string_id == stringId
-            && std::memcmp(scrollText->string_args, ft.Buf(), sizeof(scrollText->string_args)) == 0
-            && scrollText->colour == colour && scrollText->position == scroll && scrollText->mode == scrollingMode)
+        auto stringIt = _drawScrollTextStrings.find(stringHash);
+        if (stringIt != _drawScrollTextStrings.end() && stringIt->second == index)
         {
-            scrollText->id = _drawSCrollNextIndex;
-            return static_cast<int32_t>(i + SPR_SCROLLING_TEXT_START);
+            _drawScrollTextStrings.erase(stringIt);
         }
     }
-    return scrollIndex;
+    return index;
 }
 
 static void scrolling_text_format(utf8* dst, size_t size, rct_draw_scroll_text* scrollText)
 {
-    if (gConfigGeneral.upper_case_banners)
+    if (scrollText->upper_case)
     {
         format_string_to_upper(dst, size, scrollText->string_id, scrollText->string_args);
     }
@@ -1440,11 +1507,17 @@ static constexpr const int16_t* _scrollPositions[MAX_SCROLLING_TEXT_MODES] = {
 
 void scrolling_text_invalidate()
 {
+    std::scoped_lock<std::mutex> lock(_scrollingTextMutex);
+
     for (auto& scrollText : _drawScrollTextList)
     {
         scrollText.string_id = 0;
         std::memset(scrollText.string_args, 0, sizeof(scrollText.string_args));
+        scrollText.text.clear();
     }
+    _drawScrollTextBitmaps.clear();
+    _drawScrollTextStrings.clear();
+    scrolling_text_lru_reset();
 }
 
 int32_t scrolling_text_setup(
@@ -1459,35 +1532,83 @@ int32_t scrolling_text_setup(
     if (dpi->zoom_level > 0)
         return SPR_SCROLLING_TEXT_DEFAULT;
 
-    _drawSCrollNextIndex++;
+    if (_drawScrollTextHead == -1)
+    {
+        scrolling_text_lru_reset();
+    }
+
     ft.Rewind();
-    int32_t scrollIndex = scrolling_text_get_matching_or_oldest(stringId, ft, scroll, scrollingMode, colour);
-    if (scrollIndex >= SPR_SCROLLING_TEXT_START)
-        return scrollIndex;
+    const auto* args = ft.Buf();
+    const bool upperCase = gConfigGeneral.upper_case_banners;
+    const auto stringHash = scrolling_text_get_string_hash(stringId, args, upperCase);
+    const auto bitmapHash = scrolling_text_get_bitmap_hash(stringHash, colour, scroll, scrollingMode);
+
+    // If exact match return the matching image
+    auto bitmapIt = _drawScrollTextBitmaps.find(bitmapHash);
+    if (bitmapIt != _drawScrollTextBitmaps.end())
+    {
+        auto& scrollText = _drawScrollTextList[bitmapIt->second];
+        if (scrolling_text_has_string(scrollText, stringId, args, upperCase) && scrollText.colour == colour
+            && scrollText.position == scroll && scrollText.mode == scrollingMode)
+        {
+            scrolling_text_lru_unlink(bitmapIt->second);
+            scrolling_text_lru_push_front(bitmapIt->second);
+            return SPR_SCROLLING_TEXT_START + bitmapIt->second;
+        }
+    }
+
+    // Moving text keeps its string, reuse the formatted text of its previous position
+    thread_local std::string scrollString;
+    scrollString.clear();
+    bool isFormatted = false;
+    auto stringIt = _drawScrollTextStrings.find(stringHash);
+    if (stringIt != _drawScrollTextStrings.end())
+    {
+        const auto& previous = _drawScrollTextList[stringIt->second];
+        if (scrolling_text_has_string(previous, stringId, args, upperCase))
+        {
+            scrollString = previous.text;
+            isFormatted = true;
+        }
+    }
 
     // Setup scrolling text
+    auto scrollIndex = scrolling_text_evict_oldest();
+    scrolling_text_lru_unlink(scrollIndex);
+    scrolling_text_lru_push_front(scrollIndex);
+
     auto scrollText = &_drawScrollTextList[scrollIndex];
     scrollText->string_id = stringId;
-    std::memcpy(scrollText->string_args, ft.Buf(), sizeof(scrollText->string_args));
+    std::memcpy(scrollText->string_args, args, sizeof(scrollText->string_args));
     scrollText->colour = colour;
+    scrollText->upper_case = upperCase;
     scrollText->position = scroll;
     scrollText->mode = scrollingMode;
-    scrollText->id = _drawSCrollNextIndex;
+    _drawScrollTextBitmaps[bitmapHash] = scrollIndex;
+    _drawScrollTextStrings[stringHash] = scrollIndex;
 
     // Create the string to draw
-    utf8 scrollString[256];
-    scrolling_text_format(scrollString, 256, scrollText);
+    if (isFormatted)
+    {
+        scrollText->text = scrollString;
+    }
+    else
+    {
+        utf8 buffer[256];
+        scrolling_text_format(buffer, sizeof(buffer), scrollText);
+        scrollText->text = buffer;
+    }
 
     const int16_t* scrollingModePositions = _scrollPositions[scrollingMode];
 
     std::fill_n(scrollText->bitmap, 320 * 8, 0x00);
     if (LocalisationService_UseTrueTypeFont())
     {
-        scrolling_text_set_bitmap_for_ttf(scrollString, scroll, scrollText->bitmap, scrollingModePositions, colour);
+        scrolling_text_set_bitmap_for_ttf(scrollText->text, scroll, scrollText->bitmap, scrollingModePositions, colour);
     }
     else
     {
-        scrolling_text_set_bitmap_for_sprite(scrollString, scroll, scrollText->bitmap, scrollingModePositions, colour);
+        scrolling_text_set_bitmap_for_sprite(scrollText->text, scroll, scrollText->bitmap, scrollingModePositions, colour);
     }
 
     uint32_t imageId = SPR_SCROLLING_TEXT_START + scrollIndex;
@@ -1587,7 +1708,7 @@ static void scrolling_text_set_bitmap_for_ttf(
         }
     }
 
-    auto surface = ttf_surface_cache_get_or_add(fontDesc->font, ttfBuffer.c_str());
+    auto surface = ttf_render_string(fontDesc->font, ttfBuffer);
     if (surface == nullptr)
     {
         return;
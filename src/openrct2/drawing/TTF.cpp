@@ -9,8 +9,12 @@
 
 #ifndef NO_TTF
 
+#    include <algorithm>
 #    include <atomic>
+#    include <memory>
 #    include <mutex>
+#    include <optional>
+#    include <vector>
 #    pragma clang diagnostic push
 #    pragma clang diagnostic ignored "-Wdocumentation"
 #    include <ft2build.h>
@@ -23,49 +27,143 @@
 #    include "../localisation/Localisation.h"
 #    include "../localisation/LocalisationService.h"
 #    include "../platform/platform.h"
+#    include "Drawing.h"
 #    include "TTF.h"
 
 static bool _ttfInitialised = false;
 
-#    define TTF_SURFACE_CACHE_SIZE 256
-#    define TTF_GETWIDTH_CACHE_SIZE 1024
+static constexpr codepoint_t UNICODE_BOM_NATIVE = 0xFEFF;
+static constexpr codepoint_t UNICODE_BOM_SWAPPED = 0xFFFE;
 
-struct ttf_cache_entry
+/**
+ * An insert only hash table that can be read without locking while entries are added under _mutex. Entries never move
+ * once added, growing publishes a new slot array and keeps the old ones for readers that may still be probing them.
+ * Clear must not be called while the table can be read.
+ */
+template<typename TKey, typename TValue> class TTFConcurrentTable
 {
-    TTFSurface* surface;
-    TTF_Font* font;
-    utf8* text;
-    uint32_t lastUseTick;
+private:
+    struct Entry
+    {
+        TKey Key;
+        TValue Value;
+    };
+
+    struct Slots
+    {
+        size_t Mask;
+        std::unique_ptr<std::atomic<const Entry*>[]> Data;
+    };
+
+    static constexpr size_t InitialSlots = 256;
+
+    std::atomic<const Slots*> _slots{};
+    std::vector<std::unique_ptr<Slots>> _allSlots;
+    std::vector<std::unique_ptr<Entry>> _entries;
+
+    static size_t Hash(TKey key)
+    {
+        return static_cast<size_t>((static_cast<uint64_t>(key) * 0x9E3779B97F4A7C15ULL) >> 32);
+    }
+
+    static void Insert(const Slots& slots, const Entry* entry)
+    {
+        auto i = Hash(entry->Key) & slots.Mask;
+        while (slots.Data[i].load(std::memory_order_relaxed) != nullptr)
+        {
+            i = (i + 1) & slots.Mask;
+        }
+        slots.Data[i].store(entry, std::memory_order_release);
+    }
+
+    const Slots* Grow(const Slots* slots)
+    {
+        auto newSlots = std::make_unique<Slots>();
+        const auto size = slots == nullptr ? InitialSlots : (slots->Mask + 1) * 2;
+        newSlots->Mask = size - 1;
+        newSlots->Data = std::make_unique<std::atomic<const Entry*>[]>(size);
+        for (const auto& entry : _entries)
+        {
+            Insert(*newSlots, entry.get());
+        }
+        _slots.store(newSlots.get(), std::memory_order_release);
+        _allSlots.push_back(std::move(newSlots));
+        return _allSlots.back().get();
+    }
+
+public:
+    const TValue* Find(TKey key) const
+    {
+        const auto* slots = _slots.load(std::memory_order_acquire);
+        if (slots == nullptr)
+            return nullptr;
+
+        // The table is kept at most half full, so there is always an empty slot to stop at
+        for (auto i = Hash(key) & slots->Mask;; i = (i + 1) & slots->Mask)
+        {
+            const auto* entry = slots->Data[i].load(std::memory_order_acquire);
+            if (entry == nullptr)
+                return nullptr;
+            if (entry->Key == key)
+                return &entry->Value;
+        }
+    }
+
+    const TValue& Add(TKey key, TValue&& value)
+    {
+        const auto* slots = _slots.load(std::memory_order_relaxed);
+        if (slots == nullptr || (_entries.size() + 1) * 2 > slots->Mask + 1)
+        {
+            slots = Grow(slots);
+        }
+        _entries.push_back(std::make_unique<Entry>(Entry{ key, std::move(value) }));
+        Insert(*slots, _entries.back().get());
+        return _entries.back()->Value;
+    }
+
+    void Clear()
+    {
+        _slots.store(nullptr, std::memory_order_release);
+        _allSlots.clear();
+        _entries.clear();
+    }
+
+    /**
+     * Returns the bytes used by the table, valueSize gives the bytes a value holds outside of itself. Entries are only
+     * added under _mutex, so this must be called under it as well.
+     */
+    template<typename TFn> size_t GetMemoryUsage(TFn&& valueSize) const
+    {
+        size_t size = _entries.capacity() * sizeof(std::unique_ptr<Entry>);
+        for (const auto& slots : _allSlots)
+        {
+            size += sizeof(Slots) + (slots->Mask + 1) * sizeof(std::atomic<const Entry*>);
+        }
+        for (const auto& entry : _entries)
+        {
+            size += sizeof(Entry) + valueSize(entry->Value);
+        }
+        return size;
+    }
 };
 
-struct ttf_getwidth_cache_entry
+// The glyphs and kerning of a font, strings are composed from these rather than cached as a whole
+struct TTFFontCache
 {
-    uint32_t width;
-    TTF_Font* font;
-    utf8* text;
-    uint32_t lastUseTick;
+    TTF_Font* Font = nullptr;
+    // Glyphs that can not be loaded are stored as nullopt so they are not attempted again
+    TTFConcurrentTable<codepoint_t, std::optional<TTFGlyph>> Glyphs;
+    TTFConcurrentTable<uint64_t, int32_t> Kerning;
 };
 
-static ttf_cache_entry _ttfSurfaceCache[TTF_SURFACE_CACHE_SIZE] = {};
-static int32_t _ttfSurfaceCacheCount = 0;
-static int32_t _ttfSurfaceCacheHitCount = 0;
-static int32_t _ttfSurfaceCacheMissCount = 0;
-
-static ttf_getwidth_cache_entry _ttfGetWidthCache[TTF_GETWIDTH_CACHE_SIZE] = {};
-static int32_t _ttfGetWidthCacheCount = 0;
-static int32_t _ttfGetWidthCacheHitCount = 0;
-static int32_t _ttfGetWidthCacheMissCount = 0;
+static TTFFontCache _fontCaches[FONT_SIZE_COUNT];
 
 static std::mutex _mutex;
 
 static TTF_Font* ttf_open_font(const utf8* fontPath, int32_t ptSize);
 static void ttf_close_font(TTF_Font* font);
-static void ttf_surface_cache_dispose(ttf_cache_entry* entry);
-static void ttf_surface_cache_dispose_all();
-static void ttf_getwidth_cache_dispose_all();
-static bool ttf_get_size(TTF_Font* font, std::string_view text, int32_t* outWidth, int32_t* outHeight);
+static void ttf_font_caches_clear();
 static void ttf_toggle_hinting(bool);
-static TTFSurface* ttf_render(TTF_Font* font, std::string_view text);
 
 template<typename T> class FontLockHelper
 {
@@ -101,10 +199,8 @@ static void ttf_toggle_hinting(bool)
         TTF_SetFontHinting(fontDesc->font, use_hinting ? 1 : 0);
     }
 
-    if (_ttfSurfaceCacheCount)
-    {
-        ttf_surface_cache_dispose_all();
-    }
+    // The glyphs are rendered differently with hinting
+    ttf_font_caches_clear();
 }
 
 bool ttf_initialise()
@@ -137,6 +233,7 @@ bool ttf_initialise()
             log_verbose("Unable to load '%s'", fontPath);
             return false;
         }
+        _fontCaches[i].Font = fontDesc->font;
     }
 
     ttf_toggle_hinting(true);
@@ -153,8 +250,7 @@ void ttf_dispose()
     if (!_ttfInitialised)
         return;
 
-    ttf_surface_cache_dispose_all();
-    ttf_getwidth_cache_dispose_all();
+    ttf_font_caches_clear();
 
     for (int32_t i = 0; i < FONT_SIZE_COUNT; i++)
     {
@@ -163,6 +259,7 @@ void ttf_dispose()
         {
             ttf_close_font(fontDesc->font);
             fontDesc->font = nullptr;
+            _fontCaches[i].Font = nullptr;
         }
     }
 
@@ -181,36 +278,28 @@ static void ttf_close_font(TTF_Font* font)
     TTF_CloseFont(font);
 }
 
-static uint32_t ttf_surface_cache_hash(TTF_Font* font, std::string_view text)
+static void ttf_font_caches_clear()
 {
-    uint32_t hash = static_cast<uint32_t>(((reinterpret_cast<uintptr_t>(font) * 23) ^ 0xAAAAAAAA) & 0xFFFFFFFF);
-    for (auto c : text)
+    for (auto& cache : _fontCaches)
     {
-        hash = ror32(hash, 3) ^ (c * 13);
+        cache.Glyphs.Clear();
+        cache.Kerning.Clear();
     }
-    return hash;
+    gfx_clear_text_layout_cache();
 }
 
-static void ttf_surface_cache_dispose(ttf_cache_entry* entry)
+size_t ttf_get_cache_memory_usage()
 {
-    if (entry->surface != nullptr)
-    {
-        ttf_free_surface(entry->surface);
-        free(entry->text);
-
-        entry->surface = nullptr;
-        entry->font = nullptr;
-        entry->text = nullptr;
-    }
-}
+    FontLockHelper<std::mutex> lock(_mutex);
 
-static void ttf_surface_cache_dispose_all()
-{
-    for (int32_t i = 0; i < TTF_SURFACE_CACHE_SIZE; i++)
+    size_t size = 0;
+    for (const auto& cache : _fontCaches)
     {
-        ttf_surface_cache_dispose(&_ttfSurfaceCache[i]);
-        _ttfSurfaceCacheCount--;
+        size += cache.Glyphs.GetMemoryUsage(
+            [](const std::optional<TTFGlyph>& glyph) { return glyph.has_value() ? glyph->Pixels.capacity() : 0; });
+        size += cache.Kerning.GetMemoryUsage([](int32_t) { return 0; });
     }
+    return size;
 }
 
 void ttf_toggle_hinting()
@@ -219,136 +308,154 @@ void ttf_toggle_hinting()
     ttf_toggle_hinting(true);
 }
 
-TTFSurface* ttf_surface_cache_get_or_add(TTF_Font* font, std::string_view text)
+static TTFFontCache* ttf_get_font_cache(TTF_Font* font)
 {
-    ttf_cache_entry* entry;
-
-    uint32_t hash = ttf_surface_cache_hash(font, text);
-    int32_t index = hash % TTF_SURFACE_CACHE_SIZE;
-
-    FontLockHelper<std::mutex> lock(_mutex);
-
-    for (int32_t i = 0; i < TTF_SURFACE_CACHE_SIZE; i++)
+    for (auto& cache : _fontCaches)
     {
-        entry = &_ttfSurfaceCache[index];
-
-        // Check if entry is a hit
-        if (entry->surface == nullptr)
-            break;
-        if (entry->font == font && String::Equals(entry->text, text))
+        if (cache.Font == font)
         {
-            _ttfSurfaceCacheHitCount++;
-            entry->lastUseTick = gCurrentDrawCount;
-            return entry->surface;
+            return &cache;
         }
+    }
+    return nullptr;
+}
 
-        // If entry hasn't been used for a while, replace it
-        if (entry->lastUseTick < gCurrentDrawCount - 64)
+static const TTFGlyph* ttf_get_glyph(TTFFontCache& cache, codepoint_t codepoint)
+{
+    auto glyph = cache.Glyphs.Find(codepoint);
+    if (glyph == nullptr)
+    {
+        FontLockHelper<std::mutex> lock(_mutex);
+        glyph = cache.Glyphs.Find(codepoint);
+        if (glyph == nullptr)
         {
-            break;
+            std::optional<TTFGlyph> newGlyph = TTFGlyph{};
+            if (!TTF_GetGlyph(cache.Font, codepoint, &*newGlyph))
+            {
+                newGlyph = std::nullopt;
+            }
+            glyph = &cache.Glyphs.Add(codepoint, std::move(newGlyph));
         }
-
-        // Check if next entry is a hit
-        if (++index >= TTF_SURFACE_CACHE_SIZE)
-            index = 0;
     }
+    return glyph->has_value() ? &glyph->value() : nullptr;
+}
 
-    // Cache miss, replace entry with new surface
-    entry = &_ttfSurfaceCache[index];
-    ttf_surface_cache_dispose(entry);
-
-    TTFSurface* surface = ttf_render(font, text);
-    if (surface == nullptr)
+static int32_t ttf_get_kerning(TTFFontCache& cache, uint32_t previousIndex, uint32_t index)
+{
+    const auto key = (static_cast<uint64_t>(previousIndex) << 32) | index;
+    auto kerning = cache.Kerning.Find(key);
+    if (kerning == nullptr)
     {
-        return nullptr;
+        FontLockHelper<std::mutex> lock(_mutex);
+        kerning = cache.Kerning.Find(key);
+        if (kerning == nullptr)
+        {
+            kerning = &cache.Kerning.Add(key, TTF_GetKerning(cache.Font, previousIndex, index));
+        }
     }
-
-    _ttfSurfaceCacheMissCount++;
-    // printf("CACHE HITS: %d   MISSES: %d)\n", _ttfSurfaceCacheHitCount, _ttfSurfaceCacheMissCount);
-
-    _ttfSurfaceCacheCount++;
-    entry->surface = surface;
-    entry->font = font;
-    entry->text = strndup(text.data(), text.size());
-    entry->lastUseTick = gCurrentDrawCount;
-    return entry->surface;
+    return *kerning;
 }
 
-static void ttf_getwidth_cache_dispose(ttf_getwidth_cache_entry* entry)
+/**
+ * Calls fn with each glyph of text and its pen position, laid out the same way as the SDL_ttf port does. The fonts
+ * are always opened with the normal style and no outline. Returns false if a glyph could not be loaded.
+ */
+template<typename TFn> static bool ttf_layout(TTFFontCache& cache, std::string_view text, TFn&& fn)
 {
-    if (entry->text != nullptr)
+    int32_t x = 0;
+    uint32_t previousIndex = 0;
+    for (auto codepoint : CodepointView(text))
     {
-        free(entry->text);
+        if (codepoint == UNICODE_BOM_NATIVE || codepoint == UNICODE_BOM_SWAPPED)
+            continue;
 
-        entry->width = 0;
-        entry->font = nullptr;
-        entry->text = nullptr;
+        const auto* glyph = ttf_get_glyph(cache, codepoint);
+        if (glyph == nullptr)
+            return false;
+
+        if (previousIndex != 0 && glyph->Index != 0)
+        {
+            x += ttf_get_kerning(cache, previousIndex, glyph->Index);
+        }
+        fn(*glyph, x);
+        x += glyph->Advance;
+        previousIndex = glyph->Index;
     }
+    return true;
+}
+
+static bool ttf_measure(TTFFontCache& cache, std::string_view text, int32_t& minX, int32_t& maxX, int32_t& minY)
+{
+    minX = maxX = minY = 0;
+    return ttf_layout(cache, text, [&](const TTFGlyph& glyph, int32_t x) {
+        minX = std::min(minX, x + glyph.MinX);
+        maxX = std::max(maxX, x + std::max(glyph.Advance, glyph.MaxX));
+        minY = std::min(minY, glyph.MinY);
+    });
 }
 
-static void ttf_getwidth_cache_dispose_all()
+uint32_t ttf_get_width(TTF_Font* font, std::string_view text)
 {
-    for (int32_t i = 0; i < TTF_GETWIDTH_CACHE_SIZE; i++)
+    auto* cache = ttf_get_font_cache(font);
+    int32_t minX, maxX, minY;
+    if (cache == nullptr || !ttf_measure(*cache, text, minX, maxX, minY))
     {
-        ttf_getwidth_cache_dispose(&_ttfGetWidthCache[i]);
-        _ttfGetWidthCacheCount--;
+        return 0;
     }
+    return maxX - minX;
 }
 
-uint32_t ttf_getwidth_cache_get_or_add(TTF_Font* font, std::string_view text)
+const TTFSurface* ttf_render_string(TTF_Font* font, std::string_view text)
 {
-    ttf_getwidth_cache_entry* entry;
-
-    uint32_t hash = ttf_surface_cache_hash(font, text);
-    int32_t index = hash % TTF_GETWIDTH_CACHE_SIZE;
+    thread_local std::vector<uint8_t> pixels;
+    thread_local TTFSurface surface;
 
-    FontLockHelper<std::mutex> lock(_mutex);
-
-    for (int32_t i = 0; i < TTF_GETWIDTH_CACHE_SIZE; i++)
+    auto* cache = ttf_get_font_cache(font);
+    int32_t minX, maxX, minY;
+    if (cache == nullptr || !ttf_measure(*cache, text, minX, maxX, minY) || maxX == minX)
     {
-        entry = &_ttfGetWidthCache[index];
+        return nullptr;
+    }
 
-        // Check if entry is a hit
-        if (entry->text == nullptr)
-            break;
-        if (entry->font == font && String::Equals(entry->text, text))
+    const int32_t width = maxX - minX;
+    const int32_t height = std::max(TTF_FontAscent(font) - minY, TTF_FontHeight(font));
+    const auto size = static_cast<ptrdiff_t>(width) * height;
+    pixels.assign(size, 0);
+
+    // Text starting with a glyph that extends to the left of the pen is moved right to fit it
+    std::optional<int32_t> offsetX;
+    ttf_layout(*cache, text, [&](const TTFGlyph& glyph, int32_t x) {
+        if (!offsetX.has_value())
         {
-            _ttfGetWidthCacheHitCount++;
-            entry->lastUseTick = gCurrentDrawCount;
-            return entry->width;
+            offsetX = std::max(-glyph.MinX, 0);
         }
-
-        // If entry hasn't been used for a while, replace it
-        if (entry->lastUseTick < gCurrentDrawCount - 64)
+        for (int32_t row = 0; row < glyph.Rows; row++)
         {
-            break;
+            const int32_t y = row + glyph.YOffset;
+            if (y < 0 || y >= height)
+                continue;
+
+            const uint8_t* src = glyph.Pixels.data() + row * glyph.Width;
+            auto index = static_cast<ptrdiff_t>(y) * width + x + *offsetX + glyph.MinX;
+            for (int32_t col = 0; col < glyph.Width && index < size; col++, index++)
+            {
+                if (index >= 0)
+                {
+                    pixels[index] |= src[col];
+                }
+            }
         }
+    });
 
-        // Check if next entry is a hit
-        if (++index >= TTF_GETWIDTH_CACHE_SIZE)
-            index = 0;
-    }
-
-    // Cache miss, replace entry with new width
-    entry = &_ttfGetWidthCache[index];
-    ttf_getwidth_cache_dispose(entry);
-
-    int32_t width, height;
-    ttf_get_size(font, text, &width, &height);
-
-    _ttfGetWidthCacheMissCount++;
-
-    _ttfGetWidthCacheCount++;
-    entry->width = width;
-    entry->font = font;
-    entry->text = strndup(text.data(), text.size());
-    entry->lastUseTick = gCurrentDrawCount;
-    return entry->width;
+    surface.pixels = pixels.data();
+    surface.w = width;
+    surface.h = height;
+    surface.pitch = width;
+    return &surface;
 }
 
 TTFFontDescriptor* ttf_get_font_from_sprite_base(FontSpriteBase spriteBase)
 {
-    FontLockHelper<std::mutex> lock(_mutex);
     return &gCurrentTTFFontSet->size[font_get_size_from_sprite_base(spriteBase)];
 }
 
@@ -357,27 +464,6 @@ bool ttf_provides_glyph(const TTF_Font* font, codepoint_t codepoint)
     return TTF_GlyphIsProvided(font, codepoint);
 }
 
-static bool ttf_get_size(TTF_Font* font, std::string_view text, int32_t* outWidth, int32_t* outHeight)
-{
-    thread_local std::string buffer;
-    buffer.assign(text);
-    return TTF_SizeUTF8(font, buffer.c_str(), outWidth, outHeight);
-}
-
-static TTFSurface* ttf_render(TTF_Font* font, std::string_view text)
-{
-    thread_local std::string buffer;
-    buffer.assign(text);
-    if (TTF_GetFontHinting(font) != 0)
-    {
-        return TTF_RenderUTF8_Shaded(font, buffer.c_str(), 0x000000FF, 0x000000FF);
-    }
-    else
-    {
-        return TTF_RenderUTF8_Solid(font, buffer.c_str(), 0x000000FF);
-    }
-}
-
 void ttf_free_surface(TTFSurface* surface)
 {
     free(const_cast<void*>(surface->pixels));
@@ -397,4 +483,9 @@ void ttf_dispose()
 {
 }
 
+size_t ttf_get_cache_memory_usage()
+{
+    return 0;
+}
+
 #endif // NO_TTF
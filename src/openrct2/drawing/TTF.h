@@ -12,10 +12,16 @@
 #include "Font.h"
 
 #include <string_view>
+#include <vector>
 
 bool ttf_initialise();
 void ttf_dispose();
 
+/**
+ * Returns the bytes held by the cached glyphs and kerning of all fonts.
+ */
+size_t ttf_get_cache_memory_usage();
+
 #ifndef NO_TTF
 
 struct TTFSurface
@@ -26,10 +32,35 @@ struct TTFSurface
     int32_t pitch;
 };
 
+struct TTFGlyph
+{
+    // FreeType glyph index, used for kerning
+    uint32_t Index;
+    int32_t MinX;
+    int32_t MaxX;
+    int32_t MinY;
+    int32_t MaxY;
+    int32_t YOffset;
+    int32_t Advance;
+    int32_t Width;
+    int32_t Rows;
+    // Width * Rows coverage values, the bitmap or the pixmap of the glyph depending on the font hinting
+    std::vector<uint8_t> Pixels;
+};
+
 TTFFontDescriptor* ttf_get_font_from_sprite_base(FontSpriteBase spriteBase);
 void ttf_toggle_hinting();
-TTFSurface* ttf_surface_cache_get_or_add(TTF_Font* font, std::string_view text);
-uint32_t ttf_getwidth_cache_get_or_add(TTF_Font* font, std::string_view text);
+
+/**
+ * Renders text from the cached glyphs of the font. The surface belongs to the calling thread and stays valid until its
+ * next call.
+ */
+const TTFSurface* ttf_render_string(TTF_Font* font, std::string_view text);
+
+/**
+ * Returns the width text would be rendered with. Does not lock once the glyphs of the text have been cached.
+ */
+uint32_t ttf_get_width(TTF_Font* font, std::string_view text);
 bool ttf_provides_glyph(const TTF_Font* font, codepoint_t codepoint);
 void ttf_free_surface(TTFSurface* surface);
 
@@ -41,6 +72,10 @@ int TTF_SizeUTF8(TTF_Font* font, const char* text, int* w, int* h);
 TTFSurface* TTF_RenderUTF8_Solid(TTF_Font* font, const char* text, uint32_t colour);
 TTFSurface* TTF_RenderUTF8_Shaded(TTF_Font* font, const char* text, uint32_t fg, uint32_t bg);
 void TTF_CloseFont(TTF_Font* font);
+bool TTF_GetGlyph(TTF_Font* font, codepoint_t ch, TTFGlyph* glyph);
+int TTF_GetKerning(TTF_Font* font, uint32_t previousIndex, uint32_t index);
+int TTF_FontHeight(const TTF_Font* font);
+int TTF_FontAscent(const TTF_Font* font);
 void TTF_SetFontHinting(TTF_Font* font, int hinting);
 int TTF_GetFontHinting(const TTF_Font* font);
 void TTF_Quit(void);
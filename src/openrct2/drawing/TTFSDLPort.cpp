@@ -1535,6 +1535,60 @@ TTFSurface* TTF_RenderUTF8_Shaded(TTF_Font* font, const char* text, [[maybe_unus
     return textbuf;
 }
 
+bool TTF_GetGlyph(TTF_Font* font, codepoint_t ch, TTFGlyph* glyph)
+{
+    const bool shaded = TTF_GetFontHinting(font) != 0;
+    if (Find_Glyph(font, ch, CACHED_METRICS | (shaded ? CACHED_PIXMAP : CACHED_BITMAP)) != 0)
+    {
+        return false;
+    }
+
+    const c_glyph* cached = font->current;
+    const FT_Bitmap& bitmap = shaded ? cached->pixmap : cached->bitmap;
+    glyph->Index = cached->index;
+    glyph->MinX = cached->minx;
+    glyph->MaxX = cached->maxx;
+    glyph->MinY = cached->miny;
+    glyph->MaxY = cached->maxy;
+    glyph->YOffset = cached->yoffset;
+    glyph->Advance = cached->advance;
+
+    /* Same width correction as the render functions */
+    glyph->Width = static_cast<int32_t>(bitmap.width);
+    if (font->outline <= 0 && glyph->Width > cached->maxx - cached->minx)
+    {
+        glyph->Width = std::max(cached->maxx - cached->minx, 0);
+    }
+    glyph->Rows = static_cast<int32_t>(bitmap.rows);
+    glyph->Pixels.resize(static_cast<size_t>(glyph->Width) * glyph->Rows);
+    for (int32_t row = 0; row < glyph->Rows; row++)
+    {
+        std::copy_n(bitmap.buffer + row * bitmap.pitch, glyph->Width, glyph->Pixels.data() + row * glyph->Width);
+    }
+    return true;
+}
+
+int TTF_GetKerning(TTF_Font* font, uint32_t previousIndex, uint32_t index)
+{
+    if (!FT_HAS_KERNING(font->face) || !font->kerning)
+    {
+        return 0;
+    }
+    FT_Vector delta;
+    FT_Get_Kerning(font->face, previousIndex, index, ft_kerning_default, &delta);
+    return delta.x >> 6;
+}
+
+int TTF_FontHeight(const TTF_Font* font)
+{
+    return font->height;
+}
+
+int TTF_FontAscent(const TTF_Font* font)
+{
+    return font->ascent;
+}
+
 void TTF_SetFontHinting(TTF_Font* font, int hinting)
 {
     if (hinting == TTF_HINTING_LIGHT)
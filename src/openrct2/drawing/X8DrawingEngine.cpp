@@ -177,6 +177,8 @@ void X8DrawingEngine::Invalidate(int32_t left, int32_t top, int32_t right, int32
     top >>= _dirtyGrid.BlockShiftY;
     bottom >>= _dirtyGrid.BlockShiftY;
 
+    _dirtyStats.Invalidations++;
+
     uint32_t dirtyBlockColumns = _dirtyGrid.BlockColumns;
     uint8_t* screenDirtyBlocks = _dirtyGrid.Blocks;
     for (int16_t y = top; y <= bottom; y++)
@@ -184,7 +186,11 @@ void X8DrawingEngine::Invalidate(int32_t left, int32_t top, int32_t right, int32
         uint32_t yOffset = y * dirtyBlockColumns;
         for (int16_t x = left; x <= right; x++)
         {
-            screenDirtyBlocks[yOffset + x] = 0xFF;
+            if (screenDirtyBlocks[yOffset + x] == 0)
+            {
+                screenDirtyBlocks[yOffset + x] = 0xFF;
+                _dirtyGrid.DirtyCount++;
+            }
         }
     }
 }
@@ -218,6 +224,10 @@ void X8DrawingEngine::PaintWindows()
     DrawAllDirtyBlocks();
     window_update_all_viewports();
     DrawAllDirtyBlocks();
+
+    _lastFrameDirtyStats = _dirtyStats;
+    _lastFrameDirtyStats.ScreenPixels = static_cast<uint64_t>(_width) * _height;
+    _dirtyStats = {};
 }
 
 void X8DrawingEngine::PaintWeather()
@@ -291,6 +301,11 @@ void X8DrawingEngine::InvalidateImage([[maybe_unused]] uint32_t image)
     // Not applicable for this engine
 }
 
+DrawingEngineDirtyStats X8DrawingEngine::GetLastFrameDirtyStats()
+{
+    return _lastFrameDirtyStats;
+}
+
 rct_drawpixelinfo* X8DrawingEngine::GetDPI()
 {
     return &_bitsDPI;
@@ -362,19 +377,37 @@ void X8DrawingEngine::OnDrawDirtyBlock(
 
 void X8DrawingEngine::ConfigureDirtyGrid()
 {
-    _dirtyGrid.BlockShiftX = 7;
-    _dirtyGrid.BlockShiftY = 6;
+    // Moving sprites dirty less of the screen with smaller blocks, but every dirty region is a separate paint of the
+    // windows. Large screens keep the larger blocks so the number of regions stays bounded.
+    _dirtyGrid.BlockShiftX = _width > 1920 ? 7 : 6;
+    _dirtyGrid.BlockShiftY = _height > 1200 ? 6 : 5;
     _dirtyGrid.BlockWidth = 1 << _dirtyGrid.BlockShiftX;
     _dirtyGrid.BlockHeight = 1 << _dirtyGrid.BlockShiftY;
     _dirtyGrid.BlockColumns = (_width >> _dirtyGrid.BlockShiftX) + 1;
     _dirtyGrid.BlockRows = (_height >> _dirtyGrid.BlockShiftY) + 1;
 
+    // Start with everything dirty so the resized screen is redrawn
     delete[] _dirtyGrid.Blocks;
-    _dirtyGrid.Blocks = new uint8_t[_dirtyGrid.BlockColumns * _dirtyGrid.BlockRows];
+    _dirtyGrid.DirtyCount = _dirtyGrid.BlockColumns * _dirtyGrid.BlockRows;
+    _dirtyGrid.Blocks = new uint8_t[_dirtyGrid.DirtyCount];
+    std::fill_n(_dirtyGrid.Blocks, _dirtyGrid.DirtyCount, 0xFF);
 }
 
 void X8DrawingEngine::DrawAllDirtyBlocks()
 {
+    if (_dirtyGrid.DirtyCount == 0)
+    {
+        return;
+    }
+
+    // When most of the screen is dirty, drawing it as one region is cheaper than painting the windows for every
+    // separate region
+    if (_dirtyGrid.DirtyCount * 4 >= _dirtyGrid.BlockColumns * _dirtyGrid.BlockRows * 3)
+    {
+        DrawDirtyBlocks(0, 0, _dirtyGrid.BlockColumns, _dirtyGrid.BlockRows);
+        return;
+    }
+
     for (uint32_t x = 0; x < _dirtyGrid.BlockColumns; x++)
     {
         for (uint32_t y = 0; y < _dirtyGrid.BlockRows; y++)
@@ -432,7 +465,11 @@ void X8DrawingEngine::DrawDirtyBlocks(uint32_t x, uint32_t y, uint32_t columns,
         uint32_t topOffset = top * dirtyBlockColumns;
         for (uint32_t left = x; left < x + columns; left++)
         {
-            screenDirtyBlocks[topOffset + left] = 0;
+            if (screenDirtyBlocks[topOffset + left] != 0)
+            {
+                screenDirtyBlocks[topOffset + left] = 0;
+                _dirtyGrid.DirtyCount--;
+            }
         }
     }
 
@@ -446,6 +483,9 @@ void X8DrawingEngine::DrawDirtyBlocks(uint32_t x, uint32_t y, uint32_t columns,
         return;
     }
 
+    _dirtyStats.Regions++;
+    _dirtyStats.Pixels += static_cast<uint64_t>(right - left) * (bottom - top);
+
     // Draw region
     OnDrawDirtyBlock(x, y, columns, rows);
     window_draw_all(&_bitsDPI, left, top, right, bottom);
@@ -707,11 +747,20 @@ void X8DrawingContext::FilterRect(FilterPaletteID palette, int32_t left, int32_t
         const int32_t scaled_width = width / dpi->zoom_level;
         const int32_t step = ((dpi->width / dpi->zoom_level) + dpi->pitch);
 
-        // Fill the rectangle with the colours from the colour table
+        // Fill the rectangle with the colours from the colour table, directly from the table when every index is in it
+        const uint8_t* fullMap = paletteMap->GetFullMap();
         auto c = height / dpi->zoom_level;
         for (int32_t i = 0; i < c; i++)
         {
             uint8_t* nextdst = dst + step * i;
+            if (fullMap != nullptr)
+            {
+                for (int32_t j = 0; j < scaled_width; j++)
+                {
+                    nextdst[j] = fullMap[nextdst[j]];
+                }
+                continue;
+            }
             for (int32_t j = 0; j < scaled_width; j++)
             {
                 auto index = *(nextdst + j);
@@ -32,6 +32,7 @@ namespace OpenRCT2
             uint32_t BlockHeight;
             uint32_t BlockColumns;
             uint32_t BlockRows;
+            uint32_t DirtyCount;
             uint8_t* Blocks;
         };
 
@@ -75,6 +76,8 @@ namespace OpenRCT2
             uint8_t* _bits = nullptr;
 
             DirtyGrid _dirtyGrid = {};
+            DrawingEngineDirtyStats _dirtyStats = {};
+            DrawingEngineDirtyStats _lastFrameDirtyStats = {};
 
             rct_drawpixelinfo _bitsDPI = {};
 
@@ -113,6 +116,7 @@ namespace OpenRCT2
             rct_drawpixelinfo* GetDrawingPixelInfo() override;
             DRAWING_ENGINE_FLAGS GetFlags() override;
             void InvalidateImage(uint32_t image) override;
+            DrawingEngineDirtyStats GetLastFrameDirtyStats() override;
 
             rct_drawpixelinfo* GetDPI();
 
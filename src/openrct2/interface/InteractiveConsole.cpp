@@ -12,6 +12,7 @@
 #include "../Context.h"
 #include "../EditorObjectSelectionSession.h"
 #include "../Game.h"
+#include "../MemoryUsage.h"
 #include "../OpenRCT2.h"
 #include "../PlatformEnvironment.h"
 #include "../ReplayManager.h"
@@ -19,14 +20,18 @@
 #include "../actions/ClimateSetAction.h"
 #include "../actions/RideSetPriceAction.h"
 #include "../actions/RideSetSettingAction.h"
+#include "../actions/ScenarioSetSettingAction.h"
 #include "../actions/SetCheatAction.h"
 #include "../actions/StaffSetCostumeAction.h"
 #include "../config/Config.h"
 #include "../core/Guard.hpp"
+#include "../core/Json.hpp"
 #include "../core/Path.hpp"
 #include "../core/String.hpp"
+#include "../core/Trace.h"
 #include "../drawing/Drawing.h"
 #include "../drawing/Font.h"
+#include "../drawing/IDrawingEngine.h"
 #include "../interface/Chat.h"
 #include "../interface/Colour.h"
 #include "../interface/Window_internal.h"
@@ -39,10 +44,13 @@
 #include "../object/ObjectList.h"
 #include "../object/ObjectManager.h"
 #include "../object/ObjectRepository.h"
+#include "../paint/Painter.h"
+#include "../peep/GuestPathfinding.h"
 #include "../peep/Staff.h"
 #include "../platform/platform.h"
 #include "../ride/Ride.h"
 #include "../ride/RideData.h"
+#include "../scripting/ScriptEngine.h"
 #include "../util/Util.h"
 #include "../windows/Intent.h"
 #include "../world/Climate.h"
@@ -623,6 +631,10 @@ static int32_t cc_get(InteractiveConsole& console, const arguments_t& argv)
         {
             console.WriteFormatLine("difficult_guest_generation %d", (gParkFlags & PARK_FLAGS_DIFFICULT_GUEST_GENERATION) != 0);
         }
+        else if (argv[0] == "pathfinding_budget")
+        {
+            console.WriteFormatLine("pathfinding_budget %d", gGuestPathfindingBudget);
+        }
         else if (argv[0] == "park_open")
         {
             console.WriteFormatLine("park_open %d", (gParkFlags & PARK_FLAGS_PARK_OPEN) != 0);
@@ -649,6 +661,10 @@ static int32_t cc_get(InteractiveConsole& console, const arguments_t& argv)
         {
             console.WriteFormatLine("console_small_font %d", gConfigInterface.console_small_font);
         }
+        else if (argv[0] == "show_performance_overlay")
+        {
+            console.WriteFormatLine("show_performance_overlay %d", gConfigGeneral.show_performance_overlay);
+        }
         else if (argv[0] == "location")
         {
             rct_window* w = window_get_main();
@@ -844,6 +860,18 @@ static int32_t cc_set(InteractiveConsole& console, const arguments_t& argv)
             SET_FLAG(gParkFlags, PARK_FLAGS_DIFFICULT_GUEST_GENERATION, int_val[0]);
             console.Execute("get difficult_guest_generation");
         }
+        else if (argv[0] == "pathfinding_budget" && invalidArguments(&invalidArgs, int_valid[0]))
+        {
+            auto scenarioSetSetting = ScenarioSetSettingAction(
+                ScenarioSetSetting::GuestPathfindingBudget, std::clamp(int_val[0], 0, 0xFFFF));
+            scenarioSetSetting.SetCallback([&console](const GameAction*, const GameActions::Result* res) {
+                if (res->Error != GameActions::Status::Ok)
+                    console.WriteLineError("Network error: Permission denied!");
+                else
+                    console.Execute("get pathfinding_budget");
+            });
+            GameActions::Execute(&scenarioSetSetting);
+        }
         else if (argv[0] == "park_open" && invalidArguments(&invalidArgs, int_valid[0]))
         {
             SET_FLAG(gParkFlags, PARK_FLAGS_PARK_OPEN, int_val[0]);
@@ -908,6 +936,12 @@ static int32_t cc_set(InteractiveConsole& console, const arguments_t& argv)
             config_save_default();
             console.Execute("get console_small_font");
         }
+        else if (argv[0] == "show_performance_overlay" && invalidArguments(&invalidArgs, int_valid[0]))
+        {
+            gConfigGeneral.show_performance_overlay = (int_val[0] != 0);
+            config_save_default();
+            console.Execute("get show_performance_overlay");
+        }
         else if (argv[0] == "location" && invalidArguments(&invalidArgs, int_valid[0] && int_valid[1]))
         {
             rct_window* w = window_get_main();
@@ -1268,6 +1302,125 @@ static int32_t cc_show_limits(InteractiveConsole& console, [[maybe_unused]] cons
     return 0;
 }
 
+static int32_t cc_dirty_stats(InteractiveConsole& console, [[maybe_unused]] const arguments_t& argv)
+{
+    auto drawingEngine = OpenRCT2::GetContext()->GetDrawingEngine();
+    if (drawingEngine == nullptr)
+    {
+        console.WriteLineError("No drawing engine.");
+        return 1;
+    }
+
+    auto stats = drawingEngine->GetLastFrameDirtyStats();
+    auto percentage = stats.ScreenPixels != 0 ? (stats.Pixels * 100.0) / stats.ScreenPixels : 0.0;
+    console.WriteFormatLine("Invalidations: %u", stats.Invalidations);
+    console.WriteFormatLine("Dirty regions: %u", stats.Regions);
+    console.WriteFormatLine(
+        "Dirty pixels: %llu/%llu (%.1f%%)", static_cast<unsigned long long>(stats.Pixels),
+        static_cast<unsigned long long>(stats.ScreenPixels), percentage);
+    return 0;
+}
+
+static int32_t cc_paint_stats(InteractiveConsole& console, [[maybe_unused]] const arguments_t& argv)
+{
+    auto stats = OpenRCT2::GetContext()->GetPainter()->GetSessionStats();
+    console.WriteFormatLine("Paint sessions: %u", static_cast<uint32_t>(stats.Sessions));
+    console.WriteFormatLine(
+        "Peak paint structs per session: %u/%u", static_cast<uint32_t>(stats.PeakPaintStructs), MAX_PAINT_STRUCTS);
+    console.WriteFormatLine(
+        "Allocated paint structs: %u (%u KiB)", static_cast<uint32_t>(stats.AllocatedPaintStructs),
+        static_cast<uint32_t>(stats.AllocatedPaintStructs * sizeof(paint_entry) / 1024));
+    return 0;
+}
+
+static int32_t cc_memory_stats(InteractiveConsole& console, const arguments_t& argv)
+{
+    if (!argv.empty() && argv[0] == "json")
+    {
+        console.WriteLine(GetMemoryUsageAsJson().dump());
+        return 0;
+    }
+
+    size_t totalBytes = 0;
+    for (const auto& entry : GetMemoryUsage())
+    {
+        console.WriteFormatLine(
+            "%s: %u KiB (%u)", entry.Name.c_str(), static_cast<uint32_t>(entry.Bytes / 1024),
+            static_cast<uint32_t>(entry.Count));
+        totalBytes += entry.Bytes;
+    }
+    console.WriteFormatLine("Total: %u KiB", static_cast<uint32_t>(totalBytes / 1024));
+    return 0;
+}
+
+static int32_t cc_trace(InteractiveConsole& console, const arguments_t& argv)
+{
+    if (!OpenRCT2::Trace::IsEnabled())
+    {
+        console.WriteLineError("Tracing is not enabled in this build, it needs to be built with ENABLE_TRACING.");
+        return 1;
+    }
+    if (argv.empty())
+    {
+        console.WriteLineError("Missing argument, trace start|stop|dump [file].");
+        return 1;
+    }
+
+    if (argv[0] == "start")
+    {
+        OpenRCT2::Trace::Start();
+        console.WriteLine("Trace recording started.");
+    }
+    else if (argv[0] == "stop")
+    {
+        OpenRCT2::Trace::Stop();
+        console.WriteLine("Trace recording stopped.");
+    }
+    else if (argv[0] == "dump")
+    {
+        std::string name = argv.size() >= 2 ? argv[1] : "trace";
+        if (!String::EndsWith(name, ".json", true))
+        {
+            name += ".json";
+        }
+        auto path = Path::Combine(
+            OpenRCT2::GetContext()->GetPlatformEnvironment()->GetDirectoryPath(OpenRCT2::DIRBASE::USER), name);
+        try
+        {
+            auto numZones = OpenRCT2::Trace::WriteChromeTrace(path);
+            console.WriteFormatLine("Wrote %u zones to %s", static_cast<uint32_t>(numZones), path.c_str());
+        }
+        catch (const std::exception& e)
+        {
+            console.WriteLineError(e.what());
+            return 1;
+        }
+    }
+    else
+    {
+        console.WriteLineError("Unknown argument, trace start|stop|dump [file].");
+        return 1;
+    }
+    return 0;
+}
+
+static int32_t cc_network_stats(InteractiveConsole& console, [[maybe_unused]] const arguments_t& argv)
+{
+    console.WriteLine(network_get_stats_as_json().dump());
+    return 0;
+}
+
+static int32_t cc_plugin_stats(InteractiveConsole& console, [[maybe_unused]] const arguments_t& argv)
+{
+#ifdef ENABLE_SCRIPTING
+    auto& scriptEngine = OpenRCT2::GetContext()->GetScriptEngine();
+    console.WriteLine(scriptEngine.GetPluginStatsAsJson().dump());
+#else
+    console.WriteLineError("Plugins are not supported in this build.");
+#endif
+    return 0;
+}
+
 static int32_t cc_for_date([[maybe_unused]] InteractiveConsole& console, [[maybe_unused]] const arguments_t& argv)
 {
     int32_t year = 0;
@@ -1344,7 +1497,8 @@ static int32_t cc_load_park([[maybe_unused]] InteractiveConsole& console, [[mayb
     {
         safe_strcpy(savePath, argv[0].c_str(), sizeof(savePath));
     }
-    if (!String::EndsWith(savePath, ".sv6", true) && !String::EndsWith(savePath, ".sc6", true))
+    if (!String::EndsWith(savePath, ".sv6", true) && !String::EndsWith(savePath, ".sc6", true)
+        && !String::EndsWith(savePath, ".park", true))
     {
         path_append_extension(savePath, ".sv6", sizeof(savePath));
     }
@@ -1519,6 +1673,38 @@ static int32_t cc_replay_start(InteractiveConsole& console, const arguments_t& a
     return 0;
 }
 
+static int32_t cc_replay_seek(InteractiveConsole& console, const arguments_t& argv)
+{
+    if (network_get_mode() != NETWORK_MODE_NONE)
+    {
+        console.WriteFormatLine("This command is currently not supported in multiplayer mode.");
+        return 0;
+    }
+
+    if (argv.size() < 1)
+    {
+        console.WriteFormatLine("Parameters required <tick>");
+        return 0;
+    }
+
+    uint32_t tick = atol(argv[0].c_str());
+
+    auto* replayManager = OpenRCT2::GetContext()->GetReplayManager();
+    if (!replayManager->IsReplaying())
+    {
+        console.WriteFormatLine("No replay is playing.");
+        return 0;
+    }
+
+    if (replayManager->SeekPlayback(tick))
+    {
+        console.WriteFormatLine("Replay is at tick %u", tick);
+        return 1;
+    }
+
+    return 0;
+}
+
 static int32_t cc_replay_stop(InteractiveConsole& console, const arguments_t& argv)
 {
     if (network_get_mode() != NETWORK_MODE_NONE)
@@ -1746,12 +1932,14 @@ static constexpr const utf8* console_variable_table[] = {
     "no_money",
     "difficult_park_rating",
     "difficult_guest_generation",
+    "pathfinding_budget",
     "land_rights_cost",
     "construction_rights_cost",
     "park_open",
     "climate",
     "game_speed",
     "console_small_font",
+    "show_performance_overlay",
     "location",
     "window_scale",
     "window_limit",
@@ -1779,6 +1967,7 @@ static constexpr const console_command console_command_table[] = {
     { "clear", cc_clear, "Clears the console.", "clear" },
     { "close", cc_close, "Closes the console.", "close" },
     { "date", cc_for_date, "Sets the date to a given date.", "Format <year>[ <month>[ <day>]]." },
+    { "dirty_stats", cc_dirty_stats, "Shows how much of the screen was redrawn in the last frame.", "dirty_stats" },
     { "dereference", cc_dereference, "Dereferences a nullptr, for testing purposes only", "dereference" },
     { "echo", cc_echo, "Echoes the text to the console.", "echo <text>" },
     { "exit", cc_close, "Closes the console.", "exit" },
@@ -1790,8 +1979,12 @@ static constexpr const console_command console_command_table[] = {
                                     "This is a safer method opposed to \"open object_selection\".",
                                     "load_object <objectfilenodat>" },
     { "load_park", cc_load_park, "Load park from save directory or by absolute path", "load_park <filename>" },
+    { "memory_stats", cc_memory_stats, "Shows the memory used by each subsystem.", "memory_stats [json]" },
+    { "network_stats", cc_network_stats, "Shows the network traffic, send backlogs and join timings as JSON.", "network_stats" },
     { "object_count", cc_object_count, "Shows the number of objects of each type in the scenario.", "object_count" },
     { "open", cc_open, "Opens the window with the give name.", "open <window>." },
+    { "paint_stats", cc_paint_stats, "Shows how many paint structs the paint sessions use.", "paint_stats" },
+    { "plugin_stats", cc_plugin_stats, "Shows the script time used by each plugin as JSON.", "plugin_stats" },
     { "quit", cc_close, "Closes the console.", "quit" },
     { "remove_park_fences", cc_remove_park_fences, "Removes all park fences from the surface", "remove_park_fences" },
     { "remove_unused_objects", cc_remove_unused_objects, "Removes all the unused objects from the object selection.", "remove_unused_objects" },
@@ -1803,11 +1996,13 @@ static constexpr const console_command console_command_table[] = {
     { "show_limits", cc_show_limits, "Shows the map data counts and limits.", "show_limits" },
     { "staff", cc_staff, "Staff management.", "staff <subcommand>" },
     { "terminate", cc_terminate, "Calls std::terminate(), for testing purposes only.", "terminate" },
+    { "trace", cc_trace, "Records the hot paths of the game as a Chrome / Perfetto trace.", "trace start|stop|dump [file]" },
     { "variables", cc_variables, "Lists all the variables that can be used with get and sometimes set.", "variables" },
     { "windows", cc_windows, "Lists all the windows that can be opened.", "windows" },
     { "replay_startrecord", cc_replay_startrecord, "Starts recording a new replay.", "replay_startrecord <name> [max_ticks]"},
     { "replay_stoprecord", cc_replay_stoprecord, "Stops recording a new replay.", "replay_stoprecord"},
     { "replay_start", cc_replay_start, "Starts a replay", "replay_start <name>"},
+    { "replay_seek", cc_replay_seek, "Moves the replay to the given tick, counted from its start", "replay_seek <tick>"},
     { "replay_stop", cc_replay_stop, "Stops the replay", "replay_stop"},
     { "replay_normalise", cc_replay_normalise, "Normalises the replay to remove all gaps", "replay_normalise <input file> <output file>"},
     { "mp_desync", cc_mp_desync, "Forces a multiplayer desync", "cc_mp_desync [desync_type, 0 = Random t-shirt color on random peep, 1 = Remove random peep ]"},
@@ -18,6 +18,7 @@
 #include "../audio/audio.h"
 #include "../core/Console.hpp"
 #include "../core/Imaging.h"
+#include "../core/JobPool.h"
 #include "../drawing/Drawing.h"
 #include "../drawing/X8DrawingEngine.h"
 #include "../localisation/Localisation.h"
@@ -29,12 +30,17 @@
 #include "../world/Surface.h"
 #include "Viewport.h"
 
+#include <array>
+#include <atomic>
 #include <cctype>
 #include <chrono>
 #include <cstdlib>
+#include <exception>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
+#include <unordered_set>
 
 using namespace std::literals::string_literals;
 using namespace OpenRCT2;
@@ -42,26 +48,72 @@ using namespace OpenRCT2::Drawing;
 
 uint8_t gScreenshotCountdown = 0;
 
-static bool WriteDpiToFile(std::string_view path, const rct_drawpixelinfo* dpi, const GamePalette& palette)
+static std::unique_ptr<JobPool> _screenshotWriteJobs;
+static std::mutex _pendingScreenshotsMutex;
+static std::unordered_set<std::string> _pendingScreenshotPaths;
+static std::atomic<bool> _screenshotWriteFailed;
+
+static Image CreateImageFromDpi(const rct_drawpixelinfo* dpi, const GamePalette& palette)
 {
     auto const pixels8 = dpi->bits;
     auto const pixelsLen = (dpi->width + dpi->pitch) * dpi->height;
-    try
+
+    Image image;
+    image.Width = dpi->width;
+    image.Height = dpi->height;
+    image.Depth = 8;
+    image.Stride = dpi->width + dpi->pitch;
+    image.Palette = std::make_unique<GamePalette>(palette);
+    image.Pixels = std::vector<uint8_t>(pixels8, pixels8 + pixelsLen);
+    return image;
+}
+
+static bool IsScreenshotPending(const std::string& path)
+{
+    std::lock_guard<std::mutex> lock(_pendingScreenshotsMutex);
+    return _pendingScreenshotPaths.find(path) != _pendingScreenshotPaths.end();
+}
+
+/**
+ * Encodes the image on a worker so the game carries on meanwhile. The path is reserved until the file is written, a
+ * failure is reported by the next screenshot_check.
+ */
+static void QueueScreenshotWrite(const std::string& path, Image&& image)
+{
+    if (_screenshotWriteJobs == nullptr)
     {
-        Image image;
-        image.Width = dpi->width;
-        image.Height = dpi->height;
-        image.Depth = 8;
-        image.Stride = dpi->width + dpi->pitch;
-        image.Palette = std::make_unique<GamePalette>(palette);
-        image.Pixels = std::vector<uint8_t>(pixels8, pixels8 + pixelsLen);
-        Imaging::WriteToFile(path, image, IMAGE_FORMAT::PNG);
-        return true;
+        _screenshotWriteJobs = std::make_unique<JobPool>(1);
     }
-    catch (const std::exception& e)
+
     {
-        log_error("Unable to write png: %s", e.what());
-        return false;
+        std::lock_guard<std::mutex> lock(_pendingScreenshotsMutex);
+        _pendingScreenshotPaths.insert(path);
+    }
+
+    // std::function has to be copyable, which Image is not
+    auto sharedImage = std::make_shared<Image>(std::move(image));
+    auto compressionLevel = gConfigGeneral.screenshot_compression_level;
+    _screenshotWriteJobs->AddTask([path, sharedImage, compressionLevel]() {
+        try
+        {
+            Imaging::WriteToFile(path, *sharedImage, IMAGE_FORMAT::PNG, compressionLevel);
+        }
+        catch (const std::exception& e)
+        {
+            log_error("Unable to save screenshot: %s", e.what());
+            _screenshotWriteFailed = true;
+        }
+
+        std::lock_guard<std::mutex> lock(_pendingScreenshotsMutex);
+        _pendingScreenshotPaths.erase(path);
+    });
+}
+
+void screenshot_wait_for_pending()
+{
+    if (_screenshotWriteJobs != nullptr)
+    {
+        _screenshotWriteJobs->Join();
     }
 }
 
@@ -71,6 +123,11 @@ static bool WriteDpiToFile(std::string_view path, const rct_drawpixelinfo* dpi,
  */
 void screenshot_check()
 {
+    if (_screenshotWriteFailed.exchange(false))
+    {
+        context_show_error(STR_SCREENSHOT_FAILED, STR_NONE, {});
+    }
+
     if (gScreenshotCountdown != 0)
     {
         gScreenshotCountdown--;
@@ -146,7 +203,7 @@ static std::optional<std::string> screenshot_get_next_path()
     for (int tries = 0; tries < 100; tries++)
     {
         auto path = pathComposer(tries);
-        if (!Platform::FileExists(path))
+        if (!Platform::FileExists(path) && !IsScreenshotPending(path))
         {
             return path;
         }
@@ -166,14 +223,8 @@ std::string screenshot_dump_png(rct_drawpixelinfo* dpi)
         return "";
     }
 
-    if (WriteDpiToFile(path->c_str(), dpi, gPalette))
-    {
-        return *path;
-    }
-    else
-    {
-        return "";
-    }
+    QueueScreenshotWrite(*path, CreateImageFromDpi(dpi, gPalette));
+    return *path;
 }
 
 std::string screenshot_dump_png_32bpp(int32_t width, int32_t height, const void* pixels)
@@ -188,22 +239,14 @@ std::string screenshot_dump_png_32bpp(int32_t width, int32_t height, const void*
     const auto pixels8 = static_cast<const uint8_t*>(pixels);
     const auto pixelsLen = width * 4 * height;
 
-    try
-    {
-        Image image;
-        image.Width = width;
-        image.Height = height;
-        image.Depth = 32;
-        image.Stride = width * 4;
-        image.Pixels = std::vector<uint8_t>(pixels8, pixels8 + pixelsLen);
-        Imaging::WriteToFile(path->c_str(), image, IMAGE_FORMAT::PNG_32);
-        return *path;
-    }
-    catch (const std::exception& e)
-    {
-        log_error("Unable to save screenshot: %s", e.what());
-        return "";
-    }
+    Image image;
+    image.Width = width;
+    image.Height = height;
+    image.Depth = 32;
+    image.Stride = width * 4;
+    image.Pixels = std::vector<uint8_t>(pixels8, pixels8 + pixelsLen);
+    QueueScreenshotWrite(*path, std::move(image));
+    return *path;
 }
 
 enum class EdgeType
@@ -378,9 +421,69 @@ static void RenderViewport(IDrawingEngine* drawingEngine, const rct_viewport& vi
     viewport_render(&dpi, &viewport, 0, 0, viewport.width, viewport.height);
 }
 
+/**
+ * Renders the viewport in horizontal strips and streams them into a PNG. Each strip is encoded on a worker while the
+ * next one is painted, so only two strips are ever held in memory rather than the whole image.
+ */
+static void RenderViewportToFile(const rct_viewport& viewport, std::string_view path, const GamePalette& palette)
+{
+    constexpr int32_t StripHeight = 512;
+
+    // Ensure sprites appear regardless of rotation
+    reset_all_sprite_quadrant_placements();
+    auto drawingEngine = std::make_unique<X8DrawingEngine>(GetContext()->GetUiContext());
+
+    Imaging::PngStreamWriter writer(
+        path, viewport.width, viewport.height, palette, gConfigGeneral.screenshot_compression_level);
+    const auto stripSize = static_cast<size_t>(viewport.width) * std::min<int32_t>(StripHeight, viewport.height);
+    std::array<std::vector<uint8_t>, 2> strips;
+    std::exception_ptr encodeError;
+
+    JobPool encodeJobs(1);
+    for (int32_t top = 0, stripIndex = 0; top < viewport.height; top += StripHeight, stripIndex ^= 1)
+    {
+        const auto stripHeight = std::min<int32_t>(StripHeight, viewport.height - top);
+        auto& strip = strips[stripIndex];
+        strip.assign(stripSize, PALETTE_INDEX_0);
+
+        rct_drawpixelinfo dpi{};
+        dpi.bits = strip.data();
+        dpi.x = viewport.pos.x;
+        dpi.y = viewport.pos.y + top;
+        dpi.width = viewport.width;
+        dpi.height = stripHeight;
+        dpi.DrawingEngine = drawingEngine.get();
+        viewport_render(
+            &dpi, &viewport, viewport.pos.x, viewport.pos.y + top, viewport.pos.x + viewport.width,
+            viewport.pos.y + top + stripHeight);
+
+        // The previous strip has to be written first, and its buffer is the one painted next
+        encodeJobs.Join();
+        if (encodeError != nullptr)
+        {
+            std::rethrow_exception(encodeError);
+        }
+        encodeJobs.AddTask([&writer, &strip, &encodeError, width = viewport.width, stripHeight]() {
+            try
+            {
+                writer.WriteRows(strip.data(), stripHeight, width);
+            }
+            catch (const std::exception&)
+            {
+                encodeError = std::current_exception();
+            }
+        });
+    }
+    encodeJobs.Join();
+    if (encodeError != nullptr)
+    {
+        std::rethrow_exception(encodeError);
+    }
+    writer.Finish();
+}
+
 void screenshot_giant()
 {
-    rct_drawpixelinfo dpi{};
     try
     {
         auto path = screenshot_get_next_path();
@@ -409,10 +512,7 @@ void screenshot_giant()
             viewport.flags |= VIEWPORT_FLAG_TRANSPARENT_BACKGROUND;
         }
 
-        dpi = CreateDPI(viewport);
-
-        RenderViewport(nullptr, viewport, dpi);
-        WriteDpiToFile(path->c_str(), &dpi, gPalette);
+        RenderViewportToFile(viewport, *path, gPalette);
 
         // Show user that screenshot saved successfully
         Formatter ft;
@@ -425,8 +525,6 @@ void screenshot_giant()
         log_error("%s", e.what());
         context_show_error(STR_SCREENSHOT_FAILED, STR_NONE, {});
     }
-
-    ReleaseDPI(dpi);
 }
 
 // TODO: Move this at some point into a more appropriate place.
@@ -619,7 +717,6 @@ int32_t cmdline_for_screenshot(const char** argv, int32_t argc, ScreenshotOption
     }
 
     int32_t exitCode = 1;
-    rct_drawpixelinfo dpi;
     try
     {
         core_init();
@@ -721,17 +818,13 @@ int32_t cmdline_for_screenshot(const char** argv, int32_t argc, ScreenshotOption
 
         ApplyOptions(options, viewport);
 
-        dpi = CreateDPI(viewport);
-
-        RenderViewport(nullptr, viewport, dpi);
-        WriteDpiToFile(outputPath, &dpi, gPalette);
+        RenderViewportToFile(viewport, outputPath, gPalette);
     }
     catch (const std::exception& e)
     {
         std::printf("%s\n", e.what());
         exitCode = -1;
     }
-    ReleaseDPI(dpi);
 
     drawing_engine_dispose();
 
@@ -820,10 +913,14 @@ void CaptureImage(const CaptureOptions& options)
     }
 
     auto outputPath = ResolveFilenameForCapture(options.Filename);
-    auto dpi = CreateDPI(viewport);
-    RenderViewport(nullptr, viewport, dpi);
-    WriteDpiToFile(outputPath, &dpi, gPalette);
-    ReleaseDPI(dpi);
+    try
+    {
+        RenderViewportToFile(viewport, outputPath, gPalette);
+    }
+    catch (const std::exception& e)
+    {
+        log_error("Unable to write png: %s", e.what());
+    }
 
     gCurrentRotation = backupRotation;
 }
@@ -56,6 +56,7 @@ void screenshot_check();
 std::string screenshot_dump();
 std::string screenshot_dump_png(rct_drawpixelinfo* dpi);
 std::string screenshot_dump_png_32bpp(int32_t width, int32_t height, const void* pixels);
+void screenshot_wait_for_pending();
 
 void screenshot_giant();
 int32_t cmdline_for_screenshot(const char** argv, int32_t argc, ScreenshotOptions* options);
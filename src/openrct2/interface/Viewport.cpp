@@ -16,6 +16,7 @@
 #include "../config/Config.h"
 #include "../core/Guard.hpp"
 #include "../core/JobPool.h"
+#include "../core/Trace.h"
 #include "../drawing/Drawing.h"
 #include "../drawing/IDrawingEngine.h"
 #include "../paint/Paint.h"
@@ -33,8 +34,10 @@
 #include "Window_internal.h"
 
 #include <algorithm>
+#include <chrono>
 #include <cstring>
 #include <list>
+#include <numeric>
 
 using namespace OpenRCT2;
 
@@ -48,6 +51,30 @@ rct_viewport* g_music_tracking_viewport;
 
 static std::unique_ptr<JobPool> _paintJobs;
 static std::vector<paint_session*> _paintColumns;
+static std::vector<PaintTimings> _paintColumnTimings;
+// Paint structs each column of the last painted view needed, by column from the left. Columns are filled in the order
+// of their previous cost so dense columns start first and do not hold up the frame when handed out last.
+static std::vector<size_t> _paintColumnCosts;
+static std::vector<size_t> _paintColumnFillOrder;
+
+// The columns generated since viewport_paint_cache_begin, drawn again when another viewport paints the very same
+// column. Columns are only shared when they match exactly, as the order of overlapping paint structs depends on the
+// other paint structs of the column.
+struct CachedPaintColumn
+{
+    int16_t X;
+    int16_t Y;
+    int16_t Width;
+    int16_t Height;
+    ZoomLevel Zoom;
+    uint32_t ViewFlags;
+    paint_session* Session;
+};
+static constexpr size_t MaxCachedPaintColumns = 256;
+static std::vector<CachedPaintColumn> _cachedPaintColumns;
+static bool _paintCacheActive;
+
+PaintTimings* gPaintTimings;
 
 ScreenCoordsXY gSavedView;
 ZoomLevel gSavedViewZoom;
@@ -716,10 +743,12 @@ viewport_focus viewport_update_smart_guest_follow(rct_window* window, Peep* peep
     else
     {
         bool overallFocus = true;
-        if (peep->State == PeepState::OnRide || peep->State == PeepState::EnteringRide
-            || (peep->State == PeepState::LeavingRide && peep->x == LOCATION_NULL))
+        bool onRide = peep->State == PeepState::OnRide || peep->State == PeepState::EnteringRide
+            || (peep->State == PeepState::LeavingRide && peep->x == LOCATION_NULL);
+        // Guests walking around the park are followed directly, the ride is only needed while they are on or in it
+        auto ride = (onRide || peep->x == LOCATION_NULL) ? get_ride(peep->CurrentRide) : nullptr;
+        if (onRide)
         {
-            auto ride = get_ride(peep->CurrentRide);
             if (ride != nullptr && (ride->lifecycle_flags & RIDE_LIFECYCLE_ON_TRACK))
             {
                 auto train = GetEntity<Vehicle>(ride->vehicles[peep->CurrentTrain]);
@@ -736,7 +765,6 @@ viewport_focus viewport_update_smart_guest_follow(rct_window* window, Peep* peep
         }
         if (peep->x == LOCATION_NULL && overallFocus)
         {
-            auto ride = get_ride(peep->CurrentRide);
             if (ride != nullptr)
             {
                 auto xy = ride->overall_view.ToTileCentre();
@@ -856,31 +884,45 @@ static void record_session(const paint_session* session, std::vector<paint_sessi
     paint_session* session_copy = &recorded_sessions->at(record_index);
 
     // Mind the offset needs to be calculated against the original `session`, not `session_copy`
+    auto getIndex = [session](const paint_struct* ps) {
+        return session->PaintStructs.index_of(reinterpret_cast<const paint_entry*>(ps));
+    };
     for (auto& ps : session_copy->PaintStructs)
     {
         ps.basic.next_quadrant_ps = reinterpret_cast<paint_struct*>(
-            ps.basic.next_quadrant_ps ? int(ps.basic.next_quadrant_ps - &session->PaintStructs[0].basic)
-                                      : std::size(session->PaintStructs));
+            ps.basic.next_quadrant_ps ? getIndex(ps.basic.next_quadrant_ps) : std::size(session->PaintStructs));
     }
     for (auto& quad : session_copy->Quadrants)
     {
-        quad = reinterpret_cast<paint_struct*>(
-            quad ? int(quad - &session->PaintStructs[0].basic) : std::size(session->Quadrants));
+        quad = reinterpret_cast<paint_struct*>(quad ? getIndex(quad) : std::size(session->Quadrants));
     }
 }
 
-static void viewport_fill_column(paint_session* session, std::vector<paint_session>* recorded_sessions, size_t record_index)
+static void viewport_fill_column(
+    paint_session* session, std::vector<paint_session>* recorded_sessions, size_t record_index, PaintTimings* timings)
 {
+    TRACE_ZONE("Paint column fill");
+    auto startTime = std::chrono::high_resolution_clock::now();
     PaintSessionGenerate(session);
     if (recorded_sessions != nullptr)
     {
         record_session(session, recorded_sessions, record_index);
     }
+    auto arrangeStartTime = std::chrono::high_resolution_clock::now();
     PaintSessionArrange(session);
+
+    if (timings != nullptr)
+    {
+        timings->Generate += arrangeStartTime - startTime;
+        timings->Arrange += std::chrono::high_resolution_clock::now() - arrangeStartTime;
+        timings->PaintStructs += session->PaintStructs.size();
+        timings->PeakPaintStructs = std::max<uint32_t>(timings->PeakPaintStructs, session->PaintStructs.size());
+    }
 }
 
 static void viewport_paint_column(paint_session* session)
 {
+    TRACE_ZONE("Paint column draw");
     if (session->ViewFlags
             & (VIEWPORT_FLAG_HIDE_VERTICAL | VIEWPORT_FLAG_HIDE_BASE | VIEWPORT_FLAG_UNDERGROUND_INSIDE
                | VIEWPORT_FLAG_CLIP_VIEW)
@@ -894,6 +936,7 @@ static void viewport_paint_column(paint_session* session)
         gfx_clear(&session->DPI, colour);
     }
 
+    auto startTime = std::chrono::high_resolution_clock::now();
     PaintDrawStructs(session);
 
     if (gConfigGeneral.render_weather_gloom && !gTrackDesignSaveMode && !(session->ViewFlags & VIEWPORT_FLAG_INVISIBLE_SPRITES)
@@ -907,7 +950,11 @@ static void viewport_paint_column(paint_session* session)
         PaintDrawMoneyStructs(&session->DPI, session->PSStringHead);
     }
 
-    PaintSessionFree(session);
+    if (gPaintTimings != nullptr)
+    {
+        gPaintTimings->Draw += std::chrono::high_resolution_clock::now() - startTime;
+        gPaintTimings->Columns++;
+    }
 }
 
 /**
@@ -983,12 +1030,10 @@ void viewport_paint(
     }
 
     // Splits the area into 32 pixel columns and renders them
+    size_t firstColumnToFill = 0;
     for (x = alignedX; x < rightBorder; x += 32, index++)
     {
-        paint_session* session = PaintSessionAlloc(&dpi1, viewFlags);
-        _paintColumns.push_back(session);
-
-        rct_drawpixelinfo& dpi2 = session->DPI;
+        rct_drawpixelinfo dpi2 = dpi1;
         if (x >= dpi2.x)
         {
             int16_t leftPitch = x - dpi2.x;
@@ -1007,28 +1052,116 @@ void viewport_paint(
         }
         dpi2.width = paintRight - dpi2.x;
 
-        if (useMultithreading)
+        // Columns another viewport already generated are only drawn, they are kept in front of the columns to fill
+        auto* cachedSession = recorded_sessions == nullptr ? viewport_paint_cache_find(dpi2, viewFlags) : nullptr;
+        if (cachedSession != nullptr)
         {
-            _paintJobs->AddTask(
-                [session, recorded_sessions, index]() -> void { viewport_fill_column(session, recorded_sessions, index); });
+            cachedSession->DPI = dpi2;
+            _paintColumns.insert(_paintColumns.begin() + firstColumnToFill, cachedSession);
+            firstColumnToFill++;
+            continue;
         }
-        else
+
+        paint_session* session = PaintSessionAlloc(&dpi2, viewFlags);
+        _paintColumns.push_back(session);
+
+        if (!useMultithreading)
         {
-            viewport_fill_column(session, recorded_sessions, index);
+            viewport_fill_column(session, recorded_sessions, index, gPaintTimings);
         }
     }
 
     if (useMultithreading)
     {
-        _paintJobs->Join();
+        // Each column is timed on its own, so the jobs do not have to share the timings
+        const size_t numColumnsToFill = _paintColumns.size() - firstColumnToFill;
+        _paintColumnTimings.assign(gPaintTimings != nullptr ? numColumnsToFill : 0, {});
+        auto getCostIndex = [alignedX, firstColumnToFill](size_t columnIndex) {
+            return static_cast<size_t>((_paintColumns[firstColumnToFill + columnIndex]->DPI.x - alignedX) / 32);
+        };
+        auto getPreviousCost = [getCostIndex](size_t columnIndex) {
+            auto costIndex = getCostIndex(columnIndex);
+            return costIndex < _paintColumnCosts.size() ? _paintColumnCosts[costIndex] : 0;
+        };
+        _paintColumnFillOrder.resize(numColumnsToFill);
+        std::iota(_paintColumnFillOrder.begin(), _paintColumnFillOrder.end(), 0);
+        std::stable_sort(
+            _paintColumnFillOrder.begin(), _paintColumnFillOrder.end(),
+            [getPreviousCost](size_t a, size_t b) { return getPreviousCost(a) > getPreviousCost(b); });
+
+        _paintJobs->ParallelFor(0, numColumnsToFill, 1, [recorded_sessions, firstColumnToFill](size_t orderIndex) {
+            auto columnIndex = _paintColumnFillOrder[orderIndex];
+            auto* timings = columnIndex < _paintColumnTimings.size() ? &_paintColumnTimings[columnIndex] : nullptr;
+            viewport_fill_column(_paintColumns[firstColumnToFill + columnIndex], recorded_sessions, columnIndex, timings);
+        });
+
+        for (size_t columnIndex = 0; columnIndex < numColumnsToFill; columnIndex++)
+        {
+            auto costIndex = getCostIndex(columnIndex);
+            if (costIndex >= _paintColumnCosts.size())
+            {
+                _paintColumnCosts.resize(costIndex + 1);
+            }
+            _paintColumnCosts[costIndex] = _paintColumns[firstColumnToFill + columnIndex]->PaintStructs.size();
+        }
+        for (const auto& timings : _paintColumnTimings)
+        {
+            gPaintTimings->Generate += timings.Generate;
+            gPaintTimings->Arrange += timings.Arrange;
+            gPaintTimings->PaintStructs += timings.PaintStructs;
+            gPaintTimings->PeakPaintStructs = std::max(gPaintTimings->PeakPaintStructs, timings.PeakPaintStructs);
+        }
     }
 
-    for (auto column : _paintColumns)
+    for (size_t i = 0; i < _paintColumns.size(); i++)
     {
+        auto* column = _paintColumns[i];
         viewport_paint_column(column);
+        if (i < firstColumnToFill)
+        {
+            continue;
+        }
+        if (_paintCacheActive && recorded_sessions == nullptr && _cachedPaintColumns.size() < MaxCachedPaintColumns)
+        {
+            const auto& columnDPI = column->DPI;
+            _cachedPaintColumns.push_back(
+                { columnDPI.x, columnDPI.y, columnDPI.width, columnDPI.height, columnDPI.zoom_level, viewFlags, column });
+        }
+        else
+        {
+            PaintSessionFree(column);
+        }
     }
 }
 
+void viewport_paint_cache_begin()
+{
+    _paintCacheActive = true;
+}
+
+void viewport_paint_cache_end()
+{
+    for (const auto& column : _cachedPaintColumns)
+    {
+        PaintSessionFree(column.Session);
+    }
+    _cachedPaintColumns.clear();
+    _paintCacheActive = false;
+}
+
+paint_session* viewport_paint_cache_find(const rct_drawpixelinfo& dpi, uint32_t viewFlags)
+{
+    for (const auto& column : _cachedPaintColumns)
+    {
+        if (column.X == dpi.x && column.Y == dpi.y && column.Width == dpi.width && column.Height == dpi.height
+            && column.Zoom == dpi.zoom_level && column.ViewFlags == viewFlags)
+        {
+            return column.Session;
+        }
+    }
+    return nullptr;
+}
+
 static void viewport_paint_weather_gloom(rct_drawpixelinfo* dpi)
 {
     auto paletteId = climate_get_weather_gloom_palette_id(gClimateCurrent);
@@ -1702,6 +1835,15 @@ InteractionInfo get_map_coordinates_from_pos_window(rct_window* window, const Sc
  */
 void viewport_invalidate(const rct_viewport* viewport, int32_t left, int32_t top, int32_t right, int32_t bottom)
 {
+    int32_t viewportLeft = viewport->viewPos.x;
+    int32_t viewportTop = viewport->viewPos.y;
+    int32_t viewportRight = viewport->viewPos.x + viewport->view_width;
+    int32_t viewportBottom = viewport->viewPos.y + viewport->view_height;
+
+    // Most invalidations are for entities that are not in view, reject them before looking up the window
+    if (right <= viewportLeft || bottom <= viewportTop || left >= viewportRight || top >= viewportBottom)
+        return;
+
     // if unknown viewport visibility, use the containing window to discover the status
     if (viewport->visibility == VisibilityCache::Unknown)
     {
@@ -1720,32 +1862,25 @@ void viewport_invalidate(const rct_viewport* viewport, int32_t left, int32_t top
     if (viewport->visibility == VisibilityCache::Covered)
         return;
 
-    int32_t viewportLeft = viewport->viewPos.x;
-    int32_t viewportTop = viewport->viewPos.y;
-    int32_t viewportRight = viewport->viewPos.x + viewport->view_width;
-    int32_t viewportBottom = viewport->viewPos.y + viewport->view_height;
-    if (right > viewportLeft && bottom > viewportTop)
-    {
-        left = std::max(left, viewportLeft);
-        top = std::max(top, viewportTop);
-        right = std::min(right, viewportRight);
-        bottom = std::min(bottom, viewportBottom);
-
-        left -= viewportLeft;
-        top -= viewportTop;
-        right -= viewportLeft;
-        bottom -= viewportTop;
-        left = left / viewport->zoom;
-        top = top / viewport->zoom;
-        right = right / viewport->zoom;
-        bottom = bottom / viewport->zoom;
-        left += viewport->pos.x;
-        top += viewport->pos.y;
-        right += viewport->pos.x;
-        bottom += viewport->pos.y;
-
-        gfx_set_dirty_blocks({ { left, top }, { right, bottom } });
-    }
+    left = std::max(left, viewportLeft);
+    top = std::max(top, viewportTop);
+    right = std::min(right, viewportRight);
+    bottom = std::min(bottom, viewportBottom);
+
+    left -= viewportLeft;
+    top -= viewportTop;
+    right -= viewportLeft;
+    bottom -= viewportTop;
+    left = left / viewport->zoom;
+    top = top / viewport->zoom;
+    right = right / viewport->zoom;
+    bottom = bottom / viewport->zoom;
+    left += viewport->pos.x;
+    top += viewport->pos.y;
+    right += viewport->pos.x;
+    bottom += viewport->pos.y;
+
+    gfx_set_dirty_blocks({ { left, top }, { right, bottom } });
 }
 
 static rct_viewport* viewport_find_from_point(const ScreenCoordsXY& screenCoords)
@@ -13,6 +13,7 @@
 #include "../world/Location.hpp"
 #include "Window.h"
 
+#include <chrono>
 #include <limits>
 #include <optional>
 #include <vector>
@@ -121,6 +122,31 @@ void viewport_paint(
     const rct_viewport* viewport, rct_drawpixelinfo* dpi, int16_t left, int16_t top, int16_t right, int16_t bottom,
     std::vector<paint_session>* sessions = nullptr);
 
+/**
+ * Between begin and end, the columns generated by viewport_paint are kept so viewports painting the exact same column
+ * (position, size, zoom and view flags) draw them rather than generating them again. The game state must not change in
+ * between, end releases the columns.
+ */
+void viewport_paint_cache_begin();
+void viewport_paint_cache_end();
+paint_session* viewport_paint_cache_find(const rct_drawpixelinfo& dpi, uint32_t viewFlags);
+
+// Time spent in each stage of painting viewports, summed over every column painted while gPaintTimings points at it
+struct PaintTimings
+{
+    std::chrono::duration<double> Generate{};
+    std::chrono::duration<double> Arrange{};
+    std::chrono::duration<double> Draw{};
+    uint32_t Columns{};
+    uint64_t PaintStructs{};
+    // The most paint structs a single column needed, each can have up to MAX_PAINT_STRUCTS
+    uint32_t PeakPaintStructs{};
+};
+
+// When the columns are painted on the job pool, generating and arranging are timed per column and summed, so the
+// times add up to more than the time that passed
+extern PaintTimings* gPaintTimings;
+
 CoordsXYZ viewport_adjust_for_map_height(const ScreenCoordsXY& startCoords);
 
 CoordsXY viewport_coord_to_map_coord(const ScreenCoordsXY& coords, int32_t z);
@@ -34,10 +34,12 @@
 #include "Window_internal.h"
 
 #include <algorithm>
+#include <bitset>
 #include <cmath>
 #include <functional>
 #include <iterator>
 #include <list>
+#include <unordered_set>
 
 std::list<std::shared_ptr<rct_window>> g_window_list;
 rct_window* gWindowAudioExclusive;
@@ -50,6 +52,11 @@ int32_t gTextBoxFrameNo = 0;
 bool gUsingWidgetTextBox = false;
 TextInputSession* gTextInput;
 
+// Invalidation requests by class and number are collected and applied once per frame
+static bool _invalidateAllPending;
+static std::bitset<std::numeric_limits<rct_windowclass>::max() + 1> _invalidateClassesPending;
+static std::unordered_set<uint32_t> _invalidateNumbersPending;
+
 uint16_t gWindowUpdateTicks;
 uint16_t gWindowMapFlashingFlags;
 colour_t gCurrentWindowColours[4];
@@ -155,6 +162,8 @@ void window_update_all()
 
     auto windowManager = OpenRCT2::GetContext()->GetUiContext()->GetWindowManager();
     windowManager->UpdateMouseWheel();
+
+    window_flush_invalidations();
 }
 
 static void window_close_surplus(int32_t cap, int8_t avoid_classification)
@@ -459,14 +468,9 @@ rct_widgetindex window_find_widget_from_point(rct_window* w, const ScreenCoordsX
  *
  * @param window The window to invalidate (esi).
  */
-template<typename _TPred> static void window_invalidate_by_condition(_TPred pred)
+static uint32_t window_get_invalidation_key(rct_windowclass cls, rct_windownumber number)
 {
-    window_visit_each([pred](rct_window* w) {
-        if (pred(w))
-        {
-            w->Invalidate();
-        }
-    });
+    return (static_cast<uint32_t>(cls) << 16) | number;
 }
 
 /**
@@ -476,7 +480,7 @@ template<typename _TPred> static void window_invalidate_by_condition(_TPred pred
  */
 void window_invalidate_by_class(rct_windowclass cls)
 {
-    window_invalidate_by_condition([cls](rct_window* w) -> bool { return w->classification == cls; });
+    _invalidateClassesPending.set(cls);
 }
 
 /**
@@ -485,8 +489,10 @@ void window_invalidate_by_class(rct_windowclass cls)
  */
 void window_invalidate_by_number(rct_windowclass cls, rct_windownumber number)
 {
-    window_invalidate_by_condition(
-        [cls, number](rct_window* w) -> bool { return w->classification == cls && w->number == number; });
+    if (!_invalidateClassesPending.test(cls))
+    {
+        _invalidateNumbersPending.insert(window_get_invalidation_key(cls, number));
+    }
 }
 
 /**
@@ -494,7 +500,34 @@ void window_invalidate_by_number(rct_windowclass cls, rct_windownumber number)
  */
 void window_invalidate_all()
 {
-    window_visit_each([](rct_window* w) { w->Invalidate(); });
+    _invalidateAllPending = true;
+}
+
+/**
+ * Applies the invalidation requests made since the last call, each window is invalidated at most once and at its
+ * current position. Must be called before the dirty regions are drawn.
+ */
+void window_flush_invalidations()
+{
+    if (!_invalidateAllPending && _invalidateClassesPending.none() && _invalidateNumbersPending.empty())
+    {
+        return;
+    }
+
+    // Invalidating does not change the window list, no need for a copy
+    for (auto& w : g_window_list)
+    {
+        if (_invalidateAllPending || _invalidateClassesPending.test(w->classification)
+            || (!_invalidateNumbersPending.empty()
+                && _invalidateNumbersPending.count(window_get_invalidation_key(w->classification, w->number)) != 0))
+        {
+            w->Invalidate();
+        }
+    }
+
+    _invalidateAllPending = false;
+    _invalidateClassesPending.reset();
+    _invalidateNumbersPending.clear();
 }
 
 /**
@@ -9,9 +9,11 @@
 
 #include "Formatting.h"
 
+#include "../Context.h"
 #include "../config/Config.h"
 #include "../util/Util.h"
 #include "Localisation.h"
+#include "LocalisationService.h"
 #include "StringIds.h"
 
 #include <cmath>
@@ -81,6 +83,15 @@ namespace OpenRCT2
 
     FmtString::iterator::iterator(std::string_view s, size_t i)
         : str(s)
+        , tokens(nullptr)
+        , index(i)
+    {
+        update();
+    }
+
+    FmtString::iterator::iterator(std::string_view s, const compiled_tokens* t, size_t i)
+        : str(s)
+        , tokens(t)
         , index(i)
     {
         update();
@@ -88,6 +99,21 @@ namespace OpenRCT2
 
     void FmtString::iterator::update()
     {
+        if (tokens != nullptr)
+        {
+            // In compiled mode the index is into the tokens rather than the string
+            if (index < tokens->size())
+            {
+                const auto& t = (*tokens)[index];
+                current = token(t.kind, str.substr(t.offset, t.length), t.parameter);
+            }
+            else
+            {
+                current = token();
+            }
+            return;
+        }
+
         auto i = index;
         if (i >= str.size())
         {
@@ -202,9 +228,9 @@ namespace OpenRCT2
 
     FmtString::iterator& FmtString::iterator::operator++()
     {
-        if (index < str.size())
+        if (!eol())
         {
-            index += current.text.size();
+            index += tokens != nullptr ? 1 : current.text.size();
             update();
         }
         return *this;
@@ -213,17 +239,13 @@ namespace OpenRCT2
     FmtString::iterator FmtString::iterator::operator++(int)
     {
         auto result = *this;
-        if (index < str.size())
-        {
-            index += current.text.size();
-            update();
-        }
+        ++(*this);
         return result;
     }
 
     bool FmtString::iterator::eol() const
     {
-        return index >= str.size();
+        return index >= (tokens != nullptr ? tokens->size() : str.size());
     }
 
     FmtString::FmtString(std::string&& s)
@@ -242,14 +264,32 @@ namespace OpenRCT2
     {
     }
 
+    FmtString::FmtString(std::string_view s, const compiled_tokens& tokens)
+        : _str(s)
+        , _tokens(&tokens)
+    {
+    }
+
     FmtString::iterator FmtString::begin() const
     {
-        return iterator(_str, 0);
+        return iterator(_str, _tokens, 0);
     }
 
     FmtString::iterator FmtString::end() const
     {
-        return iterator(_str, _str.size());
+        return iterator(_str, _tokens, _tokens != nullptr ? _tokens->size() : _str.size());
+    }
+
+    FmtString::compiled_tokens FmtString::Compile(std::string_view s)
+    {
+        compiled_tokens result;
+        for (const auto& t : FmtString(s))
+        {
+            auto offset = static_cast<uint32_t>(t.text.data() - s.data());
+            result.push_back({ t.kind, t.parameter, offset, static_cast<uint32_t>(t.text.size()) });
+        }
+        result.shrink_to_fit();
+        return result;
     }
 
     std::string FmtString::WithoutFormatTokens() const
@@ -626,8 +666,8 @@ namespace OpenRCT2
 
     FmtString GetFmtStringById(rct_string_id id)
     {
-        auto fmtc = language_get_string(id);
-        return FmtString(fmtc);
+        const auto& localisationService = GetContext()->GetLocalisationService();
+        return localisationService.GetFmtString(id);
     }
 
     FormatBuffer& GetThreadFormatStream()
@@ -149,10 +149,6 @@ namespace OpenRCT2
 
     class FmtString
     {
-    private:
-        std::string_view _str;
-        std::string _strOwned;
-
     public:
         struct token
         {
@@ -167,10 +163,30 @@ namespace OpenRCT2
             codepoint_t GetCodepoint() const;
         };
 
+        /**
+         * A token of a pre-tokenised string, the text is referred to by offset so the owner of the string is free to
+         * move it.
+         */
+        struct compiled_token
+        {
+            FormatToken kind{};
+            uint32_t parameter{};
+            uint32_t offset{};
+            uint32_t length{};
+        };
+        using compiled_tokens = std::vector<compiled_token>;
+
+    private:
+        std::string_view _str;
+        std::string _strOwned;
+        const compiled_tokens* _tokens{};
+
+    public:
         struct iterator
         {
         private:
             std::string_view str;
+            const compiled_tokens* tokens;
             size_t index;
             token current;
 
@@ -178,6 +194,7 @@ namespace OpenRCT2
 
         public:
             iterator(std::string_view s, size_t i);
+            iterator(std::string_view s, const compiled_tokens* t, size_t i);
             bool operator==(iterator& rhs);
             bool operator!=(iterator& rhs);
             token CreateToken(size_t len);
@@ -192,10 +209,18 @@ namespace OpenRCT2
         FmtString(std::string&& s);
         FmtString(std::string_view s);
         FmtString(const char* s);
+
+        /**
+         * Iterates the given tokens of s instead of parsing it, the tokens must outlive the FmtString.
+         */
+        FmtString(std::string_view s, const compiled_tokens& tokens);
+
         iterator begin() const;
         iterator end() const;
 
         std::string WithoutFormatTokens() const;
+
+        static compiled_tokens Compile(std::string_view s);
     };
 
     template<typename T> void FormatArgument(FormatBuffer& ss, FormatToken token, T arg);
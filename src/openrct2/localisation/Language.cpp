@@ -13,6 +13,7 @@
 #include "../interface/FontFamilies.h"
 #include "../interface/Fonts.h"
 #include "../object/ObjectManager.h"
+#include "../peep/Peep.h"
 #include "../platform/platform.h"
 #include "LanguagePack.h"
 #include "Localisation.h"
@@ -81,6 +82,7 @@ bool language_open(int32_t id)
         localisationService.OpenLanguage(id);
         // Objects and their localised strings need to be refreshed
         objectManager.ResetObjects();
+        peep_name_cache_invalidate();
         return true;
     }
     catch (const std::exception&)
@@ -10,16 +10,16 @@
 #include "LanguagePack.h"
 
 #include "../common.h"
-#include "../core/FileStream.h"
-#include "../core/Memory.hpp"
+#include "../core/MemoryMappedFileStream.h"
 #include "../core/RTL.h"
 #include "../core/String.hpp"
-#include "../core/StringBuilder.h"
-#include "../core/StringReader.h"
 #include "Language.h"
 #include "Localisation.h"
 
 #include <algorithm>
+#include <atomic>
+#include <deque>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -34,29 +34,50 @@ constexpr int32_t ObjectOverrideMaxStringCount = 3;
 constexpr rct_string_id ScenarioOverrideBase = 0x7000;
 constexpr int32_t ScenarioOverrideMaxStringCount = 3;
 
+/**
+ * A string in the language file. The text stays where it is in the loaded file until the string is first requested,
+ * at which point it is copied out (with RTL fixes applied) and tokenised.
+ */
+struct LazyString
+{
+    std::string_view Source;
+    mutable std::atomic<bool> Materialised{};
+    mutable std::string Value;
+    mutable OpenRCT2::FmtString::compiled_tokens Tokens;
+};
+
 struct ObjectOverride
 {
     char name[8] = { 0 };
-    std::string strings[ObjectOverrideMaxStringCount];
+    LazyString strings[ObjectOverrideMaxStringCount];
 };
 
 struct ScenarioOverride
 {
     std::string filename;
-    std::string strings[ScenarioOverrideMaxStringCount];
+    LazyString strings[ScenarioOverrideMaxStringCount];
 };
 
 class LanguagePack final : public ILanguagePack
 {
 private:
     uint16_t const _id;
-    std::vector<std::string> _strings;
-    std::vector<ObjectOverride> _objectOverrides;
-    std::vector<ScenarioOverride> _scenarioOverrides;
+    // Either the mapped language file or a copy of the given text, indexed by the string table below
+    std::unique_ptr<OpenRCT2::MemoryMappedFileStream> _file;
+    std::string _text;
+    std::unique_ptr<LazyString[]> _strings;
+    uint32_t _stringCount{};
+    // Deques so that the overrides do not move once created
+    std::deque<ObjectOverride> _objectOverrides;
+    std::deque<ScenarioOverride> _scenarioOverrides;
+    mutable std::mutex _materialiseMutex;
 
     ///////////////////////////////////////////////////////////////////////////
     // Parsing work data
     ///////////////////////////////////////////////////////////////////////////
+    std::string_view _parseText;
+    size_t _parsePosition{};
+    std::vector<std::string_view> _parseStrings;
     std::string _currentGroup;
     ObjectOverride* _currentObjectOverride = nullptr;
     ScenarioOverride* _currentScenarioOverride = nullptr;
@@ -66,34 +87,23 @@ public:
     {
         Guard::ArgumentNotNull(path);
 
-        // Load file directly into memory
-        utf8* fileData = nullptr;
+        // Map the file into memory, strings are only copied out of it when they are used
+        std::unique_ptr<OpenRCT2::MemoryMappedFileStream> file;
         try
         {
-            OpenRCT2::FileStream fs = OpenRCT2::FileStream(path, OpenRCT2::FILE_MODE_OPEN);
-
-            size_t fileLength = static_cast<size_t>(fs.GetLength());
-            if (fileLength > MAX_LANGUAGE_SIZE)
+            file = std::make_unique<OpenRCT2::MemoryMappedFileStream>(path);
+            if (file->GetLength() > MAX_LANGUAGE_SIZE)
             {
                 throw IOException("Language file too large.");
             }
-
-            fileData = Memory::Allocate<utf8>(fileLength + 1);
-            fs.Read(fileData, fileLength);
-            fileData[fileLength] = '\0';
         }
         catch (const std::exception& ex)
         {
-            Memory::Free(fileData);
             log_error("Unable to open %s: %s", path, ex.what());
             return nullptr;
         }
 
-        // Parse the memory as text
-        LanguagePack* result = FromText(id, fileData);
-
-        Memory::Free(fileData);
-        return result;
+        return new LanguagePack(id, std::move(file));
     }
 
     static LanguagePack* FromText(uint16_t id, const utf8* text)
@@ -106,16 +116,17 @@ public:
     {
         Guard::ArgumentNotNull(text);
 
-        auto reader = UTF8StringReader(text);
-        while (reader.CanRead())
-        {
-            ParseLine(&reader);
-        }
+        _text = text;
+        Parse(_text);
+    }
 
-        // Clean up the parsing work data
-        _currentGroup = std::string();
-        _currentObjectOverride = nullptr;
-        _currentScenarioOverride = nullptr;
+    LanguagePack(uint16_t id, std::unique_ptr<OpenRCT2::MemoryMappedFileStream> file)
+        : _id(id)
+        , _file(std::move(file))
+    {
+        auto length = static_cast<size_t>(_file->GetLength());
+        auto data = static_cast<const char*>(_file->GetData());
+        Parse(data != nullptr ? std::string_view(data, length) : std::string_view());
     }
 
     uint16_t GetId() const override
@@ -125,70 +136,51 @@ public:
 
     uint32_t GetCount() const override
     {
-        return static_cast<uint32_t>(_strings.size());
+        return _stringCount;
     }
 
     void RemoveString(rct_string_id stringId) override
     {
-        if (_strings.size() >= static_cast<size_t>(stringId))
+        if (_stringCount > static_cast<size_t>(stringId))
         {
-            _strings[stringId] = std::string();
+            SetLazyString(_strings[stringId], std::string());
         }
     }
 
     void SetString(rct_string_id stringId, const std::string& str) override
     {
-        if (_strings.size() >= static_cast<size_t>(stringId))
+        if (_stringCount > static_cast<size_t>(stringId))
         {
-            _strings[stringId] = str;
+            SetLazyString(_strings[stringId], str);
         }
     }
 
     const utf8* GetString(rct_string_id stringId) const override
     {
-        if (stringId >= ScenarioOverrideBase)
+        auto lazyString = GetLazyString(stringId);
+        if (lazyString != nullptr)
         {
-            int32_t offset = stringId - ScenarioOverrideBase;
-            int32_t ooIndex = offset / ScenarioOverrideMaxStringCount;
-            int32_t ooStringIndex = offset % ScenarioOverrideMaxStringCount;
-
-            if (_scenarioOverrides.size() > static_cast<size_t>(ooIndex)
-                && !_scenarioOverrides[ooIndex].strings[ooStringIndex].empty())
-            {
-                return _scenarioOverrides[ooIndex].strings[ooStringIndex].c_str();
-            }
-            else
+            const auto& value = Materialise(*lazyString).Value;
+            if (!value.empty())
             {
-                return nullptr;
+                return value.c_str();
             }
         }
-        else if (stringId >= ObjectOverrideBase)
-        {
-            int32_t offset = stringId - ObjectOverrideBase;
-            int32_t ooIndex = offset / ObjectOverrideMaxStringCount;
-            int32_t ooStringIndex = offset % ObjectOverrideMaxStringCount;
+        return nullptr;
+    }
 
-            if (_objectOverrides.size() > static_cast<size_t>(ooIndex)
-                && !_objectOverrides[ooIndex].strings[ooStringIndex].empty())
-            {
-                return _objectOverrides[ooIndex].strings[ooStringIndex].c_str();
-            }
-            else
-            {
-                return nullptr;
-            }
-        }
-        else
+    const OpenRCT2::FmtString::compiled_tokens* GetCompiledString(rct_string_id stringId) const override
+    {
+        // Object and scenario overrides are rarely formatted, only the main strings are tokenised
+        if (_stringCount > static_cast<size_t>(stringId))
         {
-            if ((_strings.size() > static_cast<size_t>(stringId)) && !_strings[stringId].empty())
-            {
-                return _strings[stringId].c_str();
-            }
-            else
+            const auto& lazyString = Materialise(_strings[stringId]);
+            if (!lazyString.Value.empty())
             {
-                return nullptr;
+                return &lazyString.Tokens;
             }
         }
+        return nullptr;
     }
 
     rct_string_id GetObjectOverrideStringId(std::string_view legacyIdentifier, uint8_t index) override
@@ -200,7 +192,7 @@ public:
         {
             if (std::string_view(objectOverride.name, 8) == legacyIdentifier)
             {
-                if (objectOverride.strings[index].empty())
+                if (objectOverride.strings[index].Source.empty())
                 {
                     return STR_NONE;
                 }
@@ -222,7 +214,7 @@ public:
         {
             if (String::Equals(scenarioOverride.filename.c_str(), scenarioFilename, true))
             {
-                if (scenarioOverride.strings[index].empty())
+                if (scenarioOverride.strings[index].Source.empty())
                 {
                     return STR_NONE;
                 }
@@ -235,6 +227,67 @@ public:
     }
 
 private:
+    const LazyString* GetLazyString(rct_string_id stringId) const
+    {
+        if (stringId >= ScenarioOverrideBase)
+        {
+            int32_t offset = stringId - ScenarioOverrideBase;
+            int32_t ooIndex = offset / ScenarioOverrideMaxStringCount;
+            int32_t ooStringIndex = offset % ScenarioOverrideMaxStringCount;
+            if (_scenarioOverrides.size() > static_cast<size_t>(ooIndex))
+            {
+                return &_scenarioOverrides[ooIndex].strings[ooStringIndex];
+            }
+        }
+        else if (stringId >= ObjectOverrideBase)
+        {
+            int32_t offset = stringId - ObjectOverrideBase;
+            int32_t ooIndex = offset / ObjectOverrideMaxStringCount;
+            int32_t ooStringIndex = offset % ObjectOverrideMaxStringCount;
+            if (_objectOverrides.size() > static_cast<size_t>(ooIndex))
+            {
+                return &_objectOverrides[ooIndex].strings[ooStringIndex];
+            }
+        }
+        else if (_stringCount > static_cast<size_t>(stringId))
+        {
+            return &_strings[stringId];
+        }
+        return nullptr;
+    }
+
+    /**
+     * Copies the string out of the language file the first time it is requested. Strings can be requested from the
+     * paint threads, so the copy is made under a lock and published with the materialised flag.
+     */
+    const LazyString& Materialise(const LazyString& lazyString) const
+    {
+        if (!lazyString.Materialised.load(std::memory_order_acquire))
+        {
+            std::lock_guard<std::mutex> lock(_materialiseMutex);
+            if (!lazyString.Materialised.load(std::memory_order_relaxed))
+            {
+                auto value = std::string(lazyString.Source);
+                if (LanguagesDescriptors[_id].isRtl && !value.empty())
+                {
+                    value = FixRTL(value);
+                }
+                lazyString.Tokens = OpenRCT2::FmtString::Compile(value);
+                lazyString.Value = std::move(value);
+                lazyString.Materialised.store(true, std::memory_order_release);
+            }
+        }
+        return lazyString;
+    }
+
+    void SetLazyString(LazyString& lazyString, const std::string& str)
+    {
+        std::lock_guard<std::mutex> lock(_materialiseMutex);
+        lazyString.Tokens = OpenRCT2::FmtString::Compile(str);
+        lazyString.Value = str;
+        lazyString.Materialised.store(true, std::memory_order_release);
+    }
+
     ObjectOverride* GetObjectOverride(const std::string& objectIdentifier)
     {
         for (auto& oo : _objectOverrides)
@@ -251,7 +304,7 @@ private:
     {
         for (auto& so : _scenarioOverrides)
         {
-            if (String::Equals(so.strings[0], scenarioIdentifier.c_str(), true))
+            if (String::Equals(std::string(so.strings[0].Source), scenarioIdentifier, true))
             {
                 return &so;
             }
@@ -272,173 +325,171 @@ private:
     // When reading the language files, the STR_XXXX part is read and XXXX becomes the string id number. Everything after the
     // colon and before the new line will be saved as the string. Tokens are written with inside curly braces {TOKEN}. Use # at
     // the beginning of a line to leave a comment.
+    //
+    // Parsing only records where each string is in the text, building a table of offsets into it. All the structural
+    // characters are ASCII, so the text is scanned byte by byte without decoding UTF-8.
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-    static bool IsWhitespace(codepoint_t codepoint)
+    static bool IsWhitespace(char ch)
     {
-        return codepoint == '\t' || codepoint == ' ' || codepoint == '\r' || codepoint == '\n';
+        return ch == '\t' || ch == ' ' || ch == '\r' || ch == '\n';
     }
 
-    static bool IsNewLine(codepoint_t codepoint)
+    static bool IsNewLine(char ch)
     {
-        return codepoint == '\r' || codepoint == '\n';
+        return ch == '\r' || ch == '\n';
     }
 
-    static void SkipWhitespace(IStringReader* reader)
+    bool TryPeek(char* ch) const
     {
-        codepoint_t codepoint;
-        while (reader->TryPeek(&codepoint))
+        if (_parsePosition < _parseText.size())
         {
-            if (IsWhitespace(codepoint))
-            {
-                reader->Skip();
-            }
-            else
-            {
-                break;
-            }
+            *ch = _parseText[_parsePosition];
+            return true;
         }
+        return false;
     }
 
-    static void SkipNewLine(IStringReader* reader)
+    void SkipWhitespace()
     {
-        codepoint_t codepoint;
-        while (reader->TryPeek(&codepoint))
+        char ch;
+        while (TryPeek(&ch) && IsWhitespace(ch))
         {
-            if (IsNewLine(codepoint))
-            {
-                reader->Skip();
-            }
-            else
-            {
-                break;
-            }
+            _parsePosition++;
         }
     }
 
-    static void SkipToEndOfLine(IStringReader* reader)
+    void SkipNewLine()
     {
-        codepoint_t codepoint;
-        while (reader->TryPeek(&codepoint))
+        char ch;
+        while (TryPeek(&ch) && IsNewLine(ch))
         {
-            if (codepoint != '\r' && codepoint != '\n')
-            {
-                reader->Skip();
-            }
-            else
-            {
-                break;
-            }
+            _parsePosition++;
+        }
+    }
+
+    void SkipToEndOfLine()
+    {
+        char ch;
+        while (TryPeek(&ch) && !IsNewLine(ch))
+        {
+            _parsePosition++;
         }
     }
 
-    void ParseLine(IStringReader* reader)
+    std::string_view ReadToEndOfLine()
     {
-        SkipWhitespace(reader);
+        auto start = _parsePosition;
+        SkipToEndOfLine();
+        return _parseText.substr(start, _parsePosition - start);
+    }
 
-        codepoint_t codepoint;
-        if (reader->TryPeek(&codepoint))
+    void Parse(std::string_view text)
+    {
+        _parseText = text;
+        _parsePosition = 0;
+        while (_parsePosition < _parseText.size())
         {
-            switch (codepoint)
+            ParseLine();
+        }
+
+        // Build the string table from the offsets collected
+        _stringCount = static_cast<uint32_t>(_parseStrings.size());
+        _strings = std::make_unique<LazyString[]>(_stringCount);
+        for (uint32_t i = 0; i < _stringCount; i++)
+        {
+            _strings[i].Source = _parseStrings[i];
+        }
+
+        // Clean up the parsing work data
+        _parseText = {};
+        _parsePosition = 0;
+        _parseStrings = {};
+        _currentGroup = std::string();
+        _currentObjectOverride = nullptr;
+        _currentScenarioOverride = nullptr;
+    }
+
+    void ParseLine()
+    {
+        SkipWhitespace();
+
+        char ch;
+        if (TryPeek(&ch))
+        {
+            switch (ch)
             {
                 case '#':
-                    SkipToEndOfLine(reader);
+                    SkipToEndOfLine();
                     break;
                 case '[':
-                    ParseGroupObject(reader);
+                    ParseGroupObject();
                     break;
                 case '<':
-                    ParseGroupScenario(reader);
-                    break;
-                case '\r':
-                case '\n':
+                    ParseGroupScenario();
                     break;
                 default:
-                    ParseString(reader);
+                    ParseString();
                     break;
             }
-            SkipToEndOfLine(reader);
-            SkipNewLine(reader);
+            SkipToEndOfLine();
+            SkipNewLine();
         }
     }
 
-    void ParseGroupObject(IStringReader* reader)
+    /**
+     * Reads the group name after the opening bracket, returning false if the line ends before the closing bracket.
+     */
+    bool ParseGroupName(char closingBracket, std::string_view* name)
     {
-        auto sb = StringBuilder();
-        codepoint_t codepoint;
+        // Should have already deduced that the next character is the opening bracket
+        _parsePosition++;
 
-        // Should have already deduced that the next codepoint is a [
-        reader->Skip();
-
-        // Read string up to ] or line end
-        bool closedCorrectly = false;
-        while (reader->TryPeek(&codepoint))
+        auto start = _parsePosition;
+        char ch;
+        while (TryPeek(&ch))
         {
-            if (IsNewLine(codepoint))
+            if (IsNewLine(ch))
                 break;
 
-            reader->Skip();
-            if (codepoint == ']')
+            _parsePosition++;
+            if (ch == closingBracket)
             {
-                closedCorrectly = true;
-                break;
+                *name = _parseText.substr(start, _parsePosition - start - 1);
+                return true;
             }
-            sb.Append(codepoint);
         }
+        return false;
+    }
 
-        if (closedCorrectly)
+    void ParseGroupObject()
+    {
+        std::string_view name;
+        if (ParseGroupName(']', &name) && name.size() <= 8)
         {
-            while (sb.GetLength() < 8)
+            _currentGroup = std::string(name);
+            _currentGroup.resize(8, ' ');
+            _currentObjectOverride = GetObjectOverride(_currentGroup);
+            _currentScenarioOverride = nullptr;
+            if (_currentObjectOverride == nullptr)
             {
-                sb.Append(' ');
-            }
-            if (sb.GetLength() == 8)
-            {
-                _currentGroup = sb.GetStdString();
-                _currentObjectOverride = GetObjectOverride(_currentGroup);
-                _currentScenarioOverride = nullptr;
-                if (_currentObjectOverride == nullptr)
+                if (_objectOverrides.size() == MAX_OBJECT_OVERRIDES)
                 {
-                    if (_objectOverrides.size() == MAX_OBJECT_OVERRIDES)
-                    {
-                        log_warning("Maximum number of localised object strings exceeded.");
-                    }
-
-                    _objectOverrides.emplace_back();
-                    _currentObjectOverride = &_objectOverrides[_objectOverrides.size() - 1];
-                    std::copy_n(_currentGroup.c_str(), 8, _currentObjectOverride->name);
+                    log_warning("Maximum number of localised object strings exceeded.");
                 }
+
+                _currentObjectOverride = &_objectOverrides.emplace_back();
+                std::copy_n(_currentGroup.c_str(), 8, _currentObjectOverride->name);
             }
         }
     }
 
-    void ParseGroupScenario(IStringReader* reader)
+    void ParseGroupScenario()
     {
-        auto sb = StringBuilder();
-        codepoint_t codepoint;
-
-        // Should have already deduced that the next codepoint is a <
-        reader->Skip();
-
-        // Read string up to > or line end
-        bool closedCorrectly = false;
-        while (reader->TryPeek(&codepoint))
+        std::string_view name;
+        if (ParseGroupName('>', &name))
         {
-            if (IsNewLine(codepoint))
-                break;
-
-            reader->Skip();
-            if (codepoint == '>')
-            {
-                closedCorrectly = true;
-                break;
-            }
-            sb.Append(codepoint);
-        }
-
-        if (closedCorrectly)
-        {
-            _currentGroup = sb.GetStdString();
+            _currentGroup = std::string(name);
             _currentObjectOverride = nullptr;
             _currentScenarioOverride = GetScenarioOverride(_currentGroup);
             if (_currentScenarioOverride == nullptr)
@@ -448,54 +499,51 @@ private:
                     log_warning("Maximum number of scenario strings exceeded.");
                 }
 
-                _scenarioOverrides.emplace_back();
-                _currentScenarioOverride = &_scenarioOverrides[_scenarioOverrides.size() - 1];
-                _currentScenarioOverride->filename = std::string(sb.GetBuffer());
+                _currentScenarioOverride = &_scenarioOverrides.emplace_back();
+                _currentScenarioOverride->filename = _currentGroup;
             }
         }
     }
 
-    void ParseString(IStringReader* reader)
+    void ParseString()
     {
-        auto sb = StringBuilder();
-        codepoint_t codepoint;
+        char ch;
 
         // Parse string identifier
-        while (reader->TryPeek(&codepoint))
+        auto identifierStart = _parsePosition;
+        while (TryPeek(&ch))
         {
-            if (IsNewLine(codepoint))
+            if (IsNewLine(ch))
             {
                 // Unexpected new line, ignore line entirely
                 return;
             }
-            else if (!IsWhitespace(codepoint) && codepoint != ':')
+            else if (!IsWhitespace(ch) && ch != ':')
             {
-                reader->Skip();
-                sb.Append(codepoint);
+                _parsePosition++;
             }
             else
             {
                 break;
             }
         }
+        auto identifier = std::string(_parseText.substr(identifierStart, _parsePosition - identifierStart));
 
-        SkipWhitespace(reader);
+        SkipWhitespace();
 
         // Parse a colon
-        if (!reader->TryPeek(&codepoint) || codepoint != ':')
+        if (!TryPeek(&ch) || ch != ':')
         {
             // Expected a colon, ignore line entirely
             return;
         }
-        reader->Skip();
+        _parsePosition++;
 
         // Validate identifier
-        const utf8* identifier = sb.GetBuffer();
-
         int32_t stringId;
         if (_currentGroup.empty())
         {
-            if (sscanf(identifier, "STR_%4d", &stringId) != 1)
+            if (sscanf(identifier.c_str(), "STR_%4d", &stringId) != 1)
             {
                 // Ignore line entirely
                 return;
@@ -503,28 +551,28 @@ private:
         }
         else
         {
-            if (String::Equals(identifier, "STR_NAME"))
+            if (identifier == "STR_NAME")
             {
                 stringId = 0;
             }
-            else if (String::Equals(identifier, "STR_DESC"))
+            else if (identifier == "STR_DESC")
             {
                 stringId = 1;
             }
-            else if (String::Equals(identifier, "STR_CPTY"))
+            else if (identifier == "STR_CPTY")
             {
                 stringId = 2;
             }
 
-            else if (String::Equals(identifier, "STR_SCNR"))
+            else if (identifier == "STR_SCNR")
             {
                 stringId = 0;
             }
-            else if (String::Equals(identifier, "STR_PARK"))
+            else if (identifier == "STR_PARK")
             {
                 stringId = 1;
             }
-            else if (String::Equals(identifier, "STR_DTLS"))
+            else if (identifier == "STR_DTLS")
             {
                 stringId = 2;
             }
@@ -536,42 +584,26 @@ private:
         }
 
         // Rest of the line is the actual string
-        sb.Clear();
-        while (reader->TryPeek(&codepoint) && !IsNewLine(codepoint))
-        {
-            reader->Skip();
-            sb.Append(codepoint);
-        }
-
-        std::string s;
-        if (LanguagesDescriptors[_id].isRtl)
-        {
-            auto ts = std::string(sb.GetBuffer(), sb.GetLength());
-            s = FixRTL(ts);
-        }
-        else
-        {
-            s = std::string(sb.GetBuffer(), sb.GetLength());
-        }
+        auto s = ReadToEndOfLine();
 
         if (_currentGroup.empty())
         {
             // Make sure the list is big enough to contain this string id
-            if (static_cast<size_t>(stringId) >= _strings.size())
+            if (static_cast<size_t>(stringId) >= _parseStrings.size())
             {
-                _strings.resize(stringId + 1);
+                _parseStrings.resize(stringId + 1);
             }
-            _strings[stringId] = s;
+            _parseStrings[stringId] = s;
         }
         else
         {
             if (_currentObjectOverride != nullptr)
             {
-                _currentObjectOverride->strings[stringId] = s;
+                _currentObjectOverride->strings[stringId].Source = s;
             }
             else
             {
-                _currentScenarioOverride->strings[stringId] = s;
+                _currentScenarioOverride->strings[stringId].Source = s;
             }
         }
     }
@@ -10,6 +10,7 @@
 #pragma once
 
 #include "../common.h"
+#include "Formatting.h"
 
 #include <string>
 #include <string_view>
@@ -24,6 +25,8 @@ struct ILanguagePack
     virtual void RemoveString(rct_string_id stringId) abstract;
     virtual void SetString(rct_string_id stringId, const std::string& str) abstract;
     virtual const utf8* GetString(rct_string_id stringId) const abstract;
+    // Returns the tokens of the string returned by GetString, if it has been pre-tokenised
+    virtual const OpenRCT2::FmtString::compiled_tokens* GetCompiledString(rct_string_id stringId) const abstract;
     virtual rct_string_id GetObjectOverrideStringId(std::string_view legacyIdentifier, uint8_t index) abstract;
     virtual rct_string_id GetScenarioOverrideStringId(const utf8* scenarioFilename, uint8_t index) abstract;
 };
@@ -12,8 +12,10 @@
 #include "../Context.h"
 #include "../PlatformEnvironment.h"
 #include "../core/Path.hpp"
+#include "../drawing/Drawing.h"
 #include "../interface/Fonts.h"
 #include "../object/ObjectManager.h"
+#include "Formatting.h"
 #include "Language.h"
 #include "LanguagePack.h"
 #include "StringIds.h"
@@ -66,6 +68,28 @@ const char* LocalisationService::GetString(rct_string_id id) const
     return result;
 }
 
+FmtString LocalisationService::GetFmtString(rct_string_id id) const
+{
+    // Same lookup as GetString, but uses the tokens of the language pack the string came from
+    if (id != STR_EMPTY && id != STR_NONE)
+    {
+        for (const auto* languagePack : { _languageCurrent.get(), _languageFallback.get() })
+        {
+            if (languagePack == nullptr)
+            {
+                continue;
+            }
+            auto result = languagePack->GetString(id);
+            if (result != nullptr)
+            {
+                auto tokens = languagePack->GetCompiledString(id);
+                return tokens != nullptr ? FmtString(result, *tokens) : FmtString(result);
+            }
+        }
+    }
+    return FmtString(GetString(id));
+}
+
 std::string LocalisationService::GetLanguagePath(uint32_t languageId) const
 {
     auto locale = std::string(LanguagesDescriptors[languageId].locale);
@@ -96,6 +120,10 @@ void LocalisationService::OpenLanguage(int32_t id)
     {
         _currentLanguage = id;
         TryLoadFonts(*this);
+
+        // Text measured or drawn with the previous language's font is no longer valid
+        gfx_clear_text_layout_cache();
+        scrolling_text_invalidate();
     }
     else
     {
@@ -9,6 +9,7 @@
 
 #include "Localisation.h"
 
+#include <cstring>
 #include <wchar.h>
 
 uint32_t utf8_get_next(const utf8* char_ptr, const utf8** nextchar_ptr)
@@ -98,10 +99,32 @@ int32_t utf8_get_codepoint_length(char32_t codepoint)
 int32_t utf8_length(const utf8* text)
 {
     const utf8* ch = text;
+    const utf8* end = get_string_end(text);
 
     int32_t count = 0;
-    while (utf8_get_next(ch, &ch) != 0)
+    while (ch < end)
     {
+        // Runs of ASCII are counted eight bytes at a time, they need no decoding
+        uint64_t word;
+        if (end - ch >= static_cast<ptrdiff_t>(sizeof(word)))
+        {
+            std::memcpy(&word, ch, sizeof(word));
+            if ((word & 0x8080808080808080ULL) == 0)
+            {
+                ch += sizeof(word);
+                count += static_cast<int32_t>(sizeof(word));
+                continue;
+            }
+        }
+
+        if (!(*ch & 0x80))
+        {
+            ch++;
+        }
+        else if (utf8_get_next(ch, &ch) == 0)
+        {
+            break;
+        }
         count++;
     }
     return count;
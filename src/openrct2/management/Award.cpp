@@ -13,6 +13,7 @@
 #include "../interface/Window.h"
 #include "../localisation/Localisation.h"
 #include "../localisation/StringIds.h"
+#include "../peep/GuestStatistics.h"
 #include "../peep/Peep.h"
 #include "../ride/Ride.h"
 #include "../ride/RideData.h"
@@ -74,6 +75,14 @@ bool award_is_positive(int32_t type)
 
 #pragma region Award checks
 
+/** The guests thinking about litter, disgusting paths or vandalism. */
+static uint32_t get_untidy_thought_count(const GuestStatistics& guestStats)
+{
+    return guestStats.GetFreshThoughts(PeepThoughtType::BadLitter)
+        + guestStats.GetFreshThoughts(PeepThoughtType::PathDisgusting)
+        + guestStats.GetFreshThoughts(PeepThoughtType::Vandalism);
+}
+
 /** More than 1/16 of the total guests must be thinking untidy thoughts. */
 static bool award_is_deserved_most_untidy(int32_t activeAwardTypes)
 {
@@ -84,22 +93,7 @@ static bool award_is_deserved_most_untidy(int32_t activeAwardTypes)
     if (activeAwardTypes & EnumToFlag(ParkAward::MostTidy))
         return false;
 
-    uint32_t negativeCount = 0;
-    for (auto peep : EntityList<Guest>())
-    {
-        if (peep->OutsideOfPark)
-            continue;
-
-        if (peep->Thoughts[0].freshness > 5)
-            continue;
-
-        if (peep->Thoughts[0].type == PeepThoughtType::BadLitter || peep->Thoughts[0].type == PeepThoughtType::PathDisgusting
-            || peep->Thoughts[0].type == PeepThoughtType::Vandalism)
-        {
-            negativeCount++;
-        }
-    }
-
+    uint32_t negativeCount = get_untidy_thought_count(GetGuestStatistics());
     return (negativeCount > gNumGuestsInPark / 16);
 }
 
@@ -111,26 +105,9 @@ static bool award_is_deserved_most_tidy(int32_t activeAwardTypes)
     if (activeAwardTypes & EnumToFlag(ParkAward::MostDisappointing))
         return false;
 
-    uint32_t positiveCount = 0;
-    uint32_t negativeCount = 0;
-    for (auto peep : EntityList<Guest>())
-    {
-        if (peep->OutsideOfPark)
-            continue;
-
-        if (peep->Thoughts[0].freshness > 5)
-            continue;
-
-        if (peep->Thoughts[0].type == PeepThoughtType::VeryClean)
-            positiveCount++;
-
-        if (peep->Thoughts[0].type == PeepThoughtType::BadLitter || peep->Thoughts[0].type == PeepThoughtType::PathDisgusting
-            || peep->Thoughts[0].type == PeepThoughtType::Vandalism)
-        {
-            negativeCount++;
-        }
-    }
-
+    const auto& guestStats = GetGuestStatistics();
+    uint32_t positiveCount = guestStats.GetFreshThoughts(PeepThoughtType::VeryClean);
+    uint32_t negativeCount = get_untidy_thought_count(guestStats);
     return (negativeCount <= 5 && positiveCount > gNumGuestsInPark / 64);
 }
 
@@ -190,27 +167,9 @@ static bool award_is_deserved_most_beautiful(int32_t activeAwardTypes)
     if (activeAwardTypes & EnumToFlag(ParkAward::MostDisappointing))
         return false;
 
-    uint32_t positiveCount = 0;
-    uint32_t negativeCount = 0;
-    auto list = EntityList<Guest>();
-    for (auto peep : list)
-    {
-        if (peep->OutsideOfPark)
-            continue;
-
-        if (peep->Thoughts[0].freshness > 5)
-            continue;
-
-        if (peep->Thoughts[0].type == PeepThoughtType::Scenery)
-            positiveCount++;
-
-        if (peep->Thoughts[0].type == PeepThoughtType::BadLitter || peep->Thoughts[0].type == PeepThoughtType::PathDisgusting
-            || peep->Thoughts[0].type == PeepThoughtType::Vandalism)
-        {
-            negativeCount++;
-        }
-    }
-
+    const auto& guestStats = GetGuestStatistics();
+    uint32_t positiveCount = guestStats.GetFreshThoughts(PeepThoughtType::Scenery);
+    uint32_t negativeCount = get_untidy_thought_count(guestStats);
     return (negativeCount <= 15 && positiveCount > gNumGuestsInPark / 128);
 }
 
@@ -233,15 +192,7 @@ static bool award_is_deserved_worst_value(int32_t activeAwardTypes)
 /** No more than 2 people who think the vandalism is bad and no crashes. */
 static bool award_is_deserved_safest([[maybe_unused]] int32_t activeAwardTypes)
 {
-    auto peepsWhoDislikeVandalism = 0;
-    for (auto peep : EntityList<Guest>())
-    {
-        if (peep->OutsideOfPark)
-            continue;
-        if (peep->Thoughts[0].freshness <= 5 && peep->Thoughts[0].type == PeepThoughtType::Vandalism)
-            peepsWhoDislikeVandalism++;
-    }
-
+    auto peepsWhoDislikeVandalism = GetGuestStatistics().GetFreshThoughts(PeepThoughtType::Vandalism);
     if (peepsWhoDislikeVandalism > 2)
         return false;
 
@@ -301,15 +252,7 @@ static bool award_is_deserved_best_food(int32_t activeAwardTypes)
         return false;
 
     // Count hungry peeps
-    auto hungryPeeps = 0;
-    for (auto peep : EntityList<Guest>())
-    {
-        if (peep->OutsideOfPark)
-            continue;
-
-        if (peep->Thoughts[0].freshness <= 5 && peep->Thoughts[0].type == PeepThoughtType::Hungry)
-            hungryPeeps++;
-    }
+    auto hungryPeeps = GetGuestStatistics().GetFreshThoughts(PeepThoughtType::Hungry);
     return (hungryPeeps <= 12);
 }
 
@@ -345,15 +288,7 @@ static bool award_is_deserved_worst_food(int32_t activeAwardTypes)
         return false;
 
     // Count hungry peeps
-    auto hungryPeeps = 0;
-    for (auto peep : EntityList<Guest>())
-    {
-        if (peep->OutsideOfPark)
-            continue;
-
-        if (peep->Thoughts[0].freshness <= 5 && peep->Thoughts[0].type == PeepThoughtType::Hungry)
-            hungryPeeps++;
-    }
+    auto hungryPeeps = GetGuestStatistics().GetFreshThoughts(PeepThoughtType::Hungry);
     return (hungryPeeps > 15);
 }
 
@@ -375,15 +310,7 @@ static bool award_is_deserved_best_restrooms([[maybe_unused]] int32_t activeAwar
         return false;
 
     // Count number of guests who are thinking they need the restroom
-    auto guestsWhoNeedRestroom = 0;
-    for (auto peep : EntityList<Guest>())
-    {
-        if (peep->OutsideOfPark)
-            continue;
-
-        if (peep->Thoughts[0].freshness <= 5 && peep->Thoughts[0].type == PeepThoughtType::Toilet)
-            guestsWhoNeedRestroom++;
-    }
+    auto guestsWhoNeedRestroom = GetGuestStatistics().GetFreshThoughts(PeepThoughtType::Toilet);
     return (guestsWhoNeedRestroom <= 16);
 }
 
@@ -501,18 +428,10 @@ static bool award_is_deserved_most_dazzling_ride_colours(int32_t activeAwardType
 /** At least 10 peeps and more than 1/64 of total guests are lost or can't find something. */
 static bool award_is_deserved_most_confusing_layout([[maybe_unused]] int32_t activeAwardTypes)
 {
-    uint32_t peepsCounted = 0;
-    uint32_t peepsLost = 0;
-    for (auto peep : EntityList<Guest>())
-    {
-        if (peep->OutsideOfPark)
-            continue;
-
-        peepsCounted++;
-        if (peep->Thoughts[0].freshness <= 5
-            && (peep->Thoughts[0].type == PeepThoughtType::Lost || peep->Thoughts[0].type == PeepThoughtType::CantFind))
-            peepsLost++;
-    }
+    const auto& guestStats = GetGuestStatistics();
+    uint32_t peepsCounted = guestStats.InPark;
+    uint32_t peepsLost = guestStats.GetFreshThoughts(PeepThoughtType::Lost)
+        + guestStats.GetFreshThoughts(PeepThoughtType::CantFind);
 
     return (peepsLost >= 10 && peepsLost >= peepsCounted / 64);
 }
@@ -37,15 +37,11 @@ static constexpr const uint16_t AdvertisingCampaignGuestGenerationProbabilities[
 
 std::vector<MarketingCampaign> gMarketingCampaigns;
 
-uint16_t marketing_get_campaign_guest_generation_probability(int32_t campaignType)
+uint16_t marketing_get_campaign_guest_generation_probability(const MarketingCampaign& campaign)
 {
-    auto campaign = marketing_get_campaign(campaignType);
-    if (campaign == nullptr)
-        return 0;
-
     // Lower probability of guest generation if price was already low
-    auto probability = AdvertisingCampaignGuestGenerationProbabilities[campaign->Type];
-    switch (campaign->Type)
+    auto probability = AdvertisingCampaignGuestGenerationProbabilities[campaign.Type];
+    switch (campaign.Type)
     {
         case ADVERTISING_CAMPAIGN_PARK_ENTRY_FREE:
             if (park_get_entrance_fee() < MONEY(4, 00))
@@ -57,7 +53,7 @@ uint16_t marketing_get_campaign_guest_generation_probability(int32_t campaignTyp
             break;
         case ADVERTISING_CAMPAIGN_RIDE_FREE:
         {
-            auto ride = get_ride(campaign->RideId);
+            auto ride = get_ride(campaign.RideId);
             if (ride == nullptr || ride->price[0] < MONEY(0, 30))
                 probability /= 8;
             break;
@@ -127,13 +123,9 @@ void marketing_update()
     window_invalidate_by_class(WC_FINANCES);
 }
 
-void marketing_set_guest_campaign(Peep* peep, int32_t campaignType)
+void marketing_set_guest_campaign(Peep* peep, const MarketingCampaign& campaign)
 {
-    auto campaign = marketing_get_campaign(campaignType);
-    if (campaign == nullptr)
-        return;
-
-    switch (campaign->Type)
+    switch (campaign.Type)
     {
         case ADVERTISING_CAMPAIGN_PARK_ENTRY_FREE:
             peep->GiveItem(ShopItem::Voucher);
@@ -142,8 +134,8 @@ void marketing_set_guest_campaign(Peep* peep, int32_t campaignType)
         case ADVERTISING_CAMPAIGN_RIDE_FREE:
             peep->GiveItem(ShopItem::Voucher);
             peep->VoucherType = VOUCHER_TYPE_RIDE_FREE;
-            peep->VoucherRideId = campaign->RideId;
-            peep->GuestHeadingToRideId = campaign->RideId;
+            peep->VoucherRideId = campaign.RideId;
+            peep->GuestHeadingToRideId = campaign.RideId;
             peep->GuestIsLostCountdown = 240;
             break;
         case ADVERTISING_CAMPAIGN_PARK_ENTRY_HALF_PRICE:
@@ -153,12 +145,12 @@ void marketing_set_guest_campaign(Peep* peep, int32_t campaignType)
         case ADVERTISING_CAMPAIGN_FOOD_OR_DRINK_FREE:
             peep->GiveItem(ShopItem::Voucher);
             peep->VoucherType = VOUCHER_TYPE_FOOD_OR_DRINK_FREE;
-            peep->VoucherShopItem = campaign->ShopItemType;
+            peep->VoucherShopItem = campaign.ShopItemType;
             break;
         case ADVERTISING_CAMPAIGN_PARK:
             break;
         case ADVERTISING_CAMPAIGN_RIDE:
-            peep->GuestHeadingToRideId = campaign->RideId;
+            peep->GuestHeadingToRideId = campaign.RideId;
             peep->GuestIsLostCountdown = 240;
             break;
     }
@@ -61,9 +61,9 @@ namespace MarketingCampaignFlags
 extern const money16 AdvertisingCampaignPricePerWeek[ADVERTISING_CAMPAIGN_COUNT];
 extern std::vector<MarketingCampaign> gMarketingCampaigns;
 
-uint16_t marketing_get_campaign_guest_generation_probability(int32_t campaign);
+uint16_t marketing_get_campaign_guest_generation_probability(const MarketingCampaign& campaign);
 void marketing_update();
-void marketing_set_guest_campaign(Peep* peep, int32_t campaign);
+void marketing_set_guest_campaign(Peep* peep, const MarketingCampaign& campaign);
 bool marketing_is_campaign_type_applicable(int32_t campaignType);
 MarketingCampaign* marketing_get_campaign(int32_t campaignType);
 void marketing_new_campaign(const MarketingCampaign& campaign);
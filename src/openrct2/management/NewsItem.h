@@ -116,18 +116,116 @@ namespace News
     constexpr int32_t MaxItemsArchive = 50;
     constexpr int32_t MaxItems = News::ItemHistoryStart + News::MaxItemsArchive;
 
+    /**
+     * Iterates the items of an ItemQueue in queue order, the items are not contiguous as the queue wraps around.
+     */
+    template<typename TQueue, typename TItem> class ItemQueueIterator
+    {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = News::Item;
+        using difference_type = std::ptrdiff_t;
+        using pointer = TItem*;
+        using reference = TItem&;
+
+        ItemQueueIterator(TQueue* queue, std::size_t index)
+            : _queue(queue)
+            , _index(index)
+        {
+        }
+
+        reference operator*() const
+        {
+            return (*_queue)[_index];
+        }
+        pointer operator->() const
+        {
+            return &(*_queue)[_index];
+        }
+        reference operator[](difference_type n) const
+        {
+            return (*_queue)[_index + n];
+        }
+
+        ItemQueueIterator& operator++()
+        {
+            _index++;
+            return *this;
+        }
+        ItemQueueIterator operator++(int)
+        {
+            auto result = *this;
+            _index++;
+            return result;
+        }
+        ItemQueueIterator& operator--()
+        {
+            _index--;
+            return *this;
+        }
+        ItemQueueIterator operator--(int)
+        {
+            auto result = *this;
+            _index--;
+            return result;
+        }
+        ItemQueueIterator& operator+=(difference_type n)
+        {
+            _index += n;
+            return *this;
+        }
+        ItemQueueIterator& operator-=(difference_type n)
+        {
+            _index -= n;
+            return *this;
+        }
+        ItemQueueIterator operator+(difference_type n) const
+        {
+            return ItemQueueIterator(_queue, _index + n);
+        }
+        ItemQueueIterator operator-(difference_type n) const
+        {
+            return ItemQueueIterator(_queue, _index - n);
+        }
+        difference_type operator-(const ItemQueueIterator& other) const
+        {
+            return static_cast<difference_type>(_index) - static_cast<difference_type>(other._index);
+        }
+
+        bool operator==(const ItemQueueIterator& other) const
+        {
+            return _index == other._index;
+        }
+        bool operator!=(const ItemQueueIterator& other) const
+        {
+            return _index != other._index;
+        }
+        bool operator<(const ItemQueueIterator& other) const
+        {
+            return _index < other._index;
+        }
+
+    private:
+        TQueue* _queue;
+        std::size_t _index;
+    };
+
+    /**
+     * A fixed size queue of news items that ends at the first null item. The items are stored in a ring so removing the
+     * front one, which happens every time an item is archived, does not move the others.
+     */
     template<std::size_t N> class ItemQueue
     {
     public:
         static_assert(N > 0, "Cannot instantiate News::ItemQueue with size=0");
 
-        using value_type = typename std::array<News::Item, N>::value_type;
+        using value_type = News::Item;
         using pointer = value_type*;
         using const_pointer = const value_type*;
         using reference = value_type&;
         using const_reference = const value_type&;
-        using iterator = typename std::array<News::Item, N>::iterator;
-        using const_iterator = typename std::array<News::Item, N>::const_iterator;
+        using iterator = ItemQueueIterator<ItemQueue, value_type>;
+        using const_iterator = ItemQueueIterator<const ItemQueue, const value_type>;
         using size_type = std::size_t;
         using difference_type = std::ptrdiff_t;
         using reverse_iterator = std::reverse_iterator<iterator>;
@@ -138,21 +236,21 @@ namespace News
             Queue[0].Type = News::ItemType::Null;
         }
 
-        constexpr iterator begin() noexcept
+        iterator begin() noexcept
         {
-            return std::begin(Queue);
+            return iterator(this, 0);
         }
-        constexpr const_iterator begin() const noexcept
+        const_iterator begin() const noexcept
         {
             return cbegin();
         }
-        constexpr const_iterator cbegin() const noexcept
+        const_iterator cbegin() const noexcept
         {
-            return std::cbegin(Queue);
+            return const_iterator(this, 0);
         }
         iterator end() noexcept
         {
-            return std::find_if(std::begin(Queue), std::end(Queue), [](const_reference item) { return item.IsEmpty(); });
+            return iterator(this, FindEnd());
         }
         const_iterator end() const noexcept
         {
@@ -160,26 +258,26 @@ namespace News
         }
         const_iterator cend() const noexcept
         {
-            return std::find_if(std::cbegin(Queue), std::cend(Queue), [](const_reference item) { return item.IsEmpty(); });
+            return const_iterator(this, FindEnd());
         }
 
-        constexpr bool empty() const noexcept
+        bool empty() const noexcept
         {
-            return Queue[0].IsEmpty();
+            return front().IsEmpty();
         }
 
         size_type size() const noexcept
         {
-            return std::distance(cbegin(), cend());
+            return FindEnd();
         }
 
         reference front() noexcept
         {
-            return *begin();
+            return Queue[Head];
         }
         const_reference front() const noexcept
         {
-            return *cbegin();
+            return Queue[Head];
         }
         reference back() noexcept
         {
@@ -192,35 +290,35 @@ namespace News
 
         void pop_front()
         {
-            std::move(std::begin(Queue) + 1, std::end(Queue), std::begin(Queue));
-            Queue[N - 1].Type = News::ItemType::Null;
+            // The slot of the front item becomes the last one of the queue
+            Queue[Head].Type = News::ItemType::Null;
+            Head = (Head + 1) % N;
         }
 
         void push_back(const_reference item)
         {
-            auto it = end();
-            if (!std::distance(it, std::end(Queue)))
+            auto count = FindEnd();
+            if (count == N)
             {
                 // Reached queue max size, need to free some space
                 pop_front();
-                Queue[N - 1] = item;
+                (*this)[N - 1] = item;
             }
             else
             {
-                *it = item;
-                ++it;
-                if (std::distance(it, std::end(Queue)))
-                    it->Type = News::ItemType::Null;
+                (*this)[count] = item;
+                if (count + 1 < N)
+                    (*this)[count + 1].Type = News::ItemType::Null;
             }
         }
 
         reference operator[](size_type n) noexcept
         {
-            return Queue[n];
+            return Queue[(Head + n) % N];
         }
         const_reference operator[](size_type n) const noexcept
         {
-            return Queue[n];
+            return Queue[(Head + n) % N];
         }
 
         constexpr size_type capacity() const noexcept
@@ -230,11 +328,24 @@ namespace News
 
         void clear() noexcept
         {
+            Head = 0;
             front().Type = News::ItemType::Null;
         }
 
     private:
+        size_type FindEnd() const noexcept
+        {
+            for (size_type i = 0; i < N; i++)
+            {
+                if ((*this)[i].IsEmpty())
+                    return i;
+            }
+            return N;
+        }
+
         std::array<News::Item, N> Queue;
+        // The index in Queue of the front item
+        size_type Head{};
     };
 
     struct ItemQueues
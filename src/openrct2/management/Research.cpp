@@ -32,6 +32,8 @@
 #include "NewsItem.h"
 
 #include <algorithm>
+#include <array>
+#include <bitset>
 #include <iterator>
 
 static constexpr const int32_t _researchRate[] = {
@@ -56,9 +58,11 @@ std::vector<ResearchItem> gResearchItemsInvented;
 // 0x00EE787C
 uint8_t gResearchUncompletedCategories;
 
-static bool _researchedRideTypes[RIDE_TYPE_COUNT];
-static bool _researchedRideEntries[MAX_RIDE_OBJECTS];
-static bool _researchedSceneryItems[SCENERY_TYPE_COUNT][UINT16_MAX];
+// Bitsets rather than bool arrays, the scenery items alone would otherwise take over 300 KiB that every availability
+// check of the scenery and ride windows reads from
+static std::bitset<RIDE_TYPE_COUNT> _researchedRideTypes;
+static std::bitset<MAX_RIDE_OBJECTS> _researchedRideEntries;
+static std::array<std::bitset<UINT16_MAX + 1>, SCENERY_TYPE_COUNT> _researchedSceneryItems;
 
 bool gSilentResearch = false;
 
@@ -649,7 +653,7 @@ void set_all_scenery_items_invented()
 {
     for (auto sceneryType = 0; sceneryType < SCENERY_TYPE_COUNT; sceneryType++)
     {
-        std::fill(std::begin(_researchedSceneryItems[sceneryType]), std::end(_researchedSceneryItems[sceneryType]), true);
+        _researchedSceneryItems[sceneryType].set();
     }
 }
 
@@ -657,28 +661,28 @@ void set_all_scenery_items_not_invented()
 {
     for (auto sceneryType = 0; sceneryType < SCENERY_TYPE_COUNT; sceneryType++)
     {
-        std::fill(std::begin(_researchedSceneryItems[sceneryType]), std::end(_researchedSceneryItems[sceneryType]), true);
+        _researchedSceneryItems[sceneryType].set();
     }
 }
 
 void set_every_ride_type_invented()
 {
-    std::fill(std::begin(_researchedRideTypes), std::end(_researchedRideTypes), true);
+    _researchedRideTypes.set();
 }
 
 void set_every_ride_type_not_invented()
 {
-    std::fill(std::begin(_researchedRideTypes), std::end(_researchedRideTypes), false);
+    _researchedRideTypes.reset();
 }
 
 void set_every_ride_entry_invented()
 {
-    std::fill(std::begin(_researchedRideEntries), std::end(_researchedRideEntries), true);
+    _researchedRideEntries.set();
 }
 
 void set_every_ride_entry_not_invented()
 {
-    std::fill(std::begin(_researchedRideEntries), std::end(_researchedRideEntries), false);
+    _researchedRideEntries.reset();
 }
 
 /**
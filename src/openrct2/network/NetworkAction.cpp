@@ -129,6 +129,7 @@ const std::array<NetworkAction, static_cast<size_t>(NetworkPermission::Count)> N
         {
             GameCommand::RemoveScenery,
             GameCommand::PlaceScenery,
+            GameCommand::ScatterScenery,
             GameCommand::SetBrakesSpeed,
             GameCommand::RemoveWall,
             GameCommand::PlaceWall,
@@ -36,7 +36,7 @@
 // This string specifies which version of network stream current build uses.
 // It is used for making sure only compatible builds get connected, even within
 // single OpenRCT2 version.
-#define NETWORK_STREAM_VERSION "4"
+#define NETWORK_STREAM_VERSION "8"
 #define NETWORK_STREAM_ID OPENRCT2_VERSION "-" NETWORK_STREAM_VERSION
 
 static Peep* _pickup_peep = nullptr;
@@ -46,6 +46,15 @@ static int32_t _pickup_peep_old_x = LOCATION_NULL;
 // with uint16_t and needs some spare room for other data in the packet.
 static constexpr uint32_t CHUNK_SIZE = 1024 * 63;
 
+// Features of the protocol this build supports, see NETWORK_FEATURE_*.
+static constexpr uint32_t NETWORK_FEATURES = NETWORK_FEATURE_TICK_FRAMES | NETWORK_FEATURE_OBJECT_STREAM;
+
+// A client that desyncs again this soon after a resync differs in state a resync does not cover, e.g. park finances.
+static constexpr uint32_t RESYNC_COOLDOWN_TICKS = 40 * 60;
+
+// Number of joins whose timings are kept for the stats
+static constexpr size_t JOIN_TIMINGS_KEPT = 16;
+
 #ifndef DISABLE_NETWORK
 
 #    include "../Cheats.h"
@@ -55,6 +64,7 @@ static constexpr uint32_t CHUNK_SIZE = 1024 * 63;
 #    include "../config/Config.h"
 #    include "../core/Console.hpp"
 #    include "../core/FileStream.h"
+#    include "../core/JobPool.h"
 #    include "../core/MemoryStream.h"
 #    include "../core/Nullable.hpp"
 #    include "../core/Path.hpp"
@@ -91,6 +101,7 @@ static constexpr uint32_t CHUNK_SIZE = 1024 * 63;
 #    include <set>
 #    include <string>
 #    include <vector>
+#    include <zlib.h>
 
 using namespace OpenRCT2;
 
@@ -100,6 +111,64 @@ static void network_get_keys_directory(utf8* buffer, size_t bufferSize);
 static void network_get_private_key_path(utf8* buffer, size_t bufferSize, const std::string& playerName);
 static void network_get_public_key_path(utf8* buffer, size_t bufferSize, const std::string& playerName, const utf8* hash);
 
+/**
+ * Inflates the map while it is being received, so it can be loaded as soon as the last chunk has arrived.
+ */
+struct NetworkBase::MapDownload
+{
+    z_stream Stream{};
+    std::vector<uint8_t> Data;
+    uint32_t BytesReceived = 0;
+    bool Initialised = false;
+    bool Finished = false;
+
+    explicit MapDownload(uint32_t size)
+        : Data(size)
+    {
+        Initialised = inflateInit(&Stream) == Z_OK;
+        Stream.next_out = Data.data();
+        Stream.avail_out = static_cast<uInt>(Data.size());
+    }
+
+    MapDownload(const MapDownload&) = delete;
+    MapDownload& operator=(const MapDownload&) = delete;
+
+    ~MapDownload()
+    {
+        if (Initialised)
+        {
+            inflateEnd(&Stream);
+        }
+    }
+
+    bool Inflate(const uint8_t* data, size_t length)
+    {
+        if (!Initialised || (Finished && length > 0))
+            return false;
+
+        BytesReceived += static_cast<uint32_t>(length);
+        Stream.next_in = const_cast<Bytef*>(data);
+        Stream.avail_in = static_cast<uInt>(length);
+
+        int32_t ret = Z_OK;
+        while (Stream.avail_in > 0 && ret == Z_OK)
+        {
+            ret = inflate(&Stream, Z_NO_FLUSH);
+        }
+        if (ret == Z_STREAM_END)
+        {
+            Finished = true;
+            return Stream.avail_in == 0;
+        }
+        return ret == Z_OK;
+    }
+
+    bool IsComplete() const
+    {
+        return Finished && Stream.total_out == Data.size();
+    }
+};
+
 static NetworkBase gNetwork;
 
 NetworkBase::NetworkBase()
@@ -115,6 +184,7 @@ NetworkBase::NetworkBase()
     client_command_handlers[NetworkCommand::Chat] = &NetworkBase::Client_Handle_CHAT;
     client_command_handlers[NetworkCommand::GameAction] = &NetworkBase::Client_Handle_GAME_ACTION;
     client_command_handlers[NetworkCommand::Tick] = &NetworkBase::Client_Handle_TICK;
+    client_command_handlers[NetworkCommand::TickFrame] = &NetworkBase::Client_Handle_TICK_FRAME;
     client_command_handlers[NetworkCommand::PlayerList] = &NetworkBase::Client_Handle_PLAYERLIST;
     client_command_handlers[NetworkCommand::PlayerInfo] = &NetworkBase::Client_Handle_PLAYERINFO;
     client_command_handlers[NetworkCommand::Ping] = &NetworkBase::Client_Handle_PING;
@@ -126,8 +196,11 @@ NetworkBase::NetworkBase()
     client_command_handlers[NetworkCommand::GameInfo] = &NetworkBase::Client_Handle_GAMEINFO;
     client_command_handlers[NetworkCommand::Token] = &NetworkBase::Client_Handle_TOKEN;
     client_command_handlers[NetworkCommand::ObjectsList] = &NetworkBase::Client_Handle_OBJECTS_LIST;
+    client_command_handlers[NetworkCommand::Objects] = &NetworkBase::Client_Handle_OBJECTS;
     client_command_handlers[NetworkCommand::Scripts] = &NetworkBase::Client_Handle_SCRIPTS;
     client_command_handlers[NetworkCommand::GameState] = &NetworkBase::Client_Handle_GAMESTATE;
+    client_command_handlers[NetworkCommand::ResyncDigest] = &NetworkBase::Client_Handle_RESYNC_DIGEST;
+    client_command_handlers[NetworkCommand::ResyncData] = &NetworkBase::Client_Handle_RESYNC_DATA;
 
     server_command_handlers[NetworkCommand::Auth] = &NetworkBase::Server_Handle_AUTH;
     server_command_handlers[NetworkCommand::Chat] = &NetworkBase::Server_Handle_CHAT;
@@ -138,6 +211,8 @@ NetworkBase::NetworkBase()
     server_command_handlers[NetworkCommand::MapRequest] = &NetworkBase::Server_Handle_MAPREQUEST;
     server_command_handlers[NetworkCommand::RequestGameState] = &NetworkBase::Server_Handle_REQUEST_GAMESTATE;
     server_command_handlers[NetworkCommand::Heartbeat] = &NetworkBase::Server_Handle_HEARTBEAT;
+    server_command_handlers[NetworkCommand::RequestResync] = &NetworkBase::Server_Handle_REQUEST_RESYNC;
+    server_command_handlers[NetworkCommand::ResyncParts] = &NetworkBase::Server_Handle_RESYNC_PARTS;
 
     _chat_log_fs << std::unitbuf;
     _server_log_fs << std::unitbuf;
@@ -192,12 +267,16 @@ void NetworkBase::Close()
         CloseServerLog();
         CloseConnection();
 
+        _compressedMaps.clear();
+        _mapDownload.reset();
+        _tickFrameActions.clear();
         client_connection_list.clear();
         GameActions::ClearQueue();
         GameActions::ResumeQueue();
         player_list.clear();
         group_list.clear();
         _serverTickData.clear();
+        _resync = ClientResync();
         _pendingPlayerLists.clear();
         _pendingPlayerInfo.clear();
 
@@ -230,6 +309,8 @@ void NetworkBase::CloseConnection()
     }
     else if (mode == NETWORK_MODE_SERVER)
     {
+        // The network thread must let go of the sockets before they are closed
+        _ioThread.reset();
         _listenSocket.reset();
         _advertiser.reset();
     }
@@ -358,6 +439,7 @@ bool NetworkBase::BeginServer(uint16_t port, const std::string& address)
     try
     {
         _listenSocket->Listen(address, port);
+        _ioThread = std::make_unique<NetworkIOThread>(*_listenSocket);
     }
     catch (const std::exception& ex)
     {
@@ -432,6 +514,11 @@ NetworkAuth NetworkBase::GetAuthStatus()
 
 uint32_t NetworkBase::GetServerTick()
 {
+    // Hold the client at the tick of the server state it is being resynchronised to
+    if (_resync.State == ResyncState::WaitingForTick || _resync.State == ResyncState::WaitingForData)
+    {
+        return std::min(_serverState.tick, _resync.Tick);
+    }
     return _serverState.tick;
 }
 
@@ -455,6 +542,7 @@ NetworkConnection* NetworkBase::GetPlayerConnection(uint8_t id)
 
 void NetworkBase::Update()
 {
+    const auto updateStartTime = std::chrono::high_resolution_clock::now();
     _closeLock = true;
 
     // Update is not necessarily called per game tick, maintain our own delta time
@@ -472,6 +560,10 @@ void NetworkBase::Update()
             break;
     }
 
+    const auto updateDuration = std::chrono::high_resolution_clock::now() - updateStartTime;
+    _updateDurations[_updateCount++ % _updateDurations.size()] = static_cast<uint32_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(updateDuration).count());
+
     // If the Close() was called during the update, close it for real
     _closeLock = false;
     if (_requireClose)
@@ -501,6 +593,14 @@ void NetworkBase::Flush()
 
 void NetworkBase::UpdateServer()
 {
+    SendCompressedMaps();
+
+    // Actions run while paused have no tick to be sent with
+    if (game_is_paused())
+    {
+        Server_Send_TICK_FRAMES(nullptr);
+    }
+
     for (auto& connection : client_connection_list)
     {
         // This can be called multiple times before the connection is removed.
@@ -513,6 +613,7 @@ void NetworkBase::UpdateServer()
         }
         else
         {
+            Server_Update_AUTH(*connection);
             DecayCooldown(connection->Player);
         }
     }
@@ -529,8 +630,8 @@ void NetworkBase::UpdateServer()
         _advertiser->Update();
     }
 
-    std::unique_ptr<ITcpSocket> tcpSocket = _listenSocket->Accept();
-    if (tcpSocket != nullptr)
+    std::unique_ptr<ITcpSocket> tcpSocket;
+    while ((tcpSocket = _ioThread->AcceptClient()) != nullptr)
     {
         AddClient(std::move(tcpSocket));
     }
@@ -646,6 +747,8 @@ void NetworkBase::UpdateClient()
                     Client_Send_HEARTBEAT(*_serverConnection);
                     _lastSentHeartbeat = ticks;
                 }
+
+                UpdateResync();
             }
 
             break;
@@ -714,6 +817,8 @@ const char* NetworkBase::FormatChat(NetworkPlayer* fromplayer, const char* text)
 
 void NetworkBase::SendPacketToClients(const NetworkPacket& packet, bool front, bool gameCmd)
 {
+    // Encoded once, every client's send queue references the same buffer.
+    const auto sharedPacket = packet.Encode();
     for (auto& client_connection : client_connection_list)
     {
         if (client_connection->IsDisconnected)
@@ -733,8 +838,23 @@ void NetworkBase::SendPacketToClients(const NetworkPacket& packet, bool front, b
                 continue;
             }
         }
-        auto packetCopy = packet;
-        client_connection->QueuePacket(std::move(packetCopy), front);
+        client_connection->QueuePacket(sharedPacket, front);
+    }
+}
+
+/**
+ * Sends a packet only to the clients that receive game actions and ticks in tick frames, or only to those that do not.
+ */
+void NetworkBase::SendTickPacketToClients(const NetworkPacket& packet, bool tickFrames)
+{
+    const auto sharedPacket = packet.Encode();
+    for (auto& client_connection : client_connection_list)
+    {
+        const bool supportsTickFrames = (client_connection->Features & NETWORK_FEATURE_TICK_FRAMES) != 0;
+        if (!client_connection->IsDisconnected && supportsTickFrames == tickFrames)
+        {
+            client_connection->QueuePacket(sharedPacket);
+        }
     }
 }
 
@@ -759,7 +879,9 @@ bool NetworkBase::CheckSRAND(uint32_t tick, uint32_t srand0)
 
     if (!storedTick.spriteHash.empty())
     {
-        rct_sprite_checksum checksum = sprite_checksum();
+        rct_sprite_checksum checksum = storedTick.spriteHashPart.has_value()
+            ? sprite_checksum_part(*storedTick.spriteHashPart)
+            : sprite_checksum();
         std::string clientSpriteHash = checksum.ToString();
         if (clientSpriteHash != storedTick.spriteHash)
         {
@@ -776,6 +898,11 @@ bool NetworkBase::IsDesynchronised()
     return _serverState.state == NetworkServerState::Desynced;
 }
 
+bool NetworkBase::IsMapLoaded() const
+{
+    return _clientMapLoaded;
+}
+
 bool NetworkBase::CheckDesynchronizaton()
 {
     // Check synchronisation
@@ -785,16 +912,16 @@ bool NetworkBase::CheckDesynchronizaton()
         _serverState.state = NetworkServerState::Desynced;
         _serverState.desyncTick = gCurrentTicks;
 
-        char str_desync[256];
-        format_string(str_desync, 256, STR_MULTIPLAYER_DESYNC, nullptr);
-
-        auto intent = Intent(WC_NETWORK_STATUS);
-        intent.putExtra(INTENT_EXTRA_MESSAGE, std::string{ str_desync });
-        context_open_intent(&intent);
-
-        if (!gConfigNetwork.stay_connected)
+        const bool recentlyResynced = _resync.LastResyncTick.has_value()
+            && gCurrentTicks - *_resync.LastResyncTick < RESYNC_COOLDOWN_TICKS;
+        if (_resync.State == ResyncState::None && !recentlyResynced)
         {
-            Close();
+            log_info("Desync detected at tick %u, requesting resync", gCurrentTicks);
+            Client_Send_REQUEST_RESYNC();
+        }
+        else
+        {
+            ReportDesynchronisation();
         }
 
         return true;
@@ -803,6 +930,43 @@ bool NetworkBase::CheckDesynchronizaton()
     return false;
 }
 
+void NetworkBase::ReportDesynchronisation()
+{
+    _resync.State = ResyncState::None;
+
+    char str_desync[256];
+    format_string(str_desync, 256, STR_MULTIPLAYER_DESYNC, nullptr);
+
+    auto intent = Intent(WC_NETWORK_STATUS);
+    intent.putExtra(INTENT_EXTRA_MESSAGE, std::string{ str_desync });
+    context_open_intent(&intent);
+
+    if (!gConfigNetwork.stay_connected)
+    {
+        Close();
+    }
+}
+
+void NetworkBase::UpdateResync()
+{
+    // Network updates happen between ticks, so once held at the tick of the server state our own state is comparable
+    if (_resync.State != ResyncState::WaitingForTick || gCurrentTicks != _resync.Tick)
+        return;
+
+    IGameStateSnapshots* snapshots = GetContext()->GetGameStateSnapshots();
+    auto clientState = snapshots->CaptureResync(gCurrentTicks);
+    auto parts = snapshots->CompareDigests(_resync.ServerDigest, snapshots->GetDigest(*clientState));
+    _resync.ServerDigest = {};
+
+    log_info(
+        "Resync at tick %u: %u tile blocks, %u entities and %u rides differ", _resync.Tick,
+        static_cast<uint32_t>(parts.tileBlocks.size()), static_cast<uint32_t>(parts.entities.size()),
+        static_cast<uint32_t>(parts.rides.size()));
+
+    Client_Send_RESYNC_PARTS(parts);
+    _resync.State = ResyncState::WaitingForData;
+}
+
 void NetworkBase::RequestStateSnapshot()
 {
     log_info("Requesting game state for tick %u", _serverState.desyncTick);
@@ -1201,6 +1365,25 @@ void NetworkBase::Client_Send_RequestGameState(uint32_t tick)
     _serverConnection->QueuePacket(std::move(packet));
 }
 
+void NetworkBase::Client_Send_REQUEST_RESYNC()
+{
+    log_verbose("Requesting resync from server");
+
+    NetworkPacket packet(NetworkCommand::RequestResync);
+    _serverConnection->QueuePacket(std::move(packet));
+    _resync.State = ResyncState::Requested;
+}
+
+void NetworkBase::Client_Send_RESYNC_PARTS(GameStateResyncParts_t& parts)
+{
+    DataSerialiser stream(true);
+    GetContext()->GetGameStateSnapshots()->SerialiseResyncParts(parts, stream);
+
+    NetworkPacket packet(NetworkCommand::ResyncParts);
+    packet << stream;
+    _serverConnection->QueuePacket(std::move(packet));
+}
+
 void NetworkBase::Client_Send_TOKEN()
 {
     log_verbose("requesting token");
@@ -1220,6 +1403,7 @@ void NetworkBase::Client_Send_AUTH(
     assert(signature.size() <= static_cast<size_t>(UINT32_MAX));
     packet << static_cast<uint32_t>(signature.size());
     packet.Write(signature.data(), signature.size());
+    packet << NETWORK_FEATURES;
     _serverConnection->AuthStatus = NetworkAuth::Requested;
     _serverConnection->QueuePacket(std::move(packet));
 }
@@ -1275,6 +1459,38 @@ void NetworkBase::Server_Send_OBJECTS_LIST(
     }
 }
 
+/**
+ * Sends the packed custom objects a client is missing ahead of its map, so the map itself does not have to carry them
+ * and can be shared with every other client joining on the same tick.
+ */
+void NetworkBase::Server_Send_OBJECTS(
+    NetworkConnection& connection, const std::vector<const ObjectRepositoryItem*>& objects) const
+{
+    if (objects.empty())
+    {
+        return;
+    }
+
+    auto& repo = GetContext()->GetObjectRepository();
+    auto packedObjects = objects;
+    OpenRCT2::MemoryStream ms;
+    repo.WritePackedObjects(&ms, packedObjects);
+
+    const auto* data = static_cast<const uint8_t*>(ms.GetData());
+    const auto size = static_cast<uint32_t>(ms.GetLength());
+    log_verbose("Server sends %u objects (%u bytes)", static_cast<uint32_t>(objects.size()), size);
+
+    for (uint32_t offset = 0; offset < size;)
+    {
+        const uint32_t chunkSize = std::min<uint32_t>(size - offset, CHUNK_SIZE);
+        NetworkPacket packet(NetworkCommand::Objects);
+        packet << static_cast<uint32_t>(objects.size()) << size << offset;
+        packet.Write(data + offset, chunkSize);
+        connection.QueuePacket(std::move(packet));
+        offset += chunkSize;
+    }
+}
+
 void NetworkBase::Server_Send_SCRIPTS(NetworkConnection& connection) const
 {
     NetworkPacket packet(NetworkCommand::Scripts);
@@ -1335,6 +1551,15 @@ NetworkStats_t NetworkBase::GetStats() const
                 stats.bytesReceived[n] += connection->Stats.bytesReceived[n];
                 stats.bytesSent[n] += connection->Stats.bytesSent[n];
             }
+            for (size_t n = 0; n < EnumValue(NetworkCommand::Max); n++)
+            {
+                auto& commandStats = stats.commands[n];
+                const auto& connectionCommandStats = connection->Stats.commands[n];
+                commandStats.packetsReceived += connectionCommandStats.packetsReceived;
+                commandStats.bytesReceived += connectionCommandStats.bytesReceived;
+                commandStats.packetsSent += connectionCommandStats.packetsSent;
+                commandStats.bytesSent += connectionCommandStats.bytesSent;
+            }
         }
     }
     return stats;
@@ -1360,53 +1585,223 @@ void NetworkBase::Server_Send_AUTH(NetworkConnection& connection)
     }
 }
 
-void NetworkBase::Server_Send_MAP(NetworkConnection* connection)
+static std::unique_ptr<JobPool> _mapCompressionJobs;
+
+static JobPool& GetMapCompressionJobPool()
 {
-    std::vector<const ObjectRepositoryItem*> objects;
-    if (connection)
+    if (_mapCompressionJobs == nullptr)
     {
-        objects = connection->RequestedObjects;
+        _mapCompressionJobs = std::make_unique<JobPool>(1);
     }
-    else
+    return *_mapCompressionJobs;
+}
+
+/**
+ * Deflates the map into chunks that each fit into a packet. Every chunk is handed over as soon as it is complete, so it
+ * can be sent while the rest is being compressed. The last chunk is passed with last set.
+ */
+static bool DeflateMapChunks(
+    const uint8_t* data, size_t size, const std::function<void(std::vector<uint8_t>&& chunk, bool last)>& onChunk)
+{
+    z_stream stream{};
+    if (deflateInit(&stream, Z_DEFAULT_COMPRESSION) != Z_OK)
+    {
+        log_error("Failed to initialise map compression");
+        return false;
+    }
+
+    stream.next_in = const_cast<Bytef*>(data);
+    stream.avail_in = static_cast<uInt>(size);
+
+    std::vector<uint8_t> chunk(CHUNK_SIZE);
+    stream.next_out = chunk.data();
+    stream.avail_out = static_cast<uInt>(chunk.size());
+    while (true)
+    {
+        auto ret = deflate(&stream, Z_FINISH);
+        if (ret == Z_STREAM_END)
+        {
+            chunk.resize(chunk.size() - stream.avail_out);
+            onChunk(std::move(chunk), true);
+            break;
+        }
+        if (ret != Z_OK && ret != Z_BUF_ERROR)
+        {
+            log_error("Failed to compress map");
+            deflateEnd(&stream);
+            return false;
+        }
+        if (stream.avail_out == 0)
+        {
+            onChunk(std::move(chunk), false);
+            chunk = std::vector<uint8_t>(CHUNK_SIZE);
+            stream.next_out = chunk.data();
+            stream.avail_out = static_cast<uInt>(chunk.size());
+        }
+    }
+
+    log_verbose(
+        "Compressed map of size %u bytes to %u bytes", static_cast<uint32_t>(size), static_cast<uint32_t>(stream.total_out));
+    deflateEnd(&stream);
+    return true;
+}
+
+static NetworkPacket CreateMapPacket(
+    uint32_t uncompressedSize, uint32_t offset, bool last, const std::vector<uint8_t>& chunk)
+{
+    NetworkPacket packet(NetworkCommand::Map);
+    packet << uncompressedSize << offset << static_cast<uint8_t>(last ? NETWORK_MAP_FLAG_LAST_CHUNK : 0);
+    packet.Write(chunk.data(), chunk.size());
+    return packet;
+}
+
+void NetworkBase::Server_Send_MAP(NetworkConnection* connection)
+{
+    // Actions that are part of the map must not reach the clients loading it after the map
+    Server_Send_TICK_FRAMES(nullptr);
+
+    if (connection == nullptr)
     {
         // This will send all custom objects to connected clients
         // TODO: fix it so custom objects negotiation is performed even in this case.
         auto context = GetContext();
         auto& objManager = context->GetObjectManager();
-        objects = objManager.GetPackableObjects();
+        for (auto& packet : save_for_network(objManager.GetPackableObjects()))
+        {
+            SendPacketToClients(packet);
+        }
+        return;
+    }
+
+    // Clients that can install objects on their own get them separately, so their map carries no objects at all
+    static const std::vector<const ObjectRepositoryItem*> noObjects;
+    const bool streamObjects = (connection->Features & NETWORK_FEATURE_OBJECT_STREAM) != 0;
+    if (streamObjects)
+    {
+        Server_Send_OBJECTS(*connection, connection->RequestedObjects);
     }
 
-    auto header = save_for_network(objects);
-    if (header.empty())
+    // Clients joining on the same tick share one map, which is compressed on a worker thread while the game keeps
+    // running. Packets queued for the connection in the meantime are held back and sent after the map.
+    const auto& objects = streamObjects ? noObjects : connection->RequestedObjects;
+    auto it = std::find_if(_compressedMaps.begin(), _compressedMaps.end(), [&objects](const auto& compressedMap) {
+        return compressedMap->Shareable && compressedMap->Tick == gCurrentTicks && compressedMap->Objects == objects;
+    });
+
+    std::shared_ptr<CompressedMap> compressedMap;
+    if (it != _compressedMaps.end())
+    {
+        compressedMap = *it;
+        log_verbose("Sharing map of tick %u with another joining client", compressedMap->Tick);
+    }
+    else
     {
-        if (connection)
+        const auto saveStartTime = std::chrono::high_resolution_clock::now();
+        bool RLEState = gUseRLE;
+        gUseRLE = false;
+        auto ms = std::make_shared<OpenRCT2::MemoryStream>();
+        bool saved = SaveMap(ms.get(), objects);
+        gUseRLE = RLEState;
+        const std::chrono::duration<double, std::milli> saveTime = std::chrono::high_resolution_clock::now()
+            - saveStartTime;
+        if (!saved)
         {
+            log_warning("Failed to export map.");
             connection->SetLastDisconnectReason(STR_MULTIPLAYER_CONNECTION_CLOSED);
             connection->Socket->Disconnect();
+            return;
         }
-        return;
+
+        compressedMap = std::make_shared<CompressedMap>();
+        compressedMap->Tick = gCurrentTicks;
+        compressedMap->UncompressedSize = static_cast<uint32_t>(ms->GetLength());
+        compressedMap->Objects = objects;
+        compressedMap->SerialiseTimeMs = saveTime.count();
+        _compressedMaps.push_back(compressedMap);
+
+        GetMapCompressionJobPool().AddTask([compressedMap, ms]() {
+            const auto compressStartTime = std::chrono::high_resolution_clock::now();
+            auto onChunk = [&compressedMap, compressStartTime](std::vector<uint8_t>&& chunk, bool last) {
+                const std::chrono::duration<double, std::milli> compressTime = std::chrono::high_resolution_clock::now()
+                    - compressStartTime;
+                std::lock_guard<std::mutex> lock(compressedMap->Mutex);
+                compressedMap->Chunks.push_back(std::move(chunk));
+                compressedMap->CompressTimeMs = compressTime.count();
+                compressedMap->Finished = last;
+            };
+            if (!DeflateMapChunks(static_cast<const uint8_t*>(ms->GetData()), ms->GetLength(), onChunk))
+            {
+                std::lock_guard<std::mutex> lock(compressedMap->Mutex);
+                compressedMap->Failed = true;
+            }
+        });
     }
-    size_t chunksize = CHUNK_SIZE;
-    for (size_t i = 0; i < header.size(); i += chunksize)
+
+    compressedMap->Receivers.push_back({ connection, 0, 0, std::chrono::high_resolution_clock::now() });
+    connection->HoldPackets();
+}
+
+/**
+ * Sends the chunks compressed so far to the connections waiting for them, the packets held back for a connection are
+ * released after its last chunk.
+ */
+void NetworkBase::SendCompressedMaps()
+{
+    for (auto it = _compressedMaps.begin(); it != _compressedMaps.end();)
     {
-        size_t datasize = std::min(chunksize, header.size() - i);
-        NetworkPacket packet(NetworkCommand::Map);
-        packet << static_cast<uint32_t>(header.size()) << static_cast<uint32_t>(i);
-        packet.Write(&header[i], datasize);
-        if (connection)
+        auto& compressedMap = **it;
+        std::lock_guard<std::mutex> lock(compressedMap.Mutex);
+
+        bool allSent = compressedMap.Finished || compressedMap.Failed;
+        for (auto& receiver : compressedMap.Receivers)
+        {
+            if (compressedMap.Failed)
+            {
+                receiver.Connection->SetLastDisconnectReason(STR_MULTIPLAYER_CONNECTION_CLOSED);
+                receiver.Connection->Socket->Disconnect();
+                continue;
+            }
+
+            std::vector<NetworkPacket> packets;
+            for (; receiver.ChunksSent < compressedMap.Chunks.size(); receiver.ChunksSent++)
+            {
+                const auto& chunk = compressedMap.Chunks[receiver.ChunksSent];
+                const bool last = compressedMap.Finished && receiver.ChunksSent + 1 == compressedMap.Chunks.size();
+                packets.push_back(CreateMapPacket(compressedMap.UncompressedSize, receiver.BytesSent, last, chunk));
+                receiver.BytesSent += static_cast<uint32_t>(chunk.size());
+            }
+            receiver.Connection->QueuePacketsAhead(std::move(packets));
+
+            if (compressedMap.Finished)
+            {
+                receiver.Connection->ReleasePackets();
+
+                const std::chrono::duration<double, std::milli> transferTime = std::chrono::high_resolution_clock::now()
+                    - receiver.RequestTime;
+                _joinTimings.push_back({ compressedMap.Tick, compressedMap.UncompressedSize, receiver.BytesSent,
+                                         compressedMap.SerialiseTimeMs, compressedMap.CompressTimeMs,
+                                         transferTime.count() });
+                if (_joinTimings.size() > JOIN_TIMINGS_KEPT)
+                {
+                    _joinTimings.pop_front();
+                }
+            }
+        }
+
+        if (allSent)
         {
-            connection->QueuePacket(std::move(packet));
+            it = _compressedMaps.erase(it);
         }
         else
         {
-            SendPacketToClients(packet);
+            it++;
         }
     }
 }
 
-std::vector<uint8_t> NetworkBase::save_for_network(const std::vector<const ObjectRepositoryItem*>& objects) const
+std::vector<NetworkPacket> NetworkBase::save_for_network(const std::vector<const ObjectRepositoryItem*>& objects) const
 {
-    std::vector<uint8_t> header;
+    std::vector<NetworkPacket> packets;
     bool RLEState = gUseRLE;
     gUseRLE = false;
 
@@ -1414,29 +1809,21 @@ std::vector<uint8_t> NetworkBase::save_for_network(const std::vector<const Objec
     if (!SaveMap(&ms, objects))
     {
         log_warning("Failed to export map.");
-        return header;
+        return packets;
     }
     gUseRLE = RLEState;
 
-    const void* data = ms.GetData();
-    int32_t size = ms.GetLength();
-
-    auto compressed = util_zlib_deflate(static_cast<const uint8_t*>(data), size);
-    if (compressed != std::nullopt)
-    {
-        std::string headerString = "open2_sv6_zlib";
-        header.resize(headerString.size() + 1 + compressed->size());
-        std::memcpy(&header[0], headerString.c_str(), headerString.size() + 1);
-        std::memcpy(&header[headerString.size() + 1], compressed->data(), compressed->size());
-        log_verbose("Sending map of size %u bytes, compressed to %u bytes", size, headerString.size() + 1 + compressed->size());
-    }
-    else
+    const auto uncompressedSize = static_cast<uint32_t>(ms.GetLength());
+    uint32_t offset = 0;
+    auto onChunk = [&](std::vector<uint8_t>&& chunk, bool last) {
+        packets.push_back(CreateMapPacket(uncompressedSize, offset, last, chunk));
+        offset += static_cast<uint32_t>(chunk.size());
+    };
+    if (!DeflateMapChunks(static_cast<const uint8_t*>(ms.GetData()), ms.GetLength(), onChunk))
     {
-        log_warning("Failed to compress the data, falling back to non-compressed sv6.");
-        header.resize(size);
-        std::memcpy(header.data(), data, size);
+        packets.clear();
     }
-    return header;
+    return packets;
 }
 
 void NetworkBase::Client_Send_CHAT(const char* text)
@@ -1483,50 +1870,138 @@ void NetworkBase::Client_Send_GAME_ACTION(const GameAction* action)
         _gameActionCallbacks.insert(std::make_pair(networkId, action->GetCallback()));
     }
 
-    DataSerialiser stream(true);
-    action->Serialise(stream);
-
-    packet << gCurrentTicks << action->GetType() << stream;
+    packet << gCurrentTicks << action->GetType();
+    WriteGameAction(packet, action);
     _serverConnection->QueuePacket(std::move(packet));
 }
 
 void NetworkBase::Server_Send_GAME_ACTION(const GameAction* action)
 {
-    NetworkPacket packet(NetworkCommand::GameAction);
+    // The game state has changed, clients joining later in this tick need a new map
+    for (auto& compressedMap : _compressedMaps)
+    {
+        compressedMap->Shareable = false;
+    }
 
-    DataSerialiser stream(true);
-    action->Serialise(stream);
+    NetworkPacket packet(NetworkCommand::GameAction);
+    packet << gCurrentTicks << action->GetType();
+    WriteGameAction(packet, action);
 
-    packet << gCurrentTicks << action->GetType() << stream;
+    // Clients that support tick frames receive all actions of a tick together with the next tick
+    SendTickPacketToClients(packet, false);
+    _tickFrameActions.push_back(std::move(packet));
+}
 
-    SendPacketToClients(packet);
+/**
+ * Serialises the action through a stream that is reused for every action, rather than a new stream per action whose
+ * buffer is allocated only to be copied into the packet.
+ */
+void NetworkBase::WriteGameAction(NetworkPacket& packet, const GameAction* action)
+{
+    _gameActionStream.SetPosition(0);
+    DataSerialiser stream(true, _gameActionStream);
+    action->Serialise(stream);
+    packet.Write(_gameActionStream.GetData(), static_cast<size_t>(_gameActionStream.GetPosition()));
 }
 
 void NetworkBase::Server_Send_TICK()
 {
-    NetworkPacket packet(NetworkCommand::Tick);
-    packet << gCurrentTicks << scenario_rand_state().s0;
-    uint32_t flags = 0;
+    bool hasTickFrameClients = false;
+    bool hasOtherClients = false;
+    for (const auto& client_connection : client_connection_list)
+    {
+        if (client_connection->AuthStatus == NetworkAuth::Ok)
+        {
+            const bool supportsTickFrames = (client_connection->Features & NETWORK_FEATURE_TICK_FRAMES) != 0;
+            hasTickFrameClients |= supportsTickFrames;
+            hasOtherClients |= !supportsTickFrames;
+        }
+    }
+
+    const uint32_t srand0 = scenario_rand_state().s0;
+
     // Simple counter which limits how often a sprite checksum gets sent.
     // This can get somewhat expensive, so we don't want to push it every tick in release,
     // but debug version can check more often.
     static int32_t checksum_counter = 0;
     checksum_counter++;
-    if (checksum_counter >= 100)
+    const bool sendChecksum = checksum_counter >= 100;
+    if (sendChecksum)
     {
         checksum_counter = 0;
-        flags |= NETWORK_TICK_FLAG_CHECKSUMS;
     }
-    // Send flags always, so we can understand packet structure on the other end,
-    // and allow for some expansion.
-    packet << flags;
-    if (flags & NETWORK_TICK_FLAG_CHECKSUMS)
+
+    if (hasOtherClients)
     {
-        rct_sprite_checksum checksum = sprite_checksum();
-        packet.WriteString(checksum.ToString().c_str());
+        NetworkPacket packet(NetworkCommand::Tick);
+        packet << gCurrentTicks << srand0;
+        uint32_t flags = sendChecksum ? NETWORK_TICK_FLAG_CHECKSUMS : 0;
+        // Send flags always, so we can understand packet structure on the other end,
+        // and allow for some expansion.
+        packet << flags;
+        if (flags & NETWORK_TICK_FLAG_CHECKSUMS)
+        {
+            rct_sprite_checksum checksum = sprite_checksum();
+            packet.WriteString(checksum.ToString().c_str());
+        }
+        SendTickPacketToClients(packet, false);
     }
 
-    SendPacketToClients(packet);
+    if (hasTickFrameClients)
+    {
+        // Tick frames check a different part of the entities every tick, which covers all of them in fewer ticks than
+        // the full checksum is sent in, for a fraction of its cost per tick.
+        const auto part = static_cast<uint8_t>(gCurrentTicks % SPRITE_CHECKSUM_PARTS);
+        NetworkPacket packet(NetworkCommand::Tick);
+        packet << gCurrentTicks << srand0 << static_cast<uint32_t>(NETWORK_TICK_FLAG_CHECKSUM_PART) << part;
+        packet.WriteString(sprite_checksum_part(part).ToString().c_str());
+        Server_Send_TICK_FRAMES(&packet);
+    }
+    else
+    {
+        _tickFrameActions.clear();
+    }
+}
+
+/**
+ * Sends the pending game actions and the given tick, if any, in as few packets as they fit in. The tick is always in
+ * the last frame so the client has every action before it can run past their tick.
+ */
+void NetworkBase::Server_Send_TICK_FRAMES(const NetworkPacket* tickPacket)
+{
+    if (tickPacket == nullptr && _tickFrameActions.empty())
+        return;
+
+    const size_t tickSize = tickPacket != nullptr ? tickPacket->Data.size() : 0;
+    auto it = _tickFrameActions.begin();
+    do
+    {
+        size_t frameSize = sizeof(uint8_t) + sizeof(uint16_t) + tickSize;
+        auto last = it;
+        while (last != _tickFrameActions.end()
+               && (last == it || frameSize + sizeof(uint16_t) + last->Data.size() <= CHUNK_SIZE))
+        {
+            frameSize += sizeof(uint16_t) + last->Data.size();
+            last++;
+        }
+
+        const bool hasTick = tickPacket != nullptr && last == _tickFrameActions.end();
+        NetworkPacket frame(NetworkCommand::TickFrame);
+        frame << static_cast<uint8_t>(hasTick ? NETWORK_TICK_FRAME_FLAG_TICK : 0)
+              << static_cast<uint16_t>(std::distance(it, last));
+        for (; it != last; it++)
+        {
+            frame << static_cast<uint16_t>(it->Data.size());
+            frame.Write(it->Data.data(), it->Data.size());
+        }
+        if (hasTick)
+        {
+            frame.Write(tickPacket->Data.data(), tickPacket->Data.size());
+        }
+        SendTickPacketToClients(frame, true);
+    } while (it != _tickFrameActions.end());
+
+    _tickFrameActions.clear();
 }
 
 void NetworkBase::Server_Send_PLAYERINFO(int32_t playerId)
@@ -1599,6 +2074,188 @@ json_t NetworkBase::GetServerInfoAsJson() const
     return jsonObj;
 }
 
+static const char* GetCommandName(NetworkCommand command)
+{
+    switch (command)
+    {
+        case NetworkCommand::Auth:
+            return "auth";
+        case NetworkCommand::Map:
+            return "map";
+        case NetworkCommand::Chat:
+            return "chat";
+        case NetworkCommand::Tick:
+            return "tick";
+        case NetworkCommand::PlayerList:
+            return "playerList";
+        case NetworkCommand::Ping:
+            return "ping";
+        case NetworkCommand::PingList:
+            return "pingList";
+        case NetworkCommand::DisconnectMessage:
+            return "disconnectMessage";
+        case NetworkCommand::GameInfo:
+            return "gameInfo";
+        case NetworkCommand::ShowError:
+            return "showError";
+        case NetworkCommand::GroupList:
+            return "groupList";
+        case NetworkCommand::Event:
+            return "event";
+        case NetworkCommand::Token:
+            return "token";
+        case NetworkCommand::ObjectsList:
+            return "objectsList";
+        case NetworkCommand::MapRequest:
+            return "mapRequest";
+        case NetworkCommand::GameAction:
+            return "gameAction";
+        case NetworkCommand::PlayerInfo:
+            return "playerInfo";
+        case NetworkCommand::RequestGameState:
+            return "requestGameState";
+        case NetworkCommand::GameState:
+            return "gameState";
+        case NetworkCommand::Scripts:
+            return "scripts";
+        case NetworkCommand::Heartbeat:
+            return "heartbeat";
+        case NetworkCommand::RequestResync:
+            return "requestResync";
+        case NetworkCommand::ResyncDigest:
+            return "resyncDigest";
+        case NetworkCommand::ResyncParts:
+            return "resyncParts";
+        case NetworkCommand::ResyncData:
+            return "resyncData";
+        case NetworkCommand::TickFrame:
+            return "tickFrame";
+        case NetworkCommand::Objects:
+            return "objects";
+        default:
+            return nullptr;
+    }
+}
+
+static json_t GetTrafficAsJson(const NetworkStats_t& stats)
+{
+    static constexpr const char* groupNames[] = { "total", "base", "commands", "mapData" };
+    static_assert(std::size(groupNames) == EnumValue(NetworkStatisticsGroup::Max));
+
+    json_t bytesReceived = json_t::object();
+    json_t bytesSent = json_t::object();
+    for (size_t n = 0; n < std::size(groupNames); n++)
+    {
+        bytesReceived[groupNames[n]] = stats.bytesReceived[n];
+        bytesSent[groupNames[n]] = stats.bytesSent[n];
+    }
+    return { { "bytesReceived", bytesReceived }, { "bytesSent", bytesSent } };
+}
+
+/**
+ * Returns the traffic and timings of the network for monitoring a server, see the network_stats console command.
+ */
+NetworkSendBacklog NetworkBase::GetSendBacklog() const
+{
+    NetworkSendBacklog total;
+    auto addBacklog = [&total](const NetworkConnection& connection) {
+        const auto backlog = connection.GetSendBacklog();
+        total.QueuedPackets += backlog.QueuedPackets;
+        total.QueuedBytes += backlog.QueuedBytes;
+        total.HeldPackets += backlog.HeldPackets;
+    };
+
+    if (mode == NETWORK_MODE_CLIENT)
+    {
+        addBacklog(*_serverConnection);
+    }
+    for (const auto& connection : client_connection_list)
+    {
+        addBacklog(*connection);
+    }
+    return total;
+}
+
+json_t NetworkBase::GetStatsAsJson() const
+{
+    const auto stats = GetStats();
+    json_t jsonObj = GetTrafficAsJson(stats);
+    jsonObj["mode"] = mode == NETWORK_MODE_SERVER ? "server" : mode == NETWORK_MODE_CLIENT ? "client" : "none";
+    jsonObj["tick"] = gCurrentTicks;
+
+    json_t commands = json_t::object();
+    for (size_t n = 0; n < EnumValue(NetworkCommand::Max); n++)
+    {
+        const auto& commandStats = stats.commands[n];
+        const char* name = GetCommandName(static_cast<NetworkCommand>(n));
+        if (name != nullptr && (commandStats.packetsReceived != 0 || commandStats.packetsSent != 0))
+        {
+            commands[name] = {
+                { "packetsReceived", commandStats.packetsReceived },
+                { "bytesReceived", commandStats.bytesReceived },
+                { "packetsSent", commandStats.packetsSent },
+                { "bytesSent", commandStats.bytesSent },
+            };
+        }
+    }
+    jsonObj["commands"] = commands;
+
+    const size_t numUpdates = std::min(_updateCount, _updateDurations.size());
+    uint64_t totalUpdateTime = 0;
+    uint32_t maxUpdateTime = 0;
+    for (size_t i = 0; i < numUpdates; i++)
+    {
+        totalUpdateTime += _updateDurations[i];
+        maxUpdateTime = std::max(maxUpdateTime, _updateDurations[i]);
+    }
+    jsonObj["update"] = {
+        { "count", numUpdates },
+        { "averageUs", numUpdates != 0 ? totalUpdateTime / numUpdates : 0 },
+        { "maxUs", maxUpdateTime },
+    };
+
+    auto getConnectionAsJson = [](const NetworkConnection& connection) {
+        const auto backlog = connection.GetSendBacklog();
+        json_t connectionObj = GetTrafficAsJson(connection.Stats);
+        connectionObj["ping"] = connection.PingTime;
+        connectionObj["queuedPackets"] = backlog.QueuedPackets;
+        connectionObj["queuedBytes"] = backlog.QueuedBytes;
+        connectionObj["heldPackets"] = backlog.HeldPackets;
+        if (connection.Player != nullptr)
+        {
+            connectionObj["player"] = connection.Player->Id;
+            connectionObj["name"] = connection.Player->Name;
+        }
+        return connectionObj;
+    };
+
+    json_t connections = json_t::array();
+    if (mode == NETWORK_MODE_CLIENT)
+    {
+        connections.push_back(getConnectionAsJson(*_serverConnection));
+    }
+    for (const auto& connection : client_connection_list)
+    {
+        connections.push_back(getConnectionAsJson(*connection));
+    }
+    jsonObj["connections"] = connections;
+
+    json_t joins = json_t::array();
+    for (const auto& join : _joinTimings)
+    {
+        joins.push_back({
+            { "tick", join.Tick },
+            { "mapSize", join.MapSize },
+            { "compressedMapSize", join.CompressedMapSize },
+            { "serialiseMs", join.SerialiseTimeMs },
+            { "compressMs", join.CompressTimeMs },
+            { "transferMs", join.TransferTimeMs },
+        });
+    }
+    jsonObj["joins"] = joins;
+    return jsonObj;
+}
+
 void NetworkBase::Server_Send_GAMEINFO(NetworkConnection& connection)
 {
     NetworkPacket packet(NetworkCommand::GameInfo);
@@ -1658,8 +2315,29 @@ void NetworkBase::Server_Send_EVENT_PLAYER_DISCONNECTED(const char* playerName,
 
 bool NetworkBase::ProcessConnection(NetworkConnection& connection)
 {
-    NetworkReadPacket packetStatus;
-    do
+    if (connection.IO != nullptr)
+    {
+        // The network thread has read and will send the packets, only the complete ones are handled here
+        while (connection.ReceivePacket(connection.InboundPacket))
+        {
+            ProcessPacket(connection, connection.InboundPacket);
+            if (connection.Socket == nullptr)
+            {
+                return false;
+            }
+        }
+        if (connection.IO->Disconnected)
+        {
+            if (!connection.GetLastDisconnectReason())
+            {
+                connection.SetLastDisconnectReason(STR_MULTIPLAYER_CONNECTION_CLOSED);
+            }
+            return false;
+        }
+    }
+
+    NetworkReadPacket packetStatus = NetworkReadPacket::NoData;
+    while (connection.IO == nullptr)
     {
         packetStatus = connection.ReadPacket();
         switch (packetStatus)
@@ -1686,7 +2364,9 @@ bool NetworkBase::ProcessConnection(NetworkConnection& connection)
                 // could not read anything from socket
                 break;
         }
-    } while (packetStatus == NetworkReadPacket::Success);
+        if (packetStatus != NetworkReadPacket::Success)
+            break;
+    }
 
     connection.SendQueuedPackets();
 
@@ -1922,9 +2602,19 @@ void NetworkBase::ProcessDisconnectedClients()
         auto& connection = *it;
         if (connection->IsDisconnected)
         {
+            for (auto& compressedMap : _compressedMaps)
+            {
+                auto& receivers = compressedMap->Receivers;
+                receivers.erase(
+                    std::remove_if(
+                        receivers.begin(), receivers.end(),
+                        [&connection](const auto& receiver) { return receiver.Connection == connection.get(); }),
+                    receivers.end());
+            }
             ServerClientDisconnected(connection);
             RemovePlayer(connection);
 
+            _ioThread->RemoveConnection(*connection);
             it = client_connection_list.erase(it);
         }
         else
@@ -1944,6 +2634,7 @@ void NetworkBase::AddClient(std::unique_ptr<ITcpSocket>&& socket)
     // Store connection
     auto connection = std::make_unique<NetworkConnection>();
     connection->Socket = std::move(socket);
+    _ioThread->AddConnection(*connection);
 
     client_connection_list.push_back(std::move(connection));
 }
@@ -2203,6 +2894,104 @@ void NetworkBase::Server_Handle_REQUEST_GAMESTATE(NetworkConnection& connection,
     }
 }
 
+/**
+ * Queues data that may exceed the packet size limit as chunks, read them with ReadChunkedPacket.
+ */
+static void QueueChunkedPackets(NetworkConnection& connection, NetworkCommand command, uint32_t tick, const MemoryStream& data)
+{
+    const uint32_t length = static_cast<uint32_t>(data.GetLength());
+    uint32_t bytesSent = 0;
+    do
+    {
+        const uint32_t dataSize = std::min(CHUNK_SIZE, length - bytesSent);
+
+        NetworkPacket packet(command);
+        packet << tick << length << bytesSent << dataSize;
+        packet.Write(static_cast<const uint8_t*>(data.GetData()) + bytesSent, dataSize);
+        connection.QueuePacket(std::move(packet));
+
+        bytesSent += dataSize;
+    } while (bytesSent < length);
+}
+
+/**
+ * Appends a chunk queued by QueueChunkedPackets to the buffer, returns true once all data has been received.
+ */
+static bool ReadChunkedPacket(NetworkPacket& packet, MemoryStream& buffer, uint32_t& tick)
+{
+    uint32_t totalSize;
+    uint32_t offset;
+    uint32_t dataSize;
+    packet >> tick >> totalSize >> offset >> dataSize;
+
+    const uint8_t* data = packet.Read(dataSize);
+    if (data == nullptr)
+        return false;
+
+    if (offset == 0)
+    {
+        buffer = MemoryStream();
+    }
+    buffer.SetPosition(offset);
+    buffer.Write(data, dataSize);
+
+    if (buffer.GetLength() != totalSize)
+        return false;
+
+    buffer.SetPosition(0);
+    return true;
+}
+
+void NetworkBase::Server_Handle_REQUEST_RESYNC(NetworkConnection& connection, NetworkPacket& packet)
+{
+    if (connection.Player == nullptr)
+        return;
+
+    // Packets are processed between ticks, the state is captured as it is at the start of the current tick which the
+    // client reaches by following the ticks it receives after the digest.
+    IGameStateSnapshots* snapshots = GetContext()->GetGameStateSnapshots();
+    connection.Resync = snapshots->CaptureResync(gCurrentTicks);
+    auto digest = snapshots->GetDigest(*connection.Resync);
+
+    MemoryStream digestMemory;
+    DataSerialiser ds(true, digestMemory);
+    snapshots->SerialiseDigest(digest, ds);
+
+    log_info("Resyncing %s at tick %u", connection.Player->Name.c_str(), digest.tick);
+    QueueChunkedPackets(connection, NetworkCommand::ResyncDigest, digest.tick, digestMemory);
+}
+
+void NetworkBase::Server_Handle_RESYNC_PARTS(NetworkConnection& connection, NetworkPacket& packet)
+{
+    if (connection.Resync == nullptr)
+        return;
+
+    IGameStateSnapshots* snapshots = GetContext()->GetGameStateSnapshots();
+
+    GameStateResyncParts_t parts;
+    try
+    {
+        DataSerialiser stream(false);
+        const size_t size = packet.Header.Size - packet.BytesRead;
+        stream.GetStream().WriteArray(packet.Read(size), size);
+        stream.GetStream().SetPosition(0);
+        snapshots->SerialiseResyncParts(parts, stream);
+    }
+    catch (const std::exception& e)
+    {
+        log_warning("Invalid resync request: %s", e.what());
+        connection.Resync.reset();
+        return;
+    }
+
+    MemoryStream dataMemory;
+    DataSerialiser ds(true, dataMemory);
+    snapshots->SerialiseResyncData(*connection.Resync, parts, ds);
+    connection.Resync.reset();
+
+    QueueChunkedPackets(connection, NetworkCommand::ResyncData, parts.tick, dataMemory);
+}
+
 void NetworkBase::Server_Handle_HEARTBEAT(NetworkConnection& connection, NetworkPacket& packet)
 {
     log_verbose("Client %s heartbeat", connection.Socket->GetHostName());
@@ -2361,6 +3150,53 @@ void NetworkBase::Client_Handle_OBJECTS_LIST(NetworkConnection& connection, Netw
     }
 }
 
+void NetworkBase::Client_Handle_OBJECTS(NetworkConnection& connection, NetworkPacket& packet)
+{
+    uint32_t count = 0;
+    uint32_t size = 0;
+    uint32_t offset = 0;
+    packet >> count >> size >> offset;
+    const size_t chunkSize = packet.Header.Size - packet.BytesRead;
+    if (offset == 0)
+    {
+        _objectsDownload.clear();
+        _objectsDownload.reserve(size);
+    }
+
+    if (count > OBJECT_ENTRY_COUNT || offset != _objectsDownload.size() || chunkSize > size - offset)
+    {
+        connection.SetLastDisconnectReason(STR_MULTIPLAYER_SERVER_INVALID_REQUEST);
+        connection.Socket->Disconnect();
+        log_warning("Server sent invalid objects");
+        _objectsDownload = {};
+        return;
+    }
+
+    const auto* chunk = packet.Read(chunkSize);
+    _objectsDownload.insert(_objectsDownload.end(), chunk, chunk + chunkSize);
+    if (_objectsDownload.size() < size)
+    {
+        return;
+    }
+
+    // Installed objects stay in the object folder, so the next join only has to request objects that are new
+    log_verbose("client received %u objects", count);
+    auto& repo = GetContext()->GetObjectRepository();
+    OpenRCT2::MemoryStream ms(_objectsDownload.data(), _objectsDownload.size());
+    try
+    {
+        for (uint32_t i = 0; i < count; i++)
+        {
+            repo.ExportPackedObject(&ms);
+        }
+    }
+    catch (const std::exception& e)
+    {
+        log_warning("Failed to install objects sent from server: %s", e.what());
+    }
+    _objectsDownload = {};
+}
+
 void NetworkBase::Client_Handle_SCRIPTS(NetworkConnection& connection, NetworkPacket& packet)
 {
     uint32_t numScripts{};
@@ -2384,6 +3220,69 @@ void NetworkBase::Client_Handle_SCRIPTS(NetworkConnection& connection, NetworkPa
 #    endif
 }
 
+void NetworkBase::Client_Handle_RESYNC_DIGEST(NetworkConnection& connection, NetworkPacket& packet)
+{
+    if (_resync.State != ResyncState::Requested)
+        return;
+
+    uint32_t tick;
+    if (!ReadChunkedPacket(packet, _resync.Buffer, tick))
+        return;
+
+    GameStateDigest_t digest;
+    try
+    {
+        DataSerialiser ds(false, _resync.Buffer);
+        GetContext()->GetGameStateSnapshots()->SerialiseDigest(digest, ds);
+    }
+    catch (const std::exception& e)
+    {
+        log_warning("Invalid resync digest: %s", e.what());
+        ReportDesynchronisation();
+        return;
+    }
+    _resync.Buffer = MemoryStream();
+
+    // The server state must lie ahead of us, we can not go back in time
+    if (digest.tick < gCurrentTicks)
+    {
+        log_warning("Unable to resync to tick %u, already at tick %u", digest.tick, gCurrentTicks);
+        ReportDesynchronisation();
+        return;
+    }
+
+    _resync.Tick = digest.tick;
+    _resync.ServerDigest = std::move(digest);
+    _resync.State = ResyncState::WaitingForTick;
+    UpdateResync();
+}
+
+void NetworkBase::Client_Handle_RESYNC_DATA(NetworkConnection& connection, NetworkPacket& packet)
+{
+    if (_resync.State != ResyncState::WaitingForData)
+        return;
+
+    uint32_t tick;
+    if (!ReadChunkedPacket(packet, _resync.Buffer, tick))
+        return;
+
+    DataSerialiser ds(false, _resync.Buffer);
+    const bool applied = tick == gCurrentTicks && GetContext()->GetGameStateSnapshots()->ApplyResyncData(ds);
+    _resync.Buffer = MemoryStream();
+    if (!applied)
+    {
+        log_warning("Unable to apply resync data for tick %u", tick);
+        ReportDesynchronisation();
+        return;
+    }
+
+    log_info("Resynced at tick %u", tick);
+    _resync.State = ResyncState::None;
+    _resync.LastResyncTick = tick;
+    _serverState.state = NetworkServerState::Ok;
+    gfx_invalidate_screen();
+}
+
 void NetworkBase::Client_Handle_GAMESTATE(NetworkConnection& connection, NetworkPacket& packet)
 {
     uint32_t tick;
@@ -2496,129 +3395,168 @@ void NetworkBase::Server_Handle_MAPREQUEST(NetworkConnection& connection, Networ
     Server_Send_GROUPLIST(connection);
 }
 
+/**
+ * Verifying the signature of the client is an RSA operation, it is done on a worker thread so players joining at the
+ * same time do not hold up the game. The request waits in PendingAuth until Server_Update_AUTH picks up the result.
+ */
 void NetworkBase::Server_Handle_AUTH(NetworkConnection& connection, NetworkPacket& packet)
 {
-    if (connection.AuthStatus != NetworkAuth::Ok)
+    if (connection.AuthStatus == NetworkAuth::Ok || connection.PendingAuth != nullptr)
+        return;
+
+    auto toOptional = [](const char* str) { return str != nullptr ? std::make_optional<std::string>(str) : std::nullopt; };
+    auto request = std::make_unique<NetworkPendingAuth>();
+    request->GameVersion = toOptional(packet.ReadString());
+    request->Name = toOptional(packet.ReadString());
+    request->Password = toOptional(packet.ReadString());
+    const char* pubkey = packet.ReadString();
+    uint32_t sigsize;
+    packet >> sigsize;
+    if (pubkey == nullptr)
+    {
+        connection.AuthStatus = NetworkAuth::VerificationFailure;
+        Server_Finish_AUTH(connection, *request);
+        return;
+    }
+
+    try
     {
-        const char* gameversion = packet.ReadString();
-        const char* name = packet.ReadString();
-        const char* password = packet.ReadString();
-        const char* pubkey = packet.ReadString();
-        uint32_t sigsize;
-        packet >> sigsize;
-        if (pubkey == nullptr)
+        std::vector<uint8_t> signature;
+        signature.resize(sigsize);
+
+        const uint8_t* signatureData = packet.Read(sigsize);
+        if (signatureData == nullptr)
         {
-            connection.AuthStatus = NetworkAuth::VerificationFailure;
+            throw std::runtime_error("Failed to read packet.");
         }
-        else
-        {
-            try
-            {
-                std::vector<uint8_t> signature;
-                signature.resize(sigsize);
-
-                const uint8_t* signatureData = packet.Read(sigsize);
-                if (signatureData == nullptr)
-                {
-                    throw std::runtime_error("Failed to read packet.");
-                }
 
-                std::memcpy(signature.data(), signatureData, sigsize);
+        std::memcpy(signature.data(), signatureData, sigsize);
 
-                auto ms = MemoryStream(pubkey, strlen(pubkey));
-                if (!connection.Key.LoadPublic(&ms))
-                {
-                    throw std::runtime_error("Failed to load public key.");
-                }
+        // Older clients do not announce any features and read as supporting none of them
+        uint32_t features;
+        packet >> features;
+        connection.Features = features & NETWORK_FEATURES;
 
-                bool verified = connection.Key.Verify(connection.Challenge.data(), connection.Challenge.size(), signature);
-                const std::string hash = connection.Key.PublicKeyHash();
-                if (verified)
-                {
-                    log_verbose("Signature verification ok. Hash %s", hash.c_str());
-                    if (gConfigNetwork.known_keys_only && _userManager.GetUserByHash(hash) == nullptr)
-                    {
-                        log_verbose("Hash %s, not known", hash.c_str());
-                        connection.AuthStatus = NetworkAuth::UnknownKeyDisallowed;
-                    }
-                    else
-                    {
-                        connection.AuthStatus = NetworkAuth::Verified;
-                    }
-                }
-                else
-                {
-                    connection.AuthStatus = NetworkAuth::VerificationFailure;
-                    log_verbose("Signature verification failed!");
-                }
-            }
-            catch (const std::exception&)
-            {
-                connection.AuthStatus = NetworkAuth::VerificationFailure;
-                log_verbose("Signature verification failed, invalid data!");
-            }
+        auto ms = MemoryStream(pubkey, strlen(pubkey));
+        if (!connection.Key.LoadPublic(&ms))
+        {
+            throw std::runtime_error("Failed to load public key.");
         }
 
-        bool passwordless = false;
-        if (connection.AuthStatus == NetworkAuth::Verified)
+        // The key is left alone until the result is back, the challenge may be replaced by another token request
+        request->Verified = std::async(
+            std::launch::async, [&key = connection.Key, challenge = connection.Challenge, signature = std::move(signature)]() {
+                return key.Verify(challenge.data(), challenge.size(), signature);
+            });
+        connection.PendingAuth = std::move(request);
+    }
+    catch (const std::exception&)
+    {
+        connection.AuthStatus = NetworkAuth::VerificationFailure;
+        log_verbose("Signature verification failed, invalid data!");
+        Server_Finish_AUTH(connection, *request);
+    }
+}
+
+void NetworkBase::Server_Update_AUTH(NetworkConnection& connection)
+{
+    auto& request = connection.PendingAuth;
+    if (request == nullptr || request->Verified.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+        return;
+
+    bool verified = false;
+    try
+    {
+        verified = request->Verified.get();
+    }
+    catch (const std::exception&)
+    {
+        verified = false;
+    }
+
+    const std::string hash = connection.Key.PublicKeyHash();
+    if (verified)
+    {
+        log_verbose("Signature verification ok. Hash %s", hash.c_str());
+        if (gConfigNetwork.known_keys_only && _userManager.GetUserByHash(hash) == nullptr)
         {
-            const NetworkGroup* group = GetGroupByID(GetGroupIDByHash(connection.Key.PublicKeyHash()));
-            passwordless = group->CanPerformCommand(GameCommand::PasswordlessLogin);
+            log_verbose("Hash %s, not known", hash.c_str());
+            connection.AuthStatus = NetworkAuth::UnknownKeyDisallowed;
         }
-        if (!gameversion || network_get_version() != gameversion)
+        else
         {
-            connection.AuthStatus = NetworkAuth::BadVersion;
+            connection.AuthStatus = NetworkAuth::Verified;
         }
-        else if (!name)
+    }
+    else
+    {
+        connection.AuthStatus = NetworkAuth::VerificationFailure;
+        log_verbose("Signature verification failed!");
+    }
+
+    auto finishedRequest = std::move(request);
+    Server_Finish_AUTH(connection, *finishedRequest);
+}
+
+void NetworkBase::Server_Finish_AUTH(NetworkConnection& connection, const NetworkPendingAuth& request)
+{
+    const char* name = request.Name ? request.Name->c_str() : nullptr;
+    bool passwordless = false;
+    if (connection.AuthStatus == NetworkAuth::Verified)
+    {
+        const NetworkGroup* group = GetGroupByID(GetGroupIDByHash(connection.Key.PublicKeyHash()));
+        passwordless = group->CanPerformCommand(GameCommand::PasswordlessLogin);
+    }
+    if (!request.GameVersion || network_get_version() != *request.GameVersion)
+    {
+        connection.AuthStatus = NetworkAuth::BadVersion;
+    }
+    else if (!name)
+    {
+        connection.AuthStatus = NetworkAuth::BadName;
+    }
+    else if (!passwordless)
+    {
+        if ((!request.Password || request.Password->empty()) && !_password.empty())
         {
-            connection.AuthStatus = NetworkAuth::BadName;
+            connection.AuthStatus = NetworkAuth::RequirePassword;
         }
-        else if (!passwordless)
+        else if (request.Password && _password != *request.Password)
         {
-            if ((!password || strlen(password) == 0) && !_password.empty())
-            {
-                connection.AuthStatus = NetworkAuth::RequirePassword;
-            }
-            else if (password && _password != password)
-            {
-                connection.AuthStatus = NetworkAuth::BadPassword;
-            }
+            connection.AuthStatus = NetworkAuth::BadPassword;
         }
+    }
 
-        if (static_cast<size_t>(gConfigNetwork.maxplayers) <= player_list.size())
-        {
-            connection.AuthStatus = NetworkAuth::Full;
-        }
-        else if (connection.AuthStatus == NetworkAuth::Verified)
+    if (static_cast<size_t>(gConfigNetwork.maxplayers) <= player_list.size())
+    {
+        connection.AuthStatus = NetworkAuth::Full;
+    }
+    else if (connection.AuthStatus == NetworkAuth::Verified)
+    {
+        const std::string hash = connection.Key.PublicKeyHash();
+        if (ProcessPlayerAuthenticatePluginHooks(connection, name, hash))
         {
-            const std::string hash = connection.Key.PublicKeyHash();
-            if (ProcessPlayerAuthenticatePluginHooks(connection, name, hash))
-            {
-                connection.AuthStatus = NetworkAuth::Ok;
-                Server_Client_Joined(name, hash, connection);
-            }
-            else
-            {
-                connection.AuthStatus = NetworkAuth::VerificationFailure;
-            }
+            connection.AuthStatus = NetworkAuth::Ok;
+            Server_Client_Joined(name, hash, connection);
         }
-        else if (connection.AuthStatus != NetworkAuth::RequirePassword)
+        else
         {
-            log_error("Unknown failure (%d) while authenticating client", connection.AuthStatus);
+            connection.AuthStatus = NetworkAuth::VerificationFailure;
         }
-        Server_Send_AUTH(connection);
     }
+    else if (connection.AuthStatus != NetworkAuth::RequirePassword)
+    {
+        log_error("Unknown failure (%d) while authenticating client", connection.AuthStatus);
+    }
+    Server_Send_AUTH(connection);
 }
 
 void NetworkBase::Client_Handle_MAP([[maybe_unused]] NetworkConnection& connection, NetworkPacket& packet)
 {
     uint32_t size, offset;
-    packet >> size >> offset;
-    int32_t chunksize = static_cast<int32_t>(packet.Header.Size - packet.BytesRead);
-    if (chunksize <= 0)
-    {
-        return;
-    }
+    uint8_t flags;
+    packet >> size >> offset >> flags;
+    const size_t chunksize = packet.Header.Size - packet.BytesRead;
     if (offset == 0)
     {
         // Start of a new map load, clear the queue now as we have to buffer them
@@ -2628,14 +3566,22 @@ void NetworkBase::Client_Handle_MAP([[maybe_unused]] NetworkConnection& connecti
 
         _serverTickData.clear();
         _clientMapLoaded = false;
+        _mapDownload = std::make_unique<MapDownload>(size);
     }
-    if (size > chunk_buffer.size())
+
+    // Each chunk is inflated on arrival, only loading the park has to wait for the last one
+    if (_mapDownload == nullptr || offset != _mapDownload->BytesReceived
+        || !_mapDownload->Inflate(packet.Read(chunksize), chunksize))
     {
-        chunk_buffer.resize(size);
+        log_warning("Failed to decompress data sent from server.");
+        _mapDownload.reset();
+        Close();
+        return;
     }
+
     char str_downloading_map[256];
     uint32_t downloading_map_args[2] = {
-        (offset + chunksize) / 1024,
+        static_cast<uint32_t>(_mapDownload->Stream.total_out / 1024),
         size / 1024,
     };
     format_string(str_downloading_map, 256, STR_MULTIPLAYER_DOWNLOADING_MAP, downloading_map_args);
@@ -2645,36 +3591,22 @@ void NetworkBase::Client_Handle_MAP([[maybe_unused]] NetworkConnection& connecti
     intent.putExtra(INTENT_EXTRA_CALLBACK, []() -> void { gNetwork.Close(); });
     context_open_intent(&intent);
 
-    std::memcpy(&chunk_buffer[offset], const_cast<void*>(static_cast<const void*>(packet.Read(chunksize))), chunksize);
-    if (offset + chunksize == size)
+    if (flags & NETWORK_MAP_FLAG_LAST_CHUNK)
     {
         // Allow queue processing of game actions again.
         GameActions::ResumeQueue();
 
         context_force_close_window_by_class(WC_NETWORK_STATUS);
-        bool has_to_free = false;
-        uint8_t* data = &chunk_buffer[0];
-        size_t data_size = size;
-        // zlib-compressed
-        if (strcmp("open2_sv6_zlib", reinterpret_cast<char*>(&chunk_buffer[0])) == 0)
-        {
-            log_verbose("Received zlib-compressed sv6 map");
-            has_to_free = true;
-            size_t header_len = strlen("open2_sv6_zlib") + 1;
-            data = util_zlib_inflate(&chunk_buffer[header_len], size - header_len, &data_size);
-            if (data == nullptr)
-            {
-                log_warning("Failed to decompress data sent from server.");
-                Close();
-                return;
-            }
-        }
-        else
+
+        auto mapDownload = std::move(_mapDownload);
+        if (!mapDownload->IsComplete())
         {
-            log_verbose("Assuming received map is in plain sv6 format");
+            log_warning("Failed to decompress data sent from server.");
+            Close();
+            return;
         }
 
-        auto ms = MemoryStream(data, data_size);
+        auto ms = MemoryStream(mapDownload->Data.data(), mapDownload->Data.size());
         if (LoadMap(&ms))
         {
             game_load_init();
@@ -2682,6 +3614,7 @@ void NetworkBase::Client_Handle_MAP([[maybe_unused]] NetworkConnection& connecti
             _serverState.tick = gCurrentTicks;
             // window_network_status_open("Loaded new map from network");
             _serverState.state = NetworkServerState::Ok;
+            _resync = ClientResync();
             _clientMapLoaded = true;
             gFirstTimeSaving = true;
 
@@ -2702,10 +3635,6 @@ void NetworkBase::Client_Handle_MAP([[maybe_unused]] NetworkConnection& connecti
             auto loadOrQuitAction = LoadOrQuitAction(LoadOrQuitModes::OpenSavePrompt, PromptMode::SaveBeforeQuit);
             GameActions::Execute(&loadOrQuitAction);
         }
-        if (has_to_free)
-        {
-            free(data);
-        }
     }
 }
 
@@ -2890,15 +3819,51 @@ void NetworkBase::Server_Handle_CHAT(NetworkConnection& connection, NetworkPacke
 }
 
 void NetworkBase::Client_Handle_GAME_ACTION([[maybe_unused]] NetworkConnection& connection, NetworkPacket& packet)
+{
+    Client_ReadGameAction(packet, packet.Header.Size);
+}
+
+void NetworkBase::Client_Handle_TICK_FRAME([[maybe_unused]] NetworkConnection& connection, NetworkPacket& packet)
+{
+    uint8_t flags;
+    uint16_t numActions;
+    packet >> flags >> numActions;
+    for (uint16_t i = 0; i < numActions; i++)
+    {
+        uint16_t size;
+        packet >> size;
+
+        const size_t end = packet.BytesRead + size;
+        if (end > packet.Header.Size)
+        {
+            log_warning("Received truncated tick frame.");
+            return;
+        }
+        Client_ReadGameAction(packet, end);
+        packet.BytesRead = end;
+    }
+
+    if (flags & NETWORK_TICK_FRAME_FLAG_TICK)
+    {
+        Client_ReadTick(packet);
+    }
+}
+
+void NetworkBase::Client_ReadGameAction(NetworkPacket& packet, size_t end)
 {
     uint32_t tick;
     GameCommand actionType;
     packet >> tick >> actionType;
 
-    MemoryStream stream;
-    const size_t size = packet.Header.Size - packet.BytesRead;
-    stream.WriteArray(packet.Read(size), size);
-    stream.SetPosition(0);
+    const size_t size = end > packet.BytesRead ? end - packet.BytesRead : 0;
+    const uint8_t* data = packet.Read(size);
+    if (data == nullptr)
+    {
+        log_warning("Received truncated game action.");
+        return;
+    }
+    // Read the action in place from the packet
+    MemoryStream stream(const_cast<uint8_t*>(data), size, MEMORY_ACCESS::READ);
 
     DataSerialiser ds(false, stream);
 
@@ -2985,10 +3950,10 @@ void NetworkBase::Server_Handle_GAME_ACTION(NetworkConnection& connection, Netwo
         }
     }
 
-    DataSerialiser stream(false);
+    // Read the action in place from the packet
     const size_t size = packet.Header.Size - packet.BytesRead;
-    stream.GetStream().WriteArray(packet.Read(size), size);
-    stream.GetStream().SetPosition(0);
+    MemoryStream actionStream(const_cast<uint8_t*>(packet.Read(size)), size, MEMORY_ACCESS::READ);
+    DataSerialiser stream(false, actionStream);
 
     ga->Serialise(stream);
     // Set player to sender, should be 0 if sent from client.
@@ -2998,6 +3963,11 @@ void NetworkBase::Server_Handle_GAME_ACTION(NetworkConnection& connection, Netwo
 }
 
 void NetworkBase::Client_Handle_TICK([[maybe_unused]] NetworkConnection& connection, NetworkPacket& packet)
+{
+    Client_ReadTick(packet);
+}
+
+void NetworkBase::Client_ReadTick(NetworkPacket& packet)
 {
     uint32_t srand0;
     uint32_t flags;
@@ -3017,6 +3987,17 @@ void NetworkBase::Client_Handle_TICK([[maybe_unused]] NetworkConnection& connect
             tickData.spriteHash = text;
         }
     }
+    else if (flags & NETWORK_TICK_FLAG_CHECKSUM_PART)
+    {
+        uint8_t part;
+        packet >> part;
+        const char* text = packet.ReadString();
+        if (text != nullptr)
+        {
+            tickData.spriteHash = text;
+            tickData.spriteHashPart = part;
+        }
+    }
 
     // Don't let the history grow too much.
     while (_serverTickData.size() >= 100)
@@ -3256,6 +4237,11 @@ bool network_is_desynchronised()
     return gNetwork.IsDesynchronised();
 }
 
+bool network_is_map_loaded()
+{
+    return gNetwork.IsMapLoaded();
+}
+
 bool network_check_desynchronisation()
 {
     return gNetwork.CheckDesynchronizaton();
@@ -3967,6 +4953,16 @@ json_t network_get_server_info_as_json()
 {
     return gNetwork.GetServerInfoAsJson();
 }
+
+json_t network_get_stats_as_json()
+{
+    return gNetwork.GetStatsAsJson();
+}
+
+NetworkSendBacklog network_get_send_backlog()
+{
+    return gNetwork.GetSendBacklog();
+}
 #else
 int32_t network_get_mode()
 {
@@ -3994,6 +4990,10 @@ bool network_is_desynchronised()
 {
     return false;
 }
+bool network_is_map_loaded()
+{
+    return false;
+}
 bool network_gamestate_snapshots_enabled()
 {
     return false;
@@ -4232,4 +5232,12 @@ json_t network_get_server_info_as_json()
 {
     return {};
 }
+json_t network_get_stats_as_json()
+{
+    return {};
+}
+NetworkSendBacklog network_get_send_backlog()
+{
+    return {};
+}
 #endif /* DISABLE_NETWORK */
@@ -1,14 +1,21 @@
 #pragma once
 
+#include "../GameStateSnapshots.h"
 #include "../actions/GameAction.h"
 #include "NetworkConnection.h"
 #include "NetworkGroup.h"
+#include "NetworkIOThread.h"
 #include "NetworkPlayer.h"
 #include "NetworkServerAdvertiser.h"
 #include "NetworkTypes.h"
 #include "NetworkUser.h"
 
+#include <array>
+#include <chrono>
+#include <deque>
 #include <fstream>
+#include <mutex>
+#include <optional>
 
 #ifndef DISABLE_NETWORK
 
@@ -43,6 +50,8 @@ public: // Common
     void CloseChatLog();
     NetworkStats_t GetStats() const;
     json_t GetServerInfoAsJson() const;
+    json_t GetStatsAsJson() const;
+    NetworkSendBacklog GetSendBacklog() const;
     bool ProcessConnection(NetworkConnection& connection);
     void CloseConnection();
     NetworkPlayer* AddPlayer(const std::string& name, const std::string& keyhash);
@@ -69,8 +78,10 @@ public: // Server
     void UpdateServer();
     void ServerClientDisconnected(std::unique_ptr<NetworkConnection>& connection);
     bool SaveMap(OpenRCT2::IStream* stream, const std::vector<const ObjectRepositoryItem*>& objects) const;
-    std::vector<uint8_t> save_for_network(const std::vector<const ObjectRepositoryItem*>& objects) const;
+    std::vector<NetworkPacket> save_for_network(const std::vector<const ObjectRepositoryItem*>& objects) const;
+    void SendCompressedMaps();
     std::string MakePlayerNameUnique(const std::string& name);
+    void WriteGameAction(NetworkPacket& packet, const GameAction* action);
 
     // Packet dispatchers.
     void Server_Send_AUTH(NetworkConnection& connection);
@@ -79,6 +90,7 @@ public: // Server
     void Server_Send_CHAT(const char* text, const std::vector<uint8_t>& playerIds = {});
     void Server_Send_GAME_ACTION(const GameAction* action);
     void Server_Send_TICK();
+    void Server_Send_TICK_FRAMES(const NetworkPacket* tickPacket);
     void Server_Send_PLAYERINFO(int32_t playerId);
     void Server_Send_PLAYERLIST();
     void Server_Send_PING();
@@ -90,12 +102,17 @@ public: // Server
     void Server_Send_EVENT_PLAYER_JOINED(const char* playerName);
     void Server_Send_EVENT_PLAYER_DISCONNECTED(const char* playerName, const char* reason);
     void Server_Send_OBJECTS_LIST(NetworkConnection& connection, const std::vector<const ObjectRepositoryItem*>& objects) const;
+    void Server_Send_OBJECTS(NetworkConnection& connection, const std::vector<const ObjectRepositoryItem*>& objects) const;
     void Server_Send_SCRIPTS(NetworkConnection& connection) const;
 
     // Handlers
     void Server_Handle_REQUEST_GAMESTATE(NetworkConnection& connection, NetworkPacket& packet);
+    void Server_Handle_REQUEST_RESYNC(NetworkConnection& connection, NetworkPacket& packet);
+    void Server_Handle_RESYNC_PARTS(NetworkConnection& connection, NetworkPacket& packet);
     void Server_Handle_HEARTBEAT(NetworkConnection& connection, NetworkPacket& packet);
     void Server_Handle_AUTH(NetworkConnection& connection, NetworkPacket& packet);
+    void Server_Update_AUTH(NetworkConnection& connection);
+    void Server_Finish_AUTH(NetworkConnection& connection, const NetworkPendingAuth& request);
     void Server_Client_Joined(const char* name, const std::string& keyhash, NetworkConnection& connection);
     void Server_Handle_CHAT(NetworkConnection& connection, NetworkPacket& packet);
     void Server_Handle_GAME_ACTION(NetworkConnection& connection, NetworkPacket& packet);
@@ -114,10 +131,14 @@ public: // Client
     void ProcessDisconnectedClients();
     static const char* FormatChat(NetworkPlayer* fromplayer, const char* text);
     void SendPacketToClients(const NetworkPacket& packet, bool front = false, bool gameCmd = false);
+    void SendTickPacketToClients(const NetworkPacket& packet, bool tickFrames);
     bool CheckSRAND(uint32_t tick, uint32_t srand0);
     bool CheckDesynchronizaton();
+    void ReportDesynchronisation();
+    void UpdateResync();
     void RequestStateSnapshot();
     bool IsDesynchronised();
+    bool IsMapLoaded() const;
     NetworkServerState_t GetServerState() const;
     void ServerClientDisconnected();
     bool LoadMap(OpenRCT2::IStream* stream);
@@ -125,6 +146,8 @@ public: // Client
 
     // Packet dispatchers.
     void Client_Send_RequestGameState(uint32_t tick);
+    void Client_Send_REQUEST_RESYNC();
+    void Client_Send_RESYNC_PARTS(GameStateResyncParts_t& parts);
     void Client_Send_TOKEN();
     void Client_Send_AUTH(
         const std::string& name, const std::string& password, const std::string& pubkey, const std::vector<uint8_t>& signature);
@@ -141,6 +164,9 @@ public: // Client
     void Client_Handle_CHAT(NetworkConnection& connection, NetworkPacket& packet);
     void Client_Handle_GAME_ACTION(NetworkConnection& connection, NetworkPacket& packet);
     void Client_Handle_TICK(NetworkConnection& connection, NetworkPacket& packet);
+    void Client_Handle_TICK_FRAME(NetworkConnection& connection, NetworkPacket& packet);
+    void Client_ReadGameAction(NetworkPacket& packet, size_t end);
+    void Client_ReadTick(NetworkPacket& packet);
     void Client_Handle_PLAYERINFO(NetworkConnection& connection, NetworkPacket& packet);
     void Client_Handle_PLAYERLIST(NetworkConnection& connection, NetworkPacket& packet);
     void Client_Handle_PING(NetworkConnection& connection, NetworkPacket& packet);
@@ -152,8 +178,11 @@ public: // Client
     void Client_Handle_EVENT(NetworkConnection& connection, NetworkPacket& packet);
     void Client_Handle_TOKEN(NetworkConnection& connection, NetworkPacket& packet);
     void Client_Handle_OBJECTS_LIST(NetworkConnection& connection, NetworkPacket& packet);
+    void Client_Handle_OBJECTS(NetworkConnection& connection, NetworkPacket& packet);
     void Client_Handle_SCRIPTS(NetworkConnection& connection, NetworkPacket& packet);
     void Client_Handle_GAMESTATE(NetworkConnection& connection, NetworkPacket& packet);
+    void Client_Handle_RESYNC_DIGEST(NetworkConnection& connection, NetworkPacket& packet);
+    void Client_Handle_RESYNC_DATA(NetworkConnection& connection, NetworkPacket& packet);
 
     std::vector<uint8_t> _challenge;
     std::map<uint32_t, GameAction::Callback_t> _gameActionCallbacks;
@@ -174,9 +203,11 @@ private: // Common Data
     using CommandHandler = void (NetworkBase::*)(NetworkConnection& connection, NetworkPacket& packet);
 
     std::shared_ptr<OpenRCT2::IPlatformEnvironment> _env;
-    std::vector<uint8_t> chunk_buffer;
     std::ofstream _chat_log_fs;
     uint32_t _lastUpdateTime = 0;
+    // How long the latest Update calls took, in microseconds
+    std::array<uint32_t, 128> _updateDurations{};
+    size_t _updateCount = 0;
     uint32_t _currentDeltaTime = 0;
     int32_t mode = NETWORK_MODE_NONE;
     uint8_t default_group = 0;
@@ -187,14 +218,60 @@ private: // Common Data
 private: // Server Data
     std::unordered_map<NetworkCommand, CommandHandler> server_command_handlers;
     std::unique_ptr<ITcpSocket> _listenSocket;
+    std::unique_ptr<NetworkIOThread> _ioThread;
     std::unique_ptr<INetworkServerAdvertiser> _advertiser;
     std::list<std::unique_ptr<NetworkConnection>> client_connection_list;
+    // Actions not yet sent to the clients that receive them in tick frames
+    std::vector<NetworkPacket> _tickFrameActions;
     std::string _serverLogPath;
     std::string _serverLogFilenameFormat = "%Y%m%d-%H%M%S.txt";
     std::ofstream _server_log_fs;
     uint16_t listening_port = 0;
     bool _playerListInvalidated = false;
 
+    /**
+     * A map being compressed for the connections that joined on the same tick. The worker appends the compressed chunks
+     * as it produces them, so they are sent while the rest of the map is still being compressed.
+     */
+    struct CompressedMap
+    {
+        struct Receiver
+        {
+            NetworkConnection* Connection{};
+            size_t ChunksSent{};
+            uint32_t BytesSent{};
+            std::chrono::high_resolution_clock::time_point RequestTime;
+        };
+
+        uint32_t Tick{};
+        uint32_t UncompressedSize{};
+        double SerialiseTimeMs{};
+        std::vector<const ObjectRepositoryItem*> Objects;
+        // Cleared once the game state changes within the tick, later joiners need a new map
+        bool Shareable = true;
+        std::vector<Receiver> Receivers;
+
+        // Guards the members below, which are written by the worker
+        std::mutex Mutex;
+        std::vector<std::vector<uint8_t>> Chunks;
+        double CompressTimeMs{};
+        bool Finished = false;
+        bool Failed = false;
+    };
+    std::vector<std::shared_ptr<CompressedMap>> _compressedMaps;
+
+    // Where the time went for the latest joins, from the map request until its last chunk was queued
+    struct JoinTimings
+    {
+        uint32_t Tick{};
+        uint32_t MapSize{};
+        uint32_t CompressedMapSize{};
+        double SerialiseTimeMs{};
+        double CompressTimeMs{};
+        double TransferTimeMs{};
+    };
+    std::deque<JoinTimings> _joinTimings;
+
 private: // Client Data
     struct PlayerListUpdate
     {
@@ -206,6 +283,32 @@ private: // Client Data
         uint32_t srand0;
         uint32_t tick;
         std::string spriteHash;
+        // Set when the hash only covers this part of the entities, see sprite_checksum_part
+        std::optional<uint8_t> spriteHashPart;
+    };
+
+    enum class ResyncState
+    {
+        None,
+        // Waiting for the digest of the server state
+        Requested,
+        // Running up to the tick of the server state to compare it with our own
+        WaitingForTick,
+        // Held at the tick until the differing parts have been received
+        WaitingForData,
+    };
+
+    /**
+     * Replaces only the parts of the game state that differ from the server after a desync instead of leaving the
+     * client desynchronised or having it download the whole map again.
+     */
+    struct ClientResync
+    {
+        ResyncState State = ResyncState::None;
+        uint32_t Tick = 0;
+        std::optional<uint32_t> LastResyncTick;
+        GameStateDigest_t ServerDigest;
+        OpenRCT2::MemoryStream Buffer;
     };
 
     std::unordered_map<NetworkCommand, CommandHandler> client_command_handlers;
@@ -214,12 +317,17 @@ private: // Client Data
     std::multimap<uint32_t, NetworkPlayer> _pendingPlayerInfo;
     std::map<uint32_t, ServerTickData_t> _serverTickData;
     std::vector<std::string> _missingObjects;
+    std::vector<uint8_t> _objectsDownload;
     std::string _host;
     std::string _chatLogPath;
     std::string _chatLogFilenameFormat = "%Y%m%d-%H%M%S.txt";
     std::string _password;
     OpenRCT2::MemoryStream _serverGameState;
+    OpenRCT2::MemoryStream _gameActionStream;
     NetworkServerState_t _serverState;
+    ClientResync _resync;
+    struct MapDownload;
+    std::unique_ptr<MapDownload> _mapDownload;
     uint32_t _lastSentHeartbeat = 0;
     uint32_t last_ping_sent_time = 0;
     uint32_t server_connect_time = 0;
@@ -17,8 +17,11 @@
 #    include "Socket.h"
 #    include "network.h"
 
+#    include <algorithm>
+#    include <array>
+#    include <iterator>
+
 constexpr size_t NETWORK_DISCONNECT_REASON_BUFFER_SIZE = 256;
-constexpr size_t NetworkBufferSize = 1024 * 64; // 64 KiB, maximum packet size.
 
 NetworkConnection::NetworkConnection()
 {
@@ -31,25 +34,47 @@ NetworkConnection::~NetworkConnection()
 }
 
 NetworkReadPacket NetworkConnection::ReadPacket()
+{
+    NetworkReadPacket status = ReadPacket(*Socket, InboundPacket);
+    if (status == NetworkReadPacket::Success)
+    {
+        _lastPacketTime = platform_get_ticks();
+        RecordPacketStats(Stats, InboundPacket.GetCommand(), InboundPacket.BytesTransferred, false);
+    }
+    return status;
+}
+
+bool NetworkConnection::ReceivePacket(NetworkPacket& packet)
+{
+    if (IO == nullptr || !IO->Inbound.try_pop(packet))
+    {
+        return false;
+    }
+    _lastPacketTime = platform_get_ticks();
+    RecordPacketStats(Stats, packet.GetCommand(), packet.BytesTransferred, false);
+    return true;
+}
+
+NetworkReadPacket NetworkConnection::ReadPacket(ITcpSocket& socket, NetworkPacket& packet)
 {
     size_t bytesRead = 0;
 
     // Read packet header.
-    auto& header = InboundPacket.Header;
-    if (InboundPacket.BytesTransferred < sizeof(InboundPacket.Header))
+    auto& header = packet.Header;
+    if (packet.BytesTransferred < sizeof(packet.Header))
     {
-        const size_t missingLength = sizeof(header) - InboundPacket.BytesTransferred;
+        const size_t missingLength = sizeof(header) - packet.BytesTransferred;
 
-        uint8_t* buffer = reinterpret_cast<uint8_t*>(&InboundPacket.Header);
+        uint8_t* buffer = reinterpret_cast<uint8_t*>(&packet.Header);
 
-        NetworkReadPacket status = Socket->ReceiveData(buffer, missingLength, &bytesRead);
+        NetworkReadPacket status = socket.ReceiveData(buffer, missingLength, &bytesRead);
         if (status != NetworkReadPacket::Success)
         {
             return status;
         }
 
-        InboundPacket.BytesTransferred += bytesRead;
-        if (InboundPacket.BytesTransferred < sizeof(InboundPacket.Header))
+        packet.BytesTransferred += bytesRead;
+        if (packet.BytesTransferred < sizeof(packet.Header))
         {
             // If still not enough data for header, keep waiting.
             return NetworkReadPacket::MoreData;
@@ -63,34 +88,31 @@ NetworkReadPacket NetworkConnection::ReadPacket()
         // Previously the Id field was not part of the header rather part of the body.
         header.Size -= sizeof(header.Id);
 
+        // The body is received straight into the packet, which keeps its buffer between packets
+        packet.Data.resize(header.Size);
+
         // Fall-through: Read rest of packet.
     }
 
     // Read packet body.
     {
-        const size_t missingLength = header.Size - (InboundPacket.BytesTransferred - sizeof(header));
-
-        uint8_t buffer[NetworkBufferSize];
-
+        const size_t bodyReceived = packet.BytesTransferred - sizeof(header);
+        const size_t missingLength = header.Size - bodyReceived;
         if (missingLength > 0)
         {
-            NetworkReadPacket status = Socket->ReceiveData(buffer, std::min(missingLength, NetworkBufferSize), &bytesRead);
+            uint8_t* buffer = packet.GetData() + bodyReceived;
+            NetworkReadPacket status = socket.ReceiveData(buffer, missingLength, &bytesRead);
             if (status != NetworkReadPacket::Success)
             {
                 return status;
             }
 
-            InboundPacket.BytesTransferred += bytesRead;
-            InboundPacket.Write(buffer, bytesRead);
+            packet.BytesTransferred += bytesRead;
         }
 
-        if (InboundPacket.Data.size() == header.Size)
+        if (packet.BytesTransferred == sizeof(header) + header.Size)
         {
             // Received complete packet.
-            _lastPacketTime = platform_get_ticks();
-
-            RecordPacketStats(InboundPacket, false);
-
             return NetworkReadPacket::Success;
         }
     }
@@ -98,71 +120,157 @@ NetworkReadPacket NetworkConnection::ReadPacket()
     return NetworkReadPacket::MoreData;
 }
 
-bool NetworkConnection::SendPacket(NetworkPacket& packet)
+void NetworkConnection::QueuePacket(const NetworkPacket& packet, bool front)
 {
-    auto header = packet.Header;
-
-    std::vector<uint8_t> buffer;
-    buffer.reserve(sizeof(header) + header.Size);
-
-    // NOTE: For compatibility reasons for the master server we need to add sizeof(Header.Id) to the size.
-    // Previously the Id field was not part of the header rather part of the body.
-    header.Size += sizeof(header.Id);
-    header.Size = Convert::HostToNetwork(header.Size);
-    header.Id = ByteSwapBE(header.Id);
-
-    buffer.insert(buffer.end(), reinterpret_cast<uint8_t*>(&header), reinterpret_cast<uint8_t*>(&header) + sizeof(header));
-    buffer.insert(buffer.end(), packet.Data.begin(), packet.Data.end());
-
-    size_t bufferSize = buffer.size() - packet.BytesTransferred;
-    size_t sent = Socket->SendData(buffer.data() + packet.BytesTransferred, bufferSize);
-    if (sent > 0)
-    {
-        packet.BytesTransferred += sent;
-    }
-
-    bool sendComplete = packet.BytesTransferred == buffer.size();
-    if (sendComplete)
+    if (AuthStatus == NetworkAuth::Ok || !packet.CommandRequiresAuth())
     {
-        RecordPacketStats(packet, true);
+        QueuePacket(packet.Encode(), front);
     }
-    return sendComplete;
 }
 
-void NetworkConnection::QueuePacket(NetworkPacket&& packet, bool front)
+void NetworkConnection::QueuePacket(const NetworkSharedPacket& packet, bool front)
 {
-    if (AuthStatus == NetworkAuth::Ok || !packet.CommandRequiresAuth())
+    if (AuthStatus == NetworkAuth::Ok || !NetworkPacket::CommandRequiresAuth(packet.Command))
     {
-        packet.Header.Size = static_cast<uint16_t>(packet.Data.size());
-        if (front)
+        // Packets handed to the network thread can no longer be overtaken
+        if (front && IO == nullptr)
         {
             // If the first packet was already partially sent add new packet to second position
             if (!_outboundPackets.empty() && _outboundPackets.front().BytesTransferred > 0)
             {
                 auto it = _outboundPackets.begin();
                 it++; // Second position
-                _outboundPackets.insert(it, std::move(packet));
+                _outboundPackets.insert(it, { packet });
             }
             else
             {
-                _outboundPackets.push_front(std::move(packet));
+                _outboundPackets.push_front({ packet });
             }
         }
+        else if (_holdingPackets)
+        {
+            _heldPackets.push_back({ packet });
+        }
         else
         {
-            _outboundPackets.push_back(std::move(packet));
+            SubmitPacket(packet);
+        }
+    }
+}
+
+void NetworkConnection::SubmitPacket(const NetworkSharedPacket& packet)
+{
+    if (IO != nullptr)
+    {
+        // The network thread sends it, the packet is counted once it is handed over
+        RecordPacketStats(Stats, packet.Command, packet.Buffer->size(), true);
+        IO->QueuedPackets++;
+        IO->QueuedBytes += packet.Buffer->size();
+        IO->Outbound.push(NetworkSharedPacket(packet));
+    }
+    else
+    {
+        _outboundPackets.push_back({ packet });
+    }
+}
+
+void NetworkConnection::HoldPackets()
+{
+    _holdingPackets = true;
+}
+
+void NetworkConnection::QueuePacketsAhead(std::vector<NetworkPacket>&& packets)
+{
+    const bool holdingPackets = _holdingPackets;
+    _holdingPackets = false;
+    for (const auto& packet : packets)
+    {
+        QueuePacket(packet);
+    }
+    _holdingPackets = holdingPackets;
+}
+
+void NetworkConnection::ReleasePackets()
+{
+    _holdingPackets = false;
+    for (const auto& packet : _heldPackets)
+    {
+        SubmitPacket(packet.Packet);
+    }
+    _heldPackets.clear();
+}
+
+NetworkSendBacklog NetworkConnection::GetSendBacklog() const
+{
+    NetworkSendBacklog backlog;
+    if (IO != nullptr)
+    {
+        backlog.QueuedPackets = IO->QueuedPackets;
+        backlog.QueuedBytes = IO->QueuedBytes;
+    }
+    else
+    {
+        backlog.QueuedPackets = _outboundPackets.size();
+        for (const auto& packet : _outboundPackets)
+        {
+            backlog.QueuedBytes += packet.Packet.Buffer->size() - packet.BytesTransferred;
         }
     }
+    backlog.HeldPackets = _heldPackets.size();
+    return backlog;
 }
 
 void NetworkConnection::SendQueuedPackets()
 {
-    while (!_outboundPackets.empty() && SendPacket(_outboundPackets.front()))
+    if (IO == nullptr)
     {
-        _outboundPackets.pop_front();
+        SendPackets(*Socket, _outboundPackets, &Stats);
     }
 }
 
+size_t NetworkConnection::SendPackets(ITcpSocket& socket, std::deque<OutboundPacket>& packets, NetworkStats_t* stats)
+{
+    // Hand as many queued packets to the socket in one call as it can take, without copying them together first
+    constexpr size_t MaxBuffersPerSend = 64;
+    std::array<SocketSendBuffer, MaxBuffersPerSend> buffers;
+    size_t totalSent = 0;
+    while (!packets.empty())
+    {
+        size_t numBuffers = 0;
+        size_t requested = 0;
+        for (auto it = packets.begin(); it != packets.end() && numBuffers < buffers.size(); it++)
+        {
+            const auto& buffer = *it->Packet.Buffer;
+            buffers[numBuffers++] = { buffer.data() + it->BytesTransferred, buffer.size() - it->BytesTransferred };
+            requested += buffer.size() - it->BytesTransferred;
+        }
+
+        size_t sent = socket.SendData(buffers.data(), numBuffers);
+        const bool socketFull = sent < requested;
+        totalSent += sent;
+        while (sent > 0)
+        {
+            auto& packet = packets.front();
+            const size_t remaining = packet.Packet.Buffer->size() - packet.BytesTransferred;
+            const size_t consumed = std::min(sent, remaining);
+            packet.BytesTransferred += consumed;
+            sent -= consumed;
+            if (packet.BytesTransferred == packet.Packet.Buffer->size())
+            {
+                if (stats != nullptr)
+                {
+                    RecordPacketStats(*stats, packet.Packet.Command, packet.BytesTransferred, true);
+                }
+                packets.pop_front();
+            }
+        }
+
+        if (socketFull)
+            break;
+    }
+    return totalSent;
+}
+
 void NetworkConnection::ResetLastPacketTime()
 {
     _lastPacketTime = platform_get_ticks();
@@ -207,14 +315,15 @@ void NetworkConnection::SetLastDisconnectReason(const rct_string_id string_id, v
     SetLastDisconnectReason(buffer);
 }
 
-void NetworkConnection::RecordPacketStats(const NetworkPacket& packet, bool sending)
+void NetworkConnection::RecordPacketStats(NetworkStats_t& stats, NetworkCommand command, size_t size, bool sending)
 {
-    uint32_t packetSize = static_cast<uint32_t>(packet.BytesTransferred);
+    uint32_t packetSize = static_cast<uint32_t>(size);
     NetworkStatisticsGroup trafficGroup;
 
-    switch (packet.GetCommand())
+    switch (command)
     {
         case NetworkCommand::GameAction:
+        case NetworkCommand::TickFrame:
             trafficGroup = NetworkStatisticsGroup::Commands;
             break;
         case NetworkCommand::Map:
@@ -225,15 +334,24 @@ void NetworkConnection::RecordPacketStats(const NetworkPacket& packet, bool send
             break;
     }
 
+    // Unknown commands are only counted in the totals
+    NetworkCommandStats_t unknownCommandStats{};
+    const auto commandIndex = EnumValue(command);
+    auto& commandStats = commandIndex < std::size(stats.commands) ? stats.commands[commandIndex] : unknownCommandStats;
+
     if (sending)
     {
-        Stats.bytesSent[EnumValue(trafficGroup)] += packetSize;
-        Stats.bytesSent[EnumValue(NetworkStatisticsGroup::Total)] += packetSize;
+        stats.bytesSent[EnumValue(trafficGroup)] += packetSize;
+        stats.bytesSent[EnumValue(NetworkStatisticsGroup::Total)] += packetSize;
+        commandStats.packetsSent++;
+        commandStats.bytesSent += packetSize;
     }
     else
     {
-        Stats.bytesReceived[EnumValue(trafficGroup)] += packetSize;
-        Stats.bytesReceived[EnumValue(NetworkStatisticsGroup::Total)] += packetSize;
+        stats.bytesReceived[EnumValue(trafficGroup)] += packetSize;
+        stats.bytesReceived[EnumValue(NetworkStatisticsGroup::Total)] += packetSize;
+        commandStats.packetsReceived++;
+        commandStats.bytesReceived += packetSize;
     }
 }
 
@@ -11,21 +11,61 @@
 
 #ifndef DISABLE_NETWORK
 #    include "../common.h"
+#    include "../core/SpscQueue.h"
 #    include "NetworkKey.h"
 #    include "NetworkPacket.h"
 #    include "NetworkTypes.h"
 #    include "Socket.h"
 
+#    include <atomic>
 #    include <deque>
+#    include <future>
 #    include <memory>
+#    include <optional>
+#    include <string>
 #    include <vector>
 
 class NetworkPlayer;
+struct GameStateResync_t;
 struct ObjectRepositoryItem;
 
+/**
+ * The part of a server connection the network thread works on. Packets are handed between the game thread and the
+ * network thread through queues that each have one producer and one consumer.
+ */
+struct NetworkConnectionIO
+{
+    // Complete packets read by the network thread
+    SpscQueue<NetworkPacket> Inbound;
+    // Encoded packets for the network thread to send
+    SpscQueue<NetworkSharedPacket> Outbound;
+    std::atomic<bool> Disconnected{};
+    // Packets and bytes handed to the network thread that it has not sent yet
+    std::atomic<size_t> QueuedPackets{};
+    std::atomic<size_t> QueuedBytes{};
+};
+
+/**
+ * An authentication request whose signature is being verified on a worker thread, the rest of the request is handled
+ * once the result is back.
+ */
+struct NetworkPendingAuth
+{
+    std::optional<std::string> GameVersion;
+    std::optional<std::string> Name;
+    std::optional<std::string> Password;
+    std::future<bool> Verified;
+};
+
 class NetworkConnection final
 {
 public:
+    struct OutboundPacket
+    {
+        NetworkSharedPacket Packet;
+        size_t BytesTransferred = 0;
+    };
+
     std::unique_ptr<ITcpSocket> Socket = nullptr;
     NetworkPacket InboundPacket;
     NetworkAuth AuthStatus = NetworkAuth::None;
@@ -35,20 +75,33 @@ public:
     NetworkKey Key;
     std::vector<uint8_t> Challenge;
     std::vector<const ObjectRepositoryItem*> RequestedObjects;
+    uint32_t Features = 0;
+    // Game state captured for a desynchronised client until it has told which parts differ
+    std::shared_ptr<GameStateResync_t> Resync;
     bool IsDisconnected = false;
+    // Set while the network thread reads and sends for this connection, the socket must then be left alone
+    std::shared_ptr<NetworkConnectionIO> IO;
+    // Set while the signature of the client is verified, the worker uses Key so this must be destroyed before it
+    std::unique_ptr<NetworkPendingAuth> PendingAuth;
 
     NetworkConnection();
     ~NetworkConnection();
 
     NetworkReadPacket ReadPacket();
-    void QueuePacket(NetworkPacket&& packet, bool front = false);
-    void QueuePacket(const NetworkPacket& packet, bool front = false)
-    {
-        auto copy = packet;
-        return QueuePacket(std::move(copy), front);
-    }
+    bool ReceivePacket(NetworkPacket& packet);
+    void QueuePacket(const NetworkPacket& packet, bool front = false);
+    void QueuePacket(const NetworkSharedPacket& packet, bool front = false);
 
     void SendQueuedPackets();
+
+    /**
+     * Holds back packets queued from now on until ReleasePackets is called. Packets the held ones depend on are queued
+     * ahead of them with QueuePacketsAhead.
+     */
+    void HoldPackets();
+    void QueuePacketsAhead(std::vector<NetworkPacket>&& packets);
+    void ReleasePackets();
+    NetworkSendBacklog GetSendBacklog() const;
     void ResetLastPacketTime();
     bool ReceivedPacketRecently();
 
@@ -56,13 +109,18 @@ public:
     void SetLastDisconnectReason(const utf8* src);
     void SetLastDisconnectReason(const rct_string_id string_id, void* args = nullptr);
 
+    static NetworkReadPacket ReadPacket(ITcpSocket& socket, NetworkPacket& packet);
+    static size_t SendPackets(ITcpSocket& socket, std::deque<OutboundPacket>& packets, NetworkStats_t* stats);
+
 private:
-    std::deque<NetworkPacket> _outboundPackets;
+    std::deque<OutboundPacket> _outboundPackets;
+    std::deque<OutboundPacket> _heldPackets;
+    bool _holdingPackets = false;
     uint32_t _lastPacketTime = 0;
     utf8* _lastDisconnectReason = nullptr;
 
-    void RecordPacketStats(const NetworkPacket& packet, bool sending);
-    bool SendPacket(NetworkPacket& packet);
+    void SubmitPacket(const NetworkSharedPacket& packet);
+    static void RecordPacketStats(NetworkStats_t& stats, NetworkCommand command, size_t size, bool sending);
 };
 
 #endif // DISABLE_NETWORK
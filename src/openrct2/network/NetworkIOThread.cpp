@@ -0,0 +1,174 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#ifndef DISABLE_NETWORK
+
+#    include "NetworkIOThread.h"
+
+#    include "../core/Trace.h"
+
+#    include <algorithm>
+
+// Packets queued by the game thread wait at most this long for the network thread to send them
+static constexpr uint32_t NETWORK_IO_WAIT_TIME_MS = 1;
+
+NetworkIOThread::NetworkIOThread(ITcpSocket& listenSocket)
+    : _listenSocket(listenSocket)
+    , _poller(CreateSocketPoller())
+{
+    _poller->Add(_listenSocket);
+    _thread = std::thread(&NetworkIOThread::Run, this);
+}
+
+NetworkIOThread::~NetworkIOThread()
+{
+    _shouldStop = true;
+    _thread.join();
+}
+
+std::unique_ptr<ITcpSocket> NetworkIOThread::AcceptClient()
+{
+    std::unique_ptr<ITcpSocket> socket;
+    _acceptedClients.try_pop(socket);
+    return socket;
+}
+
+void NetworkIOThread::AddConnection(NetworkConnection& connection)
+{
+    connection.IO = std::make_shared<NetworkConnectionIO>();
+    _commands.push({ connection.IO, connection.Socket.get(), nullptr });
+}
+
+void NetworkIOThread::RemoveConnection(NetworkConnection& connection)
+{
+    _commands.push({ std::move(connection.IO), nullptr, std::move(connection.Socket) });
+}
+
+void NetworkIOThread::Run()
+{
+    while (!_shouldStop)
+    {
+        ProcessCommands();
+
+        const auto& readySockets = _poller->Wait(NETWORK_IO_WAIT_TIME_MS);
+        auto isReady = [&readySockets](const ITcpSocket* socket) {
+            return std::binary_search(readySockets.begin(), readySockets.end(), socket);
+        };
+
+        for (auto& connection : _connections)
+        {
+            if (connection.IO->Disconnected)
+                continue;
+
+            try
+            {
+                if (isReady(connection.Socket))
+                {
+                    ReadConnection(connection);
+                }
+                if (!connection.IO->Disconnected)
+                {
+                    SendConnection(connection);
+                }
+            }
+            catch (const std::exception&)
+            {
+                CloseConnection(connection);
+            }
+        }
+
+        if (isReady(&_listenSocket))
+        {
+            auto socket = _listenSocket.Accept();
+            if (socket != nullptr)
+            {
+                _acceptedClients.push(std::move(socket));
+            }
+        }
+    }
+}
+
+void NetworkIOThread::ProcessCommands()
+{
+    Command command;
+    while (_commands.try_pop(command))
+    {
+        if (command.OwnedSocket == nullptr)
+        {
+            _poller->Add(*command.Socket);
+            auto& connection = _connections.emplace_back();
+            connection.IO = std::move(command.IO);
+            connection.Socket = command.Socket;
+            continue;
+        }
+
+        auto it = std::find_if(_connections.begin(), _connections.end(), [&command](const Connection& connection) {
+            return connection.IO == command.IO;
+        });
+        if (it != _connections.end())
+        {
+            if (!it->IO->Disconnected)
+            {
+                _poller->Remove(*it->Socket);
+            }
+            _connections.erase(it);
+        }
+
+        // Nothing refers to the socket any more, it can be closed now
+        command.OwnedSocket.reset();
+    }
+}
+
+void NetworkIOThread::ReadConnection(Connection& connection)
+{
+    TRACE_ZONE("Network receive");
+    for (;;)
+    {
+        switch (NetworkConnection::ReadPacket(*connection.Socket, connection.InboundPacket))
+        {
+            case NetworkReadPacket::Success:
+                connection.IO->Inbound.push(std::move(connection.InboundPacket));
+                connection.InboundPacket = NetworkPacket();
+                break;
+            case NetworkReadPacket::Disconnected:
+                CloseConnection(connection);
+                return;
+            default:
+                return;
+        }
+    }
+}
+
+void NetworkIOThread::SendConnection(Connection& connection)
+{
+    TRACE_ZONE("Network send");
+    NetworkSharedPacket packet;
+    while (connection.IO->Outbound.try_pop(packet))
+    {
+        connection.OutboundPackets.push_back({ std::move(packet) });
+    }
+
+    if (!connection.OutboundPackets.empty())
+    {
+        const size_t queued = connection.OutboundPackets.size();
+        const size_t sent = NetworkConnection::SendPackets(*connection.Socket, connection.OutboundPackets, nullptr);
+        connection.IO->QueuedPackets -= queued - connection.OutboundPackets.size();
+        connection.IO->QueuedBytes -= sent;
+    }
+}
+
+void NetworkIOThread::CloseConnection(Connection& connection)
+{
+    // A closed socket stays readable, it is left out of the poller until the game thread removes the connection
+    _poller->Remove(*connection.Socket);
+    connection.OutboundPackets.clear();
+    connection.IO->Disconnected = true;
+}
+
+#endif // DISABLE_NETWORK
@@ -0,0 +1,86 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#ifndef DISABLE_NETWORK
+
+#    include "../common.h"
+#    include "../core/SpscQueue.h"
+#    include "NetworkConnection.h"
+#    include "Socket.h"
+
+#    include <atomic>
+#    include <deque>
+#    include <memory>
+#    include <thread>
+#    include <vector>
+
+/**
+ * Does all socket work of a server on its own thread: accepting clients, reading packets and sending the queued ones.
+ * The game thread only exchanges complete packets with it, see NetworkConnectionIO, so the time spent on the network
+ * no longer depends on how much the clients are sending or downloading.
+ */
+class NetworkIOThread final
+{
+public:
+    explicit NetworkIOThread(ITcpSocket& listenSocket);
+    ~NetworkIOThread();
+
+    NetworkIOThread(const NetworkIOThread&) = delete;
+    NetworkIOThread& operator=(const NetworkIOThread&) = delete;
+
+    /**
+     * Returns the next client accepted on the listen socket, or nullptr if there is none.
+     */
+    std::unique_ptr<ITcpSocket> AcceptClient();
+
+    /**
+     * Hands the socket of a connection to the network thread, from now on it reads and sends for the connection.
+     */
+    void AddConnection(NetworkConnection& connection);
+
+    /**
+     * Takes a connection away from the network thread, which closes its socket once it has let go of it.
+     */
+    void RemoveConnection(NetworkConnection& connection);
+
+private:
+    struct Command
+    {
+        std::shared_ptr<NetworkConnectionIO> IO;
+        ITcpSocket* Socket = nullptr;
+        // Set when the connection is removed
+        std::unique_ptr<ITcpSocket> OwnedSocket;
+    };
+
+    struct Connection
+    {
+        std::shared_ptr<NetworkConnectionIO> IO;
+        ITcpSocket* Socket = nullptr;
+        NetworkPacket InboundPacket;
+        std::deque<NetworkConnection::OutboundPacket> OutboundPackets;
+    };
+
+    ITcpSocket& _listenSocket;
+    std::unique_ptr<ISocketPoller> _poller;
+    std::vector<Connection> _connections;
+    SpscQueue<Command> _commands;
+    SpscQueue<std::unique_ptr<ITcpSocket>> _acceptedClients;
+    std::atomic<bool> _shouldStop{};
+    std::thread _thread;
+
+    void Run();
+    void ProcessCommands();
+    void ReadConnection(Connection& connection);
+    void SendConnection(Connection& connection);
+    void CloseConnection(Connection& connection);
+};
+
+#endif // DISABLE_NETWORK
@@ -12,7 +12,9 @@
 #    include "NetworkPacket.h"
 
 #    include "NetworkTypes.h"
+#    include "Socket.h"
 
+#    include <cstring>
 #    include <memory>
 
 NetworkPacket::NetworkPacket(NetworkCommand id)
@@ -42,9 +44,14 @@ void NetworkPacket::Clear()
     Data.clear();
 }
 
-bool NetworkPacket::CommandRequiresAuth()
+bool NetworkPacket::CommandRequiresAuth() const
 {
-    switch (GetCommand())
+    return CommandRequiresAuth(GetCommand());
+}
+
+bool NetworkPacket::CommandRequiresAuth(NetworkCommand command)
+{
+    switch (command)
     {
         case NetworkCommand::Ping:
         case NetworkCommand::Auth:
@@ -60,6 +67,24 @@ bool NetworkPacket::CommandRequiresAuth()
     }
 }
 
+NetworkSharedPacket NetworkPacket::Encode() const
+{
+    PacketHeader header{ static_cast<uint16_t>(Data.size()), Header.Id };
+
+    // NOTE: For compatibility reasons for the master server we need to add sizeof(Header.Id) to the size.
+    // Previously the Id field was not part of the header rather part of the body.
+    header.Size += sizeof(header.Id);
+    header.Size = Convert::HostToNetwork(header.Size);
+    header.Id = ByteSwapBE(header.Id);
+
+    auto buffer = std::make_shared<std::vector<uint8_t>>();
+    buffer->reserve(sizeof(header) + Data.size());
+    const auto* headerBytes = reinterpret_cast<const uint8_t*>(&header);
+    buffer->insert(buffer->end(), headerBytes, headerBytes + sizeof(header));
+    buffer->insert(buffer->end(), Data.begin(), Data.end());
+    return { Header.Id, std::move(buffer) };
+}
+
 void NetworkPacket::Write(const void* bytes, size_t size)
 {
     const uint8_t* src = reinterpret_cast<const uint8_t*>(bytes);
@@ -87,18 +112,19 @@ const uint8_t* NetworkPacket::Read(size_t size)
 
 const utf8* NetworkPacket::ReadString()
 {
-    char* str = reinterpret_cast<char*>(&GetData()[BytesRead]);
-    char* strend = str;
-    while (BytesRead < Header.Size && *strend != 0)
+    if (BytesRead >= Header.Size)
     {
-        BytesRead++;
-        strend++;
+        return nullptr;
     }
-    if (*strend != 0)
+
+    char* str = reinterpret_cast<char*>(&GetData()[BytesRead]);
+    auto strend = static_cast<char*>(std::memchr(str, 0, Header.Size - BytesRead));
+    if (strend == nullptr)
     {
+        BytesRead = Header.Size;
         return nullptr;
     }
-    BytesRead++;
+    BytesRead += (strend - str) + 1;
     return str;
 }
 
@@ -25,6 +25,16 @@ struct PacketHeader
 static_assert(sizeof(PacketHeader) == 6);
 #pragma pack(pop)
 
+/**
+ * A packet encoded with its header, ready to be sent. The buffer is immutable so a packet sent to many connections is
+ * encoded once and shared by all their send queues.
+ */
+struct NetworkSharedPacket
+{
+    NetworkCommand Command = NetworkCommand::Invalid;
+    std::shared_ptr<const std::vector<uint8_t>> Buffer;
+};
+
 struct NetworkPacket final
 {
     NetworkPacket() = default;
@@ -36,7 +46,10 @@ struct NetworkPacket final
     NetworkCommand GetCommand() const;
 
     void Clear();
-    bool CommandRequiresAuth();
+    bool CommandRequiresAuth() const;
+    static bool CommandRequiresAuth(NetworkCommand command);
+
+    NetworkSharedPacket Encode() const;
 
     const uint8_t* Read(size_t size);
     const utf8* ReadString();
@@ -28,7 +28,9 @@
 #    include "Socket.h"
 #    include "network.h"
 
+#    include <chrono>
 #    include <cstring>
+#    include <future>
 #    include <iterator>
 #    include <memory>
 #    include <random>
@@ -45,6 +47,7 @@ enum class MasterServerStatus
 #    ifndef DISABLE_HTTP
 constexpr int32_t MASTER_SERVER_REGISTER_TIME = 120 * 1000; // 2 minutes
 constexpr int32_t MASTER_SERVER_HEARTBEAT_TIME = 60 * 1000; // 1 minute
+constexpr std::chrono::milliseconds MASTER_SERVER_REQUEST_TIMEOUT = std::chrono::seconds(10);
 #    endif
 
 class NetworkServerAdvertiser final : public INetworkServerAdvertiser
@@ -69,6 +72,10 @@ private:
 
     // See https://github.com/OpenRCT2/OpenRCT2/issues/6277 and 4953
     bool _forceIPv4 = false;
+
+    // The request to the master server in flight, its response is handled by the game thread once it has arrived
+    std::future<Http::Response> _pendingRequest;
+    bool _pendingRequestIsHeartbeat = false;
 #    endif
 
 public:
@@ -141,6 +148,11 @@ private:
 #    ifndef DISABLE_HTTP
     void UpdateWAN()
     {
+        if (UpdatePendingRequest())
+        {
+            return;
+        }
+
         switch (_status)
         {
             case ADVERTISE_STATUS::UNREGISTERED:
@@ -187,18 +199,10 @@ private:
 
         request.body = body.dump();
         request.header["Content-Type"] = "application/json";
+        request.timeout = MASTER_SERVER_REQUEST_TIMEOUT;
 
-        Http::DoAsync(request, [&](Http::Response response) -> void {
-            if (response.status != Http::Status::Ok)
-            {
-                Console::Error::WriteLine("Unable to connect to master server");
-                return;
-            }
-
-            json_t root = Json::FromString(response.body);
-            root = Json::AsObject(root);
-            this->OnRegistrationResponse(root);
-        });
+        _pendingRequest = Http::DoAsync(request);
+        _pendingRequestIsHeartbeat = false;
     }
 
     void SendHeartbeat()
@@ -210,19 +214,53 @@ private:
         json_t body = GetHeartbeatJson();
         request.body = body.dump();
         request.header["Content-Type"] = "application/json";
+        request.timeout = MASTER_SERVER_REQUEST_TIMEOUT;
 
         _lastHeartbeatTime = platform_get_ticks();
-        Http::DoAsync(request, [&](Http::Response response) -> void {
-            if (response.status != Http::Status::Ok)
-            {
-                Console::Error::WriteLine("Unable to connect to master server");
-                return;
-            }
+        _pendingRequest = Http::DoAsync(request);
+        _pendingRequestIsHeartbeat = true;
+    }
+
+    /**
+     * Handles the response of the request to the master server once it has arrived, without waiting for it.
+     * @returns true if the request is still in flight.
+     */
+    bool UpdatePendingRequest()
+    {
+        if (!_pendingRequest.valid())
+        {
+            return false;
+        }
+        if (_pendingRequest.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+        {
+            return true;
+        }
 
+        auto response = _pendingRequest.get();
+        if (response.status != Http::Status::Ok)
+        {
+            Console::Error::WriteLine("Unable to connect to master server");
+            return false;
+        }
+
+        try
+        {
             json_t root = Json::FromString(response.body);
             root = Json::AsObject(root);
-            this->OnHeartbeatResponse(root);
-        });
+            if (_pendingRequestIsHeartbeat)
+            {
+                OnHeartbeatResponse(root);
+            }
+            else
+            {
+                OnRegistrationResponse(root);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            Console::Error::WriteLine("Invalid response from master server: %s", e.what());
+        }
+        return false;
     }
 
     /**
@@ -23,6 +23,24 @@ enum
 enum
 {
     NETWORK_TICK_FLAG_CHECKSUMS = 1 << 0,
+    NETWORK_TICK_FLAG_CHECKSUM_PART = 1 << 1,
+};
+
+enum
+{
+    NETWORK_MAP_FLAG_LAST_CHUNK = 1 << 0,
+};
+
+enum
+{
+    NETWORK_TICK_FRAME_FLAG_TICK = 1 << 0,
+};
+
+// Protocol features a client announces when authenticating, clients without them are sent the older packets.
+enum
+{
+    NETWORK_FEATURE_TICK_FRAMES = 1 << 0,
+    NETWORK_FEATURE_OBJECT_STREAM = 1 << 1,
 };
 
 enum
@@ -83,6 +101,12 @@ enum class NetworkCommand : uint32_t
     GameState,
     Scripts,
     Heartbeat,
+    RequestResync,
+    ResyncDigest,
+    ResyncParts,
+    ResyncData,
+    TickFrame,
+    Objects,
     Max,
     Invalid = static_cast<uint32_t>(-1),
 };
@@ -141,8 +165,25 @@ enum class NetworkStatisticsGroup : uint32_t
     Max,
 };
 
+struct NetworkCommandStats_t
+{
+    uint64_t packetsReceived;
+    uint64_t bytesReceived;
+    uint64_t packetsSent;
+    uint64_t bytesSent;
+};
+
 struct NetworkStats_t
 {
     uint64_t bytesReceived[EnumValue(NetworkStatisticsGroup::Max)];
     uint64_t bytesSent[EnumValue(NetworkStatisticsGroup::Max)];
+    NetworkCommandStats_t commands[EnumValue(NetworkCommand::Max)];
+};
+
+struct NetworkSendBacklog
+{
+    size_t QueuedPackets{};
+    size_t QueuedBytes{};
+    // Held back until a map download has been queued
+    size_t HeldPackets{};
 };
@@ -28,9 +28,17 @@
 #    include <algorithm>
 #    include <numeric>
 #    include <optional>
+#    include <thread>
 
 using namespace OpenRCT2;
 
+// How long the servers listed by the master server are shown again without asking it
+static constexpr uint32_t ONLINE_SERVER_LIST_CACHE_TIME_MS = 60 * 1000;
+
+static std::mutex _onlineServerListCacheMutex;
+static std::vector<ServerListEntry> _onlineServerListCache;
+static std::optional<uint32_t> _onlineServerListCacheTime;
+
 int32_t ServerListEntry::CompareTo(const ServerListEntry& other) const
 {
     const auto& a = *this;
@@ -238,115 +246,139 @@ bool ServerList::WriteFavourites(const std::vector<ServerListEntry>& entries) co
     }
 }
 
-std::future<std::vector<ServerListEntry>> ServerList::FetchLocalServerListAsync(const INetworkEndpoint& broadcastEndpoint) const
+void ServerListFetch::BeginQuery()
 {
-    auto broadcastAddress = broadcastEndpoint.GetHostname();
-    return std::async(std::launch::async, [broadcastAddress] {
-        constexpr auto RECV_DELAY_MS = 10;
-        constexpr auto RECV_WAIT_MS = 2000;
+    std::lock_guard<std::mutex> lock(_mutex);
+    _pendingQueries++;
+}
 
-        std::string_view msg = NETWORK_LAN_BROADCAST_MSG;
-        auto udpSocket = CreateUdpSocket();
+void ServerListFetch::AddEntries(std::vector<ServerListEntry>&& entries)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _entries.insert(_entries.end(), std::make_move_iterator(entries.begin()), std::make_move_iterator(entries.end()));
+}
 
-        log_verbose("Broadcasting %zu bytes to the LAN (%s)", msg.size(), broadcastAddress.c_str());
-        auto len = udpSocket->SendData(broadcastAddress, NETWORK_LAN_BROADCAST_PORT, msg.data(), msg.size());
-        if (len != msg.size())
-        {
-            throw std::runtime_error("Unable to broadcast server query.");
-        }
+void ServerListFetch::EndQuery(rct_string_id status)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _pendingQueries--;
+    if (status != STR_NONE)
+    {
+        _status = status;
+    }
+}
+
+std::vector<ServerListEntry> ServerListFetch::TakeEntries()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return std::move(_entries);
+}
+
+bool ServerListFetch::IsFinished() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _pendingQueries == 0;
+}
+
+rct_string_id ServerListFetch::GetStatus() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _status;
+}
+
+void ServerList::FetchLocalServerListAsync(const std::shared_ptr<ServerListFetch>& fetch) const
+{
+    // Every broadcast address is queried on its own thread, the servers are added as they answer
+    for (const auto& broadcastEndpoint : GetBroadcastAddresses())
+    {
+        auto broadcastAddress = broadcastEndpoint->GetHostname();
+        fetch->BeginQuery();
+        std::thread([fetch, broadcastAddress] {
+            constexpr auto RECV_DELAY_MS = 10;
+            constexpr auto RECV_WAIT_MS = 2000;
 
-        std::vector<ServerListEntry> entries;
-        for (int i = 0; i < (RECV_WAIT_MS / RECV_DELAY_MS); i++)
-        {
             try
             {
-                // Start with initialised buffer in case we receive a non-terminated string
-                char buffer[1024]{};
-                size_t recievedLen{};
-                std::unique_ptr<INetworkEndpoint> endpoint;
-                auto p = udpSocket->ReceiveData(buffer, sizeof(buffer) - 1, &recievedLen, &endpoint);
-                if (p == NetworkReadPacket::Success)
+                std::string_view msg = NETWORK_LAN_BROADCAST_MSG;
+                auto udpSocket = CreateUdpSocket();
+
+                log_verbose("Broadcasting %zu bytes to the LAN (%s)", msg.size(), broadcastAddress.c_str());
+                auto len = udpSocket->SendData(broadcastAddress, NETWORK_LAN_BROADCAST_PORT, msg.data(), msg.size());
+                if (len != msg.size())
                 {
-                    auto sender = endpoint->GetHostname();
-                    log_verbose("Received %zu bytes back from %s", recievedLen, sender.c_str());
-                    auto jinfo = Json::FromString(std::string_view(buffer));
+                    throw std::runtime_error("Unable to broadcast server query.");
+                }
 
-                    if (jinfo.is_object())
+                for (int i = 0; i < (RECV_WAIT_MS / RECV_DELAY_MS); i++)
+                {
+                    try
                     {
-                        jinfo["ip"] = { { "v4", { sender } } };
-
-                        auto entry = ServerListEntry::FromJson(jinfo);
-                        if (entry.has_value())
+                        // Start with initialised buffer in case we receive a non-terminated string
+                        char buffer[1024]{};
+                        size_t recievedLen{};
+                        std::unique_ptr<INetworkEndpoint> endpoint;
+                        auto p = udpSocket->ReceiveData(buffer, sizeof(buffer) - 1, &recievedLen, &endpoint);
+                        if (p == NetworkReadPacket::Success)
                         {
-                            (*entry).Local = true;
-                            entries.push_back(std::move(*entry));
+                            auto sender = endpoint->GetHostname();
+                            log_verbose("Received %zu bytes back from %s", recievedLen, sender.c_str());
+                            auto jinfo = Json::FromString(std::string_view(buffer));
+
+                            if (jinfo.is_object())
+                            {
+                                jinfo["ip"] = { { "v4", { sender } } };
+
+                                auto entry = ServerListEntry::FromJson(jinfo);
+                                if (entry.has_value())
+                                {
+                                    (*entry).Local = true;
+                                    fetch->AddEntries({ std::move(*entry) });
+                                }
+                            }
                         }
                     }
+                    catch (const std::exception& e)
+                    {
+                        log_warning("Error receiving data: %s", e.what());
+                    }
+                    platform_sleep(RECV_DELAY_MS);
                 }
             }
             catch (const std::exception& e)
             {
-                log_warning("Error receiving data: %s", e.what());
+                log_warning("Unable to query the LAN (%s): %s", broadcastAddress.c_str(), e.what());
             }
-            platform_sleep(RECV_DELAY_MS);
-        }
-        return entries;
-    });
+            fetch->EndQuery();
+        }).detach();
+    }
 }
 
-std::future<std::vector<ServerListEntry>> ServerList::FetchLocalServerListAsync() const
+void ServerList::FetchOnlineServerListAsync(const std::shared_ptr<ServerListFetch>& fetch, bool refresh) const
 {
-    return std::async(std::launch::async, [&] {
-        // Get all possible LAN broadcast addresses
-        auto broadcastEndpoints = GetBroadcastAddresses();
-
-        // Spin off a fetch for each broadcast address
-        std::vector<std::future<std::vector<ServerListEntry>>> futures;
-        for (const auto& broadcastEndpoint : broadcastEndpoints)
-        {
-            auto f = FetchLocalServerListAsync(*broadcastEndpoint);
-            futures.push_back(std::move(f));
-        }
-
-        // Wait and merge all results
-        std::vector<ServerListEntry> mergedEntries;
-        for (auto& f : futures)
+    {
+        std::lock_guard<std::mutex> lock(_onlineServerListCacheMutex);
+        if (!refresh && _onlineServerListCacheTime.has_value()
+            && platform_get_ticks() - *_onlineServerListCacheTime < ONLINE_SERVER_LIST_CACHE_TIME_MS)
         {
-            try
-            {
-                auto entries = f.get();
-                mergedEntries.insert(mergedEntries.begin(), entries.begin(), entries.end());
-            }
-            catch (...)
-            {
-                // Ignore any exceptions from a particular broadcast fetch
-            }
+            auto entries = _onlineServerListCache;
+            fetch->AddEntries(std::move(entries));
+            return;
         }
-        return mergedEntries;
-    });
-}
-
-std::future<std::vector<ServerListEntry>> ServerList::FetchOnlineServerListAsync() const
-{
-#    ifdef DISABLE_HTTP
-    return {};
-#    else
-
-    auto p = std::make_shared<std::promise<std::vector<ServerListEntry>>>();
-    auto f = p->get_future();
+    }
 
-    std::string masterServerUrl = OPENRCT2_MASTER_SERVER_URL;
+#    ifndef DISABLE_HTTP
+    Http::Request request;
+    request.url = OPENRCT2_MASTER_SERVER_URL;
     if (!gConfigNetwork.master_server_url.empty())
     {
-        masterServerUrl = gConfigNetwork.master_server_url;
+        request.url = gConfigNetwork.master_server_url;
     }
-
-    Http::Request request;
-    request.url = masterServerUrl;
     request.method = Http::Method::GET;
     request.header["Accept"] = "application/json";
-    Http::DoAsync(request, [p](Http::Response& response) -> void {
-        json_t root;
+
+    fetch->BeginQuery();
+    Http::DoAsync(request, [fetch](Http::Response& response) {
+        auto status = STR_NONE;
         try
         {
             if (response.status != Http::Status::Ok)
@@ -354,7 +386,7 @@ std::future<std::vector<ServerListEntry>> ServerList::FetchOnlineServerListAsync
                 throw MasterServerException(STR_SERVER_LIST_NO_CONNECTION);
             }
 
-            root = Json::FromString(response.body);
+            auto root = Json::FromString(response.body);
             if (root.is_object())
             {
                 auto jsonStatus = root["status"];
@@ -363,8 +395,8 @@ std::future<std::vector<ServerListEntry>> ServerList::FetchOnlineServerListAsync
                     throw MasterServerException(STR_SERVER_LIST_INVALID_RESPONSE_JSON_NUMBER);
                 }
 
-                auto status = Json::GetNumber<int32_t>(jsonStatus);
-                if (status != 200)
+                auto masterServerStatus = Json::GetNumber<int32_t>(jsonStatus);
+                if (masterServerStatus != 200)
                 {
                     throw MasterServerException(STR_SERVER_LIST_MASTER_SERVER_FAILED);
                 }
@@ -388,18 +420,36 @@ std::future<std::vector<ServerListEntry>> ServerList::FetchOnlineServerListAsync
                     }
                 }
 
-                p->set_value(entries);
+                {
+                    std::lock_guard<std::mutex> lock(_onlineServerListCacheMutex);
+                    _onlineServerListCache = entries;
+                    _onlineServerListCacheTime = platform_get_ticks();
+                }
+                fetch->AddEntries(std::move(entries));
             }
         }
-        catch (...)
+        catch (const MasterServerException& e)
+        {
+            status = e.StatusText;
+        }
+        catch (const std::exception& e)
         {
-            p->set_exception(std::current_exception());
+            log_warning("Unable to connect to master server: %s", e.what());
+            status = STR_SERVER_LIST_NO_CONNECTION;
         }
+        fetch->EndQuery(status);
     });
-    return f;
 #    endif
 }
 
+std::shared_ptr<ServerListFetch> ServerList::FetchServersAsync(bool refresh) const
+{
+    auto fetch = std::make_shared<ServerListFetch>();
+    FetchLocalServerListAsync(fetch);
+    FetchOnlineServerListAsync(fetch, refresh);
+    return fetch;
+}
+
 uint32_t ServerList::GetTotalPlayerCount() const
 {
     return std::accumulate(_serverEntries.begin(), _serverEntries.end(), 0, [](uint32_t acc, const ServerListEntry& entry) {
@@ -11,8 +11,10 @@
 
 #include "../common.h"
 #include "../core/JsonFwd.hpp"
+#include "../localisation/StringIds.h"
 
-#include <future>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <stdexcept>
 #include <string>
@@ -45,6 +47,35 @@ struct ServerListEntry
     static std::optional<ServerListEntry> FromJson(json_t& server);
 };
 
+/**
+ * Servers found by a fetch running in the background. Each query hands over its servers as soon as it has them, so
+ * the list can be filled while slower queries are still waiting for an answer.
+ */
+class ServerListFetch
+{
+private:
+    mutable std::mutex _mutex;
+    std::vector<ServerListEntry> _entries;
+    size_t _pendingQueries{};
+    rct_string_id _status = STR_NONE;
+
+public:
+    void BeginQuery();
+    void AddEntries(std::vector<ServerListEntry>&& entries);
+    void EndQuery(rct_string_id status = STR_NONE);
+
+    /**
+     * Returns the servers found since the last call.
+     */
+    std::vector<ServerListEntry> TakeEntries();
+    bool IsFinished() const;
+
+    /**
+     * Returns the error of the online query, STR_NONE if it succeeded.
+     */
+    rct_string_id GetStatus() const;
+};
+
 class ServerList
 {
 private:
@@ -53,7 +84,8 @@ private:
     void Sort();
     std::vector<ServerListEntry> ReadFavourites() const;
     bool WriteFavourites(const std::vector<ServerListEntry>& entries) const;
-    std::future<std::vector<ServerListEntry>> FetchLocalServerListAsync(const INetworkEndpoint& broadcastEndpoint) const;
+    void FetchLocalServerListAsync(const std::shared_ptr<ServerListFetch>& fetch) const;
+    void FetchOnlineServerListAsync(const std::shared_ptr<ServerListFetch>& fetch, bool refresh) const;
 
 public:
     ServerListEntry& GetServer(size_t index);
@@ -65,8 +97,11 @@ public:
     void ReadAndAddFavourites();
     void WriteFavourites() const;
 
-    std::future<std::vector<ServerListEntry>> FetchLocalServerListAsync() const;
-    std::future<std::vector<ServerListEntry>> FetchOnlineServerListAsync() const;
+    /**
+     * Starts querying the LAN and the master server. The servers listed by the master server are cached for a while,
+     * unless refresh is set reopening the list uses them instead of asking again.
+     */
+    std::shared_ptr<ServerListFetch> FetchServersAsync(bool refresh) const;
     uint32_t GetTotalPlayerCount() const;
 };
 
@@ -9,6 +9,7 @@
 
 #ifndef DISABLE_NETWORK
 
+#    include <algorithm>
 #    include <atomic>
 #    include <chrono>
 #    include <cmath>
@@ -49,8 +50,10 @@
     #include <netdb.h>
     #include <netinet/in.h>
     #include <netinet/tcp.h>
+    #include <poll.h>
     #include <sys/ioctl.h>
     #include <sys/socket.h>
+    #include <sys/uio.h>
     #include "../common.h"
     using SOCKET = int32_t;
     #define SOCKET_ERROR -1
@@ -59,6 +62,8 @@
     #define closesocket close
     #define ioctlsocket ioctl
     #if defined(__linux__)
+        #include <sys/epoll.h>
+        #include <unistd.h>
         #define FLAG_NO_PIPE MSG_NOSIGNAL
     #else
         #define FLAG_NO_PIPE 0
@@ -565,6 +570,48 @@ public:
         return totalSent;
     }
 
+    size_t SendData(const SocketSendBuffer* buffers, size_t count) override
+    {
+        if (_status != SocketStatus::Connected)
+        {
+            throw std::runtime_error("Socket not connected.");
+        }
+
+#    ifdef _WIN32
+        std::vector<WSABUF> wsaBuffers(count);
+        for (size_t i = 0; i < count; i++)
+        {
+            wsaBuffers[i].buf = static_cast<CHAR*>(const_cast<void*>(buffers[i].Data));
+            wsaBuffers[i].len = static_cast<ULONG>(buffers[i].Size);
+        }
+
+        DWORD sentBytes = 0;
+        auto result = WSASend(_socket, wsaBuffers.data(), static_cast<DWORD>(count), &sentBytes, 0, nullptr, nullptr);
+        if (result == SOCKET_ERROR)
+        {
+            return 0;
+        }
+        return sentBytes;
+#    else
+        std::vector<iovec> ioBuffers(count);
+        for (size_t i = 0; i < count; i++)
+        {
+            ioBuffers[i].iov_base = const_cast<void*>(buffers[i].Data);
+            ioBuffers[i].iov_len = buffers[i].Size;
+        }
+
+        msghdr message{};
+        message.msg_iov = ioBuffers.data();
+        message.msg_iovlen = count;
+        auto sentBytes = sendmsg(_socket, &message, FLAG_NO_PIPE);
+        if (sentBytes == SOCKET_ERROR)
+        {
+            return 0;
+        }
+        return static_cast<size_t>(sentBytes);
+#    endif
+    }
+
     NetworkReadPacket ReceiveData(void* buffer, size_t size, size_t* sizeReceived) override
     {
         if (_status != SocketStatus::Connected)
@@ -628,6 +675,11 @@ public:
         return _ipAddress;
     }
 
+    SOCKET GetHandle() const
+    {
+        return _socket;
+    }
+
 private:
     explicit TcpSocket(SOCKET socket, const std::string& hostName, const std::string& ipAddress)
     {
@@ -894,6 +946,128 @@ std::unique_ptr<IUdpSocket> CreateUdpSocket()
     return std::make_unique<UdpSocket>();
 }
 
+#    ifdef __linux__
+/**
+ * Level triggered epoll, so the cost of a wait only depends on the number of sockets that are ready.
+ */
+class EpollSocketPoller final : public ISocketPoller
+{
+private:
+    int _epoll = -1;
+    size_t _numSockets = 0;
+    std::vector<epoll_event> _events;
+    std::vector<ITcpSocket*> _readySockets;
+
+public:
+    EpollSocketPoller()
+    {
+        _epoll = epoll_create1(EPOLL_CLOEXEC);
+        if (_epoll == -1)
+        {
+            throw SocketException("epoll_create1 failed with error: " + std::to_string(LAST_SOCKET_ERROR()));
+        }
+    }
+
+    ~EpollSocketPoller() override
+    {
+        close(_epoll);
+    }
+
+    void Add(ITcpSocket& socket) override
+    {
+        epoll_event ev{};
+        ev.events = EPOLLIN | EPOLLRDHUP;
+        ev.data.ptr = &socket;
+        if (epoll_ctl(_epoll, EPOLL_CTL_ADD, static_cast<TcpSocket&>(socket).GetHandle(), &ev) == 0)
+        {
+            _numSockets++;
+        }
+    }
+
+    void Remove(ITcpSocket& socket) override
+    {
+        if (epoll_ctl(_epoll, EPOLL_CTL_DEL, static_cast<TcpSocket&>(socket).GetHandle(), nullptr) == 0)
+        {
+            _numSockets--;
+        }
+    }
+
+    const std::vector<ITcpSocket*>& Wait(uint32_t timeoutMs) override
+    {
+        _readySockets.clear();
+        _events.resize(std::max<size_t>(_numSockets, 1));
+        int numEvents = epoll_wait(
+            _epoll, _events.data(), static_cast<int>(_events.size()), static_cast<int>(timeoutMs));
+        for (int i = 0; i < numEvents; i++)
+        {
+            _readySockets.push_back(static_cast<ITcpSocket*>(_events[i].data.ptr));
+        }
+        std::sort(_readySockets.begin(), _readySockets.end());
+        return _readySockets;
+    }
+};
+#    else
+class PollSocketPoller final : public ISocketPoller
+{
+private:
+    std::vector<ITcpSocket*> _sockets;
+    std::vector<pollfd> _fds;
+    std::vector<ITcpSocket*> _readySockets;
+
+public:
+    void Add(ITcpSocket& socket) override
+    {
+        _sockets.push_back(&socket);
+    }
+
+    void Remove(ITcpSocket& socket) override
+    {
+        _sockets.erase(std::remove(_sockets.begin(), _sockets.end(), &socket), _sockets.end());
+    }
+
+    const std::vector<ITcpSocket*>& Wait(uint32_t timeoutMs) override
+    {
+        _readySockets.clear();
+        _fds.resize(_sockets.size());
+        for (size_t i = 0; i < _sockets.size(); i++)
+        {
+            _fds[i].fd = static_cast<TcpSocket*>(_sockets[i])->GetHandle();
+            _fds[i].events = POLLIN;
+            _fds[i].revents = 0;
+        }
+
+        if (!_fds.empty())
+        {
+#        ifdef _WIN32
+            int numReady = WSAPoll(_fds.data(), static_cast<ULONG>(_fds.size()), static_cast<INT>(timeoutMs));
+#        else
+            int numReady = poll(_fds.data(), static_cast<nfds_t>(_fds.size()), static_cast<int>(timeoutMs));
+#        endif
+            for (size_t i = 0; i < _fds.size() && numReady > 0; i++)
+            {
+                if (_fds[i].revents != 0)
+                {
+                    _readySockets.push_back(_sockets[i]);
+                    numReady--;
+                }
+            }
+        }
+        std::sort(_readySockets.begin(), _readySockets.end());
+        return _readySockets;
+    }
+};
+#    endif
+
+std::unique_ptr<ISocketPoller> CreateSocketPoller()
+{
+    InitialiseWSA();
+#    ifdef __linux__
+    return std::make_unique<EpollSocketPoller>();
+#    else
+    return std::make_unique<PollSocketPoller>();
+#    endif
+}
+
 #    ifdef _WIN32
 static std::vector<INTERFACE_INFO> GetNetworkInterfaces()
 {
@@ -33,6 +33,15 @@ enum class NetworkReadPacket : int32_t
     Disconnected
 };
 
+/**
+ * A block of memory to send as part of a larger write.
+ */
+struct SocketSendBuffer
+{
+    const void* Data;
+    size_t Size;
+};
+
 /**
  * Represents an address and port.
  */
@@ -66,6 +75,11 @@ public:
     virtual void ConnectAsync(const std::string& address, uint16_t port) abstract;
 
     virtual size_t SendData(const void* buffer, size_t size) abstract;
+    /**
+     * Sends the buffers in order with a single call where the platform supports it, returns the number of bytes sent
+     * which is less than their total size once the socket can not take more.
+     */
+    virtual size_t SendData(const SocketSendBuffer* buffers, size_t count) abstract;
     virtual NetworkReadPacket ReceiveData(void* buffer, size_t size, size_t* sizeReceived) abstract;
 
     virtual void SetNoDelay(bool noDelay) abstract;
@@ -75,6 +89,24 @@ public:
     virtual void Close() abstract;
 };
 
+/**
+ * Waits on many TCP sockets at once, so that only the sockets with incoming data need to be read.
+ */
+struct ISocketPoller
+{
+public:
+    virtual ~ISocketPoller() = default;
+
+    virtual void Add(ITcpSocket& socket) abstract;
+    virtual void Remove(ITcpSocket& socket) abstract;
+
+    /**
+     * Returns the sockets that have data to read, a connection to accept or were closed, sorted by address. Waits at
+     * most the given time for one to become ready.
+     */
+    virtual const std::vector<ITcpSocket*>& Wait(uint32_t timeoutMs) abstract;
+};
+
 /**
  * Represents a UDP socket / listener.
  */
@@ -100,6 +132,7 @@ public:
 
 std::unique_ptr<ITcpSocket> CreateTcpSocket();
 std::unique_ptr<IUdpSocket> CreateUdpSocket();
+std::unique_ptr<ISocketPoller> CreateSocketPoller();
 std::vector<std::unique_ptr<INetworkEndpoint>> GetBroadcastAddresses();
 
 namespace Convert
@@ -50,6 +50,8 @@ int32_t network_begin_server(int32_t port, const std::string& address);
 int32_t network_get_mode();
 int32_t network_get_status();
 bool network_is_desynchronised();
+// Whether a client has received and loaded the map from the server
+bool network_is_map_loaded();
 bool network_check_desynchronisation();
 void network_request_gamestate_snapshot();
 void network_send_tick();
@@ -122,3 +124,9 @@ std::string network_get_version();
 NetworkStats_t network_get_stats();
 NetworkServerState_t network_get_server_state();
 json_t network_get_server_info_as_json();
+json_t network_get_stats_as_json();
+
+/**
+ * Returns the packets waiting to be sent, summed over all connections.
+ */
+NetworkSendBacklog network_get_send_backlog();
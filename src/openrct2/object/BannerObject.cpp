@@ -61,7 +61,8 @@ void BannerObject::Load()
 {
     GetStringTable().Sort();
     _legacyType.name = language_allocate_object_string(GetName());
-    _legacyType.image = gfx_object_allocate_images(GetImageTable().GetImages(), GetImageTable().GetCount());
+    _legacyType.image = gfx_object_allocate_images(
+        GetImageTable().GetImages(), GetImageTable().GetCount(), GetImageTable().GetLazyImageSource());
 }
 
 void BannerObject::Unload()
@@ -65,7 +65,8 @@ void FootpathItemObject::Load()
 {
     GetStringTable().Sort();
     _legacyType.name = language_allocate_object_string(GetName());
-    _legacyType.image = gfx_object_allocate_images(GetImageTable().GetImages(), GetImageTable().GetCount());
+    _legacyType.image = gfx_object_allocate_images(
+        GetImageTable().GetImages(), GetImageTable().GetCount(), GetImageTable().GetLazyImageSource());
 
     _legacyType.path_bit.scenery_tab_id = OBJECT_ENTRY_INDEX_NULL;
 }
@@ -26,6 +26,7 @@
 #include <algorithm>
 #include <memory>
 #include <stdexcept>
+#include <utility>
 
 using namespace OpenRCT2;
 using namespace OpenRCT2::Drawing;
@@ -320,6 +321,30 @@ void ImageTable::Read(IReadObjectContext* context, OpenRCT2::IStream* stream)
         }
 
         auto dataSize = static_cast<size_t>(imageDataSize);
+        auto dataReader = context->GetDataReader();
+        if (dataReader != nullptr)
+        {
+            // Only keep the headers, the pixel data is read again on first draw
+            for (uint32_t i = 0; i < numImages; i++)
+            {
+                rct_g1_element g1Element{};
+                _dataOffsets.push_back(stream->ReadValue<uint32_t>());
+                g1Element.width = stream->ReadValue<int16_t>();
+                g1Element.height = stream->ReadValue<int16_t>();
+                g1Element.x_offset = stream->ReadValue<int16_t>();
+                g1Element.y_offset = stream->ReadValue<int16_t>();
+                g1Element.flags = stream->ReadValue<uint16_t>();
+                g1Element.zoomed_offset = stream->ReadValue<uint16_t>();
+                _entries.push_back(std::move(g1Element));
+            }
+
+            _dataReader = std::move(dataReader);
+            _dataPosition = static_cast<size_t>(stream->GetPosition());
+            _dataSize = dataSize;
+            stream->SetPosition(std::min(stream->GetLength(), stream->GetPosition() + dataSize));
+            return;
+        }
+
         auto data = std::make_unique<uint8_t[]>(dataSize);
         if (data == nullptr)
         {
@@ -359,6 +384,7 @@ void ImageTable::Read(IReadObjectContext* context, OpenRCT2::IStream* stream)
         }
 
         _data = std::move(data);
+        _dataSize = dataSize;
         _entries.insert(_entries.end(), newEntries.begin(), newEntries.end());
     }
     catch (const std::exception&)
@@ -368,6 +394,93 @@ void ImageTable::Read(IReadObjectContext* context, OpenRCT2::IStream* stream)
     }
 }
 
+const rct_g1_element* ImageTable::LoadImageData()
+{
+    if (_data == nullptr && _dataReader != nullptr)
+    {
+        auto data = std::make_unique<uint8_t[]>(_dataSize);
+        size_t readBytes = 0;
+        try
+        {
+            readBytes = std::min(_dataReader(_dataPosition, data.get(), _dataSize), _dataSize);
+        }
+        catch (const std::exception& e)
+        {
+            log_error("Unable to read object images: %s", e.what());
+        }
+
+        // Same as for short image tables in Read, missing data is zeroed
+        std::fill_n(data.get() + readBytes, _dataSize - readBytes, 0);
+
+        for (size_t i = 0; i < _entries.size(); i++)
+        {
+            _entries[i].offset = data.get() + _dataOffsets[i];
+        }
+        _data = std::move(data);
+    }
+    else if (_imageTableReader != nullptr && !_imageDataLoaded)
+    {
+        std::unique_ptr<ImageTable> imageTable;
+        try
+        {
+            imageTable = _imageTableReader();
+        }
+        catch (const std::exception& e)
+        {
+            log_error("Unable to read object images: %s", e.what());
+        }
+
+        // Images that can not be read again stay empty, the same as images that were missing when the object was read
+        if (imageTable != nullptr && imageTable->_entries.size() == _entries.size())
+        {
+            for (size_t i = 0; i < _entries.size(); i++)
+            {
+                std::swap(_entries[i].offset, imageTable->_entries[i].offset);
+            }
+            _addedDataSize = imageTable->_addedDataSize;
+        }
+        _imageDataLoaded = true;
+    }
+    return _entries.data();
+}
+
+void ImageTable::UnloadImageData()
+{
+    if (_dataReader != nullptr)
+    {
+        for (auto& entry : _entries)
+        {
+            entry.offset = nullptr;
+        }
+        _data = nullptr;
+    }
+    else if (_imageTableReader != nullptr && _imageDataLoaded)
+    {
+        for (auto& entry : _entries)
+        {
+            delete[] entry.offset;
+            entry.offset = nullptr;
+        }
+        _addedDataSize = 0;
+        _imageDataLoaded = false;
+    }
+}
+
+size_t ImageTable::GetImageDataSize() const
+{
+    return _dataSize;
+}
+
+size_t ImageTable::GetMemoryUsage() const
+{
+    size_t size = _entries.capacity() * sizeof(rct_g1_element) + _dataOffsets.capacity() * sizeof(uint32_t);
+    if (_data != nullptr)
+    {
+        size += _dataSize;
+    }
+    return size + _addedDataSize;
+}
+
 void ImageTable::ReadJson(IReadObjectContext* context, json_t& root)
 {
     Guard::Assert(root.is_object(), "ImageTable::ReadJson expects parameter root to be object");
@@ -429,6 +542,14 @@ void ImageTable::ReadJson(IReadObjectContext* context, json_t& root)
                 }
             }
         }
+
+        // The images can be unloaded once the object is registered as lazy image source and read again when drawn
+        auto imageTableReader = context->GetImageTableReader();
+        if (imageTableReader != nullptr && GetCount() != 0)
+        {
+            _imageTableReader = std::move(imageTableReader);
+            _dataSize = _addedDataSize;
+        }
     }
 }
 
@@ -444,6 +565,7 @@ void ImageTable::AddImage(const rct_g1_element* g1)
     {
         newg1.offset = new uint8_t[length];
         std::copy_n(g1->offset, length, newg1.offset);
+        _addedDataSize += length;
     }
     _entries.push_back(std::move(newg1));
 }
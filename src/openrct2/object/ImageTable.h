@@ -13,6 +13,7 @@
 #include "../core/JsonFwd.hpp"
 #include "../drawing/Drawing.h"
 
+#include <functional>
 #include <memory>
 #include <vector>
 
@@ -22,12 +23,36 @@ namespace OpenRCT2
     struct IStream;
 }
 
-class ImageTable
+/**
+ * Reads length bytes at offset of the object data into buffer and returns the number of bytes read.
+ */
+using ObjectDataReader = std::function<size_t(size_t offset, void* buffer, size_t length)>;
+
+class ImageTable;
+
+/**
+ * Reads the images of a JSON object again into a new image table, returns nullptr if that is not possible.
+ */
+using ImageTableReader = std::function<std::unique_ptr<ImageTable>()>;
+
+class ImageTable final : public ILazyImageSource
 {
 private:
     std::unique_ptr<uint8_t[]> _data;
     std::vector<rct_g1_element> _entries;
 
+    // Only used when the pixel data is read on first draw
+    ObjectDataReader _dataReader;
+    std::vector<uint32_t> _dataOffsets;
+    size_t _dataPosition{};
+    size_t _dataSize{};
+    // Pixel data of the images added one by one, these own their data
+    size_t _addedDataSize{};
+
+    // Only used when the images of a JSON object are read again after they have been unloaded
+    ImageTableReader _imageTableReader;
+    bool _imageDataLoaded = true;
+
     /**
      * Container for a G1 image, additional information and RAII. Used by ReadJson
      */
@@ -46,7 +71,7 @@ public:
     ImageTable() = default;
     ImageTable(const ImageTable&) = delete;
     ImageTable& operator=(const ImageTable&) = delete;
-    ~ImageTable();
+    ~ImageTable() override;
 
     void Read(IReadObjectContext* context, OpenRCT2::IStream* stream);
     /**
@@ -62,4 +87,22 @@ public:
         return static_cast<uint32_t>(_entries.size());
     }
     void AddImage(const rct_g1_element* g1);
+
+    /**
+     * Returns the image table as lazy image source if its pixel data can be unloaded and read again on draw, otherwise
+     * nullptr.
+     */
+    ILazyImageSource* GetLazyImageSource()
+    {
+        return _dataReader != nullptr || _imageTableReader != nullptr ? this : nullptr;
+    }
+
+    const rct_g1_element* LoadImageData() override;
+    void UnloadImageData() override;
+    size_t GetImageDataSize() const override;
+
+    /**
+     * Returns the bytes held by the image headers and the pixel data that is currently loaded.
+     */
+    size_t GetMemoryUsage() const;
 };
@@ -177,11 +177,11 @@ std::optional<uint8_t> rct_object_entry::GetSceneryType() const
 class ZipStreamWrapper final : public IStream
 {
 private:
-    std::unique_ptr<IZipArchive> _zipArchive;
+    std::shared_ptr<IZipArchive> _zipArchive;
     std::unique_ptr<IStream> _base;
 
 public:
-    ZipStreamWrapper(std::unique_ptr<IZipArchive> zipArchive, std::unique_ptr<IStream> base)
+    ZipStreamWrapper(std::shared_ptr<IZipArchive> zipArchive, std::unique_ptr<IStream> base)
         : _zipArchive(std::move(zipArchive))
         , _base(std::move(base))
     {
@@ -246,7 +246,7 @@ bool ObjectAsset::IsAvailable() const
     }
     else
     {
-        auto zipArchive = Zip::TryOpen(_zipPath, ZIP_ACCESS::READ);
+        auto zipArchive = Zip::OpenCached(_zipPath);
         return zipArchive != nullptr && zipArchive->Exists(_path);
     }
 }
@@ -266,7 +266,7 @@ size_t ObjectAsset::GetSize() const
     }
     else
     {
-        auto zipArchive = Zip::TryOpen(_zipPath, ZIP_ACCESS::READ);
+        auto zipArchive = Zip::OpenCached(_zipPath);
         if (zipArchive != nullptr)
         {
             auto index = zipArchive->GetIndexFromPath(_path);
@@ -288,7 +288,7 @@ std::unique_ptr<IStream> ObjectAsset::GetStream() const
     }
     else
     {
-        auto zipArchive = Zip::TryOpen(_zipPath, ZIP_ACCESS::READ);
+        auto zipArchive = Zip::OpenCached(_zipPath);
         if (zipArchive != nullptr)
         {
             auto stream = zipArchive->GetFileStream(_path);
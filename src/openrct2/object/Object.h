@@ -233,6 +233,14 @@ struct IReadObjectContext
     virtual bool ShouldLoadImages() abstract;
     virtual std::vector<uint8_t> GetData(std::string_view path) abstract;
     virtual ObjectAsset GetAsset(std::string_view path) abstract;
+    /**
+     * Returns a reader for the object data if images should only be read on first draw, otherwise nullptr.
+     */
+    virtual ObjectDataReader GetDataReader() abstract;
+    /**
+     * Returns a reader for the images of a JSON object if they may be unloaded and read again, otherwise nullptr.
+     */
+    virtual ImageTableReader GetImageTableReader() abstract;
 
     virtual void LogWarning(ObjectError code, const utf8* text) abstract;
     virtual void LogError(ObjectError code, const utf8* text) abstract;
@@ -10,11 +10,12 @@
 #include "ObjectFactory.h"
 
 #include "../OpenRCT2.h"
+#include "../config/Config.h"
 #include "../core/Console.hpp"
 #include "../core/File.h"
-#include "../core/FileStream.h"
 #include "../core/Json.hpp"
 #include "../core/Memory.hpp"
+#include "../core/MemoryMappedFileStream.h"
 #include "../core/MemoryStream.h"
 #include "../core/Path.hpp"
 #include "../core/String.hpp"
@@ -39,7 +40,9 @@
 #include "WaterObject.h"
 
 #include <algorithm>
+#include <cstring>
 #include <unordered_map>
+#include <vector>
 
 struct IFileDataRetriever
 {
@@ -101,6 +104,8 @@ class ReadObjectContext : public IReadObjectContext
 private:
     IObjectRepository& _objectRepository;
     const IFileDataRetriever* _fileDataRetriever;
+    ObjectDataReader _dataReader;
+    ImageTableReader _imageTableReader;
 
     std::string _identifier;
     bool _loadImages;
@@ -161,6 +166,26 @@ public:
         return {};
     }
 
+    ObjectDataReader GetDataReader() override
+    {
+        return _dataReader;
+    }
+
+    void SetDataReader(ObjectDataReader dataReader)
+    {
+        _dataReader = std::move(dataReader);
+    }
+
+    ImageTableReader GetImageTableReader() override
+    {
+        return _imageTableReader;
+    }
+
+    void SetImageTableReader(ImageTableReader imageTableReader)
+    {
+        _imageTableReader = std::move(imageTableReader);
+    }
+
     void LogWarning(ObjectError code, const utf8* text) override
     {
         _wasWarning = true;
@@ -189,7 +214,8 @@ namespace ObjectFactory
      * @note jRoot is deliberately left non-const: json_t behaviour changes when const
      */
     static std::unique_ptr<Object> CreateObjectFromJson(
-        IObjectRepository& objectRepository, json_t& jRoot, const IFileDataRetriever* fileRetriever);
+        IObjectRepository& objectRepository, json_t& jRoot, const IFileDataRetriever* fileRetriever,
+        ImageTableReader imageTableReader, bool loadImages = !gOpenRCT2NoGraphics);
 
     static ObjectSourceGame ParseSourceGame(const std::string& s)
     {
@@ -224,14 +250,71 @@ namespace ObjectFactory
         }
     }
 
-    std::unique_ptr<Object> CreateObjectFromLegacyFile(IObjectRepository& objectRepository, const utf8* path)
+    /**
+     * Returns a reader that decodes the object chunk of the legacy object file again.
+     */
+    static ObjectDataReader GetLegacyFileDataReader(const utf8* path)
+    {
+        return [objectPath = std::string(path)](size_t offset, void* buffer, size_t length) -> size_t {
+            auto fs = OpenRCT2::MemoryMappedFileStream(objectPath);
+            auto chunkReader = SawyerChunkReader(&fs);
+            fs.Seek(sizeof(rct_object_entry), OpenRCT2::STREAM_SEEK_CURRENT);
+
+            auto chunk = chunkReader.ReadChunk();
+            if (offset >= chunk->GetLength())
+            {
+                return 0;
+            }
+            auto readBytes = std::min(length, chunk->GetLength() - offset);
+            std::memcpy(buffer, static_cast<const uint8_t*>(chunk->GetData()) + offset, readBytes);
+            return readBytes;
+        };
+    }
+
+    /**
+     * Returns a reader that reads the images of the JSON object file, or of the object.json in the zip file, again.
+     */
+    static ImageTableReader GetJsonFileImageTableReader(IObjectRepository& objectRepository, std::string_view path, bool isZip)
+    {
+        return [&objectRepository, objectPath = std::string(path), isZip]() -> std::unique_ptr<ImageTable> {
+            auto imageTable = std::make_unique<ImageTable>();
+            auto readImages = [&objectRepository, &imageTable](json_t& jRoot, const IFileDataRetriever& fileDataRetriever) {
+                if (jRoot.is_object())
+                {
+                    auto readContext = ReadObjectContext(
+                        objectRepository, Json::GetString(jRoot["id"]), true, &fileDataRetriever);
+                    imageTable->ReadJson(&readContext, jRoot);
+                }
+            };
+
+            if (isZip)
+            {
+                auto archive = Zip::OpenCached(objectPath);
+                if (archive == nullptr)
+                {
+                    return nullptr;
+                }
+                json_t jRoot = Json::FromVector(archive->GetFileData("object.json"));
+                readImages(jRoot, ZipDataRetriever(objectPath, *archive));
+            }
+            else
+            {
+                json_t jRoot = Json::ReadFromFile(objectPath.c_str());
+                readImages(jRoot, FileSystemDataRetriever(Path::GetDirectory(objectPath)));
+            }
+            return imageTable;
+        };
+    }
+
+    std::unique_ptr<Object> CreateObjectFromLegacyFile(
+        IObjectRepository& objectRepository, const utf8* path, bool loadImagesLazily)
     {
         log_verbose("CreateObjectFromLegacyFile(..., \"%s\")", path);
 
         std::unique_ptr<Object> result;
         try
         {
-            auto fs = OpenRCT2::FileStream(path, OpenRCT2::FILE_MODE_OPEN);
+            auto fs = OpenRCT2::MemoryMappedFileStream(path);
             auto chunkReader = SawyerChunkReader(&fs);
 
             rct_object_entry entry = fs.ReadValue<rct_object_entry>();
@@ -249,6 +332,10 @@ namespace ObjectFactory
 
                 auto chunkStream = OpenRCT2::MemoryStream(chunk->GetData(), chunk->GetLength());
                 auto readContext = ReadObjectContext(objectRepository, objectName, !gOpenRCT2NoGraphics, nullptr);
+                if (loadImagesLazily && gConfigGeneral.object_image_budget > 0)
+                {
+                    readContext.SetDataReader(GetLegacyFileDataReader(path));
+                }
                 ReadObjectLegacy(*result, &readContext, &chunkStream);
                 if (readContext.WasError())
                 {
@@ -380,11 +467,16 @@ namespace ObjectFactory
         return ObjectType::None;
     }
 
-    std::unique_ptr<Object> CreateObjectFromZipFile(IObjectRepository& objectRepository, std::string_view path)
+    std::unique_ptr<Object> CreateObjectFromZipFile(
+        IObjectRepository& objectRepository, std::string_view path, bool loadImagesLazily)
     {
         try
         {
-            auto archive = Zip::Open(path, ZIP_ACCESS::READ);
+            auto archive = Zip::OpenCached(path);
+            if (archive == nullptr)
+            {
+                throw std::runtime_error("Unable to open zip file.");
+            }
             auto jsonBytes = archive->GetFileData("object.json");
             if (jsonBytes.empty())
             {
@@ -396,7 +488,12 @@ namespace ObjectFactory
             if (jRoot.is_object())
             {
                 auto fileDataRetriever = ZipDataRetriever(path, *archive);
-                return CreateObjectFromJson(objectRepository, jRoot, &fileDataRetriever);
+                ImageTableReader imageTableReader;
+                if (loadImagesLazily && gConfigGeneral.object_image_budget > 0)
+                {
+                    imageTableReader = GetJsonFileImageTableReader(objectRepository, path, true);
+                }
+                return CreateObjectFromJson(objectRepository, jRoot, &fileDataRetriever, std::move(imageTableReader));
             }
         }
         catch (const std::exception& e)
@@ -406,7 +503,8 @@ namespace ObjectFactory
         return nullptr;
     }
 
-    std::unique_ptr<Object> CreateObjectFromJsonFile(IObjectRepository& objectRepository, const std::string& path)
+    std::unique_ptr<Object> CreateObjectFromJsonFile(
+        IObjectRepository& objectRepository, const std::string& path, bool loadImagesLazily)
     {
         log_verbose("CreateObjectFromJsonFile(\"%s\")", path.c_str());
 
@@ -414,7 +512,12 @@ namespace ObjectFactory
         {
             json_t jRoot = Json::ReadFromFile(path.c_str());
             auto fileDataRetriever = FileSystemDataRetriever(Path::GetDirectory(path));
-            return CreateObjectFromJson(objectRepository, jRoot, &fileDataRetriever);
+            ImageTableReader imageTableReader;
+            if (loadImagesLazily && gConfigGeneral.object_image_budget > 0)
+            {
+                imageTableReader = GetJsonFileImageTableReader(objectRepository, path, false);
+            }
+            return CreateObjectFromJson(objectRepository, jRoot, &fileDataRetriever, std::move(imageTableReader));
         }
         catch (const std::runtime_error& err)
         {
@@ -424,6 +527,59 @@ namespace ObjectFactory
         return nullptr;
     }
 
+    /**
+     * The index does not need the images, so the images array, which is most of the JSON of many objects, is dropped
+     * while parsing rather than built into the document.
+     */
+    static json_t ParseJsonForIndex(const std::vector<uint8_t>& jsonBytes)
+    {
+        return json_t::parse(
+            jsonBytes.begin(), jsonBytes.end(), [](int32_t depth, json_t::parse_event_t event, json_t& parsed) {
+                return !(depth == 1 && event == json_t::parse_event_t::key && parsed == "images");
+            });
+    }
+
+    std::unique_ptr<Object> CreateObjectForIndex(IObjectRepository& objectRepository, const std::string& path)
+    {
+        auto extension = Path::GetExtension(path);
+        if (!String::Equals(extension, ".json", true) && !String::Equals(extension, ".parkobj", true))
+        {
+            return CreateObjectFromLegacyFile(objectRepository, path.c_str());
+        }
+
+        try
+        {
+            if (String::Equals(extension, ".json", true))
+            {
+                json_t jRoot = ParseJsonForIndex(File::ReadAllBytes(path));
+                if (jRoot.is_object())
+                {
+                    auto fileDataRetriever = FileSystemDataRetriever(Path::GetDirectory(path));
+                    return CreateObjectFromJson(objectRepository, jRoot, &fileDataRetriever, {}, false);
+                }
+            }
+            else
+            {
+                auto archive = Zip::OpenCached(path);
+                if (archive == nullptr)
+                {
+                    throw std::runtime_error("Unable to open zip file.");
+                }
+                json_t jRoot = ParseJsonForIndex(archive->GetFileData("object.json"));
+                if (jRoot.is_object())
+                {
+                    auto fileDataRetriever = ZipDataRetriever(path, *archive);
+                    return CreateObjectFromJson(objectRepository, jRoot, &fileDataRetriever, {}, false);
+                }
+            }
+        }
+        catch (const std::exception& e)
+        {
+            Console::Error::WriteLine("Unable to open or read '%s': %s", path.c_str(), e.what());
+        }
+        return nullptr;
+    }
+
     static void ExtractSourceGames(const std::string& id, json_t& jRoot, Object& result)
     {
         auto sourceGames = jRoot["sourceGame"];
@@ -457,7 +613,8 @@ namespace ObjectFactory
     }
 
     std::unique_ptr<Object> CreateObjectFromJson(
-        IObjectRepository& objectRepository, json_t& jRoot, const IFileDataRetriever* fileRetriever)
+        IObjectRepository& objectRepository, json_t& jRoot, const IFileDataRetriever* fileRetriever,
+        ImageTableReader imageTableReader, bool loadImages)
     {
         Guard::Assert(jRoot.is_object(), "ObjectFactory::CreateObjectFromJson expects parameter jRoot to be object");
 
@@ -487,7 +644,8 @@ namespace ObjectFactory
             result = CreateObject(entry);
             result->SetIdentifier(id);
             result->MarkAsJsonObject();
-            auto readContext = ReadObjectContext(objectRepository, id, !gOpenRCT2NoGraphics, fileRetriever);
+            auto readContext = ReadObjectContext(objectRepository, id, loadImages, fileRetriever);
+            readContext.SetImageTableReader(std::move(imageTableReader));
             result->ReadJson(&readContext, jRoot);
             if (readContext.WasError())
             {
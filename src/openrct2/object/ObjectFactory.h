@@ -20,11 +20,28 @@ struct rct_object_entry;
 
 namespace ObjectFactory
 {
-    std::unique_ptr<Object> CreateObjectFromLegacyFile(IObjectRepository& objectRepository, const utf8* path);
+    /**
+     * @param loadImagesLazily Only read the pixel data of the images on first draw if object_image_budget is set.
+     */
+    std::unique_ptr<Object> CreateObjectFromLegacyFile(
+        IObjectRepository& objectRepository, const utf8* path, bool loadImagesLazily = false);
     std::unique_ptr<Object> CreateObjectFromLegacyData(
         IObjectRepository& objectRepository, const rct_object_entry* entry, const void* data, size_t dataSize);
-    std::unique_ptr<Object> CreateObjectFromZipFile(IObjectRepository& objectRepository, std::string_view path);
+    /**
+     * @param loadImagesLazily Allow the images to be unloaded and read again on draw if object_image_budget is set.
+     */
+    std::unique_ptr<Object> CreateObjectFromZipFile(
+        IObjectRepository& objectRepository, std::string_view path, bool loadImagesLazily = false);
     std::unique_ptr<Object> CreateObject(const rct_object_entry& entry);
 
-    std::unique_ptr<Object> CreateObjectFromJsonFile(IObjectRepository& objectRepository, const std::string& path);
+    /**
+     * @param loadImagesLazily Allow the images to be unloaded and read again on draw if object_image_budget is set.
+     */
+    std::unique_ptr<Object> CreateObjectFromJsonFile(
+        IObjectRepository& objectRepository, const std::string& path, bool loadImagesLazily = false);
+
+    /**
+     * Reads only what the object index needs, the images of JSON objects are skipped.
+     */
+    std::unique_ptr<Object> CreateObjectForIndex(IObjectRepository& objectRepository, const std::string& path);
 } // namespace ObjectFactory
@@ -12,6 +12,7 @@
 #include "../Context.h"
 #include "../ParkImporter.h"
 #include "../core/Console.hpp"
+#include "../core/JobPool.h"
 #include "../core/Memory.hpp"
 #include "../localisation/StringIds.h"
 #include "../util/Util.h"
@@ -27,11 +28,21 @@
 
 #include <algorithm>
 #include <array>
+#include <chrono>
 #include <memory>
-#include <mutex>
-#include <thread>
 #include <unordered_set>
 
+static std::unique_ptr<JobPool> _objectLoadJobs;
+
+static JobPool& GetObjectLoadJobPool()
+{
+    if (_objectLoadJobs == nullptr)
+    {
+        _objectLoadJobs = std::make_unique<JobPool>();
+    }
+    return *_objectLoadJobs;
+}
+
 class ObjectManager final : public IObjectManager
 {
 private:
@@ -628,89 +639,102 @@ private:
         return requiredObjects;
     }
 
-    template<typename T, typename TFunc> static void ParallelFor(const std::vector<T>& items, TFunc func)
-    {
-        auto partitions = std::thread::hardware_concurrency();
-        auto partitionSize = (items.size() + (partitions - 1)) / partitions;
-        std::vector<std::thread> threads;
-        for (size_t n = 0; n < partitions; n++)
-        {
-            auto begin = n * partitionSize;
-            auto end = std::min(items.size(), begin + partitionSize);
-            threads.emplace_back(
-                [func](size_t pbegin, size_t pend) {
-                    for (size_t i = pbegin; i < pend; i++)
-                    {
-                        func(i);
-                    }
-                },
-                begin, end);
-        }
-        for (auto& t : threads)
-        {
-            t.join();
-        }
-    }
-
     std::vector<std::unique_ptr<Object>> LoadObjects(
         std::vector<const ObjectRepositoryItem*>& requiredObjects, size_t* outNewObjectsLoaded)
     {
+        using Clock = std::chrono::high_resolution_clock;
+
         std::vector<std::unique_ptr<Object>> objects;
         std::vector<Object*> loadedObjects;
         std::vector<rct_object_entry> badObjects;
         objects.resize(OBJECT_ENTRY_COUNT);
         loadedObjects.reserve(OBJECT_ENTRY_COUNT);
 
-        // Read objects
-        std::mutex commonMutex;
-        ParallelFor(requiredObjects, [this, &commonMutex, requiredObjects, &objects, &badObjects, &loadedObjects](size_t i) {
+        // Objects already loaded are kept, the rest are read below
+        std::vector<Object*> previousObjects(requiredObjects.size());
+        std::vector<std::chrono::duration<float, std::milli>> readTimes(requiredObjects.size());
+        for (size_t i = 0; i < requiredObjects.size(); i++)
+        {
+            if (requiredObjects[i] != nullptr)
+            {
+                previousObjects[i] = requiredObjects[i]->LoadedObject;
+            }
+        }
+
+        // Read objects, this only parses files and decodes images so it does not touch any shared state
+        auto startTime = Clock::now();
+        GetObjectLoadJobPool().ParallelFor(0, requiredObjects.size(), 1, [&](size_t i) {
             auto requiredObject = requiredObjects[i];
-            std::unique_ptr<Object> object;
-            if (requiredObject != nullptr)
+            if (requiredObject != nullptr && previousObjects[i] == nullptr)
             {
-                auto loadedObject = requiredObject->LoadedObject;
-                if (loadedObject == nullptr)
+                auto readStartTime = Clock::now();
+                objects[i] = _objectRepository.LoadObject(requiredObject);
+                readTimes[i] = Clock::now() - readStartTime;
+            }
+        });
+        auto readEndTime = Clock::now();
+
+        // Register objects in entry order, so the result does not depend on which worker finished first
+        for (size_t i = 0; i < requiredObjects.size(); i++)
+        {
+            auto requiredObject = requiredObjects[i];
+            if (requiredObject == nullptr)
+            {
+                continue;
+            }
+
+            auto previousObject = previousObjects[i];
+            if (previousObject == nullptr)
+            {
+                // If the object successfully loaded it is registered as a loaded object, otherwise it is placed into the
+                // badObjects list.
+                if (objects[i] == nullptr)
                 {
-                    // Object requires to be loaded, if the object successfully loads it will register it
-                    // as a loaded object otherwise placed into the badObjects list.
-                    object = _objectRepository.LoadObject(requiredObject);
-                    std::lock_guard<std::mutex> guard(commonMutex);
-                    if (object == nullptr)
-                    {
-                        badObjects.push_back(requiredObject->ObjectEntry);
-                        ReportObjectLoadProblem(&requiredObject->ObjectEntry);
-                    }
-                    else
-                    {
-                        loadedObjects.push_back(object.get());
-                        // Connect the ori to the registered object
-                        _objectRepository.RegisterLoadedObject(requiredObject, object.get());
-                    }
+                    badObjects.push_back(requiredObject->ObjectEntry);
+                    ReportObjectLoadProblem(&requiredObject->ObjectEntry);
                 }
                 else
                 {
-                    // The object is already loaded, given that the new list will be used as the next loaded object list,
-                    // we can move the element out safely. This is required as the resulting list must contain all loaded
-                    // objects and not just the newly loaded ones.
-                    std::lock_guard<std::mutex> guard(commonMutex);
-                    auto it = std::find_if(_loadedObjects.begin(), _loadedObjects.end(), [loadedObject](const auto& obj) {
-                        return obj.get() == loadedObject;
-                    });
-                    if (it != _loadedObjects.end())
-                    {
-                        object = std::move(*it);
-                    }
+                    loadedObjects.push_back(objects[i].get());
+                    // Connect the ori to the registered object
+                    _objectRepository.RegisterLoadedObject(requiredObject, objects[i].get());
                 }
             }
-            objects[i] = std::move(object);
-        });
+            else
+            {
+                // The object is already loaded, given that the new list will be used as the next loaded object list,
+                // we can move the element out safely. This is required as the resulting list must contain all loaded
+                // objects and not just the newly loaded ones.
+                auto it = std::find_if(_loadedObjects.begin(), _loadedObjects.end(), [previousObject](const auto& obj) {
+                    return obj.get() == previousObject;
+                });
+                if (it != _loadedObjects.end())
+                {
+                    objects[i] = std::move(*it);
+                }
+            }
+        }
 
-        // Load objects
-        for (auto obj : loadedObjects)
+        // Load objects, image and string ids are allocated here so it has to be done in entry order on this thread
+        for (size_t i = 0; i < requiredObjects.size(); i++)
         {
-            obj->Load();
+            if (previousObjects[i] == nullptr && objects[i] != nullptr)
+            {
+                auto loadStartTime = Clock::now();
+                objects[i]->Load();
+                std::chrono::duration<float, std::milli> loadTime = Clock::now() - loadStartTime;
+                log_verbose(
+                    "Loaded object %s: read %.2f ms, load %.2f ms", requiredObjects[i]->Identifier.c_str(),
+                    readTimes[i].count(), loadTime.count());
+            }
         }
 
+        std::chrono::duration<float, std::milli> readTime = readEndTime - startTime;
+        std::chrono::duration<float, std::milli> totalTime = Clock::now() - startTime;
+        log_verbose(
+            "Loaded %zu objects in %.2f ms, %.2f ms reading on %zu threads", loadedObjects.size(), totalTime.count(),
+            readTime.count(), GetObjectLoadJobPool().CountThreads());
+
         if (!badObjects.empty())
         {
             // Unload all the new objects we loaded
@@ -39,6 +39,7 @@
 #include "RideObject.h"
 
 #include <algorithm>
+#include <cctype>
 #include <memory>
 #include <unordered_map>
 #include <vector>
@@ -72,6 +73,123 @@ struct ObjectEntryEqual
 using ObjectIdentifierMap = std::unordered_map<std::string, size_t>;
 using ObjectEntryMap = std::unordered_map<rct_object_entry, size_t, ObjectEntryHash, ObjectEntryEqual>;
 
+/**
+ * Trigram index over the lower case name, identifier, path and authors of each repository item. A search only has to
+ * check the items that contain the rarest trigram of the search text rather than every item in the repository.
+ */
+class ObjectSearchIndex
+{
+    // Searchable text of each item by ID, the fields are separated by new lines so matches never span two fields
+    std::vector<std::string> _text;
+    std::unordered_map<uint32_t, std::vector<uint32_t>> _trigrams;
+
+public:
+    void Clear()
+    {
+        _text.clear();
+        _trigrams.clear();
+    }
+
+    void Add(const ObjectRepositoryItem& item)
+    {
+        if (item.Id >= _text.size())
+        {
+            _text.resize(item.Id + 1);
+        }
+
+        auto& text = _text[item.Id];
+        text.clear();
+        AppendLower(text, item.Name);
+        AppendLower(text, item.Identifier);
+        AppendLower(text, item.Path);
+        for (const auto& author : item.Authors)
+        {
+            AppendLower(text, author);
+        }
+
+        const auto id = static_cast<uint32_t>(item.Id);
+        for (size_t i = 0; i + 3 <= text.size(); i++)
+        {
+            if (text[i] == '\n' || text[i + 1] == '\n' || text[i + 2] == '\n')
+                continue;
+
+            auto& ids = _trigrams[GetTrigram(text, i)];
+            if (ids.empty() || ids.back() != id)
+            {
+                ids.push_back(id);
+            }
+        }
+    }
+
+    /**
+     * Returns the IDs of the items that contain the given text in any of their fields, in ascending order. The text
+     * is matched case insensitively.
+     */
+    std::vector<size_t> Search(std::string_view query) const
+    {
+        std::string needle;
+        AppendLower(needle, query);
+        needle.pop_back();
+
+        std::vector<size_t> result;
+        if (needle.find('\n') != std::string::npos)
+        {
+            return result;
+        }
+
+        if (needle.size() < 3)
+        {
+            for (size_t id = 0; id < _text.size(); id++)
+            {
+                if (_text[id].find(needle) != std::string::npos)
+                {
+                    result.push_back(id);
+                }
+            }
+            return result;
+        }
+
+        // Every match contains all the trigrams of the search text, so only the items of the rarest one are checked
+        const std::vector<uint32_t>* candidates = nullptr;
+        for (size_t i = 0; i + 3 <= needle.size(); i++)
+        {
+            auto it = _trigrams.find(GetTrigram(needle, i));
+            if (it == _trigrams.end())
+            {
+                return result;
+            }
+            if (candidates == nullptr || it->second.size() < candidates->size())
+            {
+                candidates = &it->second;
+            }
+        }
+        for (auto id : *candidates)
+        {
+            if (_text[id].find(needle) != std::string::npos)
+            {
+                result.push_back(id);
+            }
+        }
+        return result;
+    }
+
+private:
+    static void AppendLower(std::string& dst, std::string_view src)
+    {
+        for (auto c : src)
+        {
+            dst.push_back(static_cast<char>(tolower(static_cast<unsigned char>(c))));
+        }
+        dst.push_back('\n');
+    }
+
+    static uint32_t GetTrigram(std::string_view text, size_t index)
+    {
+        return (static_cast<uint8_t>(text[index]) << 16) | (static_cast<uint8_t>(text[index + 1]) << 8)
+            | static_cast<uint8_t>(text[index + 2]);
+    }
+};
+
 class ObjectFileIndex final : public FileIndex<ObjectRepositoryItem>
 {
 private:
@@ -96,20 +214,7 @@ public:
 public:
     std::tuple<bool, ObjectRepositoryItem> Create([[maybe_unused]] int32_t language, const std::string& path) const override
     {
-        std::unique_ptr<Object> object;
-        auto extension = Path::GetExtension(path);
-        if (String::Equals(extension, ".json", true))
-        {
-            object = ObjectFactory::CreateObjectFromJsonFile(_objectRepository, path);
-        }
-        else if (String::Equals(extension, ".parkobj", true))
-        {
-            object = ObjectFactory::CreateObjectFromZipFile(_objectRepository, path);
-        }
-        else
-        {
-            object = ObjectFactory::CreateObjectFromLegacyFile(_objectRepository, path.c_str());
-        }
+        auto object = ObjectFactory::CreateObjectForIndex(_objectRepository, path);
         if (object != nullptr)
         {
             ObjectRepositoryItem item = {};
@@ -168,6 +273,7 @@ class ObjectRepository final : public IObjectRepository
     std::vector<ObjectRepositoryItem> _items;
     ObjectIdentifierMap _newItemMap;
     ObjectEntryMap _itemMap;
+    ObjectSearchIndex _searchIndex;
 
 public:
     explicit ObjectRepository(const std::shared_ptr<IPlatformEnvironment>& env)
@@ -247,6 +353,11 @@ public:
         return FindObject(entry.Identifier);
     }
 
+    std::vector<size_t> SearchObjects(std::string_view text) const override
+    {
+        return _searchIndex.Search(text);
+    }
+
     std::unique_ptr<Object> LoadObject(const ObjectRepositoryItem* ori) override
     {
         Guard::ArgumentNotNull(ori, GUARD_LINE);
@@ -254,15 +365,15 @@ public:
         auto extension = Path::GetExtension(ori->Path);
         if (String::Equals(extension, ".json", true))
         {
-            return ObjectFactory::CreateObjectFromJsonFile(*this, ori->Path);
+            return ObjectFactory::CreateObjectFromJsonFile(*this, ori->Path, true);
         }
         else if (String::Equals(extension, ".parkobj", true))
         {
-            return ObjectFactory::CreateObjectFromZipFile(*this, ori->Path);
+            return ObjectFactory::CreateObjectFromZipFile(*this, ori->Path, true);
         }
         else
         {
-            return ObjectFactory::CreateObjectFromLegacyFile(*this, ori->Path.c_str());
+            return ObjectFactory::CreateObjectFromLegacyFile(*this, ori->Path.c_str(), true);
         }
     }
 
@@ -368,6 +479,7 @@ private:
         _items.clear();
         _newItemMap.clear();
         _itemMap.clear();
+        _searchIndex.Clear();
     }
 
     void SortItems()
@@ -394,6 +506,13 @@ private:
                 _newItemMap[_items[i].Identifier] = i;
             }
         }
+
+        // Rebuild search index
+        _searchIndex.Clear();
+        for (const auto& item : _items)
+        {
+            _searchIndex.Add(item);
+        }
     }
 
     void AddItems(const std::vector<ObjectRepositoryItem>& items)
@@ -443,7 +562,10 @@ private:
         if (std::get<0>(result))
         {
             auto ori = std::get<1>(result);
-            AddItem(ori);
+            if (AddItem(ori))
+            {
+                _searchIndex.Add(_items.back());
+            }
         }
     }
 
@@ -705,6 +827,12 @@ const ObjectRepositoryItem* object_repository_get_items()
     return objectRepository.GetObjects();
 }
 
+std::vector<size_t> object_repository_search_objects(std::string_view text)
+{
+    auto& objectRepository = GetContext()->GetObjectRepository();
+    return objectRepository.SearchObjects(text);
+}
+
 const ObjectRepositoryItem* object_repository_find_object_by_entry(const rct_object_entry* entry)
 {
     auto& objectRepository = GetContext()->GetObjectRepository();
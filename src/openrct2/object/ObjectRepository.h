@@ -14,6 +14,7 @@
 #include "../ride/Ride.h"
 
 #include <memory>
+#include <string_view>
 #include <vector>
 
 namespace OpenRCT2
@@ -76,6 +77,7 @@ struct IObjectRepository
     virtual const ObjectRepositoryItem* FindObject(std::string_view identifier) const abstract;
     virtual const ObjectRepositoryItem* FindObject(const rct_object_entry* objectEntry) const abstract;
     virtual const ObjectRepositoryItem* FindObject(const ObjectEntryDescriptor& oed) const abstract;
+    virtual std::vector<size_t> SearchObjects(std::string_view text) const abstract;
 
     virtual std::unique_ptr<Object> LoadObject(const ObjectRepositoryItem* ori) abstract;
     virtual void RegisterLoadedObject(const ObjectRepositoryItem* ori, Object* object) abstract;
@@ -94,6 +96,7 @@ bool IsObjectCustom(const ObjectRepositoryItem* object);
 
 size_t object_repository_get_items_count();
 const ObjectRepositoryItem* object_repository_get_items();
+std::vector<size_t> object_repository_search_objects(std::string_view text);
 const ObjectRepositoryItem* object_repository_find_object_by_entry(const rct_object_entry* entry);
 const ObjectRepositoryItem* object_repository_find_object_by_name(const char* name);
 std::unique_ptr<Object> object_repository_load_object(const rct_object_entry* objectEntry);
@@ -23,6 +23,7 @@
 #include <algorithm>
 #include <array>
 #include <atomic>
+#include <vector>
 
 using namespace OpenRCT2;
 
@@ -297,8 +298,164 @@ template<> bool CheckBoundingBox<3>(const paint_struct_bound_box& initialBBox, c
     return false;
 }
 
+/**
+ * The copy of a paint struct that PaintSessionArrange() sorts. The quadrant list is sorted as an array of these, so the
+ * many comparisons read contiguous memory instead of following the list, and it is linked up again at the end. The
+ * steps of the sort are the same as on the list, so the order is identical.
+ */
+struct PaintSortNode
+{
+    paint_struct_bound_box Bounds;
+    uint16_t QuadrantIndex;
+    uint8_t QuadrantFlags;
+    uint16_t StructIndex;
+};
+
+struct PaintSortState
+{
+    // The nodes in list order, the first one is the paint head
+    std::vector<PaintSortNode> Nodes;
+    std::vector<paint_struct*> Structs;
+    std::vector<PaintSortNode> Matches;
+};
+
+static thread_local PaintSortState _paintSortState;
+
 template<uint8_t _TRotation>
-static paint_struct* PaintArrangeStructsHelperRotation(paint_struct* ps_next, uint16_t quadrantIndex, uint8_t flag)
+static size_t PaintArrangeStructsHelperRotation(PaintSortState& state, size_t start, uint16_t quadrantIndex, uint8_t flag)
+{
+    auto& nodes = state.Nodes;
+    const size_t count = nodes.size();
+
+    // Find the last node before the quadrant
+    size_t pos = start;
+    while (pos + 1 < count && quadrantIndex > nodes[pos + 1].QuadrantIndex)
+    {
+        pos++;
+    }
+    if (pos + 1 >= count)
+        return pos;
+
+    // Cache the last visited node so we don't have to walk the whole list again
+    const size_t cachePos = pos;
+
+    for (size_t i = pos + 1; i < count; i++)
+    {
+        auto& node = nodes[i];
+        if (node.QuadrantIndex > quadrantIndex + 1)
+        {
+            node.QuadrantFlags = PAINT_QUADRANT_FLAG_BIGGER;
+            break;
+        }
+        else if (node.QuadrantIndex == quadrantIndex + 1)
+        {
+            node.QuadrantFlags = PAINT_QUADRANT_FLAG_NEXT | PAINT_QUADRANT_FLAG_IDENTICAL;
+        }
+        else if (node.QuadrantIndex == quadrantIndex)
+        {
+            node.QuadrantFlags = flag | PAINT_QUADRANT_FLAG_IDENTICAL;
+        }
+    }
+
+    while (true)
+    {
+        size_t initialPos;
+        while (true)
+        {
+            initialPos = pos + 1;
+            if (initialPos >= count)
+                return cachePos;
+            const auto quadrantFlags = nodes[initialPos].QuadrantFlags;
+            if (quadrantFlags & PAINT_QUADRANT_FLAG_BIGGER)
+                return cachePos;
+            if (quadrantFlags & PAINT_QUADRANT_FLAG_IDENTICAL)
+                break;
+            pos = initialPos;
+        }
+
+        nodes[initialPos].QuadrantFlags &= ~PAINT_QUADRANT_FLAG_IDENTICAL;
+        const paint_struct_bound_box initialBBox = nodes[initialPos].Bounds;
+
+        // Every following node of the next quadrant that has to be drawn before the initial node is moved in front of
+        // it, the last one found goes first
+        auto& matches = state.Matches;
+        matches.clear();
+        size_t keptEnd = initialPos + 1;
+        size_t i = initialPos + 1;
+        for (; i < count; i++)
+        {
+            const auto& node = nodes[i];
+            if (node.QuadrantFlags & PAINT_QUADRANT_FLAG_BIGGER)
+                break;
+            if ((node.QuadrantFlags & PAINT_QUADRANT_FLAG_NEXT) && CheckBoundingBox<_TRotation>(initialBBox, node.Bounds))
+            {
+                matches.push_back(node);
+            }
+            else
+            {
+                if (keptEnd != i)
+                    nodes[keptEnd] = node;
+                keptEnd++;
+            }
+        }
+        if (!matches.empty())
+        {
+            std::move_backward(nodes.begin() + initialPos, nodes.begin() + keptEnd, nodes.begin() + i);
+            std::reverse_copy(matches.begin(), matches.end(), nodes.begin() + initialPos);
+        }
+    }
+}
+
+template<int TRotation> static void PaintSessionArrange(paint_session* session, bool)
+{
+    paint_struct* psHead = &session->PaintHead;
+    psHead->next_quadrant_ps = nullptr;
+
+    uint32_t quadrantIndex = session->QuadrantBackIndex;
+    if (quadrantIndex == UINT32_MAX)
+        return;
+
+    auto& state = _paintSortState;
+    state.Nodes.clear();
+    state.Structs.clear();
+
+    auto addNode = [&state](paint_struct* ps) {
+        const auto structIndex = static_cast<uint16_t>(state.Structs.size());
+        state.Nodes.push_back({ ps->bounds, ps->quadrant_index, ps->quadrant_flags, structIndex });
+        state.Structs.push_back(ps);
+    };
+    addNode(psHead);
+    do
+    {
+        for (auto* ps = session->Quadrants[quadrantIndex]; ps != nullptr; ps = ps->next_quadrant_ps)
+        {
+            addNode(ps);
+        }
+    } while (++quadrantIndex <= session->QuadrantFrontIndex);
+
+    size_t cachePos = PaintArrangeStructsHelperRotation<TRotation>(
+        state, 0, session->QuadrantBackIndex & 0xFFFF, PAINT_QUADRANT_FLAG_NEXT);
+
+    quadrantIndex = session->QuadrantBackIndex;
+    while (++quadrantIndex < session->QuadrantFrontIndex)
+    {
+        cachePos = PaintArrangeStructsHelperRotation<TRotation>(state, cachePos, quadrantIndex & 0xFFFF, 0);
+    }
+
+    // Link the structs up in the sorted order
+    const auto& nodes = state.Nodes;
+    for (size_t i = 0; i < nodes.size(); i++)
+    {
+        auto* ps = state.Structs[nodes[i].StructIndex];
+        ps->quadrant_flags = nodes[i].QuadrantFlags;
+        ps->next_quadrant_ps = i + 1 < nodes.size() ? state.Structs[nodes[i + 1].StructIndex] : nullptr;
+    }
+}
+
+#ifdef USE_BENCHMARK
+// The sort on the linked list that PaintSessionArrange() replaced, benchspritesort checks that both give the same order.
+template<uint8_t _TRotation>
+static paint_struct* PaintArrangeStructsHelperRotationReference(paint_struct* ps_next, uint16_t quadrantIndex, uint8_t flag)
 {
     paint_struct* ps;
     paint_struct* ps_temp;
@@ -383,7 +540,7 @@ static paint_struct* PaintArrangeStructsHelperRotation(paint_struct* ps_next, ui
     }
 }
 
-template<int TRotation> static void PaintSessionArrange(paint_session* session, bool)
+template<int TRotation> static void PaintSessionArrangeReference(paint_session* session)
 {
     paint_struct* psHead = &session->PaintHead;
 
@@ -408,16 +565,17 @@ template<int TRotation> static void PaintSessionArrange(paint_session* session,
             }
         } while (++quadrantIndex <= session->QuadrantFrontIndex);
 
-        paint_struct* ps_cache = PaintArrangeStructsHelperRotation<TRotation>(
+        paint_struct* ps_cache = PaintArrangeStructsHelperRotationReference<TRotation>(
             psHead, session->QuadrantBackIndex & 0xFFFF, PAINT_QUADRANT_FLAG_NEXT);
 
         quadrantIndex = session->QuadrantBackIndex;
         while (++quadrantIndex < session->QuadrantFrontIndex)
         {
-            ps_cache = PaintArrangeStructsHelperRotation<TRotation>(ps_cache, quadrantIndex & 0xFFFF, 0);
+            ps_cache = PaintArrangeStructsHelperRotationReference<TRotation>(ps_cache, quadrantIndex & 0xFFFF, 0);
         }
     }
 }
+#endif // USE_BENCHMARK
 
 /**
  *
@@ -439,6 +597,24 @@ void PaintSessionArrange(paint_session* session)
     Guard::Assert(false);
 }
 
+#ifdef USE_BENCHMARK
+void PaintSessionArrangeReference(paint_session* session)
+{
+    switch (session->CurrentRotation)
+    {
+        case 0:
+            return PaintSessionArrangeReference<0>(session);
+        case 1:
+            return PaintSessionArrangeReference<1>(session);
+        case 2:
+            return PaintSessionArrangeReference<2>(session);
+        case 3:
+            return PaintSessionArrangeReference<3>(session);
+    }
+    Guard::Assert(false);
+}
+#endif // USE_BENCHMARK
+
 static void PaintDrawStruct(paint_session* session, paint_struct* ps)
 {
     rct_drawpixelinfo* dpi = &session->DPI;
@@ -10,7 +10,7 @@
 #pragma once
 
 #include "../common.h"
-#include "../core/FixedVector.h"
+#include "../core/ChunkedVector.h"
 #include "../drawing/Drawing.h"
 #include "../interface/Colour.h"
 #include "../world/Location.hpp"
@@ -135,10 +135,14 @@ struct tunnel_entry
 #define MAX_PAINT_QUADRANTS 512
 #define TUNNEL_MAX_COUNT 65
 
+// Paint structs are allocated in chunks as a session needs them, up to MAX_PAINT_STRUCTS per session
+#define PAINT_STRUCT_CHUNK_SIZE 256
+#define MAX_PAINT_STRUCTS 65536
+
 struct paint_session
 {
     rct_drawpixelinfo DPI;
-    FixedVector<paint_entry, 4000> PaintStructs;
+    ChunkedVector<paint_entry, PAINT_STRUCT_CHUNK_SIZE> PaintStructs;
     paint_struct* Quadrants[MAX_PAINT_QUADRANTS];
     paint_struct* LastPS;
     paint_string_struct* PSStringHead;
@@ -169,24 +173,24 @@ struct paint_session
     uint16_t WaterHeight;
     uint32_t TrackColours[4];
 
-    constexpr bool NoPaintStructsAvailable() noexcept
+    bool NoPaintStructsAvailable() const noexcept
     {
-        return PaintStructs.size() >= PaintStructs.capacity();
+        return PaintStructs.size() >= MAX_PAINT_STRUCTS;
     }
 
-    constexpr paint_struct* AllocateNormalPaintEntry() noexcept
+    paint_struct* AllocateNormalPaintEntry()
     {
         LastPS = &PaintStructs.emplace_back().basic;
         return LastPS;
     }
 
-    constexpr attached_paint_struct* AllocateAttachedPaintEntry() noexcept
+    attached_paint_struct* AllocateAttachedPaintEntry()
     {
         LastAttachedPS = &PaintStructs.emplace_back().attached;
         return LastAttachedPS;
     }
 
-    constexpr paint_string_struct* AllocateStringPaintEntry() noexcept
+    paint_string_struct* AllocateStringPaintEntry()
     {
         auto* string = &PaintStructs.emplace_back().string;
         if (LastPSString == nullptr)
@@ -261,6 +265,9 @@ paint_session* PaintSessionAlloc(rct_drawpixelinfo* dpi, uint32_t viewFlags);
 void PaintSessionFree(paint_session* session);
 void PaintSessionGenerate(paint_session* session);
 void PaintSessionArrange(paint_session* session);
+#ifdef USE_BENCHMARK
+void PaintSessionArrangeReference(paint_session* session);
+#endif
 void PaintDrawStructs(paint_session* session);
 void PaintDrawMoneyStructs(rct_drawpixelinfo* dpi, paint_string_struct* ps);
 
@@ -9,21 +9,35 @@
 
 #include "Painter.h"
 
+#include "../Context.h"
 #include "../Game.h"
+#include "../GameState.h"
 #include "../Intro.h"
 #include "../OpenRCT2.h"
 #include "../ReplayManager.h"
 #include "../config/Config.h"
+#include "../core/Allocations.h"
+#include "../core/String.hpp"
 #include "../drawing/Drawing.h"
 #include "../drawing/IDrawingEngine.h"
 #include "../interface/Chat.h"
 #include "../interface/InteractiveConsole.h"
+#include "../interface/Viewport.h"
+#include "../interface/Window.h"
 #include "../localisation/FormatCodes.h"
 #include "../localisation/Formatting.h"
 #include "../localisation/Language.h"
+#include "../network/network.h"
 #include "../paint/Paint.h"
 #include "../title/TitleScreen.h"
 #include "../ui/UiContext.h"
+#include "../world/EntityList.h"
+
+#include <algorithm>
+#include <chrono>
+#include <numeric>
+#include <string>
+#include <vector>
 
 using namespace OpenRCT2;
 using namespace OpenRCT2::Drawing;
@@ -37,14 +51,24 @@ Painter::Painter(const std::shared_ptr<IUiContext>& uiContext)
 
 void Painter::Paint(IDrawingEngine& de)
 {
+    gfx_object_evict_lazy_images();
+
+    const auto allocationsAtStart = Allocations::GetCount();
     auto dpi = de.GetDrawingPixelInfo();
+    if (gConfigGeneral.show_performance_overlay)
+    {
+        gPaintTimings = &_paintTimings;
+    }
     if (gIntroState != IntroState::None)
     {
         intro_draw(dpi);
     }
     else
     {
+        window_flush_invalidations();
+        viewport_paint_cache_begin();
         de.PaintWindows();
+        viewport_paint_cache_end();
 
         update_palette_effects();
         _uiContext->Draw(dpi);
@@ -59,6 +83,7 @@ void Painter::Paint(IDrawingEngine& de)
 
         de.PaintWeather();
     }
+    gPaintTimings = nullptr;
 
     auto* replayManager = GetContext()->GetReplayManager();
     const char* text = nullptr;
@@ -77,6 +102,12 @@ void Painter::Paint(IDrawingEngine& de)
     {
         PaintFPS(dpi);
     }
+    if (gConfigGeneral.show_performance_overlay)
+    {
+        _frameAllocations += Allocations::GetCount() - allocationsAtStart;
+        MeasurePaintTimings();
+        PaintPerformanceOverlay(de, dpi);
+    }
     gCurrentDrawCount++;
 }
 
@@ -128,6 +159,124 @@ void Painter::MeasureFPS()
     _lastSecond = currentTime;
 }
 
+void Painter::MeasurePaintTimings()
+{
+    _paintTimingsFrames++;
+
+    auto currentTime = time(nullptr);
+    if (currentTime != _paintTimingsSecond)
+    {
+        _averagePaintTimings = _paintTimings;
+        _averagePaintTimings.Generate /= _paintTimingsFrames;
+        _averagePaintTimings.Arrange /= _paintTimingsFrames;
+        _averagePaintTimings.Draw /= _paintTimingsFrames;
+        _averagePaintTimings.Columns /= _paintTimingsFrames;
+        _averagePaintTimings.PaintStructs /= _paintTimingsFrames;
+        _averageFrameAllocations = static_cast<double>(_frameAllocations) / _paintTimingsFrames;
+        _paintTimings = {};
+        _frameAllocations = 0;
+        _paintTimingsFrames = 0;
+    }
+    _paintTimingsSecond = currentTime;
+}
+
+static double ToMilliseconds(std::chrono::duration<double> duration)
+{
+    return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+void Painter::PaintPerformanceOverlay(IDrawingEngine& de, rct_drawpixelinfo* dpi)
+{
+    std::vector<std::string> lines;
+
+    // Average time of the last ticks, with the parts that took the longest
+    auto* gameState = GetContext()->GetGameState();
+    const auto& logicTimings = gameState->GetPerformanceTimings();
+    const auto numTicks = std::min(logicTimings.NumMeasurements, LOGIC_UPDATE_MEASUREMENTS_COUNT);
+    if (numTicks > 0)
+    {
+        std::vector<std::pair<double, LogicTimePart>> parts;
+        double tickTime = 0;
+        for (const auto& [part, times] : logicTimings.TimingInfo)
+        {
+            auto partTime = ToMilliseconds(std::accumulate(
+                                times.begin(), times.begin() + numTicks, std::chrono::duration<double>()))
+                / numTicks;
+            parts.emplace_back(partTime, part);
+            tickTime += partTime;
+        }
+        std::sort(parts.begin(), parts.end(), [](const auto& a, const auto& b) { return a.first > b.first; });
+
+        lines.push_back(String::StdFormat("Tick: %.2f ms (last %zu ticks)", tickTime, numTicks));
+        for (size_t i = 0; i < std::min<size_t>(parts.size(), 5); i++)
+        {
+            const auto& [partTime, part] = parts[i];
+            lines.push_back(String::StdFormat("  %s: %.2f ms", GetLogicTimePartName(part), partTime));
+        }
+    }
+    else
+    {
+        lines.push_back("Tick: paused");
+    }
+
+    const auto& paintTimings = _averagePaintTimings;
+    lines.push_back(String::StdFormat(
+        "Paint: generate %.2f ms, arrange %.2f ms, draw %.2f ms", ToMilliseconds(paintTimings.Generate),
+        ToMilliseconds(paintTimings.Arrange), ToMilliseconds(paintTimings.Draw)));
+    lines.push_back(String::StdFormat(
+        "Paint structs: %u per frame, peak %u/%u per column", static_cast<uint32_t>(paintTimings.PaintStructs),
+        paintTimings.PeakPaintStructs, MAX_PAINT_STRUCTS));
+
+    if (Allocations::IsTracked() && numTicks > 0)
+    {
+        const auto tickAllocations = std::accumulate(
+            logicTimings.Allocations.begin(), logicTimings.Allocations.begin() + numTicks, uint64_t());
+        lines.push_back(String::StdFormat(
+            "Allocations: %.1f per tick, %.1f per frame", static_cast<double>(tickAllocations) / numTicks,
+            _averageFrameAllocations));
+    }
+
+    auto dirtyStats = de.GetLastFrameDirtyStats();
+    auto dirtyPercentage = dirtyStats.ScreenPixels != 0 ? (dirtyStats.Pixels * 100.0) / dirtyStats.ScreenPixels : 0.0;
+    lines.push_back(String::StdFormat("Dirty: %.1f%% of the screen, %u regions", dirtyPercentage, dirtyStats.Regions));
+
+    uint32_t numOtherEntities = 0;
+    for (auto type : { EntityType::SteamParticle, EntityType::MoneyEffect, EntityType::CrashedVehicleParticle,
+                       EntityType::ExplosionCloud, EntityType::CrashSplash, EntityType::ExplosionFlare,
+                       EntityType::JumpingFountain, EntityType::Balloon, EntityType::Duck })
+    {
+        numOtherEntities += GetEntityListCount(type);
+    }
+    lines.push_back(String::StdFormat(
+        "Entities: %u guests, %u staff, %u vehicles, %u litter, %u other, %u free", GetEntityListCount(EntityType::Guest),
+        GetEntityListCount(EntityType::Staff), GetEntityListCount(EntityType::Vehicle),
+        GetEntityListCount(EntityType::Litter), numOtherEntities, GetNumFreeEntities()));
+
+    if (network_get_mode() != NETWORK_MODE_NONE)
+    {
+        auto backlog = network_get_send_backlog();
+        lines.push_back(String::StdFormat(
+            "Network: %zu packets (%zu KiB) queued, %zu held", backlog.QueuedPackets, backlog.QueuedBytes / 1024,
+            backlog.HeldPackets));
+    }
+
+    constexpr int32_t LineHeight = 12;
+    const ScreenCoordsXY topLeft(8, 32);
+    auto screenCoords = topLeft;
+    int32_t maxWidth = 0;
+    for (const auto& line : lines)
+    {
+        char buffer[256]{};
+        FormatStringToBuffer(buffer, sizeof(buffer), "{MEDIUMFONT}{OUTLINE}{WHITE}{STRING}", line.c_str());
+        gfx_draw_string(dpi, screenCoords, buffer);
+        maxWidth = std::max(maxWidth, gfx_get_string_width(buffer, FontSpriteBase::MEDIUM));
+        screenCoords.y += LineHeight;
+    }
+
+    // Make area dirty so the text doesn't get drawn over the last
+    gfx_set_dirty_blocks({ topLeft - ScreenCoordsXY{ 4, 4 }, screenCoords + ScreenCoordsXY{ maxWidth + 4, 4 } });
+}
+
 paint_session* Painter::CreateSession(rct_drawpixelinfo* dpi, uint32_t viewFlags)
 {
     paint_session* session = nullptr;
@@ -167,5 +316,19 @@ paint_session* Painter::CreateSession(rct_drawpixelinfo* dpi, uint32_t viewFlags
 
 void Painter::ReleaseSession(paint_session* session)
 {
+    // Only keep the paint struct chunks this session needed, so pooled sessions do not hold on to large views
+    session->PaintStructs.shrink_to_fit();
     _freePaintSessions.push_back(session);
 }
+
+PaintSessionStats Painter::GetSessionStats() const
+{
+    PaintSessionStats stats{};
+    stats.Sessions = _paintSessionPool.size();
+    for (const auto& session : _paintSessionPool)
+    {
+        stats.PeakPaintStructs = std::max(stats.PeakPaintStructs, session->PaintStructs.peak_size());
+        stats.AllocatedPaintStructs += session->PaintStructs.capacity();
+    }
+    return stats;
+}
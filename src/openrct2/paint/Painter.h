@@ -10,6 +10,7 @@
 #pragma once
 
 #include "../common.h"
+#include "../interface/Viewport.h"
 #include "Paint.h"
 
 #include <ctime>
@@ -32,6 +33,13 @@ namespace OpenRCT2
 
     namespace Paint
     {
+        struct PaintSessionStats
+        {
+            size_t Sessions;
+            size_t PeakPaintStructs;
+            size_t AllocatedPaintStructs;
+        };
+
         struct Painter final
         {
         private:
@@ -42,17 +50,29 @@ namespace OpenRCT2
             int32_t _currentFPS = 0;
             int32_t _frames = 0;
 
+            // Paint stage times of the frames drawn this second and the average of the previous second
+            PaintTimings _paintTimings;
+            PaintTimings _averagePaintTimings;
+            // Heap allocations made while painting, summed per second like the paint timings
+            uint64_t _frameAllocations = 0;
+            double _averageFrameAllocations = 0;
+            uint32_t _paintTimingsFrames = 0;
+            time_t _paintTimingsSecond = 0;
+
         public:
             explicit Painter(const std::shared_ptr<Ui::IUiContext>& uiContext);
             void Paint(Drawing::IDrawingEngine& de);
 
             paint_session* CreateSession(rct_drawpixelinfo* dpi, uint32_t viewFlags);
             void ReleaseSession(paint_session* session);
+            PaintSessionStats GetSessionStats() const;
 
         private:
             void PaintReplayNotice(rct_drawpixelinfo* dpi, const char* text);
             void PaintFPS(rct_drawpixelinfo* dpi);
             void MeasureFPS();
+            void PaintPerformanceOverlay(Drawing::IDrawingEngine& de, rct_drawpixelinfo* dpi);
+            void MeasurePaintTimings();
         };
     } // namespace Paint
 } // namespace OpenRCT2
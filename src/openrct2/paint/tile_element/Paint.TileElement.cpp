@@ -210,17 +210,27 @@ static void sub_68B3FB(paint_session* session, int32_t x, int32_t y)
 
     const TileElement* element = tile_element; // push tile_element
 
+    // Elements above the clip height are not painted, so they must not keep the tile from being culled either
+    const bool clipView = (session->ViewFlags & VIEWPORT_FLAG_CLIP_VIEW) != 0;
+    const int32_t clipZ = gClipHeight * COORDS_Z_STEP;
     uint16_t max_height = 0;
     do
     {
-        max_height = std::max(max_height, static_cast<uint16_t>(element->GetClearanceZ()));
+        if (!clipView || element->GetBaseZ() <= clipZ)
+        {
+            max_height = std::max(max_height, static_cast<uint16_t>(element->GetClearanceZ()));
+        }
     } while (!(element++)->IsLastForTile());
 
     element--;
 
     if (element->GetType() == TILE_ELEMENT_TYPE_SURFACE && (element->AsSurface()->GetWaterHeight() > 0))
     {
-        max_height = element->AsSurface()->GetWaterHeight();
+        const auto waterHeight = element->AsSurface()->GetWaterHeight();
+        if (!clipView || waterHeight <= clipZ)
+        {
+            max_height = waterHeight;
+        }
     }
 
 #ifndef __TESTPAINT__
@@ -245,7 +255,7 @@ static void sub_68B3FB(paint_session* session, int32_t x, int32_t y)
     do
     {
         // Only paint tile_elements below the clip height.
-        if ((session->ViewFlags & VIEWPORT_FLAG_CLIP_VIEW) && (tile_element->GetBaseZ() > gClipHeight * COORDS_Z_STEP))
+        if (clipView && tile_element->GetBaseZ() > clipZ)
             continue;
 
         Direction direction = tile_element->GetDirectionWithOffset(rotation);
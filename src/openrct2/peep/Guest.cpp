@@ -22,6 +22,7 @@
 #include "../rct2/RCT2.h"
 #include "../ride/Ride.h"
 #include "../ride/RideData.h"
+#include "../ride/RideProximity.h"
 #include "../ride/ShopItem.h"
 #include "../ride/Station.h"
 #include "../ride/Track.h"
@@ -1535,6 +1536,7 @@ void Guest::OnExitRide(ride_id_t rideIndex)
     if (PeepFlags & PEEP_FLAGS_RIDE_SHOULD_BE_MARKED_AS_FAVOURITE)
     {
         PeepFlags &= ~PEEP_FLAGS_RIDE_SHOULD_BE_MARKED_AS_FAVOURITE;
+        ride_guest_favourite_changed(FavouriteRide, rideIndex);
         FavouriteRide = rideIndex;
         // TODO fix this flag name or add another one
         WindowInvalidateFlags |= PEEP_INVALIDATE_STAFF_STATS;
@@ -1621,19 +1623,36 @@ Ride* Guest::FindBestRideToGoOn()
 {
     // Pick the most exciting ride
     auto rideConsideration = FindRidesToGoOn();
+    const auto& summaries = GetRideConsiderationSummaries();
     Ride* mostExcitingRide = nullptr;
-    for (auto& ride : GetRideManager())
+    for (size_t rideIndex = 0; rideIndex < rideConsideration.size(); rideIndex++)
     {
-        if (rideConsideration.size() > ride.id && rideConsideration[ride.id])
+        if (!rideConsideration[rideIndex])
+            continue;
+
+        // Thinking about a ride has no side effects other than the random number unrated rides may draw, so rides that
+        // are closed or could not be more exciting than the current pick are skipped without checking the guest.
+        const auto& summary = summaries[rideIndex];
+        if (!summary.Open)
+            continue;
+        if (summary.HasRatings)
         {
-            if (!(ride.lifecycle_flags & RIDE_LIFECYCLE_QUEUE_FULL))
+            if (mostExcitingRide != nullptr && summary.Excitement <= mostExcitingRide->excitement)
+                continue;
+        }
+        else if (!summary.DrawsRandomWhileUnrated)
+        {
+            continue;
+        }
+
+        auto ride = get_ride(static_cast<ride_id_t>(rideIndex));
+        if (ride != nullptr && !(ride->lifecycle_flags & RIDE_LIFECYCLE_QUEUE_FULL))
+        {
+            if (ShouldGoOnRide(ride, 0, false, true) && ride_has_ratings(ride))
             {
-                if (ShouldGoOnRide(&ride, 0, false, true) && ride_has_ratings(&ride))
+                if (mostExcitingRide == nullptr || ride->excitement > mostExcitingRide->excitement)
                 {
-                    if (mostExcitingRide == nullptr || ride.excitement > mostExcitingRide->excitement)
-                    {
-                        mostExcitingRide = &ride;
-                    }
+                    mostExcitingRide = ride;
                 }
             }
         }
@@ -1662,33 +1681,11 @@ std::bitset<MAX_RIDES> Guest::FindRidesToGoOn()
     else
     {
         // Take nearby rides into consideration
-        constexpr auto radius = 10 * 32;
-        int32_t cx = floor2(x, 32);
-        int32_t cy = floor2(y, 32);
-        for (int32_t tileX = cx - radius; tileX <= cx + radius; tileX += COORDS_XY_STEP)
-        {
-            for (int32_t tileY = cy - radius; tileY <= cy + radius; tileY += COORDS_XY_STEP)
-            {
-                auto location = CoordsXY{ tileX, tileY };
-                if (!map_is_location_valid(location))
-                    continue;
-
-                for (auto* trackElement : TileElementsView<TrackElement>(location))
-                {
-                    auto rideIndex = trackElement->GetRideIndex();
-                    rideConsideration[rideIndex] = true;
-                }
-            }
-        }
+        constexpr auto radius = 10;
+        rideConsideration = GetRidesNearTile(TileCoordsXY(CoordsXY{ x, y }), radius);
 
         // Always take the tall rides into consideration (realistic as you can usually see them from anywhere in the park)
-        for (auto& ride : GetRideManager())
-        {
-            if (ride.highest_drop_height > 66 || ride.excitement >= RIDE_RATING(8, 00))
-            {
-                rideConsideration[ride.id] = true;
-            }
-        }
+        rideConsideration |= GetRidesVisibleFromAnywhere();
     }
 
     return rideConsideration;
@@ -9,28 +9,40 @@
 
 #include "GuestPathfinding.h"
 
+#include "../GameState.h"
+#include "../config/Config.h"
 #include "../core/Guard.hpp"
+#include "../core/JobPool.h"
+#include "../core/Trace.h"
 #include "../ride/RideData.h"
 #include "../ride/Station.h"
 #include "../ride/Track.h"
 #include "../scenario/Scenario.h"
 #include "../util/Util.h"
 #include "../world/Entrance.h"
+#include "../world/EntityList.h"
 #include "../world/Footpath.h"
 #include "Peep.h"
 #include "Staff.h"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cstring>
+#include <memory>
+#include <unordered_map>
+#include <vector>
 
-static bool _peepPathFindIsStaff;
-static int8_t _peepPathFindNumJunctions;
-static int8_t _peepPathFindMaxJunctions;
-static int32_t _peepPathFindTilesChecked;
-static uint8_t _peepPathFindFewestNumSteps;
+// The search state is per thread, so searches can be prefetched by the job pool.
+static thread_local bool _peepPathFindIsStaff;
+static thread_local int8_t _peepPathFindNumJunctions;
+static thread_local int8_t _peepPathFindMaxJunctions;
+static thread_local int32_t _peepPathFindTilesChecked;
+static thread_local uint8_t _peepPathFindFewestNumSteps;
 
-TileCoordsXYZ gPeepPathFindGoalPosition;
-bool gPeepPathFindIgnoreForeignQueues;
-ride_id_t gPeepPathFindQueueRideIndex;
+thread_local TileCoordsXYZ gPeepPathFindGoalPosition;
+thread_local bool gPeepPathFindIgnoreForeignQueues;
+thread_local ride_id_t gPeepPathFindQueueRideIndex;
 
 #if defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
 // Use to guard calls to log messages
@@ -41,16 +53,119 @@ utf8 gPathFindDebugPeepName[256];
 
 static int32_t guest_surface_path_finding(Peep* peep);
 
+uint16_t gGuestPathfindingBudget;
+
+// The number of heuristic searches guests have started this tick and the number of searches that have been put off
+// since the game started, see guest_path_finding_is_deferred().
+static int32_t _guestPathFindSearchesThisTick;
+static uint32_t _guestPathFindDeferredCount;
+// Tiles visited by all heuristic searches, including those run on the prefetch jobs
+static std::atomic<uint64_t> _peepPathFindTilesExpanded;
+
 /* A junction history for the peep pathfinding heuristic search
  * The magic number 16 is the largest value returned by
  * peep_pathfind_get_max_number_junctions() which should eventually
  * be declared properly. */
-static struct
+static thread_local struct
 {
     TileCoordsXYZ location;
     Direction direction;
 } _peepPathFindHistory[16];
 
+/* Guest searches towards the same goal from the same junction are very common (e.g. all the guests heading for the
+ * park exit), so the result of a single heuristic search (one test edge) is cached until the map changes.
+ * The search result also depends on the peep->PathfindHistory of the searching peep, so cached searches are done as
+ * if that history was empty and remember every thin junction at which the history would have been consulted. A cached
+ * result is only used by peeps that do not remember any of those junctions, which keeps the cache exact. */
+struct PathfindCacheKey
+{
+    TileCoordsXYZ Location;
+    TileCoordsXYZ Goal;
+    int32_t TilesChecked;
+    ride_id_t QueueRideIndex;
+    Direction TestEdge;
+    int8_t MaxJunctions;
+    bool IgnoreForeignQueues;
+
+    bool operator==(const PathfindCacheKey& other) const
+    {
+        return Location == other.Location && Goal == other.Goal && TilesChecked == other.TilesChecked
+            && QueueRideIndex == other.QueueRideIndex && TestEdge == other.TestEdge && MaxJunctions == other.MaxJunctions
+            && IgnoreForeignQueues == other.IgnoreForeignQueues;
+    }
+};
+
+struct PathfindCacheKeyHash
+{
+    size_t operator()(const PathfindCacheKey& key) const
+    {
+        size_t hash = (key.Location.x << 24) ^ (key.Location.y << 16) ^ (key.Location.z << 8) ^ key.TestEdge;
+        hash = hash * 31 + ((key.Goal.x << 16) ^ (key.Goal.y << 8) ^ key.Goal.z);
+        hash = hash * 31 + ((key.TilesChecked << 8) ^ key.MaxJunctions);
+        return hash * 31 + ((key.QueueRideIndex << 1) | (key.IgnoreForeignQueues ? 1 : 0));
+    }
+};
+
+struct PathfindCacheEntry
+{
+    uint16_t Score;
+    uint8_t Steps;
+    std::vector<TileCoordsXYZ> Junctions;
+};
+
+// Limits the memory used by the cache, it is simply emptied when full.
+constexpr size_t PATHFIND_CACHE_MAX_ENTRIES = 8192;
+
+static std::unordered_map<PathfindCacheKey, PathfindCacheEntry, PathfindCacheKeyHash> _peepPathFindCache;
+static thread_local bool _peepPathFindRecordJunctions;
+static thread_local std::vector<TileCoordsXYZ> _peepPathFindRecordedJunctions;
+
+/* Most of the heuristic search is spent walking along corridors of plain footpath, i.e. tiles with a single
+ * non-wide, non-queue path element with exactly one way to continue. The search does nothing on such a tile
+ * other than checking the search limits and the goal, so the corridors are looked up once and then walked
+ * through without looking at the tile elements again. */
+struct PathCorridorTile
+{
+    TileCoordsXYZ Location; // z is the base height of the path element
+    int32_t EntryZ;
+};
+
+struct PathCorridor
+{
+    std::vector<PathCorridorTile> Tiles;
+    TileCoordsXYZ ExitLocation;
+    Direction ExitDirection;
+};
+
+struct PathCorridorKey
+{
+    TileCoordsXYZ Location;
+    Direction EntryDirection;
+    bool IsStaff;
+
+    bool operator==(const PathCorridorKey& other) const
+    {
+        return Location == other.Location && EntryDirection == other.EntryDirection && IsStaff == other.IsStaff;
+    }
+};
+
+struct PathCorridorKeyHash
+{
+    size_t operator()(const PathCorridorKey& key) const
+    {
+        return (key.Location.x << 20) ^ (key.Location.y << 12) ^ (key.Location.z << 3) ^ (key.EntryDirection << 1)
+            ^ (key.IsStaff ? 1 : 0);
+    }
+};
+
+// Corridors are cut at this length, which is also the maximum number of steps of a search path.
+constexpr size_t PATHFIND_CORRIDOR_MAX_LENGTH = 200;
+constexpr size_t PATHFIND_CORRIDOR_CACHE_MAX_ENTRIES = 65536;
+
+static std::unordered_map<PathCorridorKey, PathCorridor, PathCorridorKeyHash> _peepPathFindCorridors;
+// Set while searches are prefetched on multiple threads, no new corridors are added to the cache then.
+static bool _peepPathFindCorridorsReadOnly;
+
 enum
 {
     PATH_SEARCH_DEAD_END,
@@ -475,23 +590,36 @@ static int32_t guest_path_find_aimless(Peep* peep, uint8_t edges)
     }
 }
 
+static uint8_t peep_pathfind_get_junction_limit(const Peep* peep);
+
 /**
  *
  *  rct2: 0x0069A60A
  */
 static uint8_t peep_pathfind_get_max_number_junctions(Peep* peep)
 {
-    if (peep->AssignedPeepType == PeepType::Staff)
-        return 8;
+    auto maxJunctions = peep_pathfind_get_junction_limit(peep);
 
     // PEEP_FLAGS_2? It's cleared here but not set anywhere!
-    if ((peep->PeepFlags & PEEP_FLAGS_2))
+    if (peep->AssignedPeepType != PeepType::Staff && (peep->PeepFlags & PEEP_FLAGS_2))
     {
         if ((scenario_rand() & 0xFFFF) <= 7281)
             peep->PeepFlags &= ~PEEP_FLAGS_2;
+    }
+    return maxJunctions;
+}
 
+/**
+ * Returns the max number of thin junctions the peep searches through, without
+ * the side effects of peep_pathfind_get_max_number_junctions().
+ */
+static uint8_t peep_pathfind_get_junction_limit(const Peep* peep)
+{
+    if (peep->AssignedPeepType == PeepType::Staff)
+        return 8;
+
+    if ((peep->PeepFlags & PEEP_FLAGS_2))
         return 8;
-    }
 
     if (peep->PeepFlags & PEEP_FLAGS_LEAVING_PARK && peep->GuestIsLostCountdown < 90)
     {
@@ -597,6 +725,122 @@ static constexpr const char* pathSearchToString(uint8_t pathFindSearchResult)
 }
 #endif
 
+/**
+ * Returns the path element on the given tile if it is the only element the heuristic search could walk onto when
+ * entering the tile at height z in the given direction, it is a plain (not wide, not queue) path and there is exactly
+ * one permitted edge to continue through. The tile is then simply walked through by the search.
+ */
+static PathElement* peep_pathfind_get_corridor_path(const TileCoordsXYZ& loc, Direction direction)
+{
+    TileElement* tileElement = map_get_first_element_at(loc.ToCoordsXY());
+    if (tileElement == nullptr)
+        return nullptr;
+
+    /* Follow the element checks done by the search: z is the entry height
+     * until a path has been found and the height of that path afterwards. */
+    PathElement* corridorPath = nullptr;
+    int32_t z = loc.z;
+    do
+    {
+        if (tileElement->IsGhost())
+            continue;
+
+        switch (tileElement->GetType())
+        {
+            case TILE_ELEMENT_TYPE_TRACK:
+            case TILE_ELEMENT_TYPE_ENTRANCE:
+                if (tileElement->base_height == z)
+                    return nullptr;
+                break;
+            case TILE_ELEMENT_TYPE_PATH:
+                if (!IsValidPathZAndDirection(tileElement, z, direction))
+                    break;
+                if (corridorPath != nullptr)
+                    return nullptr;
+                corridorPath = tileElement->AsPath();
+                z = tileElement->base_height;
+                break;
+        }
+    } while (!(tileElement++)->IsLastForTile());
+
+    if (corridorPath == nullptr || corridorPath->IsWide() || corridorPath->IsQueue()
+        || bitcount(corridorPath->GetEdges()) != 2)
+        return nullptr;
+
+    uint8_t edges = path_get_permitted_edges(corridorPath) & ~(1 << direction_reverse(direction));
+    if (bitcount(edges) != 1)
+        return nullptr;
+    return corridorPath;
+}
+
+/**
+ * Returns the corridor of plain path tiles the heuristic search walks through when leaving the tile loc (at height
+ * loc.z) in the given direction. The corridor is empty if the next tile needs to be looked at by the search.
+ * Returns nullptr if the corridor is not known yet and the cache is read only.
+ */
+static const PathCorridor* peep_pathfind_get_corridor(const TileCoordsXYZ& loc, Direction direction)
+{
+    PathCorridorKey key{ loc, direction, _peepPathFindIsStaff };
+    auto it = _peepPathFindCorridors.find(key);
+    if (it != _peepPathFindCorridors.end())
+        return &it->second;
+    if (_peepPathFindCorridorsReadOnly)
+        return nullptr;
+
+    if (_peepPathFindCorridors.size() >= PATHFIND_CORRIDOR_CACHE_MAX_ENTRIES)
+        _peepPathFindCorridors.clear();
+
+    PathCorridor corridor;
+    auto exitLoc = loc;
+    auto exitDirection = direction;
+    while (corridor.Tiles.size() < PATHFIND_CORRIDOR_MAX_LENGTH)
+    {
+        auto nextLoc = exitLoc;
+        nextLoc += TileDirectionDelta[exitDirection];
+        auto* pathElement = peep_pathfind_get_corridor_path(nextLoc, exitDirection);
+        if (pathElement == nullptr)
+            break;
+
+        Direction nextDirection = bitscanforward(
+            path_get_permitted_edges(pathElement) & ~(1 << direction_reverse(exitDirection)));
+        corridor.Tiles.push_back({ TileCoordsXYZ{ nextLoc.x, nextLoc.y, pathElement->base_height }, nextLoc.z });
+
+        exitLoc = TileCoordsXYZ{ nextLoc.x, nextLoc.y, pathElement->base_height };
+        if (pathElement->IsSloped() && pathElement->GetSlopeDirection() == nextDirection)
+        {
+            exitLoc.z += 2;
+        }
+        exitDirection = nextDirection;
+    }
+    corridor.ExitLocation = exitLoc;
+    corridor.ExitDirection = exitDirection;
+    return &_peepPathFindCorridors.emplace(key, std::move(corridor)).first->second;
+}
+
+/**
+ * Remembers the current search path as the best so far if it is better than the previous best.
+ */
+static void peep_pathfind_update_result(
+    const TileCoordsXYZ& loc, uint8_t counter, uint16_t score, uint16_t* endScore, uint8_t* endJunctions,
+    TileCoordsXYZ junctionList[16], uint8_t directionList[16], TileCoordsXYZ* endXYZ, uint8_t* endSteps)
+{
+    if (score < *endScore || (score == *endScore && counter < *endSteps))
+    {
+        *endScore = score;
+        *endSteps = counter;
+        *endXYZ = loc;
+        *endJunctions = _peepPathFindMaxJunctions - _peepPathFindNumJunctions;
+        for (uint8_t junctInd = 0; junctInd < *endJunctions; junctInd++)
+        {
+            uint8_t histIdx = _peepPathFindMaxJunctions - junctInd;
+            junctionList[junctInd].x = _peepPathFindHistory[histIdx].location.x;
+            junctionList[junctInd].y = _peepPathFindHistory[histIdx].location.y;
+            junctionList[junctInd].z = _peepPathFindHistory[histIdx].location.z;
+            directionList[junctInd] = _peepPathFindHistory[histIdx].direction;
+        }
+    }
+}
+
 /**
  * Searches for the tile with the best heuristic score within the search limits
  * starting from the given tile x,y,z and going in the given direction test_edge.
@@ -688,6 +932,56 @@ static void peep_pathfind_heuristic_search(
             currentElementIsWide = false;
     }
 
+    /* Walk through the corridor of plain path tiles ahead, doing only what the
+     * search would do on each of them: return at the start of the search,
+     * when leaving the patrol area, or when either the goal or a search limit
+     * is reached (updating the parameters with the best result so far). */
+    bool useCorridors = true;
+#if defined(DEBUG_LEVEL_2) && DEBUG_LEVEL_2
+    useCorridors = !gPathFindDebug;
+#endif // defined(DEBUG_LEVEL_2) && DEBUG_LEVEL_2
+    if (useCorridors)
+    {
+        const auto* corridor = peep_pathfind_get_corridor(loc, test_edge);
+        if (corridor != nullptr && !corridor->Tiles.empty())
+        {
+            const auto* mechanic = peep->As<Staff>();
+            if (mechanic != nullptr && !mechanic->IsMechanic())
+                mechanic = nullptr;
+
+            for (const auto& tile : corridor->Tiles)
+            {
+                ++counter;
+                _peepPathFindTilesChecked--;
+
+                if ((_peepPathFindHistory[0].location.x == static_cast<uint8_t>(tile.Location.x))
+                    && (_peepPathFindHistory[0].location.y == static_cast<uint8_t>(tile.Location.y))
+                    && (_peepPathFindHistory[0].location.z == tile.EntryZ))
+                    return;
+
+                if (mechanic != nullptr)
+                {
+                    bool nextInPatrolArea = mechanic->IsLocationInPatrol(tile.Location.ToCoordsXY());
+                    if (inPatrolArea && !nextInPatrolArea)
+                        return;
+                    inPatrolArea = nextInPatrolArea;
+                }
+
+                uint16_t score = CalculateHeuristicPathingScore(tile.Location, gPeepPathFindGoalPosition);
+                if (score == 0 || counter >= 200 || _peepPathFindTilesChecked <= 0)
+                {
+                    peep_pathfind_update_result(
+                        tile.Location, counter, score, endScore, endJunctions, junctionList, directionList, endXYZ, endSteps);
+                    return;
+                }
+            }
+
+            loc = corridor->ExitLocation;
+            test_edge = corridor->ExitDirection;
+            currentElementIsWide = false;
+        }
+    }
+
     loc += TileDirectionDelta[test_edge];
 
     ++counter;
@@ -888,24 +1182,8 @@ static void peep_pathfind_heuristic_search(
         {
             /* If the search result is better than the best so far (in the parameters),
              * then update the parameters with this search before continuing to the next map element. */
-            if (new_score < *endScore || (new_score == *endScore && counter < *endSteps))
-            {
-                // Update the search results
-                *endScore = new_score;
-                *endSteps = counter;
-                // Update the end x,y,z
-                *endXYZ = loc;
-                // Update the telemetry
-                *endJunctions = _peepPathFindMaxJunctions - _peepPathFindNumJunctions;
-                for (uint8_t junctInd = 0; junctInd < *endJunctions; junctInd++)
-                {
-                    uint8_t histIdx = _peepPathFindMaxJunctions - junctInd;
-                    junctionList[junctInd].x = _peepPathFindHistory[histIdx].location.x;
-                    junctionList[junctInd].y = _peepPathFindHistory[histIdx].location.y;
-                    junctionList[junctInd].z = _peepPathFindHistory[histIdx].location.z;
-                    directionList[junctInd] = _peepPathFindHistory[histIdx].direction;
-                }
-            }
+            peep_pathfind_update_result(
+                loc, counter, new_score, endScore, endJunctions, junctionList, directionList, endXYZ, endSteps);
 #if defined(DEBUG_LEVEL_2) && DEBUG_LEVEL_2
             if (gPathFindDebug)
             {
@@ -948,23 +1226,10 @@ static void peep_pathfind_heuristic_search(
              * If the search result is better than the best so far
              * (in the parameters), then update the parameters with
              * this search before continuing to the next map element. */
-            if (currentElementIsWide && (new_score < *endScore || (new_score == *endScore && counter < *endSteps)))
+            if (currentElementIsWide)
             {
-                // Update the search results
-                *endScore = new_score;
-                *endSteps = counter;
-                // Update the end x,y,z
-                *endXYZ = loc;
-                // Update the telemetry
-                *endJunctions = _peepPathFindMaxJunctions - _peepPathFindNumJunctions;
-                for (uint8_t junctInd = 0; junctInd < *endJunctions; junctInd++)
-                {
-                    uint8_t histIdx = _peepPathFindMaxJunctions - junctInd;
-                    junctionList[junctInd].x = _peepPathFindHistory[histIdx].location.x;
-                    junctionList[junctInd].y = _peepPathFindHistory[histIdx].location.y;
-                    junctionList[junctInd].z = _peepPathFindHistory[histIdx].location.z;
-                    directionList[junctInd] = _peepPathFindHistory[histIdx].direction;
-                }
+                peep_pathfind_update_result(
+                    loc, counter, new_score, endScore, endJunctions, junctionList, directionList, endXYZ, endSteps);
             }
 #if defined(DEBUG_LEVEL_2) && DEBUG_LEVEL_2
             if (gPathFindDebug)
@@ -1018,24 +1283,8 @@ static void peep_pathfind_heuristic_search(
              * The path continues, so the goal could still be reachable from here.
              * If the search result is better than the best so far (in the parameters),
              * then update the parameters with this search before continuing to the next map element. */
-            if (new_score < *endScore || (new_score == *endScore && counter < *endSteps))
-            {
-                // Update the search results
-                *endScore = new_score;
-                *endSteps = counter;
-                // Update the end x,y,z
-                *endXYZ = loc;
-                // Update the telemetry
-                *endJunctions = _peepPathFindMaxJunctions - _peepPathFindNumJunctions;
-                for (uint8_t junctInd = 0; junctInd < *endJunctions; junctInd++)
-                {
-                    uint8_t histIdx = _peepPathFindMaxJunctions - junctInd;
-                    junctionList[junctInd].x = _peepPathFindHistory[histIdx].location.x;
-                    junctionList[junctInd].y = _peepPathFindHistory[histIdx].location.y;
-                    junctionList[junctInd].z = _peepPathFindHistory[histIdx].location.z;
-                    directionList[junctInd] = _peepPathFindHistory[histIdx].direction;
-                }
-            }
+            peep_pathfind_update_result(
+                loc, counter, new_score, endScore, endJunctions, junctionList, directionList, endXYZ, endSteps);
 #if defined(DEBUG_LEVEL_2) && DEBUG_LEVEL_2
             if (gPathFindDebug)
             {
@@ -1069,25 +1318,35 @@ static void peep_pathfind_heuristic_search(
                  * _peepPathFindHistory - loops in the current search path. */
                 bool pathLoop = false;
                 /* Check the peep->PathfindHistory to see if this junction has
-                 * already been visited by the peep while heading for this goal. */
-                for (auto& pathfindHistory : peep->PathfindHistory)
+                 * already been visited by the peep while heading for this goal.
+                 * When the result is going to be cached the search is done as if the
+                 * peep history was empty, instead the junction is recorded so the
+                 * cached result is only reused by peeps that do not remember it. */
+                if (_peepPathFindRecordJunctions)
+                {
+                    _peepPathFindRecordedJunctions.push_back(loc);
+                }
+                else
                 {
-                    if (pathfindHistory.x == loc.x && pathfindHistory.y == loc.y && pathfindHistory.z == loc.z)
+                    for (auto& pathfindHistory : peep->PathfindHistory)
                     {
-                        if (pathfindHistory.direction == 0)
-                        {
-                            /* If all directions have already been tried while
-                             * heading to this goal, this is a loop. */
-                            pathLoop = true;
-                        }
-                        else
+                        if (pathfindHistory.x == loc.x && pathfindHistory.y == loc.y && pathfindHistory.z == loc.z)
                         {
-                            /* The peep remembers walking through this junction
-                             * before, but has not yet tried all directions.
-                             * Limit the edges to search to those not yet tried. */
-                            edges &= pathfindHistory.direction;
+                            if (pathfindHistory.direction == 0)
+                            {
+                                /* If all directions have already been tried while
+                                 * heading to this goal, this is a loop. */
+                                pathLoop = true;
+                            }
+                            else
+                            {
+                                /* The peep remembers walking through this junction
+                                 * before, but has not yet tried all directions.
+                                 * Limit the edges to search to those not yet tried. */
+                                edges &= pathfindHistory.direction;
+                            }
+                            break;
                         }
-                        break;
                     }
                 }
 
@@ -1248,6 +1507,95 @@ static void peep_pathfind_heuristic_search(
     }
 }
 
+void peep_pathfind_invalidate_cache()
+{
+    _peepPathFindCache.clear();
+    _peepPathFindCorridors.clear();
+}
+
+/**
+ * Runs the heuristic search from the tile loc (the start of the search) in the direction testEdge, limited to
+ * tilesChecked tiles.
+ */
+static void peep_pathfind_search_edge(
+    const TileCoordsXYZ& loc, Peep* peep, TileElement* firstTileElement, bool inPatrolArea, Direction testEdge,
+    int32_t tilesChecked, uint16_t* endScore, uint8_t* endJunctions, TileCoordsXYZ junctionList[16],
+    uint8_t directionList[16], TileCoordsXYZ* endXYZ, uint8_t* endSteps)
+{
+    uint8_t height = loc.z;
+    if (firstTileElement->AsPath()->IsSloped() && firstTileElement->AsPath()->GetSlopeDirection() == testEdge)
+    {
+        height += 0x2;
+    }
+
+    _peepPathFindFewestNumSteps = 255;
+    _peepPathFindTilesChecked = tilesChecked;
+    _peepPathFindNumJunctions = _peepPathFindMaxJunctions;
+
+    // Initialise _peepPathFindHistory.
+    std::memset(static_cast<void*>(_peepPathFindHistory), 0xFF, sizeof(_peepPathFindHistory));
+
+    /* The pathfinding will only use elements
+     * 1.._peepPathFindMaxJunctions, so the starting point
+     * is placed in element 0 */
+    _peepPathFindHistory[0].location.x = static_cast<uint8_t>(loc.x);
+    _peepPathFindHistory[0].location.y = static_cast<uint8_t>(loc.y);
+    _peepPathFindHistory[0].location.z = loc.z;
+    _peepPathFindHistory[0].direction = 0xF;
+
+    *endScore = 0xFFFF;
+    *endXYZ = { 0, 0, 0 };
+    *endSteps = 255;
+    *endJunctions = 0;
+
+    peep_pathfind_heuristic_search(
+        { loc.x, loc.y, height }, peep, firstTileElement, inPatrolArea, 0, endScore, testEdge, endJunctions, junctionList,
+        directionList, endXYZ, endSteps);
+    _peepPathFindTilesExpanded.fetch_add(tilesChecked - _peepPathFindTilesChecked, std::memory_order_relaxed);
+}
+
+/**
+ * Runs the heuristic search for a guest as if it had no pathfinding history. The thin junctions at which the
+ * history would have been consulted are recorded in the returned cache entry.
+ */
+static PathfindCacheEntry peep_pathfind_search_edge_for_cache(
+    const TileCoordsXYZ& loc, Peep* peep, TileElement* firstTileElement, Direction testEdge, int32_t tilesChecked)
+{
+    uint16_t score;
+    uint8_t steps;
+    uint8_t endJunctions;
+    TileCoordsXYZ endXYZ;
+    TileCoordsXYZ endJunctionList[16];
+    uint8_t endDirectionList[16];
+
+    _peepPathFindRecordedJunctions.clear();
+    _peepPathFindRecordJunctions = true;
+    peep_pathfind_search_edge(
+        loc, peep, firstTileElement, false, testEdge, tilesChecked, &score, &endJunctions, endJunctionList, endDirectionList,
+        &endXYZ, &steps);
+    _peepPathFindRecordJunctions = false;
+
+    auto& junctions = _peepPathFindRecordedJunctions;
+    std::sort(junctions.begin(), junctions.end(), [](const TileCoordsXYZ& a, const TileCoordsXYZ& b) {
+        return std::tie(a.x, a.y, a.z) < std::tie(b.x, b.y, b.z);
+    });
+    junctions.erase(std::unique(junctions.begin(), junctions.end()), junctions.end());
+    return PathfindCacheEntry{ score, steps, junctions };
+}
+
+/**
+ * Whether the cached search result is what the search would return for the peep, i.e. the peep does not remember any
+ * of the junctions at which the search would have consulted the peep's pathfinding history.
+ */
+static bool peep_pathfind_cache_entry_is_valid_for(const PathfindCacheEntry& entry, const Peep* peep)
+{
+    return std::none_of(std::begin(peep->PathfindHistory), std::end(peep->PathfindHistory), [&entry](const auto& history) {
+        return std::any_of(entry.Junctions.begin(), entry.Junctions.end(), [&history](const TileCoordsXYZ& junction) {
+            return history.x == junction.x && history.y == junction.y && history.z == junction.z;
+        });
+    });
+}
+
 /**
  * Returns:
  *   -1   - no direction chosen
@@ -1255,7 +1603,7 @@ static void peep_pathfind_heuristic_search(
  *
  *  rct2: 0x0069A5F0
  */
-Direction peep_pathfind_choose_direction(const TileCoordsXYZ& loc, Peep* peep)
+static Direction peep_pathfind_search_direction(const TileCoordsXYZ& loc, Peep* peep)
 {
     // The max number of thin junctions searched - a per-search-path limit.
     _peepPathFindMaxJunctions = peep_pathfind_get_max_number_junctions(peep);
@@ -1444,41 +1792,25 @@ Direction peep_pathfind_choose_direction(const TileCoordsXYZ& loc, Peep* peep)
          * or for different edges with equal value, the edge with the
          * least steps (best_sub). */
         int32_t numEdges = bitcount(edges);
+
+        // Staff searches depend on their patrol area and are not frequent enough to be worth caching.
+        bool useCache = peep->AssignedPeepType == PeepType::Guest;
+#if defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
+        useCache = useCache && !gPathFindDebug;
+#endif // defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
         for (int32_t test_edge = chosen_edge; test_edge != -1; test_edge = bitscanforward(edges))
         {
             edges &= ~(1 << test_edge);
-            uint8_t height = loc.z;
-
-            if (first_tile_element->AsPath()->IsSloped() && first_tile_element->AsPath()->GetSlopeDirection() == test_edge)
-            {
-                height += 0x2;
-            }
 
-            _peepPathFindFewestNumSteps = 255;
             /* Divide the maxTilesChecked global search limit
              * between the remaining edges to ensure the search
              * covers all of the remaining edges. */
-            _peepPathFindTilesChecked = maxTilesChecked / numEdges;
-            _peepPathFindNumJunctions = _peepPathFindMaxJunctions;
-
-            // Initialise _peepPathFindHistory.
-            std::memset(static_cast<void*>(_peepPathFindHistory), 0xFF, sizeof(_peepPathFindHistory));
-
-            /* The pathfinding will only use elements
-             * 1.._peepPathFindMaxJunctions, so the starting point
-             * is placed in element 0 */
-            _peepPathFindHistory[0].location.x = static_cast<uint8_t>(loc.x);
-            _peepPathFindHistory[0].location.y = static_cast<uint8_t>(loc.y);
-            _peepPathFindHistory[0].location.z = loc.z;
-            _peepPathFindHistory[0].direction = 0xF;
+            int32_t tilesChecked = maxTilesChecked / numEdges;
 
             uint16_t score = 0xFFFF;
             /* Variable endXYZ contains the end location of the
              * search path. */
             TileCoordsXYZ endXYZ;
-            endXYZ.x = 0;
-            endXYZ.y = 0;
-            endXYZ.z = 0;
 
             uint8_t endSteps = 255;
 
@@ -1510,9 +1842,41 @@ Direction peep_pathfind_choose_direction(const TileCoordsXYZ& loc, Peep* peep)
             }
 #endif // defined(DEBUG_LEVEL_2) && DEBUG_LEVEL_2
 
-            peep_pathfind_heuristic_search(
-                { loc.x, loc.y, height }, peep, first_tile_element, inPatrolArea, 0, &score, test_edge, &endJunctions,
-                endJunctionList, endDirectionList, &endXYZ, &endSteps);
+            bool useCachedResult = false;
+            if (useCache)
+            {
+                PathfindCacheKey key{ loc,
+                                      goal,
+                                      tilesChecked,
+                                      gPeepPathFindQueueRideIndex,
+                                      static_cast<Direction>(test_edge),
+                                      _peepPathFindMaxJunctions,
+                                      gPeepPathFindIgnoreForeignQueues };
+                auto it = _peepPathFindCache.find(key);
+                if (it == _peepPathFindCache.end())
+                {
+                    if (_peepPathFindCache.size() >= PATHFIND_CACHE_MAX_ENTRIES)
+                        _peepPathFindCache.clear();
+
+                    auto entry = peep_pathfind_search_edge_for_cache(loc, peep, first_tile_element, test_edge, tilesChecked);
+                    it = _peepPathFindCache.emplace(key, std::move(entry)).first;
+                }
+
+                const auto& entry = it->second;
+                if (peep_pathfind_cache_entry_is_valid_for(entry, peep))
+                {
+                    score = entry.Score;
+                    endSteps = entry.Steps;
+                    useCachedResult = true;
+                }
+            }
+
+            if (!useCachedResult)
+            {
+                peep_pathfind_search_edge(
+                    loc, peep, first_tile_element, inPatrolArea, test_edge, tilesChecked, &score, &endJunctions,
+                    endJunctionList, endDirectionList, &endXYZ, &endSteps);
+            }
 
 #if defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
             if (gPathFindDebug)
@@ -1629,6 +1993,56 @@ Direction peep_pathfind_choose_direction(const TileCoordsXYZ& loc, Peep* peep)
     return chosen_edge;
 }
 
+Direction peep_pathfind_choose_direction(const TileCoordsXYZ& loc, Peep* peep)
+{
+    TRACE_ZONE("Pathfind");
+    if (OpenRCT2::gLogicCounters == nullptr)
+    {
+        return peep_pathfind_search_direction(loc, peep);
+    }
+
+    auto startTime = std::chrono::high_resolution_clock::now();
+    auto direction = peep_pathfind_search_direction(loc, peep);
+    OpenRCT2::gLogicCounters->PathfindCalls++;
+    OpenRCT2::gLogicCounters->PathfindTime += std::chrono::high_resolution_clock::now() - startTime;
+    return direction;
+}
+
+/**
+ * Whether the heuristic search of a guest at a junction is put off because the pathfinding budget of this tick has been
+ * used up, in which case the guest keeps walking in its current direction and searches again at the next junction.
+ */
+static bool guest_path_finding_is_deferred(const Peep* peep, uint8_t edges)
+{
+    const int32_t budget = gGuestPathfindingBudget;
+    if (budget == 0)
+        return false;
+
+    // A guest that cannot carry on has to search anyway
+    if (_guestPathFindSearchesThisTick >= budget && (edges & (1 << peep->PeepDirection)))
+    {
+        _guestPathFindDeferredCount++;
+        return true;
+    }
+    _guestPathFindSearchesThisTick++;
+    return false;
+}
+
+void guest_path_finding_reset_budget()
+{
+    _guestPathFindSearchesThisTick = 0;
+}
+
+uint32_t guest_path_finding_get_deferred_count()
+{
+    return _guestPathFindDeferredCount;
+}
+
+uint64_t peep_pathfind_get_tiles_expanded_count()
+{
+    return _peepPathFindTilesExpanded.load(std::memory_order_relaxed);
+}
+
 /**
  * Gets the nearest park entrance relative to point, by using Manhattan distance.
  * @param x x coordinate of location
@@ -1666,6 +2080,9 @@ static int32_t guest_path_find_entering_park(Peep* peep, uint8_t edges)
     if (chosenEntrance == 0xFF)
         return guest_path_find_aimless(peep, edges);
 
+    if (guest_path_finding_is_deferred(peep, edges))
+        return peep_move_one_tile(peep->PeepDirection, peep);
+
     gPeepPathFindGoalPosition = TileCoordsXYZ(gParkEntrances[chosenEntrance]);
     gPeepPathFindIgnoreForeignQueues = true;
     gPeepPathFindQueueRideIndex = RIDE_ID_NULL;
@@ -1724,6 +2141,9 @@ static int32_t guest_path_find_leaving_park(Peep* peep, uint8_t edges)
         return peep_move_one_tile(direction, peep);
     }
 
+    if (guest_path_finding_is_deferred(peep, edges))
+        return peep_move_one_tile(peep->PeepDirection, peep);
+
     gPeepPathFindIgnoreForeignQueues = true;
     gPeepPathFindQueueRideIndex = RIDE_ID_NULL;
     direction = peep_pathfind_choose_direction(TileCoordsXYZ{ peep->NextLoc }, peep);
@@ -1769,6 +2189,9 @@ static int32_t guest_path_find_park_entrance(Peep* peep, uint8_t edges)
         peep->PeepFlags |= PEEP_FLAGS_PARK_ENTRANCE_CHOSEN;
     }
 
+    if (guest_path_finding_is_deferred(peep, edges))
+        return peep_move_one_tile(peep->PeepDirection, peep);
+
     const auto& entrance = gParkEntrances[peep->ChosenParkEntrance];
 
     gPeepPathFindGoalPosition = TileCoordsXYZ(entrance);
@@ -1972,6 +2395,237 @@ static StationIndex guest_pathfinding_select_random_station(
 
     return 0;
 }
+
+/**
+ * Returns the entrance station of the ride closest to the given location, along with the number of entrance stations
+ * and which stations are entrance stations.
+ */
+static StationIndex guest_pathfinding_get_closest_entrance_station(
+    const Ride* ride, const TileCoordsXYZ& loc, int32_t& numEntranceStations, std::bitset<MAX_STATIONS>& entranceStations)
+{
+    auto bestScore = std::numeric_limits<int32_t>::max();
+    StationIndex closestStationNum = 0;
+
+    for (StationIndex stationNum = 0; stationNum < MAX_STATIONS; ++stationNum)
+    {
+        // Skip if stationNum has no entrance (so presumably an exit only station)
+        if (ride_get_entrance_location(ride, stationNum).isNull())
+            continue;
+
+        numEntranceStations++;
+        entranceStations[stationNum] = true;
+
+        TileCoordsXYZD entranceLocation = ride_get_entrance_location(ride, stationNum);
+        auto score = CalculateHeuristicPathingScore(entranceLocation, loc);
+        if (score < bestScore)
+        {
+            bestScore = score;
+            closestStationNum = stationNum;
+            continue;
+        }
+    }
+
+    // Ride has no stations with an entrance, so head to station 0.
+    if (numEntranceStations == 0)
+        closestStationNum = 0;
+
+    return closestStationNum;
+}
+
+/**
+ * Returns the pathfinding goal for a guest heading to the given station of the ride, i.e. the end of its queue.
+ */
+static TileCoordsXYZ guest_pathfinding_get_station_goal(
+    const Ride* ride, StationIndex stationNum, int32_t numEntranceStations)
+{
+    TileCoordsXYZ loc;
+    if (numEntranceStations == 0)
+    {
+        // stationNum is always 0 here.
+        auto entranceXY = TileCoordsXY(ride->stations[stationNum].Start);
+        loc.x = entranceXY.x;
+        loc.y = entranceXY.y;
+        loc.z = ride->stations[stationNum].Height;
+    }
+    else
+    {
+        TileCoordsXYZD entranceXYZD = ride_get_entrance_location(ride, stationNum);
+        loc.x = entranceXYZD.x;
+        loc.y = entranceXYZD.y;
+        loc.z = entranceXYZD.z;
+    }
+
+    get_ride_queue_end(loc);
+    return loc;
+}
+
+/**
+ * A guest heading for a ride or the park exit that is expected to reach a junction soon, see
+ * guest_path_finding_prefetch().
+ */
+struct PathfindPrefetchRequest
+{
+    Guest* Peep;
+    std::vector<std::pair<PathfindCacheKey, PathfindCacheEntry>> Results;
+};
+
+static std::vector<PathfindPrefetchRequest> _peepPathFindPrefetchRequests;
+static std::unique_ptr<JobPool> _peepPathFindJobs;
+
+/**
+ * Whether the guest is walking to a tile on which it is likely to pathfind to a ride or the park exit within the next
+ * few ticks.
+ */
+static bool guest_path_finding_should_prefetch(const Guest* guest)
+{
+    if (guest->State != PeepState::Walking || guest->OutsideOfPark || guest->GetNextIsSurface())
+        return false;
+    if (guest->PeepFlags & PEEP_FLAGS_LEAVING_PARK)
+    {
+        // The exit is only chosen when the guest first pathfinds to it, see guest_path_find_park_entrance().
+        if (!(guest->PeepFlags & PEEP_FLAGS_PARK_ENTRANCE_CHOSEN) || guest->ChosenParkEntrance >= gParkEntrances.size())
+            return false;
+    }
+    else if (guest->GuestHeadingToRideId == RIDE_ID_NULL)
+        return false;
+
+    auto distance = CoordsXY{ guest->x, guest->y } - guest->GetDestination();
+    return std::abs(distance.x) + std::abs(distance.y) <= guest->DestinationTolerance + 8;
+}
+
+/**
+ * Runs the heuristic searches (as if the guest had no pathfinding history) that guest_path_finding() is expected to
+ * need when the guest arrives at its destination, unless they are cached already. Only reads the game state.
+ */
+static void guest_path_finding_prefetch_searches(PathfindPrefetchRequest& request)
+{
+    TRACE_ZONE("Pathfind prefetch");
+    auto* guest = request.Peep;
+    const bool leavingPark = (guest->PeepFlags & PEEP_FLAGS_LEAVING_PARK) != 0;
+    auto* ride = leavingPark ? nullptr : get_ride(guest->GuestHeadingToRideId);
+    if (!leavingPark && (ride == nullptr || ride->status != RIDE_STATUS_OPEN))
+        return;
+
+    // The guest pathfinds on the tile of its destination, at the height of the path it walks onto.
+    auto destination = TileCoordsXY(guest->GetDestination());
+    auto nextLoc = TileCoordsXYZ(guest->NextLoc);
+    TileElement* tileElement = map_get_first_element_at(destination.ToCoordsXY());
+    if (tileElement == nullptr)
+        return;
+
+    TileCoordsXYZ loc;
+    TileElement* firstTileElement = nullptr;
+    do
+    {
+        if (tileElement->GetType() != TILE_ELEMENT_TYPE_PATH || std::abs(tileElement->base_height - nextLoc.z) > 2)
+            continue;
+        if (firstTileElement != nullptr && tileElement->base_height != firstTileElement->base_height)
+            return; // Ambiguous
+        if (firstTileElement == nullptr)
+            firstTileElement = tileElement;
+    } while (!(tileElement++)->IsLastForTile());
+    if (firstTileElement == nullptr)
+        return;
+    loc = { destination.x, destination.y, firstTileElement->base_height };
+
+    // Collect the permitted edges of all matching path elements, see peep_pathfind_choose_direction().
+    _peepPathFindIsStaff = false;
+    uint8_t edges = 0;
+    for (auto* element = map_get_first_element_at(destination.ToCoordsXY()); element != nullptr; element++)
+    {
+        if (element->base_height == loc.z && element->GetType() == TILE_ELEMENT_TYPE_PATH)
+            edges |= path_get_permitted_edges(element->AsPath());
+        if (element->IsLastForTile())
+            break;
+    }
+    edges &= 0xF;
+
+    // Guests only search at junctions, not where they can only carry on or turn back.
+    int32_t numEdges = bitcount(edges);
+    if (numEdges < 3)
+        return;
+
+    if (leavingPark)
+    {
+        gPeepPathFindGoalPosition = TileCoordsXYZ(gParkEntrances[guest->ChosenParkEntrance]);
+        gPeepPathFindQueueRideIndex = RIDE_ID_NULL;
+    }
+    else
+    {
+        int32_t numEntranceStations = 0;
+        std::bitset<MAX_STATIONS> entranceStations = {};
+        StationIndex stationNum = guest_pathfinding_get_closest_entrance_station(
+            ride, loc, numEntranceStations, entranceStations);
+        if (numEntranceStations > 1 && (ride->depart_flags & RIDE_DEPART_SYNCHRONISE_WITH_ADJACENT_STATIONS))
+        {
+            stationNum = guest_pathfinding_select_random_station(guest, numEntranceStations, entranceStations);
+        }
+
+        gPeepPathFindGoalPosition = guest_pathfinding_get_station_goal(ride, stationNum, numEntranceStations);
+        gPeepPathFindQueueRideIndex = guest->GuestHeadingToRideId;
+    }
+    gPeepPathFindIgnoreForeignQueues = true;
+    _peepPathFindMaxJunctions = peep_pathfind_get_junction_limit(guest);
+
+    for (Direction testEdge : ALL_DIRECTIONS)
+    {
+        if (!(edges & (1 << testEdge)))
+            continue;
+
+        int32_t tilesChecked = 15000 / numEdges;
+        PathfindCacheKey key{ loc,        gPeepPathFindGoalPosition, tilesChecked, gPeepPathFindQueueRideIndex,
+                              testEdge,   _peepPathFindMaxJunctions, gPeepPathFindIgnoreForeignQueues };
+        if (_peepPathFindCache.find(key) != _peepPathFindCache.end())
+            continue;
+
+        request.Results.emplace_back(
+            key, peep_pathfind_search_edge_for_cache(loc, guest, firstTileElement, testEdge, tilesChecked));
+    }
+}
+
+void guest_path_finding_prefetch()
+{
+    if (!gConfigGeneral.multithreading)
+        return;
+#if defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
+    if (gPathFindDebug)
+        return;
+#endif // defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
+
+    _peepPathFindPrefetchRequests.clear();
+    for (auto* guest : EntityList<Guest>())
+    {
+        if (guest_path_finding_should_prefetch(guest))
+        {
+            _peepPathFindPrefetchRequests.push_back({ guest, {} });
+        }
+    }
+    if (_peepPathFindPrefetchRequests.empty())
+        return;
+
+    if (_peepPathFindJobs == nullptr)
+    {
+        _peepPathFindJobs = std::make_unique<JobPool>();
+    }
+
+    // The game state is not modified until all searches have finished, the caches are only read meanwhile.
+    _peepPathFindCorridorsReadOnly = true;
+    _peepPathFindJobs->ParallelFor(0, _peepPathFindPrefetchRequests.size(), 4, [](size_t index) {
+        guest_path_finding_prefetch_searches(_peepPathFindPrefetchRequests[index]);
+    });
+    _peepPathFindCorridorsReadOnly = false;
+
+    for (auto& request : _peepPathFindPrefetchRequests)
+    {
+        for (auto& result : request.Results)
+        {
+            if (_peepPathFindCache.size() >= PATHFIND_CACHE_MAX_ENTRIES)
+                return;
+            _peepPathFindCache.emplace(result.first, std::move(result.second));
+        }
+    }
+}
+
 /**
  *
  *  rct2: 0x00694C35
@@ -2176,62 +2830,34 @@ int32_t guest_path_finding(Guest* peep)
     }
 
     // The ride is open.
+    if (guest_path_finding_is_deferred(peep, edges))
+    {
+#if defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
+        if (gPathFindDebug)
+        {
+            log_info("Completed guest_path_finding for %s - search deferred.", gPathFindDebugPeepName);
+        }
+        PathfindLoggingDisable();
+#endif // defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
+        return peep_move_one_tile(peep->PeepDirection, peep);
+    }
+
     gPeepPathFindQueueRideIndex = rideIndex;
 
     /* Find the ride's closest entrance station to the peep.
      * At the same time, count how many entrance stations there are and
      * which stations are entrance stations. */
-    auto bestScore = std::numeric_limits<int32_t>::max();
-    StationIndex closestStationNum = 0;
-
     int32_t numEntranceStations = 0;
     std::bitset<MAX_STATIONS> entranceStations = {};
-
-    for (StationIndex stationNum = 0; stationNum < MAX_STATIONS; ++stationNum)
-    {
-        // Skip if stationNum has no entrance (so presumably an exit only station)
-        if (ride_get_entrance_location(ride, stationNum).isNull())
-            continue;
-
-        numEntranceStations++;
-        entranceStations[stationNum] = true;
-
-        TileCoordsXYZD entranceLocation = ride_get_entrance_location(ride, stationNum);
-        auto score = CalculateHeuristicPathingScore(entranceLocation, TileCoordsXYZ{ peep->NextLoc });
-        if (score < bestScore)
-        {
-            bestScore = score;
-            closestStationNum = stationNum;
-            continue;
-        }
-    }
-
-    // Ride has no stations with an entrance, so head to station 0.
-    if (numEntranceStations == 0)
-        closestStationNum = 0;
+    StationIndex closestStationNum = guest_pathfinding_get_closest_entrance_station(
+        ride, loc, numEntranceStations, entranceStations);
 
     if (numEntranceStations > 1 && (ride->depart_flags & RIDE_DEPART_SYNCHRONISE_WITH_ADJACENT_STATIONS))
     {
         closestStationNum = guest_pathfinding_select_random_station(peep, numEntranceStations, entranceStations);
     }
 
-    if (numEntranceStations == 0)
-    {
-        // closestStationNum is always 0 here.
-        auto entranceXY = TileCoordsXY(ride->stations[closestStationNum].Start);
-        loc.x = entranceXY.x;
-        loc.y = entranceXY.y;
-        loc.z = ride->stations[closestStationNum].Height;
-    }
-    else
-    {
-        TileCoordsXYZD entranceXYZD = ride_get_entrance_location(ride, closestStationNum);
-        loc.x = entranceXYZD.x;
-        loc.y = entranceXYZD.y;
-        loc.z = entranceXYZD.z;
-    }
-
-    get_ride_queue_end(loc);
+    loc = guest_pathfinding_get_station_goal(ride, closestStationNum, numEntranceStations);
 
     gPeepPathFindGoalPosition = loc;
     gPeepPathFindIgnoreForeignQueues = true;
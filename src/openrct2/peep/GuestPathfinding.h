@@ -22,12 +22,12 @@ struct TileElement;
 //
 // This gets copied into Peep::PathfindGoal. The two separate variables are needed because
 // when the goal changes the peep's pathfind history needs to be reset.
-extern TileCoordsXYZ gPeepPathFindGoalPosition;
+extern thread_local TileCoordsXYZ gPeepPathFindGoalPosition;
 
 // When the heuristic pathfinder is examining neighboring tiles, one possibility is that it finds a
 // queue tile; furthermore, this queue tile may or may not be for the ride that the peep is trying
 // to get to, if any. This first var is used to store the ride that the peep is currently headed to.
-extern ride_id_t gPeepPathFindQueueRideIndex;
+extern thread_local ride_id_t gPeepPathFindQueueRideIndex;
 
 // Furthermore, staff members don't care about this stuff; even if they are e.g. a mechanic headed
 // to a particular ride, they have no issues with walking over queues for other rides to get there.
@@ -35,16 +35,36 @@ extern ride_id_t gPeepPathFindQueueRideIndex;
 // than their target ride, and if false, they will treat it like a regular path.
 //
 // In practice, if this is false, gPeepPathFindQueueRideIndex is always RIDE_ID_NULL.
-extern bool gPeepPathFindIgnoreForeignQueues;
+extern thread_local bool gPeepPathFindIgnoreForeignQueues;
 
 // Given a peep 'peep' at tile 'loc', who is trying to get to 'gPeepPathFindGoalPosition', decide
 // the direction the peep should walk in from the current tile.
 Direction peep_pathfind_choose_direction(const TileCoordsXYZ& loc, Peep* peep);
 
+// Discards the cached results of guest pathfinding searches. Must be called whenever the footpaths, ride entrances,
+// shops or path banners on the map change.
+void peep_pathfind_invalidate_cache();
+
 // Test whether the given tile can be walked onto, if the peep is currently at height currentZ and
 // moving in direction currentDirection.
 bool IsValidPathZAndDirection(TileElement* tileElement, int32_t currentZ, int32_t currentDirection);
 
+// Runs the heuristic searches that guests heading for a ride or the park exit are about to need on the job pool, so that
+// guest_path_finding() finds their results in the cache. Only reads the game state, the guests are still updated
+// serially in entity order, so the outcome is identical with or without prefetching.
+void guest_path_finding_prefetch();
+
+// The number of heuristic searches guests may start per tick, 0 for no limit. Part of the park, so it is saved and sent
+// to clients with the map, and changed through ScenarioSetSettingAction.
+extern uint16_t gGuestPathfindingBudget;
+
+// Starts a new tick for the pathfinding budget.
+void guest_path_finding_reset_budget();
+// The number of guest searches that have been put off because the pathfinding budget was used up.
+uint32_t guest_path_finding_get_deferred_count();
+// The number of tiles the heuristic searches have visited since the game started, used to benchmark the pathfinding.
+uint64_t peep_pathfind_get_tiles_expanded_count();
+
 // Overall guest pathfinding AI. Sets up Peep::DestinationX/DestinationY (which they move to in a
 // straight line, no pathfinding). Called whenever the guest has arrived at their previously set destination.
 //
@@ -0,0 +1,92 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "GuestStatistics.h"
+
+#include "../Game.h"
+#include "../core/Trace.h"
+#include "../ride/Ride.h"
+#include "../ride/RideData.h"
+#include "../world/EntityList.h"
+
+// Thoughts older than this are not counted, the same age the guest warnings and awards have always used
+static constexpr uint8_t FRESH_THOUGHT_MAX_FRESHNESS = 5;
+
+static GuestStatistics _guestStatistics;
+static uint32_t _guestStatisticsTick;
+static bool _guestStatisticsValid;
+
+static bool IsHeadingForRideWithoutFlag(const Guest* guest, uint64_t rideTypeFlag)
+{
+    if (guest->GuestHeadingToRideId == RIDE_ID_NULL)
+        return true;
+
+    auto ride = get_ride(guest->GuestHeadingToRideId);
+    return ride != nullptr && !ride->GetRideTypeDescriptor().HasFlag(rideTypeFlag);
+}
+
+static void GatherGuestStatistics(GuestStatistics& stats)
+{
+    TRACE_ZONE("Guest statistics");
+    stats = {};
+    for (auto guest : EntityList<Guest>())
+    {
+        if (guest->OutsideOfPark)
+            continue;
+
+        stats.InPark++;
+        if (guest->Happiness > 128)
+        {
+            stats.Happy++;
+        }
+        if ((guest->PeepFlags & PEEP_FLAGS_LEAVING_PARK) && (guest->GuestIsLostCountdown < 90))
+        {
+            stats.LostWhileLeaving++;
+        }
+
+        const auto& thought = guest->Thoughts[0];
+        if (thought.freshness > FRESH_THOUGHT_MAX_FRESHNESS)
+            continue;
+
+        stats.FreshThoughts[EnumValue(thought.type)]++;
+        switch (thought.type)
+        {
+            case PeepThoughtType::Hungry:
+                if (IsHeadingForRideWithoutFlag(guest, RIDE_TYPE_FLAG_FLAT_RIDE))
+                    stats.HungryNotHeadingForFood++;
+                break;
+            case PeepThoughtType::Thirsty:
+                if (IsHeadingForRideWithoutFlag(guest, RIDE_TYPE_FLAG_SELLS_DRINKS))
+                    stats.ThirstyNotHeadingForDrink++;
+                break;
+            case PeepThoughtType::Toilet:
+                if (IsHeadingForRideWithoutFlag(guest, RIDE_TYPE_FLAG_IS_TOILET))
+                    stats.NeedToiletNotHeadingForToilet++;
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+const GuestStatistics& GetGuestStatistics()
+{
+    if (!_guestStatisticsValid || _guestStatisticsTick != gCurrentTicks)
+    {
+        GatherGuestStatistics(_guestStatistics);
+        _guestStatisticsTick = gCurrentTicks;
+        _guestStatisticsValid = true;
+    }
+    return _guestStatistics;
+}
+
+void GuestStatisticsInvalidate()
+{
+    _guestStatisticsValid = false;
+}
@@ -0,0 +1,46 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../common.h"
+#include "Peep.h"
+
+#include <array>
+
+/**
+ * Counts of the guests inside the park used by the park rating, the awards and the guest warnings, gathered in a single
+ * pass over the guests that all of them share.
+ */
+struct GuestStatistics
+{
+    uint32_t InPark;
+    uint32_t Happy;
+    uint32_t LostWhileLeaving;
+
+    // Guests by the type of their latest thought, only counted while the thought is fresh
+    std::array<uint32_t, 256> FreshThoughts;
+    // Guests with fresh needs that are not already heading for a ride that meets them
+    uint32_t HungryNotHeadingForFood;
+    uint32_t ThirstyNotHeadingForDrink;
+    uint32_t NeedToiletNotHeadingForToilet;
+
+    uint32_t GetFreshThoughts(PeepThoughtType type) const
+    {
+        return FreshThoughts[EnumValue(type)];
+    }
+};
+
+/**
+ * Returns the statistics of the current tick, gathered on first use. They are gathered again after the guests have
+ * been updated.
+ */
+const GuestStatistics& GetGuestStatistics();
+
+void GuestStatisticsInvalidate();
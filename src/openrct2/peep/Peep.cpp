@@ -12,6 +12,7 @@
 #include "../Cheats.h"
 #include "../Context.h"
 #include "../Game.h"
+#include "../GameState.h"
 #include "../Input.h"
 #include "../OpenRCT2.h"
 #include "../actions/GameAction.h"
@@ -19,6 +20,7 @@
 #include "../audio/audio.h"
 #include "../config/Config.h"
 #include "../core/Guard.hpp"
+#include "../core/Trace.h"
 #include "../interface/Window.h"
 #include "../localisation/Localisation.h"
 #include "../management/Finance.h"
@@ -45,11 +47,14 @@
 #include "../world/Sprite.h"
 #include "../world/Surface.h"
 #include "GuestPathfinding.h"
+#include "GuestStatistics.h"
 #include "Staff.h"
 
 #include <algorithm>
+#include <chrono>
 #include <iterator>
 #include <limits>
+#include <vector>
 
 uint8_t gGuestChangeModifier;
 uint32_t gNumGuestsInPark;
@@ -70,6 +75,23 @@ static TileElement* _peepRideEntranceExitElement;
 
 static void* _crowdSoundChannel = nullptr;
 
+// Set while peep_remove_all_guests runs, the removal of each guest then skips refreshing the windows and the screen
+static bool _peepRemovingAllGuests = false;
+
+// The formatted name of each peep by sprite index, the fields a default name is made of are kept to tell when it is
+// stale. Custom names only change through Peep::SetName, which drops the entry.
+struct PeepNameCacheEntry
+{
+    bool Valid{};
+    bool RealNames{};
+    PeepType Type{};
+    StaffType AssignedStaffType{};
+    uint32_t Id{};
+    const char* CustomName{};
+    std::string Name;
+};
+static std::vector<PeepNameCacheEntry> _peepNameCache;
+
 static void peep_128_tick_update(Peep* peep, int32_t index);
 static void peep_release_balloon(Guest* peep, int16_t spawn_height);
 // clang-format off
@@ -393,9 +415,14 @@ int32_t peep_get_staff_count()
  */
 void peep_update_all()
 {
+    TRACE_ZONE("Peep update");
     if (gScreenFlags & SCREEN_FLAGS_EDITOR)
         return;
 
+    guest_path_finding_reset_budget();
+    guest_path_finding_prefetch();
+
+    auto startTime = std::chrono::high_resolution_clock::now();
     int32_t i = 0;
     // Warning this loop can delete peeps
     for (auto peep : EntityList<Guest>())
@@ -417,6 +444,11 @@ void peep_update_all()
         i++;
     }
 
+    // The statistics gathered earlier in the tick no longer match the guests
+    GuestStatisticsInvalidate();
+
+    auto staffStartTime = std::chrono::high_resolution_clock::now();
+    const int32_t numGuests = i;
     for (auto staff : EntityList<Staff>())
     {
         if (static_cast<uint32_t>(i & 0x7F) != (gCurrentTicks & 0x7F))
@@ -435,6 +467,14 @@ void peep_update_all()
 
         i++;
     }
+
+    if (auto* counters = OpenRCT2::gLogicCounters; counters != nullptr)
+    {
+        counters->GuestsUpdated += numGuests;
+        counters->StaffUpdated += i - numGuests;
+        counters->GuestTime += staffStartTime - startTime;
+        counters->StaffTime += std::chrono::high_resolution_clock::now() - staffStartTime;
+    }
 }
 
 /**
@@ -832,7 +872,10 @@ void peep_sprite_remove(Peep* peep)
     {
         guest->RemoveFromRide();
     }
-    peep->Invalidate();
+    if (!_peepRemovingAllGuests)
+    {
+        peep->Invalidate();
+    }
 
     window_close_by_number(WC_PEEP, peep->sprite_index);
 
@@ -855,8 +898,27 @@ void peep_sprite_remove(Peep* peep)
     }
     sprite_remove(peep);
 
-    auto intent = Intent(wasGuest ? INTENT_ACTION_REFRESH_GUEST_LIST : INTENT_ACTION_REFRESH_STAFF_LIST);
-    context_broadcast_intent(&intent);
+    if (!_peepRemovingAllGuests)
+    {
+        auto intent = Intent(wasGuest ? INTENT_ACTION_REFRESH_GUEST_LIST : INTENT_ACTION_REFRESH_STAFF_LIST);
+        context_broadcast_intent(&intent);
+    }
+}
+
+void peep_remove_all_guests()
+{
+    _peepRemovingAllGuests = true;
+    for (auto guest : EntityList<Guest>())
+    {
+        guest->Remove();
+    }
+    _peepRemovingAllGuests = false;
+
+    auto updateGuestCountIntent = Intent(INTENT_ACTION_UPDATE_GUEST_COUNT);
+    context_broadcast_intent(&updateGuestCountIntent);
+    auto refreshGuestListIntent = Intent(INTENT_ACTION_REFRESH_GUEST_LIST);
+    context_broadcast_intent(&refreshGuestListIntent);
+    gfx_invalidate_screen();
 }
 
 /**
@@ -869,8 +931,11 @@ void Peep::Remove()
         if (!OutsideOfPark)
         {
             decrement_guests_in_park();
-            auto intent = Intent(INTENT_ACTION_UPDATE_GUEST_COUNT);
-            context_broadcast_intent(&intent);
+            if (!_peepRemovingAllGuests)
+            {
+                auto intent = Intent(INTENT_ACTION_UPDATE_GUEST_COUNT);
+                context_broadcast_intent(&intent);
+            }
         }
         if (State == PeepState::EnteringPark)
         {
@@ -1189,71 +1254,17 @@ void Peep::Update()
  */
 void peep_problem_warnings_update()
 {
-    Ride* ride;
-    uint32_t hunger_counter = 0, lost_counter = 0, noexit_counter = 0, thirst_counter = 0, litter_counter = 0,
-             disgust_counter = 0, toilet_counter = 0, vandalism_counter = 0;
+    const auto& guestStats = GetGuestStatistics();
+    uint32_t hunger_counter = guestStats.HungryNotHeadingForFood;
+    uint32_t lost_counter = guestStats.GetFreshThoughts(PeepThoughtType::Lost);
+    uint32_t noexit_counter = guestStats.GetFreshThoughts(PeepThoughtType::CantFindExit);
+    uint32_t thirst_counter = guestStats.ThirstyNotHeadingForDrink;
+    uint32_t litter_counter = guestStats.GetFreshThoughts(PeepThoughtType::BadLitter);
+    uint32_t disgust_counter = guestStats.GetFreshThoughts(PeepThoughtType::PathDisgusting);
+    uint32_t toilet_counter = guestStats.NeedToiletNotHeadingForToilet;
+    uint32_t vandalism_counter = guestStats.GetFreshThoughts(PeepThoughtType::Vandalism);
     uint8_t* warning_throttle = gPeepWarningThrottle;
 
-    for (auto peep : EntityList<Guest>())
-    {
-        if (peep->OutsideOfPark || peep->Thoughts[0].freshness > 5)
-            continue;
-
-        switch (peep->Thoughts[0].type)
-        {
-            case PeepThoughtType::Lost: // 0x10
-                lost_counter++;
-                break;
-
-            case PeepThoughtType::Hungry: // 0x14
-                if (peep->GuestHeadingToRideId == RIDE_ID_NULL)
-                {
-                    hunger_counter++;
-                    break;
-                }
-                ride = get_ride(peep->GuestHeadingToRideId);
-                if (ride != nullptr && !ride->GetRideTypeDescriptor().HasFlag(RIDE_TYPE_FLAG_FLAT_RIDE))
-                    hunger_counter++;
-                break;
-
-            case PeepThoughtType::Thirsty:
-                if (peep->GuestHeadingToRideId == RIDE_ID_NULL)
-                {
-                    thirst_counter++;
-                    break;
-                }
-                ride = get_ride(peep->GuestHeadingToRideId);
-                if (ride != nullptr && !ride->GetRideTypeDescriptor().HasFlag(RIDE_TYPE_FLAG_SELLS_DRINKS))
-                    thirst_counter++;
-                break;
-
-            case PeepThoughtType::Toilet:
-                if (peep->GuestHeadingToRideId == RIDE_ID_NULL)
-                {
-                    toilet_counter++;
-                    break;
-                }
-                ride = get_ride(peep->GuestHeadingToRideId);
-                if (ride != nullptr && !ride->GetRideTypeDescriptor().HasFlag(RIDE_TYPE_FLAG_IS_TOILET))
-                    toilet_counter++;
-                break;
-
-            case PeepThoughtType::BadLitter: // 0x1a
-                litter_counter++;
-                break;
-            case PeepThoughtType::CantFindExit: // 0x1b
-                noexit_counter++;
-                break;
-            case PeepThoughtType::PathDisgusting: // 0x1f
-                disgust_counter++;
-                break;
-            case PeepThoughtType::Vandalism: // 0x21
-                vandalism_counter++;
-                break;
-            default:
-                break;
-        }
-    }
     // could maybe be packed into a loop, would lose a lot of clarity though
     if (warning_throttle[0])
         --warning_throttle[0];
@@ -1631,6 +1642,7 @@ Peep* Peep::Generate(const CoordsXYZ& coords)
     peep->Mass = (scenario_rand() & 0x1F) + 45;
     peep->PathCheckOptimisation = 0;
     peep->InteractionRideIndex = RIDE_ID_NULL;
+    peep->GuestPreviousInQueue = SPRITE_INDEX_NULL;
     peep->AssignedPeepType = PeepType::Guest;
     peep->PreviousRide = RIDE_ID_NULL;
     peep->Thoughts->type = PeepThoughtType::None;
@@ -1987,13 +1999,46 @@ void Peep::FormatNameTo(Formatter& ft) const
 
 std::string Peep::GetName() const
 {
-    Formatter ft;
-    FormatNameTo(ft);
-    return format_string(STR_STRINGID, ft.Data());
+    if (sprite_index >= MAX_ENTITIES)
+    {
+        Formatter ft;
+        FormatNameTo(ft);
+        return format_string(STR_STRINGID, ft.Data());
+    }
+
+    if (_peepNameCache.empty())
+    {
+        _peepNameCache.resize(MAX_ENTITIES);
+    }
+    auto& entry = _peepNameCache[sprite_index];
+    const bool realNames = (gParkFlags & PARK_FLAGS_SHOW_REAL_GUEST_NAMES) != 0;
+    if (!entry.Valid || entry.RealNames != realNames || entry.Type != AssignedPeepType
+        || entry.AssignedStaffType != AssignedStaffType || entry.Id != Id || entry.CustomName != Name)
+    {
+        Formatter ft;
+        FormatNameTo(ft);
+        entry.Name = format_string(STR_STRINGID, ft.Data());
+        entry.Valid = true;
+        entry.RealNames = realNames;
+        entry.Type = AssignedPeepType;
+        entry.AssignedStaffType = AssignedStaffType;
+        entry.Id = Id;
+        entry.CustomName = Name;
+    }
+    return entry.Name;
+}
+
+void peep_name_cache_invalidate()
+{
+    _peepNameCache.clear();
 }
 
 bool Peep::SetName(std::string_view value)
 {
+    if (sprite_index < _peepNameCache.size())
+    {
+        _peepNameCache[sprite_index].Valid = false;
+    }
     if (value.empty())
     {
         std::free(Name);
@@ -2372,10 +2417,7 @@ static bool peep_interact_with_entrance(Peep* peep, const CoordsXYE& coords, uin
         peep->ActionSpriteImageOffset = _unk_F1AEF0;
         peep->InteractionRideIndex = rideIndex;
 
-        uint16_t previous_last = ride->stations[stationNum].LastPeepInQueue;
-        ride->stations[stationNum].LastPeepInQueue = peep->sprite_index;
-        peep->GuestNextInQueue = previous_last;
-        ride->stations[stationNum].QueueLength++;
+        ride->QueueInsertGuestAtBack(stationNum, peep);
 
         peep->CurrentRide = rideIndex;
         peep->CurrentRideStation = stationNum;
@@ -2797,10 +2839,7 @@ static void peep_interact_with_path(Peep* peep, const CoordsXYE& coords)
                     peep->InteractionRideIndex = rideIndex;
 
                     // Add the peep to the ride queue.
-                    uint16_t old_last_peep = ride->stations[stationNum].LastPeepInQueue;
-                    ride->stations[stationNum].LastPeepInQueue = peep->sprite_index;
-                    peep->GuestNextInQueue = old_last_peep;
-                    ride->stations[stationNum].QueueLength++;
+                    ride->QueueInsertGuestAtBack(stationNum, peep);
 
                     peep_decrement_num_riders(peep);
                     peep->CurrentRide = rideIndex;
@@ -3184,16 +3223,7 @@ int32_t peep_compare(const uint16_t sprite_index_a, const uint16_t sprite_index_
     }
 
     // Compare their names as strings
-    char nameA[256]{};
-    Formatter ft;
-    peep_a->FormatNameTo(ft);
-    format_string(nameA, sizeof(nameA), STR_STRINGID, ft.Data());
-
-    char nameB[256]{};
-    ft.Rewind();
-    peep_b->FormatNameTo(ft);
-    format_string(nameB, sizeof(nameB), STR_STRINGID, ft.Data());
-    return strlogicalcmp(nameA, nameB);
+    return strlogicalcmp(peep_a->GetName().c_str(), peep_b->GetName().c_str());
 }
 
 /**
@@ -3291,34 +3321,7 @@ void Peep::RemoveFromQueue()
     if (ride == nullptr)
         return;
 
-    auto& station = ride->stations[CurrentRideStation];
-    // Make sure we don't underflow, building while paused might reset it to 0 where peeps have
-    // not yet left the queue.
-    if (station.QueueLength > 0)
-    {
-        station.QueueLength--;
-    }
-
-    if (sprite_index == station.LastPeepInQueue)
-    {
-        station.LastPeepInQueue = GuestNextInQueue;
-        return;
-    }
-
-    auto* otherGuest = GetEntity<Guest>(station.LastPeepInQueue);
-    if (otherGuest == nullptr)
-    {
-        log_error("Invalid Guest Queue list!");
-        return;
-    }
-    for (; otherGuest != nullptr; otherGuest = GetEntity<Guest>(otherGuest->GuestNextInQueue))
-    {
-        if (sprite_index == otherGuest->GuestNextInQueue)
-        {
-            otherGuest->GuestNextInQueue = GuestNextInQueue;
-            return;
-        }
-    }
+    ride->QueueRemoveGuest(CurrentRideStation, this);
 }
 
 /**
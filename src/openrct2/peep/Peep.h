@@ -637,6 +637,8 @@ struct Peep : SpriteBase
         uint16_t MechanicTimeSinceCall; // time getting to ride to fix
         uint16_t GuestNextInQueue;
     };
+    // The guest behind in the queue, the reverse of GuestNextInQueue. Not saved, rebuilt when a park is loaded.
+    uint16_t GuestPreviousInQueue;
     union
     {
         uint8_t MazeLastEdge;
@@ -1028,6 +1030,12 @@ int32_t get_peep_face_sprite_small(Peep* peep);
 int32_t get_peep_face_sprite_large(Peep* peep);
 void peep_sprite_remove(Peep* peep);
 
+/**
+ * Removes every guest. The guest count, the guest list and the screen are refreshed once after all of them are gone
+ * rather than for each guest.
+ */
+void peep_remove_all_guests();
+
 void peep_window_state_update(Peep* peep);
 void peep_decrement_num_riders(Peep* peep);
 
@@ -1036,6 +1044,11 @@ int32_t peep_compare(const uint16_t sprite_index_a, const uint16_t sprite_index_
 
 void peep_update_names(bool realNames);
 
+/**
+ * Drops the formatted names Peep::GetName keeps, for when the language changes or the entities are replaced.
+ */
+void peep_name_cache_invalidate();
+
 void guest_set_name(uint16_t spriteIndex, const char* name);
 
 void increment_guests_in_park();
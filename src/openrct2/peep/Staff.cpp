@@ -140,28 +140,32 @@ bool staff_hire_new_member(StaffType staffType, EntertainerCostume entertainerTy
  */
 void staff_update_greyed_patrol_areas()
 {
-    for (int32_t staff_type = 0; staff_type < static_cast<uint8_t>(StaffType::Count); ++staff_type)
+    // The patrol areas of the staff types follow those of the individual staff members
+    uint32_t* staffTypePatrolAreas = &gStaffPatrolAreas[STAFF_MAX_COUNT * STAFF_PATROL_AREA_SIZE];
+    std::fill_n(staffTypePatrolAreas, static_cast<uint8_t>(StaffType::Count) * STAFF_PATROL_AREA_SIZE, 0);
+
+    // A single pass over the staff, merging whole words of each patrol area into the area of its staff type
+    for (auto peep : EntityList<Staff>())
     {
-        int32_t staffPatrolOffset = (staff_type + STAFF_MAX_COUNT) * STAFF_PATROL_AREA_SIZE;
-        for (int32_t i = 0; i < STAFF_PATROL_AREA_SIZE; i++)
-        {
-            gStaffPatrolAreas[staffPatrolOffset + i] = 0;
-        }
+        auto staffType = static_cast<uint8_t>(peep->AssignedStaffType);
+        if (staffType >= static_cast<uint8_t>(StaffType::Count))
+            continue;
 
-        for (auto peep : EntityList<Staff>())
+        uint32_t* dst = &staffTypePatrolAreas[staffType * STAFF_PATROL_AREA_SIZE];
+        const uint32_t* src = &gStaffPatrolAreas[peep->StaffId * STAFF_PATROL_AREA_SIZE];
+        for (int32_t i = 0; i < STAFF_PATROL_AREA_SIZE; i++)
         {
-            if (static_cast<uint8_t>(peep->AssignedStaffType) == staff_type)
-            {
-                int32_t peepPatrolOffset = peep->StaffId * STAFF_PATROL_AREA_SIZE;
-                for (int32_t i = 0; i < STAFF_PATROL_AREA_SIZE; i++)
-                {
-                    gStaffPatrolAreas[staffPatrolOffset + i] |= gStaffPatrolAreas[peepPatrolOffset + i];
-                }
-            }
+            dst[i] |= src[i];
         }
     }
 }
 
+bool staff_has_patrol_area(int32_t staffIndex)
+{
+    const uint32_t* patrolArea = &gStaffPatrolAreas[staffIndex * STAFF_PATROL_AREA_SIZE];
+    return std::any_of(patrolArea, patrolArea + STAFF_PATROL_AREA_SIZE, [](uint32_t word) { return word != 0; });
+}
+
 /**
  *
  *  rct2: 0x006C0905
@@ -421,20 +425,10 @@ void staff_toggle_patrol_area(int32_t staffIndex, const CoordsXY& coords)
  */
 Direction Staff::HandymanDirectionToNearestLitter() const
 {
-    uint16_t nearestLitterDist = 0xFFFF;
-    Litter* nearestLitter = nullptr;
-    for (auto litter : EntityList<Litter>())
-    {
-        uint16_t distance = abs(litter->x - x) + abs(litter->y - y) + abs(litter->z - z) * 4;
-
-        if (distance < nearestLitterDist)
-        {
-            nearestLitterDist = distance;
-            nearestLitter = litter;
-        }
-    }
-
-    if (nearestLitterDist > MAX_LITTER_DISTANCE)
+    auto* nearestLitter = GetNearestEntity<Litter>(CoordsXY{ x, y }, MAX_LITTER_DISTANCE, [this](const Litter& litter) {
+        return abs(litter.x - x) + abs(litter.y - y) + abs(litter.z - z) * 4;
+    });
+    if (nearestLitter == nullptr)
     {
         return INVALID_DIRECTION;
     }
@@ -960,23 +954,9 @@ bool Staff::DoMiscPathFinding()
  */
 void Staff::EntertainerUpdateNearbyPeeps() const
 {
-    for (auto guest : EntityList<Guest>())
-    {
-        if (guest->x == LOCATION_NULL)
-            continue;
-
-        int16_t z_dist = abs(z - guest->z);
-        if (z_dist > 48)
-            continue;
-
-        int16_t x_dist = abs(x - guest->x);
-        int16_t y_dist = abs(y - guest->y);
-
-        if (x_dist > 96)
-            continue;
-
-        if (y_dist > 96)
-            continue;
+    ForEachEntityInRange<Guest>({ x, y }, 96, [this](Guest* guest) {
+        if (std::abs(z - guest->z) > 48)
+            return;
 
         if (guest->State == PeepState::Walking)
         {
@@ -987,7 +967,7 @@ void Staff::EntertainerUpdateNearbyPeeps() const
             guest->TimeInQueue = std::max(0, guest->TimeInQueue - 200);
             guest->HappinessTarget = std::min(guest->HappinessTarget + 3, PEEP_MAX_HAPPINESS);
         }
-    }
+    });
 }
 
 /**
@@ -1621,26 +1601,28 @@ bool Staff::UpdatePatrollingFindWatering()
                 continue;
             }
 
-            rct_scenery_entry* sceneryEntry = tile_element->AsSmallScenery()->GetEntry();
-
-            if (sceneryEntry == nullptr || !scenery_small_entry_has_flag(sceneryEntry, SMALL_SCENERY_FLAG_CAN_BE_WATERED))
-            {
-                continue;
-            }
-
-            if (tile_element->AsSmallScenery()->GetAge() < SCENERY_WITHER_AGE_THRESHOLD_2)
+            // Most scenery has been watered recently, check its age before looking up its entry
+            auto age = tile_element->AsSmallScenery()->GetAge();
+            if (age < SCENERY_WITHER_AGE_THRESHOLD_2)
             {
                 if (chosen_position >= 4)
                 {
                     continue;
                 }
 
-                if (tile_element->AsSmallScenery()->GetAge() < SCENERY_WITHER_AGE_THRESHOLD_1)
+                if (age < SCENERY_WITHER_AGE_THRESHOLD_1)
                 {
                     continue;
                 }
             }
 
+            rct_scenery_entry* sceneryEntry = tile_element->AsSmallScenery()->GetEntry();
+
+            if (sceneryEntry == nullptr || !scenery_small_entry_has_flag(sceneryEntry, SMALL_SCENERY_FLAG_CAN_BE_WATERED))
+            {
+                continue;
+            }
+
             SetState(PeepState::Watering);
             Var37 = chosen_position;
 
@@ -65,6 +65,7 @@ void staff_reset_modes();
 void staff_set_name(uint16_t spriteIndex, const char* name);
 bool staff_hire_new_member(StaffType staffType, EntertainerCostume entertainerType);
 void staff_update_greyed_patrol_areas();
+bool staff_has_patrol_area(int32_t staffIndex);
 bool staff_is_patrol_area_set_for_type(StaffType type, const CoordsXY& coords);
 void staff_set_patrol_area(int32_t staffIndex, const CoordsXY& coords, bool value);
 void staff_toggle_patrol_area(int32_t staffIndex, const CoordsXY& coords);
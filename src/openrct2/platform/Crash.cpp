@@ -218,6 +218,7 @@ static bool OnCrash(
     }
 
     std::string screenshotPath = screenshot_dump();
+    screenshot_wait_for_pending();
     if (!screenshotPath.empty())
     {
         auto screenshotPathW = String::ToWideChar(screenshotPath.c_str());
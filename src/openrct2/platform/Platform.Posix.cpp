@@ -127,7 +127,7 @@ namespace Platform
             size_t readBytes;
             while ((readBytes = fread(buffer, 1, sizeof(buffer), fpipe)) > 0)
             {
-                outputBuffer.insert(outputBuffer.begin(), buffer, buffer + readBytes);
+                outputBuffer.insert(outputBuffer.end(), buffer, buffer + readBytes);
             }
 
             // Trim line breaks
@@ -159,6 +159,25 @@ namespace Platform
         return -1;
 #    endif // __EMSCRIPTEN__
     }
+
+    std::string QuoteArgument(const std::string& argument)
+    {
+        // Nothing is special within single quotes, only a single quote has to end the quotes to be escaped
+        std::string result = "'";
+        for (auto c : argument)
+        {
+            if (c == '\'')
+            {
+                result += "'\\''";
+            }
+            else
+            {
+                result += c;
+            }
+        }
+        result += '\'';
+        return result;
+    }
 } // namespace Platform
 
 #endif
@@ -535,6 +535,21 @@ namespace Platform
         log_warning("Execute() not implemented for Windows!");
         return -1;
     }
+
+    std::string QuoteArgument(const std::string& argument)
+    {
+        std::string result = "\"";
+        for (auto c : argument)
+        {
+            if (c == '"')
+            {
+                result += '\\';
+            }
+            result += c;
+        }
+        result += '"';
+        return result;
+    }
 } // namespace Platform
 
 #endif
@@ -39,6 +39,8 @@ namespace Platform
     rct2_date GetDateLocal();
     bool FindApp(const std::string& app, std::string* output);
     int32_t Execute(const std::string& command, std::string* output = nullptr);
+    // Quotes the argument so Execute passes it to the command as it is, whatever characters it contains
+    std::string QuoteArgument(const std::string& argument);
 
 #if defined(__unix__) || (defined(__APPLE__) && defined(__MACH__)) || defined(__FreeBSD__)
     std::string GetEnvironmentPath(const char* name);
@@ -173,7 +173,7 @@ public:
     ParkLoadResult LoadFromStream(
         IStream* stream, bool isScenario, [[maybe_unused]] bool skipObjectCheck, const utf8* path) override
     {
-        _s4 = *ReadAndDecodeS4(stream, isScenario);
+        ReadAndDecodeS4(stream, isScenario);
         _s4Path = path;
         _isScenario = isScenario;
         _gameVersion = sawyercoding_detect_rct1_version(_s4.game_version) & FILE_VERSION_MASK;
@@ -209,6 +209,7 @@ public:
         CountBlockSections();
         SetDefaultNames();
         determine_ride_entrance_and_exit_locations();
+        ride_queues_rebuild();
 
         map_count_remaining_land_rights();
         research_determine_first_of_type();
@@ -299,30 +300,28 @@ public:
     }
 
 private:
-    std::unique_ptr<rct1_s4> ReadAndDecodeS4(IStream* stream, bool isScenario)
+    /**
+     * Decodes the park straight into _s4, so only the encoded file and the decoded state are held at once rather than
+     * further copies of the decoded state.
+     */
+    void ReadAndDecodeS4(IStream* stream, bool isScenario)
     {
-        auto s4 = std::make_unique<rct1_s4>();
         size_t dataSize = stream->GetLength() - stream->GetPosition();
         auto data = stream->ReadArray<uint8_t>(dataSize);
-        auto decodedData = std::make_unique<uint8_t[]>(sizeof(rct1_s4));
+        auto decodedData = reinterpret_cast<uint8_t*>(&_s4);
 
         size_t decodedSize;
         int32_t fileType = sawyercoding_detect_file_type(data.get(), dataSize);
         if (isScenario && (fileType & FILE_VERSION_MASK) != FILE_VERSION_RCT1)
         {
-            decodedSize = sawyercoding_decode_sc4(data.get(), decodedData.get(), dataSize, sizeof(rct1_s4));
+            decodedSize = sawyercoding_decode_sc4(data.get(), decodedData, dataSize, sizeof(rct1_s4));
         }
         else
         {
-            decodedSize = sawyercoding_decode_sv4(data.get(), decodedData.get(), dataSize, sizeof(rct1_s4));
+            decodedSize = sawyercoding_decode_sv4(data.get(), decodedData, dataSize, sizeof(rct1_s4));
         }
 
-        if (decodedSize == sizeof(rct1_s4))
-        {
-            std::memcpy(s4.get(), decodedData.get(), sizeof(rct1_s4));
-            return s4;
-        }
-        else
+        if (decodedSize != sizeof(rct1_s4))
         {
             throw std::runtime_error("Unable to decode park.");
         }
@@ -2019,6 +2018,9 @@ private:
         // Build tile pointer cache (needed to get the first element at a certain location)
         auto tilePointerIndex = TilePointerIndex<RCT12TileElement>(RCT1_MAX_MAP_SIZE, _s4.tile_elements);
 
+        // Walls are split into an element per edge so the number of elements is only known afterwards, the memory past
+        // the imported elements is never touched though
+        map_reserve_tile_elements(MAX_TILE_ELEMENTS_WITH_SPARE_ROOM);
         TileElement* dstElement = gTileElements;
 
         for (TileCoordsXY coords = { 0, 0 }; coords.y < MAXIMUM_MAP_SIZE_TECHNICAL; coords.y++)
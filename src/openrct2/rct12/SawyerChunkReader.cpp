@@ -10,12 +10,17 @@
 #include "SawyerChunkReader.h"
 
 #include "../core/IStream.hpp"
+#include "../core/JobPool.h"
 
-// malloc is very slow for large allocations in MSVC debug builds as it allocates
-// memory on a special debug heap and then initialises all the memory to 0xCC.
-#if defined(_WIN32) && defined(DEBUG)
-#    define __USE_HEAP_ALLOC__
-#    include <windows.h>
+#include <algorithm>
+#include <cstdlib>
+#include <exception>
+#include <vector>
+
+// SSE2 is always available on x86-64, so unlike the drawing functions it does not need a runtime check
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    define SAWYER_CHUNK_READER_SSE2
+#    include <emmintrin.h>
 #endif
 
 // Allow chunks to be uncompressed to a maximum of 16 MiB
@@ -27,6 +32,47 @@ constexpr const char* EXCEPTION_MSG_DESTINATION_TOO_SMALL = "Chunk data larger t
 constexpr const char* EXCEPTION_MSG_INVALID_CHUNK_ENCODING = "Invalid chunk encoding.";
 constexpr const char* EXCEPTION_MSG_ZERO_SIZED_CHUNK = "Encountered zero-sized chunk.";
 
+// Runs are expanded in blocks of this many bytes
+constexpr size_t BLOCK_SIZE = 16;
+
+static size_t RoundUpToBlockSize(size_t count)
+{
+    return (count + (BLOCK_SIZE - 1)) & ~(BLOCK_SIZE - 1);
+}
+
+static void FillBlocks(uint8_t* dst, uint8_t value, size_t count)
+{
+#ifdef SAWYER_CHUNK_READER_SSE2
+    const auto block = _mm_set1_epi8(static_cast<char>(value));
+    for (size_t i = 0; i < count; i += BLOCK_SIZE)
+    {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), block);
+    }
+#else
+    // Fixed size memset calls are turned into vector stores by the compiler
+    for (size_t i = 0; i < count; i += BLOCK_SIZE)
+    {
+        std::memset(dst + i, value, BLOCK_SIZE);
+    }
+#endif
+}
+
+static void CopyBlocks(uint8_t* dst, const uint8_t* src, size_t count)
+{
+#ifdef SAWYER_CHUNK_READER_SSE2
+    for (size_t i = 0; i < count; i += BLOCK_SIZE)
+    {
+        _mm_storeu_si128(
+            reinterpret_cast<__m128i*>(dst + i), _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i)));
+    }
+#else
+    for (size_t i = 0; i < count; i += BLOCK_SIZE)
+    {
+        std::memcpy(dst + i, src + i, BLOCK_SIZE);
+    }
+#endif
+}
+
 SawyerChunkReader::SawyerChunkReader(OpenRCT2::IStream* stream)
     : _stream(stream)
 {
@@ -64,29 +110,9 @@ std::shared_ptr<SawyerChunk> SawyerChunkReader::ReadChunk()
             case CHUNK_ENCODING_RLECOMPRESSED:
             case CHUNK_ENCODING_ROTATE:
             {
-                std::unique_ptr<uint8_t[]> compressedData(new uint8_t[header.length]);
-                if (_stream->TryRead(compressedData.get(), header.length) != header.length)
-                {
-                    throw SawyerChunkException(EXCEPTION_MSG_CORRUPT_CHUNK_SIZE);
-                }
-
-                auto buffer = static_cast<uint8_t*>(AllocateLargeTempBuffer());
-                try
-                {
-                    size_t uncompressedLength = DecodeChunk(buffer, MAX_UNCOMPRESSED_CHUNK_SIZE, compressedData.get(), header);
-                    if (uncompressedLength == 0)
-                    {
-                        throw SawyerChunkException(EXCEPTION_MSG_ZERO_SIZED_CHUNK);
-                    }
-                    buffer = static_cast<uint8_t*>(FinaliseLargeTempBuffer(buffer, uncompressedLength));
-                    return std::make_shared<SawyerChunk>(
-                        static_cast<SAWYER_ENCODING>(header.encoding), buffer, uncompressedLength);
-                }
-                catch (const std::exception&)
-                {
-                    FreeLargeTempBuffer(buffer);
-                    throw;
-                }
+                std::unique_ptr<uint8_t[]> compressedDataBuffer;
+                auto compressedData = ReadCompressedData(header.length, compressedDataBuffer);
+                return DecodeChunk(compressedData, header);
             }
             default:
                 throw SawyerChunkException(EXCEPTION_MSG_INVALID_CHUNK_ENCODING);
@@ -112,22 +138,75 @@ std::shared_ptr<SawyerChunk> SawyerChunkReader::ReadChunkTrack()
             throw SawyerChunkException(EXCEPTION_MSG_ZERO_SIZED_CHUNK);
         }
         uint32_t compressedDataLength = compressedDataLength64;
-        auto compressedData = std::make_unique<uint8_t[]>(compressedDataLength);
+        std::unique_ptr<uint8_t[]> compressedDataBuffer;
+        auto compressedData = ReadCompressedData(compressedDataLength, compressedDataBuffer);
+
+        sawyercoding_chunk_header header{ CHUNK_ENCODING_RLE, compressedDataLength };
+        return DecodeChunk(compressedData, header);
+    }
+    catch (const std::exception&)
+    {
+        // Rewind stream back to original position
+        _stream->SetPosition(originalPosition);
+        throw;
+    }
+}
 
-        if (_stream->TryRead(compressedData.get(), compressedDataLength) != compressedDataLength)
+void SawyerChunkReader::ReadChunk(void* dst, size_t length)
+{
+    auto chunk = ReadChunk();
+    CopyChunk(*chunk, dst, length);
+}
+
+void SawyerChunkReader::ReadChunks(JobPool& jobPool, std::initializer_list<ChunkDestination> destinations)
+{
+    struct PendingChunk
+    {
+        ChunkDestination Destination;
+        sawyercoding_chunk_header Header;
+        const uint8_t* CompressedData;
+        std::unique_ptr<uint8_t[]> CompressedDataBuffer;
+        std::exception_ptr Exception;
+    };
+
+    uint64_t originalPosition = _stream->GetPosition();
+    try
+    {
+        // The chunks follow each other in the stream, so only the reading is sequential
+        std::vector<PendingChunk> chunks(destinations.size());
+        size_t i = 0;
+        for (const auto& destination : destinations)
         {
-            throw SawyerChunkException(EXCEPTION_MSG_CORRUPT_CHUNK_SIZE);
+            auto& chunk = chunks[i++];
+            chunk.Destination = destination;
+            chunk.Header = _stream->ReadValue<sawyercoding_chunk_header>();
+            if (chunk.Header.length >= MAX_UNCOMPRESSED_CHUNK_SIZE)
+                throw SawyerChunkException(EXCEPTION_MSG_CORRUPT_CHUNK_SIZE);
+            if (chunk.Header.encoding > CHUNK_ENCODING_ROTATE)
+                throw SawyerChunkException(EXCEPTION_MSG_INVALID_CHUNK_ENCODING);
+            chunk.CompressedData = ReadCompressedData(chunk.Header.length, chunk.CompressedDataBuffer);
         }
 
-        auto buffer = static_cast<uint8_t*>(AllocateLargeTempBuffer());
-        sawyercoding_chunk_header header{ CHUNK_ENCODING_RLE, compressedDataLength };
-        size_t uncompressedLength = DecodeChunk(buffer, MAX_UNCOMPRESSED_CHUNK_SIZE, compressedData.get(), header);
-        if (uncompressedLength == 0)
+        jobPool.ParallelFor(0, chunks.size(), 1, [&chunks](size_t index) {
+            auto& chunk = chunks[index];
+            try
+            {
+                auto decoded = DecodeChunk(chunk.CompressedData, chunk.Header);
+                CopyChunk(*decoded, chunk.Destination.Data, chunk.Destination.Length);
+            }
+            catch (...)
+            {
+                chunk.Exception = std::current_exception();
+            }
+        });
+
+        for (const auto& chunk : chunks)
         {
-            throw SawyerChunkException(EXCEPTION_MSG_ZERO_SIZED_CHUNK);
+            if (chunk.Exception != nullptr)
+            {
+                std::rethrow_exception(chunk.Exception);
+            }
         }
-        buffer = static_cast<uint8_t*>(FinaliseLargeTempBuffer(buffer, uncompressedLength));
-        return std::make_shared<SawyerChunk>(SAWYER_ENCODING::RLE, buffer, uncompressedLength);
     }
     catch (const std::exception&)
     {
@@ -137,11 +216,10 @@ std::shared_ptr<SawyerChunk> SawyerChunkReader::ReadChunkTrack()
     }
 }
 
-void SawyerChunkReader::ReadChunk(void* dst, size_t length)
+void SawyerChunkReader::CopyChunk(const SawyerChunk& chunk, void* dst, size_t length)
 {
-    auto chunk = ReadChunk();
-    auto chunkData = static_cast<const uint8_t*>(chunk->GetData());
-    auto chunkLength = chunk->GetLength();
+    auto chunkData = static_cast<const uint8_t*>(chunk.GetData());
+    auto chunkLength = chunk.GetLength();
     if (chunkLength > length)
     {
         std::memcpy(dst, chunkData, length);
@@ -158,46 +236,149 @@ void SawyerChunkReader::ReadChunk(void* dst, size_t length)
     }
 }
 
-size_t SawyerChunkReader::DecodeChunk(void* dst, size_t dstCapacity, const void* src, const sawyercoding_chunk_header& header)
+const uint8_t* SawyerChunkReader::ReadCompressedData(size_t length, std::unique_ptr<uint8_t[]>& buffer)
 {
-    size_t resultLength;
+    // Decode straight from the stream's memory if it has any (memory streams and memory mapped files)
+    auto streamData = static_cast<const uint8_t*>(_stream->GetData());
+    if (streamData != nullptr)
+    {
+        auto position = _stream->GetPosition();
+        if (_stream->GetLength() - position < length)
+        {
+            throw SawyerChunkException(EXCEPTION_MSG_CORRUPT_CHUNK_SIZE);
+        }
+        _stream->Seek(length, OpenRCT2::STREAM_SEEK_CURRENT);
+        return streamData + position;
+    }
+
+    buffer.reset(new uint8_t[length]);
+    if (_stream->TryRead(buffer.get(), length) != length)
+    {
+        throw SawyerChunkException(EXCEPTION_MSG_CORRUPT_CHUNK_SIZE);
+    }
+    return buffer.get();
+}
+
+std::shared_ptr<SawyerChunk> SawyerChunkReader::DecodeChunk(const void* src, const sawyercoding_chunk_header& header)
+{
+    // The repeat pass can only be sized once the RLE pass has expanded its input
+    auto decodeSrc = static_cast<const uint8_t*>(src);
+    size_t decodeSrcLength = header.length;
+    std::unique_ptr<uint8_t[]> immBuffer;
+    if (header.encoding == CHUNK_ENCODING_RLECOMPRESSED)
+    {
+        auto immLength = GetDecodedLengthRLE(src, header.length);
+        immBuffer.reset(new uint8_t[immLength]);
+        decodeSrcLength = DecodeChunkRLE(immBuffer.get(), immLength, src, header.length);
+        decodeSrc = immBuffer.get();
+    }
+
+    size_t length;
     switch (header.encoding)
     {
         case CHUNK_ENCODING_NONE:
-            if (header.length > dstCapacity)
-            {
-                throw SawyerChunkException(EXCEPTION_MSG_DESTINATION_TOO_SMALL);
-            }
-            std::memcpy(dst, src, header.length);
-            resultLength = header.length;
+        case CHUNK_ENCODING_ROTATE:
+            length = decodeSrcLength;
             break;
         case CHUNK_ENCODING_RLE:
-            resultLength = DecodeChunkRLE(dst, dstCapacity, src, header.length);
+            length = GetDecodedLengthRLE(decodeSrc, decodeSrcLength);
             break;
         case CHUNK_ENCODING_RLECOMPRESSED:
-            resultLength = DecodeChunkRLERepeat(dst, dstCapacity, src, header.length);
-            break;
-        case CHUNK_ENCODING_ROTATE:
-            resultLength = DecodeChunkRotate(dst, dstCapacity, src, header.length);
+            // Each repeat code expands to at most 8 bytes, counting them would take as long as decoding them so the
+            // buffer is shrunk to fit afterwards instead
+            length = std::min(decodeSrcLength * 8, MAX_UNCOMPRESSED_CHUNK_SIZE);
             break;
         default:
             throw SawyerChunkException(EXCEPTION_MSG_INVALID_CHUNK_ENCODING);
     }
-    return resultLength;
+    if (length == 0)
+    {
+        throw SawyerChunkException(EXCEPTION_MSG_ZERO_SIZED_CHUNK);
+    }
+    if (length > MAX_UNCOMPRESSED_CHUNK_SIZE)
+    {
+        throw SawyerChunkException(EXCEPTION_MSG_DESTINATION_TOO_SMALL);
+    }
+
+    // The chunk is decoded straight into the buffer the chunk takes ownership of
+    auto buffer = static_cast<uint8_t*>(std::malloc(length));
+    if (buffer == nullptr)
+    {
+        throw std::runtime_error("Unable to allocate chunk buffer.");
+    }
+    try
+    {
+        switch (header.encoding)
+        {
+            case CHUNK_ENCODING_NONE:
+                std::memcpy(buffer, decodeSrc, length);
+                break;
+            case CHUNK_ENCODING_RLE:
+                DecodeChunkRLE(buffer, length, decodeSrc, decodeSrcLength);
+                break;
+            case CHUNK_ENCODING_RLECOMPRESSED:
+            {
+                length = DecodeChunkRepeat(buffer, length, decodeSrc, decodeSrcLength);
+                if (length == 0)
+                {
+                    throw SawyerChunkException(EXCEPTION_MSG_ZERO_SIZED_CHUNK);
+                }
+                auto finalBuffer = static_cast<uint8_t*>(std::realloc(buffer, length));
+                if (finalBuffer == nullptr)
+                {
+                    throw std::runtime_error("Unable to allocate chunk buffer.");
+                }
+                buffer = finalBuffer;
+                break;
+            }
+            case CHUNK_ENCODING_ROTATE:
+                DecodeChunkRotate(buffer, length, decodeSrc, decodeSrcLength);
+                break;
+        }
+    }
+    catch (const std::exception&)
+    {
+        std::free(buffer);
+        throw;
+    }
+    return std::make_shared<SawyerChunk>(static_cast<SAWYER_ENCODING>(header.encoding), buffer, length);
 }
 
-size_t SawyerChunkReader::DecodeChunkRLERepeat(void* dst, size_t dstCapacity, const void* src, size_t srcLength)
+size_t SawyerChunkReader::GetDecodedLengthRLE(const void* src, size_t srcLength)
 {
-    auto immBuffer = std::unique_ptr<uint8_t, decltype(&FreeLargeTempBuffer)>(
-        static_cast<uint8_t*>(AllocateLargeTempBuffer()), &FreeLargeTempBuffer);
-    auto immLength = DecodeChunkRLE(immBuffer.get(), MAX_UNCOMPRESSED_CHUNK_SIZE, src, srcLength);
-    auto size = DecodeChunkRepeat(dst, dstCapacity, immBuffer.get(), immLength);
-    return size;
+    auto src8 = static_cast<const uint8_t*>(src);
+    size_t length = 0;
+    for (size_t i = 0; i < srcLength; i++)
+    {
+        uint8_t rleCodeByte = src8[i];
+        if (rleCodeByte & 128)
+        {
+            i++;
+            length += 257 - rleCodeByte;
+        }
+        else
+        {
+            i += rleCodeByte + 1;
+            length += rleCodeByte + 1;
+        }
+        if (i >= srcLength)
+        {
+            throw SawyerChunkException(EXCEPTION_MSG_CORRUPT_RLE);
+        }
+
+        // Stop early so corrupt data can not make us allocate more than a chunk can ever be
+        if (length > MAX_UNCOMPRESSED_CHUNK_SIZE)
+        {
+            throw SawyerChunkException(EXCEPTION_MSG_DESTINATION_TOO_SMALL);
+        }
+    }
+    return length;
 }
 
 size_t SawyerChunkReader::DecodeChunkRLE(void* dst, size_t dstCapacity, const void* src, size_t srcLength)
 {
     auto src8 = static_cast<const uint8_t*>(src);
+    auto srcEnd = src8 + srcLength;
     auto dst8 = static_cast<uint8_t*>(dst);
     auto dstEnd = dst8 + dstCapacity;
     for (size_t i = 0; i < srcLength; i++)
@@ -217,27 +398,43 @@ size_t SawyerChunkReader::DecodeChunkRLE(void* dst, size_t dstCapacity, const vo
                 throw SawyerChunkException(EXCEPTION_MSG_DESTINATION_TOO_SMALL);
             }
 
-            std::fill_n(dst8, count, src8[i]);
+            // Runs are written in whole blocks when there is room for the overshoot, later runs overwrite it
+            if (dst8 + RoundUpToBlockSize(count) <= dstEnd)
+            {
+                FillBlocks(dst8, src8[i], count);
+            }
+            else
+            {
+                std::fill_n(dst8, count, src8[i]);
+            }
             dst8 += count;
         }
         else
         {
+            size_t count = rleCodeByte + 1;
             if (i + 1 >= srcLength)
             {
                 throw SawyerChunkException(EXCEPTION_MSG_CORRUPT_RLE);
             }
-            if (dst8 + rleCodeByte + 1 > dstEnd)
+            if (dst8 + count > dstEnd)
             {
                 throw SawyerChunkException(EXCEPTION_MSG_DESTINATION_TOO_SMALL);
             }
-            if (i + 1 + rleCodeByte + 1 > srcLength)
+            if (i + 1 + count > srcLength)
             {
                 throw SawyerChunkException(EXCEPTION_MSG_CORRUPT_RLE);
             }
 
-            std::memcpy(dst8, src8 + i + 1, rleCodeByte + 1);
-            dst8 += rleCodeByte + 1;
-            i += rleCodeByte + 1;
+            if (dst8 + RoundUpToBlockSize(count) <= dstEnd && src8 + i + 1 + RoundUpToBlockSize(count) <= srcEnd)
+            {
+                CopyBlocks(dst8, src8 + i + 1, count);
+            }
+            else
+            {
+                std::memcpy(dst8, src8 + i + 1, count);
+            }
+            dst8 += count;
+            i += count;
         }
     }
     return reinterpret_cast<uintptr_t>(dst8) - reinterpret_cast<uintptr_t>(dst);
@@ -252,6 +449,14 @@ size_t SawyerChunkReader::DecodeChunkRepeat(void* dst, size_t dstCapacity, const
     {
         if (src8[i] == 0xFF)
         {
+            if (i + 1 >= srcLength)
+            {
+                throw SawyerChunkException(EXCEPTION_MSG_CORRUPT_RLE);
+            }
+            if (dst8 >= dstEnd)
+            {
+                throw SawyerChunkException(EXCEPTION_MSG_DESTINATION_TOO_SMALL);
+            }
             *dst8++ = src8[++i];
         }
         else
@@ -259,7 +464,7 @@ size_t SawyerChunkReader::DecodeChunkRepeat(void* dst, size_t dstCapacity, const
             size_t count = (src8[i] & 7) + 1;
             const uint8_t* copySrc = dst8 + static_cast<int32_t>(src8[i] >> 3) - 32;
 
-            if (dst8 + count >= dstEnd || copySrc + count >= dstEnd)
+            if (dst8 + count > dstEnd || copySrc + count > dstEnd)
             {
                 throw SawyerChunkException(EXCEPTION_MSG_DESTINATION_TOO_SMALL);
             }
@@ -289,50 +494,29 @@ size_t SawyerChunkReader::DecodeChunkRotate(void* dst, size_t dstCapacity, const
 
     auto src8 = static_cast<const uint8_t*>(src);
     auto dst8 = static_cast<uint8_t*>(dst);
-    uint8_t code = 1;
-    for (size_t i = 0; i < srcLength; i++)
+    size_t i = 0;
+#ifdef SAWYER_CHUNK_READER_SSE2
+    // The rotation repeats every 4 bytes (1, 3, 5, 7), so it is the same for every 16 byte block. Rotating right by n is
+    // rotating left by 8 - n, which multiplying the zero extended byte by 1 << (8 - n) does with the bits that wrap
+    // around ending up in the high byte of the 16 bit lane.
+    const auto multipliers = _mm_setr_epi16(128, 32, 8, 2, 128, 32, 8, 2);
+    const auto lowByteMask = _mm_set1_epi16(0xFF);
+    const auto zero = _mm_setzero_si128();
+    for (; i + 16 <= srcLength; i += 16)
     {
-        dst8[i] = ror8(src8[i], code);
-        code = (code + 2) % 8;
+        auto bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src8 + i));
+        auto lo = _mm_mullo_epi16(_mm_unpacklo_epi8(bytes, zero), multipliers);
+        auto hi = _mm_mullo_epi16(_mm_unpackhi_epi8(bytes, zero), multipliers);
+        lo = _mm_or_si128(_mm_and_si128(lo, lowByteMask), _mm_srli_epi16(lo, 8));
+        hi = _mm_or_si128(_mm_and_si128(hi, lowByteMask), _mm_srli_epi16(hi, 8));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst8 + i), _mm_packus_epi16(lo, hi));
     }
-    return srcLength;
-}
-
-void* SawyerChunkReader::AllocateLargeTempBuffer()
-{
-#ifdef __USE_HEAP_ALLOC__
-    auto buffer = HeapAlloc(GetProcessHeap(), 0, MAX_UNCOMPRESSED_CHUNK_SIZE);
-#else
-    auto buffer = std::malloc(MAX_UNCOMPRESSED_CHUNK_SIZE);
 #endif
-    if (buffer == nullptr)
+    uint8_t code = static_cast<uint8_t>(((i % 4) * 2) + 1);
+    for (; i < srcLength; i++)
     {
-        throw std::runtime_error("Unable to allocate large temporary buffer.");
-    }
-    return buffer;
-}
-
-void* SawyerChunkReader::FinaliseLargeTempBuffer(void* buffer, size_t len)
-{
-#ifdef __USE_HEAP_ALLOC__
-    auto finalBuffer = std::malloc(len);
-    std::memcpy(finalBuffer, buffer, len);
-    HeapFree(GetProcessHeap(), 0, buffer);
-#else
-    auto finalBuffer = static_cast<uint8_t*>(std::realloc(buffer, len));
-#endif
-    if (finalBuffer == nullptr)
-    {
-        throw std::runtime_error("Unable to allocate final buffer.");
+        dst8[i] = ror8(src8[i], code);
+        code = (code + 2) % 8;
     }
-    return finalBuffer;
-}
-
-void SawyerChunkReader::FreeLargeTempBuffer(void* buffer)
-{
-#ifdef __USE_HEAP_ALLOC__
-    HeapFree(GetProcessHeap(), 0, buffer);
-#else
-    std::free(buffer);
-#endif
+    return srcLength;
 }
@@ -14,8 +14,11 @@
 #include "../util/SawyerCoding.h"
 #include "SawyerChunk.h"
 
+#include <initializer_list>
 #include <memory>
 
+class JobPool;
+
 class SawyerChunkException : public IOException
 {
 public:
@@ -72,6 +75,20 @@ public:
      */
     void ReadChunk(void* dst, size_t length);
 
+    struct ChunkDestination
+    {
+        void* Data;
+        size_t Length;
+    };
+
+    /**
+     * Reads the next chunks from the stream into the given destination
+     * buffers, which are copied to and padded like ReadChunk(dst, length)
+     * does. The chunks are read in order but decoded in parallel on the
+     * given job pool.
+     */
+    void ReadChunks(JobPool& jobPool, std::initializer_list<ChunkDestination> destinations);
+
     /**
      * Reads the next chunk from the stream into a buffer returned as the
      * specified type. If the chunk is smaller than the size of the type
@@ -85,13 +102,16 @@ public:
     }
 
 private:
-    static size_t DecodeChunk(void* dst, size_t dstCapacity, const void* src, const sawyercoding_chunk_header& header);
-    static size_t DecodeChunkRLERepeat(void* dst, size_t dstCapacity, const void* src, size_t srcLength);
+    const uint8_t* ReadCompressedData(size_t length, std::unique_ptr<uint8_t[]>& buffer);
+
+    static void CopyChunk(const SawyerChunk& chunk, void* dst, size_t length);
+
+    /**
+     * Decodes a chunk into a buffer allocated to its decoded size, or an upper bound of it for the repeat encoding.
+     */
+    static std::shared_ptr<SawyerChunk> DecodeChunk(const void* src, const sawyercoding_chunk_header& header);
+    static size_t GetDecodedLengthRLE(const void* src, size_t srcLength);
     static size_t DecodeChunkRLE(void* dst, size_t dstCapacity, const void* src, size_t srcLength);
     static size_t DecodeChunkRepeat(void* dst, size_t dstCapacity, const void* src, size_t srcLength);
     static size_t DecodeChunkRotate(void* dst, size_t dstCapacity, const void* src, size_t srcLength);
-
-    static void* AllocateLargeTempBuffer();
-    static void* FinaliseLargeTempBuffer(void* buffer, size_t len);
-    static void FreeLargeTempBuffer(void* buffer);
 };
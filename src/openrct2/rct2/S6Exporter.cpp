@@ -13,10 +13,15 @@
 #include "../Game.h"
 #include "../GameState.h"
 #include "../OpenRCT2.h"
+#include "../ParkFile.h"
 #include "../common.h"
 #include "../config/Config.h"
+#include "../core/Console.hpp"
 #include "../core/FileStream.h"
 #include "../core/IStream.hpp"
+#include "../core/JobPool.h"
+#include "../core/MemoryStream.h"
+#include "../core/Path.hpp"
 #include "../core/String.hpp"
 #include "../interface/Viewport.h"
 #include "../interface/Window.h"
@@ -31,6 +36,7 @@
 #include "../object/ObjectLimits.h"
 #include "../object/ObjectManager.h"
 #include "../object/ObjectRepository.h"
+#include "../peep/GuestPathfinding.h"
 #include "../peep/Staff.h"
 #include "../rct12/SawyerChunkWriter.h"
 #include "../ride/Ride.h"
@@ -51,7 +57,21 @@
 #include <cstring>
 #include <functional>
 #include <iterator>
+#include <memory>
+#include <mutex>
 #include <optional>
+#include <string>
+
+static std::unique_ptr<JobPool> _s6ExportJobs;
+
+static JobPool& GetS6ExportJobPool()
+{
+    if (_s6ExportJobs == nullptr)
+    {
+        _s6ExportJobs = std::make_unique<JobPool>();
+    }
+    return *_s6ExportJobs;
+}
 
 S6Exporter::S6Exporter()
 {
@@ -81,7 +101,43 @@ void S6Exporter::SaveScenario(OpenRCT2::IStream* stream)
     Save(stream, true);
 }
 
-void S6Exporter::Save(OpenRCT2::IStream* stream, bool isScenario)
+void S6Exporter::SaveParkFile(const utf8* path, bool isScenario)
+{
+    auto fs = OpenRCT2::FileStream(path, OpenRCT2::FILE_MODE_WRITE);
+    SaveParkFile(&fs, isScenario);
+}
+
+void S6Exporter::SaveParkFile(OpenRCT2::IStream* stream, bool isScenario)
+{
+    InitialiseHeader(isScenario);
+
+    OpenRCT2::MemoryStream packedObjects;
+    if (_s6.header.num_packed_objects > 0)
+    {
+        WritePackedObjects(&packedObjects);
+    }
+
+    // Scenarios store the whole park state block like saved games do, unlike SC6 files which leave out the parts only
+    // saved games use
+    ParkFileWriter writer;
+    writer.AddChunk(ParkFileChunkType::Header, &_s6.header, sizeof(_s6.header));
+    if (isScenario)
+    {
+        writer.AddChunk(ParkFileChunkType::Info, &_s6.info, sizeof(_s6.info));
+    }
+    if (_s6.header.num_packed_objects > 0)
+    {
+        writer.AddChunk(
+            ParkFileChunkType::PackedObjects, packedObjects.GetData(), static_cast<size_t>(packedObjects.GetLength()));
+    }
+    writer.AddChunk(ParkFileChunkType::Objects, _s6.objects, sizeof(_s6.objects));
+    writer.AddChunk(ParkFileChunkType::General, &_s6.elapsed_months, 16);
+    writer.AddChunk(ParkFileChunkType::TileElements, &_s6.tile_elements, sizeof(_s6.tile_elements));
+    writer.AddChunk(ParkFileChunkType::ParkState, &_s6.next_free_tile_element_pointer_index, RCT2_S6_PARK_STATE_SIZE);
+    writer.Save(stream, GetS6ExportJobPool());
+}
+
+void S6Exporter::InitialiseHeader(bool isScenario)
 {
     _s6.header.type = isScenario ? S6_TYPE_SCENARIO : S6_TYPE_SAVEDGAME;
     _s6.header.classic_flag = 0;
@@ -89,6 +145,36 @@ void S6Exporter::Save(OpenRCT2::IStream* stream, bool isScenario)
     _s6.header.version = S6_RCT2_VERSION;
     _s6.header.magic_number = S6_MAGIC_NUMBER;
     _s6.game_version_number = 201028;
+}
+
+/**
+ * Reads the objects to pack from the object repository, which must happen on the game thread. Packing them ahead of
+ * saving lets the file be written on another thread.
+ */
+void S6Exporter::PackObjects()
+{
+    if (_packedObjects.has_value())
+        return;
+
+    OpenRCT2::MemoryStream ms;
+    if (!ExportObjectsList.empty())
+    {
+        auto& objRepo = OpenRCT2::GetContext()->GetObjectRepository();
+        objRepo.WritePackedObjects(&ms, ExportObjectsList);
+    }
+    auto data = static_cast<const uint8_t*>(ms.GetData());
+    _packedObjects = std::vector<uint8_t>(data, data + ms.GetLength());
+}
+
+void S6Exporter::WritePackedObjects(OpenRCT2::IStream* stream)
+{
+    PackObjects();
+    stream->Write(_packedObjects->data(), _packedObjects->size());
+}
+
+void S6Exporter::Save(OpenRCT2::IStream* stream, bool isScenario)
+{
+    InitialiseHeader(isScenario);
 
     auto chunkWriter = SawyerChunkWriter(stream);
 
@@ -104,8 +190,7 @@ void S6Exporter::Save(OpenRCT2::IStream* stream, bool isScenario)
     // 2: Write packed objects
     if (_s6.header.num_packed_objects > 0)
     {
-        auto& objRepo = OpenRCT2::GetContext()->GetObjectRepository();
-        objRepo.WritePackedObjects(stream, ExportObjectsList);
+        WritePackedObjects(stream);
     }
 
     // 3: Write available objects chunk
@@ -132,7 +217,8 @@ void S6Exporter::Save(OpenRCT2::IStream* stream, bool isScenario)
     else
     {
         // 6: Everything else...
-        chunkWriter.WriteChunk(&_s6.next_free_tile_element_pointer_index, 0x2E8570, SAWYER_ENCODING::RLECOMPRESSED);
+        chunkWriter.WriteChunk(
+            &_s6.next_free_tile_element_pointer_index, RCT2_S6_PARK_STATE_SIZE, SAWYER_ENCODING::RLECOMPRESSED);
     }
 
     // Determine number of bytes written
@@ -412,7 +498,8 @@ void S6Exporter::Export()
     // rct1_scenario_flags
     _s6.wide_path_tile_loop_x = gWidePathTileLoopX;
     _s6.wide_path_tile_loop_y = gWidePathTileLoopY;
-    // pad_13CE778
+    _s6.pathfinding_budget = gGuestPathfindingBudget;
+    // pad_13CE77A
 
     String::Set(_s6.scenario_filename, sizeof(_s6.scenario_filename), gScenarioFileName);
 
@@ -1557,9 +1644,12 @@ void S6Exporter::ExportMapAnimations()
 
 void S6Exporter::ExportTileElements()
 {
+    // The element list may be smaller than the one in the save, the elements past its end are all zero
+    TileElement emptyElement{};
+    const size_t numElements = map_get_tile_elements_end() - gTileElements;
     for (uint32_t index = 0; index < RCT2_MAX_TILE_ELEMENTS; index++)
     {
-        auto src = &gTileElements[index];
+        auto src = index < numElements ? &gTileElements[index] : &emptyElement;
         auto dst = &_s6.tile_elements[index];
         if (src->base_height == MAX_ELEMENT_HEIGHT)
         {
@@ -1808,12 +1898,12 @@ enum : uint32_t
     S6_SAVE_FLAG_AUTOMATIC = 1u << 31,
 };
 
-/**
- *
- *  rct2: 0x006754F5
- * @param flags bit 0: pack objects, 1: save as scenario
- */
-int32_t scenario_save(const utf8* path, int32_t flags)
+static std::unique_ptr<JobPool> _backgroundSaveJobs;
+// Background saves that have been written or failed, their completion callbacks are run on the game thread
+static std::mutex _completedBackgroundSavesMutex;
+static std::vector<std::pair<std::function<void(bool)>, bool>> _completedBackgroundSaves;
+
+static void scenario_save_prepare(const utf8* path, int32_t flags)
 {
     if (flags & S6_SAVE_FLAG_SCENARIO)
     {
@@ -1831,33 +1921,60 @@ int32_t scenario_save(const utf8* path, int32_t flags)
 
     map_reorganise_elements();
     viewport_set_saved_view();
+}
+
+static std::unique_ptr<S6Exporter> scenario_save_export(int32_t flags)
+{
+    auto s6exporter = std::make_unique<S6Exporter>();
+    if (flags & S6_SAVE_FLAG_EXPORT)
+    {
+        auto& objManager = OpenRCT2::GetContext()->GetObjectManager();
+        s6exporter->ExportObjectsList = objManager.GetPackableObjects();
+        s6exporter->PackObjects();
+    }
+    s6exporter->RemoveTracklessRides = true;
+    s6exporter->Export();
+    return s6exporter;
+}
+
+static void scenario_save_write(S6Exporter& s6exporter, const utf8* path, int32_t flags)
+{
+    if (String::Equals(Path::GetExtension(path), ".park", true))
+    {
+        s6exporter.SaveParkFile(path, (flags & S6_SAVE_FLAG_SCENARIO) != 0);
+    }
+    else if (flags & S6_SAVE_FLAG_SCENARIO)
+    {
+        s6exporter.SaveScenario(path);
+    }
+    else
+    {
+        s6exporter.SaveGame(path);
+    }
+}
+
+/**
+ *
+ *  rct2: 0x006754F5
+ * @param flags bit 0: pack objects, 1: save as scenario
+ */
+int32_t scenario_save(const utf8* path, int32_t flags)
+{
+    // Do not race a background save that may be writing the same file
+    scenario_wait_for_background_saves();
+    scenario_save_prepare(path, flags);
 
     bool result = false;
-    auto s6exporter = new S6Exporter();
     try
     {
-        if (flags & S6_SAVE_FLAG_EXPORT)
-        {
-            auto& objManager = OpenRCT2::GetContext()->GetObjectManager();
-            s6exporter->ExportObjectsList = objManager.GetPackableObjects();
-        }
-        s6exporter->RemoveTracklessRides = true;
-        s6exporter->Export();
-        if (flags & S6_SAVE_FLAG_SCENARIO)
-        {
-            s6exporter->SaveScenario(path);
-        }
-        else
-        {
-            s6exporter->SaveGame(path);
-        }
+        auto s6exporter = scenario_save_export(flags);
+        scenario_save_write(*s6exporter, path, flags);
         result = true;
     }
     catch (const std::exception& e)
     {
         log_error("Unable to save park: '%s'", e.what());
     }
-    delete s6exporter;
 
     gfx_invalidate_screen();
 
@@ -1867,3 +1984,83 @@ int32_t scenario_save(const utf8* path, int32_t flags)
     }
     return result;
 }
+
+/**
+ * Exports the park on the calling thread, which is a copy of the game state into the exporter, and then encodes and
+ * writes it on a worker thread so the game can carry on meanwhile. Objects to pack are read from the object repository
+ * before the copy is handed over.
+ * @param onComplete called on the game thread by scenario_complete_background_saves once the file has been written, or
+ *                   failed to be, with whether it was written. Not called if the park could not be exported.
+ * @returns false if the park could not be exported.
+ */
+bool scenario_save_in_background(const utf8* path, int32_t flags, std::function<void(bool success)> onComplete)
+{
+    scenario_save_prepare(path, flags);
+
+    std::shared_ptr<S6Exporter> s6exporter;
+    try
+    {
+        s6exporter = scenario_save_export(flags);
+    }
+    catch (const std::exception& e)
+    {
+        log_error("Unable to save park: '%s'", e.what());
+        return false;
+    }
+
+    gfx_invalidate_screen();
+
+    if (_backgroundSaveJobs == nullptr)
+    {
+        _backgroundSaveJobs = std::make_unique<JobPool>(1);
+    }
+    _backgroundSaveJobs->AddTask([s6exporter, path = std::string(path), flags, onComplete = std::move(onComplete)]() {
+        bool success = false;
+        try
+        {
+            scenario_save_write(*s6exporter, path.c_str(), flags);
+            log_verbose("Saved to %s", path.c_str());
+            success = true;
+        }
+        catch (const std::exception& e)
+        {
+            log_error("Unable to save park: '%s'", e.what());
+            Console::Error::WriteLine("Could not save '%s'. Is the save folder writeable?", path.c_str());
+        }
+        if (onComplete)
+        {
+            std::lock_guard<std::mutex> lock(_completedBackgroundSavesMutex);
+            _completedBackgroundSaves.emplace_back(onComplete, success);
+        }
+    });
+    return true;
+}
+
+/**
+ * Blocks until all saves started by scenario_save_in_background have been written, and runs their completion callbacks
+ * so they apply to the park they saved rather than to one loaded afterwards.
+ */
+void scenario_wait_for_background_saves()
+{
+    if (_backgroundSaveJobs != nullptr)
+    {
+        _backgroundSaveJobs->Join();
+    }
+    scenario_complete_background_saves();
+}
+
+/**
+ * Runs the completion callbacks of the background saves that have finished since the last call.
+ */
+void scenario_complete_background_saves()
+{
+    std::vector<std::pair<std::function<void(bool)>, bool>> completedSaves;
+    {
+        std::lock_guard<std::mutex> lock(_completedBackgroundSavesMutex);
+        completedSaves.swap(_completedBackgroundSaves);
+    }
+    for (const auto& [onComplete, success] : completedSaves)
+    {
+        onComplete(success);
+    }
+}
@@ -30,7 +30,8 @@ union rct_sprite;
 struct SpriteBase;
 
 /**
- * Class to export RollerCoaster Tycoon 2 scenarios (*.SC6) and saved games (*.SV6).
+ * Class to export RollerCoaster Tycoon 2 scenarios (*.SC6) and saved games (*.SV6), or either as an OpenRCT2 park file
+ * (*.PARK).
  */
 class S6Exporter final
 {
@@ -44,7 +45,10 @@ public:
     void SaveGame(OpenRCT2::IStream* stream);
     void SaveScenario(const utf8* path);
     void SaveScenario(OpenRCT2::IStream* stream);
+    void SaveParkFile(const utf8* path, bool isScenario);
+    void SaveParkFile(OpenRCT2::IStream* stream, bool isScenario);
     void Export();
+    void PackObjects();
     void ExportParkName();
     void ExportRides();
     void ExportRide(rct2_ride* dst, const Ride* src);
@@ -56,7 +60,10 @@ public:
 private:
     rct_s6_data _s6{};
     std::vector<std::string> _userStrings;
+    std::optional<std::vector<uint8_t>> _packedObjects;
 
+    void InitialiseHeader(bool isScenario);
+    void WritePackedObjects(OpenRCT2::IStream* stream);
     void Save(OpenRCT2::IStream* stream, bool isScenario);
     static uint32_t GetLoanHash(money32 initialCash, money32 bankLoan, uint32_t maxBankLoan);
     void ExportResearchedRideTypes();
@@ -9,14 +9,18 @@
 
 #include "../Context.h"
 #include "../Diagnostic.h"
+#include "../FileClassifier.h"
 #include "../Game.h"
 #include "../GameState.h"
 #include "../OpenRCT2.h"
+#include "../ParkFile.h"
 #include "../ParkImporter.h"
 #include "../config/Config.h"
 #include "../core/Console.hpp"
-#include "../core/FileStream.h"
 #include "../core/IStream.hpp"
+#include "../core/JobPool.h"
+#include "../core/MemoryMappedFileStream.h"
+#include "../core/MemoryStream.h"
 #include "../core/Path.hpp"
 #include "../core/Random.hpp"
 #include "../core/String.hpp"
@@ -32,6 +36,7 @@
 #include "../object/ObjectLimits.h"
 #include "../object/ObjectManager.h"
 #include "../object/ObjectRepository.h"
+#include "../peep/GuestPathfinding.h"
 #include "../peep/Staff.h"
 #include "../rct12/RCT12.h"
 #include "../rct12/SawyerChunkReader.h"
@@ -57,6 +62,20 @@
 #include "../world/Surface.h"
 
 #include <algorithm>
+#include <array>
+#include <atomic>
+
+// Shared by all imports so loading a park does not have to start its own threads
+static std::unique_ptr<JobPool> _s6ImportJobs;
+
+static JobPool& GetS6ImportJobPool()
+{
+    if (_s6ImportJobs == nullptr)
+    {
+        _s6ImportJobs = std::make_unique<JobPool>();
+    }
+    return *_s6ImportJobs;
+}
 
 /**
  * Class to import RollerCoaster Tycoon 2 scenarios (*.SC6) and saved games (*.SV6).
@@ -71,6 +90,9 @@ private:
     uint8_t _gameVersion = 0;
     bool _isSV7 = false;
 
+    // Banners referenced by the tile elements, which are imported once all tile elements have been
+    std::array<std::atomic<bool>, RCT2_MAX_BANNERS_IN_PARK> _bannersToImport{};
+
 public:
     S6Importer(IObjectRepository& objectRepository)
         : _objectRepository(objectRepository)
@@ -88,6 +110,18 @@ public:
         {
             return LoadSavedGame(path);
         }
+        else if (String::Equals(extension, ".park", true))
+        {
+            auto fs = OpenRCT2::MemoryMappedFileStream(path);
+            auto type = ClassifyParkFile(&fs);
+            if (type == FILE_TYPE::UNDEFINED)
+            {
+                throw std::runtime_error("Invalid park file.");
+            }
+            auto result = LoadFromStream(&fs, type == FILE_TYPE::SCENARIO, false, path);
+            _s6Path = path;
+            return result;
+        }
         else
         {
             throw std::runtime_error("Invalid RCT2 park extension.");
@@ -96,7 +130,7 @@ public:
 
     ParkLoadResult LoadSavedGame(const utf8* path, bool skipObjectCheck = false) override
     {
-        auto fs = OpenRCT2::FileStream(path, OpenRCT2::FILE_MODE_OPEN);
+        auto fs = OpenRCT2::MemoryMappedFileStream(path);
         auto result = LoadFromStream(&fs, false, skipObjectCheck);
         _s6Path = path;
         return result;
@@ -104,7 +138,7 @@ public:
 
     ParkLoadResult LoadScenario(const utf8* path, bool skipObjectCheck = false) override
     {
-        auto fs = OpenRCT2::FileStream(path, OpenRCT2::FILE_MODE_OPEN);
+        auto fs = OpenRCT2::MemoryMappedFileStream(path);
         auto result = LoadFromStream(&fs, true, skipObjectCheck);
         _s6Path = path;
         return result;
@@ -114,6 +148,11 @@ public:
         OpenRCT2::IStream* stream, bool isScenario, [[maybe_unused]] bool skipObjectCheck = false,
         const utf8* path = String::Empty) override
     {
+        if (ParkFileReader::IsParkFile(stream))
+        {
+            return LoadFromParkFile(stream, isScenario, path);
+        }
+
         if (isScenario && !gConfigGeneral.allow_loading_with_incorrect_checksum && !SawyerEncoding::ValidateChecksum(stream))
         {
             throw IOException("Invalid checksum.");
@@ -157,26 +196,37 @@ public:
             _isSV7 = _stricmp(extension, ".sv7") == 0;
         }
 
+        // The remaining chunks do not depend on each other, the tile elements and the rest of the park are decoded at the
+        // same time
+        auto& jobPool = GetS6ImportJobPool();
         if (isScenario)
         {
-            chunkReader.ReadChunk(&_s6.objects, sizeof(_s6.objects));
-            chunkReader.ReadChunk(&_s6.elapsed_months, 16);
-            chunkReader.ReadChunk(&_s6.tile_elements, sizeof(_s6.tile_elements));
-            chunkReader.ReadChunk(&_s6.next_free_tile_element_pointer_index, 2560076);
-            chunkReader.ReadChunk(&_s6.guests_in_park, 4);
-            chunkReader.ReadChunk(&_s6.last_guests_in_park, 8);
-            chunkReader.ReadChunk(&_s6.park_rating, 2);
-            chunkReader.ReadChunk(&_s6.active_research_types, 1082);
-            chunkReader.ReadChunk(&_s6.current_expenditure, 16);
-            chunkReader.ReadChunk(&_s6.park_value, 4);
-            chunkReader.ReadChunk(&_s6.completed_company_value, 483816);
+            chunkReader.ReadChunks(
+                jobPool,
+                {
+                    { &_s6.objects, sizeof(_s6.objects) },
+                    { &_s6.elapsed_months, 16 },
+                    { &_s6.tile_elements, sizeof(_s6.tile_elements) },
+                    { &_s6.next_free_tile_element_pointer_index, 2560076 },
+                    { &_s6.guests_in_park, 4 },
+                    { &_s6.last_guests_in_park, 8 },
+                    { &_s6.park_rating, 2 },
+                    { &_s6.active_research_types, 1082 },
+                    { &_s6.current_expenditure, 16 },
+                    { &_s6.park_value, 4 },
+                    { &_s6.completed_company_value, 483816 },
+                });
         }
         else
         {
-            chunkReader.ReadChunk(&_s6.objects, sizeof(_s6.objects));
-            chunkReader.ReadChunk(&_s6.elapsed_months, 16);
-            chunkReader.ReadChunk(&_s6.tile_elements, sizeof(_s6.tile_elements));
-            chunkReader.ReadChunk(&_s6.next_free_tile_element_pointer_index, 3048816);
+            chunkReader.ReadChunks(
+                jobPool,
+                {
+                    { &_s6.objects, sizeof(_s6.objects) },
+                    { &_s6.elapsed_months, 16 },
+                    { &_s6.tile_elements, sizeof(_s6.tile_elements) },
+                    { &_s6.next_free_tile_element_pointer_index, RCT2_S6_PARK_STATE_SIZE },
+                });
         }
 
         _s6Path = path;
@@ -184,6 +234,47 @@ public:
         return ParkLoadResult(GetRequiredObjects());
     }
 
+    ParkLoadResult LoadFromParkFile(OpenRCT2::IStream* stream, bool isScenario, const utf8* path)
+    {
+        // There is no file checksum, zlib verifies the checksum of every compressed chunk as it is decoded
+        auto reader = ParkFileReader(stream);
+        reader.ReadChunk(ParkFileChunkType::Header, &_s6.header, sizeof(_s6.header));
+        if (isScenario && _s6.header.type != S6_TYPE_SCENARIO)
+        {
+            throw std::runtime_error("Park is not a scenario.");
+        }
+        if (!isScenario && _s6.header.type != S6_TYPE_SAVEDGAME)
+        {
+            throw std::runtime_error("Park is not a saved game.");
+        }
+
+        if (_s6.header.num_packed_objects > 0)
+        {
+            auto packedObjects = reader.ReadChunk(ParkFileChunkType::PackedObjects);
+            auto packedObjectsStream = OpenRCT2::MemoryStream(packedObjects.data(), packedObjects.size());
+            for (uint16_t i = 0; i < _s6.header.num_packed_objects; i++)
+            {
+                _objectRepository.ExportPackedObject(&packedObjectsStream);
+            }
+        }
+
+        // Saved games have no info chunk, it is left zeroed like it is for SV6 files
+        reader.ReadChunks(
+            GetS6ImportJobPool(),
+            {
+                { ParkFileChunkType::Info, &_s6.info, sizeof(_s6.info) },
+                { ParkFileChunkType::Objects, &_s6.objects, sizeof(_s6.objects) },
+                { ParkFileChunkType::General, &_s6.elapsed_months, 16 },
+                { ParkFileChunkType::TileElements, &_s6.tile_elements, sizeof(_s6.tile_elements) },
+                { ParkFileChunkType::ParkState, &_s6.next_free_tile_element_pointer_index, RCT2_S6_PARK_STATE_SIZE },
+            });
+
+        _isSV7 = false;
+        _s6Path = path;
+
+        return ParkLoadResult(GetRequiredObjects());
+    }
+
     bool GetDetails(scenario_index_entry* dst) override
     {
         *dst = {};
@@ -451,7 +542,8 @@ public:
         // rct1_scenario_flags
         gWidePathTileLoopX = _s6.wide_path_tile_loop_x;
         gWidePathTileLoopY = _s6.wide_path_tile_loop_y;
-        // pad_13CE778
+        gGuestPathfindingBudget = _s6.pathfinding_budget;
+        // pad_13CE77A
 
         // Fix and set dynamic variables
         map_strip_ghost_flag_from_elements();
@@ -459,6 +551,7 @@ public:
         game_convert_strings_to_utf8();
         map_count_remaining_land_rights();
         determine_ride_entrance_and_exit_locations();
+        ride_queues_rebuild();
 
         auto& park = OpenRCT2::GetContext()->GetGameState()->GetPark();
         park.Name = GetUserString(_s6.park_name);
@@ -1030,49 +1123,39 @@ public:
         // Build tile pointer cache (needed to get the first element at a certain location)
         auto tilePointerIndex = TilePointerIndex<RCT12TileElement>(RCT2_MAXIMUM_MAP_SIZE_TECHNICAL, _s6.tile_elements);
 
-        TileElement* dstElement = gTileElements;
+        // The rows are imported in parallel, which needs to know where each of them starts in the destination first
+        std::vector<size_t> rowOffsets(MAXIMUM_MAP_SIZE_TECHNICAL);
+        size_t numElements = 0;
         for (TileCoordsXY coords = { 0, 0 }; coords.y < MAXIMUM_MAP_SIZE_TECHNICAL; coords.y++)
         {
+            rowOffsets[coords.y] = numElements;
             for (coords.x = 0; coords.x < MAXIMUM_MAP_SIZE_TECHNICAL; coords.x++)
             {
-                if (coords.x >= RCT2_MAXIMUM_MAP_SIZE_TECHNICAL || coords.y >= RCT2_MAXIMUM_MAP_SIZE_TECHNICAL)
-                {
-                    dstElement->ClearAs(TILE_ELEMENT_TYPE_SURFACE);
-                    dstElement->SetLastForTile(true);
-                    dstElement++;
-                    continue;
-                }
+                numElements += CountTileElementsToImport(tilePointerIndex, coords);
+            }
+        }
+        map_reserve_tile_elements(numElements + (MAX_TILE_ELEMENTS_WITH_SPARE_ROOM - MAX_TILE_ELEMENTS));
 
-                RCT12TileElement* srcElement = tilePointerIndex.GetFirstElementAt(coords);
-                // This might happen with damaged parks. Make sure there is *something* to avoid crashes.
-                if (srcElement == nullptr)
-                {
-                    dstElement->ClearAs(TILE_ELEMENT_TYPE_SURFACE);
-                    dstElement->SetLastForTile(true);
-                    dstElement++;
-                    continue;
-                }
+        std::vector<TileElement*> rowStarts(MAXIMUM_MAP_SIZE_TECHNICAL);
+        for (size_t y = 0; y < rowStarts.size(); y++)
+        {
+            rowStarts[y] = gTileElements + rowOffsets[y];
+        }
 
-                do
-                {
-                    if (srcElement->base_height == RCT12_MAX_ELEMENT_HEIGHT)
-                    {
-                        std::memcpy(dstElement, srcElement, sizeof(*srcElement));
-                    }
-                    else
-                    {
-                        auto tileElementType = static_cast<RCT12TileElementType>(srcElement->GetType());
-                        // Todo: replace with setting invisibility bit
-                        if (tileElementType == RCT12TileElementType::Corrupt
-                            || tileElementType == RCT12TileElementType::EightCarsCorrupt14
-                            || tileElementType == RCT12TileElementType::EightCarsCorrupt15)
-                            std::memcpy(dstElement, srcElement, sizeof(*srcElement));
-                        else
-                            ImportTileElement(dstElement, srcElement);
-                    }
+        for (auto& bannerToImport : _bannersToImport)
+        {
+            bannerToImport.store(false, std::memory_order_relaxed);
+        }
+        GetS6ImportJobPool().ParallelFor(0, MAXIMUM_MAP_SIZE_TECHNICAL, 8, [this, &tilePointerIndex, &rowStarts](size_t y) {
+            ImportTileElementRow(tilePointerIndex, static_cast<int32_t>(y), rowStarts[y]);
+        });
 
-                    dstElement++;
-                } while (!(srcElement++)->IsLastForTile());
+        // Banners can be referenced by several elements in different rows, they are imported here to not race
+        for (size_t i = 0; i < _bannersToImport.size(); i++)
+        {
+            if (_bannersToImport[i].load(std::memory_order_relaxed))
+            {
+                ImportBanner(GetBanner(static_cast<BannerIndex>(i)), &_s6.banners[i]);
             }
         }
 
@@ -1081,6 +1164,70 @@ public:
         map_update_tile_pointers();
     }
 
+    static size_t CountTileElementsToImport(TilePointerIndex<RCT12TileElement>& tilePointerIndex, const TileCoordsXY& coords)
+    {
+        if (coords.x >= RCT2_MAXIMUM_MAP_SIZE_TECHNICAL || coords.y >= RCT2_MAXIMUM_MAP_SIZE_TECHNICAL)
+        {
+            return 1;
+        }
+        const RCT12TileElement* srcElement = tilePointerIndex.GetFirstElementAt(coords);
+        if (srcElement == nullptr)
+        {
+            return 1;
+        }
+        size_t count = 1;
+        while (!(srcElement++)->IsLastForTile())
+        {
+            count++;
+        }
+        return count;
+    }
+
+    void ImportTileElementRow(TilePointerIndex<RCT12TileElement>& tilePointerIndex, int32_t y, TileElement* dstElement)
+    {
+        for (TileCoordsXY coords = { 0, y }; coords.x < MAXIMUM_MAP_SIZE_TECHNICAL; coords.x++)
+        {
+            if (coords.x >= RCT2_MAXIMUM_MAP_SIZE_TECHNICAL || coords.y >= RCT2_MAXIMUM_MAP_SIZE_TECHNICAL)
+            {
+                dstElement->ClearAs(TILE_ELEMENT_TYPE_SURFACE);
+                dstElement->SetLastForTile(true);
+                dstElement++;
+                continue;
+            }
+
+            RCT12TileElement* srcElement = tilePointerIndex.GetFirstElementAt(coords);
+            // This might happen with damaged parks. Make sure there is *something* to avoid crashes.
+            if (srcElement == nullptr)
+            {
+                dstElement->ClearAs(TILE_ELEMENT_TYPE_SURFACE);
+                dstElement->SetLastForTile(true);
+                dstElement++;
+                continue;
+            }
+
+            do
+            {
+                if (srcElement->base_height == RCT12_MAX_ELEMENT_HEIGHT)
+                {
+                    std::memcpy(dstElement, srcElement, sizeof(*srcElement));
+                }
+                else
+                {
+                    auto tileElementType = static_cast<RCT12TileElementType>(srcElement->GetType());
+                    // Todo: replace with setting invisibility bit
+                    if (tileElementType == RCT12TileElementType::Corrupt
+                        || tileElementType == RCT12TileElementType::EightCarsCorrupt14
+                        || tileElementType == RCT12TileElementType::EightCarsCorrupt15)
+                        std::memcpy(dstElement, srcElement, sizeof(*srcElement));
+                    else
+                        ImportTileElement(dstElement, srcElement);
+                }
+
+                dstElement++;
+            } while (!(srcElement++)->IsLastForTile());
+        }
+    }
+
     void ImportTileElement(TileElement* dst, const RCT12TileElement* src)
     {
         // Todo: allow for changing definition of OpenRCT2 tile element types - replace with a map
@@ -1234,9 +1381,7 @@ public:
                     auto bannerIndex = src2->GetBannerIndex();
                     if (bannerIndex < std::size(_s6.banners))
                     {
-                        auto srcBanner = &_s6.banners[bannerIndex];
-                        auto dstBanner = GetBanner(bannerIndex);
-                        ImportBanner(dstBanner, srcBanner);
+                        _bannersToImport[bannerIndex].store(true, std::memory_order_relaxed);
                         dst2->SetBannerIndex(src2->GetBannerIndex());
                     }
                 }
@@ -1260,9 +1405,7 @@ public:
                     auto bannerIndex = src2->GetBannerIndex();
                     if (bannerIndex < std::size(_s6.banners))
                     {
-                        auto srcBanner = &_s6.banners[bannerIndex];
-                        auto dstBanner = GetBanner(bannerIndex);
-                        ImportBanner(dstBanner, srcBanner);
+                        _bannersToImport[bannerIndex].store(true, std::memory_order_relaxed);
                         dst2->SetBannerIndex(src2->GetBannerIndex());
                     }
                 }
@@ -1280,9 +1423,7 @@ public:
                 auto bannerIndex = src2->GetIndex();
                 if (bannerIndex < std::size(_s6.banners))
                 {
-                    auto srcBanner = &_s6.banners[bannerIndex];
-                    auto dstBanner = GetBanner(bannerIndex);
-                    ImportBanner(dstBanner, srcBanner);
+                    _bannersToImport[bannerIndex].store(true, std::memory_order_relaxed);
                 }
                 else
                 {
@@ -1323,12 +1464,12 @@ public:
 
     void ImportSprites()
     {
-        for (int32_t i = 0; i < RCT2_MAX_SPRITES; i++)
-        {
+        // Every sprite is converted into its own slot from the saved data only
+        GetS6ImportJobPool().ParallelFor(0, RCT2_MAX_SPRITES, 256, [this](size_t i) {
             auto src = &_s6.sprites[i];
             auto dst = GetEntity(i);
             ImportSprite(reinterpret_cast<rct_sprite*>(dst), src);
-        }
+        });
         RebuildEntityLists();
     }
 
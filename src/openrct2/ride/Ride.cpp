@@ -67,12 +67,15 @@
 #include "Vehicle.h"
 
 #include <algorithm>
+#include <array>
 #include <cassert>
 #include <climits>
 #include <cstdlib>
 #include <iterator>
 #include <limits>
+#include <mutex>
 #include <optional>
+#include <unordered_map>
 
 using namespace OpenRCT2;
 
@@ -87,6 +90,13 @@ static constexpr const int32_t RideInspectionInterval[] = {
 
 static std::vector<Ride> _rides;
 
+// The rides that have a measurement, so the rides without one cost nothing each tick. The list is found again from the
+// rides the first time it is needed after they are reset, which every park load does before giving rides their
+// measurements. Rides whose measurement was freed elsewhere, such as when the ride is demolished, are dropped the next
+// time the list is walked.
+static std::vector<ride_id_t> _measuredRides;
+static bool _measuredRidesFound = false;
+
 bool gGotoStartPlacementMode = false;
 
 money16 gTotalRideValueForMoney;
@@ -309,30 +319,41 @@ int32_t Ride::GetMaxQueueTime() const
     return static_cast<int32_t>(queueTime);
 }
 
+/*
+ * A queue is a list of guests linked through GuestNextInQueue from the back (LastPeepInQueue) to the front, which is
+ * what gets saved. The front of the queue and the links from the front to the back are kept alongside so guests can
+ * join at either end and leave from anywhere without walking the queue. The extra links only mirror the saved ones, so
+ * any change to the queue goes through the functions below.
+ */
+
 Peep* Ride::GetQueueHeadGuest(StationIndex stationIndex) const
 {
-    Peep* peep;
-    Peep* result = nullptr;
-    uint16_t spriteIndex = stations[stationIndex].LastPeepInQueue;
-    while ((peep = try_get_guest(spriteIndex)) != nullptr)
-    {
-        spriteIndex = peep->GuestNextInQueue;
-        result = peep;
-    }
-    return result;
+    return try_get_guest(stations[stationIndex].FirstPeepInQueue);
 }
 
-void Ride::UpdateQueueLength(StationIndex stationIndex)
+void Ride::QueueInsertGuestAtBack(StationIndex stationIndex, Peep* peep)
 {
-    uint16_t count = 0;
-    Peep* peep;
-    uint16_t spriteIndex = stations[stationIndex].LastPeepInQueue;
-    while ((peep = try_get_guest(spriteIndex)) != nullptr)
+    assert(stationIndex < MAX_STATIONS);
+    assert(peep != nullptr);
+
+    auto& station = stations[stationIndex];
+    Peep* lastGuest = try_get_guest(station.LastPeepInQueue);
+    if (lastGuest == nullptr)
     {
-        spriteIndex = peep->GuestNextInQueue;
-        count++;
+        station.FirstPeepInQueue = peep->sprite_index;
+    }
+    else
+    {
+        lastGuest->GuestPreviousInQueue = peep->sprite_index;
     }
-    stations[stationIndex].QueueLength = count;
+    peep->GuestNextInQueue = station.LastPeepInQueue;
+    peep->GuestPreviousInQueue = SPRITE_INDEX_NULL;
+    station.LastPeepInQueue = peep->sprite_index;
+    station.QueueLength++;
+
+#if defined(DEBUG_LEVEL_2) && DEBUG_LEVEL_2
+    QueueValidate(stationIndex);
+#endif
 }
 
 void Ride::QueueInsertGuestAtFront(StationIndex stationIndex, Peep* peep)
@@ -340,38 +361,236 @@ void Ride::QueueInsertGuestAtFront(StationIndex stationIndex, Peep* peep)
     assert(stationIndex < MAX_STATIONS);
     assert(peep != nullptr);
 
-    peep->GuestNextInQueue = SPRITE_INDEX_NULL;
-    Peep* queueHeadGuest = GetQueueHeadGuest(peep->CurrentRideStation);
+    auto& station = stations[stationIndex];
+    Peep* queueHeadGuest = GetQueueHeadGuest(stationIndex);
     if (queueHeadGuest == nullptr)
     {
-        stations[peep->CurrentRideStation].LastPeepInQueue = peep->sprite_index;
+        station.LastPeepInQueue = peep->sprite_index;
+        peep->GuestPreviousInQueue = SPRITE_INDEX_NULL;
     }
     else
     {
         queueHeadGuest->GuestNextInQueue = peep->sprite_index;
+        peep->GuestPreviousInQueue = queueHeadGuest->sprite_index;
+    }
+    peep->GuestNextInQueue = SPRITE_INDEX_NULL;
+    station.FirstPeepInQueue = peep->sprite_index;
+    station.QueueLength++;
+
+#if defined(DEBUG_LEVEL_2) && DEBUG_LEVEL_2
+    QueueValidate(stationIndex);
+#endif
+}
+
+void Ride::QueueRemoveGuest(StationIndex stationIndex, Peep* peep)
+{
+    assert(stationIndex < MAX_STATIONS);
+    assert(peep != nullptr);
+
+    auto& station = stations[stationIndex];
+    // Make sure we don't underflow, building while paused might reset it to 0 where peeps have
+    // not yet left the queue.
+    if (station.QueueLength > 0)
+    {
+        station.QueueLength--;
+    }
+
+    Peep* guestBehind = nullptr;
+    if (peep->sprite_index == station.LastPeepInQueue)
+    {
+        station.LastPeepInQueue = peep->GuestNextInQueue;
+    }
+    else
+    {
+        guestBehind = try_get_guest(peep->GuestPreviousInQueue);
+        if (guestBehind == nullptr || guestBehind->GuestNextInQueue != peep->sprite_index)
+        {
+            // Guests that are no longer in the queue, for example after its entrance was rebuilt, have no guest
+            // behind them. Only they walk the queue, to keep the saved links the same as when it was always walked.
+            guestBehind = nullptr;
+            auto* otherGuest = try_get_guest(station.LastPeepInQueue);
+            if (otherGuest == nullptr)
+            {
+                log_error("Invalid Guest Queue list!");
+                return;
+            }
+            for (; otherGuest != nullptr; otherGuest = try_get_guest(otherGuest->GuestNextInQueue))
+            {
+                if (peep->sprite_index == otherGuest->GuestNextInQueue)
+                {
+                    guestBehind = otherGuest;
+                    break;
+                }
+            }
+            if (guestBehind == nullptr)
+                return;
+        }
+        guestBehind->GuestNextInQueue = peep->GuestNextInQueue;
+    }
+
+    uint16_t guestBehindIndex = guestBehind != nullptr ? guestBehind->sprite_index : SPRITE_INDEX_NULL;
+    Peep* guestAhead = try_get_guest(peep->GuestNextInQueue);
+    if (guestAhead != nullptr && guestAhead->GuestPreviousInQueue == peep->sprite_index)
+    {
+        guestAhead->GuestPreviousInQueue = guestBehindIndex;
+    }
+    if (station.FirstPeepInQueue == peep->sprite_index)
+    {
+        station.FirstPeepInQueue = guestBehindIndex;
+    }
+    peep->GuestPreviousInQueue = SPRITE_INDEX_NULL;
+
+#if defined(DEBUG_LEVEL_2) && DEBUG_LEVEL_2
+    QueueValidate(stationIndex);
+#endif
+}
+
+/**
+ * Empties the queue without touching its guests, they find out they are no longer in it when they try to leave.
+ */
+void Ride::QueueClear(StationIndex stationIndex)
+{
+    auto& station = stations[stationIndex];
+    Peep* guest = try_get_guest(station.LastPeepInQueue);
+    for (size_t i = 0; guest != nullptr && i < MAX_ENTITIES; i++)
+    {
+        guest->GuestPreviousInQueue = SPRITE_INDEX_NULL;
+        guest = try_get_guest(guest->GuestNextInQueue);
+    }
+    station.LastPeepInQueue = SPRITE_INDEX_NULL;
+    station.FirstPeepInQueue = SPRITE_INDEX_NULL;
+    station.QueueLength = 0;
+}
+
+/**
+ * Recreates the front of the queue and the links towards the back from the saved links. The queue length is saved,
+ * so it is left as it is to stay in sync with the server.
+ */
+void Ride::QueueRebuild(StationIndex stationIndex)
+{
+    auto& station = stations[stationIndex];
+    station.FirstPeepInQueue = SPRITE_INDEX_NULL;
+
+    // Broken saves can have loops in the queue, a queue can never hold more guests than there are entities
+    uint16_t guestBehindIndex = SPRITE_INDEX_NULL;
+    Peep* guest = try_get_guest(station.LastPeepInQueue);
+    for (size_t i = 0; guest != nullptr && i < MAX_ENTITIES; i++)
+    {
+        guest->GuestPreviousInQueue = guestBehindIndex;
+        station.FirstPeepInQueue = guest->sprite_index;
+        guestBehindIndex = guest->sprite_index;
+        guest = try_get_guest(guest->GuestNextInQueue);
+    }
+}
+
+/**
+ * Walks the queue and checks that the front of the queue, the links towards the back and the queue length agree with
+ * the saved links. Logs every mismatch and returns whether there were none.
+ */
+bool Ride::QueueValidate(StationIndex stationIndex) const
+{
+    const auto& station = stations[stationIndex];
+    bool valid = true;
+    uint16_t count = 0;
+    uint16_t guestBehindIndex = SPRITE_INDEX_NULL;
+    uint16_t firstIndex = SPRITE_INDEX_NULL;
+    Peep* guest = try_get_guest(station.LastPeepInQueue);
+    for (; guest != nullptr && count < MAX_ENTITIES; guest = try_get_guest(guest->GuestNextInQueue))
+    {
+        if (guest->GuestPreviousInQueue != guestBehindIndex)
+        {
+            log_error(
+                "Ride %u station %u: guest %u is behind guest %u but linked to %u.", id, stationIndex,
+                guestBehindIndex, guest->sprite_index, guest->GuestPreviousInQueue);
+            valid = false;
+        }
+        guestBehindIndex = guest->sprite_index;
+        firstIndex = guest->sprite_index;
+        count++;
+    }
+    if (station.FirstPeepInQueue != firstIndex)
+    {
+        log_error(
+            "Ride %u station %u: guest %u is at the front but %u is recorded.", id, stationIndex, firstIndex,
+            station.FirstPeepInQueue);
+        valid = false;
+    }
+    if (station.QueueLength != count)
+    {
+        log_error(
+            "Ride %u station %u: %u guests are queueing but the length is %u.", id, stationIndex, count,
+            station.QueueLength);
+        valid = false;
+    }
+    return valid;
+}
+
+void ride_queues_rebuild()
+{
+    for (auto guest : EntityList<Guest>())
+    {
+        guest->GuestPreviousInQueue = SPRITE_INDEX_NULL;
+    }
+    for (auto& ride : GetRideManager())
+    {
+        for (StationIndex stationIndex = 0; stationIndex < MAX_STATIONS; stationIndex++)
+        {
+            ride.QueueRebuild(stationIndex);
+        }
     }
-    UpdateQueueLength(peep->CurrentRideStation);
 }
 
 /**
  *
  *  rct2: 0x006AC916
  */
-void ride_update_favourited_stat()
+// The number of guests that have each ride as their favourite, kept up to date as guests change their favourite so the
+// weekly update does not have to scan every guest. Only rebuilt from the guests after the entities have been replaced.
+static std::array<uint16_t, MAX_RIDES> _rideFavouriteCounts;
+static bool _rideFavouriteCountsValid = false;
+
+void ride_favourite_counts_invalidate()
 {
-    for (auto& ride : GetRideManager())
-        ride.guests_favourite = 0;
+    _rideFavouriteCountsValid = false;
+}
+
+void ride_guest_favourite_changed(ride_id_t previousRide, ride_id_t newRide)
+{
+    if (!_rideFavouriteCountsValid)
+        return;
 
+    if (previousRide < MAX_RIDES)
+        _rideFavouriteCounts[previousRide]--;
+    if (newRide < MAX_RIDES)
+        _rideFavouriteCounts[newRide]++;
+}
+
+static void ride_favourite_counts_rebuild()
+{
+    _rideFavouriteCounts.fill(0);
     for (auto peep : EntityList<Guest>())
     {
-        if (peep->FavouriteRide != RIDE_ID_NULL)
+        if (peep->FavouriteRide < MAX_RIDES)
         {
-            auto ride = get_ride(peep->FavouriteRide);
-            if (ride != nullptr)
-            {
-                ride->guests_favourite++;
-                ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_CUSTOMER;
-            }
+            _rideFavouriteCounts[peep->FavouriteRide]++;
+        }
+    }
+    _rideFavouriteCountsValid = true;
+}
+
+void ride_update_favourited_stat()
+{
+    if (!_rideFavouriteCountsValid)
+    {
+        ride_favourite_counts_rebuild();
+    }
+
+    for (auto& ride : GetRideManager())
+    {
+        ride.guests_favourite = ride.id < MAX_RIDES ? _rideFavouriteCounts[ride.id] : 0;
+        if (ride.guests_favourite != 0)
+        {
+            ride.window_invalidate_flags |= RIDE_INVALIDATE_RIDE_CUSTOMER;
         }
     }
 
@@ -554,6 +773,105 @@ bool track_block_get_next_from_zero(
     return false;
 }
 
+// The links between track pieces found by track_block_get_next and track_block_get_previous, keyed by the element they
+// were looked up from. Links are not stored per ride as the elements of a tile move when elements are inserted or
+// removed, so any change to the tile elements drops all of them.
+enum class TrackLinkResult : uint8_t
+{
+    Found,
+    NotFound,
+    NoTile,
+};
+
+struct TrackLinkCacheEntry
+{
+    int32_t X;
+    int32_t Y;
+    TrackLinkResult Result;
+    CoordsXYE Output;
+    int32_t Z;
+    int32_t Direction;
+};
+
+struct TrackLinkPreviousCacheEntry
+{
+    int32_t X;
+    int32_t Y;
+    TrackLinkResult Result;
+    track_begin_end Output;
+};
+
+static constexpr size_t TRACK_LINK_CACHE_MAX_SIZE = 1 << 16;
+static std::unordered_map<const TileElement*, TrackLinkCacheEntry> _trackLinkNextCache;
+static std::unordered_map<const TileElement*, TrackLinkPreviousCacheEntry> _trackLinkPreviousCache;
+// Ride ratings can be calculated on worker threads
+static std::mutex _trackLinkCacheMutex;
+
+void track_block_links_invalidate()
+{
+    std::lock_guard<std::mutex> lock(_trackLinkCacheMutex);
+    _trackLinkNextCache.clear();
+    _trackLinkPreviousCache.clear();
+}
+
+template<typename TEntry>
+static void track_links_cache_insert(
+    std::unordered_map<const TileElement*, TEntry>& cache, const TileElement* key, const TEntry& entry)
+{
+    std::lock_guard<std::mutex> lock(_trackLinkCacheMutex);
+    if (cache.size() >= TRACK_LINK_CACHE_MAX_SIZE)
+        cache.clear();
+    cache[key] = entry;
+}
+
+/**
+ * Writes a cached result of track_block_get_next_from_zero, only writing the outputs the lookup itself would write.
+ */
+static bool track_links_apply_next(const TrackLinkCacheEntry& entry, CoordsXYE* output, int32_t* z, int32_t* direction)
+{
+    if (entry.Result == TrackLinkResult::NoTile)
+    {
+        output->element = nullptr;
+        output->x = LOCATION_NULL;
+        return false;
+    }
+    if (z != nullptr)
+        *z = entry.Z;
+    if (direction != nullptr)
+        *direction = entry.Direction;
+    *output = entry.Output;
+    return entry.Result == TrackLinkResult::Found;
+}
+
+/**
+ * Writes a cached result of track_block_get_previous_from_zero, only writing the outputs the lookup itself would write.
+ */
+static bool track_links_apply_previous(const TrackLinkPreviousCacheEntry& entry, track_begin_end* outTrackBeginEnd)
+{
+    const auto& src = entry.Output;
+    outTrackBeginEnd->end_x = src.end_x;
+    outTrackBeginEnd->end_y = src.end_y;
+    outTrackBeginEnd->begin_element = src.begin_element;
+    switch (entry.Result)
+    {
+        case TrackLinkResult::Found:
+            outTrackBeginEnd->begin_x = src.begin_x;
+            outTrackBeginEnd->begin_y = src.begin_y;
+            outTrackBeginEnd->begin_z = src.begin_z;
+            outTrackBeginEnd->begin_direction = src.begin_direction;
+            outTrackBeginEnd->end_direction = src.end_direction;
+            return true;
+        case TrackLinkResult::NotFound:
+            outTrackBeginEnd->begin_z = src.begin_z;
+            outTrackBeginEnd->end_direction = src.end_direction;
+            return false;
+        case TrackLinkResult::NoTile:
+            outTrackBeginEnd->begin_direction = src.begin_direction;
+            return false;
+    }
+    return false;
+}
+
 /**
  *
  *  rct2: 0x006C60C2
@@ -598,7 +916,28 @@ bool track_block_get_next(CoordsXYE* input, CoordsXYE* output, int32_t* z, int32
     uint8_t directionStart = ((trackCoordinate.rotation_end + rotation) & TILE_ELEMENT_DIRECTION_MASK)
         | (trackCoordinate.rotation_end & TRACK_BLOCK_2);
 
-    return track_block_get_next_from_zero({ coords, OriginZ }, ride, directionStart, output, z, direction, false);
+    // The output may be the input
+    const TileElement* key = input->element;
+    {
+        std::lock_guard<std::mutex> lock(_trackLinkCacheMutex);
+        auto it = _trackLinkNextCache.find(key);
+        if (it != _trackLinkNextCache.end() && it->second.X == x && it->second.Y == y)
+        {
+            return track_links_apply_next(it->second, output, z, direction);
+        }
+    }
+
+    TrackLinkCacheEntry entry{};
+    entry.X = x;
+    entry.Y = y;
+    auto result = track_block_get_next_from_zero(
+        { coords, OriginZ }, ride, directionStart, &entry.Output, &entry.Z, &entry.Direction, false);
+    if (result)
+        entry.Result = TrackLinkResult::Found;
+    else
+        entry.Result = entry.Output.element == nullptr ? TrackLinkResult::NoTile : TrackLinkResult::NotFound;
+    track_links_cache_insert(_trackLinkNextCache, key, entry);
+    return track_links_apply_next(entry, output, z, direction);
 }
 
 /**
@@ -737,7 +1076,30 @@ bool track_block_get_previous(const CoordsXYE& trackPos, track_begin_end* outTra
     rotation = ((trackCoordinate.rotation_begin + rotation) & TILE_ELEMENT_DIRECTION_MASK)
         | (trackCoordinate.rotation_begin & TRACK_BLOCK_2);
 
-    return track_block_get_previous_from_zero({ coords, z }, ride, rotation, outTrackBeginEnd);
+    const TileElement* key = trackPos.element;
+    {
+        std::lock_guard<std::mutex> lock(_trackLinkCacheMutex);
+        auto it = _trackLinkPreviousCache.find(key);
+        if (it != _trackLinkPreviousCache.end() && it->second.X == trackPos.x && it->second.Y == trackPos.y)
+        {
+            return track_links_apply_previous(it->second, outTrackBeginEnd);
+        }
+    }
+
+    // begin_z is written by every lookup that finds the tile, which tells the two failures apart
+    TrackLinkPreviousCacheEntry entry{};
+    entry.X = trackPos.x;
+    entry.Y = trackPos.y;
+    entry.Output.begin_z = std::numeric_limits<int32_t>::min();
+    auto result = track_block_get_previous_from_zero({ coords, z }, ride, rotation, &entry.Output);
+    if (result)
+        entry.Result = TrackLinkResult::Found;
+    else if (entry.Output.begin_z == std::numeric_limits<int32_t>::min())
+        entry.Result = TrackLinkResult::NoTile;
+    else
+        entry.Result = TrackLinkResult::NotFound;
+    track_links_cache_insert(_trackLinkPreviousCache, key, entry);
+    return track_links_apply_previous(entry, outTrackBeginEnd);
 }
 
 /**
@@ -924,6 +1286,8 @@ void ride_init_all()
 {
     _rides.clear();
     _rides.shrink_to_fit();
+    _measuredRides.clear();
+    _measuredRidesFound = false;
 }
 
 /**
@@ -2074,14 +2438,17 @@ void Ride::Update()
     else if (type == RIDE_TYPE_SPIRAL_SLIDE)
         UpdateSpiralSlide();
 
-    ride_breakdown_update(this);
+    // Breakdowns are checked every 256 ticks and inspections every 2048 ticks, on the other ticks neither is entered
+    if (!(gCurrentTicks & 255))
+        ride_breakdown_update(this);
 
     // Various things include news messages
     if (lifecycle_flags & (RIDE_LIFECYCLE_BREAKDOWN_PENDING | RIDE_LIFECYCLE_BROKEN_DOWN | RIDE_LIFECYCLE_DUE_INSPECTION))
         if (((gCurrentTicks >> 1) & 255) == static_cast<uint32_t>(id))
             ride_breakdown_status_update(this);
 
-    ride_inspection_update(this);
+    if (!(gCurrentTicks & 2047))
+        ride_inspection_update(this);
 
     // If ride is simulating but crashed, reset the vehicles
     if (status == RIDE_STATUS_SIMULATING && (lifecycle_flags & RIDE_LIFECYCLE_CRASHED))
@@ -2259,8 +2626,6 @@ static uint8_t _breakdownProblemProbabilities[] = {
  */
 static void ride_inspection_update(Ride* ride)
 {
-    if (gCurrentTicks & 2047)
-        return;
     if (gScreenFlags & SCREEN_FLAGS_TRACK_DESIGNER)
         return;
 
@@ -2324,8 +2689,6 @@ static int32_t get_age_penalty(Ride* ride)
  */
 static void ride_breakdown_update(Ride* ride)
 {
-    if (gCurrentTicks & 255)
-        return;
     if (gScreenFlags & SCREEN_FLAGS_TRACK_DESIGNER)
         return;
 
@@ -2732,6 +3095,13 @@ Peep* find_closest_mechanic(const CoordsXY& entrancePosition, int32_t forInspect
     Peep* closestMechanic = nullptr;
     uint32_t closestDistance = std::numeric_limits<uint32_t>::max();
 
+    // The patrol check only depends on the location, so the parts of it that are the same for every mechanic are done
+    // once. A location in the park without rights is not in anyone's patrol.
+    auto location = entrancePosition.ToTileStart();
+    const bool checkPatrol = map_is_location_in_park(location);
+    if (checkPatrol && !map_is_location_owned_or_has_rights(location))
+        return nullptr;
+
     for (auto peep : EntityList<Staff>())
     {
         if (!peep->IsMechanic())
@@ -2756,21 +3126,20 @@ Peep* find_closest_mechanic(const CoordsXY& entrancePosition, int32_t forInspect
                 continue;
         }
 
-        auto location = entrancePosition.ToTileStart();
-        if (map_is_location_in_park(location))
-            if (!peep->IsLocationInPatrol(location))
-                continue;
-
         if (peep->x == LOCATION_NULL)
             continue;
 
-        // Manhattan distance
+        // Manhattan distance, only a strictly closer mechanic replaces the current one so the patrol area does not need
+        // to be looked up otherwise
         uint32_t distance = std::abs(peep->x - entrancePosition.x) + std::abs(peep->y - entrancePosition.y);
-        if (distance < closestDistance)
-        {
-            closestDistance = distance;
-            closestMechanic = peep;
-        }
+        if (distance >= closestDistance)
+            continue;
+
+        if (checkPatrol && gStaffModes[peep->StaffId] == StaffMode::Patrol && !peep->IsPatrolAreaSet(location))
+            continue;
+
+        closestDistance = distance;
+        closestMechanic = peep;
     }
 
     return closestMechanic;
@@ -2967,6 +3336,22 @@ static void ride_measurement_update(Ride& ride, RideMeasurement& measurement)
     }
 }
 
+static void ride_measurements_find()
+{
+    if (_measuredRidesFound)
+        return;
+
+    _measuredRides.clear();
+    for (auto& ride : GetRideManager())
+    {
+        if (ride.measurement != nullptr)
+        {
+            _measuredRides.push_back(ride.id);
+        }
+    }
+    _measuredRidesFound = true;
+}
+
 /**
  *
  *  rct2: 0x006B6456
@@ -2976,22 +3361,32 @@ void ride_measurements_update()
     if (gScreenFlags & SCREEN_FLAGS_SCENARIO_EDITOR)
         return;
 
+    ride_measurements_find();
+
     // For each ride measurement
-    for (auto& ride : GetRideManager())
+    for (size_t i = 0; i < _measuredRides.size();)
     {
-        auto measurement = ride.measurement.get();
-        if (measurement != nullptr && (ride.lifecycle_flags & RIDE_LIFECYCLE_ON_TRACK) && ride.status != RIDE_STATUS_SIMULATING)
+        auto ride = get_ride(_measuredRides[i]);
+        auto measurement = ride != nullptr ? ride->measurement.get() : nullptr;
+        if (measurement == nullptr)
+        {
+            _measuredRides.erase(_measuredRides.begin() + i);
+            continue;
+        }
+        i++;
+
+        if ((ride->lifecycle_flags & RIDE_LIFECYCLE_ON_TRACK) && ride->status != RIDE_STATUS_SIMULATING)
         {
             if (measurement->flags & RIDE_MEASUREMENT_FLAG_RUNNING)
             {
-                ride_measurement_update(ride, *measurement);
+                ride_measurement_update(*ride, *measurement);
             }
             else
             {
                 // For each vehicle
-                for (int32_t j = 0; j < ride.num_vehicles; j++)
+                for (int32_t j = 0; j < ride->num_vehicles; j++)
                 {
-                    uint16_t vehicleSpriteIdx = ride.vehicles[j];
+                    uint16_t vehicleSpriteIdx = ride->vehicles[j];
                     auto vehicle = GetEntity<Vehicle>(vehicleSpriteIdx);
                     if (vehicle != nullptr)
                     {
@@ -3002,7 +3397,7 @@ void ride_measurements_update()
                             measurement->current_station = vehicle->current_station;
                             measurement->flags |= RIDE_MEASUREMENT_FLAG_RUNNING;
                             measurement->flags &= ~RIDE_MEASUREMENT_FLAG_UNLOADING;
-                            ride_measurement_update(ride, *measurement);
+                            ride_measurement_update(*ride, *measurement);
                             break;
                         }
                     }
@@ -3013,32 +3408,25 @@ void ride_measurements_update()
 }
 
 /**
- * If there are more than the threshold of allowed ride measurements, free the non-LRU one.
+ * If there are more than the threshold of allowed ride measurements, free the least recently used ones.
  */
 static void ride_free_old_measurements()
 {
-    size_t numRideMeasurements;
-    do
+    ride_measurements_find();
+    auto isStale = [](ride_id_t rideId) {
+        auto ride = get_ride(rideId);
+        return ride == nullptr || ride->measurement == nullptr;
+    };
+    _measuredRides.erase(std::remove_if(_measuredRides.begin(), _measuredRides.end(), isStale), _measuredRides.end());
+
+    while (_measuredRides.size() > MAX_RIDE_MEASUREMENTS)
     {
-        Ride* lruRide{};
-        numRideMeasurements = 0;
-        for (auto& ride : GetRideManager())
-        {
-            if (ride.measurement != nullptr)
-            {
-                if (lruRide == nullptr || ride.measurement->last_use_tick > lruRide->measurement->last_use_tick)
-                {
-                    lruRide = &ride;
-                }
-                numRideMeasurements++;
-            }
-        }
-        if (numRideMeasurements > MAX_RIDE_MEASUREMENTS && lruRide != nullptr)
-        {
-            lruRide->measurement = {};
-            numRideMeasurements--;
-        }
-    } while (numRideMeasurements > MAX_RIDE_MEASUREMENTS);
+        auto lruIt = std::min_element(_measuredRides.begin(), _measuredRides.end(), [](ride_id_t a, ride_id_t b) {
+            return get_ride(a)->measurement->last_use_tick < get_ride(b)->measurement->last_use_tick;
+        });
+        get_ride(*lruIt)->measurement = {};
+        _measuredRides.erase(lruIt);
+    }
 }
 
 std::pair<RideMeasurement*, OpenRCT2String> Ride::GetMeasurement()
@@ -3054,11 +3442,18 @@ std::pair<RideMeasurement*, OpenRCT2String> Ride::GetMeasurement()
     // Check if a measurement already exists for this ride
     if (measurement == nullptr)
     {
+        ride_measurements_find();
         measurement = std::make_unique<RideMeasurement>();
         if (rtd.HasFlag(RIDE_TYPE_FLAG_HAS_G_FORCES))
         {
             measurement->flags |= RIDE_MEASUREMENT_FLAG_G_FORCES;
         }
+        // The new measurement is the most recently used, so it is never the one freed
+        measurement->last_use_tick = gScenarioTicks;
+        if (std::find(_measuredRides.begin(), _measuredRides.end(), id) == _measuredRides.end())
+        {
+            _measuredRides.push_back(id);
+        }
         ride_free_old_measurements();
         assert(measurement != nullptr);
     }
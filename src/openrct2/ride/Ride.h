@@ -161,6 +161,8 @@ struct RideStation
     uint8_t QueueTime;
     uint16_t QueueLength;
     uint16_t LastPeepInQueue;
+    // The guest at the front of the queue. Not saved, rebuilt when a park is loaded.
+    uint16_t FirstPeepInQueue;
 
     static constexpr uint8_t NO_TRAIN = std::numeric_limits<uint8_t>::max();
 
@@ -382,7 +384,6 @@ private:
     void Update();
     void UpdateChairlift();
     void UpdateSpiralSlide();
-    void UpdateQueueLength(StationIndex stationIndex);
     bool CreateVehicles(const CoordsXYE& element, bool isApplying);
     void MoveTrainsToBlockBrakes(TrackElement* firstBlock);
     money32 CalculateIncomePerHour() const;
@@ -432,7 +433,12 @@ public:
     int32_t GetTotalQueueLength() const;
     int32_t GetMaxQueueTime() const;
 
+    void QueueInsertGuestAtBack(StationIndex stationIndex, Peep* peep);
     void QueueInsertGuestAtFront(StationIndex stationIndex, Peep* peep);
+    void QueueRemoveGuest(StationIndex stationIndex, Peep* peep);
+    void QueueClear(StationIndex stationIndex);
+    void QueueRebuild(StationIndex stationIndex);
+    bool QueueValidate(StationIndex stationIndex) const;
     Peep* GetQueueHeadGuest(StationIndex stationIndex) const;
 
     void SetNameToDefault();
@@ -1112,7 +1118,22 @@ int32_t ride_get_count();
 void ride_init_all();
 void reset_all_ride_build_dates();
 void ride_update_favourited_stat();
+
+/**
+ * Must be called whenever a guest's favourite ride changes, including when a guest with a favourite ride is removed.
+ */
+void ride_guest_favourite_changed(ride_id_t previousRide, ride_id_t newRide);
+
+/**
+ * Drops the favourite ride counts so they are rebuilt from the guests, for when the entities have been replaced.
+ */
+void ride_favourite_counts_invalidate();
 void ride_check_all_reachable();
+
+/**
+ * Recreates the parts of the ride queues that are not saved from the saved links, must be called after loading a park.
+ */
+void ride_queues_rebuild();
 void ride_update_satisfaction(Ride* ride, uint8_t happiness);
 void ride_update_popularity(Ride* ride, uint8_t pop_amount);
 bool ride_try_get_origin_element(const Ride* ride, CoordsXYE* output);
@@ -1141,6 +1162,12 @@ void ride_set_map_tooltip(TileElement* tileElement);
 void ride_prepare_breakdown(Ride* ride, int32_t breakdownReason);
 TileElement* ride_get_station_start_track_element(Ride* ride, StationIndex stationIndex);
 TileElement* ride_get_station_exit_element(const CoordsXYZ& elementPos);
+
+/**
+ * Drops the station start track elements remembered by ride_get_station_start_track_element, must be called whenever
+ * tile elements may have moved or been replaced.
+ */
+void ride_station_elements_invalidate();
 void ride_set_status(Ride* ride, int32_t status);
 void ride_set_name(Ride* ride, const char* name, uint32_t flags);
 int32_t ride_get_refund_price(const Ride* ride);
@@ -1153,6 +1180,12 @@ void ride_entrance_exit_place_provisional_ghost();
 void ride_entrance_exit_remove_ghost();
 void ride_restore_provisional_track_piece();
 void ride_remove_provisional_track_piece();
+
+/**
+ * Forgets the positions where provisional track pieces could not be placed, must be called whenever the map or the
+ * rules for placing track may have changed other than by the construction ghosts themselves.
+ */
+void ride_provisional_track_invalidate_cache();
 void set_vehicle_type_image_max_sizes(rct_ride_entry_vehicle* vehicle_type, int32_t num_images);
 void invalidate_test_results(Ride* ride);
 
@@ -1183,6 +1216,12 @@ bool track_block_get_previous(const CoordsXYE& trackPos, track_begin_end* outTra
 bool track_block_get_previous_from_zero(
     const CoordsXYZ& startPos, Ride* ride, uint8_t direction, track_begin_end* outTrackBeginEnd);
 
+/**
+ * Drops the cached links between track pieces, must be called whenever tile elements are added, removed, moved or
+ * changed in a way that affects how track pieces connect.
+ */
+void track_block_links_invalidate();
+
 void ride_get_start_of_track(CoordsXYE* output);
 
 void window_ride_construction_update_active_elements();
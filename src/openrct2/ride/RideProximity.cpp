@@ -0,0 +1,199 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "RideProximity.h"
+
+#include "../Game.h"
+#include "../world/Location.hpp"
+#include "../world/Map.h"
+#include "../world/TileElementsView.h"
+#include "RideData.h"
+
+#include <algorithm>
+#include <array>
+
+using namespace OpenRCT2;
+
+// Number of tiles along each side of a block
+static constexpr int32_t BLOCK_SIZE = 8;
+static constexpr int32_t NUM_BLOCKS = MAXIMUM_MAP_SIZE_TECHNICAL / BLOCK_SIZE;
+
+struct RideProximityBlock
+{
+    std::bitset<MAX_RIDES> Rides;
+    uint32_t Generation = 0;
+};
+
+static std::array<RideProximityBlock, NUM_BLOCKS * NUM_BLOCKS> _blocks;
+// Blocks are rebuilt when their generation does not match, zero is never used so that single blocks can be invalidated.
+static uint32_t _generation = 1;
+
+static std::bitset<MAX_RIDES> _visibleFromAnywhere;
+static uint32_t _visibleFromAnywhereTick;
+static bool _visibleFromAnywhereValid;
+
+static std::array<RideConsiderationSummary, MAX_RIDES> _considerationSummaries;
+static uint32_t _considerationSummariesTick;
+static bool _considerationSummariesValid;
+
+static void AddRidesOnTile(std::bitset<MAX_RIDES>& rides, int32_t tileX, int32_t tileY)
+{
+    for (auto* trackElement : TileElementsView<TrackElement>(TileCoordsXY{ tileX, tileY }.ToCoordsXY()))
+    {
+        auto rideIndex = trackElement->GetRideIndex();
+        if (rideIndex < MAX_RIDES)
+        {
+            rides[rideIndex] = true;
+        }
+    }
+}
+
+static const std::bitset<MAX_RIDES>& GetBlockRides(int32_t blockX, int32_t blockY)
+{
+    auto& block = _blocks[blockY * NUM_BLOCKS + blockX];
+    if (block.Generation != _generation)
+    {
+        block.Rides.reset();
+        for (int32_t tileX = blockX * BLOCK_SIZE; tileX < (blockX + 1) * BLOCK_SIZE; tileX++)
+        {
+            for (int32_t tileY = blockY * BLOCK_SIZE; tileY < (blockY + 1) * BLOCK_SIZE; tileY++)
+            {
+                AddRidesOnTile(block.Rides, tileX, tileY);
+            }
+        }
+        block.Generation = _generation;
+    }
+    return block.Rides;
+}
+
+std::bitset<MAX_RIDES> GetRidesNearTile(const TileCoordsXY& centre, int32_t radius)
+{
+    std::bitset<MAX_RIDES> result;
+
+    constexpr int32_t maxTile = MAXIMUM_MAP_SIZE_TECHNICAL - 1;
+    const int32_t left = std::clamp(centre.x - radius, 0, maxTile);
+    const int32_t right = std::clamp(centre.x + radius, 0, maxTile);
+    const int32_t top = std::clamp(centre.y - radius, 0, maxTile);
+    const int32_t bottom = std::clamp(centre.y + radius, 0, maxTile);
+    if (centre.x + radius < 0 || centre.x - radius > maxTile || centre.y + radius < 0 || centre.y - radius > maxTile)
+    {
+        return result;
+    }
+
+    // Blocks that are completely inside the area contribute their whole set
+    const int32_t blockLeft = left / BLOCK_SIZE;
+    const int32_t blockRight = right / BLOCK_SIZE;
+    const int32_t blockTop = top / BLOCK_SIZE;
+    const int32_t blockBottom = bottom / BLOCK_SIZE;
+    for (int32_t blockX = blockLeft; blockX <= blockRight; blockX++)
+    {
+        for (int32_t blockY = blockTop; blockY <= blockBottom; blockY++)
+        {
+            const int32_t blockTileLeft = blockX * BLOCK_SIZE;
+            const int32_t blockTileTop = blockY * BLOCK_SIZE;
+            if (blockTileLeft >= left && blockTileLeft + BLOCK_SIZE - 1 <= right && blockTileTop >= top
+                && blockTileTop + BLOCK_SIZE - 1 <= bottom)
+            {
+                result |= GetBlockRides(blockX, blockY);
+            }
+        }
+    }
+
+    // Blocks on the border only need their tiles scanned if they have a ride that has not been found yet
+    for (int32_t blockX = blockLeft; blockX <= blockRight; blockX++)
+    {
+        for (int32_t blockY = blockTop; blockY <= blockBottom; blockY++)
+        {
+            const int32_t blockTileLeft = blockX * BLOCK_SIZE;
+            const int32_t blockTileTop = blockY * BLOCK_SIZE;
+            const int32_t scanLeft = std::max(blockTileLeft, left);
+            const int32_t scanRight = std::min(blockTileLeft + BLOCK_SIZE - 1, right);
+            const int32_t scanTop = std::max(blockTileTop, top);
+            const int32_t scanBottom = std::min(blockTileTop + BLOCK_SIZE - 1, bottom);
+            if (scanRight - scanLeft == BLOCK_SIZE - 1 && scanBottom - scanTop == BLOCK_SIZE - 1)
+                continue;
+
+            const auto& blockRides = GetBlockRides(blockX, blockY);
+            if ((blockRides & ~result).none())
+                continue;
+
+            for (int32_t tileX = scanLeft; tileX <= scanRight; tileX++)
+            {
+                for (int32_t tileY = scanTop; tileY <= scanBottom; tileY++)
+                {
+                    AddRidesOnTile(result, tileX, tileY);
+                }
+            }
+        }
+    }
+    return result;
+}
+
+const std::bitset<MAX_RIDES>& GetRidesVisibleFromAnywhere()
+{
+    if (!_visibleFromAnywhereValid || _visibleFromAnywhereTick != gCurrentTicks)
+    {
+        _visibleFromAnywhere.reset();
+        for (auto& ride : GetRideManager())
+        {
+            if (ride.highest_drop_height > 66 || ride.excitement >= RIDE_RATING(8, 00))
+            {
+                _visibleFromAnywhere[ride.id] = true;
+            }
+        }
+        _visibleFromAnywhereTick = gCurrentTicks;
+        _visibleFromAnywhereValid = true;
+    }
+    return _visibleFromAnywhere;
+}
+
+const std::array<RideConsiderationSummary, MAX_RIDES>& GetRideConsiderationSummaries()
+{
+    if (!_considerationSummariesValid || _considerationSummariesTick != gCurrentTicks)
+    {
+        _considerationSummaries.fill({});
+        for (auto& ride : GetRideManager())
+        {
+            const auto& rtd = ride.GetRideTypeDescriptor();
+            auto& summary = _considerationSummaries[ride.id];
+            summary.Excitement = ride.excitement;
+            summary.Open = ride.status == RIDE_STATUS_OPEN && !(ride.lifecycle_flags & RIDE_LIFECYCLE_BROKEN_DOWN);
+            summary.HasRatings = ride_has_ratings(&ride);
+            summary.DrawsRandomWhileUnrated = !summary.HasRatings && rtd.HasFlag(RIDE_TYPE_FLAG_PEEP_CHECK_GFORCES)
+                && !rtd.HasFlag(RIDE_TYPE_FLAG_IS_SHOP);
+        }
+        _considerationSummariesTick = gCurrentTicks;
+        _considerationSummariesValid = true;
+    }
+    return _considerationSummaries;
+}
+
+void RideProximityInvalidateTile(const CoordsXY& loc)
+{
+    auto tileLoc = TileCoordsXY(loc);
+    if (tileLoc.x >= 0 && tileLoc.y >= 0 && tileLoc.x < MAXIMUM_MAP_SIZE_TECHNICAL && tileLoc.y < MAXIMUM_MAP_SIZE_TECHNICAL)
+    {
+        _blocks[(tileLoc.y / BLOCK_SIZE) * NUM_BLOCKS + (tileLoc.x / BLOCK_SIZE)].Generation = 0;
+    }
+}
+
+void RideProximityInvalidateAll()
+{
+    _generation++;
+    if (_generation == 0)
+    {
+        _generation = 1;
+        for (auto& block : _blocks)
+        {
+            block.Generation = 0;
+        }
+    }
+    _visibleFromAnywhereValid = false;
+    _considerationSummariesValid = false;
+}
@@ -0,0 +1,52 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../common.h"
+#include "Ride.h"
+
+#include <array>
+#include <bitset>
+
+struct CoordsXY;
+struct TileCoordsXY;
+
+/**
+ * Returns the rides that have a track element on any tile within radius tiles of the given tile. The result is the same
+ * as scanning every tile of the square, but uses a coarse grid of per-block ride sets that is rebuilt lazily whenever
+ * track elements are added to or removed from the map.
+ */
+std::bitset<MAX_RIDES> GetRidesNearTile(const TileCoordsXY& centre, int32_t radius);
+
+/**
+ * Returns the rides that are tall or exciting enough to be seen from anywhere in the park, recalculated once per tick.
+ */
+const std::bitset<MAX_RIDES>& GetRidesVisibleFromAnywhere();
+
+/**
+ * The properties of a ride that guests check first when choosing a ride to head for, which do not depend on the guest.
+ */
+struct RideConsiderationSummary
+{
+    ride_rating Excitement;
+    bool Open;
+    bool HasRatings;
+    // Unrated rides that check g-forces draw a random number while being considered, so they can never be skipped
+    bool DrawsRandomWhileUnrated;
+};
+
+/**
+ * Returns the consideration summary of every ride, indexed by ride id and recalculated once per tick, so rides can be
+ * ruled out without walking the ride structs.
+ */
+const std::array<RideConsiderationSummary, MAX_RIDES>& GetRideConsiderationSummaries();
+
+void RideProximityInvalidateTile(const CoordsXY& loc);
+void RideProximityInvalidateAll();
@@ -11,7 +11,10 @@
 
 #include "../Cheats.h"
 #include "../Context.h"
+#include "../GameState.h"
 #include "../OpenRCT2.h"
+#include "../core/JobPool.h"
+#include "../core/Trace.h"
 #include "../interface/Window.h"
 #include "../localisation/Date.h"
 #include "../scripting/ScriptEngine.h"
@@ -24,7 +27,13 @@
 #include "Track.h"
 
 #include <algorithm>
+#include <array>
+#include <chrono>
 #include <iterator>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
 
 using namespace OpenRCT2;
 using namespace OpenRCT2::Scripting;
@@ -78,6 +87,34 @@ struct ShelteredEights
 
 RideRatingCalculationData gRideRatingsCalcData;
 
+// The calculation state the rating functions work on. This is gRideRatingsCalcData for the incremental calculation,
+// ride_ratings_update_rides points it at a private state for every ride it rates so rides can be rated on any thread.
+static thread_local RideRatingCalculationData* _rideRatingsState = &gRideRatingsCalcData;
+
+static std::unique_ptr<JobPool> _rideRatingsJobs;
+
+/**
+ * The proximity scores a single track piece contributes, which only depend on the piece itself and the elements on its
+ * own tile and the tiles next to and ahead of it.
+ */
+struct RideRatingsProximityCacheEntry
+{
+    int32_t Z;
+    ride_id_t RideIndex;
+    track_type_t TrackType;
+    uint8_t Direction;
+    uint8_t ClearanceHeight;
+    uint8_t SurfaceBaseHeight;
+    std::array<uint16_t, PROXIMITY_COUNT> Scores;
+};
+
+static constexpr size_t MAX_PROXIMITY_CACHE_ENTRIES = 65536;
+
+// Cached proximity scores by tile index, entries are dropped when anything within one tile of them changes
+static std::unordered_map<uint32_t, std::vector<RideRatingsProximityCacheEntry>> _rideRatingsProximityCache;
+static size_t _rideRatingsProximityCacheSize;
+static std::mutex _rideRatingsProximityCacheMutex;
+
 static void ride_ratings_update_state();
 static void ride_ratings_update_state_0();
 static void ride_ratings_update_state_1();
@@ -87,26 +124,120 @@ static void ride_ratings_update_state_4();
 static void ride_ratings_update_state_5();
 static void ride_ratings_begin_proximity_loop();
 static void ride_ratings_calculate(Ride* ride);
+static void ride_ratings_calculate_base(Ride* ride);
+static void ride_ratings_call_hook(Ride* ride);
 static void ride_ratings_calculate_value(Ride* ride);
 static void ride_ratings_score_close_proximity(TileElement* inputTileElement);
 
 static void ride_ratings_add(RatingTuple* rating, int32_t excitement, int32_t intensity, int32_t nausea);
 
 /**
- * This is a small hack function to keep calling the ride rating processor until
- * the given ride's ratings have been calculated. What ever is currently being
- * processed will be overwritten.
- * Only purpose of this function currently is for testing.
+ * Runs the proximity loop of a ride to completion on a private calculation state and applies the ride type's rating
+ * function. Only reads the map and writes to the ride itself, so different rides can be processed concurrently.
+ * Returns false if the ride could not be rated.
  */
-void ride_ratings_update_ride(const Ride& ride)
+static bool ride_ratings_calculate_to_completion(Ride& ride, RideRatingsMeasurement* measurement = nullptr)
+{
+    TRACE_ZONE("Ride rating");
+    RideRatingCalculationData state{};
+    state.CurrentRide = ride.id;
+    state.State = RIDE_RATINGS_STATE_INITIALISE;
+
+    auto* previousState = _rideRatingsState;
+    _rideRatingsState = &state;
+    auto startTime = std::chrono::high_resolution_clock::now();
+    uint32_t numStateUpdates = 0;
+    while (state.State != RIDE_RATINGS_STATE_FIND_NEXT_RIDE && state.State != RIDE_RATINGS_STATE_CALCULATE)
+    {
+        ride_ratings_update_state();
+        numStateUpdates++;
+    }
+    auto calculateStartTime = std::chrono::high_resolution_clock::now();
+
+    bool rated = state.State == RIDE_RATINGS_STATE_CALCULATE;
+    if (rated)
+    {
+        ride_ratings_calculate_base(&ride);
+    }
+    _rideRatingsState = previousState;
+
+    if (measurement != nullptr)
+    {
+        measurement->StateUpdates += numStateUpdates;
+        measurement->TrackPieces += state.ProximityTotal;
+        measurement->ProximityTime += calculateStartTime - startTime;
+        measurement->CalculateTime += std::chrono::high_resolution_clock::now() - calculateStartTime;
+    }
+    return rated;
+}
+
+/**
+ * Calls the plugin hooks and calculates the value of a ride that has just been rated.
+ */
+static void ride_ratings_finish(Ride* ride)
+{
+    ride_ratings_call_hook(ride);
+    ride_ratings_calculate_value(ride);
+    window_invalidate_by_number(WC_RIDE, ride->id);
+}
+
+/**
+ * Calculates the ratings of a single ride to completion, see ride_ratings_update_rides. With measurement given, the work
+ * done for the ride is added to it.
+ */
+void ride_ratings_update_ride(const Ride& ride, RideRatingsMeasurement* measurement)
+{
+    if (measurement == nullptr)
+    {
+        ride_ratings_update_rides({ ride.id });
+        return;
+    }
+
+    auto* mutableRide = get_ride(ride.id);
+    if (mutableRide != nullptr && mutableRide->status != RIDE_STATUS_CLOSED && mutableRide->type < RIDE_TYPE_COUNT
+        && ride_ratings_calculate_to_completion(*mutableRide, measurement))
+    {
+        ride_ratings_finish(mutableRide);
+    }
+}
+
+void ride_ratings_update_rides(const std::vector<ride_id_t>& rideIds, bool parallel)
 {
-    if (ride.status != RIDE_STATUS_CLOSED)
+    std::vector<Ride*> rides;
+    rides.reserve(rideIds.size());
+    for (auto rideId : rideIds)
     {
-        gRideRatingsCalcData.CurrentRide = ride.id;
-        gRideRatingsCalcData.State = RIDE_RATINGS_STATE_INITIALISE;
-        while (gRideRatingsCalcData.State != RIDE_RATINGS_STATE_FIND_NEXT_RIDE)
+        auto ride = get_ride(rideId);
+        if (ride != nullptr && ride->status != RIDE_STATUS_CLOSED && ride->type < RIDE_TYPE_COUNT)
         {
-            ride_ratings_update_state();
+            rides.push_back(ride);
+        }
+    }
+
+    std::vector<uint8_t> rated(rides.size());
+    if (parallel && rides.size() > 1)
+    {
+        if (_rideRatingsJobs == nullptr)
+        {
+            _rideRatingsJobs = std::make_unique<JobPool>();
+        }
+        _rideRatingsJobs->ParallelFor(
+            0, rides.size(), 1, [&](size_t index) { rated[index] = ride_ratings_calculate_to_completion(*rides[index]); });
+    }
+    else
+    {
+        for (size_t i = 0; i < rides.size(); i++)
+        {
+            rated[i] = ride_ratings_calculate_to_completion(*rides[i]);
+        }
+    }
+
+    // Plugin hooks and the ride value, which looks at the other rides, are processed in order on the calling thread
+    for (size_t i = 0; i < rides.size(); i++)
+    {
+        if (rated[i])
+        {
+            ride_ratings_finish(rides[i]);
         }
     }
 }
@@ -117,15 +248,20 @@ void ride_ratings_update_ride(const Ride& ride)
  */
 void ride_ratings_update_all()
 {
+    TRACE_ZONE("Ride ratings update");
     if (gScreenFlags & SCREEN_FLAGS_SCENARIO_EDITOR)
         return;
 
     ride_ratings_update_state();
+    if (OpenRCT2::gLogicCounters != nullptr)
+    {
+        OpenRCT2::gLogicCounters->RideRatingsSteps++;
+    }
 }
 
 static void ride_ratings_update_state()
 {
-    switch (gRideRatingsCalcData.State)
+    switch (_rideRatingsState->State)
     {
         case RIDE_RATINGS_STATE_FIND_NEXT_RIDE:
             ride_ratings_update_state_0();
@@ -154,7 +290,7 @@ static void ride_ratings_update_state()
  */
 static void ride_ratings_update_state_0()
 {
-    int32_t currentRide = gRideRatingsCalcData.CurrentRide;
+    int32_t currentRide = _rideRatingsState->CurrentRide;
 
     currentRide++;
     if (currentRide == RIDE_ID_NULL)
@@ -165,9 +301,9 @@ static void ride_ratings_update_state_0()
     auto ride = get_ride(currentRide);
     if (ride != nullptr && ride->status != RIDE_STATUS_CLOSED)
     {
-        gRideRatingsCalcData.State = RIDE_RATINGS_STATE_INITIALISE;
+        _rideRatingsState->State = RIDE_RATINGS_STATE_INITIALISE;
     }
-    gRideRatingsCalcData.CurrentRide = currentRide;
+    _rideRatingsState->CurrentRide = currentRide;
 }
 
 /**
@@ -176,15 +312,15 @@ static void ride_ratings_update_state_0()
  */
 static void ride_ratings_update_state_1()
 {
-    gRideRatingsCalcData.ProximityTotal = 0;
+    _rideRatingsState->ProximityTotal = 0;
     for (int32_t i = 0; i < PROXIMITY_COUNT; i++)
     {
-        gRideRatingsCalcData.ProximityScores[i] = 0;
+        _rideRatingsState->ProximityScores[i] = 0;
     }
-    gRideRatingsCalcData.AmountOfBrakes = 0;
-    gRideRatingsCalcData.AmountOfReversers = 0;
-    gRideRatingsCalcData.State = RIDE_RATINGS_STATE_2;
-    gRideRatingsCalcData.StationFlags = 0;
+    _rideRatingsState->AmountOfBrakes = 0;
+    _rideRatingsState->AmountOfReversers = 0;
+    _rideRatingsState->State = RIDE_RATINGS_STATE_2;
+    _rideRatingsState->StationFlags = 0;
     ride_ratings_begin_proximity_loop();
 }
 
@@ -194,21 +330,21 @@ static void ride_ratings_update_state_1()
  */
 static void ride_ratings_update_state_2()
 {
-    const ride_id_t rideIndex = gRideRatingsCalcData.CurrentRide;
+    const ride_id_t rideIndex = _rideRatingsState->CurrentRide;
     auto ride = get_ride(rideIndex);
     if (ride == nullptr || ride->status == RIDE_STATUS_CLOSED || ride->type >= RIDE_TYPE_COUNT)
     {
-        gRideRatingsCalcData.State = RIDE_RATINGS_STATE_FIND_NEXT_RIDE;
+        _rideRatingsState->State = RIDE_RATINGS_STATE_FIND_NEXT_RIDE;
         return;
     }
 
-    auto loc = gRideRatingsCalcData.Proximity;
-    track_type_t trackType = gRideRatingsCalcData.ProximityTrackType;
+    auto loc = _rideRatingsState->Proximity;
+    track_type_t trackType = _rideRatingsState->ProximityTrackType;
 
     TileElement* tileElement = map_get_first_element_at(loc);
     if (tileElement == nullptr)
     {
-        gRideRatingsCalcData.State = RIDE_RATINGS_STATE_FIND_NEXT_RIDE;
+        _rideRatingsState->State = RIDE_RATINGS_STATE_FIND_NEXT_RIDE;
         return;
     }
     do
@@ -233,37 +369,37 @@ static void ride_ratings_update_state_2()
             if (trackType == TrackElemType::EndStation)
             {
                 int32_t entranceIndex = tileElement->AsTrack()->GetStationIndex();
-                gRideRatingsCalcData.StationFlags &= ~RIDE_RATING_STATION_FLAG_NO_ENTRANCE;
+                _rideRatingsState->StationFlags &= ~RIDE_RATING_STATION_FLAG_NO_ENTRANCE;
                 if (ride_get_entrance_location(ride, entranceIndex).isNull())
                 {
-                    gRideRatingsCalcData.StationFlags |= RIDE_RATING_STATION_FLAG_NO_ENTRANCE;
+                    _rideRatingsState->StationFlags |= RIDE_RATING_STATION_FLAG_NO_ENTRANCE;
                 }
             }
 
             ride_ratings_score_close_proximity(tileElement);
 
-            CoordsXYE trackElement = { gRideRatingsCalcData.Proximity, tileElement };
+            CoordsXYE trackElement = { _rideRatingsState->Proximity, tileElement };
             CoordsXYE nextTrackElement;
             if (!track_block_get_next(&trackElement, &nextTrackElement, nullptr, nullptr))
             {
-                gRideRatingsCalcData.State = RIDE_RATINGS_STATE_4;
+                _rideRatingsState->State = RIDE_RATINGS_STATE_4;
                 return;
             }
 
             loc = { nextTrackElement, nextTrackElement.element->GetBaseZ() };
             tileElement = nextTrackElement.element;
-            if (loc == gRideRatingsCalcData.ProximityStart)
+            if (loc == _rideRatingsState->ProximityStart)
             {
-                gRideRatingsCalcData.State = RIDE_RATINGS_STATE_CALCULATE;
+                _rideRatingsState->State = RIDE_RATINGS_STATE_CALCULATE;
                 return;
             }
-            gRideRatingsCalcData.Proximity = loc;
-            gRideRatingsCalcData.ProximityTrackType = tileElement->AsTrack()->GetTrackType();
+            _rideRatingsState->Proximity = loc;
+            _rideRatingsState->ProximityTrackType = tileElement->AsTrack()->GetTrackType();
             return;
         }
     } while (!(tileElement++)->IsLastForTile());
 
-    gRideRatingsCalcData.State = RIDE_RATINGS_STATE_FIND_NEXT_RIDE;
+    _rideRatingsState->State = RIDE_RATINGS_STATE_FIND_NEXT_RIDE;
 }
 
 /**
@@ -272,18 +408,18 @@ static void ride_ratings_update_state_2()
  */
 static void ride_ratings_update_state_3()
 {
-    auto ride = get_ride(gRideRatingsCalcData.CurrentRide);
+    auto ride = get_ride(_rideRatingsState->CurrentRide);
     if (ride == nullptr || ride->status == RIDE_STATUS_CLOSED)
     {
-        gRideRatingsCalcData.State = RIDE_RATINGS_STATE_FIND_NEXT_RIDE;
+        _rideRatingsState->State = RIDE_RATINGS_STATE_FIND_NEXT_RIDE;
         return;
     }
 
     ride_ratings_calculate(ride);
     ride_ratings_calculate_value(ride);
 
-    window_invalidate_by_number(WC_RIDE, gRideRatingsCalcData.CurrentRide);
-    gRideRatingsCalcData.State = RIDE_RATINGS_STATE_FIND_NEXT_RIDE;
+    window_invalidate_by_number(WC_RIDE, _rideRatingsState->CurrentRide);
+    _rideRatingsState->State = RIDE_RATINGS_STATE_FIND_NEXT_RIDE;
 }
 
 /**
@@ -292,7 +428,7 @@ static void ride_ratings_update_state_3()
  */
 static void ride_ratings_update_state_4()
 {
-    gRideRatingsCalcData.State = RIDE_RATINGS_STATE_5;
+    _rideRatingsState->State = RIDE_RATINGS_STATE_5;
     ride_ratings_begin_proximity_loop();
 }
 
@@ -302,20 +438,20 @@ static void ride_ratings_update_state_4()
  */
 static void ride_ratings_update_state_5()
 {
-    auto ride = get_ride(gRideRatingsCalcData.CurrentRide);
+    auto ride = get_ride(_rideRatingsState->CurrentRide);
     if (ride == nullptr || ride->status == RIDE_STATUS_CLOSED)
     {
-        gRideRatingsCalcData.State = RIDE_RATINGS_STATE_FIND_NEXT_RIDE;
+        _rideRatingsState->State = RIDE_RATINGS_STATE_FIND_NEXT_RIDE;
         return;
     }
 
-    auto loc = gRideRatingsCalcData.Proximity;
-    track_type_t trackType = gRideRatingsCalcData.ProximityTrackType;
+    auto loc = _rideRatingsState->Proximity;
+    track_type_t trackType = _rideRatingsState->ProximityTrackType;
 
     TileElement* tileElement = map_get_first_element_at(loc);
     if (tileElement == nullptr)
     {
-        gRideRatingsCalcData.State = RIDE_RATINGS_STATE_FIND_NEXT_RIDE;
+        _rideRatingsState->State = RIDE_RATINGS_STATE_FIND_NEXT_RIDE;
         return;
     }
     do
@@ -339,27 +475,27 @@ static void ride_ratings_update_state_5()
             ride_ratings_score_close_proximity(tileElement);
 
             track_begin_end trackBeginEnd;
-            if (!track_block_get_previous({ gRideRatingsCalcData.Proximity, tileElement }, &trackBeginEnd))
+            if (!track_block_get_previous({ _rideRatingsState->Proximity, tileElement }, &trackBeginEnd))
             {
-                gRideRatingsCalcData.State = RIDE_RATINGS_STATE_CALCULATE;
+                _rideRatingsState->State = RIDE_RATINGS_STATE_CALCULATE;
                 return;
             }
 
             loc.x = trackBeginEnd.begin_x;
             loc.y = trackBeginEnd.begin_y;
             loc.z = trackBeginEnd.begin_z;
-            if (loc == gRideRatingsCalcData.ProximityStart)
+            if (loc == _rideRatingsState->ProximityStart)
             {
-                gRideRatingsCalcData.State = RIDE_RATINGS_STATE_CALCULATE;
+                _rideRatingsState->State = RIDE_RATINGS_STATE_CALCULATE;
                 return;
             }
-            gRideRatingsCalcData.Proximity = loc;
-            gRideRatingsCalcData.ProximityTrackType = trackBeginEnd.begin_element->AsTrack()->GetTrackType();
+            _rideRatingsState->Proximity = loc;
+            _rideRatingsState->ProximityTrackType = trackBeginEnd.begin_element->AsTrack()->GetTrackType();
             return;
         }
     } while (!(tileElement++)->IsLastForTile());
 
-    gRideRatingsCalcData.State = RIDE_RATINGS_STATE_FIND_NEXT_RIDE;
+    _rideRatingsState->State = RIDE_RATINGS_STATE_FIND_NEXT_RIDE;
 }
 
 /**
@@ -368,16 +504,16 @@ static void ride_ratings_update_state_5()
  */
 static void ride_ratings_begin_proximity_loop()
 {
-    auto ride = get_ride(gRideRatingsCalcData.CurrentRide);
+    auto ride = get_ride(_rideRatingsState->CurrentRide);
     if (ride == nullptr || ride->status == RIDE_STATUS_CLOSED)
     {
-        gRideRatingsCalcData.State = RIDE_RATINGS_STATE_FIND_NEXT_RIDE;
+        _rideRatingsState->State = RIDE_RATINGS_STATE_FIND_NEXT_RIDE;
         return;
     }
 
     if (ride->type == RIDE_TYPE_MAZE)
     {
-        gRideRatingsCalcData.State = RIDE_RATINGS_STATE_CALCULATE;
+        _rideRatingsState->State = RIDE_RATINGS_STATE_CALCULATE;
         return;
     }
 
@@ -385,26 +521,26 @@ static void ride_ratings_begin_proximity_loop()
     {
         if (!ride->stations[i].Start.isNull())
         {
-            gRideRatingsCalcData.StationFlags &= ~RIDE_RATING_STATION_FLAG_NO_ENTRANCE;
+            _rideRatingsState->StationFlags &= ~RIDE_RATING_STATION_FLAG_NO_ENTRANCE;
             if (ride_get_entrance_location(ride, i).isNull())
             {
-                gRideRatingsCalcData.StationFlags |= RIDE_RATING_STATION_FLAG_NO_ENTRANCE;
+                _rideRatingsState->StationFlags |= RIDE_RATING_STATION_FLAG_NO_ENTRANCE;
             }
 
             auto location = ride->stations[i].GetStart();
-            gRideRatingsCalcData.Proximity = location;
-            gRideRatingsCalcData.ProximityTrackType = TrackElemType::None;
-            gRideRatingsCalcData.ProximityStart = location;
+            _rideRatingsState->Proximity = location;
+            _rideRatingsState->ProximityTrackType = TrackElemType::None;
+            _rideRatingsState->ProximityStart = location;
             return;
         }
     }
 
-    gRideRatingsCalcData.State = RIDE_RATINGS_STATE_FIND_NEXT_RIDE;
+    _rideRatingsState->State = RIDE_RATINGS_STATE_FIND_NEXT_RIDE;
 }
 
 static void proximity_score_increment(int32_t type)
 {
-    gRideRatingsCalcData.ProximityScores[type]++;
+    _rideRatingsState->ProximityScores[type]++;
 }
 
 /**
@@ -413,7 +549,7 @@ static void proximity_score_increment(int32_t type)
  */
 static void ride_ratings_score_close_proximity_in_direction(TileElement* inputTileElement, int32_t direction)
 {
-    auto scorePos = CoordsXY{ CoordsXY{ gRideRatingsCalcData.Proximity } + CoordsDirectionDelta[direction] };
+    auto scorePos = CoordsXY{ CoordsXY{ _rideRatingsState->Proximity } + CoordsDirectionDelta[direction] };
     if (!map_is_location_valid(scorePos))
         return;
 
@@ -428,7 +564,7 @@ static void ride_ratings_score_close_proximity_in_direction(TileElement* inputTi
         switch (tileElement->GetType())
         {
             case TILE_ELEMENT_TYPE_SURFACE:
-                if (gRideRatingsCalcData.ProximityBaseHeight <= inputTileElement->base_height)
+                if (_rideRatingsState->ProximityBaseHeight <= inputTileElement->base_height)
                 {
                     if (inputTileElement->clearance_height <= tileElement->base_height)
                     {
@@ -524,11 +660,11 @@ static void ride_ratings_score_close_proximity_loops(TileElement* inputTileEleme
     auto trackType = inputTileElement->AsTrack()->GetTrackType();
     if (trackType == TrackElemType::LeftVerticalLoop || trackType == TrackElemType::RightVerticalLoop)
     {
-        ride_ratings_score_close_proximity_loops_helper({ gRideRatingsCalcData.Proximity, inputTileElement });
+        ride_ratings_score_close_proximity_loops_helper({ _rideRatingsState->Proximity, inputTileElement });
 
         int32_t direction = inputTileElement->GetDirection();
         ride_ratings_score_close_proximity_loops_helper(
-            { CoordsXY{ gRideRatingsCalcData.Proximity } + CoordsDirectionDelta[direction], inputTileElement });
+            { CoordsXY{ _rideRatingsState->Proximity } + CoordsDirectionDelta[direction], inputTileElement });
     }
 }
 
@@ -536,15 +672,9 @@ static void ride_ratings_score_close_proximity_loops(TileElement* inputTileEleme
  *
  *  rct2: 0x006B5F9D
  */
-static void ride_ratings_score_close_proximity(TileElement* inputTileElement)
+static void ride_ratings_score_close_proximity_tiles(TileElement* inputTileElement)
 {
-    if (gRideRatingsCalcData.StationFlags & RIDE_RATING_STATION_FLAG_NO_ENTRANCE)
-    {
-        return;
-    }
-
-    gRideRatingsCalcData.ProximityTotal++;
-    TileElement* tileElement = map_get_first_element_at(gRideRatingsCalcData.Proximity);
+    TileElement* tileElement = map_get_first_element_at(_rideRatingsState->Proximity);
     if (tileElement == nullptr)
         return;
     do
@@ -556,8 +686,8 @@ static void ride_ratings_score_close_proximity(TileElement* inputTileElement)
         switch (tileElement->GetType())
         {
             case TILE_ELEMENT_TYPE_SURFACE:
-                gRideRatingsCalcData.ProximityBaseHeight = tileElement->base_height;
-                if (tileElement->GetBaseZ() == gRideRatingsCalcData.Proximity.z)
+                _rideRatingsState->ProximityBaseHeight = tileElement->base_height;
+                if (tileElement->GetBaseZ() == _rideRatingsState->Proximity.z)
                 {
                     proximity_score_increment(PROXIMITY_SURFACE_TOUCH);
                 }
@@ -565,20 +695,20 @@ static void ride_ratings_score_close_proximity(TileElement* inputTileElement)
                 if (waterHeight != 0)
                 {
                     auto z = waterHeight;
-                    if (z <= gRideRatingsCalcData.Proximity.z)
+                    if (z <= _rideRatingsState->Proximity.z)
                     {
                         proximity_score_increment(PROXIMITY_WATER_OVER);
-                        if (z == gRideRatingsCalcData.Proximity.z)
+                        if (z == _rideRatingsState->Proximity.z)
                         {
                             proximity_score_increment(PROXIMITY_WATER_TOUCH);
                         }
                         z += 16;
-                        if (z == gRideRatingsCalcData.Proximity.z)
+                        if (z == _rideRatingsState->Proximity.z)
                         {
                             proximity_score_increment(PROXIMITY_WATER_LOW);
                         }
                         z += 112;
-                        if (z <= gRideRatingsCalcData.Proximity.z)
+                        if (z <= _rideRatingsState->Proximity.z)
                         {
                             proximity_score_increment(PROXIMITY_WATER_HIGH);
                         }
@@ -707,20 +837,144 @@ static void ride_ratings_score_close_proximity(TileElement* inputTileElement)
     ride_ratings_score_close_proximity_in_direction(inputTileElement, (direction + 1) & 3);
     ride_ratings_score_close_proximity_in_direction(inputTileElement, (direction - 1) & 3);
     ride_ratings_score_close_proximity_loops(inputTileElement);
+}
 
-    switch (gRideRatingsCalcData.ProximityTrackType)
+static uint32_t ride_ratings_get_proximity_cache_index(const CoordsXY& loc)
+{
+    auto tileLoc = TileCoordsXY{ loc };
+    return tileLoc.y * MAXIMUM_MAP_SIZE_TECHNICAL + tileLoc.x;
+}
+
+static bool ride_ratings_proximity_cache_entry_matches(
+    const RideRatingsProximityCacheEntry& entry, const TileElement* inputTileElement, int32_t z)
+{
+    const auto* trackElement = inputTileElement->AsTrack();
+    return entry.Z == z && entry.RideIndex == trackElement->GetRideIndex()
+        && entry.TrackType == trackElement->GetTrackType() && entry.Direction == inputTileElement->GetDirection()
+        && entry.ClearanceHeight == inputTileElement->clearance_height;
+}
+
+static void ride_ratings_score_close_proximity(TileElement* inputTileElement)
+{
+    if (_rideRatingsState->StationFlags & RIDE_RATING_STATION_FLAG_NO_ENTRANCE)
+    {
+        return;
+    }
+
+    _rideRatingsState->ProximityTotal++;
+
+    // The side checks use the surface height found on the piece's own tile, an entry can only be reused if that does not
+    // fall back to the height left over from a previous piece.
+    const auto& loc = _rideRatingsState->Proximity;
+    const auto* surfaceElement = map_get_surface_element_at(loc);
+    bool cacheable = surfaceElement != nullptr && !surfaceElement->IsGhost();
+    auto cacheIndex = ride_ratings_get_proximity_cache_index(loc);
+    bool scored = false;
+    if (cacheable)
+    {
+        std::lock_guard<std::mutex> lock(_rideRatingsProximityCacheMutex);
+        auto it = _rideRatingsProximityCache.find(cacheIndex);
+        if (it != _rideRatingsProximityCache.end())
+        {
+            for (const auto& entry : it->second)
+            {
+                if (ride_ratings_proximity_cache_entry_matches(entry, inputTileElement, loc.z))
+                {
+                    for (int32_t i = 0; i < PROXIMITY_COUNT; i++)
+                    {
+                        _rideRatingsState->ProximityScores[i] += entry.Scores[i];
+                    }
+                    _rideRatingsState->ProximityBaseHeight = entry.SurfaceBaseHeight;
+                    scored = true;
+                    break;
+                }
+            }
+        }
+    }
+
+    if (!scored)
+    {
+        std::array<uint16_t, PROXIMITY_COUNT> previousScores;
+        std::copy_n(_rideRatingsState->ProximityScores, PROXIMITY_COUNT, previousScores.begin());
+
+        ride_ratings_score_close_proximity_tiles(inputTileElement);
+
+        if (cacheable)
+        {
+            RideRatingsProximityCacheEntry entry{};
+            entry.Z = loc.z;
+            entry.RideIndex = inputTileElement->AsTrack()->GetRideIndex();
+            entry.TrackType = inputTileElement->AsTrack()->GetTrackType();
+            entry.Direction = inputTileElement->GetDirection();
+            entry.ClearanceHeight = inputTileElement->clearance_height;
+            entry.SurfaceBaseHeight = _rideRatingsState->ProximityBaseHeight;
+            for (int32_t i = 0; i < PROXIMITY_COUNT; i++)
+            {
+                entry.Scores[i] = _rideRatingsState->ProximityScores[i] - previousScores[i];
+            }
+
+            std::lock_guard<std::mutex> lock(_rideRatingsProximityCacheMutex);
+            if (_rideRatingsProximityCacheSize >= MAX_PROXIMITY_CACHE_ENTRIES)
+            {
+                _rideRatingsProximityCache.clear();
+                _rideRatingsProximityCacheSize = 0;
+            }
+            _rideRatingsProximityCache[cacheIndex].push_back(entry);
+            _rideRatingsProximityCacheSize++;
+        }
+    }
+
+    switch (_rideRatingsState->ProximityTrackType)
     {
         case TrackElemType::Brakes:
-            gRideRatingsCalcData.AmountOfBrakes++;
+            _rideRatingsState->AmountOfBrakes++;
             break;
         case TrackElemType::LeftReverser:
         case TrackElemType::RightReverser:
-            gRideRatingsCalcData.AmountOfReversers++;
+            _rideRatingsState->AmountOfReversers++;
             break;
     }
 }
 
+void ride_ratings_proximity_cache_invalidate_tile(const CoordsXY& loc)
+{
+    std::lock_guard<std::mutex> lock(_rideRatingsProximityCacheMutex);
+    if (_rideRatingsProximityCache.empty())
+        return;
+
+    // A piece looks at the tiles next to it and the tile ahead of it
+    auto centre = TileCoordsXY{ loc };
+    for (int32_t y = centre.y - 1; y <= centre.y + 1; y++)
+    {
+        for (int32_t x = centre.x - 1; x <= centre.x + 1; x++)
+        {
+            if (x < 0 || y < 0 || x >= MAXIMUM_MAP_SIZE_TECHNICAL || y >= MAXIMUM_MAP_SIZE_TECHNICAL)
+                continue;
+
+            auto it = _rideRatingsProximityCache.find(y * MAXIMUM_MAP_SIZE_TECHNICAL + x);
+            if (it != _rideRatingsProximityCache.end())
+            {
+                _rideRatingsProximityCacheSize -= it->second.size();
+                _rideRatingsProximityCache.erase(it);
+            }
+        }
+    }
+}
+
+void ride_ratings_proximity_cache_invalidate_all()
+{
+    std::lock_guard<std::mutex> lock(_rideRatingsProximityCacheMutex);
+    _rideRatingsProximityCache.clear();
+    _rideRatingsProximityCacheSize = 0;
+}
+
 static void ride_ratings_calculate(Ride* ride)
+{
+    ride_ratings_calculate_base(ride);
+    ride_ratings_call_hook(ride);
+}
+
+static void ride_ratings_calculate_base(Ride* ride)
 {
     auto calcFunc = ride_ratings_get_calculate_func(ride->type);
     if (calcFunc != nullptr)
@@ -737,7 +991,10 @@ static void ride_ratings_calculate(Ride* ride)
         ride->ratings.nausea = max(0, ride->ratings.nausea);
     }
 #endif
+}
 
+static void ride_ratings_call_hook([[maybe_unused]] Ride* ride)
+{
 #ifdef ENABLE_SCRIPTING
     auto& hookEngine = GetContext()->GetScriptEngine().GetHookEngine();
     if (hookEngine.HasSubscriptions(HOOK_TYPE::RIDE_RATINGS_CALCULATE))
@@ -903,10 +1160,10 @@ static uint16_t ride_compute_upkeep(Ride* ride)
     {
         reverserMaintenanceCost = 10;
     }
-    upkeep += reverserMaintenanceCost * gRideRatingsCalcData.AmountOfReversers;
+    upkeep += reverserMaintenanceCost * _rideRatingsState->AmountOfReversers;
 
     // Add maintenance cost for brake track pieces
-    upkeep += 20 * gRideRatingsCalcData.AmountOfBrakes;
+    upkeep += 20 * _rideRatingsState->AmountOfBrakes;
 
     // these seem to be adhoc adjustments to a ride's upkeep/cost, times
     // various variables set on the ride itself.
@@ -1060,7 +1317,7 @@ static uint32_t get_proximity_score_helper_3(uint16_t x, uint16_t resultIfNotZer
  */
 static uint32_t ride_ratings_get_proximity_score()
 {
-    const uint16_t* scores = gRideRatingsCalcData.ProximityScores;
+    const uint16_t* scores = _rideRatingsState->ProximityScores;
 
     uint32_t result = 0;
     result += get_proximity_score_helper_1(scores[PROXIMITY_WATER_OVER], 60, 0x00AAAA);
@@ -3367,7 +3624,7 @@ void ride_ratings_calculate_reverser_roller_coaster(Ride* ride)
     ride_ratings_apply_max_speed(&ratings, ride, 44281, 88562, 35424);
     ride_ratings_apply_average_speed(&ratings, ride, 364088, 655360);
 
-    int32_t numReversers = std::min<uint16_t>(gRideRatingsCalcData.AmountOfReversers, 6);
+    int32_t numReversers = std::min<uint16_t>(_rideRatingsState->AmountOfReversers, 6);
     ride_rating reverserRating = numReversers * RIDE_RATING(0, 20);
     ride_ratings_add(&ratings, reverserRating, reverserRating, reverserRating);
 
@@ -3379,7 +3636,7 @@ void ride_ratings_calculate_reverser_roller_coaster(Ride* ride)
     ride_ratings_apply_proximity(&ratings, 22367);
     ride_ratings_apply_scenery(&ratings, ride, 11155);
 
-    if (gRideRatingsCalcData.AmountOfReversers < 1)
+    if (_rideRatingsState->AmountOfReversers < 1)
     {
         ratings.Excitement /= 8;
     }
@@ -13,6 +13,9 @@
 #include "../world/Location.hpp"
 #include "RideTypes.h"
 
+#include <chrono>
+#include <vector>
+
 using ride_rating = fixed16_2dp;
 using track_type_t = uint16_t;
 
@@ -56,9 +59,32 @@ struct RideRatingCalculationData
 
 extern RideRatingCalculationData gRideRatingsCalcData;
 
-void ride_ratings_update_ride(const Ride& ride);
+// The work done to rate a single ride to completion, filled in by ride_ratings_update_ride for the ride ratings benchmark
+struct RideRatingsMeasurement
+{
+    uint32_t StateUpdates{};
+    uint32_t TrackPieces{};
+    std::chrono::duration<double> ProximityTime{};
+    std::chrono::duration<double> CalculateTime{};
+};
+
+void ride_ratings_update_ride(const Ride& ride, RideRatingsMeasurement* measurement = nullptr);
 void ride_ratings_update_all();
 
+/**
+ * Calculates the ratings of the given rides to completion in one call, without disturbing the ride that is being rated
+ * incrementally by ride_ratings_update_all. With parallel set the rides are rated on a job pool, the resulting
+ * ratings are the same but this must only be used when the ratings do not have to stay in sync with other clients.
+ */
+void ride_ratings_update_rides(const std::vector<ride_id_t>& rides, bool parallel = false);
+
+/**
+ * The proximity scores of track pieces are cached between rating passes. These must be called whenever surface, path,
+ * track or scenery elements change, either around a known tile or anywhere on the map.
+ */
+void ride_ratings_proximity_cache_invalidate_tile(const CoordsXY& loc);
+void ride_ratings_proximity_cache_invalidate_all();
+
 using ride_ratings_calculation = void (*)(Ride* ride);
 ride_ratings_calculation ride_ratings_get_calculate_func(uint8_t rideType);
 
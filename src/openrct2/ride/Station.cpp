@@ -15,6 +15,8 @@
 #include "../world/Sprite.h"
 #include "Track.h"
 
+#include <array>
+
 static void ride_update_station_blocksection(Ride* ride, StationIndex stationIndex);
 static void ride_update_station_dodgems(Ride* ride, StationIndex stationIndex);
 static void ride_update_station_normal(Ride* ride, StationIndex stationIndex);
@@ -327,10 +329,8 @@ static void ride_invalidate_station_start(Ride* ride, StationIndex stationIndex,
     map_invalidate_tile_zoom1({ startPos, tileElement->GetBaseZ(), tileElement->GetClearanceZ() });
 }
 
-TileElement* ride_get_station_start_track_element(Ride* ride, StationIndex stationIndex)
+static TileElement* ride_find_station_start_track_element(const CoordsXYZ& stationStart)
 {
-    auto stationStart = ride->stations[stationIndex].GetStart();
-
     // Find the station track element
     TileElement* tileElement = map_get_first_element_at(stationStart);
     if (tileElement == nullptr)
@@ -345,6 +345,51 @@ TileElement* ride_get_station_start_track_element(Ride* ride, StationIndex stati
     return nullptr;
 }
 
+// The station start track elements of every ride, which guests, mechanics and the station updates look up all the
+// time. Entries are only used for the station start they were found at and while their generation is current.
+struct StationStartElementCacheEntry
+{
+    CoordsXYZ Start;
+    TileElement* Element;
+    uint32_t Generation;
+};
+
+static std::array<std::array<StationStartElementCacheEntry, MAX_STATIONS>, MAX_RIDES> _stationStartElementCache;
+// Zero is never used so that the zero initialised entries are not current
+static uint32_t _stationStartElementGeneration = 1;
+
+void ride_station_elements_invalidate()
+{
+    _stationStartElementGeneration++;
+    if (_stationStartElementGeneration == 0)
+    {
+        _stationStartElementGeneration = 1;
+        for (auto& rideEntries : _stationStartElementCache)
+        {
+            rideEntries.fill({});
+        }
+    }
+}
+
+TileElement* ride_get_station_start_track_element(Ride* ride, StationIndex stationIndex)
+{
+    auto stationStart = ride->stations[stationIndex].GetStart();
+    if (ride->id >= MAX_RIDES || stationIndex >= MAX_STATIONS)
+        return ride_find_station_start_track_element(stationStart);
+
+    // Plugins can change elements in place, so the element must still be the one the search would find
+    auto& entry = _stationStartElementCache[ride->id][stationIndex];
+    if (entry.Generation != _stationStartElementGeneration || entry.Start != stationStart
+        || (entry.Element != nullptr
+            && (entry.Element->GetType() != TILE_ELEMENT_TYPE_TRACK || entry.Element->GetBaseZ() != stationStart.z)))
+    {
+        entry.Start = stationStart;
+        entry.Element = ride_find_station_start_track_element(stationStart);
+        entry.Generation = _stationStartElementGeneration;
+    }
+    return entry.Element;
+}
+
 TileElement* ride_get_station_exit_element(const CoordsXYZ& elementPos)
 {
     // Find the station track element
@@ -513,6 +513,7 @@ bool track_add_station_element(CoordsXYZD loc, ride_id_t rideIndex, int32_t flag
                     targetTrackType = TrackElemType::MiddleStation;
                 }
                 stationElement->AsTrack()->SetTrackType(targetTrackType);
+                track_block_links_invalidate();
 
                 map_invalidate_element(loc, stationElement);
 
@@ -660,6 +661,7 @@ bool track_remove_station_element(const CoordsXYZD& loc, ride_id_t rideIndex, in
                     }
                 }
                 stationElement->AsTrack()->SetTrackType(targetTrackType);
+                track_block_links_invalidate();
 
                 map_invalidate_element(currentLoc, stationElement);
             }
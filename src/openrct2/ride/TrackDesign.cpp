@@ -62,13 +62,21 @@
 #include <algorithm>
 #include <iterator>
 #include <memory>
+#include <vector>
 
 using namespace OpenRCT2;
 using namespace OpenRCT2::Drawing;
 
+// The preview map is a flat surface element for every tile, followed by room for the elements of the design
+static constexpr size_t TRACK_PREVIEW_SURFACE_ELEMENTS = MAX_TILE_TILE_ELEMENT_POINTERS;
+static constexpr size_t TRACK_PREVIEW_SPARE_ELEMENTS = 16384;
+
 struct map_backup
 {
-    TileElement tile_elements[MAX_TILE_ELEMENTS];
+    // Only used when there is no room to build the preview map after the live elements
+    std::vector<TileElement> tile_elements;
+    TileElement* tile_elements_end;
+    bool sandboxed;
     TileElement* tile_pointers[MAX_TILE_TILE_ELEMENT_POINTERS];
     TileElement* next_free_tile_element;
     uint16_t map_size_units;
@@ -96,11 +104,14 @@ static bool _trackDesignPlaceStateHasScenery = false;
 static bool _trackDesignPlaceStatePlaceScenery = true;
 static bool _trackDesignPlaceIsReplay = false;
 
+// The paths of the design are connected together once all of them have been placed
+static std::vector<CoordsXYE> _trackDesignPathsToConnect;
+
 static std::unique_ptr<map_backup> track_design_preview_backup_map();
 
 static void track_design_preview_restore_map(map_backup* backup);
 
-static void track_design_preview_clear_map();
+static void track_design_preview_clear_map(map_backup* backup);
 
 rct_string_id TrackDesign::CreateTrackDesign(const Ride& ride)
 {
@@ -1218,25 +1229,7 @@ static bool TrackDesignPlaceSceneryElement(
                         return true;
                     }
 
-                    footpath_queue_chain_reset();
-                    footpath_remove_edges_at(mapCoord, reinterpret_cast<TileElement*>(pathElement));
-
-                    flags = GAME_COMMAND_FLAG_APPLY;
-                    if (_trackDesignPlaceOperation == PTD_OPERATION_PLACE_TRACK_PREVIEW)
-                    {
-                        flags = GAME_COMMAND_FLAG_APPLY | GAME_COMMAND_FLAG_ALLOW_DURING_PAUSED | GAME_COMMAND_FLAG_NO_SPEND;
-                    }
-                    if (_trackDesignPlaceOperation == PTD_OPERATION_PLACE_GHOST)
-                    {
-                        flags = GAME_COMMAND_FLAG_APPLY | GAME_COMMAND_FLAG_ALLOW_DURING_PAUSED | GAME_COMMAND_FLAG_NO_SPEND
-                            | GAME_COMMAND_FLAG_GHOST;
-                    }
-                    if (_trackDesignPlaceIsReplay)
-                    {
-                        flags |= GAME_COMMAND_FLAG_REPLAY;
-                    }
-                    footpath_connect_edges(mapCoord, reinterpret_cast<TileElement*>(pathElement), flags);
-                    footpath_update_queue_chains();
+                    _trackDesignPathsToConnect.push_back({ mapCoord, reinterpret_cast<TileElement*>(pathElement) });
                     return true;
                 }
                 break;
@@ -1265,6 +1258,25 @@ static bool TrackDesignPlaceSceneryElement(
     return true;
 }
 
+static void TrackDesignConnectPaths()
+{
+    int32_t flags = GAME_COMMAND_FLAG_APPLY;
+    if (_trackDesignPlaceOperation == PTD_OPERATION_PLACE_TRACK_PREVIEW)
+    {
+        flags = GAME_COMMAND_FLAG_APPLY | GAME_COMMAND_FLAG_ALLOW_DURING_PAUSED | GAME_COMMAND_FLAG_NO_SPEND;
+    }
+    if (_trackDesignPlaceOperation == PTD_OPERATION_PLACE_GHOST)
+    {
+        flags = GAME_COMMAND_FLAG_APPLY | GAME_COMMAND_FLAG_ALLOW_DURING_PAUSED | GAME_COMMAND_FLAG_NO_SPEND
+            | GAME_COMMAND_FLAG_GHOST;
+    }
+    if (_trackDesignPlaceIsReplay)
+    {
+        flags |= GAME_COMMAND_FLAG_REPLAY;
+    }
+    footpath_reconnect_edges(_trackDesignPathsToConnect, flags);
+}
+
 /**
  *
  *  rct2: 0x006D0964
@@ -1284,6 +1296,7 @@ static int32_t track_design_place_all_scenery(
             continue;
         }
 
+        _trackDesignPathsToConnect.clear();
         for (const auto& scenery : sceneryList)
         {
             uint8_t rotation = _currentTrackPieceDirection;
@@ -1299,6 +1312,11 @@ static int32_t track_design_place_all_scenery(
                 return 0;
             }
         }
+        if (!_trackDesignPathsToConnect.empty())
+        {
+            TrackDesignConnectPaths();
+            _trackDesignPathsToConnect.clear();
+        }
     }
     return 1;
 }
@@ -1990,7 +2008,7 @@ void track_design_draw_preview(TrackDesign* td6, uint8_t* pixels)
     {
         return;
     }
-    track_design_preview_clear_map();
+    track_design_preview_clear_map(mapBackup.get());
 
     if (gScreenFlags & SCREEN_FLAGS_TRACK_MANAGER)
     {
@@ -2091,7 +2109,8 @@ void track_design_draw_preview(TrackDesign* td6, uint8_t* pixels)
 
 /**
  * Create a backup of the map as it will be cleared for drawing the track
- * design preview.
+ * design preview. The preview map is normally built in the unused elements
+ * after the live ones, so only the tile pointers need to be kept.
  *  rct2: 0x006D1C68
  */
 static std::unique_ptr<map_backup> track_design_preview_backup_map()
@@ -2099,7 +2118,19 @@ static std::unique_ptr<map_backup> track_design_preview_backup_map()
     auto backup = std::make_unique<map_backup>();
     if (backup != nullptr)
     {
-        std::memcpy(backup->tile_elements, gTileElements, sizeof(backup->tile_elements));
+        size_t numLiveElements = map_get_tile_elements_end() - gTileElements;
+        size_t numSandboxElements = numLiveElements + TRACK_PREVIEW_SURFACE_ELEMENTS + TRACK_PREVIEW_SPARE_ELEMENTS;
+        backup->sandboxed = numSandboxElements <= MAX_TILE_ELEMENTS;
+
+        // The element list can not grow while the preview is placed as the backup points into it, so make room first
+        map_reserve_tile_elements(
+            backup->sandboxed ? numSandboxElements + (MAX_TILE_ELEMENTS_WITH_SPARE_ROOM - MAX_TILE_ELEMENTS)
+                              : MAX_TILE_ELEMENTS_WITH_SPARE_ROOM);
+        backup->tile_elements_end = map_get_tile_elements_end();
+        if (!backup->sandboxed)
+        {
+            backup->tile_elements.assign(gTileElements, backup->tile_elements_end);
+        }
         std::memcpy(backup->tile_pointers, gTileElementTilePointers, sizeof(backup->tile_pointers));
         backup->next_free_tile_element = gNextFreeTileElement;
         backup->map_size_units = gMapSizeUnits;
@@ -2116,20 +2147,31 @@ static std::unique_ptr<map_backup> track_design_preview_backup_map()
  */
 static void track_design_preview_restore_map(map_backup* backup)
 {
-    std::memcpy(gTileElements, backup->tile_elements, sizeof(backup->tile_elements));
+    if (backup->sandboxed)
+    {
+        // The live elements were never touched, clearing the preview map behind them is enough
+        map_set_tile_elements_end(backup->tile_elements_end);
+        map_set_reorganise_enabled(true);
+    }
+    else
+    {
+        std::copy(backup->tile_elements.begin(), backup->tile_elements.end(), gTileElements);
+        map_set_tile_elements_end(gTileElements + backup->tile_elements.size());
+    }
     std::memcpy(gTileElementTilePointers, backup->tile_pointers, sizeof(backup->tile_pointers));
     gNextFreeTileElement = backup->next_free_tile_element;
     gMapSizeUnits = backup->map_size_units;
     gMapSizeMinus2 = backup->map_size_units_minus_2;
     gMapSize = backup->map_size;
     gCurrentRotation = backup->current_rotation;
+    map_invalidate_tile_element_caches();
 }
 
 /**
  * Resets all the map elements to surface tiles for track preview.
  *  rct2: 0x006D1D9A
  */
-static void track_design_preview_clear_map()
+static void track_design_preview_clear_map(map_backup* backup)
 {
     // These values were previously allocated in backup map but
     // it seems more fitting to place in this function
@@ -2137,9 +2179,10 @@ static void track_design_preview_clear_map()
     gMapSizeMinus2 = (264 * 32) - 2;
     gMapSize = 256;
 
-    for (int32_t i = 0; i < MAX_TILE_TILE_ELEMENT_POINTERS; i++)
+    TileElement* surfaceElements = backup->sandboxed ? backup->tile_elements_end : gTileElements;
+    for (size_t i = 0; i < TRACK_PREVIEW_SURFACE_ELEMENTS; i++)
     {
-        TileElement* tile_element = &gTileElements[i];
+        TileElement* tile_element = &surfaceElements[i];
         tile_element->ClearAs(TILE_ELEMENT_TYPE_SURFACE);
         tile_element->SetLastForTile(true);
         tile_element->AsSurface()->SetSlope(TILE_ELEMENT_SLOPE_FLAT);
@@ -2150,7 +2193,24 @@ static void track_design_preview_clear_map()
         tile_element->AsSurface()->SetOwnership(OWNERSHIP_OWNED);
         tile_element->AsSurface()->SetParkFences(0);
     }
-    map_update_tile_pointers();
+
+    if (backup->sandboxed)
+    {
+        for (size_t i = 0; i < TRACK_PREVIEW_SURFACE_ELEMENTS; i++)
+        {
+            gTileElementTilePointers[i] = &surfaceElements[i];
+        }
+        gNextFreeTileElement = surfaceElements + TRACK_PREVIEW_SURFACE_ELEMENTS;
+        map_set_tile_elements_end(gNextFreeTileElement);
+
+        // Defragmenting would move the preview map over the live elements
+        map_set_reorganise_enabled(false);
+        map_invalidate_tile_element_caches();
+    }
+    else
+    {
+        map_update_tile_pointers();
+    }
 }
 
 bool track_design_are_entrance_and_exit_placed()
@@ -38,6 +38,7 @@ struct TrackRepositoryItem
     uint8_t RideType = RIDE_TYPE_NULL;
     std::string ObjectEntry;
     uint32_t Flags = 0;
+    TrackDesignFileStats Stats;
 };
 
 enum TRACK_REPO_ITEM_FLAGS
@@ -57,7 +58,7 @@ class TrackDesignFileIndex final : public FileIndex<TrackRepositoryItem>
 {
 private:
     static constexpr uint32_t MAGIC_NUMBER = 0x58444954; // TIDX
-    static constexpr uint16_t VERSION = 4;
+    static constexpr uint16_t VERSION = 5;
     static constexpr auto PATTERN = "*.td4;*.td6";
 
 public:
@@ -83,6 +84,7 @@ public:
             item.Path = path;
             item.RideType = td6->type;
             item.ObjectEntry = std::string(td6->vehicle_object.name, 8);
+            item.Stats = GetStats(*td6);
             item.Flags = 0;
             if (IsTrackReadOnly(path))
             {
@@ -104,9 +106,51 @@ protected:
         ds << item.RideType;
         ds << item.ObjectEntry;
         ds << item.Flags;
+
+        auto& stats = item.Stats;
+        ds << stats.type;
+        ds << stats.excitement;
+        ds << stats.intensity;
+        ds << stats.nausea;
+        ds << stats.max_speed;
+        ds << stats.average_speed;
+        ds << stats.ride_length;
+        ds << stats.max_positive_vertical_g;
+        ds << stats.max_negative_vertical_g;
+        ds << stats.max_lateral_g;
+        ds << stats.total_air_time;
+        ds << stats.inversions;
+        ds << stats.holes;
+        ds << stats.drops;
+        ds << stats.highest_drop_height;
+        ds << stats.space_required_x;
+        ds << stats.space_required_y;
     }
 
 private:
+    static TrackDesignFileStats GetStats(const TrackDesign& td6)
+    {
+        TrackDesignFileStats stats;
+        stats.type = td6.type;
+        stats.excitement = td6.excitement;
+        stats.intensity = td6.intensity;
+        stats.nausea = td6.nausea;
+        stats.max_speed = td6.max_speed;
+        stats.average_speed = td6.average_speed;
+        stats.ride_length = td6.ride_length;
+        stats.max_positive_vertical_g = td6.max_positive_vertical_g;
+        stats.max_negative_vertical_g = td6.max_negative_vertical_g;
+        stats.max_lateral_g = td6.max_lateral_g;
+        stats.total_air_time = td6.total_air_time;
+        stats.inversions = td6.inversions;
+        stats.holes = td6.holes;
+        stats.drops = td6.drops;
+        stats.highest_drop_height = td6.highest_drop_height;
+        stats.space_required_x = td6.space_required_x;
+        stats.space_required_y = td6.space_required_y;
+        return stats;
+    }
+
     bool IsTrackReadOnly(const std::string& path) const
     {
         return String::StartsWith(path, SearchPaths[0]) || String::StartsWith(path, SearchPaths[1]);
@@ -119,6 +163,7 @@ private:
     std::shared_ptr<IPlatformEnvironment> const _env;
     TrackDesignFileIndex const _fileIndex;
     std::vector<TrackRepositoryItem> _items;
+    bool _scanned{};
 
 public:
     explicit TrackDesignRepository(const std::shared_ptr<IPlatformEnvironment>& env)
@@ -130,6 +175,7 @@ public:
 
     size_t GetCount() const override
     {
+        EnsureScanned();
         return _items.size();
     }
 
@@ -140,6 +186,7 @@ public:
      */
     size_t GetCountForObjectEntry(uint8_t rideType, const std::string& entry) const override
     {
+        EnsureScanned();
         size_t count = 0;
         const auto& repo = GetContext()->GetObjectRepository();
 
@@ -174,6 +221,7 @@ public:
      */
     std::vector<track_design_file_ref> GetItemsForObjectEntry(uint8_t rideType, const std::string& entry) const override
     {
+        EnsureScanned();
         std::vector<track_design_file_ref> refs;
         const auto& repo = GetContext()->GetObjectRepository();
 
@@ -198,6 +246,7 @@ public:
                 track_design_file_ref ref;
                 ref.name = String::Duplicate(GetNameFromTrackPath(item.Path));
                 ref.path = String::Duplicate(item.Path);
+                ref.stats = item.Stats;
                 refs.push_back(ref);
             }
         }
@@ -208,6 +257,7 @@ public:
     void Scan(int32_t language) override
     {
         _items.clear();
+        _scanned = true;
         auto trackDesigns = _fileIndex.LoadOrBuild(language);
         for (const auto& td : trackDesigns)
         {
@@ -219,6 +269,7 @@ public:
 
     bool Delete(const std::string& path) override
     {
+        EnsureScanned();
         bool result = false;
         size_t index = GetTrackIndex(path);
         if (index != SIZE_MAX)
@@ -238,6 +289,7 @@ public:
 
     std::string Rename(const std::string& path, const std::string& newName) override
     {
+        EnsureScanned();
         std::string result;
         size_t index = GetTrackIndex(path);
         if (index != SIZE_MAX)
@@ -261,6 +313,7 @@ public:
 
     std::string Install(const std::string& path, const std::string& name) override
     {
+        EnsureScanned();
         std::string result;
         std::string installDir = _env->GetDirectoryPath(DIRBASE::USER, DIRID::TRACK);
 
@@ -280,6 +333,17 @@ public:
     }
 
 private:
+    /**
+     * The repository is only scanned once something asks for track designs, headless servers usually never do.
+     */
+    void EnsureScanned() const
+    {
+        if (!_scanned)
+        {
+            const_cast<TrackDesignRepository*>(this)->Scan(LocalisationService_GetCurrentLanguage());
+        }
+    }
+
     void SortItems()
     {
         std::sort(_items.begin(), _items.end(), [](const TrackRepositoryItem& a, const TrackRepositoryItem& b) -> bool {
@@ -13,10 +13,36 @@
 
 #include <memory>
 
+/**
+ * The ratings and statistics of a track design, these are kept in the track design index so they can be shown without
+ * reading the design file again.
+ */
+struct TrackDesignFileStats
+{
+    uint8_t type = 0;
+    uint8_t excitement = 0;
+    uint8_t intensity = 0;
+    uint8_t nausea = 0;
+    int8_t max_speed = 0;
+    int8_t average_speed = 0;
+    uint16_t ride_length = 0;
+    uint8_t max_positive_vertical_g = 0;
+    int8_t max_negative_vertical_g = 0;
+    uint8_t max_lateral_g = 0;
+    uint8_t total_air_time = 0;
+    uint8_t inversions = 0;
+    uint8_t holes = 0;
+    uint8_t drops = 0;
+    uint8_t highest_drop_height = 0;
+    uint8_t space_required_x = 0;
+    uint8_t space_required_y = 0;
+};
+
 struct track_design_file_ref
 {
     utf8* name;
     utf8* path;
+    TrackDesignFileStats stats;
 };
 
 #include <string>
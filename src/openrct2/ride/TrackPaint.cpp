@@ -27,6 +27,9 @@
 #include "TrackData.h"
 #include "TrackDesign.h"
 
+#include <array>
+#include <memory>
+
 // clang-format off
 /* rct2: 0x007667AC */
 static constexpr TileCoordsXY EntranceOffsetEdgeNE[] = {
@@ -2131,6 +2134,35 @@ void track_paint_util_left_corkscrew_up_supports(paint_session* session, Directi
     }
 }
 
+/**
+ * The paint functions of every track type of every ride type, resolved once from the getters of the ride types so a
+ * track element takes a single lookup to reach the function painting it.
+ */
+static TRACK_PAINT_FUNCTION get_track_paint_function(uint8_t rideType, track_type_t trackType)
+{
+    using TrackPaintFunctions = std::array<std::array<TRACK_PAINT_FUNCTION, TrackElemType::Count>, RIDE_TYPE_COUNT>;
+
+    // Columns are painted on several threads, the table is built by whichever gets here first
+    static const auto table = [] {
+        auto functions = std::make_unique<TrackPaintFunctions>();
+        for (size_t i = 0; i < RIDE_TYPE_COUNT; i++)
+        {
+            auto getter = RideTypeDescriptors[i].TrackPaintFunction;
+            for (track_type_t j = 0; j < TrackElemType::Count; j++)
+            {
+                (*functions)[i][j] = getter != nullptr ? getter(j) : nullptr;
+            }
+        }
+        return functions;
+    }();
+
+    if (rideType >= RIDE_TYPE_COUNT || trackType >= TrackElemType::Count)
+    {
+        return nullptr;
+    }
+    return (*table)[rideType][trackType];
+}
+
 /**
  *
  *  rct2: 0x006C4794
@@ -2190,18 +2222,10 @@ void track_paint(paint_session* session, Direction direction, int32_t height, co
             session->TrackColours[SCHEME_3] = ghost_id;
         }
 
-        if (ride->type >= RIDE_TYPE_COUNT)
+        TRACK_PAINT_FUNCTION paintFunction = get_track_paint_function(ride->type, trackType);
+        if (paintFunction != nullptr)
         {
-            return;
-        }
-        TRACK_PAINT_FUNCTION_GETTER paintFunctionGetter = ride->GetRideTypeDescriptor().TrackPaintFunction;
-        if (paintFunctionGetter != nullptr)
-        {
-            TRACK_PAINT_FUNCTION paintFunction = paintFunctionGetter(trackType);
-            if (paintFunction != nullptr)
-            {
-                paintFunction(session, rideIndex, trackSequence, direction, height, tileElement);
-            }
+            paintFunction(session, rideIndex, trackSequence, direction, height, tileElement);
         }
     }
 }
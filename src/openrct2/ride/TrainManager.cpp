@@ -19,14 +19,19 @@ namespace TrainManager
     {
         Entity = nullptr;
 
-        while (iter != end && Entity == nullptr)
+        while (next != SPRITE_INDEX_NULL && Entity == nullptr)
         {
-            Entity = GetEntity<Vehicle>(*iter++);
+            Entity = GetEntity<Vehicle>(next);
+            next = set->FindFrom(next + 1);
             if (Entity && !Entity->IsHead())
             {
                 Entity = nullptr;
             }
         }
+        if (next != SPRITE_INDEX_NULL)
+        {
+            PrefetchEntity(next);
+        }
         return *this;
     }
 
@@ -7,8 +7,9 @@
  * OpenRCT2 is licensed under the GNU General Public License version 3.
  *****************************************************************************/
 #pragma once
+#include "../world/EntityIndexSet.h"
+
 #include <cstdint>
-#include <list>
 
 struct Vehicle;
 
@@ -18,19 +19,19 @@ namespace TrainManager
     class View
     {
     private:
-        const std::list<uint16_t>* vec;
+        const EntityIndexSet* vec;
 
         class Iterator
         {
         private:
-            std::list<uint16_t>::const_iterator iter;
-            std::list<uint16_t>::const_iterator end;
+            const EntityIndexSet* set;
+            uint16_t next;
             Vehicle* Entity = nullptr;
 
         public:
-            Iterator(std::list<uint16_t>::const_iterator _iter, std::list<uint16_t>::const_iterator _end)
-                : iter(_iter)
-                , end(_end)
+            Iterator(const EntityIndexSet& _set, uint16_t _next)
+                : set(&_set)
+                , next(_next)
             {
                 ++(*this);
             }
@@ -67,11 +68,11 @@ namespace TrainManager
 
         Iterator begin()
         {
-            return Iterator(std::cbegin(*vec), std::cend(*vec));
+            return Iterator(*vec, vec->FindFrom(0));
         }
         Iterator end()
         {
-            return Iterator(std::cend(*vec), std::cend(*vec));
+            return Iterator(*vec, SPRITE_INDEX_NULL);
         }
     };
 } // namespace TrainManager
@@ -12,12 +12,14 @@
 #include "../Context.h"
 #include "../Editor.h"
 #include "../Game.h"
+#include "../GameState.h"
 #include "../OpenRCT2.h"
 #include "../actions/RideSetStatusAction.h"
 #include "../audio/AudioMixer.h"
 #include "../audio/audio.h"
 #include "../config/Config.h"
 #include "../core/Memory.hpp"
+#include "../core/Trace.h"
 #include "../interface/Viewport.h"
 #include "../localisation/Localisation.h"
 #include "../management/NewsItem.h"
@@ -26,6 +28,7 @@
 #include "../scenario/Scenario.h"
 #include "../util/Util.h"
 #include "../windows/Intent.h"
+#include "../world/EntityList.h"
 #include "../world/Map.h"
 #include "../world/MapAnimation.h"
 #include "../world/Park.h"
@@ -737,72 +740,36 @@ template<> bool SpriteBase::Is<Vehicle>() const
     return Type == EntityType::Vehicle;
 }
 
-static bool vehicle_move_info_valid(
-    VehicleTrackSubposition trackSubposition, track_type_t type, uint8_t direction, int32_t offset)
+/**
+ * Returns the list of positions along the given track piece, or nullptr if there is none.
+ */
+static const rct_vehicle_info_list* vehicle_get_move_info_list(
+    VehicleTrackSubposition trackSubposition, track_type_t type, uint8_t direction)
 {
     uint16_t typeAndDirection = (type << 2) | (direction & 3);
 
-    if (trackSubposition >= VehicleTrackSubposition{ std::size(gTrackVehicleInfo) })
-    {
-        return false;
-    }
-    int32_t size = 0;
-    switch (trackSubposition)
-    {
-        case VehicleTrackSubposition::Default:
-            size = VehicleTrackSubpositionSizeDefault;
-            break;
-        case VehicleTrackSubposition::ChairliftGoingOut:
-            size = 692;
-            break;
-        case VehicleTrackSubposition::ChairliftGoingBack:
-        case VehicleTrackSubposition::ChairliftEndBullwheel:
-        case VehicleTrackSubposition::ChairliftStartBullwheel:
-            size = 404;
-            break;
-        case VehicleTrackSubposition::GoKartsLeftLane:
-        case VehicleTrackSubposition::GoKartsRightLane:
-        case VehicleTrackSubposition::GoKartsMovingToRightLane:
-        case VehicleTrackSubposition::GoKartsMovingToLeftLane:
-            size = 208;
-            break;
-        case VehicleTrackSubposition::MiniGolfPathA9: // VehicleTrackSubposition::MiniGolfStart9
-        case VehicleTrackSubposition::MiniGolfBallPathA10:
-        case VehicleTrackSubposition::MiniGolfPathB11:
-        case VehicleTrackSubposition::MiniGolfBallPathB12:
-        case VehicleTrackSubposition::MiniGolfPathC13:
-        case VehicleTrackSubposition::MiniGolfBallPathC14:
-            size = 824;
-            break;
-        case VehicleTrackSubposition::ReverserRCFrontBogie:
-        case VehicleTrackSubposition::ReverserRCRearBogie:
-            size = 868;
-            break;
-        default:
-            break;
-    }
-    if (typeAndDirection >= size)
+    const auto subposition = static_cast<uint8_t>(trackSubposition);
+    if (subposition >= std::size(gTrackVehicleInfo))
     {
-        return false;
+        return nullptr;
     }
-    if (offset >= gTrackVehicleInfo[static_cast<uint8_t>(trackSubposition)][typeAndDirection]->size)
+    if (typeAndDirection >= gTrackVehicleInfoListSizes[subposition])
     {
-        return false;
+        return nullptr;
     }
-    return true;
+    return gTrackVehicleInfo[subposition][typeAndDirection];
 }
 
 static const rct_vehicle_info* vehicle_get_move_info(
     VehicleTrackSubposition trackSubposition, track_type_t type, uint8_t direction, int32_t offset)
 {
-    uint16_t typeAndDirection = (type << 2) | (direction & 3);
-
-    if (!vehicle_move_info_valid(trackSubposition, type, direction, offset))
+    const auto* list = vehicle_get_move_info_list(trackSubposition, type, direction);
+    if (list == nullptr || offset >= list->size)
     {
         static constexpr const rct_vehicle_info zero = {};
         return &zero;
     }
-    return &gTrackVehicleInfo[static_cast<uint8_t>(trackSubposition)][typeAndDirection]->info[offset];
+    return &list->info[offset];
 }
 
 const rct_vehicle_info* Vehicle::GetMoveInfo() const
@@ -812,13 +779,12 @@ const rct_vehicle_info* Vehicle::GetMoveInfo() const
 
 static uint16_t vehicle_get_move_info_size(VehicleTrackSubposition trackSubposition, track_type_t type, uint8_t direction)
 {
-    uint16_t typeAndDirection = (type << 2) | (direction & 3);
-
-    if (!vehicle_move_info_valid(trackSubposition, type, direction, 0))
+    const auto* list = vehicle_get_move_info_list(trackSubposition, type, direction);
+    if (list == nullptr)
     {
         return 0;
     }
-    return gTrackVehicleInfo[static_cast<uint8_t>(trackSubposition)][typeAndDirection]->size;
+    return list->size;
 }
 
 uint16_t Vehicle::GetTrackProgress() const
@@ -1282,6 +1248,95 @@ static void UpdateSound(
     }
 }
 
+/**
+ * Returns the range of map coordinates that can hold a train heard in the listening viewport, which is the area
+ * Vehicle::SoundCanPlay tests the sprite bounds against, widened by the largest sprite and projected back over
+ * every height a vehicle can be at.
+ */
+static MapRange vehicle_sounds_get_audible_range()
+{
+    // Largest distance of sprite bounds from the position of the entity, the sprite sizes are stored as bytes
+    constexpr int32_t spriteMargin = 256;
+
+    auto* viewport = g_music_tracking_viewport;
+    int32_t left = viewport->viewPos.x - spriteMargin;
+    int32_t top = viewport->viewPos.y - spriteMargin;
+    int32_t right = viewport->viewPos.x + viewport->view_width + spriteMargin;
+    int32_t bottom = viewport->viewPos.y + viewport->view_height + spriteMargin;
+    if (window_get_classification(gWindowAudioExclusive) == WC_MAIN_WINDOW)
+    {
+        left -= viewport->view_width / 4;
+        top -= viewport->view_height / 4;
+        right += viewport->view_width / 4;
+        bottom += viewport->view_height / 4;
+    }
+
+    // The projection is linear, so the corners of the view at the lowest and highest height bound the range
+    CoordsXY min = { INT32_MAX, INT32_MAX };
+    CoordsXY max = { INT32_MIN, INT32_MIN };
+    for (int32_t z : { 0, MAX_ELEMENT_HEIGHT * COORDS_Z_STEP })
+    {
+        for (const auto& corner : { ScreenCoordsXY{ left, top }, ScreenCoordsXY{ right, top },
+                                    ScreenCoordsXY{ left, bottom }, ScreenCoordsXY{ right, bottom } })
+        {
+            auto pos = viewport_coord_to_map_coord(corner, z);
+            min = { std::min(min.x, pos.x), std::min(min.y, pos.y) };
+            max = { std::max(max.x, pos.x), std::max(max.y, pos.y) };
+        }
+    }
+    return { min.x, min.y, max.x, max.y };
+}
+
+/**
+ * Calls UpdateSoundParams for every train that may be heard. When the audible part of the map holds fewer tiles than
+ * there are vehicles, only the trains found there through the spatial index are visited, in the same order as a walk
+ * over all trains so the same sounds get picked.
+ */
+static void vehicle_sounds_update_params(std::vector<OpenRCT2::Audio::VehicleSoundParams>& vehicleSoundParamsList)
+{
+    // Without a listening viewport no vehicle can be heard
+    if (g_music_tracking_viewport == nullptr)
+        return;
+
+    constexpr int32_t maxTile = MAXIMUM_MAP_SIZE_TECHNICAL - 1;
+    auto range = vehicle_sounds_get_audible_range();
+    const int32_t tileLeft = std::clamp(range.GetLeft() / COORDS_XY_STEP, 0, maxTile);
+    const int32_t tileRight = std::clamp(range.GetRight() / COORDS_XY_STEP, 0, maxTile);
+    const int32_t tileTop = std::clamp(range.GetTop() / COORDS_XY_STEP, 0, maxTile);
+    const int32_t tileBottom = std::clamp(range.GetBottom() / COORDS_XY_STEP, 0, maxTile);
+    const int32_t numTiles = (tileRight - tileLeft + 1) * (tileBottom - tileTop + 1);
+    if (numTiles >= GetEntityListCount(EntityType::Vehicle))
+    {
+        for (auto vehicle : TrainManager::View())
+        {
+            vehicle->UpdateSoundParams(vehicleSoundParamsList);
+        }
+        return;
+    }
+
+    static std::vector<Vehicle*> trains;
+    trains.clear();
+    for (int32_t tileX = tileLeft; tileX <= tileRight; tileX++)
+    {
+        for (int32_t tileY = tileTop; tileY <= tileBottom; tileY++)
+        {
+            for (auto* vehicle : EntityTileList<Vehicle>(TileCoordsXY{ tileX, tileY }.ToCoordsXY()))
+            {
+                if (vehicle->IsHead())
+                {
+                    trains.push_back(vehicle);
+                }
+            }
+        }
+    }
+    std::sort(
+        trains.begin(), trains.end(), [](const Vehicle* a, const Vehicle* b) { return a->sprite_index < b->sprite_index; });
+    for (auto* vehicle : trains)
+    {
+        vehicle->UpdateSoundParams(vehicleSoundParamsList);
+    }
+}
+
 /**
  *
  *  rct2: 0x006BBC6B
@@ -1295,11 +1350,7 @@ void vehicle_sounds_update()
     vehicleSoundParamsList.reserve(OpenRCT2::Audio::MaxVehicleSounds);
 
     vehicle_sounds_update_window_setup();
-
-    for (auto vehicle : TrainManager::View())
-    {
-        vehicle->UpdateSoundParams(vehicleSoundParamsList);
-    }
+    vehicle_sounds_update_params(vehicleSoundParamsList);
 
     // Stop all playing sounds that no longer have priority to play after vehicle_update_sound_params
     for (auto& vehicle_sound : OpenRCT2::Audio::gVehicleSoundList)
@@ -1373,15 +1424,22 @@ void vehicle_sounds_update()
  */
 void vehicle_update_all()
 {
+    TRACE_ZONE("Vehicle update");
     if (gScreenFlags & SCREEN_FLAGS_SCENARIO_EDITOR)
         return;
 
     if ((gScreenFlags & SCREEN_FLAGS_TRACK_DESIGNER) && gS6Info.editor_step != EditorStep::RollercoasterDesigner)
         return;
 
+    uint32_t numTrains = 0;
     for (auto vehicle : TrainManager::View())
     {
         vehicle->Update();
+        numTrains++;
+    }
+    if (OpenRCT2::gLogicCounters != nullptr)
+    {
+        OpenRCT2::gLogicCounters->TrainsUpdated += numTrains;
     }
 }
 
@@ -7745,21 +7803,13 @@ bool Vehicle::UpdateMotionCollisionDetection(const CoordsXYZ& loc, uint16_t* oth
             if (vehicle2 == this)
                 continue;
 
+            // Broadphase: reject by position first, these checks are cheap compared to looking up the vehicle entry
+            // and do not depend on it so the first vehicle found is the same regardless of the order of the checks.
             int32_t z_diff = abs(vehicle2->z - loc.z);
 
             if (z_diff > 16)
                 continue;
 
-            if (vehicle2->ride_subtype == RIDE_ENTRY_INDEX_NULL)
-                continue;
-
-            auto collideVehicleEntry = vehicle2->Entry();
-            if (collideVehicleEntry == nullptr)
-                continue;
-
-            if (!(collideVehicleEntry->flags & VEHICLE_ENTRY_FLAG_BOAT_HIRE_COLLISION_DETECTION))
-                continue;
-
             uint32_t x_diff = abs(vehicle2->x - loc.x);
             if (x_diff > 0x7FFF)
                 continue;
@@ -7768,6 +7818,12 @@ bool Vehicle::UpdateMotionCollisionDetection(const CoordsXYZ& loc, uint16_t* oth
             if (y_diff > 0x7FFF)
                 continue;
 
+            uint32_t ecx = var_44 + vehicle2->var_44;
+            ecx = ((ecx >> 1) * 30) >> 8;
+
+            if (x_diff + y_diff >= ecx)
+                continue;
+
             VehicleTrackSubposition cl = std::min(TrackSubposition, vehicle2->TrackSubposition);
             VehicleTrackSubposition ch = std::max(TrackSubposition, vehicle2->TrackSubposition);
             if (cl != ch)
@@ -7776,10 +7832,14 @@ bool Vehicle::UpdateMotionCollisionDetection(const CoordsXYZ& loc, uint16_t* oth
                     continue;
             }
 
-            uint32_t ecx = var_44 + vehicle2->var_44;
-            ecx = ((ecx >> 1) * 30) >> 8;
+            if (vehicle2->ride_subtype == RIDE_ENTRY_INDEX_NULL)
+                continue;
 
-            if (x_diff + y_diff >= ecx)
+            auto collideVehicleEntry = vehicle2->Entry();
+            if (collideVehicleEntry == nullptr)
+                continue;
+
+            if (!(collideVehicleEntry->flags & VEHICLE_ENTRY_FLAG_BOAT_HIRE_COLLISION_DETECTION))
                 continue;
 
             if (!(collideVehicleEntry->flags & VEHICLE_ENTRY_FLAG_GO_KART))
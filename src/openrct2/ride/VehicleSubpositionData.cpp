@@ -25843,4 +25843,24 @@ constexpr const rct_vehicle_info_list * const * gTrackVehicleInfo[static_cast<ui
     TrackVehicleInfoListReverserRCRearBogie,      // VehicleTrackSubposition::ReverserRCRearBogie
 };
 
+constexpr const uint16_t gTrackVehicleInfoListSizes[static_cast<uint8_t>(VehicleTrackSubposition::Count)] = {
+    static_cast<uint16_t>(std::size(TrackVehicleInfoListDefault)),
+    static_cast<uint16_t>(std::size(TrackVehicleInfoListChairliftGoingOut)),
+    static_cast<uint16_t>(std::size(TrackVehicleInfoListChairliftGoingBack)),
+    static_cast<uint16_t>(std::size(TrackVehicleInfoListChairliftEndBullwheel)),
+    static_cast<uint16_t>(std::size(TrackVehicleInfoListChairliftStartBullwheel)),
+    static_cast<uint16_t>(std::size(TrackVehicleInfoListGoKartsLeftLane)),
+    static_cast<uint16_t>(std::size(TrackVehicleInfoListGoKartsRightLane)),
+    static_cast<uint16_t>(std::size(TrackVehicleInfoListGoKartsMovingToRightLane)),
+    static_cast<uint16_t>(std::size(TrackVehicleInfoListGoKartsMovingToLeftLane)),
+    static_cast<uint16_t>(std::size(TrackVehicleInfoListMiniGolfStartPathA9)),
+    static_cast<uint16_t>(std::size(TrackVehicleInfoListMiniGolfBallPathA10)),
+    static_cast<uint16_t>(std::size(TrackVehicleInfoListMiniGolfPathB11)),
+    static_cast<uint16_t>(std::size(TrackVehicleInfoListMiniGolfBallPathB12)),
+    static_cast<uint16_t>(std::size(TrackVehicleInfoListMiniGolfPathC13)),
+    static_cast<uint16_t>(std::size(TrackVehicleInfoListMiniGolfPathC14)),
+    static_cast<uint16_t>(std::size(TrackVehicleInfoListReverserRCFrontBogie)),
+    static_cast<uint16_t>(std::size(TrackVehicleInfoListReverserRCRearBogie)),
+};
+
 // clang-format on
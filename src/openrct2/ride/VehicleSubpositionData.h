@@ -50,3 +50,5 @@ struct rct_vehicle_info_list
 };
 
 extern const rct_vehicle_info_list* const* const gTrackVehicleInfo[EnumValue(VehicleTrackSubposition::Count)];
+// The number of track type and direction combinations in each list of gTrackVehicleInfo
+extern const uint16_t gTrackVehicleInfoListSizes[EnumValue(VehicleTrackSubposition::Count)];
@@ -25,6 +25,8 @@
 #include "../world/Map.h"
 #include "../world/MapAnimation.h"
 
+#include <functional>
+
 using random_engine_t = Random::Rct2::Engine;
 
 enum class EditorStep : uint8_t;
@@ -297,11 +299,15 @@ struct rct_s6_data
     uint32_t rct1_scenario_flags;      // Unused in RCT2
     uint16_t wide_path_tile_loop_x;
     uint16_t wide_path_tile_loop_y;
-    uint8_t pad_13CE778[434];
+    uint16_t pathfinding_budget; // OpenRCT2: guest pathfinding searches per tick, 0 for no limit
+    uint8_t pad_13CE77A[432];
 };
 assert_struct_size(rct_s6_data, 0x46b44a);
 #pragma pack(pop)
 
+// Size of the park state, SC6[6] of a saved game, which starts at rct_s6_data::next_free_tile_element_pointer_index
+constexpr uint32_t RCT2_S6_PARK_STATE_SIZE = 0x2E8570;
+
 enum
 {
     SCENARIO_FLAGS_VISIBLE = (1 << 0),
@@ -461,6 +467,10 @@ uint32_t scenario_rand_max(uint32_t max);
 
 bool scenario_prepare_for_save();
 int32_t scenario_save(const utf8* path, int32_t flags);
+bool scenario_save_in_background(
+    const utf8* path, int32_t flags, std::function<void(bool success)> onComplete = nullptr);
+void scenario_wait_for_background_saves();
+void scenario_complete_background_saves();
 void scenario_remove_trackless_rides(rct_s6_data* s6);
 void scenario_fix_ghosts(rct_s6_data* s6);
 void scenario_failure();
@@ -11,6 +11,7 @@
 
 #include "../Context.h"
 #include "../Game.h"
+#include "../ParkFile.h"
 #include "../ParkImporter.h"
 #include "../PlatformEnvironment.h"
 #include "../config/Config.h"
@@ -18,6 +19,7 @@
 #include "../core/File.h"
 #include "../core/FileIndex.hpp"
 #include "../core/FileStream.h"
+#include "../core/JobPool.h"
 #include "../core/MemoryStream.h"
 #include "../core/Path.hpp"
 #include "../core/String.hpp"
@@ -32,6 +34,8 @@
 
 #include <algorithm>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <vector>
 
 using namespace OpenRCT2;
@@ -129,8 +133,8 @@ class ScenarioFileIndex final : public FileIndex<scenario_index_entry>
 {
 private:
     static constexpr uint32_t MAGIC_NUMBER = 0x58444953; // SIDX
-    static constexpr uint16_t VERSION = 5;
-    static constexpr auto PATTERN = "*.sc4;*.sc6;*.sea";
+    static constexpr uint16_t VERSION = 6;
+    static constexpr auto PATTERN = "*.sc4;*.sc6;*.sea;*.park";
 
 public:
     explicit ScenarioFileIndex(const IPlatformEnvironment& env)
@@ -225,14 +229,29 @@ private:
             }
             else
             {
-                // RCT2 or RCTC scenario
+                // RCT2 or RCTC scenario, or an OpenRCT2 park file
                 auto stream = GetStreamFromRCT2Scenario(path);
-                auto chunkReader = SawyerChunkReader(stream.get());
+                rct_s6_header header{};
+                rct_s6_info info{};
+                if (ParkFileReader::IsParkFile(stream.get()))
+                {
+                    // Only the header and info chunks are decoded, the rest of the park is never read
+                    auto parkFileReader = ParkFileReader(stream.get());
+                    parkFileReader.ReadChunk(ParkFileChunkType::Header, &header, sizeof(header));
+                    parkFileReader.ReadChunk(ParkFileChunkType::Info, &info, sizeof(info));
+                }
+                else
+                {
+                    auto chunkReader = SawyerChunkReader(stream.get());
+                    header = chunkReader.ReadChunkAs<rct_s6_header>();
+                    if (header.type == S6_TYPE_SCENARIO)
+                    {
+                        info = chunkReader.ReadChunkAs<rct_s6_info>();
+                    }
+                }
 
-                rct_s6_header header = chunkReader.ReadChunkAs<rct_s6_header>();
                 if (header.type == S6_TYPE_SCENARIO)
                 {
-                    rct_s6_info info = chunkReader.ReadChunkAs<rct_s6_info>();
                     // If the name or the details contain a colour code, they might be in UTF-8 already.
                     // This is caused by a bug that was in OpenRCT2 for 3 years.
                     if (!IsLikelyUTF8(info.name) && !IsLikelyUTF8(info.details))
@@ -324,6 +343,13 @@ private:
     ScenarioFileIndex const _fileIndex;
     std::vector<scenario_index_entry> _scenarios;
     std::vector<scenario_highscore_entry*> _highscores;
+    bool _scanned{};
+
+    // Background rescans, the results are swapped in by PollScan on the main thread
+    std::mutex _scanMutex;
+    std::optional<std::vector<scenario_index_entry>> _scanResult;
+    bool _scanPending{};
+    std::unique_ptr<JobPool> _scanJobs;
 
 public:
     explicit ScenarioRepository(const std::shared_ptr<IPlatformEnvironment>& env)
@@ -334,35 +360,75 @@ public:
 
     virtual ~ScenarioRepository()
     {
+        // The scan task refers to this repository
+        _scanJobs = nullptr;
         ClearHighscores();
     }
 
     void Scan(int32_t language) override
     {
+        // A background scan may still be writing the index, wait for it and drop its results in favour of this scan
+        if (_scanJobs != nullptr)
+        {
+            _scanJobs->Join();
+        }
+        {
+            std::lock_guard<std::mutex> lock(_scanMutex);
+            _scanResult.reset();
+            _scanPending = false;
+        }
+
         ImportMegaPark();
+        SetScenarios(_fileIndex.LoadOrBuild(language));
+    }
 
-        // Reload scenarios from index
-        _scenarios.clear();
-        auto scenarios = _fileIndex.LoadOrBuild(language);
-        for (const auto& scenario : scenarios)
+    void ScanAsync(int32_t language) override
+    {
         {
-            AddScenario(scenario);
+            std::lock_guard<std::mutex> lock(_scanMutex);
+            if (_scanPending)
+                return;
+            _scanPending = true;
         }
 
-        // Sort the scenarios and load the highscores
-        Sort();
-        LoadScores();
-        LoadLegacyScores();
-        AttachHighscores();
+        if (_scanJobs == nullptr)
+        {
+            _scanJobs = std::make_unique<JobPool>(1);
+        }
+        _scanJobs->AddTask([this, language]() {
+            ImportMegaPark();
+            auto scenarios = _fileIndex.LoadOrBuild(language);
+
+            std::lock_guard<std::mutex> lock(_scanMutex);
+            _scanResult = std::move(scenarios);
+        });
+    }
+
+    bool PollScan() override
+    {
+        std::vector<scenario_index_entry> scenarios;
+        {
+            std::lock_guard<std::mutex> lock(_scanMutex);
+            if (!_scanResult.has_value())
+                return false;
+
+            scenarios = std::move(*_scanResult);
+            _scanResult.reset();
+            _scanPending = false;
+        }
+        SetScenarios(scenarios);
+        return true;
     }
 
     size_t GetCount() const override
     {
+        EnsureScanned();
         return _scenarios.size();
     }
 
     const scenario_index_entry* GetByIndex(size_t index) const override
     {
+        EnsureScanned();
         const scenario_index_entry* result = nullptr;
         if (index < _scenarios.size())
         {
@@ -373,6 +439,7 @@ public:
 
     const scenario_index_entry* GetByFilename(const utf8* filename) const override
     {
+        EnsureScanned();
         for (const auto& scenario : _scenarios)
         {
             const utf8* scenarioFilename = Path::GetFileName(scenario.path);
@@ -388,6 +455,7 @@ public:
 
     const scenario_index_entry* GetByInternalName(const utf8* name) const override
     {
+        EnsureScanned();
         for (size_t i = 0; i < _scenarios.size(); i++)
         {
             const scenario_index_entry* scenario = &_scenarios[i];
@@ -406,6 +474,7 @@ public:
 
     const scenario_index_entry* GetByPath(const utf8* path) const override
     {
+        EnsureScanned();
         for (const auto& scenario : _scenarios)
         {
             if (Path::Equals(path, scenario.path))
@@ -456,6 +525,17 @@ public:
     }
 
 private:
+    /**
+     * The repository is only scanned once something asks for scenarios, headless servers usually never do.
+     */
+    void EnsureScanned() const
+    {
+        if (!_scanned)
+        {
+            const_cast<ScenarioRepository*>(this)->Scan(LocalisationService_GetCurrentLanguage());
+        }
+    }
+
     scenario_index_entry* GetByFilename(const utf8* filename)
     {
         const ScenarioRepository* repo = this;
@@ -513,6 +593,23 @@ private:
         File::WriteAllBytes(dstPath, mpdat.data(), mpdat.size());
     }
 
+    void SetScenarios(const std::vector<scenario_index_entry>& scenarios)
+    {
+        // Reload scenarios from index
+        _scanned = true;
+        _scenarios.clear();
+        for (const auto& scenario : scenarios)
+        {
+            AddScenario(scenario);
+        }
+
+        // Sort the scenarios and load the highscores
+        Sort();
+        LoadScores();
+        LoadLegacyScores();
+        AttachHighscores();
+    }
+
     void AddScenario(const scenario_index_entry& entry)
     {
         auto filename = Path::GetFileName(entry.path);
@@ -753,6 +850,18 @@ void scenario_repository_scan()
     repo->Scan(LocalisationService_GetCurrentLanguage());
 }
 
+void scenario_repository_scan_async()
+{
+    IScenarioRepository* repo = GetScenarioRepository();
+    repo->ScanAsync(LocalisationService_GetCurrentLanguage());
+}
+
+bool scenario_repository_poll_scan()
+{
+    IScenarioRepository* repo = GetScenarioRepository();
+    return repo->PollScan();
+}
+
 size_t scenario_repository_get_count()
 {
     IScenarioRepository* repo = GetScenarioRepository();
@@ -60,6 +60,16 @@ struct IScenarioRepository
      * Scans the scenario directories and grabs the metadata for all the scenarios.
      */
     virtual void Scan(int32_t language) abstract;
+    /**
+     * Starts scanning the scenario directories on a background thread, the current scenarios stay available until the
+     * results are applied by PollScan. Does nothing if a background scan is already in progress.
+     */
+    virtual void ScanAsync(int32_t language) abstract;
+    /**
+     * Replaces the scenarios with the results of a finished background scan. Returns true if they were replaced, which
+     * invalidates all previously returned scenario entries.
+     */
+    virtual bool PollScan() abstract;
 
     virtual size_t GetCount() const abstract;
     virtual const scenario_index_entry* GetByIndex(size_t index) const abstract;
@@ -78,6 +88,8 @@ std::unique_ptr<IScenarioRepository> CreateScenarioRepository(const std::shared_
 IScenarioRepository* GetScenarioRepository();
 
 void scenario_repository_scan();
+void scenario_repository_scan_async();
+bool scenario_repository_poll_scan();
 size_t scenario_repository_get_count();
 const scenario_index_entry* scenario_repository_get_by_index(size_t index);
 bool scenario_repository_try_record_highscore(const utf8* scenarioFileName, money32 companyValue, const utf8* name);
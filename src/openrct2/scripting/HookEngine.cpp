@@ -83,16 +83,12 @@ void HookEngine::UnsubscribeAll()
         auto& hooks = hookList.Hooks;
         hooks.clear();
     }
-}
-
-bool HookEngine::HasSubscriptions(HOOK_TYPE type) const
-{
-    auto& hookList = GetHookList(type);
-    return !hookList.Hooks.empty();
+    _queuedCalls.clear();
 }
 
 void HookEngine::Call(HOOK_TYPE type, bool isGameStateMutable)
 {
+    ScriptEngine::PluginCallScope callScope(_scriptEngine, PluginCallType::Hook, type);
     auto& hookList = GetHookList(type);
     for (auto& hook : hookList.Hooks)
     {
@@ -102,6 +98,7 @@ void HookEngine::Call(HOOK_TYPE type, bool isGameStateMutable)
 
 void HookEngine::Call(HOOK_TYPE type, const DukValue& arg, bool isGameStateMutable)
 {
+    ScriptEngine::PluginCallScope callScope(_scriptEngine, PluginCallType::Hook, type);
     auto& hookList = GetHookList(type);
     for (auto& hook : hookList.Hooks)
     {
@@ -112,6 +109,7 @@ void HookEngine::Call(HOOK_TYPE type, const DukValue& arg, bool isGameStateMutab
 void HookEngine::Call(
     HOOK_TYPE type, const std::initializer_list<std::pair<std::string_view, std::any>>& args, bool isGameStateMutable)
 {
+    ScriptEngine::PluginCallScope callScope(_scriptEngine, PluginCallType::Hook, type);
     auto& hookList = GetHookList(type);
     for (auto& hook : hookList.Hooks)
     {
@@ -144,6 +142,22 @@ void HookEngine::Call(
     }
 }
 
+void HookEngine::Queue(HOOK_TYPE type, const DukValue& arg, bool isGameStateMutable)
+{
+    _queuedCalls.push_back({ type, arg, isGameStateMutable });
+}
+
+void HookEngine::CallQueued()
+{
+    // Hooks may cause new calls to be queued, those wait for the next tick
+    auto queuedCalls = std::move(_queuedCalls);
+    _queuedCalls.clear();
+    for (const auto& queuedCall : queuedCalls)
+    {
+        Call(queuedCall.Type, queuedCall.Arg, queuedCall.IsGameStateMutable);
+    }
+}
+
 HookList& HookEngine::GetHookList(HOOK_TYPE type)
 {
     auto index = static_cast<size_t>(type);
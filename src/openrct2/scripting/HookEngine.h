@@ -69,11 +69,19 @@ namespace OpenRCT2::Scripting
         HookList(HookList&& src) = default;
     };
 
+    struct QueuedHookCall
+    {
+        HOOK_TYPE Type{};
+        DukValue Arg;
+        bool IsGameStateMutable{};
+    };
+
     class HookEngine
     {
     private:
         ScriptEngine& _scriptEngine;
         std::vector<HookList> _hookMap;
+        std::vector<QueuedHookCall> _queuedCalls;
         uint32_t _nextCookie = 1;
 
     public:
@@ -83,12 +91,23 @@ namespace OpenRCT2::Scripting
         void Unsubscribe(HOOK_TYPE type, uint32_t cookie);
         void UnsubscribeAll(std::shared_ptr<const Plugin> owner);
         void UnsubscribeAll();
-        bool HasSubscriptions(HOOK_TYPE type) const;
+        bool HasSubscriptions(HOOK_TYPE type) const
+        {
+            // Checked before any arguments are built, keep this cheap enough for the hottest paths
+            return !_hookMap[static_cast<size_t>(type)].Hooks.empty();
+        }
         void Call(HOOK_TYPE type, bool isGameStateMutable);
         void Call(HOOK_TYPE type, const DukValue& arg, bool isGameStateMutable);
         void Call(
             HOOK_TYPE type, const std::initializer_list<std::pair<std::string_view, std::any>>& args, bool isGameStateMutable);
 
+        /**
+         * Defers a call until CallQueued, which is done once per tick. Only for hooks that are notified of frequent
+         * events and whose handlers can not change the outcome of the event.
+         */
+        void Queue(HOOK_TYPE type, const DukValue& arg, bool isGameStateMutable);
+        void CallQueued();
+
     private:
         HookList& GetHookList(HOOK_TYPE type);
         const HookList& GetHookList(HOOK_TYPE type) const;
@@ -11,17 +11,144 @@
 
 #    include "Plugin.h"
 
+#    include "../Context.h"
 #    include "../Diagnostic.h"
 #    include "../OpenRCT2.h"
+#    include "../PlatformEnvironment.h"
 #    include "../core/File.h"
+#    include "../core/Path.hpp"
+#    include "../core/String.hpp"
 #    include "Duktape.hpp"
 
 #    include <algorithm>
+#    include <cinttypes>
+#    include <cstring>
 #    include <fstream>
 #    include <memory>
+#    include <unordered_map>
 
+using namespace OpenRCT2;
 using namespace OpenRCT2::Scripting;
 
+static constexpr uint32_t BYTECODE_CACHE_MAGIC = 0x43504F52; // ROPC
+
+struct BytecodeCacheHeader
+{
+    uint32_t Magic;
+    uint32_t DuktapeVersion;
+    uint64_t CodeLength;
+};
+
+// Compiled plugin code by hash, so that the plugins of a server are only compiled on the first join
+static std::unordered_map<uint64_t, std::vector<uint8_t>> _bytecodeCache;
+
+static uint64_t GetCodeHash(std::string_view code)
+{
+    // FNV-1a
+    uint64_t hash = 0xCBF29CE484222325;
+    for (auto c : code)
+    {
+        hash = (hash ^ static_cast<uint8_t>(c)) * 0x100000001B3;
+    }
+    return hash;
+}
+
+static std::string GetBytecodeCachePath(uint64_t hash)
+{
+    auto env = GetContext()->GetPlatformEnvironment();
+    auto directory = Path::Combine(env->GetDirectoryPath(DIRBASE::CACHE), "plugins");
+    return Path::Combine(directory, String::StdFormat("%016" PRIX64 ".bin", hash));
+}
+
+static duk_ret_t LoadFunction(duk_context* ctx, [[maybe_unused]] void* udata)
+{
+    duk_load_function(ctx);
+    return 1;
+}
+
+/**
+ * Pushes the compiled function of the code if it is in the memory cache or, for plugins on disk, in the disk cache.
+ */
+static bool PushCachedFunction(duk_context* ctx, uint64_t hash, std::string_view code, bool useDiskCache)
+{
+    auto it = _bytecodeCache.find(hash);
+    if (it == _bytecodeCache.end() && useDiskCache)
+    {
+        try
+        {
+            auto path = GetBytecodeCachePath(hash);
+            if (File::Exists(path))
+            {
+                auto data = File::ReadAllBytes(path);
+                BytecodeCacheHeader header{};
+                if (data.size() > sizeof(header))
+                {
+                    std::memcpy(&header, data.data(), sizeof(header));
+                    if (header.Magic == BYTECODE_CACHE_MAGIC && header.DuktapeVersion == DUK_VERSION
+                        && header.CodeLength == code.size())
+                    {
+                        data.erase(data.begin(), data.begin() + sizeof(header));
+                        it = _bytecodeCache.emplace(hash, std::move(data)).first;
+                    }
+                }
+            }
+        }
+        catch (const std::exception& e)
+        {
+            log_warning("Unable to read cached plugin bytecode: %s", e.what());
+        }
+    }
+    if (it == _bytecodeCache.end())
+    {
+        return false;
+    }
+
+    const auto& bytecode = it->second;
+    auto buffer = duk_push_fixed_buffer(ctx, bytecode.size());
+    std::memcpy(buffer, bytecode.data(), bytecode.size());
+    if (duk_safe_call(ctx, LoadFunction, nullptr, 1, 1) != DUK_EXEC_SUCCESS)
+    {
+        // Compile the code again
+        duk_pop(ctx);
+        _bytecodeCache.erase(it);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Stores the compiled function on top of the stack, which is left there.
+ */
+static void StoreCachedFunction(duk_context* ctx, uint64_t hash, std::string_view code, bool useDiskCache)
+{
+    duk_dup_top(ctx);
+    duk_dump_function(ctx);
+    duk_size_t size{};
+    auto data = static_cast<const uint8_t*>(duk_get_buffer(ctx, -1, &size));
+    auto& bytecode = _bytecodeCache[hash];
+    bytecode.assign(data, data + size);
+    duk_pop(ctx);
+
+    if (useDiskCache)
+    {
+        try
+        {
+            auto path = GetBytecodeCachePath(hash);
+            Path::CreateDirectory(Path::GetDirectory(path));
+
+            BytecodeCacheHeader header{ BYTECODE_CACHE_MAGIC, DUK_VERSION, code.size() };
+            std::vector<uint8_t> fileData(sizeof(header));
+            std::memcpy(fileData.data(), &header, sizeof(header));
+            fileData.insert(fileData.end(), bytecode.begin(), bytecode.end());
+            File::WriteAllBytes(path, fileData.data(), fileData.size());
+        }
+        catch (const std::exception& e)
+        {
+            log_warning("Unable to write cached plugin bytecode: %s", e.what());
+        }
+    }
+}
+
 Plugin::Plugin(duk_context* context, const std::string& path)
     : _context(context)
     , _path(path)
@@ -62,9 +189,24 @@ void Plugin::Load()
         "     })(" + projectedVariables + ");";
     // clang-format on
 
-    auto flags = DUK_COMPILE_EVAL | DUK_COMPILE_SAFE | DUK_COMPILE_NOSOURCE | DUK_COMPILE_NOFILENAME;
-    auto result = duk_eval_raw(_context, code.c_str(), code.size(), flags);
-    if (result != DUK_ERR_NONE)
+    // Compiling is the slow part of loading, the compiled code is reused as long as the code stays the same
+    auto hash = GetCodeHash(code);
+    if (!PushCachedFunction(_context, hash, code, HasPath()))
+    {
+        auto flags = DUK_COMPILE_EVAL | DUK_COMPILE_NOSOURCE | DUK_COMPILE_NOFILENAME;
+        if (duk_pcompile_lstring(_context, flags, code.c_str(), code.size()) != DUK_ERR_NONE)
+        {
+            auto val = std::string(duk_safe_to_string(_context, -1));
+            duk_pop(_context);
+            throw std::runtime_error("Failed to load plug-in script: " + val);
+        }
+        StoreCachedFunction(_context, hash, code, HasPath());
+    }
+
+    // Run it the way duk_eval does
+    duk_push_global_object(_context);
+    auto result = duk_pcall_method(_context, 0);
+    if (result != DUK_EXEC_SUCCESS)
     {
         auto val = std::string(duk_safe_to_string(_context, -1));
         duk_pop(_context);
@@ -12,7 +12,10 @@
 #ifdef ENABLE_SCRIPTING
 
 #    include "Duktape.hpp"
+#    include "HookEngine.h"
 
+#    include <array>
+#    include <chrono>
 #    include <memory>
 #    include <string>
 #    include <string_view>
@@ -45,6 +48,35 @@ namespace OpenRCT2::Scripting
         DukValue Main;
     };
 
+    struct PluginCallStats
+    {
+        uint32_t Calls{};
+        std::chrono::nanoseconds Time{};
+        std::chrono::nanoseconds MaxTime{};
+    };
+
+    /**
+     * Script time used by a plugin. Time spent in other plugins it causes to run, e.g. through hooks of the game actions
+     * it executes, is accounted to those plugins.
+     */
+    struct PluginTimings
+    {
+        std::array<PluginCallStats, NUM_HOOK_TYPES> Hooks;
+        PluginCallStats Intervals;
+        PluginCallStats Sockets;
+        PluginCallStats CustomActionQueries;
+        PluginCallStats CustomActionExecutes;
+        PluginCallStats Other;
+
+        // Time used since the script engine was last updated, which happens once per frame
+        std::chrono::nanoseconds UpdateTime{};
+        std::chrono::nanoseconds MaxUpdateTime{};
+        uint32_t SoftBudgetExceeded{};
+        uint32_t HardBudgetExceeded{};
+        uint32_t SkippedCalls{};
+        uint32_t LastWarningTimestamp{};
+    };
+
     class Plugin
     {
     private:
@@ -53,6 +85,7 @@ namespace OpenRCT2::Scripting
         PluginMetadata _metadata{};
         std::string _code;
         bool _hasStarted{};
+        PluginTimings _timings;
 
     public:
         std::string GetPath() const
@@ -80,6 +113,16 @@ namespace OpenRCT2::Scripting
             return _hasStarted;
         }
 
+        PluginTimings& GetTimings()
+        {
+            return _timings;
+        }
+
+        const PluginTimings& GetTimings() const
+        {
+            return _timings;
+        }
+
         Plugin() = default;
         Plugin(duk_context* context, const std::string& path);
         Plugin(const Plugin&) = delete;
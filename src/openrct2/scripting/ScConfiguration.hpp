@@ -260,7 +260,7 @@ namespace OpenRCT2::Scripting
                     }
                     duk_pop(ctx);
 
-                    scriptEngine.SaveSharedStorage();
+                    scriptEngine.SaveSharedStorage(ns);
                 }
             }
         }
@@ -21,6 +21,9 @@
 #    include "ScRide.hpp"
 #    include "ScTile.hpp"
 
+#    include <algorithm>
+#    include <vector>
+
 namespace OpenRCT2::Scripting
 {
     class ScMap
@@ -153,6 +156,135 @@ namespace OpenRCT2::Scripting
             return result;
         }
 
+        /**
+         * Returns the heights, types and rides of all tile elements in a rectangle of tiles as typed arrays, so that the
+         * whole map can be looked at without creating a tile and tile element object for every element.
+         */
+        DukValue getTileData(int32_t x, int32_t y, int32_t width, int32_t height) const
+        {
+            auto left = std::clamp(x, 0, static_cast<int32_t>(gMapSize));
+            auto top = std::clamp(y, 0, static_cast<int32_t>(gMapSize));
+            auto right = std::clamp(x + std::max(width, 0), left, static_cast<int32_t>(gMapSize));
+            auto bottom = std::clamp(y + std::max(height, 0), top, static_cast<int32_t>(gMapSize));
+            auto numTiles = static_cast<size_t>(right - left) * (bottom - top);
+
+            size_t numElements = 0;
+            for (int32_t tileY = top; tileY < bottom; tileY++)
+            {
+                for (int32_t tileX = left; tileX < right; tileX++)
+                {
+                    auto first = map_get_first_element_at(TileCoordsXY{ tileX, tileY }.ToCoordsXY());
+                    numElements += ScTile::GetNumElements(first);
+                }
+            }
+
+            auto ctx = _context;
+            auto objIdx = duk_push_object(ctx);
+            duk_push_int(ctx, left);
+            duk_put_prop_string(ctx, objIdx, "x");
+            duk_push_int(ctx, top);
+            duk_put_prop_string(ctx, objIdx, "y");
+            duk_push_int(ctx, right - left);
+            duk_put_prop_string(ctx, objIdx, "width");
+            duk_push_int(ctx, bottom - top);
+            duk_put_prop_string(ctx, objIdx, "height");
+
+            auto surfaceHeights = PushTypedArray<uint8_t>(ctx, objIdx, "surfaceHeight", numTiles, DUK_BUFOBJ_UINT8ARRAY);
+            auto firstElements = PushTypedArray<uint32_t>(ctx, objIdx, "elementIndex", numTiles + 1, DUK_BUFOBJ_UINT32ARRAY);
+            auto types = PushTypedArray<uint8_t>(ctx, objIdx, "elementType", numElements, DUK_BUFOBJ_UINT8ARRAY);
+            auto baseHeights = PushTypedArray<uint8_t>(ctx, objIdx, "baseHeight", numElements, DUK_BUFOBJ_UINT8ARRAY);
+            auto clearanceHeights = PushTypedArray<uint8_t>(
+                ctx, objIdx, "clearanceHeight", numElements, DUK_BUFOBJ_UINT8ARRAY);
+            auto rideIds = PushTypedArray<uint16_t>(ctx, objIdx, "rideId", numElements, DUK_BUFOBJ_UINT16ARRAY);
+
+            size_t tileIndex = 0;
+            size_t elementIndex = 0;
+            for (int32_t tileY = top; tileY < bottom; tileY++)
+            {
+                for (int32_t tileX = left; tileX < right; tileX++)
+                {
+                    firstElements[tileIndex] = static_cast<uint32_t>(elementIndex);
+                    auto element = map_get_first_element_at(TileCoordsXY{ tileX, tileY }.ToCoordsXY());
+                    if (element != nullptr)
+                    {
+                        do
+                        {
+                            if (element->GetType() == TILE_ELEMENT_TYPE_SURFACE)
+                            {
+                                surfaceHeights[tileIndex] = element->base_height;
+                            }
+                            types[elementIndex] = element->GetType() >> 2;
+                            baseHeights[elementIndex] = element->base_height;
+                            clearanceHeights[elementIndex] = element->clearance_height;
+                            auto rideIndex = element->GetRideIndex();
+                            rideIds[elementIndex] = rideIndex == RIDE_ID_NULL ? RideIdNewNull : rideIndex;
+                            elementIndex++;
+                        } while (!(element++)->IsLastForTile());
+                    }
+                    tileIndex++;
+                }
+            }
+            firstElements[tileIndex] = static_cast<uint32_t>(elementIndex);
+
+            return DukValue::take_from_stack(ctx);
+        }
+
+        /**
+         * Returns the ids and positions of all entities of a type as typed arrays. If a filter with a position and a
+         * range is given, only the entities at most range units away from it on both axes are returned.
+         */
+        DukValue getEntityData(const std::string& type, const DukValue& filter) const
+        {
+            std::vector<const SpriteBase*> entities;
+            if (type == "balloon")
+            {
+                CollectEntities<Balloon>(filter, entities);
+            }
+            else if (type == "car")
+            {
+                CollectEntities<Vehicle>(filter, entities);
+            }
+            else if (type == "litter")
+            {
+                CollectEntities<Litter>(filter, entities);
+            }
+            else if (type == "duck")
+            {
+                CollectEntities<Duck>(filter, entities);
+            }
+            else if (type == "peep")
+            {
+                if (filter.type() == DukValue::Type::OBJECT)
+                {
+                    CollectEntities<Peep>(filter, entities);
+                }
+                else
+                {
+                    CollectEntities<Guest>(filter, entities);
+                    CollectEntities<Staff>(filter, entities);
+                }
+            }
+            else
+            {
+                duk_error(_context, DUK_ERR_ERROR, "Invalid entity type.");
+            }
+
+            auto ctx = _context;
+            auto objIdx = duk_push_object(ctx);
+            auto ids = PushTypedArray<uint16_t>(ctx, objIdx, "id", entities.size(), DUK_BUFOBJ_UINT16ARRAY);
+            auto xs = PushTypedArray<int32_t>(ctx, objIdx, "x", entities.size(), DUK_BUFOBJ_INT32ARRAY);
+            auto ys = PushTypedArray<int32_t>(ctx, objIdx, "y", entities.size(), DUK_BUFOBJ_INT32ARRAY);
+            auto zs = PushTypedArray<int32_t>(ctx, objIdx, "z", entities.size(), DUK_BUFOBJ_INT32ARRAY);
+            for (size_t i = 0; i < entities.size(); i++)
+            {
+                ids[i] = entities[i]->sprite_index;
+                xs[i] = entities[i]->x;
+                ys[i] = entities[i]->y;
+                zs[i] = entities[i]->z;
+            }
+            return DukValue::take_from_stack(ctx);
+        }
+
         static void Register(duk_context* ctx)
         {
             dukglue_register_property(ctx, &ScMap::size_get, nullptr, "size");
@@ -163,9 +295,42 @@ namespace OpenRCT2::Scripting
             dukglue_register_method(ctx, &ScMap::getTile, "getTile");
             dukglue_register_method(ctx, &ScMap::getEntity, "getEntity");
             dukglue_register_method(ctx, &ScMap::getAllEntities, "getAllEntities");
+            dukglue_register_method(ctx, &ScMap::getTileData, "getTileData");
+            dukglue_register_method(ctx, &ScMap::getEntityData, "getEntityData");
         }
 
     private:
+        /**
+         * Adds a typed array of the given length to the object at objIdx and returns its data, which starts zeroed.
+         */
+        template<typename T>
+        static T* PushTypedArray(duk_context* ctx, duk_idx_t objIdx, const char* name, size_t length, duk_uint_t type)
+        {
+            auto size = length * sizeof(T);
+            auto data = static_cast<T*>(duk_push_fixed_buffer(ctx, size));
+            duk_push_buffer_object(ctx, -1, 0, size, type);
+            duk_remove(ctx, -2);
+            duk_put_prop_string(ctx, objIdx, name);
+            return data;
+        }
+
+        template<typename T> static void CollectEntities(const DukValue& filter, std::vector<const SpriteBase*>& entities)
+        {
+            if (filter.type() == DukValue::Type::OBJECT)
+            {
+                auto loc = CoordsXY{ AsOrDefault<int32_t>(filter["x"]), AsOrDefault<int32_t>(filter["y"]) };
+                auto range = AsOrDefault<int32_t>(filter["range"]);
+                ForEachEntityInRange<T>(loc, range, [&entities](T* entity) { entities.push_back(entity); });
+            }
+            else
+            {
+                for (auto* entity : EntityList<T>())
+                {
+                    entities.push_back(entity);
+                }
+            }
+        }
+
         DukValue GetEntityAsDukValue(const SpriteBase* sprite) const
         {
             auto spriteId = sprite->sprite_index;
@@ -14,6 +14,8 @@
 #    include "../Context.h"
 #    include "../common.h"
 #    include "../core/Guard.hpp"
+#    include "../peep/GuestPathfinding.h"
+#    include "../ride/RideRatings.h"
 #    include "../ride/Track.h"
 #    include "../world/Footpath.h"
 #    include "../world/Scenery.h"
@@ -1476,6 +1478,11 @@ namespace OpenRCT2::Scripting
         void Invalidate()
         {
             map_invalidate_tile_full(_coords);
+            map_update_tile_element_types(_coords);
+            ride_ratings_proximity_cache_invalidate_tile(_coords);
+            footpath_invalidate_wide_flags(_coords);
+            peep_pathfind_invalidate_cache();
+            track_block_links_invalidate();
         }
 
     public:
@@ -1682,6 +1689,11 @@ namespace OpenRCT2::Scripting
                     }
                 }
                 map_invalidate_tile_full(_coords);
+                map_update_tile_element_types(_coords);
+                ride_ratings_proximity_cache_invalidate_tile(_coords);
+                footpath_invalidate_wide_flags(_coords);
+                peep_pathfind_invalidate_cache();
+                track_block_links_invalidate();
             }
         }
 
@@ -1761,6 +1773,7 @@ namespace OpenRCT2::Scripting
             return map_get_first_element_at(_coords);
         }
 
+    public:
         static size_t GetNumElements(const TileElement* first)
         {
             size_t count = 0;
@@ -1775,6 +1788,7 @@ namespace OpenRCT2::Scripting
             return count;
         }
 
+    private:
         duk_context* GetDukContext() const
         {
             auto& scriptEngine = GetContext()->GetScriptEngine();
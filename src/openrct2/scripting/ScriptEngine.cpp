@@ -19,7 +19,9 @@
 #    include "../config/Config.h"
 #    include "../core/File.h"
 #    include "../core/FileScanner.h"
+#    include "../core/Json.hpp"
 #    include "../core/Path.hpp"
+#    include "../core/String.hpp"
 #    include "../interface/InteractiveConsole.h"
 #    include "../platform/Platform2.h"
 #    include "Duktape.hpp"
@@ -38,13 +40,18 @@
 #    include "ScSocket.hpp"
 #    include "ScTile.hpp"
 
+#    include <cstddef>
+#    include <cstdlib>
 #    include <iostream>
+#    include <iterator>
 #    include <stdexcept>
+#    include <utility>
 
 using namespace OpenRCT2;
 using namespace OpenRCT2::Scripting;
 
-static constexpr int32_t OPENRCT2_PLUGIN_API_VERSION = 25;
+static constexpr int32_t OPENRCT2_PLUGIN_API_VERSION = 26;
+static constexpr uint32_t PLUGIN_BUDGET_WARNING_INTERVAL_MS = 10000;
 
 struct ExpressionStringifier final
 {
@@ -354,9 +361,58 @@ public:
     }
 };
 
+// Every duktape allocation is prefixed with its size so the size of all heaps is known
+static constexpr size_t DUK_ALLOC_HEADER_SIZE = alignof(std::max_align_t);
+static size_t _dukHeapSize;
+
+static void* DukAlloc(void*, duk_size_t size)
+{
+    if (size == 0)
+        return nullptr;
+
+    auto* block = static_cast<uint8_t*>(std::malloc(DUK_ALLOC_HEADER_SIZE + size));
+    if (block == nullptr)
+        return nullptr;
+
+    *reinterpret_cast<size_t*>(block) = size;
+    _dukHeapSize += size;
+    return block + DUK_ALLOC_HEADER_SIZE;
+}
+
+static void DukFree(void*, void* ptr)
+{
+    if (ptr == nullptr)
+        return;
+
+    auto* block = static_cast<uint8_t*>(ptr) - DUK_ALLOC_HEADER_SIZE;
+    _dukHeapSize -= *reinterpret_cast<size_t*>(block);
+    std::free(block);
+}
+
+static void* DukRealloc(void* udata, void* ptr, duk_size_t size)
+{
+    if (ptr == nullptr)
+        return DukAlloc(udata, size);
+    if (size == 0)
+    {
+        DukFree(udata, ptr);
+        return nullptr;
+    }
+
+    auto* block = static_cast<uint8_t*>(ptr) - DUK_ALLOC_HEADER_SIZE;
+    auto oldSize = *reinterpret_cast<size_t*>(block);
+    auto* newBlock = static_cast<uint8_t*>(std::realloc(block, DUK_ALLOC_HEADER_SIZE + size));
+    if (newBlock == nullptr)
+        return nullptr;
+
+    *reinterpret_cast<size_t*>(newBlock) = size;
+    _dukHeapSize = _dukHeapSize - oldSize + size;
+    return newBlock + DUK_ALLOC_HEADER_SIZE;
+}
+
 DukContext::DukContext()
 {
-    _context = duk_create_heap_default();
+    _context = duk_create_heap(DukAlloc, DukRealloc, DukFree, nullptr, nullptr);
     if (_context == nullptr)
     {
         throw std::runtime_error("Unable to initialise duktape context.");
@@ -375,6 +431,18 @@ ScriptEngine::ScriptEngine(InteractiveConsole& console, IPlatformEnvironment& en
 {
 }
 
+ScriptEngine::~ScriptEngine()
+{
+    if (_sharedStorageSavePending)
+    {
+        FlushSharedStorage();
+    }
+    if (_sharedStorageWrite.valid())
+    {
+        _sharedStorageWrite.wait();
+    }
+}
+
 void ScriptEngine::Initialise()
 {
     auto ctx = static_cast<duk_context*>(_context);
@@ -641,6 +709,8 @@ void ScriptEngine::Update()
         Initialise();
     }
 
+    UpdatePluginBudgets();
+
     if (_pluginsLoaded)
     {
         if (!_pluginsStarted)
@@ -661,6 +731,7 @@ void ScriptEngine::Update()
     UpdateIntervals();
     UpdateSockets();
     ProcessREPL();
+    UpdateSharedStorage();
 }
 
 void ScriptEngine::ProcessREPL()
@@ -710,6 +781,12 @@ DukValue ScriptEngine::ExecutePluginCall(
     DukStackFrame frame(_context);
     if (func.is_function())
     {
+        if (plugin != nullptr && CanSkipPluginCall(*plugin))
+        {
+            plugin->GetTimings().SkippedCalls++;
+            return DukValue();
+        }
+
         ScriptExecutionInfo::PluginScope scope(_execInfo, plugin, isGameStateMutable);
         func.push();
         thisValue.push();
@@ -717,7 +794,18 @@ DukValue ScriptEngine::ExecutePluginCall(
         {
             arg.push();
         }
+
+        auto startTime = std::chrono::high_resolution_clock::now();
+        auto outerNestedCallTime = std::exchange(_nestedCallTime, {});
         auto result = duk_pcall_method(_context, static_cast<duk_idx_t>(args.size()));
+        auto callTime = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::high_resolution_clock::now() - startTime);
+        if (plugin != nullptr)
+        {
+            RecordPluginCall(*plugin, callTime - _nestedCallTime);
+        }
+        _nestedCallTime = outerNestedCallTime + callTime;
+
         if (result == DUK_EXEC_SUCCESS)
         {
             return DukValue::take_from_stack(_context);
@@ -777,10 +865,12 @@ std::unique_ptr<GameActions::Result> ScriptEngine::QueryOrExecuteCustomGameActio
         DukValue dukResult;
         if (!isExecute)
         {
+            PluginCallScope callScope(*this, PluginCallType::CustomActionQuery);
             dukResult = ExecutePluginCall(customAction.Owner, customAction.Query, { *dukArgs }, false);
         }
         else
         {
+            PluginCallScope callScope(*this, PluginCallType::CustomActionExecute);
             dukResult = ExecutePluginCall(customAction.Owner, customAction.Execute, { *dukArgs }, true);
         }
         return DukToGameActionResult(dukResult);
@@ -1045,6 +1135,7 @@ const static std::unordered_map<std::string, GameCommand> ActionNameToType = {
     { "signsetstyle", GameCommand::SetSignStyle },
     { "smallsceneryplace", GameCommand::PlaceScenery },
     { "smallsceneryremove", GameCommand::RemoveScenery },
+    { "smallsceneryscatter", GameCommand::ScatterScenery },
     { "stafffire", GameCommand::FireStaffMember },
     { "staffhire", GameCommand::HireNewStaffMember },
     { "staffsetcolour", GameCommand::SetStaffColour },
@@ -1089,11 +1180,10 @@ static std::unique_ptr<GameAction> CreateGameActionFromActionId(const std::strin
 
 void ScriptEngine::RunGameActionHooks(const GameAction& action, std::unique_ptr<GameActions::Result>& result, bool isExecute)
 {
-    DukStackFrame frame(_context);
-
     auto hookType = isExecute ? HOOK_TYPE::ACTION_EXECUTE : HOOK_TYPE::ACTION_QUERY;
     if (_hookEngine.HasSubscriptions(hookType))
     {
+        DukStackFrame frame(_context);
         DukObject obj(_context);
 
         auto actionId = action.GetType();
@@ -1137,10 +1227,15 @@ void ScriptEngine::RunGameActionHooks(const GameAction& action, std::unique_ptr<
         obj.Set("result", GameActionResultToDuk(action, result));
         auto dukEventArgs = obj.Take();
 
-        _hookEngine.Call(hookType, dukEventArgs, false);
-
-        if (!isExecute)
+        // Execute hooks are only notified, the game does not wait for them and they are called once per tick
+        if (isExecute)
         {
+            _hookEngine.Queue(hookType, dukEventArgs, false);
+        }
+        else
+        {
+            _hookEngine.Call(hookType, dukEventArgs, false);
+
             auto dukResult = dukEventArgs["result"];
             if (dukResult.type() == DukValue::Type::OBJECT)
             {
@@ -1193,6 +1288,9 @@ void ScriptEngine::InitSharedStorage()
 {
     duk_push_object(_context);
     _sharedStorage = std::move(DukValue::take_from_stack(_context));
+    _sharedStorageJson.clear();
+    _sharedStorageChangedKeys.clear();
+    _sharedStorageAllChanged = true;
 }
 
 void ScriptEngine::LoadSharedStorage()
@@ -1219,21 +1317,115 @@ void ScriptEngine::LoadSharedStorage()
     }
 }
 
-void ScriptEngine::SaveSharedStorage()
+void ScriptEngine::SaveSharedStorage(std::string_view ns)
 {
-    auto path = _env.GetFilePath(PATHID::PLUGIN_STORE);
-    try
+    if (ns.empty())
     {
-        _sharedStorage.push();
-        auto json = std::string(duk_json_encode(_context, -1));
+        _sharedStorageAllChanged = true;
+    }
+    else
+    {
+        _sharedStorageChangedKeys.emplace(ns.substr(0, ns.find('.')));
+    }
+
+    // The delay counts from the first change, so a plugin saving constantly still gets its changes written
+    if (!_sharedStorageSavePending)
+    {
+        _sharedStorageSavePending = true;
+        _sharedStorageSaveTick = Platform::GetTicks();
+    }
+}
+
+void ScriptEngine::UpdateSharedStorage()
+{
+    constexpr uint32_t SaveDelay = 1000;
+    if (!_sharedStorageSavePending || Platform::GetTicks() - _sharedStorageSaveTick < SaveDelay)
+        return;
+
+    // Wait for the previous write to finish rather than block the game thread on it
+    if (_sharedStorageWrite.valid()
+        && _sharedStorageWrite.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+        return;
+
+    FlushSharedStorage();
+}
+
+/**
+ * Encodes the changed parts of the shared storage on this thread as the script heap is not thread safe, the file is
+ * written in the background.
+ */
+void ScriptEngine::FlushSharedStorage()
+{
+    _sharedStorageSavePending = false;
+
+    auto encodeKey = [this](const std::string& key) {
+        auto value = _sharedStorage[key];
+        if (value.type() == DukValue::Type::UNDEFINED)
+        {
+            _sharedStorageJson.erase(key);
+            return;
+        }
+        value.push();
+        auto json = duk_json_encode(_context, -1);
+        // Values JSON cannot represent, such as functions, are left out of the file
+        if (json != nullptr)
+        {
+            _sharedStorageJson[key] = json;
+        }
+        else
+        {
+            _sharedStorageJson.erase(key);
+        }
         duk_pop(_context);
+    };
+
+    if (_sharedStorageAllChanged)
+    {
+        _sharedStorageJson.clear();
+        _sharedStorage.push();
+        duk_enum(_context, -1, DUK_ENUM_OWN_PROPERTIES_ONLY);
+        while (duk_next(_context, -1, 0))
+        {
+            _sharedStorageChangedKeys.emplace(duk_get_string(_context, -1));
+            duk_pop(_context);
+        }
+        duk_pop_2(_context);
+        _sharedStorageAllChanged = false;
+    }
+    for (const auto& key : _sharedStorageChangedKeys)
+    {
+        encodeKey(key);
+    }
+    _sharedStorageChangedKeys.clear();
 
-        File::WriteAllBytes(path, json.c_str(), json.size());
+    std::string json = "{";
+    for (const auto& [key, value] : _sharedStorageJson)
+    {
+        if (json.size() > 1)
+        {
+            json += ',';
+        }
+        json += json_t(key).dump();
+        json += ':';
+        json += value;
     }
-    catch (const std::exception&)
+    json += "}";
+
+    if (_sharedStorageWrite.valid())
     {
-        Console::Error::WriteLine("Unable to write to '%s'", path.c_str());
+        _sharedStorageWrite.wait();
     }
+    auto path = _env.GetFilePath(PATHID::PLUGIN_STORE);
+    _sharedStorageWrite = std::async(std::launch::async, [path = std::move(path), json = std::move(json)]() {
+        try
+        {
+            File::WriteAllBytes(path, json.c_str(), json.size());
+        }
+        catch (const std::exception&)
+        {
+            Console::Error::WriteLine("Unable to write to '%s'", path.c_str());
+        }
+    });
 }
 
 IntervalHandle ScriptEngine::AllocateHandle()
@@ -1296,6 +1488,7 @@ void ScriptEngine::UpdateIntervals()
     }
     _lastIntervalTimestamp = timestamp;
 
+    PluginCallScope callScope(*this, PluginCallType::Interval);
     for (auto& interval : _intervals)
     {
         if (interval.IsValid())
@@ -1335,6 +1528,8 @@ void ScriptEngine::AddSocket(const std::shared_ptr<ScSocketBase>& socket)
 void ScriptEngine::UpdateSockets()
 {
 #    ifndef DISABLE_NETWORK
+    PluginCallScope callScope(*this, PluginCallType::Socket);
+
     // Use simple for i loop as Update calls can modify the list
     auto it = _sockets.begin();
     while (it != _sockets.end())
@@ -1373,6 +1568,162 @@ void ScriptEngine::RemoveSockets(const std::shared_ptr<Plugin>& plugin)
 #    endif
 }
 
+bool ScriptEngine::CanSkipPluginCall(const Plugin& plugin) const
+{
+    // Remote plugins run on every client, skipping their calls on one of them would desync the game
+    if (gConfigPlugin.hard_budget_us <= 0 || plugin.GetMetadata().Type != PluginType::Local)
+        return false;
+    if (plugin.GetTimings().UpdateTime < std::chrono::microseconds(gConfigPlugin.hard_budget_us))
+        return false;
+
+    // Only calls that merely notify the plugin can be skipped, the others can change the outcome of what the game does
+    switch (_callType)
+    {
+        case PluginCallType::Interval:
+        case PluginCallType::Socket:
+            return true;
+        case PluginCallType::Hook:
+            switch (_callHookType)
+            {
+                case HOOK_TYPE::ACTION_EXECUTE:
+                case HOOK_TYPE::INTERVAL_TICK:
+                case HOOK_TYPE::INTERVAL_DAY:
+                case HOOK_TYPE::NETWORK_JOIN:
+                case HOOK_TYPE::NETWORK_LEAVE:
+                    return true;
+                default:
+                    return false;
+            }
+        default:
+            return false;
+    }
+}
+
+void ScriptEngine::RecordPluginCall(Plugin& plugin, std::chrono::nanoseconds time)
+{
+    auto& timings = plugin.GetTimings();
+    PluginCallStats* stats = &timings.Other;
+    switch (_callType)
+    {
+        case PluginCallType::Hook:
+            if (_callHookType != HOOK_TYPE::UNDEFINED)
+            {
+                stats = &timings.Hooks[static_cast<size_t>(_callHookType)];
+            }
+            break;
+        case PluginCallType::Interval:
+            stats = &timings.Intervals;
+            break;
+        case PluginCallType::Socket:
+            stats = &timings.Sockets;
+            break;
+        case PluginCallType::CustomActionQuery:
+            stats = &timings.CustomActionQueries;
+            break;
+        case PluginCallType::CustomActionExecute:
+            stats = &timings.CustomActionExecutes;
+            break;
+        default:
+            break;
+    }
+    stats->Calls++;
+    stats->Time += time;
+    stats->MaxTime = std::max(stats->MaxTime, time);
+    timings.UpdateTime += time;
+}
+
+void ScriptEngine::UpdatePluginBudgets()
+{
+    const auto softBudget = std::chrono::microseconds(gConfigPlugin.soft_budget_us);
+    const auto hardBudget = std::chrono::microseconds(gConfigPlugin.hard_budget_us);
+    const auto timestamp = Platform::GetTicks();
+    for (auto& plugin : _plugins)
+    {
+        auto& timings = plugin->GetTimings();
+        auto updateTime = std::exchange(timings.UpdateTime, {});
+        timings.MaxUpdateTime = std::max(timings.MaxUpdateTime, updateTime);
+
+        std::chrono::microseconds budget{};
+        if (hardBudget.count() > 0 && updateTime >= hardBudget)
+        {
+            timings.HardBudgetExceeded++;
+            budget = hardBudget;
+        }
+        else if (softBudget.count() > 0 && updateTime >= softBudget)
+        {
+            timings.SoftBudgetExceeded++;
+            budget = softBudget;
+        }
+
+        // Warn at most every few seconds, a slow plugin tends to be slow every frame
+        if (budget.count() > 0 && timestamp - timings.LastWarningTimestamp >= PLUGIN_BUDGET_WARNING_INTERVAL_MS)
+        {
+            timings.LastWarningTimestamp = timestamp;
+            auto message = String::StdFormat(
+                "Used %.2f ms of script time in one frame, the budget is %.2f ms", updateTime.count() / 1000000.0,
+                budget.count() / 1000.0);
+            LogPluginInfo(plugin, message);
+        }
+    }
+}
+
+size_t ScriptEngine::GetHeapSize() const
+{
+    return _dukHeapSize;
+}
+
+json_t ScriptEngine::GetPluginStatsAsJson() const
+{
+    auto callStatsToJson = [](const PluginCallStats& stats) {
+        return json_t{
+            { "calls", stats.Calls },
+            { "timeUs", std::chrono::duration_cast<std::chrono::microseconds>(stats.Time).count() },
+            { "maxTimeUs", std::chrono::duration_cast<std::chrono::microseconds>(stats.MaxTime).count() },
+        };
+    };
+
+    static constexpr const char* HookNames[] = {
+        "action.query",         "action.execute", "interval.tick", "interval.day",           "network.chat",
+        "network.authenticate", "network.join",   "network.leave", "ride.ratings.calculate", "action.location",
+    };
+    static_assert(std::size(HookNames) == NUM_HOOK_TYPES);
+
+    json_t jsonPlugins = json_t::array();
+    for (const auto& plugin : _plugins)
+    {
+        const auto& timings = plugin->GetTimings();
+
+        json_t jsonHooks = json_t::object();
+        for (size_t i = 0; i < NUM_HOOK_TYPES; i++)
+        {
+            if (timings.Hooks[i].Calls != 0)
+            {
+                jsonHooks[HookNames[i]] = callStatsToJson(timings.Hooks[i]);
+            }
+        }
+
+        jsonPlugins.push_back({
+            { "name", plugin->GetMetadata().Name },
+            { "hooks", jsonHooks },
+            { "intervals", callStatsToJson(timings.Intervals) },
+            { "sockets", callStatsToJson(timings.Sockets) },
+            { "customActionQueries", callStatsToJson(timings.CustomActionQueries) },
+            { "customActionExecutes", callStatsToJson(timings.CustomActionExecutes) },
+            { "other", callStatsToJson(timings.Other) },
+            { "maxFrameTimeUs", std::chrono::duration_cast<std::chrono::microseconds>(timings.MaxUpdateTime).count() },
+            { "softBudgetExceeded", timings.SoftBudgetExceeded },
+            { "hardBudgetExceeded", timings.HardBudgetExceeded },
+            { "skippedCalls", timings.SkippedCalls },
+        });
+    }
+
+    return json_t{
+        { "softBudgetUs", gConfigPlugin.soft_budget_us },
+        { "hardBudgetUs", gConfigPlugin.hard_budget_us },
+        { "plugins", jsonPlugins },
+    };
+}
+
 std::string OpenRCT2::Scripting::Stringify(const DukValue& val)
 {
     return ExpressionStringifier::StringifyExpression(val);
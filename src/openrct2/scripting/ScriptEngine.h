@@ -13,13 +13,16 @@
 
 #    include "../common.h"
 #    include "../core/FileWatcher.h"
+#    include "../core/JsonFwd.hpp"
 #    include "../management/Finance.h"
 #    include "../world/Location.hpp"
 #    include "HookEngine.h"
 #    include "Plugin.h"
 
+#    include <chrono>
 #    include <future>
 #    include <list>
+#    include <map>
 #    include <memory>
 #    include <mutex>
 #    include <queue>
@@ -117,6 +120,17 @@ namespace OpenRCT2::Scripting
         }
     };
 
+    // What a plugin is called for, the script time is accounted separately for each
+    enum class PluginCallType
+    {
+        Other,
+        Hook,
+        Interval,
+        Socket,
+        CustomActionQuery,
+        CustomActionExecute,
+    };
+
     using IntervalHandle = int32_t;
     struct ScriptInterval
     {
@@ -148,10 +162,22 @@ namespace OpenRCT2::Scripting
         HookEngine _hookEngine;
         ScriptExecutionInfo _execInfo;
         DukValue _sharedStorage;
+        // The JSON of each top level key of the shared storage, only changed keys are encoded again when saving
+        std::map<std::string, std::string> _sharedStorageJson;
+        std::unordered_set<std::string> _sharedStorageChangedKeys;
+        bool _sharedStorageAllChanged{};
+        bool _sharedStorageSavePending{};
+        uint32_t _sharedStorageSaveTick{};
+        std::future<void> _sharedStorageWrite;
 
         uint32_t _lastIntervalTimestamp{};
         std::vector<ScriptInterval> _intervals;
 
+        PluginCallType _callType{};
+        HOOK_TYPE _callHookType = HOOK_TYPE::UNDEFINED;
+        // Time spent in plugin calls made while the current one runs
+        std::chrono::nanoseconds _nestedCallTime{};
+
         std::unique_ptr<FileWatcher> _pluginFileWatcher;
         std::unordered_set<std::string> _changedPluginFiles;
         std::mutex _changedPluginFilesMutex;
@@ -171,8 +197,33 @@ namespace OpenRCT2::Scripting
 #    endif
 
     public:
+        class PluginCallScope
+        {
+        private:
+            ScriptEngine& _scriptEngine;
+            PluginCallType _backupType;
+            HOOK_TYPE _backupHookType;
+
+        public:
+            PluginCallScope(ScriptEngine& scriptEngine, PluginCallType type, HOOK_TYPE hookType = HOOK_TYPE::UNDEFINED)
+                : _scriptEngine(scriptEngine)
+                , _backupType(scriptEngine._callType)
+                , _backupHookType(scriptEngine._callHookType)
+            {
+                _scriptEngine._callType = type;
+                _scriptEngine._callHookType = hookType;
+            }
+            PluginCallScope(const PluginCallScope&) = delete;
+            ~PluginCallScope()
+            {
+                _scriptEngine._callType = _backupType;
+                _scriptEngine._callHookType = _backupHookType;
+            }
+        };
+
         ScriptEngine(InteractiveConsole& console, IPlatformEnvironment& env);
         ScriptEngine(ScriptEngine&) = delete;
+        ~ScriptEngine();
 
         duk_context* GetContext()
         {
@@ -222,7 +273,18 @@ namespace OpenRCT2::Scripting
         void RunGameActionHooks(const GameAction& action, std::unique_ptr<GameActions::Result>& result, bool isExecute);
         std::unique_ptr<GameAction> CreateGameAction(const std::string& actionid, const DukValue& args);
 
-        void SaveSharedStorage();
+        /**
+         * Schedules the shared storage to be written, changes made shortly after each other are written together.
+         * @param ns The namespace that changed, or empty if any part of the storage may have changed.
+         */
+        void SaveSharedStorage(std::string_view ns = {});
+
+        json_t GetPluginStatsAsJson() const;
+
+        /**
+         * Returns the bytes allocated by the script heap.
+         */
+        size_t GetHeapSize() const;
 
         IntervalHandle AddInterval(const std::shared_ptr<Plugin>& plugin, int32_t delay, bool repeat, DukValue&& callback);
         void RemoveInterval(const std::shared_ptr<Plugin>& plugin, IntervalHandle handle);
@@ -251,6 +313,8 @@ namespace OpenRCT2::Scripting
 
         void InitSharedStorage();
         void LoadSharedStorage();
+        void UpdateSharedStorage();
+        void FlushSharedStorage();
 
         IntervalHandle AllocateHandle();
         void UpdateIntervals();
@@ -258,6 +322,10 @@ namespace OpenRCT2::Scripting
 
         void UpdateSockets();
         void RemoveSockets(const std::shared_ptr<Plugin>& plugin);
+
+        bool CanSkipPluginCall(const Plugin& plugin) const;
+        void RecordPluginCall(Plugin& plugin, std::chrono::nanoseconds time);
+        void UpdatePluginBudgets();
     };
 
     bool IsGameStateMutable();
@@ -43,6 +43,7 @@ namespace TitleSequenceManager
     };
 
     static std::vector<TitleSequenceManagerItem> _items;
+    static bool _scanned = false;
 
     static std::string GetNewTitleSequencePath(const std::string& name, bool isZip);
     static size_t FindItemIndexByPath(const std::string& path);
@@ -54,13 +55,26 @@ namespace TitleSequenceManager
     static std::string GetUserSequencesPath();
     static bool IsNameReserved(const std::string& name);
 
+    /**
+     * The sequences are only scanned once something asks for them, headless servers never do.
+     */
+    static void EnsureScanned()
+    {
+        if (!_scanned)
+        {
+            Scan();
+        }
+    }
+
     size_t GetCount()
     {
+        EnsureScanned();
         return _items.size();
     }
 
     const TitleSequenceManagerItem* GetItem(size_t i)
     {
+        EnsureScanned();
         if (i >= _items.size())
         {
             return nullptr;
@@ -96,6 +110,7 @@ namespace TitleSequenceManager
 
     size_t RenameItem(size_t i, const utf8* newName)
     {
+        EnsureScanned();
         auto item = &_items[i];
         const auto& oldPath = item->Path;
 
@@ -120,6 +135,7 @@ namespace TitleSequenceManager
 
     size_t DuplicateItem(size_t i, const utf8* name)
     {
+        EnsureScanned();
         auto item = &_items[i];
         const auto& srcPath = item->Path;
 
@@ -137,6 +153,7 @@ namespace TitleSequenceManager
 
     size_t CreateItem(const utf8* name)
     {
+        EnsureScanned();
         auto seq = CreateTitleSequence();
         seq->Name = name;
         seq->Path = GetNewTitleSequencePath(seq->Name, true);
@@ -196,6 +213,7 @@ namespace TitleSequenceManager
     void Scan()
     {
         _items.clear();
+        _scanned = true;
 
         // Scan data path
         Scan(GetDataSequencesPath());
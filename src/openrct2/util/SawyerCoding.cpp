@@ -16,6 +16,11 @@
 #include <algorithm>
 #include <cstring>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    define SAWYER_CODING_SSE2
+#    include <emmintrin.h>
+#endif
+
 static size_t decode_chunk_rle(const uint8_t* src_buffer, uint8_t* dst_buffer, size_t length);
 static size_t decode_chunk_rle_with_size(const uint8_t* src_buffer, uint8_t* dst_buffer, size_t length, size_t dstSize);
 
@@ -28,7 +33,21 @@ bool gUseRLE = true;
 uint32_t sawyercoding_calculate_checksum(const uint8_t* buffer, size_t length)
 {
     uint32_t checksum = 0;
-    for (size_t i = 0; i < length; i++)
+    size_t i = 0;
+#ifdef SAWYER_CODING_SSE2
+    // Sums of absolute differences against zero add up 8 bytes at a time into each 64 bit lane, only the low 32 bits
+    // of the lanes are needed as the checksum wraps around.
+    const auto zero = _mm_setzero_si128();
+    auto sums = _mm_setzero_si128();
+    for (; i + 16 <= length; i += 16)
+    {
+        auto bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(buffer + i));
+        sums = _mm_add_epi64(sums, _mm_sad_epu8(bytes, zero));
+    }
+    checksum = static_cast<uint32_t>(_mm_cvtsi128_si32(sums));
+    checksum += static_cast<uint32_t>(_mm_cvtsi128_si32(_mm_srli_si128(sums, 8)));
+#endif
+    for (; i < length; i++)
         checksum += buffer[i];
 
     return checksum;
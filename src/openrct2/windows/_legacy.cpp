@@ -27,6 +27,7 @@
 
 #include <iterator>
 #include <tuple>
+#include <unordered_set>
 
 bool gDisableErrorWindowSound = false;
 
@@ -38,6 +39,62 @@ uint8_t _rideConstructionState2;
 bool _stationConstructed;
 bool _deferClose;
 
+namespace
+{
+    // The cache is cleared once it grows beyond this
+    constexpr size_t MaxProvisionalTrackFailures = 4096;
+
+    struct ProvisionalTrackKey
+    {
+        ride_id_t RideIndex;
+        int32_t TrackType;
+        int32_t TrackDirection;
+        int32_t LiftHillAndAlternativeState;
+        CoordsXYZ TrackPos;
+
+        bool operator==(const ProvisionalTrackKey& rhs) const
+        {
+            return RideIndex == rhs.RideIndex && TrackType == rhs.TrackType && TrackDirection == rhs.TrackDirection
+                && LiftHillAndAlternativeState == rhs.LiftHillAndAlternativeState && TrackPos == rhs.TrackPos;
+        }
+    };
+
+    struct ProvisionalTrackKeyHash
+    {
+        size_t operator()(const ProvisionalTrackKey& key) const
+        {
+            size_t hash = static_cast<size_t>(key.RideIndex);
+            for (int32_t value : { key.TrackType, key.TrackDirection, key.LiftHillAndAlternativeState, key.TrackPos.x,
+                                   key.TrackPos.y, key.TrackPos.z })
+            {
+                hash = hash * 31 + static_cast<size_t>(value);
+            }
+            return hash;
+        }
+    };
+
+    /**
+     * The pieces that could not be placed since the map last changed. The construction tool tries every height above
+     * the cursor and retries a failed piece every frame, the ghosts are removed before each attempt so only map
+     * changes made by anything else can change the outcome.
+     */
+    std::unordered_set<ProvisionalTrackKey, ProvisionalTrackKeyHash> _provisionalTrackFailures;
+} // namespace
+
+void ride_provisional_track_invalidate_cache()
+{
+    _provisionalTrackFailures.clear();
+}
+
+static void ride_provisional_track_add_failure(const ProvisionalTrackKey& key)
+{
+    if (_provisionalTrackFailures.size() >= MaxProvisionalTrackFailures)
+    {
+        _provisionalTrackFailures.clear();
+    }
+    _provisionalTrackFailures.insert(key);
+}
+
 /**
  *
  *  rct2: 0x006CA162
@@ -52,13 +109,21 @@ money32 place_provisional_track_piece(
 
     money32 result;
     ride_construction_remove_ghosts();
+
+    const ProvisionalTrackKey key{ rideIndex, trackType, trackDirection, liftHillAndAlternativeState, trackPos };
+    if (_provisionalTrackFailures.find(key) != _provisionalTrackFailures.end())
+        return MONEY32_UNDEFINED;
+
     if (ride->type == RIDE_TYPE_MAZE)
     {
         int32_t flags = GAME_COMMAND_FLAG_APPLY | GAME_COMMAND_FLAG_ALLOW_DURING_PAUSED | GAME_COMMAND_FLAG_NO_SPEND
             | GAME_COMMAND_FLAG_GHOST; // 105
         result = maze_set_track(trackPos.x, trackPos.y, trackPos.z, flags, true, 0, rideIndex, GC_SET_MAZE_TRACK_BUILD);
         if (result == MONEY32_UNDEFINED)
+        {
+            ride_provisional_track_add_failure(key);
             return result;
+        }
 
         _unkF440C5 = { trackPos, static_cast<Direction>(trackDirection) };
         _currentTrackSelectionFlags |= TRACK_SELECTION_FLAG_TRACK;
@@ -88,7 +153,14 @@ money32 place_provisional_track_piece(
         auto tpar = dynamic_cast<TrackPlaceActionResult*>(res.get());
         result = ((tpar == nullptr) || (res->Error == GameActions::Status::Ok)) ? res->Cost : MONEY32_UNDEFINED;
         if (result == MONEY32_UNDEFINED)
+        {
+            // Running out of free elements does not depend on the position
+            if (res->Error != GameActions::Status::NoFreeElements)
+            {
+                ride_provisional_track_add_failure(key);
+            }
             return result;
+        }
 
         int16_t z_begin, z_end;
         const rct_track_coordinates& coords = TrackCoordinates[trackType];
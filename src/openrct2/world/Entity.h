@@ -16,6 +16,12 @@ constexpr uint16_t MAX_ENTITIES = 10000;
 SpriteBase* try_get_sprite(size_t spriteIndex);
 SpriteBase* get_sprite(size_t sprite_idx);
 
+/**
+ * Hints the CPU to start loading the first cache lines of an entity, used by the entity list iterators to overlap
+ * fetching the next entity with updating the current one.
+ */
+void PrefetchEntity(size_t sprite_idx);
+
 template<typename T = SpriteBase> T* GetEntity(size_t sprite_idx)
 {
     auto spr = get_sprite(sprite_idx);
@@ -0,0 +1,120 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../common.h"
+#include "../util/Util.h"
+#include "Entity.h"
+
+#include <array>
+
+/**
+ * A set of entity indices stored as one bit per entity. Insertion and removal are O(1) and the indices are always
+ * enumerated in ascending sprite_index order, which the entity lists rely on to stay deterministic. A summary word
+ * holds a bit for every non-empty word, so finding the next index skips empty stretches 64 words at a time.
+ */
+class EntityIndexSet
+{
+private:
+    static constexpr size_t BitsPerWord = 64;
+    static constexpr size_t NumWords = (MAX_ENTITIES + BitsPerWord - 1) / BitsPerWord;
+    static constexpr size_t NumSummaryWords = (NumWords + BitsPerWord - 1) / BitsPerWord;
+
+    std::array<uint64_t, NumWords> _words{};
+    std::array<uint64_t, NumSummaryWords> _summary{};
+    uint16_t _count = 0;
+
+    /**
+     * Returns the lowest non-empty word at or after wordIndex, or NumWords if there is none.
+     */
+    size_t FindWordFrom(size_t wordIndex) const
+    {
+        size_t summaryIndex = wordIndex / BitsPerWord;
+        if (summaryIndex >= NumSummaryWords)
+            return NumWords;
+
+        uint64_t summary = _summary[summaryIndex] & (~0ULL << (wordIndex % BitsPerWord));
+        while (summary == 0)
+        {
+            if (++summaryIndex >= NumSummaryWords)
+                return NumWords;
+            summary = _summary[summaryIndex];
+        }
+        return summaryIndex * BitsPerWord + bitscanforward(static_cast<int64_t>(summary));
+    }
+
+public:
+    void Insert(uint16_t index)
+    {
+        auto& word = _words[index / BitsPerWord];
+        const auto mask = 1ULL << (index % BitsPerWord);
+        if (!(word & mask))
+        {
+            word |= mask;
+            _count++;
+            const auto wordIndex = index / BitsPerWord;
+            _summary[wordIndex / BitsPerWord] |= 1ULL << (wordIndex % BitsPerWord);
+        }
+    }
+
+    void Remove(uint16_t index)
+    {
+        auto& word = _words[index / BitsPerWord];
+        const auto mask = 1ULL << (index % BitsPerWord);
+        if (word & mask)
+        {
+            word &= ~mask;
+            _count--;
+            if (word == 0)
+            {
+                const auto wordIndex = index / BitsPerWord;
+                _summary[wordIndex / BitsPerWord] &= ~(1ULL << (wordIndex % BitsPerWord));
+            }
+        }
+    }
+
+    bool Contains(uint16_t index) const
+    {
+        return index < MAX_ENTITIES && (_words[index / BitsPerWord] & (1ULL << (index % BitsPerWord))) != 0;
+    }
+
+    void Clear()
+    {
+        _words.fill(0);
+        _summary.fill(0);
+        _count = 0;
+    }
+
+    uint16_t Count() const
+    {
+        return _count;
+    }
+
+    /**
+     * Returns the lowest index in the set that is not less than index, or SPRITE_INDEX_NULL if there is none.
+     */
+    uint16_t FindFrom(uint16_t index) const
+    {
+        size_t wordIndex = index / BitsPerWord;
+        if (wordIndex >= NumWords)
+            return SPRITE_INDEX_NULL;
+
+        // Mask out the bits below index in the first word
+        uint64_t word = _words[wordIndex] & (~0ULL << (index % BitsPerWord));
+        if (word == 0)
+        {
+            wordIndex = FindWordFrom(wordIndex + 1);
+            if (wordIndex >= NumWords)
+                return SPRITE_INDEX_NULL;
+            word = _words[wordIndex];
+        }
+        return static_cast<uint16_t>(wordIndex * BitsPerWord + bitscanforward(static_cast<int64_t>(word)));
+    }
+};
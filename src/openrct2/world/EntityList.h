@@ -12,10 +12,13 @@
 #include "../common.h"
 #include "../rct12/RCT12.h"
 #include "Entity.h"
+#include "EntityIndexSet.h"
 #include "Location.hpp"
+#include "Map.h"
 #include "SpriteBase.h"
 
-#include <list>
+#include <algorithm>
+#include <cstdlib>
 #include <vector>
 
 enum class EntityListId : uint8_t
@@ -23,25 +26,28 @@ enum class EntityListId : uint8_t
     Count = 6,
 };
 
-const std::list<uint16_t>& GetEntityList(const EntityType id);
+const EntityIndexSet& GetEntityList(const EntityType id);
 
 uint16_t GetEntityListCount(EntityType list);
 uint16_t GetMiscEntityCount();
 uint16_t GetNumFreeEntities();
 void RebuildEntityLists();
-const std::vector<uint16_t>& GetEntityTileList(const CoordsXY& spritePos);
+/**
+ * The entities on the tile of the spatial index that contains spritePos, in sprite_index order: the first one and then
+ * the one after each, SPRITE_INDEX_NULL past the last.
+ */
+uint16_t GetEntityTileListFirst(const CoordsXY& spritePos);
+uint16_t GetEntityTileListNext(uint16_t spriteIndex);
 
 template<typename T> class EntityTileIterator
 {
 private:
-    std::vector<uint16_t>::const_iterator iter;
-    std::vector<uint16_t>::const_iterator end;
+    uint16_t Next = SPRITE_INDEX_NULL;
     T* Entity = nullptr;
 
 public:
-    EntityTileIterator(std::vector<uint16_t>::const_iterator _iter, std::vector<uint16_t>::const_iterator _end)
-        : iter(_iter)
-        , end(_end)
+    EntityTileIterator(uint16_t first)
+        : Next(first)
     {
         ++(*this);
     }
@@ -49,9 +55,10 @@ public:
     {
         Entity = nullptr;
 
-        while (iter != end && Entity == nullptr)
+        while (Next != SPRITE_INDEX_NULL && Entity == nullptr)
         {
-            Entity = GetEntity<T>(*iter++);
+            Entity = GetEntity<T>(Next);
+            Next = GetEntityTileListNext(Next);
         }
         return *this;
     }
@@ -60,7 +67,7 @@ public:
     {
         EntityTileIterator retval = *this;
         ++(*this);
-        return *iter;
+        return retval;
     }
     bool operator==(EntityTileIterator other) const
     {
@@ -85,35 +92,83 @@ public:
 template<typename T = SpriteBase> class EntityTileList
 {
 private:
-    const std::vector<uint16_t>& vec;
+    uint16_t First;
 
 public:
     EntityTileList(const CoordsXY& loc)
-        : vec(GetEntityTileList(loc))
+        : First(GetEntityTileListFirst(loc))
     {
     }
 
     EntityTileIterator<T> begin()
     {
-        return EntityTileIterator<T>(std::begin(vec), std::end(vec));
+        return EntityTileIterator<T>(First);
     }
     EntityTileIterator<T> end()
     {
-        return EntityTileIterator<T>(std::end(vec), std::end(vec));
+        return EntityTileIterator<T>(SPRITE_INDEX_NULL);
     }
 };
 
+/**
+ * Calls fn for every entity of type T that is at most range units away from loc on both the x and y axis. Only the tiles
+ * of the spatial index that overlap the range are visited.
+ */
+template<typename T, typename TFn> void ForEachEntityInRange(const CoordsXY& loc, int32_t range, TFn fn)
+{
+    constexpr int32_t maxTile = MAXIMUM_MAP_SIZE_TECHNICAL - 1;
+    const int32_t tileLeft = std::clamp((loc.x - range) / COORDS_XY_STEP, 0, maxTile);
+    const int32_t tileRight = std::clamp((loc.x + range) / COORDS_XY_STEP, 0, maxTile);
+    const int32_t tileTop = std::clamp((loc.y - range) / COORDS_XY_STEP, 0, maxTile);
+    const int32_t tileBottom = std::clamp((loc.y + range) / COORDS_XY_STEP, 0, maxTile);
+    for (int32_t tileX = tileLeft; tileX <= tileRight; tileX++)
+    {
+        for (int32_t tileY = tileTop; tileY <= tileBottom; tileY++)
+        {
+            for (auto* entity : EntityTileList<T>(TileCoordsXY{ tileX, tileY }.ToCoordsXY()))
+            {
+                if (std::abs(entity->x - loc.x) <= range && std::abs(entity->y - loc.y) <= range)
+                {
+                    fn(entity);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Returns the entity of type T with the smallest distanceFn(entity) that does not exceed maxDistance, or nullptr. The
+ * distance function must never be less than the largest of the x and y distance to loc. Ties are resolved to the
+ * lowest sprite index so the result is the same as a linear search through EntityList<T>.
+ */
+template<typename T, typename TDistanceFn>
+T* GetNearestEntity(const CoordsXY& loc, int32_t maxDistance, TDistanceFn distanceFn)
+{
+    T* nearestEntity = nullptr;
+    int32_t nearestDistance = maxDistance + 1;
+    ForEachEntityInRange<T>(loc, maxDistance, [&](T* entity) {
+        int32_t distance = distanceFn(*entity);
+        if (distance < nearestDistance
+            || (distance == nearestDistance && nearestEntity != nullptr && entity->sprite_index < nearestEntity->sprite_index))
+        {
+            nearestDistance = distance;
+            nearestEntity = entity;
+        }
+    });
+    return nearestEntity;
+}
+
 template<typename T> class EntityListIterator
 {
 private:
-    std::list<uint16_t>::const_iterator iter;
-    std::list<uint16_t>::const_iterator end;
+    const EntityIndexSet* set;
+    uint16_t next;
     T* Entity = nullptr;
 
 public:
-    EntityListIterator(std::list<uint16_t>::const_iterator _iter, std::list<uint16_t>::const_iterator _end)
-        : iter(_iter)
-        , end(_end)
+    EntityListIterator(const EntityIndexSet& _set, uint16_t _next)
+        : set(&_set)
+        , next(_next)
     {
         ++(*this);
     }
@@ -121,9 +176,17 @@ public:
     {
         Entity = nullptr;
 
-        while (iter != end && Entity == nullptr)
+        // The next index is looked up as soon as an entity is returned, entities added before it while the current
+        // entity is processed are not visited. The lookup starts from the entity that was next at that time so the
+        // current entity may be removed from the set.
+        while (next != SPRITE_INDEX_NULL && Entity == nullptr)
+        {
+            Entity = GetEntity<T>(next);
+            next = set->FindFrom(next + 1);
+        }
+        if (next != SPRITE_INDEX_NULL)
         {
-            Entity = GetEntity<T>(*iter++);
+            PrefetchEntity(next);
         }
         return *this;
     }
@@ -132,7 +195,7 @@ public:
     {
         EntityListIterator retval = *this;
         ++(*this);
-        return *iter;
+        return retval;
     }
     bool operator==(EntityListIterator other) const
     {
@@ -158,7 +221,7 @@ template<typename T = SpriteBase> class EntityList
 {
 private:
     using EntityListIterator_t = EntityListIterator<T>;
-    const std::list<uint16_t>& vec;
+    const EntityIndexSet& vec;
 
 public:
     EntityList()
@@ -168,10 +231,10 @@ public:
 
     EntityListIterator_t begin()
     {
-        return EntityListIterator_t(std::cbegin(vec), std::cend(vec));
+        return EntityListIterator_t(vec, vec.FindFrom(0));
     }
     EntityListIterator_t end()
     {
-        return EntityListIterator_t(std::cend(vec), std::cend(vec));
+        return EntityListIterator_t(vec, SPRITE_INDEX_NULL);
     }
 };
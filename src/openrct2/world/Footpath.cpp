@@ -23,6 +23,7 @@
 #include "../object/ObjectList.h"
 #include "../object/ObjectManager.h"
 #include "../paint/VirtualFloor.h"
+#include "../peep/GuestPathfinding.h"
 #include "../ride/RideData.h"
 #include "../ride/Station.h"
 #include "../ride/Track.h"
@@ -36,7 +37,9 @@
 #include "Surface.h"
 
 #include <algorithm>
+#include <bitset>
 #include <iterator>
+#include <optional>
 
 void footpath_update_queue_entrance_banner(const CoordsXY& footpathPos, TileElement* tileElement);
 
@@ -57,6 +60,10 @@ uint8_t gFootpathGroundFlags;
 static uint8_t* _footpathQueueChainNext;
 static uint8_t _footpathQueueChain[64];
 
+// Tiles whose wide flags could change the next time they are recalculated. The wide flags of a tile only depend on the
+// paths of the tile itself and the eight tiles around it, so a tile stays clean until one of those changes.
+static std::bitset<MAXIMUM_MAP_SIZE_TECHNICAL * MAXIMUM_MAP_SIZE_TECHNICAL> _footpathWideFlagsDirty;
+
 // This is the coordinates that a user of the bin should move to
 // rct2: 0x00992A4C
 const CoordsXY BinUseOffsets[4] = {
@@ -200,6 +207,31 @@ money32 footpath_provisional_set(int32_t type, const CoordsXYZ& footpathLoc, int
     return cost;
 }
 
+/**
+ * Puts back the provisional footpath that map_remove_provisional_elements stashed. The ghost returns to the exact
+ * place it was taken from, so unlike footpath_provisional_set the viewport visibility and virtual floor are left
+ * alone, which saves invalidating the virtual floor every tick while a path is being placed.
+ */
+void footpath_provisional_restore()
+{
+    auto footpathPlaceAction = FootpathPlaceAction(
+        gFootpathProvisionalPosition, gFootpathProvisionalSlope, gFootpathProvisionalType);
+    footpathPlaceAction.SetFlags(GAME_COMMAND_FLAG_GHOST | GAME_COMMAND_FLAG_ALLOW_DURING_PAUSED);
+    auto res = GameActions::Execute(&footpathPlaceAction);
+    if (res->Error == GameActions::Status::Ok)
+    {
+        gFootpathProvisionalFlags |= PROVISIONAL_PATH_FLAG_1;
+        return;
+    }
+
+    // Something was built where the ghost was, hide the virtual floor as footpath_provisional_set does
+    virtual_floor_invalidate();
+    if (!scenery_tool_is_active())
+    {
+        virtual_floor_set_height(0);
+    }
+}
+
 /**
  *
  *  rct2: 0x006A77FF
@@ -1000,17 +1032,12 @@ static void loc_6A6C85(
     loc_6A6D7E(pos, direction, tileElementPos.element, flags, query, neighbourList);
 }
 
-/**
- *
- *  rct2: 0x006A6C66
- */
-void footpath_connect_edges(const CoordsXY& footpathPos, TileElement* tileElement, int32_t flags)
+static void footpath_connect_element_edges(const CoordsXY& footpathPos, TileElement* tileElement, int32_t flags)
 {
     rct_neighbour_list neighbourList;
     rct_neighbour neighbour;
 
-    footpath_update_queue_chains();
-
+    footpath_invalidate_wide_flags(footpathPos, 1);
     neighbour_list_init(&neighbourList);
 
     footpath_update_queue_entrance_banner(footpathPos, tileElement);
@@ -1061,6 +1088,30 @@ void footpath_connect_edges(const CoordsXY& footpathPos, TileElement* tileElemen
     }
 }
 
+/**
+ *
+ *  rct2: 0x006A6C66
+ */
+void footpath_connect_edges(const CoordsXY& footpathPos, TileElement* tileElement, int32_t flags)
+{
+    // Connecting changes the edges and corners of the path and its neighbours
+    peep_pathfind_invalidate_cache();
+    footpath_update_queue_chains();
+
+    footpath_connect_element_edges(footpathPos, tileElement, flags);
+}
+
+void footpath_reconnect_edges(const std::vector<CoordsXYE>& elements, int32_t flags)
+{
+    footpath_queue_chain_reset();
+    for (const auto& element : elements)
+    {
+        footpath_remove_edges_at(element, element.element);
+        footpath_connect_element_edges(element, element.element, flags);
+    }
+    footpath_update_queue_chains();
+}
+
 /**
  *
  *  rct2: 0x006A742F
@@ -1076,6 +1127,8 @@ void footpath_chain_ride_queue(
     int32_t baseZ = tileElement->GetBaseZ();
     int32_t lastPathDirection = direction;
 
+    peep_pathfind_invalidate_cache();
+
     lastPathElement = nullptr;
     lastQueuePathElement = nullptr;
     for (;;)
@@ -1199,6 +1252,10 @@ void footpath_queue_chain_push(ride_id_t rideIndex)
 {
     if (rideIndex != RIDE_ID_NULL)
     {
+        // Chaining the queues of a ride twice gives the same result, only keep one entry for it
+        if (std::find(_footpathQueueChain, _footpathQueueChainNext, rideIndex) != _footpathQueueChainNext)
+            return;
+
         uint8_t* lastSlot = _footpathQueueChain + std::size(_footpathQueueChain) - 1;
         if (_footpathQueueChainNext <= lastSlot)
         {
@@ -1748,15 +1805,36 @@ static TileElement* footpath_can_be_wide(const CoordsXYZ& footpathPos)
     return nullptr;
 }
 
+/**
+ * Returns the wide flags of the path elements at the given location as a bit set, or std::nullopt if there are too
+ * many path elements to fit.
+ */
+static std::optional<uint64_t> footpath_get_wide_flags(const CoordsXY& footpathPos)
+{
+    uint64_t wideFlags = 0;
+    uint32_t index = 0;
+    TileElement* tileElement = map_get_first_element_at(footpathPos);
+    if (tileElement == nullptr)
+        return wideFlags;
+    do
+    {
+        if (tileElement->GetType() != TILE_ELEMENT_TYPE_PATH)
+            continue;
+        if (index >= 64)
+            return std::nullopt;
+        if (tileElement->AsPath()->IsWide())
+            wideFlags |= 1ULL << index;
+        index++;
+    } while (!(tileElement++)->IsLastForTile());
+    return wideFlags;
+}
+
 /**
  *
  *  rct2: 0x006A87BB
  */
-void footpath_update_path_wide_flags(const CoordsXY& footpathPos)
+static void footpath_update_path_wide_flags_at(const CoordsXY& footpathPos)
 {
-    if (map_is_location_at_edge(footpathPos))
-        return;
-
     footpath_clear_wide(footpathPos);
     /* Rather than clearing the wide flag of the following tiles and
      * checking the state of them later, leave them intact and assume
@@ -1937,6 +2015,65 @@ void footpath_update_path_wide_flags(const CoordsXY& footpathPos)
     } while (!(tileElement++)->IsLastForTile());
 }
 
+static size_t footpath_get_wide_flags_dirty_index(const TileCoordsXY& tilePos)
+{
+    return tilePos.y * MAXIMUM_MAP_SIZE_TECHNICAL + tilePos.x;
+}
+
+/**
+ * Marks the tiles whose wide flags depend on any of the tiles within radius of the given tile.
+ */
+static void footpath_invalidate_wide_flags_around(const TileCoordsXY& centre, int32_t radius)
+{
+    const int32_t left = std::max(centre.x - radius - 1, 0);
+    const int32_t right = std::min(centre.x + radius + 1, MAXIMUM_MAP_SIZE_TECHNICAL - 1);
+    const int32_t top = std::max(centre.y - radius - 1, 0);
+    const int32_t bottom = std::min(centre.y + radius + 1, MAXIMUM_MAP_SIZE_TECHNICAL - 1);
+    for (int32_t y = top; y <= bottom; y++)
+    {
+        for (int32_t x = left; x <= right; x++)
+        {
+            _footpathWideFlagsDirty.set(footpath_get_wide_flags_dirty_index({ x, y }));
+        }
+    }
+}
+
+void footpath_invalidate_wide_flags(const CoordsXY& footpathPos, int32_t radius)
+{
+    footpath_invalidate_wide_flags_around(TileCoordsXY{ footpathPos }, radius);
+}
+
+void footpath_invalidate_wide_flags_all()
+{
+    _footpathWideFlagsDirty.set();
+}
+
+void footpath_update_path_wide_flags(const CoordsXY& footpathPos)
+{
+    if (map_is_location_at_edge(footpathPos))
+        return;
+
+    // Recalculating a tile whose paths and neighbouring paths have not changed since it was last recalculated gives the
+    // same wide flags again, so it can be skipped without changing the result.
+    auto tilePos = TileCoordsXY{ footpathPos };
+    auto dirtyIndex = footpath_get_wide_flags_dirty_index(tilePos);
+    if (!_footpathWideFlagsDirty.test(dirtyIndex))
+        return;
+    _footpathWideFlagsDirty.reset(dirtyIndex);
+
+    // Wide paths end the guest pathfinding searches, so any changed wide flag invalidates the cached results.
+    auto wideFlagsBefore = footpath_get_wide_flags(footpathPos);
+    footpath_update_path_wide_flags_at(footpathPos);
+    if (!wideFlagsBefore.has_value() || footpath_get_wide_flags(footpathPos) != wideFlagsBefore)
+    {
+        peep_pathfind_invalidate_cache();
+
+        // The wide flags of a tile are not an input to its own recalculation, only to that of its neighbours
+        footpath_invalidate_wide_flags_around(tilePos, 0);
+        _footpathWideFlagsDirty.reset(dirtyIndex);
+    }
+}
+
 bool footpath_is_blocked_by_vehicle(const TileCoordsXYZ& position)
 {
     auto pathElement = map_get_path_element_at(position);
@@ -2203,6 +2340,8 @@ void footpath_remove_edges_at(const CoordsXY& footpathPos, TileElement* tileElem
             return;
     }
 
+    peep_pathfind_invalidate_cache();
+    footpath_invalidate_wide_flags(footpathPos, 1);
     footpath_update_queue_entrance_banner(footpathPos, tileElement);
 
     bool fixCorners = false;
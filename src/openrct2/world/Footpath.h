@@ -13,6 +13,8 @@
 #include "../interface/Viewport.h"
 #include "../object/Object.h"
 
+#include <vector>
+
 enum
 {
     PROVISIONAL_PATH_FLAG_SHOW_ARROW = (1 << 0),
@@ -27,6 +29,8 @@ constexpr auto PATH_CLEARANCE = 4 * COORDS_Z_STEP;
 
 #define FOOTPATH_ELEMENT_INSERT_QUEUE 0x80
 
+struct CoordsXYE;
+
 using PathSurfaceIndex = uint16_t;
 constexpr PathSurfaceIndex PATH_SURFACE_INDEX_NULL = static_cast<PathSurfaceIndex>(-1);
 
@@ -182,16 +186,31 @@ void footpath_interrupt_peeps(const CoordsXYZ& footpathPos);
 money32 footpath_remove(const CoordsXYZ& footpathLoc, int32_t flags);
 money32 footpath_provisional_set(int32_t type, const CoordsXYZ& footpathLoc, int32_t slope);
 void footpath_provisional_remove();
+void footpath_provisional_restore();
 void footpath_provisional_update();
 CoordsXY footpath_get_coordinates_from_pos(const ScreenCoordsXY& screenCoords, int32_t* direction, TileElement** tileElement);
 CoordsXY footpath_bridge_get_info_from_pos(const ScreenCoordsXY& screenCoords, int32_t* direction, TileElement** tileElement);
 void footpath_remove_litter(const CoordsXYZ& footpathPos);
 void footpath_connect_edges(const CoordsXY& footpathPos, TileElement* tileElement, int32_t flags);
+
+/**
+ * Removes and connects the edges of each element again, in order, as footpath_remove_edges_at followed by
+ * footpath_connect_edges would. The queues of the rides the elements touch are chained once after all of them rather
+ * than after each element.
+ */
+void footpath_reconnect_edges(const std::vector<CoordsXYE>& elements, int32_t flags);
 void footpath_update_queue_chains();
 bool fence_in_the_way(const CoordsXYRangedZ& fencePos, int32_t direction);
 void footpath_chain_ride_queue(
     ride_id_t rideIndex, int32_t entranceIndex, const CoordsXY& footpathPos, TileElement* tileElement, int32_t direction);
 void footpath_update_path_wide_flags(const CoordsXY& footpathPos);
+
+/**
+ * The wide flags of a tile are only recalculated when the paths on or around it have changed. These must be called
+ * whenever path elements change, either for the tiles within radius of a known tile or anywhere on the map.
+ */
+void footpath_invalidate_wide_flags(const CoordsXY& footpathPos, int32_t radius = 0);
+void footpath_invalidate_wide_flags_all();
 bool footpath_is_blocked_by_vehicle(const TileCoordsXYZ& position);
 
 int32_t footpath_is_connected_to_map_edge(const CoordsXYZ& footpathPos, int32_t direction, int32_t flags);
@@ -12,6 +12,7 @@
 #include "../Cheats.h"
 #include "../Context.h"
 #include "../Game.h"
+#include "../GameState.h"
 #include "../Input.h"
 #include "../OpenRCT2.h"
 #include "../actions/BannerRemoveAction.h"
@@ -36,7 +37,10 @@
 #include "../network/network.h"
 #include "../object/ObjectManager.h"
 #include "../object/TerrainSurfaceObject.h"
+#include "../peep/GuestPathfinding.h"
 #include "../ride/RideData.h"
+#include "../ride/RideProximity.h"
+#include "../ride/RideRatings.h"
 #include "../ride/Track.h"
 #include "../ride/TrackData.h"
 #include "../ride/TrackDesign.h"
@@ -57,6 +61,9 @@
 #include "Wall.h"
 
 #include <algorithm>
+#include <array>
+#include <bitset>
+#include <cstdlib>
 #include <iterator>
 #include <memory>
 
@@ -100,14 +107,44 @@ int16_t gMapSize;
 int16_t gMapSizeMaxXY;
 int16_t gMapBaseZ;
 
-TileElement gTileElements[MAX_TILE_ELEMENTS_WITH_SPARE_ROOM];
+TileElement* gTileElements;
 TileElement* gTileElementTilePointers[MAX_TILE_TILE_ELEMENT_POINTERS];
 std::vector<CoordsXY> gMapSelectionTiles;
+
+// The element types that may be present on each tile, one bit per type (the type value divided by four). A bit is set
+// whenever an element of that type is added to the tile but only cleared when the tile is recalculated.
+static uint16_t _tileElementTypeMasks[MAX_TILE_TILE_ELEMENT_POINTERS];
+static constexpr uint16_t TILE_ELEMENT_TYPE_MASK_ALL = 0xFFFF;
 std::vector<PeepSpawn> gPeepSpawns;
 
 TileElement* gNextFreeTileElement;
 uint32_t gNextFreeTileElementPointerIndex;
 
+// The tiles invalidated since map_take_changed_tiles was last called, only collected while tracking is enabled. Past
+// MAX_CHANGED_TILES the list is dropped and every tile is reported as changed.
+static constexpr size_t MAX_CHANGED_TILES = MAX_TILE_TILE_ELEMENT_POINTERS / 8;
+static bool _changedTileTracking;
+static bool _allTilesChanged = true;
+static std::vector<TileCoordsXY> _changedTiles;
+static std::bitset<MAX_TILE_TILE_ELEMENT_POINTERS> _changedTileFlags;
+
+// The tiles map_update_tiles still has work for, one bit per position of gGrassSceneryTileLoopPosition. A tile is only
+// left out when visiting it would do nothing, any change to it marks it active again until it is next visited.
+static constexpr size_t TILE_LOOP_BITS_PER_WORD = 64;
+static uint64_t _tileLoopActive[MAX_TILE_TILE_ELEMENT_POINTERS / TILE_LOOP_BITS_PER_WORD];
+static bool _tileLoopSuspended = true;
+
+// One past the highest tile element that may be non-zero, everything from here to the end of gTileElements is zero and
+// has never been touched. Whole-array operations stop here so memory that is not used by the park is not paged in.
+static TileElement* _tileElementsEnd;
+static size_t _tileElementsCapacity;
+static bool _tileElementsReorganiseEnabled = true;
+
+// Room for the elements of every tile of a new map and the given number of elements per tile inside the map, anything
+// more is allocated when the park grows
+static constexpr size_t TILE_ELEMENTS_PER_MAP_TILE = 2;
+static constexpr size_t TILE_ELEMENTS_SPARE_ROOM = MAX_TILE_ELEMENTS_WITH_SPARE_ROOM - MAX_TILE_ELEMENTS;
+
 bool gLandMountainMode;
 bool gLandPaintMode;
 bool gClearSmallScenery;
@@ -120,8 +157,45 @@ uint16_t gLandRemainingConstructionSales;
 bool gMapLandRightsUpdateSuccess;
 
 static void clear_elements_at(const CoordsXY& loc);
+static void map_mark_all_tiles_changed();
+static void map_update_tiles_mark_all_active();
 static ScreenCoordsXY translate_3d_to_2d(int32_t rotation, const CoordsXY& pos);
 
+/**
+ * Whether tile elements of the given type are looked at by the guest pathfinding heuristic search.
+ */
+static bool tile_element_affects_pathfinding(uint8_t type)
+{
+    switch (type)
+    {
+        case TILE_ELEMENT_TYPE_PATH:
+        case TILE_ELEMENT_TYPE_TRACK:
+        case TILE_ELEMENT_TYPE_ENTRANCE:
+        case TILE_ELEMENT_TYPE_BANNER:
+            return true;
+        default:
+            return false;
+    }
+}
+
+/**
+ * Whether tile elements of the given type are looked at when scoring the proximity of track pieces for ride ratings.
+ */
+static bool tile_element_affects_ride_ratings(uint8_t type)
+{
+    switch (type)
+    {
+        case TILE_ELEMENT_TYPE_SURFACE:
+        case TILE_ELEMENT_TYPE_PATH:
+        case TILE_ELEMENT_TYPE_TRACK:
+        case TILE_ELEMENT_TYPE_SMALL_SCENERY:
+        case TILE_ELEMENT_TYPE_LARGE_SCENERY:
+            return true;
+        default:
+            return false;
+    }
+}
+
 void tile_element_iterator_begin(tile_element_iterator* it)
 {
     it->x = 0;
@@ -177,6 +251,64 @@ TileElement* map_get_first_element_at(const CoordsXY& elementPos)
     return gTileElementTilePointers[tileElementPos.x + tileElementPos.y * MAXIMUM_MAP_SIZE_TECHNICAL];
 }
 
+static uint16_t tile_element_get_type_bit(uint8_t type)
+{
+    return static_cast<uint16_t>(1 << (type >> 2));
+}
+
+static uint16_t map_calculate_tile_element_types(const TileElement* tileElement)
+{
+    uint16_t mask = 0;
+    if (tileElement == nullptr)
+        return mask;
+    do
+    {
+        mask |= tile_element_get_type_bit(tileElement->GetType());
+    } while (!(tileElement++)->IsLastForTile());
+    return mask;
+}
+
+TileElement* map_get_first_element_of_type_at(const CoordsXY& elementPos, TileElementType type)
+{
+    if (!map_is_location_valid(elementPos))
+    {
+        log_verbose("Trying to access element outside of range");
+        return nullptr;
+    }
+    auto tileElementPos = TileCoordsXY{ elementPos };
+    auto index = tileElementPos.x + tileElementPos.y * MAXIMUM_MAP_SIZE_TECHNICAL;
+    if (!(_tileElementTypeMasks[index] & tile_element_get_type_bit(static_cast<uint8_t>(type))))
+        return nullptr;
+    return gTileElementTilePointers[index];
+}
+
+void map_update_tile_element_types(const CoordsXY& loc)
+{
+    if (!map_is_location_valid(loc))
+        return;
+    auto tilePos = TileCoordsXY{ loc };
+    auto index = tilePos.x + tilePos.y * MAXIMUM_MAP_SIZE_TECHNICAL;
+    _tileElementTypeMasks[index] = map_calculate_tile_element_types(gTileElementTilePointers[index]);
+    map_update_tiles_mark_active(loc);
+}
+
+void map_invalidate_tile_element_caches()
+{
+    map_mark_all_tiles_changed();
+    map_update_tiles_mark_all_active();
+    for (int32_t i = 0; i < MAX_TILE_TILE_ELEMENT_POINTERS; i++)
+    {
+        _tileElementTypeMasks[i] = map_calculate_tile_element_types(gTileElementTilePointers[i]);
+    }
+    RideProximityInvalidateAll();
+    ride_ratings_proximity_cache_invalidate_all();
+    footpath_invalidate_wide_flags_all();
+    peep_pathfind_invalidate_cache();
+    track_block_links_invalidate();
+    ride_station_elements_invalidate();
+    ride_provisional_track_invalidate_cache();
+}
+
 TileElement* map_get_nth_element_at(const CoordsXY& coords, int32_t n)
 {
     TileElement* tileElement = map_get_first_element_at(coords);
@@ -212,6 +344,15 @@ void map_set_tile_element(const TileCoordsXY& tilePos, TileElement* elements)
         return;
     }
     gTileElementTilePointers[tilePos.x + tilePos.y * MAXIMUM_MAP_SIZE_TECHNICAL] = elements;
+    // The elements may still be filled in after this call
+    _tileElementTypeMasks[tilePos.x + tilePos.y * MAXIMUM_MAP_SIZE_TECHNICAL] = TILE_ELEMENT_TYPE_MASK_ALL;
+    RideProximityInvalidateTile(tilePos.ToCoordsXY());
+    ride_ratings_proximity_cache_invalidate_tile(tilePos.ToCoordsXY());
+    footpath_invalidate_wide_flags(tilePos.ToCoordsXY());
+    map_update_tiles_mark_active(tilePos.ToCoordsXY());
+    peep_pathfind_invalidate_cache();
+    track_block_links_invalidate();
+    ride_station_elements_invalidate();
 }
 
 SurfaceElement* map_get_surface_element_at(const CoordsXY& coords)
@@ -248,6 +389,23 @@ BannerElement* map_get_banner_element_at(const CoordsXYZ& bannerPos, uint8_t pos
     return nullptr;
 }
 
+static TileElement* map_allocate_tile_elements(size_t numElements)
+{
+    // calloc leaves the zeroed memory untouched until it is used, unlike value initialising an array
+    auto* tileElements = static_cast<TileElement*>(std::calloc(numElements, sizeof(TileElement)));
+    Guard::ArgumentNotNull(tileElements, "Failed to allocate %zu tile elements", numElements);
+    return tileElements;
+}
+
+/**
+ * Returns one past the last element that may be handed out, the spare room after it is never used.
+ */
+static TileElement* map_get_tile_elements_limit()
+{
+    auto numUsableElements = std::max(_tileElementsCapacity, TILE_ELEMENTS_SPARE_ROOM) - TILE_ELEMENTS_SPARE_ROOM;
+    return gTileElements + std::min<size_t>(numUsableElements, MAX_TILE_ELEMENTS);
+}
+
 /**
  *
  *  rct2: 0x0068AB4C
@@ -256,6 +414,14 @@ void map_init(int32_t size)
 {
     gNextFreeTileElementPointerIndex = 0;
 
+    // Start over with an element list sized for the new map, any memory a previous larger park used is given back
+    std::free(gTileElements);
+    _tileElementsCapacity = std::min<size_t>(
+        MAX_TILE_TILE_ELEMENT_POINTERS + size * size * TILE_ELEMENTS_PER_MAP_TILE + TILE_ELEMENTS_SPARE_ROOM,
+        MAX_TILE_ELEMENTS_WITH_SPARE_ROOM);
+    gTileElements = map_allocate_tile_elements(_tileElementsCapacity);
+    _tileElementsEnd = gTileElements;
+
     for (int32_t i = 0; i < MAX_TILE_TILE_ELEMENT_POINTERS; i++)
     {
         TileElement* tile_element = &gTileElements[i];
@@ -340,10 +506,62 @@ void map_count_remaining_land_rights()
  */
 void map_strip_ghost_flag_from_elements()
 {
-    for (auto& element : gTileElements)
+    for (auto* element = gTileElements; element < _tileElementsEnd; element++)
+    {
+        element->SetGhost(false);
+    }
+}
+
+TileElement* map_get_tile_elements_end()
+{
+    return _tileElementsEnd;
+}
+
+void map_set_tile_elements_end(TileElement* end)
+{
+    // Clear the elements that are no longer in use so everything after the end stays zero
+    if (end < _tileElementsEnd)
     {
-        element.SetGhost(false);
+        std::memset(end, 0, (_tileElementsEnd - end) * sizeof(TileElement));
     }
+    _tileElementsEnd = end;
+}
+
+size_t map_get_tile_elements_capacity()
+{
+    return _tileElementsCapacity;
+}
+
+void map_reserve_tile_elements(size_t numElements)
+{
+    numElements = std::min<size_t>(numElements, MAX_TILE_ELEMENTS_WITH_SPARE_ROOM);
+    if (numElements <= _tileElementsCapacity)
+        return;
+
+    // Only the elements that may be in use need copying, the rest of the new list is already zero
+    auto* oldTileElements = gTileElements;
+    auto* newTileElements = map_allocate_tile_elements(numElements);
+    std::copy(oldTileElements, _tileElementsEnd, newTileElements);
+    gTileElements = newTileElements;
+    _tileElementsCapacity = numElements;
+
+    // Point everything that referred to the old list at the same elements in the new one
+    auto rebase = [oldTileElements, newTileElements](TileElement* tileElement) {
+        return tileElement == nullptr ? nullptr : newTileElements + (tileElement - oldTileElements);
+    };
+    for (auto& tilePointer : gTileElementTilePointers)
+    {
+        tilePointer = rebase(tilePointer);
+    }
+    gNextFreeTileElement = rebase(gNextFreeTileElement);
+    _tileElementsEnd = rebase(_tileElementsEnd);
+    std::free(oldTileElements);
+    map_invalidate_tile_element_caches();
+}
+
+void map_set_reorganise_enabled(bool enabled)
+{
+    _tileElementsReorganiseEnabled = enabled;
 }
 
 /**
@@ -372,33 +590,17 @@ void map_update_tile_pointers()
     }
 
     gNextFreeTileElement = tileElement;
+    _tileElementsEnd = std::max(_tileElementsEnd, gNextFreeTileElement);
+    map_invalidate_tile_element_caches();
 }
 
 /**
- * Return the absolute height of an element, given its (x,y) coordinates
- *
- * ax: x
- * cx: y
- * dx: return remember to & with 0xFFFF if you don't want water affecting results
- *  rct2: 0x00662783
+ * The height of the surface above its base at the given position within the tile, for every slope.
  */
-int16_t tile_element_height(const CoordsXY& loc)
+static uint8_t surface_get_height_offset(uint32_t slope, uint8_t xl, uint8_t yl)
 {
-    // Off the map
-    if (!map_is_location_valid(loc))
-        return MINIMUM_LAND_HEIGHT_BIG;
+    uint16_t height = 0;
 
-    // Get the surface element for the tile
-    auto surfaceElement = map_get_surface_element_at(loc);
-
-    if (surfaceElement == nullptr)
-    {
-        return MINIMUM_LAND_HEIGHT_BIG;
-    }
-
-    uint16_t height = surfaceElement->GetBaseZ();
-
-    uint32_t slope = surfaceElement->GetSlope();
     uint8_t extra_height = (slope & TILE_ELEMENT_SLOPE_DOUBLE_HEIGHT) >> 4; // 0x10 is the 5th bit - sets slope to double height
     // Remove the extra height bit
     slope &= TILE_ELEMENT_SLOPE_ALL_CORNERS_UP;
@@ -406,13 +608,8 @@ int16_t tile_element_height(const CoordsXY& loc)
     int8_t quad = 0, quad_extra = 0; // which quadrant the element is in?
                                      // quad_extra is for extra height tiles
 
-    uint8_t xl, yl; // coordinates across this tile
-
     uint8_t TILE_SIZE = 31;
 
-    xl = loc.x & 0x1f;
-    yl = loc.y & 0x1f;
-
     // Slope logic:
     // Each of the four bits in slope represents that corner being raised
     // slope == 15 (all four bits) is not used and slope == 0 is flat
@@ -528,6 +725,57 @@ int16_t tile_element_height(const CoordsXY& loc)
     return height;
 }
 
+// The height offsets of surface_get_height_offset indexed by slope, then by the position within the tile, so surface
+// heights are a table read instead of branching on the slope per query
+static constexpr size_t SURFACE_HEIGHT_OFFSETS_PER_SLOPE = COORDS_XY_STEP * COORDS_XY_STEP;
+using SurfaceHeightOffsets
+    = std::array<std::array<uint8_t, SURFACE_HEIGHT_OFFSETS_PER_SLOPE>, TILE_ELEMENT_SURFACE_SLOPE_MASK + 1>;
+
+static SurfaceHeightOffsets create_surface_height_offsets()
+{
+    SurfaceHeightOffsets offsets{};
+    for (uint32_t slope = 0; slope < offsets.size(); slope++)
+    {
+        for (uint8_t yl = 0; yl < COORDS_XY_STEP; yl++)
+        {
+            for (uint8_t xl = 0; xl < COORDS_XY_STEP; xl++)
+            {
+                offsets[slope][yl * COORDS_XY_STEP + xl] = surface_get_height_offset(slope, xl, yl);
+            }
+        }
+    }
+    return offsets;
+}
+
+static const SurfaceHeightOffsets _surfaceHeightOffsets = create_surface_height_offsets();
+
+/**
+ * Return the absolute height of an element, given its (x,y) coordinates
+ *
+ * ax: x
+ * cx: y
+ * dx: return remember to & with 0xFFFF if you don't want water affecting results
+ *  rct2: 0x00662783
+ */
+int16_t tile_element_height(const CoordsXY& loc)
+{
+    // Off the map
+    if (!map_is_location_valid(loc))
+        return MINIMUM_LAND_HEIGHT_BIG;
+
+    // Get the surface element for the tile
+    auto surfaceElement = map_get_surface_element_at(loc);
+
+    if (surfaceElement == nullptr)
+    {
+        return MINIMUM_LAND_HEIGHT_BIG;
+    }
+
+    auto positionInTile = (loc.y & (COORDS_XY_STEP - 1)) * COORDS_XY_STEP + (loc.x & (COORDS_XY_STEP - 1));
+    auto slope = surfaceElement->GetSlope() & TILE_ELEMENT_SURFACE_SLOPE_MASK;
+    return surfaceElement->GetBaseZ() + _surfaceHeightOffsets[slope][positionInTile];
+}
+
 int16_t tile_element_water_height(const CoordsXY& loc)
 {
     // Off the map
@@ -912,6 +1160,27 @@ bool map_is_location_at_edge(const CoordsXY& loc)
  */
 void tile_element_remove(TileElement* tileElement)
 {
+    // The location of the element is not known here
+    if (tileElement->GetType() == TILE_ELEMENT_TYPE_TRACK)
+    {
+        RideProximityInvalidateAll();
+    }
+    if (tile_element_affects_ride_ratings(tileElement->GetType()))
+    {
+        ride_ratings_proximity_cache_invalidate_all();
+    }
+    if (tileElement->GetType() == TILE_ELEMENT_TYPE_PATH)
+    {
+        footpath_invalidate_wide_flags_all();
+    }
+    if (tile_element_affects_pathfinding(tileElement->GetType()))
+    {
+        peep_pathfind_invalidate_cache();
+    }
+    // Removing any element moves the elements after it
+    track_block_links_invalidate();
+    ride_station_elements_invalidate();
+
     // Replace Nth element by (N+1)th element.
     // This loop will make tileElement point to the old last element position,
     // after copy it to it's new position
@@ -1039,14 +1308,9 @@ void map_reorganise_elements()
 {
     context_setcurrentcursor(CursorID::ZZZ);
 
-    auto newTileElements = std::make_unique<TileElement[]>(MAX_TILE_ELEMENTS_WITH_SPARE_ROOM);
-    TileElement* newElementsPtr = newTileElements.get();
-
-    if (newTileElements == nullptr)
-    {
-        log_fatal("Unable to allocate memory for map elements.");
-        return;
-    }
+    // Only the elements in use are copied, so the buffer is sized for those rather than the whole element list
+    std::vector<TileElement> newTileElements;
+    newTileElements.reserve(gNextFreeTileElement - gTileElements);
 
     for (int32_t y = 0; y < MAXIMUM_MAP_SIZE_TECHNICAL; y++)
     {
@@ -1059,15 +1323,13 @@ void map_reorganise_elements()
             while (!(endElement++)->IsLastForTile())
                 ;
 
-            const auto numElements = static_cast<uint32_t>(endElement - startElement);
-            std::memcpy(newElementsPtr, startElement, numElements * sizeof(TileElement));
-            newElementsPtr += numElements;
+            newTileElements.insert(newTileElements.end(), startElement, endElement);
         }
     }
 
-    const auto numElements = static_cast<uint32_t>(newElementsPtr - newTileElements.get());
-    std::memcpy(gTileElements, newTileElements.get(), numElements * sizeof(TileElement));
-    std::memset(gTileElements + numElements, 0, (MAX_TILE_ELEMENTS_WITH_SPARE_ROOM - numElements) * sizeof(TileElement));
+    const auto numElements = newTileElements.size();
+    std::memcpy(gTileElements, newTileElements.data(), numElements * sizeof(TileElement));
+    map_set_tile_elements_end(gTileElements + numElements);
 
     map_update_tile_pointers();
 }
@@ -1082,18 +1344,26 @@ bool map_check_free_elements_and_reorganise(int32_t numElements)
 {
     if (numElements != 0)
     {
-        auto tileElementEnd = &gTileElements[MAX_TILE_ELEMENTS];
-
         // Check if is there is room for the required number of elements
         auto newTileElementEnd = gNextFreeTileElement + numElements;
-        if (newTileElementEnd > tileElementEnd)
+        if (newTileElementEnd > map_get_tile_elements_limit())
         {
-            // Defragment the map element list
-            map_reorganise_elements();
+            if (_tileElementsReorganiseEnabled)
+            {
+                // Defragment the map element list
+                map_reorganise_elements();
+
+                // Grow the list once the park fills most of it, so it is not reorganised again after a few elements
+                size_t numElementsNeeded = (gNextFreeTileElement - gTileElements) + numElements + TILE_ELEMENTS_SPARE_ROOM;
+                if (numElementsNeeded > _tileElementsCapacity / 4 * 3)
+                {
+                    map_reserve_tile_elements(std::max(numElementsNeeded, _tileElementsCapacity) * 3 / 2);
+                }
+            }
 
             // Check if there is any room again
             newTileElementEnd = gNextFreeTileElement + numElements;
-            if (newTileElementEnd > tileElementEnd)
+            if (newTileElementEnd > map_get_tile_elements_limit())
             {
                 // Not enough spare elements left :'(
                 gGameCommandErrorText = STR_ERR_LANDSCAPE_DATA_AREA_FULL;
@@ -1104,6 +1374,42 @@ bool map_check_free_elements_and_reorganise(int32_t numElements)
     return true;
 }
 
+static TileElement* tile_element_on_inserted(const CoordsXYZ& loc, TileElementType type, TileElement* insertedElement);
+
+/**
+ * Returns whether the element directly after the given last element of a tile can be taken by that tile, which is the
+ * case when it has been freed by a previous insert or removal or when it is the next free element.
+ */
+static bool tile_element_can_grow_in_place(TileElement* lastTileElement)
+{
+    TileElement* nextTileElement = lastTileElement + 1;
+    if (nextTileElement < gNextFreeTileElement)
+    {
+        return nextTileElement->base_height == MAX_ELEMENT_HEIGHT;
+    }
+    if (nextTileElement == gNextFreeTileElement && nextTileElement < map_get_tile_elements_limit())
+    {
+        gNextFreeTileElement++;
+        return true;
+    }
+    return false;
+}
+
+static void tile_element_init_inserted(
+    TileElement* tileElement, const CoordsXYZ& loc, int32_t occupiedQuadrants, TileElementType type, bool isLastForTile)
+{
+    tileElement->type = 0;
+    tileElement->SetType(static_cast<uint8_t>(type));
+    tileElement->SetBaseZ(loc.z);
+    tileElement->Flags = 0;
+    tileElement->SetLastForTile(isLastForTile);
+    tileElement->SetOccupiedQuadrants(occupiedQuadrants);
+    tileElement->SetClearanceZ(loc.z);
+    tileElement->owner = 0;
+    std::memset(&tileElement->pad_05, 0, sizeof(tileElement->pad_05));
+    std::memset(&tileElement->pad_08, 0, sizeof(tileElement->pad_08));
+}
+
 /**
  *
  *  rct2: 0x0068B1F6
@@ -1114,6 +1420,38 @@ TileElement* tile_element_insert(const CoordsXYZ& loc, int32_t occupiedQuadrants
     TileElement *originalTileElement, *newTileElement, *insertedElement;
     bool isLastForTile = false;
 
+    originalTileElement = gTileElementTilePointers[tileLoc.y * MAXIMUM_MAP_SIZE_TECHNICAL + tileLoc.x];
+    if (originalTileElement != nullptr)
+    {
+        // The new element goes before the first element that is above the insert height
+        TileElement* insertPosition = originalTileElement;
+        while (loc.z >= insertPosition->GetBaseZ() && !insertPosition->IsLastForTile())
+            insertPosition++;
+        TileElement* lastTileElement = insertPosition;
+        while (!lastTileElement->IsLastForTile())
+            lastTileElement++;
+
+        // Insert in place if the element after the tile is free, this avoids moving the whole tile to the end of the
+        // element list which eventually requires the whole list to be reorganised.
+        if (tile_element_can_grow_in_place(lastTileElement))
+        {
+            isLastForTile = loc.z >= insertPosition->GetBaseZ();
+            if (isLastForTile)
+            {
+                insertPosition->SetLastForTile(false);
+                insertPosition++;
+            }
+            else
+            {
+                std::memmove(insertPosition + 1, insertPosition, (lastTileElement - insertPosition + 1) * sizeof(TileElement));
+            }
+            insertedElement = insertPosition;
+            tile_element_init_inserted(insertedElement, loc, occupiedQuadrants, type, isLastForTile);
+            _tileElementsEnd = std::max(_tileElementsEnd, gNextFreeTileElement);
+            return tile_element_on_inserted(loc, type, insertedElement);
+        }
+    }
+
     if (!map_check_free_elements_and_reorganise(1))
     {
         log_error("Cannot insert new element");
@@ -1153,16 +1491,7 @@ TileElement* tile_element_insert(const CoordsXYZ& loc, int32_t occupiedQuadrants
 
     // Insert new map element
     insertedElement = newTileElement;
-    newTileElement->type = 0;
-    newTileElement->SetType(static_cast<uint8_t>(type));
-    newTileElement->SetBaseZ(loc.z);
-    newTileElement->Flags = 0;
-    newTileElement->SetLastForTile(isLastForTile);
-    newTileElement->SetOccupiedQuadrants(occupiedQuadrants);
-    newTileElement->SetClearanceZ(loc.z);
-    newTileElement->owner = 0;
-    std::memset(&newTileElement->pad_05, 0, sizeof(newTileElement->pad_05));
-    std::memset(&newTileElement->pad_08, 0, sizeof(newTileElement->pad_08));
+    tile_element_init_inserted(newTileElement, loc, occupiedQuadrants, type, isLastForTile);
     newTileElement++;
 
     // Insert rest of map elements above insert height
@@ -1179,6 +1508,43 @@ TileElement* tile_element_insert(const CoordsXYZ& loc, int32_t occupiedQuadrants
     }
 
     gNextFreeTileElement = newTileElement;
+
+    // Leave a free element after the moved tile so the next insert on this tile can be done in place
+    if (gNextFreeTileElement < map_get_tile_elements_limit())
+    {
+        gNextFreeTileElement->base_height = MAX_ELEMENT_HEIGHT;
+        gNextFreeTileElement++;
+    }
+    _tileElementsEnd = std::max(_tileElementsEnd, gNextFreeTileElement);
+    return tile_element_on_inserted(loc, type, insertedElement);
+}
+
+static TileElement* tile_element_on_inserted(const CoordsXYZ& loc, TileElementType type, TileElement* insertedElement)
+{
+    const auto tileLoc = TileCoordsXY{ loc };
+    _tileElementTypeMasks[tileLoc.y * MAXIMUM_MAP_SIZE_TECHNICAL + tileLoc.x] = map_calculate_tile_element_types(
+        gTileElementTilePointers[tileLoc.y * MAXIMUM_MAP_SIZE_TECHNICAL + tileLoc.x]);
+    map_update_tiles_mark_active(loc);
+
+    if (type == TileElementType::Track)
+    {
+        RideProximityInvalidateTile(loc);
+    }
+    if (tile_element_affects_ride_ratings(static_cast<uint8_t>(type)))
+    {
+        ride_ratings_proximity_cache_invalidate_tile(loc);
+    }
+    if (type == TileElementType::Path)
+    {
+        footpath_invalidate_wide_flags(loc);
+    }
+    if (tile_element_affects_pathfinding(static_cast<uint8_t>(type)))
+    {
+        peep_pathfind_invalidate_cache();
+    }
+    // Inserting any element may move the other elements of the tile
+    track_block_links_invalidate();
+    ride_station_elements_invalidate();
     return insertedElement;
 }
 
@@ -1255,6 +1621,8 @@ void map_obstruction_set_error_text(TileElement* tileElement, GameActions::Resul
 }
 
 /**
+ * Writes the result into the given one rather than allocating it, the bool variant is called for every tile of every
+ * piece placed by large scenery, track designs and the area tools.
  *
  *  rct2: 0x0068B932
  *  ax = x
@@ -1264,34 +1632,34 @@ void map_obstruction_set_error_text(TileElement* tileElement, GameActions::Resul
  *  ebp = clearFunc
  *  bl = bl
  */
-std::unique_ptr<GameActions::ConstructClearResult> MapCanConstructWithClearAt(
-    const CoordsXYRangedZ& pos, CLEAR_FUNC clearFunc, QuarterTile quarterTile, uint8_t flags, uint8_t crossingMode)
+static void map_check_construct_clearance(
+    const CoordsXYRangedZ& pos, CLEAR_FUNC clearFunc, QuarterTile quarterTile, uint8_t flags, uint8_t crossingMode,
+    GameActions::ConstructClearResult& res)
 {
     int32_t northZ, eastZ, baseHeight, southZ, westZ, water_height;
     northZ = eastZ = baseHeight = southZ = westZ = water_height = 0;
-    auto res = std::make_unique<GameActions::ConstructClearResult>();
     uint8_t slope = 0;
 
-    res->GroundFlags = ELEMENT_IS_ABOVE_GROUND;
+    res.GroundFlags = ELEMENT_IS_ABOVE_GROUND;
     bool canBuildCrossing = false;
     if (pos.x >= gMapSizeUnits || pos.y >= gMapSizeUnits || pos.x < 32 || pos.y < 32)
     {
-        res->Error = GameActions::Status::InvalidParameters;
-        res->ErrorMessage = STR_OFF_EDGE_OF_MAP;
-        return res;
+        res.Error = GameActions::Status::InvalidParameters;
+        res.ErrorMessage = STR_OFF_EDGE_OF_MAP;
+        return;
     }
 
     if (gCheatsDisableClearanceChecks)
     {
-        return res;
+        return;
     }
 
     TileElement* tileElement = map_get_first_element_at(pos);
     if (tileElement == nullptr)
     {
-        res->Error = GameActions::Status::Unknown;
-        res->ErrorMessage = STR_NONE;
-        return res;
+        res.Error = GameActions::Status::Unknown;
+        res.ErrorMessage = STR_NONE;
+        return;
     }
     do
     {
@@ -1310,7 +1678,7 @@ std::unique_ptr<GameActions::ConstructClearResult> MapCanConstructWithClearAt(
         water_height = tileElement->AsSurface()->GetWaterHeight();
         if (water_height && water_height > pos.baseZ && tileElement->GetBaseZ() < pos.clearanceZ)
         {
-            res->GroundFlags |= ELEMENT_IS_UNDERWATER;
+            res.GroundFlags |= ELEMENT_IS_UNDERWATER;
             if (water_height < pos.clearanceZ)
             {
                 goto loc_68BAE6;
@@ -1323,9 +1691,9 @@ std::unique_ptr<GameActions::ConstructClearResult> MapCanConstructWithClearAt(
 
             if (heightFromGround > (18 * COORDS_Z_STEP))
             {
-                res->Error = GameActions::Status::Disallowed;
-                res->ErrorMessage = STR_LOCAL_AUTHORITY_WONT_ALLOW_CONSTRUCTION_ABOVE_TREE_HEIGHT;
-                return res;
+                res.Error = GameActions::Status::Disallowed;
+                res.ErrorMessage = STR_LOCAL_AUTHORITY_WONT_ALLOW_CONSTRUCTION_ABOVE_TREE_HEIGHT;
+                return;
             }
         }
 
@@ -1341,8 +1709,8 @@ std::unique_ptr<GameActions::ConstructClearResult> MapCanConstructWithClearAt(
             if (tileElement->GetBaseZ() >= pos.clearanceZ)
             {
                 // loc_68BA81
-                res->GroundFlags |= ELEMENT_IS_UNDERGROUND;
-                res->GroundFlags &= ~ELEMENT_IS_ABOVE_GROUND;
+                res.GroundFlags |= ELEMENT_IS_UNDERGROUND;
+                res.GroundFlags &= ~ELEMENT_IS_ABOVE_GROUND;
             }
             else
             {
@@ -1390,7 +1758,7 @@ std::unique_ptr<GameActions::ConstructClearResult> MapCanConstructWithClearAt(
             loc_68BABC:
                 if (clearFunc != nullptr)
                 {
-                    if (!clearFunc(&tileElement, pos, flags, &res->Cost))
+                    if (!clearFunc(&tileElement, pos, flags, &res.Cost))
                     {
                         continue;
                     }
@@ -1417,28 +1785,36 @@ std::unique_ptr<GameActions::ConstructClearResult> MapCanConstructWithClearAt(
 
                 if (tileElement != nullptr)
                 {
-                    map_obstruction_set_error_text(tileElement, *res);
-                    res->Error = GameActions::Status::NoClearance;
+                    map_obstruction_set_error_text(tileElement, res);
+                    res.Error = GameActions::Status::NoClearance;
                 }
-                return res;
+                return;
 
             loc_68BAE6:
                 if (clearFunc != nullptr)
                 {
-                    if (!clearFunc(&tileElement, pos, flags, &res->Cost))
+                    if (!clearFunc(&tileElement, pos, flags, &res.Cost))
                     {
                         goto loc_68B9B7;
                     }
                 }
                 if (tileElement != nullptr)
                 {
-                    res->Error = GameActions::Status::NoClearance;
-                    res->ErrorMessage = STR_CANNOT_BUILD_PARTLY_ABOVE_AND_PARTLY_BELOW_WATER;
+                    res.Error = GameActions::Status::NoClearance;
+                    res.ErrorMessage = STR_CANNOT_BUILD_PARTLY_ABOVE_AND_PARTLY_BELOW_WATER;
                 }
-                return res;
+                return;
             }
         }
     } while (!(tileElement++)->IsLastForTile());
+    return;
+}
+
+std::unique_ptr<GameActions::ConstructClearResult> MapCanConstructWithClearAt(
+    const CoordsXYRangedZ& pos, CLEAR_FUNC clearFunc, QuarterTile quarterTile, uint8_t flags, uint8_t crossingMode)
+{
+    auto res = std::make_unique<GameActions::ConstructClearResult>();
+    map_check_construct_clearance(pos, clearFunc, quarterTile, flags, crossingMode, *res);
     return res;
 }
 
@@ -1446,19 +1822,20 @@ bool map_can_construct_with_clear_at(
     const CoordsXYRangedZ& pos, CLEAR_FUNC clearFunc, QuarterTile quarterTile, uint8_t flags, money32* price,
     uint8_t crossingMode)
 {
-    auto res = MapCanConstructWithClearAt(pos, clearFunc, quarterTile, flags, crossingMode);
-    if (auto message = res->ErrorMessage.AsStringId())
+    GameActions::ConstructClearResult res{};
+    map_check_construct_clearance(pos, clearFunc, quarterTile, flags, crossingMode, res);
+    if (auto message = res.ErrorMessage.AsStringId())
         gGameCommandErrorText = *message;
     else
         gGameCommandErrorText = STR_NONE;
-    std::copy(res->ErrorMessageArgs.begin(), res->ErrorMessageArgs.end(), gCommonFormatArgs);
+    std::copy(res.ErrorMessageArgs.begin(), res.ErrorMessageArgs.end(), gCommonFormatArgs);
     if (price != nullptr)
     {
-        *price += res->Cost;
+        *price += res.Cost;
     }
 
-    gMapGroundFlags = res->GroundFlags;
-    return res->Error == GameActions::Status::Ok;
+    gMapGroundFlags = res.GroundFlags;
+    return res.Error == GameActions::Status::Ok;
 }
 
 /**
@@ -1474,8 +1851,75 @@ std::unique_ptr<GameActions::ConstructClearResult> MapCanConstructAt(const Coord
 {
     return MapCanConstructWithClearAt(pos, nullptr, bl, 0, CREATE_CROSSING_MODE_NONE);
 }
+static uint16_t map_get_tile_loop_position(const TileCoordsXY& tilePos)
+{
+    // The inverse of the interleaving in map_update_tiles, the lowest bits of the position are the highest of x and y
+    uint16_t position = 0;
+    for (int32_t i = 0; i < 8; i++)
+    {
+        position |= ((tilePos.x >> (7 - i)) & 1) << (2 * i);
+        position |= ((tilePos.y >> (7 - i)) & 1) << (2 * i + 1);
+    }
+    return position;
+}
+
+static TileCoordsXY map_get_tile_loop_tile(uint16_t position)
+{
+    int32_t x = 0;
+    int32_t y = 0;
+    for (int32_t i = 0; i < 8; i++)
+    {
+        x = (x << 1) | (position & 1);
+        position >>= 1;
+        y = (y << 1) | (position & 1);
+        position >>= 1;
+    }
+    return { x, y };
+}
+
+void map_update_tiles_mark_active(const CoordsXY& loc)
+{
+    if (!map_is_location_valid(loc))
+        return;
+
+    auto position = map_get_tile_loop_position(TileCoordsXY{ loc });
+    _tileLoopActive[position / TILE_LOOP_BITS_PER_WORD] |= 1ULL << (position % TILE_LOOP_BITS_PER_WORD);
+}
+
+static void map_update_tiles_mark_all_active()
+{
+    std::fill(std::begin(_tileLoopActive), std::end(_tileLoopActive), ~0ULL);
+}
+
+/**
+ * Whether visiting the tile could still change anything: grass that grows or has to be cleared, aging scenery or
+ * jumping fountains. Ghosts are included so the result does not depend on the network mode.
+ */
+static bool map_update_tiles_has_work(const CoordsXY& loc, const SurfaceElement* surfaceElement)
+{
+    if (surfaceElement->CanGrassGrow())
+    {
+        bool clearsGrass = surfaceElement->GetWaterHeight() > surfaceElement->GetBaseZ() || !map_is_location_in_park(loc);
+        if (!clearsGrass || (surfaceElement->GetGrassLength() & 7) != GRASS_LENGTH_CLEAR_0)
+            return true;
+    }
+
+    const TileElement* tileElement = map_get_first_element_at(loc);
+    if (tileElement == nullptr)
+        return false;
+    do
+    {
+        if (tileElement->GetType() == TILE_ELEMENT_TYPE_SMALL_SCENERY)
+            return true;
+        if (tileElement->GetType() == TILE_ELEMENT_TYPE_PATH && tileElement->AsPath()->HasAddition())
+            return true;
+    } while (!(tileElement++)->IsLastForTile());
+    return false;
+}
+
 /**
- * Updates grass length, scenery age and jumping fountains.
+ * Updates grass length, scenery age and jumping fountains. The loop still advances 43 positions per tick but only
+ * visits the active tiles among them, so its cost follows the number of tiles that have work rather than the map size.
  *
  *  rct2: 0x006646E1
  */
@@ -1483,33 +1927,62 @@ void map_update_tiles()
 {
     int32_t ignoreScreenFlags = SCREEN_FLAGS_SCENARIO_EDITOR | SCREEN_FLAGS_TRACK_DESIGNER | SCREEN_FLAGS_TRACK_MANAGER;
     if (gScreenFlags & ignoreScreenFlags)
+    {
+        _tileLoopSuspended = true;
         return;
+    }
+    // Tiles may have been changed without being marked while the loop did not run, such as terrain objects in the editor
+    if (_tileLoopSuspended)
+    {
+        _tileLoopSuspended = false;
+        map_update_tiles_mark_all_active();
+    }
 
     // Update 43 more tiles
-    for (int32_t j = 0; j < 43; j++)
+    int32_t remaining = 43;
+    while (remaining > 0)
     {
-        int32_t x = 0;
-        int32_t y = 0;
+        uint16_t position = gGrassSceneryTileLoopPosition;
+        auto bitIndex = static_cast<int32_t>(position % TILE_LOOP_BITS_PER_WORD);
+        uint64_t word = _tileLoopActive[position / TILE_LOOP_BITS_PER_WORD] >> bitIndex;
+        if (word == 0)
+        {
+            // Skip the rest of the word, words never straddle the point where the position wraps around
+            auto skip = std::min<int32_t>(remaining, TILE_LOOP_BITS_PER_WORD - bitIndex);
+            gGrassSceneryTileLoopPosition = static_cast<uint16_t>(position + skip);
+            remaining -= skip;
+            continue;
+        }
 
-        uint16_t interleaved_xy = gGrassSceneryTileLoopPosition;
-        for (int32_t i = 0; i < 8; i++)
+        auto skip = bitscanforward(static_cast<int64_t>(word));
+        if (skip >= remaining)
         {
-            x = (x << 1) | (interleaved_xy & 1);
-            interleaved_xy >>= 1;
-            y = (y << 1) | (interleaved_xy & 1);
-            interleaved_xy >>= 1;
+            gGrassSceneryTileLoopPosition = static_cast<uint16_t>(position + remaining);
+            break;
         }
+        position += skip;
+        remaining -= skip;
 
-        auto mapPos = TileCoordsXY{ x, y }.ToCoordsXY();
+        auto mapPos = map_get_tile_loop_tile(position).ToCoordsXY();
         auto* surfaceElement = map_get_surface_element_at(mapPos);
+        bool active = false;
         if (surfaceElement != nullptr)
         {
             surfaceElement->UpdateGrassLength(mapPos);
             scenery_update_tile(mapPos);
+            if (OpenRCT2::gLogicCounters != nullptr)
+            {
+                OpenRCT2::gLogicCounters->TilesUpdated++;
+            }
+            active = map_update_tiles_has_work(mapPos, surfaceElement);
+        }
+        if (!active)
+        {
+            _tileLoopActive[position / TILE_LOOP_BITS_PER_WORD] &= ~(1ULL << (position % TILE_LOOP_BITS_PER_WORD));
         }
 
-        gGrassSceneryTileLoopPosition++;
-        gGrassSceneryTileLoopPosition &= 0xFFFF;
+        gGrassSceneryTileLoopPosition = static_cast<uint16_t>(position + 1);
+        remaining--;
     }
 }
 
@@ -1539,7 +2012,7 @@ void map_restore_provisional_elements()
     if (gFootpathProvisionalFlags & PROVISIONAL_PATH_FLAG_1)
     {
         gFootpathProvisionalFlags &= ~PROVISIONAL_PATH_FLAG_1;
-        footpath_provisional_set(gFootpathProvisionalType, gFootpathProvisionalPosition, gFootpathProvisionalSlope);
+        footpath_provisional_restore();
     }
     if (window_find_by_class(WC_RIDE_CONSTRUCTION) != nullptr)
     {
@@ -2000,8 +2473,60 @@ ScreenCoordsXY translate_3d_to_2d_with_z(int32_t rotation, const CoordsXYZ& pos)
     return ScreenCoordsXY{ rotated.y - rotated.x, ((rotated.x + rotated.y) >> 1) - pos.z };
 }
 
+static void map_mark_all_tiles_changed()
+{
+    _allTilesChanged = true;
+    _changedTiles.clear();
+    _changedTileFlags.reset();
+}
+
+static void map_mark_tile_changed(const CoordsXY& loc)
+{
+    if (!_changedTileTracking || _allTilesChanged || !map_is_location_valid(loc))
+        return;
+
+    const auto tilePos = TileCoordsXY{ loc };
+    const auto index = tilePos.x + tilePos.y * MAXIMUM_MAP_SIZE_TECHNICAL;
+    if (_changedTileFlags[index])
+        return;
+
+    if (_changedTiles.size() >= MAX_CHANGED_TILES)
+    {
+        map_mark_all_tiles_changed();
+        return;
+    }
+    _changedTileFlags[index] = true;
+    _changedTiles.push_back(tilePos);
+}
+
+void map_set_changed_tile_tracking(bool enabled)
+{
+    _changedTileTracking = enabled;
+    map_mark_all_tiles_changed();
+    _changedTiles.shrink_to_fit();
+}
+
+bool map_take_changed_tiles(std::vector<TileCoordsXY>& tiles)
+{
+    tiles.clear();
+    if (_allTilesChanged)
+    {
+        _allTilesChanged = false;
+        return false;
+    }
+
+    for (const auto& tilePos : _changedTiles)
+    {
+        _changedTileFlags[tilePos.x + tilePos.y * MAXIMUM_MAP_SIZE_TECHNICAL] = false;
+    }
+    std::swap(tiles, _changedTiles);
+    return true;
+}
+
 static void map_invalidate_tile_under_zoom(int32_t x, int32_t y, int32_t z0, int32_t z1, int32_t maxZoom)
 {
+    map_mark_tile_changed({ x, y });
+    map_update_tiles_mark_active({ x, y });
     if (gOpenRCT2Headless)
         return;
 
@@ -2067,6 +2592,15 @@ void map_invalidate_region(const CoordsXY& mins, const CoordsXY& maxs)
     x0 = mins.x + 16;
     y0 = mins.y + 16;
 
+    for (int32_t y = mins.y; y <= maxs.y; y += COORDS_XY_STEP)
+    {
+        for (int32_t x = mins.x; x <= maxs.x; x += COORDS_XY_STEP)
+        {
+            map_mark_tile_changed({ x, y });
+            map_update_tiles_mark_active({ x, y });
+        }
+    }
+
     x1 = maxs.x + 16;
     y1 = maxs.y + 16;
 
@@ -2164,7 +2698,7 @@ void map_clear_all_elements()
  */
 TrackElement* map_get_track_element_at(const CoordsXYZ& trackPos)
 {
-    TileElement* tileElement = map_get_first_element_at(trackPos);
+    TileElement* tileElement = map_get_first_element_of_type_at(trackPos, TileElementType::Track);
     if (tileElement == nullptr)
         return nullptr;
     do
@@ -2372,7 +2906,7 @@ TileElement* map_get_track_element_at_with_direction_from_ride(const CoordsXYZD&
 
 WallElement* map_get_wall_element_at(const CoordsXYRangedZ& coords)
 {
-    auto tileElement = map_get_first_element_at(coords);
+    auto tileElement = map_get_first_element_of_type_at(coords, TileElementType::Wall);
 
     if (tileElement != nullptr)
     {
@@ -2392,7 +2926,7 @@ WallElement* map_get_wall_element_at(const CoordsXYRangedZ& coords)
 WallElement* map_get_wall_element_at(const CoordsXYZD& wallCoords)
 {
     auto tileWallCoords = TileCoordsXYZ(wallCoords);
-    TileElement* tileElement = map_get_first_element_at(wallCoords);
+    TileElement* tileElement = map_get_first_element_of_type_at(wallCoords, TileElementType::Wall);
     if (tileElement == nullptr)
         return nullptr;
     do
@@ -117,7 +117,8 @@ extern uint8_t gMapSelectArrowDirection;
 
 extern uint8_t gMapGroundFlags;
 
-extern TileElement gTileElements[MAX_TILE_ELEMENTS_WITH_SPARE_ROOM];
+// Sized for the loaded map by map_init and grown as elements are added, up to MAX_TILE_ELEMENTS_WITH_SPARE_ROOM
+extern TileElement* gTileElements;
 extern TileElement* gTileElementTilePointers[MAX_TILE_TILE_ELEMENT_POINTERS];
 
 extern std::vector<CoordsXY> gMapSelectionTiles;
@@ -178,8 +179,53 @@ void map_init(int32_t size);
 
 void map_count_remaining_land_rights();
 void map_strip_ghost_flag_from_elements();
+
+/**
+ * Returns one past the last element of gTileElements that may be in use, all elements after it are zero.
+ */
+TileElement* map_get_tile_elements_end();
+
+/**
+ * Moves the end of the used tile elements, for when the element list has been replaced as a whole. Elements between a
+ * new end and the previous one are cleared.
+ */
+void map_set_tile_elements_end(TileElement* end);
+
+/**
+ * Returns the number of elements gTileElements has room for, including the spare room after MAX_TILE_ELEMENTS.
+ */
+size_t map_get_tile_elements_capacity();
+
+/**
+ * Makes sure gTileElements has room for at least the given number of elements, growing it when needed. Growing moves
+ * the elements, so pointers to them do not survive the call, the same as for map_reorganise_elements.
+ */
+void map_reserve_tile_elements(size_t numElements);
+
+/**
+ * Allows or forbids map_check_free_elements_and_reorganise to defragment or grow the element list when it runs out of
+ * room, for while elements outside of the tile pointers must stay where they are.
+ */
+void map_set_reorganise_enabled(bool enabled);
 void map_update_tile_pointers();
 TileElement* map_get_first_element_at(const CoordsXY& elementPos);
+
+/**
+ * Returns the first element of the tile like map_get_first_element_at, or nullptr if the tile is known to contain no
+ * element of the given type. Each tile keeps the set of element types it contains next to its tile pointer.
+ */
+TileElement* map_get_first_element_of_type_at(const CoordsXY& elementPos, TileElementType type);
+
+/**
+ * Recalculates the element types of a tile after elements have been changed in place.
+ */
+void map_update_tile_element_types(const CoordsXY& loc);
+
+/**
+ * Recalculates the element types of every tile and drops all cached results derived from the tile elements, for when
+ * the elements and tile pointers have been replaced as a whole.
+ */
+void map_invalidate_tile_element_caches();
 TileElement* map_get_nth_element_at(const CoordsXY& coords, int32_t n);
 void map_set_tile_element(const TileCoordsXY& tilePos, TileElement* elements);
 int32_t map_height_from_slope(const CoordsXY& coords, int32_t slopeDirection, bool isSloped);
@@ -254,6 +300,10 @@ int32_t tile_element_iterator_next(tile_element_iterator* it);
 void tile_element_iterator_restart_for_tile(tile_element_iterator* it);
 
 void map_update_tiles();
+/**
+ * Makes map_update_tiles visit the tile again, call it whenever a tile is changed in place.
+ */
+void map_update_tiles_mark_active(const CoordsXY& loc);
 int32_t map_get_highest_z(const CoordsXY& loc);
 
 bool tile_element_wants_path_connection_towards(const TileCoordsXYZD& coords, const TileElement* const elementToBeRemoved);
@@ -273,6 +323,18 @@ void map_invalidate_tile_full(const CoordsXY& tilePos);
 void map_invalidate_element(const CoordsXY& elementPos, TileElement* tileElement);
 void map_invalidate_region(const CoordsXY& mins, const CoordsXY& maxs);
 
+/**
+ * Starts or stops collecting the tiles that are invalidated, for views that cache what they draw for each tile such as
+ * the map window.
+ */
+void map_set_changed_tile_tracking(bool enabled);
+
+/**
+ * Moves the tiles invalidated since the last call into tiles. Returns false instead if every tile has to be assumed
+ * changed, which is the case after tracking starts, after the map is replaced or once too many tiles have changed.
+ */
+bool map_take_changed_tiles(std::vector<TileCoordsXY>& tiles);
+
 int32_t map_get_tile_side(const CoordsXY& mapPos);
 int32_t map_get_tile_quadrant(const CoordsXY& mapPos);
 int32_t map_get_corner_height(int32_t z, int32_t slope, int32_t direction);
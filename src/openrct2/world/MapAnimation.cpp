@@ -26,25 +26,29 @@
 #include "SmallScenery.h"
 #include "Sprite.h"
 
+#include <algorithm>
+#include <unordered_set>
+
 using map_animation_invalidate_event_handler = bool (*)(const CoordsXYZ& loc);
 
+// The animations in the order they were created, which is the order they are updated and saved in
 static std::vector<MapAnimation> _mapAnimations;
+// The keys of all animations in _mapAnimations, for checking whether an animation exists without a search
+static std::unordered_set<uint64_t> _mapAnimationKeys;
 
 constexpr size_t MAX_ANIMATED_OBJECTS = 2000;
 
 static bool InvalidateMapAnimation(const MapAnimation& obj);
 
+static uint64_t GetMapAnimationKey(int32_t type, const CoordsXYZ& location)
+{
+    return (static_cast<uint64_t>(type & 0xFF) << 48) | (static_cast<uint64_t>(location.x & 0xFFFF) << 32)
+        | (static_cast<uint64_t>(location.y & 0xFFFF) << 16) | static_cast<uint64_t>(location.z & 0xFFFF);
+}
+
 static bool DoesAnimationExist(int32_t type, const CoordsXYZ& location)
 {
-    for (const auto& a : _mapAnimations)
-    {
-        if (a.type == type && a.location == location)
-        {
-            // Animation already exists
-            return true;
-        }
-    }
-    return false;
+    return _mapAnimationKeys.find(GetMapAnimationKey(type, location)) != _mapAnimationKeys.end();
 }
 
 void map_animation_create(int32_t type, const CoordsXYZ& loc)
@@ -55,6 +59,7 @@ void map_animation_create(int32_t type, const CoordsXYZ& loc)
         {
             // Create new animation
             _mapAnimations.push_back({ static_cast<uint8_t>(type), loc });
+            _mapAnimationKeys.insert(GetMapAnimationKey(type, loc));
         }
         else
         {
@@ -69,19 +74,16 @@ void map_animation_create(int32_t type, const CoordsXYZ& loc)
  */
 void map_animation_invalidate_all()
 {
-    auto it = _mapAnimations.begin();
-    while (it != _mapAnimations.end())
-    {
-        if (InvalidateMapAnimation(*it))
-        {
-            // Map animation has finished, remove it
-            it = _mapAnimations.erase(it);
-        }
-        else
+    // Finished animations are removed in the same pass, keeping the order of the others
+    auto newEnd = std::remove_if(_mapAnimations.begin(), _mapAnimations.end(), [](const MapAnimation& a) {
+        if (InvalidateMapAnimation(a))
         {
-            it++;
+            _mapAnimationKeys.erase(GetMapAnimationKey(a.type, a.location));
+            return true;
         }
-    }
+        return false;
+    });
+    _mapAnimations.erase(newEnd, _mapAnimations.end());
 }
 
 /**
@@ -612,6 +614,7 @@ const std::vector<MapAnimation>& GetMapAnimations()
 static void ClearMapAnimations()
 {
     _mapAnimations.clear();
+    _mapAnimationKeys.clear();
 }
 
 void AutoCreateMapAnimations()
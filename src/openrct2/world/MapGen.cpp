@@ -14,6 +14,7 @@
 #include "../common.h"
 #include "../core/Guard.hpp"
 #include "../core/Imaging.h"
+#include "../core/JobPool.h"
 #include "../core/String.hpp"
 #include "../localisation/Localisation.h"
 #include "../localisation/StringIds.h"
@@ -30,6 +31,7 @@
 #include <cmath>
 #include <cstring>
 #include <iterator>
+#include <memory>
 #include <vector>
 
 #pragma region Height map struct
@@ -92,20 +94,21 @@ static void mapgen_set_height();
 static void mapgen_simplex(mapgen_settings* settings);
 
 static int32_t _heightSize;
-static uint8_t* _height;
+static std::vector<uint8_t> _height;
 
-static int32_t get_height(int32_t x, int32_t y)
-{
-    if (x >= 0 && y >= 0 && x < _heightSize && y < _heightSize)
-        return _height[x + y * _heightSize];
-    else
-        return 0;
-}
+static std::unique_ptr<JobPool> _mapGenJobs;
 
-static void set_height(int32_t x, int32_t y, int32_t height)
+// The noise and smoothing of the height map are split into blocks of this many rows, each row only depends on the
+// previous state of the height map so the result does not depend on the number of workers.
+static constexpr size_t HeightMapRowsPerJob = 8;
+
+static JobPool& GetMapGenJobPool()
 {
-    if (x >= 0 && y >= 0 && x < _heightSize && y < _heightSize)
-        _height[x + y * _heightSize] = height;
+    if (_mapGenJobs == nullptr)
+    {
+        _mapGenJobs = std::make_unique<JobPool>();
+    }
+    return *_mapGenJobs;
 }
 
 void mapgen_generate_blank(mapgen_settings* settings)
@@ -182,15 +185,15 @@ void mapgen_generate(mapgen_settings* settings)
 
     // Create the temporary height map and initialise
     _heightSize = mapSize * 2;
-    _height = new uint8_t[_heightSize * _heightSize];
-    std::fill_n(_height, _heightSize * _heightSize, 0x00);
+    _height.assign(_heightSize * _heightSize, 0x00);
 
     mapgen_simplex(settings);
     mapgen_smooth_height(2 + (util_rand() % 6));
 
     // Set the game map to the height map
     mapgen_set_height();
-    delete[] _height;
+    _height.clear();
+    _height.shrink_to_fit();
 
     // Set the tile slopes so that there are no cliffs
     while (map_smooth(1, 1, mapSize - 1, mapSize - 1))
@@ -408,36 +411,42 @@ static void mapgen_set_water_level(int32_t waterLevel)
 }
 
 /**
- * Smooths the height map.
+ * Smooths the height map, every inner cell becomes the average of itself and its eight neighbours. The sums are done
+ * per column first and then across each row, so the inner loops are plain additions the compiler can vectorise.
  */
 static void mapgen_smooth_height(int32_t iterations)
 {
-    int32_t i, x, y, xx, yy, avg;
-    int32_t arraySize = _heightSize * _heightSize * sizeof(uint8_t);
-    uint8_t* copyHeight = new uint8_t[arraySize];
+    const size_t heightSize = _heightSize;
+    if (heightSize < 3)
+        return;
 
-    for (i = 0; i < iterations; i++)
+    std::vector<uint8_t> copyHeight(_height.size());
+    for (int32_t i = 0; i < iterations; i++)
     {
-        std::memcpy(copyHeight, _height, arraySize);
-        for (y = 1; y < _heightSize - 1; y++)
-        {
-            for (x = 1; x < _heightSize - 1; x++)
+        copyHeight = _height;
+        const size_t numBlocks = (heightSize - 2 + HeightMapRowsPerJob - 1) / HeightMapRowsPerJob;
+        GetMapGenJobPool().ParallelFor(0, numBlocks, 1, [&](size_t block) {
+            std::vector<uint16_t> columnSums(heightSize);
+            const size_t yStart = 1 + block * HeightMapRowsPerJob;
+            const size_t yEnd = std::min(yStart + HeightMapRowsPerJob, heightSize - 1);
+            for (size_t y = yStart; y < yEnd; y++)
             {
-                avg = 0;
-                for (yy = -1; yy <= 1; yy++)
+                const uint8_t* above = copyHeight.data() + (y - 1) * heightSize;
+                const uint8_t* row = above + heightSize;
+                const uint8_t* below = row + heightSize;
+                for (size_t x = 0; x < heightSize; x++)
                 {
-                    for (xx = -1; xx <= 1; xx++)
-                    {
-                        avg += copyHeight[(y + yy) * _heightSize + (x + xx)];
-                    }
+                    columnSums[x] = above[x] + row[x] + below[x];
+                }
+
+                uint8_t* dst = _height.data() + y * heightSize;
+                for (size_t x = 1; x < heightSize - 1; x++)
+                {
+                    dst[x] = static_cast<uint8_t>((columnSums[x - 1] + columnSums[x] + columnSums[x + 1]) / 9);
                 }
-                avg /= 9;
-                set_height(x, y, avg);
             }
-        }
+        });
     }
-
-    delete[] copyHeight;
 }
 
 /**
@@ -455,10 +464,12 @@ static void mapgen_set_height()
             heightX = x * 2;
             heightY = y * 2;
 
-            uint8_t q00 = get_height(heightX + 0, heightY + 0);
-            uint8_t q01 = get_height(heightX + 0, heightY + 1);
-            uint8_t q10 = get_height(heightX + 1, heightY + 0);
-            uint8_t q11 = get_height(heightX + 1, heightY + 1);
+            const uint8_t* q0 = _height.data() + heightX + heightY * _heightSize;
+            const uint8_t* q1 = q0 + _heightSize;
+            uint8_t q00 = q0[0];
+            uint8_t q01 = q1[0];
+            uint8_t q10 = q0[1];
+            uint8_t q11 = q1[1];
 
             uint8_t baseHeight = (q00 + q01 + q10 + q11) / 4;
 
@@ -621,25 +632,32 @@ static float grad(int32_t hash, float x, float y)
 
 static void mapgen_simplex(mapgen_settings* settings)
 {
-    int32_t x, y;
-
     float freq = settings->simplex_base_freq * (1.0f / _heightSize);
     int32_t octaves = settings->simplex_octaves;
 
     int32_t low = settings->simplex_low;
     int32_t high = settings->simplex_high;
 
+    // The permutation table is only read from here on, so rows can be generated in any order
     noise_rand();
-    for (y = 0; y < _heightSize; y++)
-    {
-        for (x = 0; x < _heightSize; x++)
+    const size_t heightSize = _heightSize;
+    const size_t numBlocks = (heightSize + HeightMapRowsPerJob - 1) / HeightMapRowsPerJob;
+    GetMapGenJobPool().ParallelFor(0, numBlocks, 1, [&](size_t block) {
+        const size_t yEnd = std::min((block + 1) * HeightMapRowsPerJob, heightSize);
+        for (size_t y = block * HeightMapRowsPerJob; y < yEnd; y++)
         {
-            float noiseValue = std::clamp(fractal_noise(x, y, freq, octaves, 2.0f, 0.65f), -1.0f, 1.0f);
-            float normalisedNoiseValue = (noiseValue + 1.0f) / 2.0f;
+            uint8_t* row = _height.data() + y * heightSize;
+            for (size_t x = 0; x < heightSize; x++)
+            {
+                float noiseValue = std::clamp(
+                    fractal_noise(static_cast<int32_t>(x), static_cast<int32_t>(y), freq, octaves, 2.0f, 0.65f), -1.0f,
+                    1.0f);
+                float normalisedNoiseValue = (noiseValue + 1.0f) / 2.0f;
 
-            set_height(x, y, low + static_cast<int32_t>(normalisedNoiseValue * high));
+                row[x] = static_cast<uint8_t>(low + static_cast<int32_t>(normalisedNoiseValue * high));
+            }
         }
-    }
+    });
 }
 
 #pragma endregion
@@ -27,6 +27,8 @@
 #include "../management/NewsItem.h"
 #include "../management/Research.h"
 #include "../network/network.h"
+#include "../peep/GuestPathfinding.h"
+#include "../peep/GuestStatistics.h"
 #include "../peep/Peep.h"
 #include "../peep/Staff.h"
 #include "../ride/Ride.h"
@@ -105,6 +107,9 @@ void park_set_open(bool open)
  */
 void update_park_fences(const CoordsXY& coords)
 {
+    // Called whenever the ownership of the tile changes, which decides whether its grass grows
+    map_update_tiles_mark_active(coords);
+
     if (map_is_edge(coords))
         return;
 
@@ -262,6 +267,7 @@ void Park::Initialise()
     gStaffHandymanColour = COLOUR_BRIGHT_RED;
     gStaffMechanicColour = COLOUR_LIGHT_BLUE;
     gStaffSecurityColour = COLOUR_YELLOW;
+    gGuestPathfindingBudget = 0;
     gNumGuestsInPark = 0;
     gNumGuestsInParkLastWeek = 0;
     gNumGuestsHeadingForPark = 0;
@@ -381,22 +387,9 @@ int32_t Park::CalculateParkRating() const
         result -= 150 - (std::min<int16_t>(2000, gNumGuestsInPark) / 13);
 
         // Find the number of happy peeps and the number of peeps who can't find the park exit
-        uint32_t happyGuestCount = 0;
-        uint32_t lostGuestCount = 0;
-        for (auto peep : EntityList<Guest>())
-        {
-            if (!peep->OutsideOfPark)
-            {
-                if (peep->Happiness > 128)
-                {
-                    happyGuestCount++;
-                }
-                if ((peep->PeepFlags & PEEP_FLAGS_LEAVING_PARK) && (peep->GuestIsLostCountdown < 90))
-                {
-                    lostGuestCount++;
-                }
-            }
-        }
+        const auto& guestStats = GetGuestStatistics();
+        uint32_t happyGuestCount = guestStats.Happy;
+        uint32_t lostGuestCount = guestStats.LostWhileLeaving;
 
         // Peep happiness -500 to +0
         result -= 500;
@@ -690,16 +683,16 @@ void Park::GenerateGuests()
     for (const auto& campaign : gMarketingCampaigns)
     {
         // Random chance of guest generation
-        auto probability = marketing_get_campaign_guest_generation_probability(campaign.Type);
+        auto probability = marketing_get_campaign_guest_generation_probability(campaign);
         auto random = scenario_rand_max(std::numeric_limits<uint16_t>::max());
         if (random < probability)
         {
-            GenerateGuestFromCampaign(campaign.Type);
+            GenerateGuestFromCampaign(campaign);
         }
     }
 }
 
-Peep* Park::GenerateGuestFromCampaign(int32_t campaign)
+Peep* Park::GenerateGuestFromCampaign(const MarketingCampaign& campaign)
 {
     auto peep = GenerateGuest();
     if (peep != nullptr)
@@ -18,6 +18,7 @@
 
 #define MAX_ENTRANCE_FEE MONEY(200, 00)
 
+struct MarketingCampaign;
 struct Peep;
 
 enum : uint32_t
@@ -85,7 +86,7 @@ namespace OpenRCT2
         uint32_t CalculateGuestGenerationProbability() const;
 
         void GenerateGuests();
-        Peep* GenerateGuestFromCampaign(int32_t campaign);
+        Peep* GenerateGuestFromCampaign(const MarketingCampaign& campaign);
     };
 } // namespace OpenRCT2
 
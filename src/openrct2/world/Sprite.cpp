@@ -18,21 +18,53 @@
 #include "../interface/Viewport.h"
 #include "../localisation/Date.h"
 #include "../localisation/Localisation.h"
+#include "../peep/GuestStatistics.h"
+#include "../peep/Peep.h"
+#include "../ride/Ride.h"
 #include "../scenario/Scenario.h"
 #include "Fountain.h"
 
 #include <algorithm>
 #include <cmath>
 #include <iterator>
+#include <set>
+#include <utility>
 #include <vector>
 
-static rct_sprite _spriteList[MAX_ENTITIES];
-static std::array<std::list<uint16_t>, EnumValue(EntityType::Count)> gEntityLists;
-static std::vector<uint16_t> _freeIdList;
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#    include <xmmintrin.h>
+#endif
+
+// Aligned to a cache line so every entity spans exactly sizeof(rct_sprite) / 64 lines
+alignas(64) static rct_sprite _spriteList[MAX_ENTITIES];
+static std::array<EntityIndexSet, EnumValue(EntityType::Count)> gEntityLists;
+// The free slots, new entities always take the lowest one so the indices stay deterministic
+static EntityIndexSet _freeIds;
 
 static bool _spriteFlashingList[MAX_ENTITIES];
 
-static std::array<std::vector<uint16_t>, SPATIAL_INDEX_SIZE> gSpriteSpatialIndex;
+// The entities on each tile of the spatial index as intrusive lists in sprite_index order, linked through compact arrays
+// so moving an entity between tiles neither allocates nor touches the entities themselves. _spatialTile holds the tile
+// each entity is linked into, SPATIAL_INDEX_NONE when it is not in the index.
+static constexpr uint32_t SPATIAL_INDEX_NONE = SPATIAL_INDEX_SIZE;
+
+template<typename T, size_t TSize> static std::array<T, TSize> CreateFilledArray(T value)
+{
+    std::array<T, TSize> result;
+    result.fill(value);
+    return result;
+}
+
+static auto _spatialHeads = CreateFilledArray<uint16_t, SPATIAL_INDEX_SIZE>(SPRITE_INDEX_NULL);
+static auto _spatialTails = CreateFilledArray<uint16_t, SPATIAL_INDEX_SIZE>(SPRITE_INDEX_NULL);
+static std::array<uint16_t, MAX_ENTITIES> _spatialNext;
+static std::array<uint16_t, MAX_ENTITIES> _spatialPrev;
+static auto _spatialTile = CreateFilledArray<uint32_t, MAX_ENTITIES>(SPATIAL_INDEX_NONE);
+
+// All litter ordered by creation tick and then sprite index, so the litter to replace when there is too much can be found
+// without a scan. Rebuilt from the litter list after the entities have been replaced.
+static std::set<std::pair<uint32_t, uint16_t>> _litterByCreationTick;
+static bool _litterByCreationTickValid = false;
 
 const rct_string_id litterNames[12] = { STR_LITTER_VOMIT,
                                         STR_LITTER_VOMIT,
@@ -60,7 +92,7 @@ constexpr size_t GetSpatialIndexOffset(int32_t x, int32_t y)
         index = (flooredX << 3) | tileY;
     }
 
-    if (index >= sizeof(gSpriteSpatialIndex))
+    if (index >= SPATIAL_INDEX_SIZE)
     {
         return SPATIAL_INDEX_LOCATION_NULL;
     }
@@ -114,12 +146,12 @@ template<> bool SpriteBase::Is<ExplosionCloud>() const
 
 uint16_t GetEntityListCount(EntityType type)
 {
-    return static_cast<uint16_t>(gEntityLists[EnumValue(type)].size());
+    return gEntityLists[EnumValue(type)].Count();
 }
 
 uint16_t GetNumFreeEntities()
 {
-    return static_cast<uint16_t>(_freeIdList.size());
+    return _freeIds.Count();
 }
 
 std::string rct_sprite_checksum::ToString() const
@@ -152,9 +184,30 @@ SpriteBase* get_sprite(size_t spriteIndex)
     return try_get_sprite(spriteIndex);
 }
 
-const std::vector<uint16_t>& GetEntityTileList(const CoordsXY& spritePos)
+void PrefetchEntity(size_t spriteIndex)
 {
-    return gSpriteSpatialIndex[GetSpatialIndexOffset(spritePos.x, spritePos.y)];
+    if (spriteIndex >= MAX_ENTITIES)
+        return;
+
+    // The common entity fields and most of the fields read by the update functions are in the first two lines
+    [[maybe_unused]] const auto* entity = reinterpret_cast<const char*>(&_spriteList[spriteIndex]);
+#if defined(__GNUC__)
+    __builtin_prefetch(entity);
+    __builtin_prefetch(entity + 64);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    _mm_prefetch(entity, _MM_HINT_T0);
+    _mm_prefetch(entity + 64, _MM_HINT_T0);
+#endif
+}
+
+uint16_t GetEntityTileListFirst(const CoordsXY& spritePos)
+{
+    return _spatialHeads[GetSpatialIndexOffset(spritePos.x, spritePos.y)];
+}
+
+uint16_t GetEntityTileListNext(uint16_t spriteIndex)
+{
+    return _spatialNext[spriteIndex];
 }
 
 void SpriteBase::Invalidate()
@@ -228,27 +281,30 @@ void RebuildEntityLists()
 {
     for (auto& list : gEntityLists)
     {
-        list.clear();
+        list.Clear();
     }
 
-    _freeIdList.clear();
+    _freeIds.Clear();
 
     for (auto& ent : _spriteList)
     {
         if (ent.misc.Type == EntityType::Null)
         {
-            _freeIdList.push_back(ent.misc.sprite_index);
+            _freeIds.Insert(ent.misc.sprite_index);
         }
         else
         {
-            gEntityLists[EnumValue(ent.misc.Type)].push_back(ent.misc.sprite_index);
+            gEntityLists[EnumValue(ent.misc.Type)].Insert(ent.misc.sprite_index);
         }
     }
-    // List needs to be back to front to simplify removing
-    std::sort(std::begin(_freeIdList), std::end(_freeIdList), std::greater<uint16_t>());
+    // The entities may have been replaced as a whole
+    ride_favourite_counts_invalidate();
+    GuestStatisticsInvalidate();
+    peep_name_cache_invalidate();
+    _litterByCreationTickValid = false;
 }
 
-const std::list<uint16_t>& GetEntityList(const EntityType id)
+const EntityIndexSet& GetEntityList(const EntityType id)
 {
     return gEntityLists[EnumValue(id)];
 }
@@ -288,10 +344,10 @@ static void SpriteSpatialInsert(SpriteBase* sprite, const CoordsXY& newLoc);
  */
 void reset_sprite_spatial_index()
 {
-    for (auto& vec : gSpriteSpatialIndex)
-    {
-        vec.clear();
-    }
+    _spatialHeads.fill(SPRITE_INDEX_NULL);
+    _spatialTails.fill(SPRITE_INDEX_NULL);
+    _spatialTile.fill(SPATIAL_INDEX_NONE);
+    // Entities are inserted in sprite_index order, so each one is appended to the end of its tile
     for (size_t i = 0; i < MAX_ENTITIES; i++)
     {
         auto* spr = GetEntity(i);
@@ -304,7 +360,7 @@ void reset_sprite_spatial_index()
 
 #ifndef DISABLE_NETWORK
 
-rct_sprite_checksum sprite_checksum()
+static rct_sprite_checksum sprite_checksum(size_t begin, size_t end)
 {
     using namespace Crypt;
 
@@ -322,7 +378,7 @@ rct_sprite_checksum sprite_checksum()
         }
 
         _spriteHashAlg->Clear();
-        for (size_t i = 0; i < MAX_ENTITIES; i++)
+        for (size_t i = begin; i < end; i++)
         {
             // TODO create a way to copy only the specific type
             auto sprite = GetEntity(i);
@@ -344,6 +400,9 @@ rct_sprite_checksum sprite_checksum()
                     // invalidation flags causing the sprite checksum to be different than on server, the flag does not
                     // affect game state.
                     copy.peep.WindowInvalidateFlags = 0;
+
+                    // Not saved, a client rebuilds it from the queues when it loads the map
+                    copy.peep.GuestPreviousInQueue = 0;
                 }
 
                 _spriteHashAlg->Update(&copy, sizeof(copy));
@@ -360,6 +419,21 @@ rct_sprite_checksum sprite_checksum()
 
     return checksum;
 }
+
+rct_sprite_checksum sprite_checksum()
+{
+    return sprite_checksum(0, MAX_ENTITIES);
+}
+
+/**
+ * Checksum of one of SPRITE_CHECKSUM_PARTS equal slices of the entity list, cheap enough to be taken every tick.
+ */
+rct_sprite_checksum sprite_checksum_part(uint32_t part)
+{
+    constexpr size_t partSize = (MAX_ENTITIES + SPRITE_CHECKSUM_PARTS - 1) / SPRITE_CHECKSUM_PARTS;
+    const size_t begin = std::min<size_t>(static_cast<size_t>(part % SPRITE_CHECKSUM_PARTS) * partSize, MAX_ENTITIES);
+    return sprite_checksum(begin, std::min<size_t>(begin + partSize, MAX_ENTITIES));
+}
 #else
 
 rct_sprite_checksum sprite_checksum()
@@ -367,6 +441,11 @@ rct_sprite_checksum sprite_checksum()
     return rct_sprite_checksum{};
 }
 
+rct_sprite_checksum sprite_checksum_part([[maybe_unused]] uint32_t part)
+{
+    return rct_sprite_checksum{};
+}
+
 #endif // DISABLE_NETWORK
 
 static void sprite_reset(SpriteBase* sprite)
@@ -387,7 +466,7 @@ static void sprite_reset(SpriteBase* sprite)
  */
 void sprite_clear_all_unused()
 {
-    for (auto index : _freeIdList)
+    for (auto index = _freeIds.FindFrom(0); index != SPRITE_INDEX_NULL; index = _freeIds.FindFrom(index + 1))
     {
         auto* entity = GetEntity(index);
         if (entity == nullptr)
@@ -403,25 +482,13 @@ void sprite_clear_all_unused()
 static constexpr uint16_t MAX_MISC_SPRITES = 300;
 static void AddToEntityList(SpriteBase* entity)
 {
-    auto& list = gEntityLists[EnumValue(entity->Type)];
-    // Entity list must be in sprite_index order to prevent desync issues
-    list.insert(std::lower_bound(std::begin(list), std::end(list), entity->sprite_index), entity->sprite_index);
-}
-
-static void AddToFreeList(uint16_t index)
-{
-    // Free list must be in reverse sprite_index order to prevent desync issues
-    _freeIdList.insert(std::upper_bound(std::rbegin(_freeIdList), std::rend(_freeIdList), index).base(), index);
+    // Entity lists are always iterated in sprite_index order to prevent desync issues
+    gEntityLists[EnumValue(entity->Type)].Insert(entity->sprite_index);
 }
 
 static void RemoveFromEntityList(SpriteBase* entity)
 {
-    auto& list = gEntityLists[EnumValue(entity->Type)];
-    auto ptr = std::lower_bound(std::begin(list), std::end(list), entity->sprite_index);
-    if (ptr != std::end(list) && *ptr == entity->sprite_index)
-    {
-        list.erase(ptr);
-    }
+    gEntityLists[EnumValue(entity->Type)].Remove(entity->sprite_index);
 }
 
 uint16_t GetMiscEntityCount()
@@ -438,7 +505,7 @@ uint16_t GetMiscEntityCount()
 
 rct_sprite* create_sprite(EntityType type)
 {
-    if (_freeIdList.size() == 0)
+    if (_freeIds.Count() == 0)
     {
         // No free sprites.
         return nullptr;
@@ -451,18 +518,19 @@ rct_sprite* create_sprite(EntityType type)
         // free it will fail to keep slots for more relevant sprites.
         // Also there can't be more than MAX_MISC_SPRITES sprites in this list.
         uint16_t miscSlotsRemaining = MAX_MISC_SPRITES - GetMiscEntityCount();
-        if (miscSlotsRemaining >= _freeIdList.size())
+        if (miscSlotsRemaining >= _freeIds.Count())
         {
             return nullptr;
         }
     }
 
-    auto* sprite = GetEntity(_freeIdList.back());
+    // Take the lowest free slot to prevent desync issues
+    auto* sprite = GetEntity(_freeIds.FindFrom(0));
     if (sprite == nullptr)
     {
         return nullptr;
     }
-    _freeIdList.pop_back();
+    _freeIds.Remove(sprite->sprite_index);
 
     // Need to reset all sprite data, as the uninitialised values
     // may contain garbage and cause a desync later on.
@@ -597,33 +665,66 @@ void sprite_misc_update_all()
 // Performs a search to ensure that insert keeps next_in_quadrant in sprite_index order
 static void SpriteSpatialInsert(SpriteBase* sprite, const CoordsXY& newLoc)
 {
-    size_t newIndex = GetSpatialIndexOffset(newLoc.x, newLoc.y);
-    auto& spatialVector = gSpriteSpatialIndex[newIndex];
-    auto index = std::lower_bound(std::begin(spatialVector), std::end(spatialVector), sprite->sprite_index);
-    spatialVector.insert(index, sprite->sprite_index);
+    const auto spriteIndex = sprite->sprite_index;
+    const auto newIndex = static_cast<uint32_t>(GetSpatialIndexOffset(newLoc.x, newLoc.y));
+    if (_spatialTile[spriteIndex] != SPATIAL_INDEX_NONE)
+    {
+        log_warning("Sprite %u is already in the spatial index.", spriteIndex);
+        return;
+    }
+
+    // Entities mostly join a tile with a higher index than the ones on it, only walk the tile when they do not
+    uint16_t next = SPRITE_INDEX_NULL;
+    if (_spatialTails[newIndex] != SPRITE_INDEX_NULL && _spatialTails[newIndex] > spriteIndex)
+    {
+        next = _spatialHeads[newIndex];
+        while (next < spriteIndex)
+        {
+            next = _spatialNext[next];
+        }
+    }
+
+    const uint16_t prev = next == SPRITE_INDEX_NULL ? _spatialTails[newIndex] : _spatialPrev[next];
+    _spatialNext[spriteIndex] = next;
+    _spatialPrev[spriteIndex] = prev;
+    if (prev == SPRITE_INDEX_NULL)
+        _spatialHeads[newIndex] = spriteIndex;
+    else
+        _spatialNext[prev] = spriteIndex;
+    if (next == SPRITE_INDEX_NULL)
+        _spatialTails[newIndex] = spriteIndex;
+    else
+        _spatialPrev[next] = spriteIndex;
+    _spatialTile[spriteIndex] = newIndex;
 }
 
 static void SpriteSpatialRemove(SpriteBase* sprite)
 {
-    size_t currentIndex = GetSpatialIndexOffset(sprite->x, sprite->y);
-    auto& spatialVector = gSpriteSpatialIndex[currentIndex];
-    auto index = std::lower_bound(std::begin(spatialVector), std::end(spatialVector), sprite->sprite_index);
-    if (index != std::end(spatialVector) && *index == sprite->sprite_index)
+    const auto spriteIndex = sprite->sprite_index;
+    const auto currentIndex = _spatialTile[spriteIndex];
+    if (currentIndex == SPATIAL_INDEX_NONE)
     {
-        spatialVector.erase(index, index + 1);
+        log_warning("Sprite %u is not in the spatial index.", spriteIndex);
+        return;
     }
+
+    const auto prev = _spatialPrev[spriteIndex];
+    const auto next = _spatialNext[spriteIndex];
+    if (prev == SPRITE_INDEX_NULL)
+        _spatialHeads[currentIndex] = next;
     else
-    {
-        log_warning("Bad sprite spatial index. Rebuilding the spatial index...");
-        reset_sprite_spatial_index();
-    }
+        _spatialNext[prev] = next;
+    if (next == SPRITE_INDEX_NULL)
+        _spatialTails[currentIndex] = prev;
+    else
+        _spatialPrev[next] = prev;
+    _spatialTile[spriteIndex] = SPATIAL_INDEX_NONE;
 }
 
 static void SpriteSpatialMove(SpriteBase* sprite, const CoordsXY& newLoc)
 {
-    size_t newIndex = GetSpatialIndexOffset(newLoc.x, newLoc.y);
-    size_t currentIndex = GetSpatialIndexOffset(sprite->x, sprite->y);
-    if (newIndex == currentIndex)
+    const auto newIndex = static_cast<uint32_t>(GetSpatialIndexOffset(newLoc.x, newLoc.y));
+    if (newIndex == _spatialTile[sprite->sprite_index])
         return;
 
     SpriteSpatialRemove(sprite);
@@ -696,10 +797,20 @@ void sprite_remove(SpriteBase* sprite)
     {
         peep->SetName({});
     }
+    auto guest = sprite->As<Guest>();
+    if (guest != nullptr)
+    {
+        ride_guest_favourite_changed(guest->FavouriteRide, RIDE_ID_NULL);
+    }
+    auto litter = sprite->As<Litter>();
+    if (litter != nullptr && _litterByCreationTickValid)
+    {
+        _litterByCreationTick.erase({ litter->creationTick, litter->sprite_index });
+    }
 
     EntityTweener::Get().RemoveEntity(sprite);
     RemoveFromEntityList(sprite); // remove from existing list
-    AddToFreeList(sprite->sprite_index);
+    _freeIds.Insert(sprite->sprite_index);
 
     SpriteSpatialRemove(sprite);
     sprite_reset(sprite);
@@ -747,15 +858,21 @@ void litter_create(const CoordsXYZD& litterPos, LitterType type)
 
     if (GetEntityListCount(EntityType::Litter) >= 500)
     {
-        Litter* newestLitter = nullptr;
-        uint32_t newestLitterCreationTick = 0;
-        for (auto litter : EntityList<Litter>())
+        if (!_litterByCreationTickValid)
         {
-            if (newestLitterCreationTick <= litter->creationTick)
+            _litterByCreationTick.clear();
+            for (auto litter : EntityList<Litter>())
             {
-                newestLitterCreationTick = litter->creationTick;
-                newestLitter = litter;
+                _litterByCreationTick.emplace(litter->creationTick, litter->sprite_index);
             }
+            _litterByCreationTickValid = true;
+        }
+
+        // The newest litter is replaced, of those created on the same tick the one with the highest sprite index
+        Litter* newestLitter = nullptr;
+        if (!_litterByCreationTick.empty())
+        {
+            newestLitter = GetEntity<Litter>(_litterByCreationTick.rbegin()->second);
         }
 
         if (newestLitter != nullptr)
@@ -776,6 +893,10 @@ void litter_create(const CoordsXYZD& litterPos, LitterType type)
     litter->SubType = type;
     litter->MoveTo(offsetLitterPos);
     litter->creationTick = gScenarioTicks;
+    if (_litterByCreationTickValid)
+    {
+        _litterByCreationTick.emplace(litter->creationTick, litter->sprite_index);
+    }
 }
 
 /**
@@ -830,25 +951,27 @@ uint16_t remove_floating_sprites()
     return removed;
 }
 
-void EntityTweener::PopulateEntities()
+template<typename T> void EntityTweener::AddEntities()
 {
-    for (auto ent : EntityList<Guest>())
-    {
-        Entities.push_back(ent);
-        PrePos.emplace_back(ent->x, ent->y, ent->z);
-    }
-    for (auto ent : EntityList<Staff>())
-    {
-        Entities.push_back(ent);
-        PrePos.emplace_back(ent->x, ent->y, ent->z);
-    }
-    for (auto ent : EntityList<Vehicle>())
+    for (auto ent : EntityList<T>())
     {
+        Slots[ent->sprite_index] = static_cast<int32_t>(Entities.size());
         Entities.push_back(ent);
         PrePos.emplace_back(ent->x, ent->y, ent->z);
     }
 }
 
+void EntityTweener::PopulateEntities()
+{
+    AddEntities<Guest>();
+    AddEntities<Staff>();
+    AddEntities<Vehicle>();
+    // The misc entities that move a little every tick, the others stand still or are animated in place
+    AddEntities<Balloon>();
+    AddEntities<Duck>();
+    AddEntities<VehicleCrashParticle>();
+}
+
 void EntityTweener::PreTick()
 {
     Restore();
@@ -874,15 +997,13 @@ void EntityTweener::PostTick()
 
 void EntityTweener::RemoveEntity(SpriteBase* entity)
 {
-    if (!entity->Is<Peep>() && !entity->Is<Vehicle>())
+    // Only the entities added by PopulateEntities are tweened
+    auto& slot = Slots[entity->sprite_index];
+    if (slot != -1)
     {
-        // Only peeps and vehicles are tweened, bail if type is incorrect.
-        return;
+        Entities[slot] = nullptr;
+        slot = -1;
     }
-
-    auto it = std::find(Entities.begin(), Entities.end(), entity);
-    if (it != Entities.end())
-        *it = nullptr;
 }
 
 void EntityTweener::Tween(float alpha)
@@ -900,6 +1021,8 @@ void EntityTweener::Tween(float alpha)
         if (posA == posB)
             continue;
 
+        // The entity was drawn at the position of the previous frame, which has to be redrawn without it
+        ent->Invalidate();
         sprite_set_coordinates(
             { static_cast<int32_t>(std::round(posB.x * alpha + posA.x * inv)),
               static_cast<int32_t>(std::round(posB.y * alpha + posA.y * inv)),
@@ -917,6 +1040,7 @@ void EntityTweener::Restore()
         if (ent == nullptr)
             continue;
 
+        ent->Invalidate();
         sprite_set_coordinates(PostPos[i], ent);
         ent->Invalidate();
     }
@@ -924,6 +1048,11 @@ void EntityTweener::Restore()
 
 void EntityTweener::Reset()
 {
+    for (auto* ent : Entities)
+    {
+        if (ent != nullptr)
+            Slots[ent->sprite_index] = -1;
+    }
     Entities.clear();
     PrePos.clear();
     PostPos.clear();
@@ -248,7 +248,12 @@ void duck_remove_all();
 void crashed_vehicle_particle_create(rct_vehicle_colour colours, const CoordsXYZ& vehiclePos);
 void crash_splash_create(const CoordsXYZ& splashPos);
 
+// Number of parts sprite_checksum_part splits the entities into, checking one part per tick covers all of them in
+// as many ticks.
+constexpr uint32_t SPRITE_CHECKSUM_PARTS = 128;
+
 rct_sprite_checksum sprite_checksum();
+rct_sprite_checksum sprite_checksum_part(uint32_t part);
 
 void sprite_set_flashing(SpriteBase* sprite, bool flashing);
 bool sprite_get_flashing(SpriteBase* sprite);
@@ -258,8 +263,11 @@ class EntityTweener
     std::vector<SpriteBase*> Entities;
     std::vector<CoordsXYZ> PrePos;
     std::vector<CoordsXYZ> PostPos;
+    // The index in Entities of each tweened entity by sprite index, so removing one does not search the list
+    std::vector<int32_t> Slots = std::vector<int32_t>(MAX_ENTITIES, -1);
 
 private:
+    template<typename T> void AddEntities();
     void PopulateEntities();
 
 public:
@@ -111,14 +111,16 @@ namespace OpenRCT2
 
         Iterator begin() noexcept
         {
-            T* element = reinterpret_cast<T*>(map_get_first_element_at(_loc));
-
             if constexpr (!std::is_same_v<T, TileElement>)
             {
-                element = Detail::NextMatchingTile<T>(element);
+                // Tiles without an element of this type are skipped without walking their elements
+                auto* element = map_get_first_element_of_type_at(_loc, T::ElementType);
+                return Iterator{ Detail::NextMatchingTile<T>(element) };
+            }
+            else
+            {
+                return Iterator{ map_get_first_element_at(_loc) };
             }
-
-            return Iterator{ element };
         }
 
         Iterator end() noexcept
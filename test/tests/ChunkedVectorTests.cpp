@@ -0,0 +1,95 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+#include <gtest/gtest.h>
+#include <openrct2/core/ChunkedVector.h>
+#include <stdint.h>
+#include <vector>
+
+// Small chunks so the tests cross many chunk boundaries.
+constexpr size_t TEST_CHUNK_SIZE = 16;
+constexpr size_t TEST_PUSH_COUNT = 1000;
+
+TEST(ChunkedVectorTest, grows_in_chunks)
+{
+    ChunkedVector<size_t, TEST_CHUNK_SIZE> vector;
+    ASSERT_TRUE(vector.empty());
+    ASSERT_EQ(vector.capacity(), 0U);
+
+    std::vector<size_t*> addresses;
+    for (size_t i = 0; i < TEST_PUSH_COUNT; i++)
+    {
+        addresses.push_back(&vector.emplace_back(i));
+        ASSERT_EQ(vector.size(), i + 1);
+        ASSERT_EQ(vector.capacity() % TEST_CHUNK_SIZE, 0U);
+        ASSERT_GE(vector.capacity(), vector.size());
+        ASSERT_LT(vector.capacity() - vector.size(), TEST_CHUNK_SIZE);
+    }
+
+    // Elements never move
+    size_t expected = 0;
+    for (auto& value : vector)
+    {
+        ASSERT_EQ(value, expected);
+        ASSERT_EQ(&value, addresses[expected]);
+        ASSERT_EQ(vector.index_of(&value), expected);
+        expected++;
+    }
+    ASSERT_EQ(expected, TEST_PUSH_COUNT);
+
+    size_t unrelated = 0;
+    ASSERT_EQ(vector.index_of(&unrelated), vector.size());
+}
+
+TEST(ChunkedVectorTest, clear_keeps_chunks)
+{
+    ChunkedVector<size_t, TEST_CHUNK_SIZE> vector;
+    for (size_t i = 0; i < TEST_PUSH_COUNT; i++)
+    {
+        vector.emplace_back(i);
+    }
+    auto* first = &vector[0];
+    auto capacity = vector.capacity();
+
+    vector.clear();
+    ASSERT_TRUE(vector.empty());
+    ASSERT_EQ(vector.capacity(), capacity);
+    ASSERT_EQ(vector.peak_size(), TEST_PUSH_COUNT);
+    ASSERT_EQ(&vector.emplace_back(size_t{ 7 }), first);
+
+    vector.shrink_to_fit();
+    ASSERT_EQ(vector.capacity(), TEST_CHUNK_SIZE);
+    ASSERT_EQ(vector[0], 7U);
+    ASSERT_EQ(vector.peak_size(), TEST_PUSH_COUNT);
+}
+
+TEST(ChunkedVectorTest, copy)
+{
+    ChunkedVector<size_t, TEST_CHUNK_SIZE> vector;
+    for (size_t i = 0; i < TEST_PUSH_COUNT; i++)
+    {
+        vector.emplace_back(i);
+    }
+
+    auto copy = vector;
+    ASSERT_EQ(copy.size(), vector.size());
+    for (size_t i = 0; i < copy.size(); i++)
+    {
+        ASSERT_EQ(copy[i], vector[i]);
+        ASSERT_NE(&copy[i], &vector[i]);
+    }
+
+    // Assigning into an existing vector reuses its chunks
+    auto* first = &copy[0];
+    vector.clear();
+    vector.emplace_back(size_t{ 42 });
+    copy = vector;
+    ASSERT_EQ(copy.size(), 1U);
+    ASSERT_EQ(copy[0], 42U);
+    ASSERT_EQ(&copy[0], first);
+}
@@ -57,6 +57,29 @@ TEST_F(FmtStringTests, iteration_escaped)
     ASSERT_EQ("[1:This is an ][2:{{][1:ESCAPED][2:}}][1: string.]", actual);
 }
 
+TEST_F(FmtStringTests, iteration_compiled)
+{
+    std::string_view str = "{MOVE_X}{12}Escaped {{ and\n{INLINE_SPRITE}{1}{2}{3}{4}{INT32} {BLACK}";
+    auto tokens = FmtString::Compile(str);
+
+    std::string expected;
+    for (const auto& t : FmtString(str))
+    {
+        expected += String::StdFormat("[%d:%s:%u]", t.kind, std::string(t.text).c_str(), t.parameter);
+    }
+
+    std::string actual;
+    auto fmt = FmtString(str, tokens);
+    for (const auto& t : fmt)
+    {
+        actual += String::StdFormat("[%d:%s:%u]", t.kind, std::string(t.text).c_str(), t.parameter);
+    }
+
+    ASSERT_EQ(tokens.size(), 9U);
+    ASSERT_EQ(expected, actual);
+    ASSERT_EQ(FmtString(str).WithoutFormatTokens(), fmt.WithoutFormatTokens());
+}
+
 TEST_F(FmtStringTests, without_format_tokens)
 {
     auto fmt = FmtString("{BLACK}Guests: {INT32}");
@@ -615,3 +638,23 @@ TEST_F(FormattingTests, buffer_storage_swap)
     ss << ", extended";
     ASSERT_STREQ(ss.data(), "Hello World, Exceeding local storage, extended");
 }
+
+TEST_F(FormattingTests, compiled_string)
+{
+    auto ft = Formatter();
+    ft.Add<rct_string_id>(STR_RIDE_NAME_DEFAULT);
+    ft.Add<rct_string_id>(STR_RIDE_NAME_BOAT_HIRE);
+    ft.Add<uint16_t>(2);
+    const std::vector<FormatArg_t> args = { STR_RIDE_NAME_DEFAULT, STR_RIDE_NAME_BOAT_HIRE, 2 };
+
+    // Language strings come pre-tokenised, they must format the same as the text parsed on the spot
+    auto compiledResult = FormatStringAny(GetFmtStringById(STR_QUEUING_FOR), args);
+    auto parsedResult = FormatStringAny(FmtString(language_get_string(STR_QUEUING_FOR)), args);
+
+    char legacyResult[64]{};
+    FormatStringLegacy(legacyResult, sizeof(legacyResult), STR_QUEUING_FOR, ft.Data());
+
+    ASSERT_EQ("Queuing for Boat Hire 2", compiledResult);
+    ASSERT_EQ(parsedResult, compiledResult);
+    ASSERT_STREQ(compiledResult.c_str(), legacyResult);
+}
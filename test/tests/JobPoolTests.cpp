@@ -0,0 +1,64 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <atomic>
+#include <gtest/gtest.h>
+#include <numeric>
+#include <openrct2/core/JobPool.h>
+#include <vector>
+
+TEST(JobPoolTest, tasks_and_completions)
+{
+    JobPool jobPool;
+    std::atomic<size_t> work = 0;
+    size_t completions = 0;
+    for (size_t i = 0; i < 1000; i++)
+    {
+        jobPool.AddTask([&work]() { work++; }, [&completions]() { completions++; });
+    }
+    jobPool.Join();
+    ASSERT_EQ(work, 1000U);
+    ASSERT_EQ(completions, 1000U);
+    ASSERT_EQ(jobPool.CountPending(), 0U);
+}
+
+TEST(JobPoolTest, parallel_for_visits_every_index_once)
+{
+    JobPool jobPool;
+    for (size_t grain : { 1, 7, 64, 5000 })
+    {
+        std::vector<uint32_t> visits(4096);
+        jobPool.ParallelFor(0, visits.size(), grain, [&visits](size_t index) { visits[index]++; });
+        for (auto count : visits)
+        {
+            ASSERT_EQ(count, 1U);
+        }
+    }
+}
+
+TEST(JobPoolTest, parallel_for_empty_range)
+{
+    JobPool jobPool;
+    size_t calls = 0;
+    jobPool.ParallelFor(10, 10, 1, [&calls](size_t) { calls++; });
+    ASSERT_EQ(calls, 0U);
+}
+
+TEST(JobPoolTest, nested_parallel_for)
+{
+    JobPool jobPool;
+    std::vector<std::atomic<size_t>> sums(64);
+    jobPool.ParallelFor(0, sums.size(), 1, [&](size_t outer) {
+        jobPool.ParallelFor(0, 100, 10, [&](size_t inner) { sums[outer] += inner; });
+    });
+    for (const auto& sum : sums)
+    {
+        ASSERT_EQ(sum, 4950U);
+    }
+}
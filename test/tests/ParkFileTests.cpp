@@ -0,0 +1,110 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <openrct2/ParkFile.h>
+#include <openrct2/core/JobPool.h>
+#include <openrct2/core/MemoryStream.h>
+#include <vector>
+
+using namespace OpenRCT2;
+
+static std::vector<uint8_t> CreateChunkData(size_t length, bool compressible)
+{
+    std::vector<uint8_t> data(length);
+    uint32_t state = 12345;
+    for (size_t i = 0; i < length; i++)
+    {
+        state = state * 1103515245 + 12345;
+        data[i] = compressible ? static_cast<uint8_t>(i / 64) : static_cast<uint8_t>(state >> 16);
+    }
+    return data;
+}
+
+class ParkFileTest : public testing::Test
+{
+protected:
+    JobPool _jobPool;
+    std::vector<uint8_t> _tiny = CreateChunkData(8, true);
+    std::vector<uint8_t> _compressible = CreateChunkData(256 * 1024, true);
+    std::vector<uint8_t> _random = CreateChunkData(4096, false);
+
+    MemoryStream Write()
+    {
+        ParkFileWriter writer;
+        writer.AddChunk(ParkFileChunkType::Header, _tiny.data(), _tiny.size());
+        writer.AddChunk(ParkFileChunkType::TileElements, _compressible.data(), _compressible.size());
+        writer.AddChunk(ParkFileChunkType::ParkState, _random.data(), _random.size());
+
+        MemoryStream ms;
+        writer.Save(&ms, _jobPool);
+        ms.SetPosition(0);
+        return ms;
+    }
+};
+
+TEST_F(ParkFileTest, round_trip)
+{
+    auto ms = Write();
+    ASSERT_TRUE(ParkFileReader::IsParkFile(&ms));
+    ASSERT_EQ(ms.GetPosition(), 0U);
+    ASSERT_LT(ms.GetLength(), _compressible.size());
+
+    ParkFileReader reader(&ms);
+    ASSERT_EQ(reader.ReadChunk(ParkFileChunkType::Header), _tiny);
+    ASSERT_EQ(reader.ReadChunk(ParkFileChunkType::ParkState), _random);
+    ASSERT_EQ(reader.ReadChunk(ParkFileChunkType::TileElements), _compressible);
+    ASSERT_FALSE(reader.HasChunk(ParkFileChunkType::Info));
+    ASSERT_TRUE(reader.ReadChunk(ParkFileChunkType::Info).empty());
+}
+
+TEST_F(ParkFileTest, read_chunks_pads_and_truncates)
+{
+    auto ms = Write();
+    ParkFileReader reader(&ms);
+
+    std::vector<uint8_t> header(_tiny.size() + 16, 0xCC);
+    std::vector<uint8_t> tileElements(1000);
+    std::vector<uint8_t> info(32, 0xCC);
+    reader.ReadChunks(
+        _jobPool,
+        {
+            { ParkFileChunkType::Header, header.data(), header.size() },
+            { ParkFileChunkType::TileElements, tileElements.data(), tileElements.size() },
+            { ParkFileChunkType::Info, info.data(), info.size() },
+        });
+
+    ASSERT_TRUE(std::equal(_tiny.begin(), _tiny.end(), header.begin()));
+    ASSERT_TRUE(std::all_of(header.begin() + _tiny.size(), header.end(), [](uint8_t b) { return b == 0; }));
+    ASSERT_TRUE(std::equal(tileElements.begin(), tileElements.end(), _compressible.begin()));
+    ASSERT_TRUE(std::all_of(info.begin(), info.end(), [](uint8_t b) { return b == 0; }));
+}
+
+TEST_F(ParkFileTest, rejects_invalid_files)
+{
+    std::vector<uint8_t> notAPark(64, 0x55);
+    MemoryStream notAParkStream(notAPark.data(), notAPark.size());
+    ASSERT_FALSE(ParkFileReader::IsParkFile(&notAParkStream));
+    ASSERT_THROW(ParkFileReader reader(&notAParkStream), IOException);
+
+    // Truncate the file in the middle of the compressed tile elements
+    auto ms = Write();
+    auto data = static_cast<const uint8_t*>(ms.GetData());
+    std::vector<uint8_t> truncated(data, data + ms.GetLength() / 2);
+    MemoryStream truncatedStream(truncated.data(), truncated.size());
+    ASSERT_THROW(ParkFileReader reader(&truncatedStream), IOException);
+
+    // Corrupt the compressed tile elements
+    std::vector<uint8_t> corrupt(data, data + ms.GetLength());
+    corrupt[corrupt.size() - _random.size() - 10] ^= 0xFF;
+    MemoryStream corruptStream(corrupt.data(), corrupt.size());
+    ParkFileReader reader(&corruptStream);
+    ASSERT_THROW(reader.ReadChunk(ParkFileChunkType::TileElements), IOException);
+}
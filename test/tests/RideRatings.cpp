@@ -20,7 +20,9 @@
 #include <openrct2/platform/platform.h>
 #include <openrct2/ride/Ride.h>
 #include <openrct2/ride/RideData.h>
+#include <openrct2/ride/RideRatings.h>
 #include <string>
+#include <vector>
 
 using namespace OpenRCT2;
 
@@ -35,6 +37,34 @@ protected:
         }
     }
 
+    void CalculateRatingsForAllRidesInParallel()
+    {
+        std::vector<ride_id_t> rides;
+        for (const auto& ride : GetRideManager())
+        {
+            rides.push_back(ride.id);
+        }
+        ride_ratings_update_rides(rides, true);
+    }
+
+    void CheckRatings()
+    {
+        // Load expected ratings
+        auto expectedDataPath = Path::Combine(TestData::GetBasePath(), "ratings", "bpb.sv6.txt");
+        auto expectedRatings = File::ReadAllLines(expectedDataPath);
+
+        // Check ride ratings
+        int expI = 0;
+        for (const auto& ride : GetRideManager())
+        {
+            auto actual = FormatRatings(ride);
+            auto expected = expectedRatings[expI];
+            ASSERT_STREQ(actual.c_str(), expected.c_str());
+
+            expI++;
+        }
+    }
+
     void DumpRatings()
     {
         for (const auto& ride : GetRideManager())
@@ -72,19 +102,26 @@ TEST_F(RideRatings, all)
     ASSERT_EQ(ride_get_count(), 134);
 
     CalculateRatingsForAllRides();
+    CheckRatings();
+}
 
-    // Load expected ratings
-    auto expectedDataPath = Path::Combine(TestData::GetBasePath(), "ratings", "bpb.sv6.txt");
-    auto expectedRatings = File::ReadAllLines(expectedDataPath);
+TEST_F(RideRatings, parallel)
+{
+    std::string path = TestData::GetParkPath("bpb.sv6");
 
-    // Check ride ratings
-    int expI = 0;
-    for (const auto& ride : GetRideManager())
-    {
-        auto actual = FormatRatings(ride);
-        auto expected = expectedRatings[expI];
-        ASSERT_STREQ(actual.c_str(), expected.c_str());
+    gOpenRCT2Headless = true;
+    gOpenRCT2NoGraphics = true;
 
-        expI++;
-    }
+    core_init();
+    auto context = CreateContext();
+    bool initialised = context->Initialise();
+    ASSERT_TRUE(initialised);
+
+    load_from_sv6(path.c_str());
+
+    // Check ride count to check load was successful
+    ASSERT_EQ(ride_get_count(), 134);
+
+    CalculateRatingsForAllRidesInParallel();
+    CheckRatings();
 }